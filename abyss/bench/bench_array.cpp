@@ -0,0 +1,62 @@
+/**
+ * @file bench_array.cpp
+ * @brief abyss::Array growth: Add vs AddCached vs bulk append
+ *
+ * Each iteration builds an array of N ints from empty, so the numbers include
+ * every reallocation the growth policy causes; ns/op is per element.
+ */
+
+#include <abyss/AEArray.h>
+#include <yu/bench.h>
+
+#include <cstdint>
+#include <format>
+#include <numeric>
+#include <span>
+#include <vector>
+
+namespace {
+
+template<typename Fill>
+void RegisterSizes(const char* name, Fill fill) {
+    for (const std::uint32_t count : {16u, 1024u, 65536u}) {
+        yu::bench::Register(std::format("{} x{}", name, count), [fill, count](yu::bench::State& state) {
+            state.SetItemsPerIteration(count);
+            for (auto _ : state) {
+                abyss::Array<int> array;
+                fill(array, count);
+                yu::bench::DoNotOptimize(array.Size());
+            }
+        });
+    }
+}
+
+} // anonymous namespace
+
+int main(int argc, char** argv) {
+    static std::vector<int> source(65536);
+    std::iota(source.begin(), source.end(), 0);
+
+    RegisterSizes("Array::Add", [](abyss::Array<int>& array, std::uint32_t count) {
+        for (std::uint32_t i = 0; i < count; ++i) array.Add(static_cast<int>(i));
+    });
+
+    RegisterSizes("Array::AddCached", [](abyss::Array<int>& array, std::uint32_t count) {
+        for (std::uint32_t i = 0; i < count; ++i) array.AddCached(static_cast<int>(i));
+    });
+
+    RegisterSizes("Array::PushBack", [](abyss::Array<int>& array, std::uint32_t count) {
+        for (std::uint32_t i = 0; i < count; ++i) array.PushBack(static_cast<int>(i));
+    });
+
+    RegisterSizes("Array::Reserve+Add", [](abyss::Array<int>& array, std::uint32_t count) {
+        array.Reserve(count);
+        for (std::uint32_t i = 0; i < count; ++i) array.Add(static_cast<int>(i));
+    });
+
+    RegisterSizes("Array::AppendRange", [](abyss::Array<int>& array, std::uint32_t count) {
+        array.AppendRange(std::span<const int>(source.data(), count));
+    });
+
+    return yu::bench::Main(argc, argv);
+}
@@ -0,0 +1,131 @@
+/**
+ * @file bench_string.cpp
+ * @brief abyss::String construction and UTF-8 conversion
+ */
+
+#include <abyss/AEString.h>
+#include <abyss/Utf.h>
+#include <yu/bench.h>
+
+#include <array>
+#include <string>
+#include <string_view>
+
+#ifdef _WIN32
+#include <Windows.h>
+#endif
+
+namespace {
+
+constexpr const wchar_t* ShortWide = L"Terran Vossk";
+constexpr const char* ShortUtf8 = "Terran Vossk";
+constexpr const char* LongUtf8 =
+    "The Nivelian system lies beyond the Vossk void; Größe und Maß, 大小 — "
+    "a trading convoy leaves every few hours for the outer stations.";
+
+#ifdef _WIN32
+// The conversions abyss::utf replaced: two Win32 passes and an allocation per call
+std::wstring Win32ToWide(std::string_view text) {
+    const int length = MultiByteToWideChar(CP_UTF8, 0, text.data(), static_cast<int>(text.size()), nullptr, 0);
+    std::wstring result(static_cast<std::size_t>(length > 0 ? length : 0), L'\0');
+    MultiByteToWideChar(CP_UTF8, 0, text.data(), static_cast<int>(text.size()), result.data(), length);
+    return result;
+}
+
+std::string Win32ToUtf8(std::wstring_view text) {
+    const int length = WideCharToMultiByte(CP_UTF8, 0, text.data(), static_cast<int>(text.size()), nullptr, 0, nullptr, nullptr);
+    std::string result(static_cast<std::size_t>(length > 0 ? length : 0), '\0');
+    WideCharToMultiByte(CP_UTF8, 0, text.data(), static_cast<int>(text.size()), result.data(), length, nullptr, nullptr);
+    return result;
+}
+#endif
+
+} // anonymous namespace
+
+int main(int argc, char** argv) {
+    const abyss::String shortString(ShortWide);
+    const abyss::String longString = abyss::String::FromUTF8(LongUtf8);
+
+    yu::bench::Register("String(const wchar_t*) short", [](yu::bench::State& state) {
+        for (auto _ : state) {
+            abyss::String s(ShortWide);
+            yu::bench::DoNotOptimize(s.c_str());
+        }
+    });
+
+    yu::bench::Register("String::FromUTF8 short", [](yu::bench::State& state) {
+        for (auto _ : state) {
+            abyss::String s = abyss::String::FromUTF8(ShortUtf8);
+            yu::bench::DoNotOptimize(s.c_str());
+        }
+    });
+
+    yu::bench::Register("String::FromUTF8 long, non-ASCII", [](yu::bench::State& state) {
+        for (auto _ : state) {
+            abyss::String s = abyss::String::FromUTF8(LongUtf8);
+            yu::bench::DoNotOptimize(s.c_str());
+        }
+    });
+
+    yu::bench::Register("String copy", [&](yu::bench::State& state) {
+        for (auto _ : state) {
+            abyss::String s(longString);
+            yu::bench::DoNotOptimize(s.c_str());
+        }
+    });
+
+    yu::bench::Register("String::ToUTF8 short", [&](yu::bench::State& state) {
+        for (auto _ : state) {
+            std::string utf8 = shortString.ToUTF8();
+            yu::bench::DoNotOptimize(utf8.data());
+        }
+    });
+
+    yu::bench::Register("String::ToUTF8 long", [&](yu::bench::State& state) {
+        for (auto _ : state) {
+            std::string utf8 = longString.ToUTF8();
+            yu::bench::DoNotOptimize(utf8.data());
+        }
+    });
+
+    yu::bench::Register("String::ToUTF8(span) long", [&](yu::bench::State& state) {
+        std::array<char, 512> buffer;
+        for (auto _ : state) {
+            const std::size_t written = longString.ToUTF8(buffer);
+            yu::bench::DoNotOptimize(written);
+        }
+    });
+
+    yu::bench::Register("String::AppendUTF8 long, reused buffer", [&](yu::bench::State& state) {
+        std::string out;
+        for (auto _ : state) {
+            out.clear();
+            longString.AppendUTF8(out);
+            yu::bench::DoNotOptimize(out.data());
+        }
+    });
+
+    yu::bench::Register("utf::ToWideScratch long", [](yu::bench::State& state) {
+        for (auto _ : state) {
+            yu::bench::DoNotOptimize(abyss::utf::ToWideScratch(LongUtf8).data());
+        }
+    });
+
+#ifdef _WIN32
+    yu::bench::Register("MultiByteToWideChar x2 long (baseline)", [](yu::bench::State& state) {
+        for (auto _ : state) {
+            std::wstring wide = Win32ToWide(LongUtf8);
+            yu::bench::DoNotOptimize(wide.data());
+        }
+    });
+
+    yu::bench::Register("WideCharToMultiByte x2 long (baseline)", [&](yu::bench::State& state) {
+        for (auto _ : state) {
+            std::string utf8 = Win32ToUtf8(longString.c_str());
+            yu::bench::DoNotOptimize(utf8.data());
+        }
+    });
+#endif
+
+    return yu::bench::Main(argc, argv);
+}
@@ -6,6 +6,8 @@
 #include <yu/memory.h>
 #include <type_traits>
 #include <cstring>
+#include <new>
+#include <span>
 #include <utility>
 
 constexpr yu::mem::TagId AEArrayTag = yu::mem::Tags::UserStart + 2;
@@ -18,12 +20,46 @@ namespace abyss::detail
 }
 namespace abyss
 {
+    /**
+     * @brief Growth policy matching the engine: Add reallocates to exactly count + 1
+     * and removals shrink the allocation to the new size
+     *
+     * Required for arrays handed back to the game.
+     */
+    struct EngineGrowth
+    {
+        static constexpr bool ExactFit = true;
+
+        static constexpr std::uint32_t Grow(std::uint32_t /*capacity*/, std::uint32_t required)
+        {
+            return required;
+        }
+    };
+
+    /**
+     * @brief Growth policy with amortized doubling; removals keep the allocation
+     *
+     * For arrays owned by our own code. The layout is unchanged, only the
+     * allocation pattern differs.
+     */
+    struct GeometricGrowth
+    {
+        static constexpr bool ExactFit = false;
+
+        static constexpr std::uint32_t Grow(std::uint32_t capacity, std::uint32_t required)
+        {
+            const std::uint32_t doubled = (capacity < 4) ? 4 : capacity * 2;
+            return (doubled > required) ? doubled : required;
+        }
+    };
+
     /**
      * @brief AEArray - A simple array structure used in Abyss engine
      *
      * @tparam T
+     * @tparam Growth EngineGrowth (default, engine-compatible) or GeometricGrowth
      */
-    template <typename T>
+    template <typename T, typename Growth = EngineGrowth>
     class Array
     {
         /**
@@ -43,6 +79,11 @@ namespace abyss
         std::uint32_t capacity;
 
     public:
+        using value_type = T;
+        using size_type = std::uint32_t;
+        using iterator = T *;
+        using const_iterator = const T *;
+
         /**
          * @brief Construct a new Array object
          *
@@ -93,6 +134,31 @@ namespace abyss
          * @return const T&
          */
         const T &operator[](std::uint32_t index) const;
+        /**
+         * @brief Pointer to the first element; the items are contiguous, so the array
+         * is a std::ranges::contiguous_range and converts implicitly to std::span
+         *
+         * @return T*
+         */
+        T *data();
+        /**
+         * @brief Const pointer to the first element
+         *
+         * @return const T*
+         */
+        const T *data() const;
+        iterator begin();
+        iterator end();
+        const_iterator begin() const;
+        const_iterator end() const;
+        const_iterator cbegin() const;
+        const_iterator cend() const;
+        /**
+         * @brief Number of elements, for std::size and std::ranges::size
+         *
+         * @return std::uint32_t
+         */
+        std::uint32_t size() const;
 
         /**
          * @brief Clears the array and sets its length to newLength
@@ -106,6 +172,26 @@ namespace abyss
          * @param item
          */
         void Add(const T &item);
+        /**
+         * @brief Constructs an item in place at the end of the array, growing by the policy
+         *
+         * @param args Constructor arguments, forwarded
+         * @return T& The new item
+         */
+        template <typename... Args>
+        T &EmplaceBack(Args &&...args);
+        /**
+         * @brief Copies an item to the end of the array, growing by the policy
+         *
+         * @param item
+         */
+        void PushBack(const T &item);
+        /**
+         * @brief Moves an item to the end of the array, growing by the policy
+         *
+         * @param item
+         */
+        void PushBack(T &&item);
         /**
          * @brief Adds an item to the end of the array, doubling capacity if needed
          *
@@ -124,6 +210,40 @@ namespace abyss
          * @param item
          */
         void Remove(const T &item);
+        /**
+         * @brief Removes the item at the specified index by moving the last item into its place (order is not kept)
+         *
+         * @param index
+         */
+        void RemoveAtUnordered(std::uint32_t index);
+        /**
+         * @brief Appends a range of items (one allocation at most); the range may point into this array
+         *
+         * @param range
+         */
+        void AppendRange(std::span<const T> range);
+        /**
+         * @brief Inserts a range of items before index (one allocation at most); the range may point into this array
+         *
+         * @param index Insertion position, clamped to Size()
+         * @param range
+         */
+        void InsertRange(std::uint32_t index, std::span<const T> range);
+        /**
+         * @brief Removes rangeCount items starting at first (one reallocation at most)
+         *
+         * @param first
+         * @param rangeCount Clamped to the end of the array
+         */
+        void EraseRange(std::uint32_t first, std::uint32_t rangeCount);
+        /**
+         * @brief Removes every item for which pred(item) is true, in one pass (one reallocation at most)
+         *
+         * @param pred
+         * @return std::uint32_t Number of removed items
+         */
+        template <typename Pred>
+        std::uint32_t EraseIf(Pred pred);
         /**
          * @brief Releases memory for class-type elements
          *
@@ -142,6 +262,17 @@ namespace abyss
          * @param newCapacity
          */
         void Resize(std::uint32_t newCapacity);
+        /**
+         * @brief Grows the capacity to at least newCapacity (never shrinks)
+         *
+         * @param newCapacity
+         */
+        void Reserve(std::uint32_t newCapacity);
+        /**
+         * @brief Shrinks the capacity to the number of elements (1 for an empty, allocated array, as the engine does)
+         *
+         */
+        void ShrinkToFit();
 
         /**
          * @brief Gets the number of elements currently stored in the array
@@ -166,9 +297,9 @@ namespace abyss
          * @brief Creates an Array from a std::vector
          *
          * @param vec
-         * @return Array<T>
+         * @return Array
          */
-        static Array<T> FromVector(const std::vector<T> &vec);
+        static Array FromVector(const std::vector<T> &vec);
         /**
          * @brief Clears the array, removing all elements
          *
@@ -189,14 +320,27 @@ namespace abyss
          * @return false
          */
         bool IsValid() const;
+
+    private:
+        /**
+         * @brief Checks if one more element fits without reallocating
+         *
+         * @return true if items[count] can be constructed in place
+         */
+        bool HasRoomForOne() const;
+        /**
+         * @brief Gives back unused capacity after a removal, if the growth policy asks for it
+         *
+         */
+        void ShrinkAfterRemove();
     };
 
-    template <typename T>
-    Array<T>::Array()
+    template <typename T, typename Growth>
+    Array<T, Growth>::Array()
         : count(0), items(nullptr), capacity(0) {}
 
-    template <typename T>
-    Array<T>::~Array()
+    template <typename T, typename Growth>
+    Array<T, Growth>::~Array()
     {
         if (items)
         {
@@ -212,8 +356,8 @@ namespace abyss
         }
     }
 
-    template <typename T>
-    Array<T>::Array(const Array &other)
+    template <typename T, typename Growth>
+    Array<T, Growth>::Array(const Array &other)
         : count(other.count), capacity(other.capacity), items(nullptr)
     {
         if (capacity > 0)
@@ -233,8 +377,8 @@ namespace abyss
         }
     }
 
-    template <typename T>
-    Array<T> &Array<T>::operator=(const Array &other)
+    template <typename T, typename Growth>
+    Array<T, Growth> &Array<T, Growth>::operator=(const Array &other)
     {
         if (this != &other)
         {
@@ -274,8 +418,8 @@ namespace abyss
         return *this;
     }
 
-    template <typename T>
-    Array<T>::Array(Array &&other) noexcept
+    template <typename T, typename Growth>
+    Array<T, Growth>::Array(Array &&other) noexcept
         : count(other.count), items(other.items), capacity(other.capacity)
     {
         other.count = 0;
@@ -283,8 +427,8 @@ namespace abyss
         other.capacity = 0;
     }
 
-    template <typename T>
-    Array<T> &Array<T>::operator=(Array &&other) noexcept
+    template <typename T, typename Growth>
+    Array<T, Growth> &Array<T, Growth>::operator=(Array &&other) noexcept
     {
         if (this != &other)
         {
@@ -311,20 +455,74 @@ namespace abyss
         return *this;
     }
 
-    template <typename T>
-    T &Array<T>::operator[](std::uint32_t index)
+    template <typename T, typename Growth>
+    T &Array<T, Growth>::operator[](std::uint32_t index)
     {
         return items[index];
     }
 
-    template <typename T>
-    const T &Array<T>::operator[](std::uint32_t index) const
+    template <typename T, typename Growth>
+    const T &Array<T, Growth>::operator[](std::uint32_t index) const
     {
         return items[index];
     }
 
-    template <typename T>
-    void Array<T>::SetLength(std::uint32_t newLength)
+    template <typename T, typename Growth>
+    T *Array<T, Growth>::data()
+    {
+        return items;
+    }
+
+    template <typename T, typename Growth>
+    const T *Array<T, Growth>::data() const
+    {
+        return items;
+    }
+
+    template <typename T, typename Growth>
+    typename Array<T, Growth>::iterator Array<T, Growth>::begin()
+    {
+        return items;
+    }
+
+    template <typename T, typename Growth>
+    typename Array<T, Growth>::iterator Array<T, Growth>::end()
+    {
+        return items + count;
+    }
+
+    template <typename T, typename Growth>
+    typename Array<T, Growth>::const_iterator Array<T, Growth>::begin() const
+    {
+        return items;
+    }
+
+    template <typename T, typename Growth>
+    typename Array<T, Growth>::const_iterator Array<T, Growth>::end() const
+    {
+        return items + count;
+    }
+
+    template <typename T, typename Growth>
+    typename Array<T, Growth>::const_iterator Array<T, Growth>::cbegin() const
+    {
+        return items;
+    }
+
+    template <typename T, typename Growth>
+    typename Array<T, Growth>::const_iterator Array<T, Growth>::cend() const
+    {
+        return items + count;
+    }
+
+    template <typename T, typename Growth>
+    std::uint32_t Array<T, Growth>::size() const
+    {
+        return count;
+    }
+
+    template <typename T, typename Growth>
+    void Array<T, Growth>::SetLength(std::uint32_t newLength)
     {
         if constexpr (detail::is_trivially_relocatable_v<T>)
         {
@@ -374,8 +572,8 @@ namespace abyss
         }
     }
 
-    template <typename T>
-    void Array<T>::Resize(std::uint32_t newCapacity)
+    template <typename T, typename Growth>
+    void Array<T, Growth>::Resize(std::uint32_t newCapacity)
     {
         if (newCapacity == capacity)
             return;
@@ -424,9 +622,37 @@ namespace abyss
         }
     }
 
-    template <typename T>
-    void Array<T>::Add(const T &item)
+    template <typename T, typename Growth>
+    void Array<T, Growth>::Reserve(std::uint32_t newCapacity)
+    {
+        if (newCapacity > capacity)
+        {
+            Resize(newCapacity);
+        }
+    }
+
+    template <typename T, typename Growth>
+    void Array<T, Growth>::ShrinkToFit()
     {
+        if (!items)
+            return;
+
+        const std::uint32_t newCapacity = (count == 0) ? 1 : count;
+        if (newCapacity != capacity)
+        {
+            Resize(newCapacity);
+        }
+    }
+
+    template <typename T, typename Growth>
+    void Array<T, Growth>::Add(const T &item)
+    {
+        if constexpr (!Growth::ExactFit)
+        {
+            PushBack(item);
+            return;
+        }
+
         // Capacity increases by exactly 1 each time (matches pseudocode)
         std::uint32_t newCapacity = count + 1;
 
@@ -462,8 +688,62 @@ namespace abyss
         count = newCapacity;
     }
 
-    template <typename T>
-    void Array<T>::AddCached(const T &item)
+    template <typename T, typename Growth>
+    template <typename... Args>
+    T &Array<T, Growth>::EmplaceBack(Args &&...args)
+    {
+        if (HasRoomForOne())
+        {
+            T *item = new (&items[count]) T(std::forward<Args>(args)...);
+            ++count;
+            return *item;
+        }
+
+        const std::uint32_t newCapacity = Growth::Grow(capacity, count + 1);
+
+        if constexpr (detail::is_trivially_relocatable_v<T>)
+        {
+            // The arguments may refer to an element: build the value before the buffer moves
+            T value(std::forward<Args>(args)...);
+            Resize(newCapacity);
+            std::memcpy(static_cast<void *>(&items[count]), &value, sizeof(T));
+        }
+        else
+        {
+            // Construct into the new buffer while the old one (and the arguments) are still alive
+            T *newItems = static_cast<T *>(yu::mem::Allocate(sizeof(T) * newCapacity, AEArrayTag));
+            new (&newItems[count]) T(std::forward<Args>(args)...);
+
+            for (std::uint32_t i = 0; i < count; ++i)
+            {
+                new (&newItems[i]) T(std::move(items[i]));
+                items[i].~T();
+            }
+            if (items)
+            {
+                yu::mem::Free(items);
+            }
+
+            items = newItems;
+            capacity = newCapacity;
+        }
+        return items[count++];
+    }
+
+    template <typename T, typename Growth>
+    void Array<T, Growth>::PushBack(const T &item)
+    {
+        EmplaceBack(item);
+    }
+
+    template <typename T, typename Growth>
+    void Array<T, Growth>::PushBack(T &&item)
+    {
+        EmplaceBack(std::move(item));
+    }
+
+    template <typename T, typename Growth>
+    void Array<T, Growth>::AddCached(const T &item)
     {
         if (count >= capacity)
         {
@@ -495,8 +775,8 @@ namespace abyss
         ++count;
     }
 
-    template <typename T>
-    void Array<T>::RemoveAt(std::uint32_t index)
+    template <typename T, typename Growth>
+    void Array<T, Growth>::RemoveAt(std::uint32_t index)
     {
         if (count == 0 || index >= count)
             return;
@@ -504,20 +784,20 @@ namespace abyss
         if constexpr (detail::is_trivially_relocatable_v<T>)
         {
             // Shift elements left
-            for (std::uint32_t i = index; i + 1 < count; ++i)
-            {
-                items[i] = items[i + 1];
-            }
+            std::memmove(static_cast<void *>(items + index), items + index + 1, sizeof(T) * (count - index - 1));
             --count;
 
-            // Reallocate to exact size (matches pseudocode Remove behavior)
-            std::uint32_t newCapacity = (count == 0) ? 1 : count;
-            items = static_cast<T *>(yu::mem::Reallocate(items, sizeof(T) * newCapacity, AEArrayTag));
-            if (count == 0)
+            if constexpr (Growth::ExactFit)
             {
-                std::memset(items, 0, sizeof(T) * newCapacity);
+                // Reallocate to exact size (matches pseudocode Remove behavior)
+                std::uint32_t newCapacity = (count == 0) ? 1 : count;
+                items = static_cast<T *>(yu::mem::Reallocate(items, sizeof(T) * newCapacity, AEArrayTag));
+                if (count == 0)
+                {
+                    std::memset(items, 0, sizeof(T) * newCapacity);
+                }
+                capacity = newCapacity;
             }
-            capacity = newCapacity;
         }
         else
         {
@@ -533,7 +813,7 @@ namespace abyss
 
             // Shrink to fit
             std::uint32_t newCapacity = (count == 0) ? 1 : count;
-            if (newCapacity != capacity)
+            if (Growth::ExactFit && newCapacity != capacity)
             {
                 T *newItems = static_cast<T *>(yu::mem::Allocate(sizeof(T) * newCapacity, AEArrayTag));
                 for (std::uint32_t i = 0; i < count; ++i)
@@ -548,8 +828,8 @@ namespace abyss
         }
     }
 
-    template <typename T>
-    void Array<T>::Remove(const T &item)
+    template <typename T, typename Growth>
+    void Array<T, Growth>::Remove(const T &item)
     {
         if (count == 0)
             return;
@@ -568,14 +848,17 @@ namespace abyss
 
             count = newLength;
 
-            // Reallocate to exact size (capacity = length)
-            std::uint32_t newCapacity = (count == 0) ? 1 : count;
-            items = static_cast<T *>(yu::mem::Reallocate(items, sizeof(T) * newCapacity, AEArrayTag));
-            if (count == 0)
+            if constexpr (Growth::ExactFit)
             {
-                std::memset(items, 0, sizeof(T) * newCapacity);
+                // Reallocate to exact size (capacity = length)
+                std::uint32_t newCapacity = (count == 0) ? 1 : count;
+                items = static_cast<T *>(yu::mem::Reallocate(items, sizeof(T) * newCapacity, AEArrayTag));
+                if (count == 0)
+                {
+                    std::memset(items, 0, sizeof(T) * newCapacity);
+                }
+                capacity = newCapacity;
             }
-            capacity = newCapacity;
         }
         else
         {
@@ -601,7 +884,7 @@ namespace abyss
             count = newLength;
 
             std::uint32_t newCapacity = (count == 0) ? 1 : count;
-            if (newCapacity != capacity)
+            if (Growth::ExactFit && newCapacity != capacity)
             {
                 T *newItems = static_cast<T *>(yu::mem::Allocate(sizeof(T) * newCapacity, AEArrayTag));
                 for (std::uint32_t i = 0; i < count; ++i)
@@ -616,8 +899,180 @@ namespace abyss
         }
     }
 
-    template <typename T>
-    void Array<T>::ReleaseClasses()
+    template <typename T, typename Growth>
+    void Array<T, Growth>::RemoveAtUnordered(std::uint32_t index)
+    {
+        if (count == 0 || index >= count)
+            return;
+
+        const std::uint32_t last = count - 1;
+        if constexpr (detail::is_trivially_relocatable_v<T>)
+        {
+            items[index] = items[last];
+        }
+        else
+        {
+            if (index != last)
+            {
+                items[index] = std::move(items[last]);
+            }
+            items[last].~T();
+        }
+        --count;
+        ShrinkAfterRemove();
+    }
+
+    template <typename T, typename Growth>
+    void Array<T, Growth>::AppendRange(std::span<const T> range)
+    {
+        InsertRange(count, range);
+    }
+
+    template <typename T, typename Growth>
+    void Array<T, Growth>::InsertRange(std::uint32_t index, std::span<const T> range)
+    {
+        if (range.empty())
+            return;
+        if (index > count)
+            index = count;
+
+        const auto rangeCount = static_cast<std::uint32_t>(range.size());
+        const std::uint32_t newCount = count + rangeCount;
+        const bool aliased = items != nullptr && range.data() >= items && range.data() < items + capacity;
+        const std::uint32_t sourceOffset = aliased ? static_cast<std::uint32_t>(range.data() - items) : 0;
+
+        if constexpr (detail::is_trivially_relocatable_v<T>)
+        {
+            if (newCount > capacity)
+            {
+                Resize(Growth::Grow(capacity, newCount));
+            }
+            std::memmove(static_cast<void *>(items + index + rangeCount), items + index, sizeof(T) * (count - index));
+
+            if (!aliased)
+            {
+                std::memcpy(static_cast<void *>(items + index), range.data(), sizeof(T) * rangeCount);
+            }
+            else
+            {
+                // The part of the source before index stayed put, the rest moved up by rangeCount
+                const std::uint32_t sourceEnd = sourceOffset + rangeCount;
+                const std::uint32_t splitAt = (sourceEnd < index) ? sourceEnd : index;
+                const std::uint32_t before = (splitAt > sourceOffset) ? splitAt - sourceOffset : 0;
+                std::memcpy(static_cast<void *>(items + index), items + sourceOffset, sizeof(T) * before);
+                std::memcpy(static_cast<void *>(items + index + before), items + sourceOffset + before + rangeCount,
+                            sizeof(T) * (rangeCount - before));
+            }
+        }
+        else
+        {
+            if (newCount > capacity || aliased)
+            {
+                // Build into a new buffer: the source stays valid until the old one is freed
+                const std::uint32_t newCapacity = (newCount > capacity) ? Growth::Grow(capacity, newCount) : capacity;
+                T *newItems = static_cast<T *>(yu::mem::Allocate(sizeof(T) * newCapacity, AEArrayTag));
+                for (std::uint32_t i = 0; i < rangeCount; ++i)
+                {
+                    new (&newItems[index + i]) T(range[i]);
+                }
+                for (std::uint32_t i = 0; i < count; ++i)
+                {
+                    new (&newItems[(i < index) ? i : i + rangeCount]) T(std::move(items[i]));
+                    items[i].~T();
+                }
+                if (items)
+                {
+                    yu::mem::Free(items);
+                }
+                items = newItems;
+                capacity = newCapacity;
+            }
+            else
+            {
+                for (std::uint32_t i = count; i-- > index;)
+                {
+                    new (&items[i + rangeCount]) T(std::move(items[i]));
+                    items[i].~T();
+                }
+                for (std::uint32_t i = 0; i < rangeCount; ++i)
+                {
+                    new (&items[index + i]) T(range[i]);
+                }
+            }
+        }
+        count = newCount;
+    }
+
+    template <typename T, typename Growth>
+    void Array<T, Growth>::EraseRange(std::uint32_t first, std::uint32_t rangeCount)
+    {
+        if (first >= count || rangeCount == 0)
+            return;
+        if (rangeCount > count - first)
+            rangeCount = count - first;
+
+        const std::uint32_t tail = count - first - rangeCount;
+        if constexpr (detail::is_trivially_relocatable_v<T>)
+        {
+            std::memmove(static_cast<void *>(items + first), items + first + rangeCount, sizeof(T) * tail);
+        }
+        else
+        {
+            for (std::uint32_t i = first; i < first + rangeCount; ++i)
+            {
+                items[i].~T();
+            }
+            for (std::uint32_t i = 0; i < tail; ++i)
+            {
+                new (&items[first + i]) T(std::move(items[first + rangeCount + i]));
+                items[first + rangeCount + i].~T();
+            }
+        }
+        count -= rangeCount;
+        ShrinkAfterRemove();
+    }
+
+    template <typename T, typename Growth>
+    template <typename Pred>
+    std::uint32_t Array<T, Growth>::EraseIf(Pred pred)
+    {
+        std::uint32_t newLength = 0;
+        for (std::uint32_t i = 0; i < count; ++i)
+        {
+            if (pred(static_cast<const T &>(items[i])))
+            {
+                if constexpr (!std::is_trivially_destructible_v<T>)
+                {
+                    items[i].~T();
+                }
+                continue;
+            }
+            if (newLength != i)
+            {
+                if constexpr (detail::is_trivially_relocatable_v<T>)
+                {
+                    items[newLength] = items[i];
+                }
+                else
+                {
+                    new (&items[newLength]) T(std::move(items[i]));
+                    items[i].~T();
+                }
+            }
+            ++newLength;
+        }
+
+        const std::uint32_t removed = count - newLength;
+        count = newLength;
+        if (removed > 0)
+        {
+            ShrinkAfterRemove();
+        }
+        return removed;
+    }
+
+    template <typename T, typename Growth>
+    void Array<T, Growth>::ReleaseClasses()
     {
         if constexpr (std::is_pointer_v<T>)
         {
@@ -648,8 +1103,8 @@ namespace abyss
         }
     }
 
-    template <typename T>
-    void Array<T>::Set(T *src, std::uint32_t newCount)
+    template <typename T, typename Growth>
+    void Array<T, Growth>::Set(T *src, std::uint32_t newCount)
     {
         std::uint32_t newCapacity = (newCount == 0) ? 1 : newCount;
 
@@ -693,28 +1148,28 @@ namespace abyss
         count = newCount;
     }
 
-    template <typename T>
-    std::uint32_t Array<T>::Size() const
+    template <typename T, typename Growth>
+    std::uint32_t Array<T, Growth>::Size() const
     {
         return count;
     }
 
-    template <typename T>
-    std::uint32_t Array<T>::Capacity() const
+    template <typename T, typename Growth>
+    std::uint32_t Array<T, Growth>::Capacity() const
     {
         return capacity;
     }
 
-    template <typename T>
-    std::vector<T> Array<T>::ToVector() const
+    template <typename T, typename Growth>
+    std::vector<T> Array<T, Growth>::ToVector() const
     {
         return std::vector<T>(items, items + count);
     }
 
-    template <typename T>
-    Array<T> Array<T>::FromVector(const std::vector<T> &vec)
+    template <typename T, typename Growth>
+    Array<T, Growth> Array<T, Growth>::FromVector(const std::vector<T> &vec)
     {
-        Array<T> arr;
+        Array<T, Growth> arr;
         if (vec.empty())
         {
             return arr;
@@ -742,8 +1197,8 @@ namespace abyss
         return arr;
     }
 
-    template <typename T>
-    void Array<T>::Clear()
+    template <typename T, typename Growth>
+    void Array<T, Growth>::Clear()
     {
         if (items)
         {
@@ -761,18 +1216,45 @@ namespace abyss
         capacity = 0;
     }
 
-    template <typename T>
-    bool Array<T>::Empty() const
+    template <typename T, typename Growth>
+    bool Array<T, Growth>::Empty() const
     {
         return count == 0;
     }
 
-    template <typename T>
-    bool Array<T>::IsValid() const
+    template <typename T, typename Growth>
+    bool Array<T, Growth>::IsValid() const
     {
         return items != nullptr;
     }
 
+    template <typename T, typename Growth>
+    bool Array<T, Growth>::HasRoomForOne() const
+    {
+        return items != nullptr && count < capacity;
+    }
+
+    template <typename T, typename Growth>
+    void Array<T, Growth>::ShrinkAfterRemove()
+    {
+        if constexpr (Growth::ExactFit)
+        {
+            // Same as RemoveAt: capacity = count, or 1 (zeroed) once empty
+            const std::uint32_t newCapacity = (count == 0) ? 1 : count;
+            if (newCapacity != capacity)
+            {
+                Resize(newCapacity);
+            }
+            if constexpr (detail::is_trivially_relocatable_v<T>)
+            {
+                if (count == 0)
+                {
+                    std::memset(items, 0, sizeof(T) * newCapacity);
+                }
+            }
+        }
+    }
+
 };
 
 #endif // AEARRAY_H
\ No newline at end of file
@@ -1,3 +1,7 @@
+#ifndef AESTRING_H
+#define AESTRING_H
+
+#include <span>
 #include <string>
 #include <string_view>
 #include <cstdint>
@@ -108,6 +112,19 @@ namespace abyss
          * @return std::string UTF-8 encoded string
          */
         std::string ToUTF8() const;
+        /**
+         * @brief Convert the String to UTF-8 into a caller-provided buffer, without allocating
+         *
+         * @param out Destination; utf::MaxUtf8Length(size()) bytes always suffice
+         * @return std::size_t Number of bytes written (no terminator)
+         */
+        std::size_t ToUTF8(std::span<char> out) const;
+        /**
+         * @brief Append the UTF-8 form of the String to out; allocates only if out lacks the capacity
+         *
+         * @param out
+         */
+        void AppendUTF8(std::string &out) const;
 
         /**
          * @brief Check if the String is valid (non-null)
@@ -118,4 +135,6 @@ namespace abyss
         bool IsValid() const;
     };
 
-}
\ No newline at end of file
+}
+
+#endif // AESTRING_H
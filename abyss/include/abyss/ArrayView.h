@@ -0,0 +1,156 @@
+#ifndef ARRAYVIEW_H
+#define ARRAYVIEW_H
+
+#include <abyss/AEArray.h>
+#include <cstdint>
+#include <ranges>
+#include <span>
+#include <type_traits>
+
+namespace abyss
+{
+    /**
+     * @brief Non-owning view of a live engine array (count, items, capacity) at a game address
+     *
+     * The view keeps a pointer to the array header, not to the items, so it
+     * follows the array when the game reallocates it: every begin()/size() call
+     * reads the current header. It never allocates, frees or destroys anything.
+     * Use ArrayView<const T> for read-only access.
+     *
+     * @tparam T Element type, optionally const
+     */
+    template <typename T>
+    class ArrayView
+    {
+    public:
+        using value_type = std::remove_const_t<T>;
+        using size_type = std::uint32_t;
+        using iterator = T *;
+        using Header = Array<value_type>;
+
+        /**
+         * @brief Construct an empty (invalid) view
+         *
+         */
+        ArrayView() = default;
+        /**
+         * @brief Construct a view of an existing array header
+         *
+         * @param header May be nullptr
+         */
+        explicit ArrayView(const Header *header);
+        /**
+         * @brief Construct a view of the array header at a game address
+         *
+         * @param address
+         * @return ArrayView
+         */
+        static ArrayView At(std::uintptr_t address);
+
+        T *data() const;
+        iterator begin() const;
+        iterator end() const;
+        std::uint32_t size() const;
+        bool empty() const;
+        T &operator[](std::uint32_t index) const;
+        /**
+         * @brief Capacity of the viewed array
+         *
+         * @return std::uint32_t
+         */
+        std::uint32_t Capacity() const;
+        /**
+         * @brief Checks if the view points at an array with non-null items
+         *
+         * @return true
+         * @return false
+         */
+        bool IsValid() const;
+        /**
+         * @brief The current items as a span; invalidated when the game reallocates the array
+         *
+         * @return std::span<T>
+         */
+        std::span<T> AsSpan() const;
+
+    private:
+        const Header *header = nullptr;
+    };
+
+    template <typename T>
+    ArrayView<T>::ArrayView(const Header *header)
+        : header(header) {}
+
+    template <typename T>
+    ArrayView<T> ArrayView<T>::At(std::uintptr_t address)
+    {
+        return ArrayView(reinterpret_cast<const Header *>(address));
+    }
+
+    template <typename T>
+    T *ArrayView<T>::data() const
+    {
+        // The header is only read; element constness is decided by T
+        return header ? const_cast<T *>(header->data()) : nullptr;
+    }
+
+    template <typename T>
+    typename ArrayView<T>::iterator ArrayView<T>::begin() const
+    {
+        return data();
+    }
+
+    template <typename T>
+    typename ArrayView<T>::iterator ArrayView<T>::end() const
+    {
+        return data() + size();
+    }
+
+    template <typename T>
+    std::uint32_t ArrayView<T>::size() const
+    {
+        return (header && header->data()) ? header->Size() : 0;
+    }
+
+    template <typename T>
+    bool ArrayView<T>::empty() const
+    {
+        return size() == 0;
+    }
+
+    template <typename T>
+    T &ArrayView<T>::operator[](std::uint32_t index) const
+    {
+        return data()[index];
+    }
+
+    template <typename T>
+    std::uint32_t ArrayView<T>::Capacity() const
+    {
+        return header ? header->Capacity() : 0;
+    }
+
+    template <typename T>
+    bool ArrayView<T>::IsValid() const
+    {
+        return header != nullptr && header->IsValid();
+    }
+
+    template <typename T>
+    std::span<T> ArrayView<T>::AsSpan() const
+    {
+        return std::span<T>(data(), size());
+    }
+}
+
+// A view does not own the items: iterators outlive it, and copies are O(1)
+namespace std::ranges
+{
+    template <typename T>
+    inline constexpr bool enable_borrowed_range<abyss::ArrayView<T>> = true;
+
+    template <typename T>
+    inline constexpr bool enable_view<abyss::ArrayView<T>> = true;
+}
+
+#endif // ARRAYVIEW_H
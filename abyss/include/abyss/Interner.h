@@ -0,0 +1,143 @@
+#ifndef INTERNER_H
+#define INTERNER_H
+
+#include <abyss/AEString.h>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <string_view>
+
+namespace abyss
+{
+    /**
+     * @brief Stable id of an interned string; 0 is never a valid id
+     *
+     */
+    using InternId = std::uint32_t;
+    constexpr InternId InvalidInternId = 0;
+
+    /**
+     * @brief Interned string table for engine identifiers (mesh, station, item names)
+     *
+     * Maps wide or UTF-8 strings to stable 32-bit ids, so comparing names
+     * becomes comparing integers. Strings, entries and the hash table live in
+     * OS pages (yu/memory_os.h), never in the CRT heap, so the table can be
+     * used from hook threads without going through the hooked operator new.
+     *
+     * Lookups are lock-free: the open-addressed table is only published, never
+     * modified in place, and tables replaced by a grow stay alive until the
+     * interner is destroyed. Inserts take a mutex. Strings are never removed;
+     * the views returned by Wide() and Utf8() stay valid for the lifetime of
+     * the interner.
+     */
+    class Interner
+    {
+    public:
+        /**
+         * @brief Maximum number of interned strings
+         *
+         */
+        static constexpr std::uint32_t MaxEntries = 1u << 20;
+
+        Interner() = default;
+        ~Interner();
+        Interner(const Interner &) = delete;
+        Interner &operator=(const Interner &) = delete;
+
+        /**
+         * @brief The process-wide interner
+         *
+         * @return Interner&
+         */
+        static Interner &Global();
+
+        /**
+         * @brief Returns the id of str, adding it if needed
+         *
+         * @param str
+         * @return InternId InvalidInternId only if MaxEntries is reached or the OS is out of memory
+         */
+        InternId Intern(std::wstring_view str);
+        /**
+         * @brief Returns the id of a UTF-8 string, adding it if needed (interned in its wide form)
+         *
+         * @param utf8Str
+         * @return InternId
+         */
+        InternId Intern(std::string_view utf8Str);
+        /**
+         * @brief Returns the id of an engine string, adding it if needed
+         *
+         * @param str
+         * @return InternId
+         */
+        InternId Intern(const String &str);
+
+        /**
+         * @brief Returns the id of str without adding it (lock-free)
+         *
+         * @param str
+         * @return InternId InvalidInternId if str was never interned
+         */
+        InternId Find(std::wstring_view str) const;
+
+        /**
+         * @brief The interned wide string; null-terminated
+         *
+         * @param id
+         * @return std::wstring_view Empty for an invalid id
+         */
+        std::wstring_view Wide(InternId id) const;
+        /**
+         * @brief The UTF-8 form of the interned string, converted on first use and cached
+         *
+         * @param id
+         * @return std::string_view Null-terminated; empty for an invalid id
+         */
+        std::string_view Utf8(InternId id);
+
+        /**
+         * @brief Number of interned strings
+         *
+         * @return std::uint32_t
+         */
+        std::uint32_t Size() const;
+        /**
+         * @brief Bytes of OS pages held by the interner
+         *
+         * @return std::size_t
+         */
+        std::size_t Footprint() const;
+
+    private:
+        struct Entry
+        {
+            const wchar_t *wide;
+            std::uint32_t length;
+            std::uint32_t hash;
+            std::atomic<const char *> utf8;
+            std::uint32_t utf8Length;
+        };
+
+        struct Table;
+        struct Block;
+
+        static constexpr std::uint32_t EntriesPerChunk = 1024;
+        static constexpr std::uint32_t ChunkCount = MaxEntries / EntriesPerChunk;
+
+        const Entry *EntryOf(InternId id) const;
+        InternId FindIn(const Table *table, std::wstring_view str, std::uint32_t hash) const;
+        bool Grow();
+        void *ArenaAllocate(std::size_t size, std::size_t alignment);
+
+        std::atomic<Table *> m_table{nullptr};
+        std::atomic<Entry *> m_chunks[ChunkCount]{};
+        std::atomic<std::uint32_t> m_count{0};
+        Block *m_blocks = nullptr;
+        std::atomic<std::size_t> m_footprint{0};
+        std::mutex m_mutex;
+    };
+}
+
+#endif // INTERNER_H
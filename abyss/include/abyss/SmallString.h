@@ -0,0 +1,233 @@
+#ifndef SMALLSTRING_H
+#define SMALLSTRING_H
+
+#include <abyss/AEString.h>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <string_view>
+
+namespace abyss
+{
+    /**
+     * @brief The engine's string layout ({text, length}) without ownership
+     *
+     * What the game reads from an abyss::String. Pointing one at a
+     * SmallString's buffer costs nothing; the buffer must outlive the game's use.
+     */
+    struct StringView
+    {
+        const wchar_t *text;
+        std::uint32_t length;
+    };
+    static_assert(sizeof(StringView) == sizeof(String), "StringView must match the engine string layout");
+
+    /**
+     * @brief Mod-side wide string with inline storage for short strings and a cached hash
+     *
+     * Strings of up to InlineCapacity characters live inside the object, so
+     * building one does not touch the allocator; longer ones take one heap
+     * allocation. The hash is computed on first use and kept until the string
+     * changes, and equality rejects on length and cached hashes before
+     * comparing characters with wmemcmp. Not layout-compatible with the engine:
+     * use View() or ToString() when handing a string to the game.
+     */
+    class SmallString
+    {
+    public:
+        /**
+         * @brief Characters stored without a heap allocation (excluding the terminator)
+         *
+         */
+        static constexpr std::uint32_t InlineCapacity = 15;
+
+        /**
+         * @brief Construct an empty SmallString
+         *
+         */
+        SmallString();
+        /**
+         * @brief Construct from a wide C-string (nullptr gives an empty string)
+         *
+         * @param str
+         */
+        SmallString(const wchar_t *str);
+        /**
+         * @brief Construct from a wide string view
+         *
+         * @param str
+         */
+        SmallString(std::wstring_view str);
+        /**
+         * @brief Construct from an engine string
+         *
+         * @param str
+         */
+        SmallString(const String &str);
+        /**
+         * @brief Construct from a UTF-8 string view
+         *
+         * @param utf8Str
+         */
+        explicit SmallString(std::string_view utf8Str);
+        /**
+         * @brief Copy constructor
+         *
+         * @param other
+         */
+        SmallString(const SmallString &other);
+        /**
+         * @brief Move constructor; inline strings are copied, heap strings are stolen
+         *
+         * @param other
+         */
+        SmallString(SmallString &&other) noexcept;
+        /**
+         * @brief Copy assignment operator
+         *
+         * @param other
+         * @return SmallString&
+         */
+        SmallString &operator=(const SmallString &other);
+        /**
+         * @brief Move assignment operator
+         *
+         * @param other
+         * @return SmallString&
+         */
+        SmallString &operator=(SmallString &&other) noexcept;
+        /**
+         * @brief Destroy the SmallString object
+         *
+         */
+        ~SmallString();
+
+        /**
+         * @brief Get the null-terminated wide string (never nullptr)
+         *
+         * @return const wchar_t*
+         */
+        const wchar_t *c_str() const;
+        /**
+         * @brief Get the length of the string
+         *
+         * @return std::uint32_t
+         */
+        std::uint32_t size() const;
+        /**
+         * @brief Checks if the string is empty
+         *
+         * @return true
+         * @return false
+         */
+        bool Empty() const;
+        /**
+         * @brief Checks if the characters are stored inline
+         *
+         * @return true
+         * @return false
+         */
+        bool IsInline() const;
+
+        /**
+         * @brief FNV-1a hash of the characters, computed once and cached
+         *
+         * @return std::uint32_t
+         */
+        std::uint32_t Hash() const;
+
+        /**
+         * @brief Equality operator: length, then cached hashes, then wmemcmp
+         *
+         * @param other
+         * @return true
+         * @return false
+         */
+        bool operator==(const SmallString &other) const;
+        /**
+         * @brief Inequality operator
+         *
+         * @param other
+         * @return true
+         * @return false
+         */
+        bool operator!=(const SmallString &other) const;
+        /**
+         * @brief Compare against an engine string
+         *
+         * @param other
+         * @return true
+         * @return false
+         */
+        bool operator==(const String &other) const;
+
+        /**
+         * @brief Non-owning wide string view
+         *
+         * @return std::wstring_view
+         */
+        operator std::wstring_view() const;
+        /**
+         * @brief Non-owning engine layout view of the characters
+         *
+         * @return StringView
+         */
+        StringView View() const;
+        /**
+         * @brief Copy into an owning engine string, for when the game keeps the string
+         *
+         * @return String
+         */
+        String ToString() const;
+        /**
+         * @brief Convert to a UTF-8 std::string
+         *
+         * @return std::string
+         */
+        std::string ToUTF8() const;
+
+    private:
+        /**
+         * @brief Assigns the characters of str (length characters, not necessarily terminated)
+         *
+         * @param str
+         * @param length
+         */
+        void Assign(const wchar_t *str, std::uint32_t length);
+        /**
+         * @brief Frees the heap buffer, if any, and resets to an empty inline string
+         *
+         */
+        void Reset();
+
+        /**
+         * @brief inlineText or a heap buffer of capacity + 1 characters
+         *
+         */
+        wchar_t *text;
+        std::uint32_t length;
+        /**
+         * @brief Cached Hash(); 0 while not computed
+         *
+         */
+        mutable std::uint32_t hash;
+        /**
+         * @brief Characters text can hold, excluding the terminator (InlineCapacity while inline)
+         *
+         */
+        std::uint32_t capacity;
+        wchar_t inlineText[InlineCapacity + 1];
+    };
+}
+
+template <>
+struct std::hash<abyss::SmallString>
+{
+    std::size_t operator()(const abyss::SmallString &str) const noexcept
+    {
+        return str.Hash();
+    }
+};
+
+#endif // SMALLSTRING_H
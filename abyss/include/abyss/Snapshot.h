@@ -0,0 +1,317 @@
+#ifndef SNAPSHOT_H
+#define SNAPSHOT_H
+
+#include <abyss/AEArray.h>
+#include <abyss/Transform.h>
+#include <abyss/math/Matrix.hpp>
+#include <yu/io_mapped.h>
+#include <yu/io_stream.h>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <span>
+#include <vector>
+
+namespace abyss
+{
+    /**
+     * @brief Block codec of a snapshot frame
+     *
+     * Every frame is first XOR-delta encoded against the previous one (keyframes
+     * against nothing), so an unchanged transform becomes a run of zero bytes.
+     */
+    enum class SnapshotCodec : std::uint8_t
+    {
+        None = 0,    ///< Delta bytes stored as is
+        ZeroRun = 1, ///< Delta bytes with zero runs collapsed (built in, fast)
+        Lz4 = 2      ///< ZeroRun output compressed with LZ4 (needs ABYSS_SNAPSHOT_LZ4)
+    };
+
+    /**
+     * @brief One transform in a snapshot frame
+     *
+     * Plain data with a fixed layout: a decoded frame is an array of rows that
+     * is used in place. Mesh handles are stored after the rows, once per frame.
+     */
+    struct SnapshotRow
+    {
+        std::uint64_t address;    ///< Transform address in the game
+        float world[16];          ///< World matrix (zero without SnapshotRow::HasWorld)
+        std::uint32_t meshOffset; ///< First mesh in the frame's mesh array
+        std::uint32_t meshCount;  ///< Transform::meshes.Size()
+        std::uint32_t flags;
+        std::uint32_t reserved;
+
+        static constexpr std::uint32_t HasWorld = 1u << 0;
+    };
+    static_assert(sizeof(SnapshotRow) == 88, "SnapshotRow is a file format");
+
+    /**
+     * @brief File and frame headers of the snapshot format
+     *
+     * File: FileHeader, FileHeader::fieldCount SchemaFields, then frames.
+     * Frame: FrameHeader followed by storedSize payload bytes. All values are
+     * little endian (the game is x86).
+     */
+    namespace snapshot_format
+    {
+        constexpr char Magic[4] = {'A', 'B', 'S', 'N'};
+        constexpr std::uint32_t FrameMagic = 0x52464241; // "ABFR"
+        constexpr std::uint16_t Version = 1;
+
+        /// @brief Types of the schema fields
+        enum class FieldType : std::uint16_t
+        {
+            U32 = 1,
+            U64 = 2,
+            F32 = 3
+        };
+
+        struct FileHeader
+        {
+            char magic[4];
+            std::uint16_t version;
+            std::uint16_t fieldCount;
+            std::uint32_t rowSize;
+            std::uint32_t keyframeInterval;
+        };
+        static_assert(sizeof(FileHeader) == 16);
+
+        /// @brief Describes one SnapshotRow member, so offline tools need no header
+        struct SchemaField
+        {
+            char name[16];
+            FieldType type;
+            std::uint16_t count;
+            std::uint32_t offset;
+        };
+        static_assert(sizeof(SchemaField) == 24);
+
+        struct FrameHeader
+        {
+            std::uint32_t magic;
+            SnapshotCodec codec;
+            std::uint8_t flags;
+            std::uint16_t reserved;
+            std::uint64_t frame;        ///< Caller's frame number
+            std::uint32_t rowCount;
+            std::uint32_t meshCount;
+            std::uint32_t rawSize;      ///< rowCount rows + meshCount u64 handles
+            std::uint32_t encodedSize;  ///< After zero-run encoding (input of LZ4)
+            std::uint32_t storedSize;   ///< Payload bytes in the file
+            std::uint32_t reserved2;
+        };
+        static_assert(sizeof(FrameHeader) == 40);
+
+        constexpr std::uint8_t KeyframeFlag = 1u << 0;
+
+        /// @brief Schema written by this build
+        std::span<const SchemaField> Schema();
+    } // namespace snapshot_format
+
+    /**
+     * @brief Settings of a SnapshotWriter
+     *
+     */
+    struct SnapshotOptions
+    {
+        std::uint32_t keyframeInterval = 120; ///< Frames between keyframes (seek points)
+        SnapshotCodec codec = SnapshotCodec::ZeroRun;
+        bool backgroundFlush = true;          ///< Disk writes on the stream writer's flusher thread
+    };
+
+    /**
+     * @brief Records transform frames to a compact binary file
+     *
+     * Frames are delta encoded against the previous frame, so a mostly static
+     * scene costs a few bytes per transform. The file is written through a
+     * yu::io::StreamWriter; a recording cut short by a crash is still readable
+     * up to its last complete frame.
+     */
+    class SnapshotWriter
+    {
+    public:
+        SnapshotWriter() = default;
+        ~SnapshotWriter();
+        SnapshotWriter(const SnapshotWriter &) = delete;
+        SnapshotWriter &operator=(const SnapshotWriter &) = delete;
+
+        /**
+         * @brief Creates the file and writes its header
+         *
+         * @param path Output file (relative to the yu::io base path)
+         * @param options
+         * @return true on success
+         */
+        bool Open(const std::filesystem::path &path, const SnapshotOptions &options = {});
+
+        bool IsOpen() const { return m_out.IsOpen(); }
+
+        /**
+         * @brief Records every transform of the array
+         *
+         * @tparam WorldOf const math::Matrix *(const Transform &); nullptr records no matrix
+         * @param frame Frame number stored with the frame
+         * @param transforms Live transform array (null entries are skipped)
+         * @param worldOf World matrix accessor (see TransformCache::Gather)
+         * @return true if the frame was written
+         */
+        template <typename WorldOf>
+        bool WriteFrame(std::uint64_t frame, const Array<Transform *> &transforms, WorldOf &&worldOf);
+
+        /**
+         * @brief Records prepared rows
+         *
+         * @param frame Frame number stored with the frame
+         * @param rows Rows; meshOffset/meshCount index into meshes
+         * @param meshes Mesh handles of all rows
+         * @return true if the frame was written
+         */
+        bool WriteFrame(std::uint64_t frame, std::span<const SnapshotRow> rows, std::span<const std::uint64_t> meshes);
+
+        /**
+         * @brief Flushes and closes the file
+         *
+         * @return true if every frame reached the file
+         */
+        bool Close();
+
+        /// @brief Frames written since Open
+        std::uint64_t FrameCount() const { return m_frames; }
+        /// @brief Bytes the frames would take without encoding
+        std::uint64_t RawBytes() const { return m_rawBytes; }
+        /// @brief Bytes the frames take in the file (headers included)
+        std::uint64_t StoredBytes() const { return m_storedBytes; }
+
+    private:
+        yu::io::StreamWriter m_out;
+        SnapshotOptions m_options;
+        std::uint64_t m_frames = 0;
+        std::uint64_t m_rawBytes = 0;
+        std::uint64_t m_storedBytes = 0;
+
+        // Reused across frames: a steady recording does not allocate
+        std::vector<SnapshotRow> m_rows;
+        std::vector<std::uint64_t> m_meshes;
+        std::vector<std::uint8_t> m_raw;
+        std::vector<std::uint8_t> m_previous;
+        std::vector<std::uint8_t> m_delta;
+        std::vector<std::uint8_t> m_encoded;
+        std::vector<std::uint8_t> m_compressed;
+    };
+
+    /**
+     * @brief A decoded frame; views into the reader, valid until its next ReadFrame
+     *
+     */
+    struct SnapshotFrame
+    {
+        std::uint64_t frame = 0;
+        std::span<const SnapshotRow> rows;
+        std::span<const std::uint64_t> meshes;
+
+        /// @brief Mesh handles of one row
+        std::span<const std::uint64_t> MeshesOf(const SnapshotRow &row) const
+        {
+            return meshes.subspan(row.meshOffset, row.meshCount);
+        }
+    };
+
+    /**
+     * @brief Plays back a snapshot file through a memory mapping
+     *
+     * Open() maps the file and indexes the frame headers (no payload is
+     * touched). ReadFrame() decodes forward from the nearest keyframe, so
+     * sequential playback decodes each frame once.
+     */
+    class SnapshotReader
+    {
+    public:
+        /**
+         * @brief Maps a snapshot file and indexes its frames
+         *
+         * @param path Snapshot file (relative to the yu::io base path)
+         * @return true if the header and schema match this build
+         */
+        bool Open(const std::filesystem::path &path);
+
+        void Close();
+
+        /// @brief Complete frames in the file
+        std::uint32_t FrameCount() const { return static_cast<std::uint32_t>(m_frames.size()); }
+
+        /// @brief Header of frame i (no decoding)
+        const snapshot_format::FrameHeader &Header(std::uint32_t index) const;
+
+        /// @brief Keyframe interval the file was written with
+        std::uint32_t KeyframeInterval() const { return m_keyframeInterval; }
+
+        /**
+         * @brief Decodes frame i
+         *
+         * @param index Position in the file, below FrameCount()
+         * @param out Views into the reader's decoded state
+         * @return false if the frame is corrupt or uses a codec this build lacks
+         */
+        bool ReadFrame(std::uint32_t index, SnapshotFrame &out);
+
+    private:
+        bool Decode(std::uint32_t index);
+
+        yu::io::MappedFile m_file;
+        std::span<const std::uint8_t> m_bytes;
+        struct FrameEntry
+        {
+            std::size_t offset; ///< Of the header in the file
+            snapshot_format::FrameHeader header; ///< Copy: headers in the file are not aligned
+        };
+        std::vector<FrameEntry> m_frames;
+        std::uint32_t m_keyframeInterval = 0;
+
+        std::vector<std::uint64_t> m_state; ///< Decoded raw frame (u64 storage keeps rows aligned)
+        std::size_t m_stateSize = 0;
+        std::vector<std::uint8_t> m_delta;
+        std::vector<std::uint8_t> m_scratch;   ///< LZ4 output
+        std::int64_t m_decoded = -1; ///< Frame held in m_state
+    };
+
+    template <typename WorldOf>
+    bool SnapshotWriter::WriteFrame(std::uint64_t frame, const Array<Transform *> &transforms, WorldOf &&worldOf)
+    {
+        m_rows.clear();
+        m_meshes.clear();
+        const std::uint32_t count = transforms.Size();
+        for (std::uint32_t i = 0; i < count; ++i)
+        {
+            Transform *transform = transforms[i];
+            if (!transform)
+            {
+                continue;
+            }
+
+            SnapshotRow row{};
+            row.address = reinterpret_cast<std::uintptr_t>(transform);
+            if (const math::Matrix *world = worldOf(static_cast<const Transform &>(*transform)))
+            {
+                for (std::size_t k = 0; k < 16; ++k)
+                {
+                    row.world[k] = (*world)[k];
+                }
+                row.flags |= SnapshotRow::HasWorld;
+            }
+
+            const Array<std::uintptr_t> &meshes = transform->meshes;
+            row.meshOffset = static_cast<std::uint32_t>(m_meshes.size());
+            row.meshCount = meshes.Size();
+            for (std::uint32_t m = 0; m < row.meshCount; ++m)
+            {
+                m_meshes.push_back(meshes[m]);
+            }
+            m_rows.push_back(row);
+        }
+        return WriteFrame(frame, m_rows, m_meshes);
+    }
+} // namespace abyss
+
+#endif // SNAPSHOT_H
@@ -0,0 +1,121 @@
+#ifndef TRANSFORMCACHE_H
+#define TRANSFORMCACHE_H
+
+#include <abyss/AEArray.h>
+#include <abyss/Transform.h>
+#include <abyss/math/Batch.hpp>
+#include <abyss/math/Matrix.hpp>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+namespace abyss
+{
+    /**
+     * @brief Per-frame structure-of-arrays copy of transform positions and their projection
+     *
+     * Gather() walks PaintCanvas::transforms once and copies each world position
+     * into contiguous x/y/z arrays; Project() then runs math::ProjectPoints over
+     * them in one pass. Widgets read the screen-space arrays instead of chasing
+     * Transform pointers through game memory. Buffers are reused across frames,
+     * so a steady scene does not allocate.
+     */
+    class TransformCache
+    {
+    public:
+        /**
+         * @brief Copies the world position of every transform
+         *
+         * The location of the world matrix inside abyss::Transform is not mapped
+         * yet, so the caller supplies it.
+         *
+         * @tparam WorldOf const math::Matrix *(const Transform &); nullptr skips the transform
+         * @param transforms Live transform array (null entries are skipped)
+         * @param worldOf World matrix accessor
+         */
+        template <typename WorldOf>
+        void Gather(const Array<Transform *> &transforms, WorldOf &&worldOf);
+
+        /**
+         * @brief Projects the gathered positions to the screen
+         *
+         * @param viewProjection View matrix times projection matrix (e.g. D3DTS_VIEW * D3DTS_PROJECTION)
+         * @param viewport Target rectangle
+         * @return Number of visible transforms
+         */
+        std::uint32_t Project(const math::Matrix &viewProjection, const math::Viewport &viewport);
+
+        /**
+         * @brief Drops every entry (keeps the buffers)
+         *
+         */
+        void Clear();
+
+        /**
+         * @brief Gets the number of gathered transforms
+         *
+         * @return std::uint32_t
+         */
+        std::uint32_t Size() const;
+        /**
+         * @brief Gets the number of transforms visible after the last Project()
+         *
+         * @return std::uint32_t
+         */
+        std::uint32_t VisibleCount() const;
+
+        /// @brief Source transform of entry i
+        std::span<Transform *const> Sources() const { return m_sources; }
+        /// @brief World-space positions
+        std::span<const float> X() const { return m_x; }
+        std::span<const float> Y() const { return m_y; }
+        std::span<const float> Z() const { return m_z; }
+        /// @brief Screen-space results of the last Project()
+        std::span<const float> ScreenX() const { return m_screenX; }
+        std::span<const float> ScreenY() const { return m_screenY; }
+        std::span<const float> Depth() const { return m_depth; }
+        std::span<const std::uint8_t> Visible() const { return m_visible; }
+
+    private:
+        std::vector<Transform *> m_sources;
+        std::vector<float> m_x;
+        std::vector<float> m_y;
+        std::vector<float> m_z;
+        std::vector<float> m_screenX;
+        std::vector<float> m_screenY;
+        std::vector<float> m_depth;
+        std::vector<std::uint8_t> m_visible;
+        std::uint32_t m_visibleCount = 0;
+    };
+
+    template <typename WorldOf>
+    void TransformCache::Gather(const Array<Transform *> &transforms, WorldOf &&worldOf)
+    {
+        Clear();
+        const std::uint32_t count = transforms.Size();
+        m_sources.reserve(count);
+        m_x.reserve(count);
+        m_y.reserve(count);
+        m_z.reserve(count);
+
+        for (std::uint32_t i = 0; i < count; ++i)
+        {
+            Transform *transform = transforms[i];
+            if (!transform)
+            {
+                continue;
+            }
+            const math::Matrix *world = worldOf(static_cast<const Transform &>(*transform));
+            if (!world)
+            {
+                continue;
+            }
+            m_sources.push_back(transform);
+            m_x.push_back((*world)[12]);
+            m_y.push_back((*world)[13]);
+            m_z.push_back((*world)[14]);
+        }
+    }
+} // namespace abyss
+
+#endif // TRANSFORMCACHE_H
@@ -0,0 +1,138 @@
+#ifndef TRANSFORMOBSERVER_H
+#define TRANSFORMOBSERVER_H
+
+#include <abyss/AEArray.h>
+#include <abyss/Transform.h>
+#include <abyss/math/Matrix.hpp>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+namespace abyss
+{
+    /**
+     * @brief Frame-to-frame change events of PaintCanvas::transforms
+     *
+     * Update() keeps the previous frame as a list of (transform, matrix hash)
+     * pairs in array order. The new frame is walked against it: the common
+     * prefix, all of a steady scene, needs no lookup. Past the first
+     * difference, the previous transforms go into an open-addressing set, so
+     * added and removed transforms are found without sorting. A transform
+     * counts as moved when the hash of its world matrix changed; the hashes
+     * of all surviving transforms are compared four at a time.
+     * Consumers read the three event lists instead of rescanning the array.
+     * Buffers are reused across frames, so a steady scene does not allocate.
+     */
+    class TransformObserver
+    {
+    public:
+        /**
+         * @brief Diffs the live transforms against the previous Update()
+         *
+         * The first Update() (and the first after Reset()) reports every
+         * transform as added. Null entries and duplicates are ignored.
+         *
+         * @tparam WorldOf const math::Matrix *(const Transform &); nullptr means "no matrix", which never counts as a move
+         * @param transforms Live transform array
+         * @param worldOf World matrix accessor (see TransformCache::Gather)
+         */
+        template <typename WorldOf>
+        void Update(const Array<Transform *> &transforms, WorldOf &&worldOf);
+
+        /**
+         * @brief Diffs membership only: no transform is ever reported as moved
+         *
+         * @param transforms Live transform array
+         */
+        void Update(const Array<Transform *> &transforms);
+
+        /**
+         * @brief Forgets the previous frame and the events
+         *
+         */
+        void Reset();
+
+        /// @brief Transforms that appeared since the previous Update(), in array order
+        std::span<Transform *const> Added() const { return m_added; }
+        /// @brief Transforms that disappeared, in the previous frame's array order. They may be freed: compare, do not dereference
+        std::span<Transform *const> Removed() const { return m_removed; }
+        /// @brief Transforms present in both frames whose world matrix changed, in array order
+        std::span<Transform *const> Moved() const { return m_moved; }
+
+        /// @brief Whether the last Update() produced any event
+        bool Changed() const { return !m_added.empty() || !m_removed.empty() || !m_moved.empty(); }
+
+        /**
+         * @brief Gets the number of transforms seen by the last Update()
+         *
+         * @return std::uint32_t
+         */
+        std::uint32_t Size() const;
+
+        /**
+         * @brief Hash used for move detection (0 for no matrix)
+         *
+         * Bitwise over the 16 floats: -0.0f and 0.0f differ, and a NaN
+         * matrix hashes the same every frame.
+         *
+         * @param world Matrix, possibly in game memory (no alignment assumed)
+         * @return std::uint32_t
+         */
+        static std::uint32_t HashMatrix(const math::Matrix *world);
+
+    private:
+        struct Entry
+        {
+            Transform *transform;
+            std::uint32_t hash;
+        };
+
+        /// Diffs m_current against m_previous, drops duplicates from m_current and swaps them
+        void Diff();
+        /// Diff past the common prefix of both frames, through m_slots
+        void DiffTail(std::size_t prefix);
+        /// Slot of a transform in m_slots: its own, or the empty one where it belongs
+        std::size_t FindSlot(const Transform *transform) const;
+        void Keep(Transform *transform, std::uint32_t oldHash, std::uint32_t newHash);
+
+        struct Slot
+        {
+            Transform *transform; ///< nullptr for an empty slot
+            std::uint32_t oldHash;
+            bool current;         ///< Seen in the new frame (or settled by the prefix)
+        };
+
+        std::vector<Entry> m_previous;
+        std::vector<Entry> m_current;
+        // Open-addressing set of the previous frame, rebuilt only on frames whose membership or order changed
+        std::vector<Slot> m_slots;
+        // Transforms present in both frames, with their old and new hashes side by side
+        std::vector<Transform *> m_kept;
+        std::vector<std::uint32_t> m_oldHashes;
+        std::vector<std::uint32_t> m_newHashes;
+        std::vector<Transform *> m_added;
+        std::vector<Transform *> m_removed;
+        std::vector<Transform *> m_moved;
+    };
+
+    template <typename WorldOf>
+    void TransformObserver::Update(const Array<Transform *> &transforms, WorldOf &&worldOf)
+    {
+        const std::uint32_t count = transforms.Size();
+        m_current.clear();
+        m_current.reserve(count);
+        for (std::uint32_t i = 0; i < count; ++i)
+        {
+            Transform *transform = transforms[i];
+            if (!transform)
+            {
+                continue;
+            }
+            const math::Matrix *world = worldOf(static_cast<const Transform &>(*transform));
+            m_current.push_back({transform, HashMatrix(world)});
+        }
+        Diff();
+    }
+} // namespace abyss
+
+#endif // TRANSFORMOBSERVER_H
@@ -0,0 +1,104 @@
+#ifndef UTF_H
+#define UTF_H
+
+#include <cstddef>
+#include <span>
+#include <string>
+#include <string_view>
+
+/**
+ * @brief UTF-8 <-> UTF-16 transcoding for abyss strings
+ *
+ * Every conversion is a single pass into a buffer the caller provides (or a
+ * thread-local scratch buffer), so sizing by the Max* bounds below and
+ * converting never calls the allocator. Runs of ASCII are converted 16
+ * characters at a time with SSE2. Invalid input is replaced with U+FFFD, as
+ * MultiByteToWideChar and WideCharToMultiByte do without MB_ERR_INVALID_CHARS.
+ * wchar_t is UTF-16 on Windows; where it is 32 bits wide it holds UTF-32.
+ */
+namespace abyss::utf
+{
+    /**
+     * @brief Upper bound of the wide units produced by a UTF-8 string of utf8Bytes bytes
+     *
+     * @param utf8Bytes
+     * @return constexpr std::size_t
+     */
+    constexpr std::size_t MaxWideLength(std::size_t utf8Bytes)
+    {
+        return utf8Bytes;
+    }
+    /**
+     * @brief Upper bound of the UTF-8 bytes produced by wideUnits wide units
+     *
+     * @param wideUnits
+     * @return constexpr std::size_t
+     */
+    constexpr std::size_t MaxUtf8Length(std::size_t wideUnits)
+    {
+        return wideUnits * (sizeof(wchar_t) == 2 ? 3 : 4);
+    }
+
+    /**
+     * @brief Converts UTF-8 to wide characters
+     *
+     * Stops at the last whole code point that fits if out is smaller than
+     * MaxWideLength(utf8.size()). No terminator is written.
+     *
+     * @param utf8
+     * @param out
+     * @return std::size_t Number of wide units written
+     */
+    std::size_t ToWide(std::string_view utf8, std::span<wchar_t> out);
+    /**
+     * @brief Converts UTF-8 to UTF-16
+     *
+     * @param utf8
+     * @param out
+     * @return std::size_t Number of UTF-16 units written
+     */
+    std::size_t ToUtf16(std::string_view utf8, std::span<char16_t> out);
+    /**
+     * @brief Converts wide characters to UTF-8
+     *
+     * Stops at the last whole code point that fits if out is smaller than
+     * MaxUtf8Length(wide.size()). No terminator is written.
+     *
+     * @param wide
+     * @param out
+     * @return std::size_t Number of bytes written
+     */
+    std::size_t ToUtf8(std::wstring_view wide, std::span<char> out);
+    /**
+     * @brief Converts UTF-16 to UTF-8
+     *
+     * @param utf16
+     * @param out
+     * @return std::size_t Number of bytes written
+     */
+    std::size_t ToUtf8(std::u16string_view utf16, std::span<char> out);
+    /**
+     * @brief Appends the UTF-8 form of wide to out; allocates only if out lacks the capacity
+     *
+     * @param wide
+     * @param out
+     */
+    void AppendUtf8(std::wstring_view wide, std::string &out);
+
+    /**
+     * @brief Converts into a thread-local buffer that only grows
+     *
+     * @param utf8
+     * @return std::wstring_view Valid until the next scratch conversion on this thread
+     */
+    std::wstring_view ToWideScratch(std::string_view utf8);
+    /**
+     * @brief Converts into a thread-local buffer that only grows
+     *
+     * @param wide
+     * @return std::string_view Valid until the next scratch conversion on this thread
+     */
+    std::string_view ToUtf8Scratch(std::wstring_view wide);
+}
+
+#endif // UTF_H
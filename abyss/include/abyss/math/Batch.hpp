@@ -0,0 +1,101 @@
+#ifndef MATH_BATCH
+#define MATH_BATCH
+#include <abyss/math/Matrix.hpp>
+#include <abyss/math/Vector.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+
+namespace abyss
+{
+    namespace math
+    {
+        /**
+         * @brief Transforms points by a matrix (out[i] = m.Transform(in[i]))
+         *
+         * Uses SSE2 four points at a time when available. out may be the same span as in.
+         *
+         * @param m Matrix to apply
+         * @param in Points to transform
+         * @param out Destination, at least in.size() elements
+         */
+        void TransformPoints(const Matrix &m, std::span<const Vector> in, std::span<Vector> out);
+        /**
+         * @brief Rotates directions by a matrix, ignoring its position (out[i] = m.Rotate(in[i]))
+         *
+         * @param m Matrix to apply
+         * @param in Directions to rotate
+         * @param out Destination, at least in.size() elements
+         */
+        void RotateVectors(const Matrix &m, std::span<const Vector> in, std::span<Vector> out);
+        /**
+         * @brief Multiplies matrices pairwise (out[i] = a[i] * b[i])
+         *
+         * @param a Left operands
+         * @param b Right operands, at least a.size() elements
+         * @param out Destination, at least a.size() elements
+         */
+        void MultiplyMatrices(std::span<const Matrix> a, std::span<const Matrix> b, std::span<Matrix> out);
+        /**
+         * @brief Multiplies every matrix by the same matrix (out[i] = a[i] * b), e.g. world * viewProjection
+         *
+         * @param a Left operands
+         * @param b Right operand
+         * @param out Destination, at least a.size() elements
+         */
+        void MultiplyMatrices(std::span<const Matrix> a, const Matrix &b, std::span<Matrix> out);
+
+        /**
+         * @brief Screen rectangle the projected points are mapped to (D3DVIEWPORT9 X/Y/Width/Height)
+         *
+         */
+        struct Viewport
+        {
+            float x = 0.0f;
+            float y = 0.0f;
+            float width = 0.0f;
+            float height = 0.0f;
+        };
+
+        /**
+         * @brief World-space points as separate x/y/z arrays
+         *
+         */
+        struct PointSpans
+        {
+            std::span<const float> x;
+            std::span<const float> y;
+            std::span<const float> z;
+        };
+
+        /**
+         * @brief Projection results as separate arrays
+         *
+         */
+        struct ScreenSpans
+        {
+            std::span<float> x;              ///< Screen x in pixels
+            std::span<float> y;              ///< Screen y in pixels (down)
+            std::span<float> depth;          ///< Depth in [0, 1] when visible
+            std::span<std::uint8_t> visible; ///< 1 if the point is inside the view volume
+        };
+
+        /**
+         * @brief Projects points to the screen with a view * projection matrix (D3D clip space)
+         *
+         * Works on structure-of-arrays input so the SSE2 path handles four points per
+         * iteration without shuffles. The count is the smallest span size. Points
+         * behind the camera or outside the frustum get visible = 0; their screen
+         * coordinates are left undefined.
+         *
+         * @param viewProjection View matrix times projection matrix
+         * @param viewport Target rectangle
+         * @param in World-space positions
+         * @param out Screen-space results
+         * @return Number of points processed
+         */
+        std::size_t ProjectPoints(const Matrix &viewProjection, const Viewport &viewport, const PointSpans &in, const ScreenSpans &out);
+    }
+} // namespace abyss
+
+#endif /* MATH_BATCH */
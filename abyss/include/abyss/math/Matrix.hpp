@@ -30,15 +30,17 @@ namespace abyss
         public:
             /// @brief Returns zero matrix
             Matrix();
+            /// @brief Copies a matrix
+            Matrix(const Matrix &) = default;
             /// @brief Destroys the matrix
-            ~Matrix();
+            ~Matrix() = default;
 
             /**
              * @brief Operator =
              *
-             * @return abyss::math::Matrix
+             * @return abyss::math::Matrix&
              */
-            abyss::math::Matrix operator=(const abyss::math::Matrix &) const;
+            abyss::math::Matrix &operator=(const abyss::math::Matrix &) = default;
             /**
              * @brief Multiply two matrices
              *
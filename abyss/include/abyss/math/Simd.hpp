@@ -0,0 +1,18 @@
+#ifndef MATH_SIMD
+#define MATH_SIMD
+
+/**
+ * @brief SIMD selection for abyss::math
+ *
+ * ABYSS_MATH_SSE2 is 1 when the compiler targets SSE2 (MSVC x86 does by
+ * default, /arch:SSE2), 0 otherwise. Define ABYSS_MATH_NO_SIMD to force the
+ * scalar paths, e.g. to compare results against them.
+ */
+#if !defined(ABYSS_MATH_NO_SIMD) && (defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2))
+#define ABYSS_MATH_SSE2 1
+#include <emmintrin.h>
+#else
+#define ABYSS_MATH_SSE2 0
+#endif
+
+#endif /* MATH_SIMD */
@@ -20,11 +20,19 @@ namespace abyss
              *
              */
             Vector();
+            /**
+             * @brief Construct a new Vector object from its components
+             *
+             * @param x
+             * @param y
+             * @param z
+             */
+            Vector(float x, float y, float z);
             /**
              * @brief Destroy the Vector object
              *
              */
-            ~Vector();
+            ~Vector() = default;
 
             /**
              * @brief Adds two vectors
@@ -1,4 +1,5 @@
 #ifndef ABYSS_OFFSETS_OFFSETS_HPP
 #define ABYSS_OFFSETS_OFFSETS_HPP
 #include <abyss/offsets/pc.hpp>
+#include <abyss/offsets/resolver.hpp>
 #endif // ABYSS_OFFSETS_OFFSETS_HPP
\ No newline at end of file
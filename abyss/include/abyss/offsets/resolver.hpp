@@ -0,0 +1,138 @@
+#ifndef ABYSS_OFFSETS_RESOLVER_HPP
+#define ABYSS_OFFSETS_RESOLVER_HPP
+
+#include <abyss/offsets/scanner.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <span>
+#include <vector>
+
+namespace abyss::offsets
+{
+    /**
+     * @brief How the address of a signature is derived from its match
+     *
+     */
+    enum class SignatureKind : std::uint8_t
+    {
+        Address,  ///< Match address + adjust (function start)
+        Absolute, ///< 32-bit address stored at match + adjust (mov ecx, [global])
+        Relative, ///< rel32 target at match + adjust (call/jmp)
+        Import    ///< Import address table slot; pattern is "module!symbol", module "*" for any
+    };
+
+    /**
+     * @brief One entry of an offset table
+     *
+     */
+    struct Signature
+    {
+        const char *name;
+        SignatureKind kind;
+        const char *pattern;     ///< nullptr: no signature known, the fallback is always used
+        std::int32_t adjust;
+        std::uintptr_t fallback; ///< Address of the known build (pc.hpp)
+    };
+
+    /**
+     * @brief Where a resolved address came from
+     *
+     */
+    enum class OffsetSource : std::uint8_t
+    {
+        Fallback,
+        Cache,
+        Scan
+    };
+
+    /**
+     * @brief Outcome of Resolver::Resolve
+     *
+     */
+    struct ResolveReport
+    {
+        std::uint32_t cached = 0;    ///< Entries taken from the cache file
+        std::uint32_t scanned = 0;   ///< Entries found by scanning
+        std::uint32_t fallback = 0;  ///< Entries left at their pc.hpp address
+        bool cacheWritten = false;
+        std::uint64_t microseconds = 0;
+    };
+
+    /**
+     * @brief Resolves an offset table against a loaded module
+     *
+     * Patterns are searched in every executable section at once: the sections
+     * are cut into overlapping chunks that worker threads scan for all pending
+     * patterns, keeping the lowest match of each. Results are stored as module
+     * offsets in a cache file keyed by the image's link time stamp, checksum,
+     * size and the table itself, so a later launch of the same executable
+     * reads them back without scanning.
+     */
+    class Resolver
+    {
+    public:
+        /**
+         * @brief Resolves every entry of the table
+         *
+         * @param image Module to scan
+         * @param table Offset table; must outlive the resolver
+         * @param cachePath Cache file (empty: no cache)
+         * @return Counts per source
+         */
+        ResolveReport Resolve(const ModuleImage &image, std::span<const Signature> table, const std::filesystem::path &cachePath);
+
+        /// @brief Resolved address of entry i, its fallback if unresolved (0 before Resolve)
+        std::uintptr_t Get(std::size_t index) const;
+        OffsetSource SourceOf(std::size_t index) const;
+
+    private:
+        bool LoadCache(const ModuleImage &image, const std::filesystem::path &path, std::uint32_t tableHash);
+        bool SaveCache(const ModuleImage &image, const std::filesystem::path &path, std::uint32_t tableHash) const;
+        void Scan(const ModuleImage &image);
+
+        std::span<const Signature> m_table;
+        std::uintptr_t m_base = 0;
+        std::vector<std::uint32_t> m_rvas; ///< Resolved offsets, NoOffset where unresolved
+        std::vector<OffsetSource> m_sources;
+    };
+
+    /**
+     * @brief Entries of the offset table of this build
+     *
+     */
+    enum class Id : std::size_t
+    {
+        Canvas,
+        GlobalsInit,
+        Malloc,
+        Free,
+        Realloc,
+        NewArray,
+        DeleteArray,
+        Count
+    };
+
+    /// @brief Offset table of the game, indexed by Id
+    std::span<const Signature> Signatures();
+
+    /**
+     * @brief Resolves the offset table against the game executable
+     *
+     * Call once at startup, before anything reads Get().
+     *
+     * @param moduleBase Base of the game executable (GetModuleHandle(nullptr))
+     * @param cachePath Cache file
+     * @return Counts per source
+     */
+    ResolveReport Initialize(const void *moduleBase, const std::filesystem::path &cachePath);
+
+    /**
+     * @brief Address of an offset table entry
+     *
+     * @return The resolved address, or the pc.hpp address before Initialize()
+     */
+    std::uintptr_t Get(Id id);
+} // namespace abyss::offsets
+
+#endif // ABYSS_OFFSETS_RESOLVER_HPP
@@ -0,0 +1,136 @@
+#ifndef ABYSS_OFFSETS_SCANNER_HPP
+#define ABYSS_OFFSETS_SCANNER_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <string_view>
+#include <vector>
+
+namespace abyss::offsets
+{
+    /**
+     * @brief Byte pattern with wildcards
+     *
+     * Parsed from IDA style text: hexadecimal bytes separated by spaces, "?" or
+     * "??" for a byte that may take any value ("8B 0D ?? ?? ?? ?? 85 C9").
+     */
+    class Pattern
+    {
+    public:
+        Pattern() = default;
+
+        /**
+         * @brief Parses a pattern
+         *
+         * @param text Pattern text; malformed text or a pattern of wildcards only gives an empty pattern
+         */
+        explicit Pattern(std::string_view text);
+
+        bool Empty() const { return m_bytes.empty(); }
+        std::size_t Size() const { return m_bytes.size(); }
+
+        /// @brief Pattern bytes (0 under a wildcard)
+        std::span<const std::uint8_t> Bytes() const { return m_bytes; }
+        /// @brief 0xFF for a concrete byte, 0 for a wildcard
+        std::span<const std::uint8_t> Mask() const { return m_mask; }
+
+        /**
+         * @brief Compares the pattern against Size() bytes
+         *
+         * @param at First byte to compare
+         */
+        bool Matches(const std::uint8_t *at) const;
+
+        /// @brief Indices of the first and last concrete byte, compared 16 positions at a time by Find()
+        std::size_t FirstAnchor() const { return m_first; }
+        std::size_t LastAnchor() const { return m_last; }
+
+    private:
+        std::vector<std::uint8_t> m_bytes;
+        std::vector<std::uint8_t> m_mask;
+        std::size_t m_first = 0;
+        std::size_t m_last = 0;
+    };
+
+    /// @brief Returned by Find() without a match
+    constexpr std::size_t NotFound = static_cast<std::size_t>(-1);
+
+    /**
+     * @brief Finds the first occurrence of a pattern
+     *
+     * With SSE2 both anchor bytes are compared against 16 candidate positions
+     * per step (_mm_cmpeq_epi8); only positions where both match are compared
+     * in full.
+     *
+     * @param haystack Bytes to search
+     * @param pattern Non-empty pattern
+     * @return Offset of the match in haystack, or NotFound
+     */
+    std::size_t Find(std::span<const std::uint8_t> haystack, const Pattern &pattern);
+
+    /**
+     * @brief Executable section of a loaded module
+     *
+     */
+    struct CodeSection
+    {
+        char name[9];                      ///< Section name (".text"), zero terminated
+        std::uint32_t rva;                 ///< Offset from the module base
+        std::span<const std::uint8_t> bytes;
+    };
+
+    /**
+     * @brief PE headers of a module loaded in this process
+     *
+     * Reads the headers in place; the image must stay loaded while the view is used.
+     */
+    class ModuleImage
+    {
+    public:
+        /**
+         * @brief Reads the headers of a loaded module
+         *
+         * @param base Module base (HMODULE)
+         * @return false if base does not point to a PE image
+         */
+        bool Parse(const void *base);
+
+        std::uintptr_t Base() const { return reinterpret_cast<std::uintptr_t>(m_base); }
+        std::uint32_t SizeOfImage() const { return m_sizeOfImage; }
+        /// @brief Link time stamp of the file header
+        std::uint32_t TimeDateStamp() const { return m_timeDateStamp; }
+        /// @brief Checksum of the optional header (0 unless the linker wrote one)
+        std::uint32_t CheckSum() const { return m_checkSum; }
+
+        /// @brief Sections marked as code or executable
+        std::span<const CodeSection> CodeSections() const { return m_sections; }
+
+        /**
+         * @brief Finds the import address table slot of an imported function
+         *
+         * @param module Importing DLL name (case insensitive), or "*" for any
+         * @param symbol Function name (decorated, as the linker imports it)
+         * @return Offset of the slot from the module base, 0 if not imported by name
+         */
+        std::uint32_t FindImport(std::string_view module, std::string_view symbol) const;
+
+        /// @brief Whether an offset lies inside the image
+        bool Contains(std::uint32_t rva, std::uint32_t size = 1) const
+        {
+            return rva < m_sizeOfImage && size <= m_sizeOfImage - rva;
+        }
+
+    private:
+        const std::uint8_t *m_base = nullptr;
+        std::uint32_t m_sizeOfImage = 0;
+        std::uint32_t m_timeDateStamp = 0;
+        std::uint32_t m_checkSum = 0;
+        bool m_pe64 = false;
+        std::uint32_t m_importRva = 0;
+        std::uint32_t m_importSize = 0;
+        std::vector<CodeSection> m_sections;
+    };
+} // namespace abyss::offsets
+
+#endif // ABYSS_OFFSETS_SCANNER_HPP
@@ -14,5 +14,15 @@ namespace abyss {
         inline realloc_t realloc = *reinterpret_cast<realloc_t*>(abyss::offsets::functions::stdlib::realloc);
         inline newarray_t newarray = *reinterpret_cast<newarray_t*>(abyss::offsets::functions::stdlib::newarray);
         inline deletearray_t deletearray = *reinterpret_cast<deletearray_t*>(abyss::offsets::functions::stdlib::deletearray);
+
+        /// Reloads the functions from the import slots found by abyss::offsets::Initialize (before hooking them)
+        inline void Bind() {
+            using abyss::offsets::Id;
+            malloc = *reinterpret_cast<malloc_t*>(abyss::offsets::Get(Id::Malloc));
+            free = *reinterpret_cast<free_t*>(abyss::offsets::Get(Id::Free));
+            realloc = *reinterpret_cast<realloc_t*>(abyss::offsets::Get(Id::Realloc));
+            newarray = *reinterpret_cast<newarray_t*>(abyss::offsets::Get(Id::NewArray));
+            deletearray = *reinterpret_cast<deletearray_t*>(abyss::offsets::Get(Id::DeleteArray));
+        }
     }
 }
\ No newline at end of file
@@ -5,5 +5,10 @@ namespace gof2 {
     namespace globals {
         using init_t = std::uintptr_t (__stdcall*)(std::uintptr_t, std::uintptr_t, std::uintptr_t);
         inline init_t init = reinterpret_cast<init_t>(abyss::offsets::functions::globals::init);
+
+        /// Reloads the functions from the addresses found by abyss::offsets::Initialize
+        inline void Bind() {
+            init = reinterpret_cast<init_t>(abyss::offsets::Get(abyss::offsets::Id::GlobalsInit));
+        }
     }
 }
\ No newline at end of file
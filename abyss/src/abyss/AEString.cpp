@@ -1,9 +1,9 @@
 #include <abyss/AEString.h>
+#include <abyss/Utf.h>
 #include <wchar.h>
 #include <yu/memory.h>
 #include <locale>
 #include <cstdlib>
-#include <Windows.h>
 
 
 
@@ -69,13 +69,11 @@ namespace abyss {
     }
 
     String::String(std::string_view sv) {
-        // Convert UTF-8 string_view to wide string
-        int wideLen = MultiByteToWideChar(CP_UTF8, 0, sv.data(), static_cast<int>(sv.size()), nullptr, 0);
-        if (wideLen > 0) {
-            text = yu::mem::NewArray<wchar_t>(wideLen + 1, AEStringTag);
-            MultiByteToWideChar(CP_UTF8, 0, sv.data(), static_cast<int>(sv.size()), text, wideLen);
-            text[wideLen] = L'\0';
-            length = static_cast<std::uint32_t>(wideLen);
+        // Single pass into a buffer sized for the worst case (exact for ASCII)
+        if (!sv.empty()) {
+            text = yu::mem::NewArray<wchar_t>(utf::MaxWideLength(sv.size()) + 1, AEStringTag);
+            length = static_cast<std::uint32_t>(utf::ToWide(sv, std::span<wchar_t>(text, utf::MaxWideLength(sv.size()))));
+            text[length] = L'\0';
         } else {
             text = nullptr;
             length = 0;
@@ -99,7 +97,7 @@ namespace abyss {
         // Treat empty strings as equal regardless of internal pointer state
         if (length == 0 && other.length == 0) return true;
         if (text == nullptr || other.text == nullptr) return false;
-        return std::wcscmp(text, other.text) == 0;
+        return std::wmemcmp(text, other.text, length) == 0;
     }
 
     bool String::operator!=(const String& other) const {
@@ -111,17 +109,21 @@ namespace abyss {
     }
 
     std::string String::ToUTF8() const {
-        if (!text) return std::string();
-
-        int utf8Len = WideCharToMultiByte(CP_UTF8, 0, text, static_cast<int>(length), nullptr, 0, nullptr, nullptr);
-        if (utf8Len <= 0) return std::string();
-
         std::string result;
-        result.resize(static_cast<std::size_t>(utf8Len));
-        WideCharToMultiByte(CP_UTF8, 0, text, static_cast<int>(length), result.data(), utf8Len, nullptr, nullptr);
+        AppendUTF8(result);
         return result;
     }
 
+    std::size_t String::ToUTF8(std::span<char> out) const {
+        return text ? utf::ToUtf8(std::wstring_view(text, length), out) : 0;
+    }
+
+    void String::AppendUTF8(std::string& out) const {
+        if (text) {
+            utf::AppendUtf8(std::wstring_view(text, length), out);
+        }
+    }
+
     bool String::IsValid() const {
         return text != nullptr;
     }
@@ -0,0 +1,344 @@
+#include <abyss/Interner.h>
+#include <abyss/Utf.h>
+#include <yu/memory_os.h>
+#include <cstring>
+#include <cwchar>
+
+namespace abyss
+{
+    namespace
+    {
+        constexpr std::size_t BlockSize = 64 * 1024;
+        constexpr std::uint32_t InitialSlots = 1024;
+        constexpr std::size_t StackConvertUnits = 256;
+
+        std::uint32_t HashChars(std::wstring_view str)
+        {
+            // FNV-1a over the wide code units
+            std::uint32_t h = 2166136261u;
+            for (wchar_t c : str)
+            {
+                h = (h ^ static_cast<std::uint32_t>(c)) * 16777619u;
+            }
+            return h;
+        }
+
+        std::size_t AlignUp(std::size_t value, std::size_t alignment)
+        {
+            return (value + alignment - 1) & ~(alignment - 1);
+        }
+    }
+
+    // Open-addressed slots packed as (hash << 32 | id); 0 is an empty slot.
+    // Aligned so the 64-bit slots after the header stay naturally aligned on x86.
+    struct alignas(std::uint64_t) Interner::Table
+    {
+        Table *previous;
+        std::size_t bytes;
+        std::uint32_t mask;
+
+        std::atomic<std::uint64_t> *Slots()
+        {
+            return reinterpret_cast<std::atomic<std::uint64_t> *>(this + 1);
+        }
+
+        const std::atomic<std::uint64_t> *Slots() const
+        {
+            return reinterpret_cast<const std::atomic<std::uint64_t> *>(this + 1);
+        }
+    };
+
+    // Bump arena block; the payload follows the header
+    struct Interner::Block
+    {
+        Block *next;
+        std::size_t bytes;
+        std::size_t used;
+    };
+
+    Interner::~Interner()
+    {
+        for (Table *table = m_table.load(std::memory_order_relaxed); table;)
+        {
+            Table *previous = table->previous;
+            yu::mem::os::FreePages(table, table->bytes);
+            table = previous;
+        }
+        for (auto &chunk : m_chunks)
+        {
+            yu::mem::os::FreePages(chunk.load(std::memory_order_relaxed), sizeof(Entry) * EntriesPerChunk);
+        }
+        for (Block *block = m_blocks; block;)
+        {
+            Block *next = block->next;
+            yu::mem::os::FreePages(block, block->bytes);
+            block = next;
+        }
+    }
+
+    Interner &Interner::Global()
+    {
+        static Interner interner;
+        return interner;
+    }
+
+    InternId Interner::Intern(std::wstring_view str)
+    {
+        const std::uint32_t hash = HashChars(str);
+        if (const InternId id = FindIn(m_table.load(std::memory_order_acquire), str, hash))
+        {
+            return id;
+        }
+
+        std::lock_guard lock(m_mutex);
+        // Another thread may have added it since the lock-free probe
+        if (const InternId id = FindIn(m_table.load(std::memory_order_relaxed), str, hash))
+        {
+            return id;
+        }
+
+        const std::uint32_t count = m_count.load(std::memory_order_relaxed);
+        if (count >= MaxEntries - 1)
+        {
+            return InvalidInternId;
+        }
+        const Table *table = m_table.load(std::memory_order_relaxed);
+        if (!table || (count + 1) * 2 > table->mask + 1)
+        {
+            if (!Grow())
+            {
+                return InvalidInternId;
+            }
+        }
+
+        // Ids start at 1, so id - 1 indexes the entry chunks
+        const InternId id = count + 1;
+        std::atomic<Entry *> &chunkSlot = m_chunks[(id - 1) / EntriesPerChunk];
+        Entry *chunk = chunkSlot.load(std::memory_order_relaxed);
+        if (!chunk)
+        {
+            chunk = static_cast<Entry *>(yu::mem::os::AllocatePages(sizeof(Entry) * EntriesPerChunk));
+            if (!chunk)
+            {
+                return InvalidInternId;
+            }
+            m_footprint.fetch_add(sizeof(Entry) * EntriesPerChunk, std::memory_order_relaxed);
+            chunkSlot.store(chunk, std::memory_order_release);
+        }
+
+        auto *text = static_cast<wchar_t *>(ArenaAllocate(sizeof(wchar_t) * (str.size() + 1), alignof(wchar_t)));
+        if (!text)
+        {
+            return InvalidInternId;
+        }
+        if (!str.empty())
+        {
+            std::wmemcpy(text, str.data(), str.size());
+        }
+        text[str.size()] = L'\0';
+
+        Entry &entry = chunk[(id - 1) % EntriesPerChunk];
+        entry.wide = text;
+        entry.length = static_cast<std::uint32_t>(str.size());
+        entry.hash = hash;
+
+        // Publish: the entry is complete and its id resolvable (EntryOf checks
+        // m_count) before the slot store lets a reader find it
+        m_count.store(id, std::memory_order_release);
+        Table *current = m_table.load(std::memory_order_relaxed);
+        for (std::uint32_t i = hash & current->mask;; i = (i + 1) & current->mask)
+        {
+            std::atomic<std::uint64_t> &slot = current->Slots()[i];
+            if (slot.load(std::memory_order_relaxed) == 0)
+            {
+                slot.store((static_cast<std::uint64_t>(hash) << 32) | id, std::memory_order_release);
+                break;
+            }
+        }
+        return id;
+    }
+
+    InternId Interner::Intern(std::string_view utf8Str)
+    {
+        // Convert on the stack (or in OS pages), never on the CRT heap
+        wchar_t stackBuffer[StackConvertUnits];
+        const std::size_t capacity = utf::MaxWideLength(utf8Str.size());
+        wchar_t *buffer = stackBuffer;
+        if (capacity > StackConvertUnits)
+        {
+            buffer = static_cast<wchar_t *>(yu::mem::os::AllocatePages(sizeof(wchar_t) * capacity));
+            if (!buffer)
+            {
+                return InvalidInternId;
+            }
+        }
+
+        const std::size_t length = utf::ToWide(utf8Str, std::span<wchar_t>(buffer, capacity));
+        const InternId id = Intern(std::wstring_view(buffer, length));
+        if (buffer != stackBuffer)
+        {
+            yu::mem::os::FreePages(buffer, sizeof(wchar_t) * capacity);
+        }
+        return id;
+    }
+
+    InternId Interner::Intern(const String &str)
+    {
+        return Intern(std::wstring_view(str.c_str(), str.size()));
+    }
+
+    InternId Interner::Find(std::wstring_view str) const
+    {
+        return FindIn(m_table.load(std::memory_order_acquire), str, HashChars(str));
+    }
+
+    std::wstring_view Interner::Wide(InternId id) const
+    {
+        const Entry *entry = EntryOf(id);
+        return entry ? std::wstring_view(entry->wide, entry->length) : std::wstring_view();
+    }
+
+    std::string_view Interner::Utf8(InternId id)
+    {
+        const Entry *entry = EntryOf(id);
+        if (!entry)
+        {
+            return std::string_view();
+        }
+        if (const char *cached = entry->utf8.load(std::memory_order_acquire))
+        {
+            return std::string_view(cached, entry->utf8Length);
+        }
+
+        std::lock_guard lock(m_mutex);
+        Entry &mutableEntry = const_cast<Entry &>(*entry);
+        if (const char *cached = mutableEntry.utf8.load(std::memory_order_relaxed))
+        {
+            return std::string_view(cached, mutableEntry.utf8Length);
+        }
+
+        const std::size_t capacity = utf::MaxUtf8Length(entry->length);
+        auto *text = static_cast<char *>(ArenaAllocate(capacity + 1, 1));
+        if (!text)
+        {
+            return std::string_view();
+        }
+        const std::size_t length = utf::ToUtf8(std::wstring_view(entry->wide, entry->length), std::span<char>(text, capacity));
+        text[length] = '\0';
+        // Give the unused tail back to the arena (text is the last allocation)
+        m_blocks->used -= capacity - length;
+
+        mutableEntry.utf8Length = static_cast<std::uint32_t>(length);
+        mutableEntry.utf8.store(text, std::memory_order_release);
+        return std::string_view(text, length);
+    }
+
+    std::uint32_t Interner::Size() const
+    {
+        return m_count.load(std::memory_order_acquire);
+    }
+
+    std::size_t Interner::Footprint() const
+    {
+        return m_footprint.load(std::memory_order_relaxed);
+    }
+
+    const Interner::Entry *Interner::EntryOf(InternId id) const
+    {
+        if (id == InvalidInternId || id > m_count.load(std::memory_order_acquire))
+        {
+            return nullptr;
+        }
+        const Entry *chunk = m_chunks[(id - 1) / EntriesPerChunk].load(std::memory_order_acquire);
+        return &chunk[(id - 1) % EntriesPerChunk];
+    }
+
+    InternId Interner::FindIn(const Table *table, std::wstring_view str, std::uint32_t hash) const
+    {
+        if (!table)
+        {
+            return InvalidInternId;
+        }
+        for (std::uint32_t i = hash & table->mask;; i = (i + 1) & table->mask)
+        {
+            const std::uint64_t slot = table->Slots()[i].load(std::memory_order_acquire);
+            if (slot == 0)
+            {
+                return InvalidInternId;
+            }
+            if (static_cast<std::uint32_t>(slot >> 32) != hash)
+            {
+                continue;
+            }
+            const auto id = static_cast<InternId>(slot);
+            const Entry *entry = &m_chunks[(id - 1) / EntriesPerChunk].load(std::memory_order_acquire)[(id - 1) % EntriesPerChunk];
+            if (entry->length == str.size() && (str.empty() || std::wmemcmp(entry->wide, str.data(), str.size()) == 0))
+            {
+                return id;
+            }
+        }
+    }
+
+    bool Interner::Grow()
+    {
+        // Called with m_mutex held. The old table stays readable for lock-free probes in flight.
+        Table *old = m_table.load(std::memory_order_relaxed);
+        const std::uint32_t slots = old ? (old->mask + 1) * 2 : InitialSlots;
+        const std::size_t bytes = sizeof(Table) + sizeof(std::uint64_t) * slots;
+        auto *table = static_cast<Table *>(yu::mem::os::AllocatePages(bytes));
+        if (!table)
+        {
+            return false;
+        }
+        table->previous = old;
+        table->bytes = bytes;
+        table->mask = slots - 1;
+
+        const std::uint32_t count = m_count.load(std::memory_order_relaxed);
+        for (InternId id = 1; id <= count; ++id)
+        {
+            const Entry *entry = EntryOf(id);
+            for (std::uint32_t i = entry->hash & table->mask;; i = (i + 1) & table->mask)
+            {
+                std::atomic<std::uint64_t> &slot = table->Slots()[i];
+                if (slot.load(std::memory_order_relaxed) == 0)
+                {
+                    slot.store((static_cast<std::uint64_t>(entry->hash) << 32) | id, std::memory_order_relaxed);
+                    break;
+                }
+            }
+        }
+
+        m_footprint.fetch_add(bytes, std::memory_order_relaxed);
+        m_table.store(table, std::memory_order_release);
+        return true;
+    }
+
+    void *Interner::ArenaAllocate(std::size_t size, std::size_t alignment)
+    {
+        // Called with m_mutex held
+        if (m_blocks)
+        {
+            const std::size_t offset = AlignUp(sizeof(Block) + m_blocks->used, alignment);
+            if (offset + size <= m_blocks->bytes)
+            {
+                m_blocks->used = offset + size - sizeof(Block);
+                return reinterpret_cast<char *>(m_blocks) + offset;
+            }
+        }
+
+        const std::size_t bytes = AlignUp(sizeof(Block) + size + alignment, BlockSize);
+        auto *block = static_cast<Block *>(yu::mem::os::AllocatePages(bytes));
+        if (!block)
+        {
+            return nullptr;
+        }
+        block->next = m_blocks;
+        block->bytes = bytes;
+        const std::size_t offset = AlignUp(sizeof(Block), alignment);
+        block->used = offset + size - sizeof(Block);
+        m_blocks = block;
+        m_footprint.fetch_add(bytes, std::memory_order_relaxed);
+        return reinterpret_cast<char *>(block) + offset;
+    }
+}
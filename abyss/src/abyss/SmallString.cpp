@@ -0,0 +1,173 @@
+#include <abyss/SmallString.h>
+#include <abyss/Utf.h>
+#include <wchar.h>
+#include <yu/memory.h>
+
+constexpr yu::mem::TagId AESmallStringTag = yu::mem::Tags::UserStart + 3;
+
+namespace abyss {
+    namespace {
+        std::uint32_t HashChars(const wchar_t* text, std::uint32_t length) {
+            // FNV-1a over the UTF-16 code units
+            std::uint32_t h = 2166136261u;
+            for (std::uint32_t i = 0; i < length; ++i) {
+                h = (h ^ static_cast<std::uint32_t>(text[i])) * 16777619u;
+            }
+            return h != 0 ? h : 1; // 0 means "not computed yet"
+        }
+    }
+
+    SmallString::SmallString()
+        : text(inlineText), length(0), hash(0), capacity(InlineCapacity), inlineText{} {}
+
+    SmallString::SmallString(const wchar_t* str)
+        : SmallString() {
+        if (str) {
+            Assign(str, static_cast<std::uint32_t>(wcslen(str)));
+        }
+    }
+
+    SmallString::SmallString(std::wstring_view str)
+        : SmallString() {
+        Assign(str.data(), static_cast<std::uint32_t>(str.size()));
+    }
+
+    SmallString::SmallString(const String& str)
+        : SmallString() {
+        Assign(str.c_str(), str.size());
+    }
+
+    SmallString::SmallString(std::string_view utf8Str)
+        : SmallString() {
+        const std::wstring_view wide = utf::ToWideScratch(utf8Str);
+        Assign(wide.data(), static_cast<std::uint32_t>(wide.size()));
+    }
+
+    SmallString::SmallString(const SmallString& other)
+        : SmallString() {
+        Assign(other.text, other.length);
+        hash = other.hash;
+    }
+
+    SmallString::SmallString(SmallString&& other) noexcept
+        : SmallString() {
+        *this = std::move(other);
+    }
+
+    SmallString& SmallString::operator=(const SmallString& other) {
+        if (this != &other) {
+            Assign(other.text, other.length);
+            hash = other.hash;
+        }
+        return *this;
+    }
+
+    SmallString& SmallString::operator=(SmallString&& other) noexcept {
+        if (this != &other) {
+            if (other.IsInline()) {
+                Assign(other.text, other.length);
+            } else {
+                Reset();
+                text = other.text;
+                length = other.length;
+                capacity = other.capacity;
+                other.text = other.inlineText;
+                other.capacity = InlineCapacity;
+            }
+            hash = other.hash;
+            other.length = 0;
+            other.hash = 0;
+            other.inlineText[0] = L'\0';
+        }
+        return *this;
+    }
+
+    SmallString::~SmallString() {
+        Reset();
+    }
+
+    void SmallString::Assign(const wchar_t* str, std::uint32_t newLength) {
+        // Reuse the current buffer when it is big enough: a heap buffer keeps its
+        // capacity when a shorter string is assigned, so growing back does not reallocate
+        if (newLength > capacity) {
+            wchar_t* buffer = yu::mem::NewArray<wchar_t>(newLength + 1, AESmallStringTag);
+            wmemcpy(buffer, str, newLength);
+            Reset();
+            text = buffer;
+            capacity = newLength;
+        } else if (!IsInline() && newLength <= InlineCapacity) {
+            wmemcpy(inlineText, str, newLength);
+            Reset();
+        } else {
+            wmemmove(text, str, newLength);
+        }
+        length = newLength;
+        text[length] = L'\0';
+        hash = 0;
+    }
+
+    void SmallString::Reset() {
+        if (!IsInline()) {
+            yu::mem::DeleteArray(text, capacity + 1);
+            text = inlineText;
+            capacity = InlineCapacity;
+        }
+        length = 0;
+        hash = 0;
+    }
+
+    const wchar_t* SmallString::c_str() const {
+        return text;
+    }
+
+    std::uint32_t SmallString::size() const {
+        return length;
+    }
+
+    bool SmallString::Empty() const {
+        return length == 0;
+    }
+
+    bool SmallString::IsInline() const {
+        return text == inlineText;
+    }
+
+    std::uint32_t SmallString::Hash() const {
+        if (hash == 0) {
+            hash = HashChars(text, length);
+        }
+        return hash;
+    }
+
+    bool SmallString::operator==(const SmallString& other) const {
+        if (length != other.length) return false;
+        if (hash != 0 && other.hash != 0 && hash != other.hash) return false;
+        return wmemcmp(text, other.text, length) == 0;
+    }
+
+    bool SmallString::operator!=(const SmallString& other) const {
+        return !(*this == other);
+    }
+
+    bool SmallString::operator==(const String& other) const {
+        return length == other.size() && wmemcmp(text, other.c_str(), length) == 0;
+    }
+
+    SmallString::operator std::wstring_view() const {
+        return std::wstring_view(text, length);
+    }
+
+    StringView SmallString::View() const {
+        return StringView{ text, length };
+    }
+
+    String SmallString::ToString() const {
+        return String(text);
+    }
+
+    std::string SmallString::ToUTF8() const {
+        std::string result;
+        utf::AppendUtf8(std::wstring_view(text, length), result);
+        return result;
+    }
+}
@@ -0,0 +1,477 @@
+#include <abyss/Snapshot.h>
+#include <algorithm>
+#include <cstddef>
+
+#ifdef ABYSS_SNAPSHOT_LZ4
+#include <lz4.h>
+#endif
+
+namespace abyss
+{
+    namespace snapshot_format
+    {
+        namespace
+        {
+            constexpr SchemaField Fields[] = {
+                {"address", FieldType::U64, 1, offsetof(SnapshotRow, address)},
+                {"world", FieldType::F32, 16, offsetof(SnapshotRow, world)},
+                {"meshOffset", FieldType::U32, 1, offsetof(SnapshotRow, meshOffset)},
+                {"meshCount", FieldType::U32, 1, offsetof(SnapshotRow, meshCount)},
+                {"flags", FieldType::U32, 1, offsetof(SnapshotRow, flags)},
+            };
+        } // namespace
+
+        std::span<const SchemaField> Schema()
+        {
+            return Fields;
+        }
+    } // namespace snapshot_format
+
+    namespace
+    {
+        using namespace snapshot_format;
+
+        // Zero-run tokens: a varint n; n & 1 == 0 is a run of n >> 1 zero bytes,
+        // n & 1 == 1 is n >> 1 literal bytes that follow.
+
+        /// @brief Zero bytes shorter than this stay inside a literal run
+        constexpr std::size_t MinZeroRun = 4;
+
+        void PutVarint(std::vector<std::uint8_t> &out, std::uint64_t value)
+        {
+            while (value >= 0x80)
+            {
+                out.push_back(static_cast<std::uint8_t>(value | 0x80));
+                value >>= 7;
+            }
+            out.push_back(static_cast<std::uint8_t>(value));
+        }
+
+        bool GetVarint(const std::uint8_t *&in, const std::uint8_t *end, std::uint64_t &value)
+        {
+            value = 0;
+            for (unsigned shift = 0; in < end && shift < 64; shift += 7)
+            {
+                const std::uint8_t byte = *in++;
+                value |= static_cast<std::uint64_t>(byte & 0x7F) << shift;
+                if (!(byte & 0x80))
+                {
+                    return true;
+                }
+            }
+            return false;
+        }
+
+        /// @brief Length of the run of zero bytes at data[0..size), eight bytes at a time
+        std::size_t ZeroRunLength(const std::uint8_t *data, std::size_t size)
+        {
+            std::size_t n = 0;
+            while (n + 8 <= size)
+            {
+                std::uint64_t word;
+                std::memcpy(&word, data + n, 8);
+                if (word != 0)
+                {
+                    break;
+                }
+                n += 8;
+            }
+            while (n < size && data[n] == 0)
+            {
+                ++n;
+            }
+            return n;
+        }
+
+        void EncodeZeroRuns(std::span<const std::uint8_t> in, std::vector<std::uint8_t> &out)
+        {
+            out.clear();
+            const std::uint8_t *data = in.data();
+            const std::size_t size = in.size();
+            std::size_t pos = 0;
+            while (pos < size)
+            {
+                const std::size_t zeros = ZeroRunLength(data + pos, size - pos);
+                if (zeros >= MinZeroRun || pos + zeros == size)
+                {
+                    PutVarint(out, static_cast<std::uint64_t>(zeros) << 1);
+                    pos += zeros;
+                    continue;
+                }
+
+                // Literal run up to the next zero run long enough to pay for a token
+                std::size_t end = pos + zeros;
+                while (end < size)
+                {
+                    if (data[end] == 0)
+                    {
+                        const std::size_t run = ZeroRunLength(data + end, size - end);
+                        if (run >= MinZeroRun)
+                        {
+                            break;
+                        }
+                        end += run;
+                        continue;
+                    }
+                    ++end;
+                }
+                PutVarint(out, (static_cast<std::uint64_t>(end - pos) << 1) | 1);
+                out.insert(out.end(), data + pos, data + end);
+                pos = end;
+            }
+        }
+
+        bool DecodeZeroRuns(std::span<const std::uint8_t> in, std::uint8_t *out, std::size_t outSize)
+        {
+            const std::uint8_t *src = in.data();
+            const std::uint8_t *end = src + in.size();
+            std::size_t pos = 0;
+            while (src < end)
+            {
+                std::uint64_t token;
+                if (!GetVarint(src, end, token))
+                {
+                    return false;
+                }
+                const std::uint64_t length = token >> 1;
+                if (length > outSize - pos)
+                {
+                    return false;
+                }
+                if (token & 1)
+                {
+                    if (length > static_cast<std::uint64_t>(end - src))
+                    {
+                        return false;
+                    }
+                    std::memcpy(out + pos, src, static_cast<std::size_t>(length));
+                    src += length;
+                }
+                else
+                {
+                    std::memset(out + pos, 0, static_cast<std::size_t>(length));
+                }
+                pos += static_cast<std::size_t>(length);
+            }
+            return pos == outSize;
+        }
+
+        /// @brief out = current XOR previous (bytes past the previous frame are copied)
+        void XorDelta(std::span<const std::uint8_t> current, std::span<const std::uint8_t> previous,
+                      std::vector<std::uint8_t> &out)
+        {
+            out.resize(current.size());
+            const std::size_t shared = std::min(current.size(), previous.size());
+            std::size_t i = 0;
+            for (; i + 8 <= shared; i += 8)
+            {
+                std::uint64_t a, b;
+                std::memcpy(&a, current.data() + i, 8);
+                std::memcpy(&b, previous.data() + i, 8);
+                a ^= b;
+                std::memcpy(out.data() + i, &a, 8);
+            }
+            for (; i < shared; ++i)
+            {
+                out[i] = current[i] ^ previous[i];
+            }
+            std::memcpy(out.data() + shared, current.data() + shared, current.size() - shared);
+        }
+
+        /// @brief Turns state (holding previousSize bytes of the previous frame) into the frame of delta
+        void ApplyDelta(std::uint8_t *state, std::size_t previousSize, std::span<const std::uint8_t> delta)
+        {
+            const std::size_t shared = std::min(delta.size(), previousSize);
+            for (std::size_t i = 0; i < shared; ++i)
+            {
+                state[i] ^= delta[i];
+            }
+            std::memcpy(state + shared, delta.data() + shared, delta.size() - shared);
+        }
+    } // namespace
+
+    SnapshotWriter::~SnapshotWriter()
+    {
+        Close();
+    }
+
+    bool SnapshotWriter::Open(const std::filesystem::path &path, const SnapshotOptions &options)
+    {
+        Close();
+        m_options = options;
+        m_options.keyframeInterval = std::max<std::uint32_t>(options.keyframeInterval, 1);
+#ifndef ABYSS_SNAPSHOT_LZ4
+        if (m_options.codec == SnapshotCodec::Lz4)
+        {
+            m_options.codec = SnapshotCodec::ZeroRun;
+        }
+#endif
+        m_frames = 0;
+        m_rawBytes = 0;
+        m_storedBytes = 0;
+        m_previous.clear();
+
+        yu::io::StreamWriterConfig config;
+        config.bufferSize = 1024 * 1024;
+        config.backgroundFlush = options.backgroundFlush;
+        if (!m_out.Open(path, yu::io::StreamMode::Truncate, config))
+        {
+            return false;
+        }
+
+        const auto schema = Schema();
+        FileHeader header{};
+        std::memcpy(header.magic, Magic, sizeof(Magic));
+        header.version = Version;
+        header.fieldCount = static_cast<std::uint16_t>(schema.size());
+        header.rowSize = sizeof(SnapshotRow);
+        header.keyframeInterval = m_options.keyframeInterval;
+        m_out.Write(&header, sizeof(header));
+        return m_out.Write(schema.data(), schema.size_bytes());
+    }
+
+    bool SnapshotWriter::WriteFrame(std::uint64_t frame, std::span<const SnapshotRow> rows,
+                                    std::span<const std::uint64_t> meshes)
+    {
+        if (!m_out.IsOpen())
+        {
+            return false;
+        }
+
+        // Raw frame: rows, then mesh handles
+        std::vector<std::uint8_t> &raw = m_raw;
+        raw.resize(rows.size_bytes() + meshes.size_bytes());
+        if (!rows.empty())
+        {
+            std::memcpy(raw.data(), rows.data(), rows.size_bytes());
+        }
+        if (!meshes.empty())
+        {
+            std::memcpy(raw.data() + rows.size_bytes(), meshes.data(), meshes.size_bytes());
+        }
+
+        FrameHeader header{};
+        header.magic = FrameMagic;
+        header.codec = m_options.codec;
+        header.frame = frame;
+        header.rowCount = static_cast<std::uint32_t>(rows.size());
+        header.meshCount = static_cast<std::uint32_t>(meshes.size());
+        header.rawSize = static_cast<std::uint32_t>(raw.size());
+
+        const bool keyframe = m_frames % m_options.keyframeInterval == 0;
+        if (keyframe)
+        {
+            header.flags |= KeyframeFlag;
+            m_delta.assign(raw.begin(), raw.end());
+        }
+        else
+        {
+            XorDelta(raw, m_previous, m_delta);
+        }
+
+        std::span<const std::uint8_t> payload = m_delta;
+        if (m_options.codec != SnapshotCodec::None)
+        {
+            EncodeZeroRuns(m_delta, m_encoded);
+            payload = m_encoded;
+        }
+        header.encodedSize = static_cast<std::uint32_t>(payload.size());
+
+#ifdef ABYSS_SNAPSHOT_LZ4
+        if (m_options.codec == SnapshotCodec::Lz4)
+        {
+            m_compressed.resize(static_cast<std::size_t>(LZ4_compressBound(static_cast<int>(payload.size()))));
+            const int size = LZ4_compress_default(reinterpret_cast<const char *>(payload.data()),
+                                                  reinterpret_cast<char *>(m_compressed.data()),
+                                                  static_cast<int>(payload.size()),
+                                                  static_cast<int>(m_compressed.size()));
+            if (size <= 0)
+            {
+                return false;
+            }
+            payload = std::span<const std::uint8_t>(m_compressed.data(), static_cast<std::size_t>(size));
+        }
+#endif
+        header.storedSize = static_cast<std::uint32_t>(payload.size());
+
+        if (!m_out.Write(&header, sizeof(header)) || !m_out.Write(payload))
+        {
+            return false;
+        }
+
+        // Only a written frame becomes the base of the next delta
+        m_previous.swap(raw); // m_raw keeps the old buffer for reuse
+        ++m_frames;
+        m_rawBytes += sizeof(FrameHeader) + header.rawSize;
+        m_storedBytes += sizeof(FrameHeader) + header.storedSize;
+        return true;
+    }
+
+    bool SnapshotWriter::Close()
+    {
+        if (!m_out.IsOpen())
+        {
+            return true;
+        }
+        return m_out.Close().has_value();
+    }
+
+    bool SnapshotReader::Open(const std::filesystem::path &path)
+    {
+        Close();
+        auto file = yu::io::MappedFile::Open(path, yu::io::AccessHint::Sequential);
+        if (!file)
+        {
+            return false;
+        }
+        m_file = std::move(*file);
+        auto bytes = m_file.View();
+        if (!bytes)
+        {
+            Close();
+            return false;
+        }
+        m_bytes = *bytes;
+
+        // Header and schema must describe this build's SnapshotRow
+        FileHeader header;
+        const auto schema = Schema();
+        if (m_bytes.size() < sizeof(header))
+        {
+            Close();
+            return false;
+        }
+        std::memcpy(&header, m_bytes.data(), sizeof(header));
+        const std::size_t schemaBytes = sizeof(SchemaField) * header.fieldCount;
+        if (std::memcmp(header.magic, Magic, sizeof(Magic)) != 0 || header.version != Version ||
+            header.rowSize != sizeof(SnapshotRow) || header.fieldCount != schema.size() ||
+            m_bytes.size() < sizeof(header) + schemaBytes ||
+            std::memcmp(m_bytes.data() + sizeof(header), schema.data(), schemaBytes) != 0)
+        {
+            Close();
+            return false;
+        }
+        m_keyframeInterval = header.keyframeInterval;
+
+        // Index the frames; a truncated tail (recording cut short) ends the index
+        std::size_t offset = sizeof(header) + schemaBytes;
+        while (offset + sizeof(FrameHeader) <= m_bytes.size())
+        {
+            FrameHeader frame;
+            std::memcpy(&frame, m_bytes.data() + offset, sizeof(frame));
+            const std::size_t next = offset + sizeof(FrameHeader) + frame.storedSize;
+            if (frame.magic != FrameMagic || next > m_bytes.size() ||
+                frame.rawSize != frame.rowCount * sizeof(SnapshotRow) + frame.meshCount * sizeof(std::uint64_t))
+            {
+                break;
+            }
+            if (m_frames.empty() && !(frame.flags & KeyframeFlag))
+            {
+                break;
+            }
+            m_frames.push_back({offset, frame});
+            offset = next;
+        }
+        return true;
+    }
+
+    void SnapshotReader::Close()
+    {
+        m_file.Close();
+        m_bytes = {};
+        m_frames.clear();
+        m_keyframeInterval = 0;
+        m_stateSize = 0;
+        m_decoded = -1;
+    }
+
+    const FrameHeader &SnapshotReader::Header(std::uint32_t index) const
+    {
+        return m_frames[index].header;
+    }
+
+    bool SnapshotReader::ReadFrame(std::uint32_t index, SnapshotFrame &out)
+    {
+        if (index >= m_frames.size())
+        {
+            return false;
+        }
+
+        // Decode forward from the frame held, or from the last keyframe at or before index
+        std::uint32_t start = index;
+        while (!(Header(start).flags & KeyframeFlag))
+        {
+            --start;
+        }
+        if (m_decoded >= static_cast<std::int64_t>(start) && m_decoded <= static_cast<std::int64_t>(index))
+        {
+            start = static_cast<std::uint32_t>(m_decoded) + 1;
+        }
+        for (std::uint32_t i = start; i <= index; ++i)
+        {
+            if (!Decode(i))
+            {
+                m_decoded = -1;
+                return false;
+            }
+        }
+
+        const FrameHeader &header = Header(index);
+        const auto *base = reinterpret_cast<const std::uint8_t *>(m_state.data());
+        out.frame = header.frame;
+        out.rows = std::span<const SnapshotRow>(reinterpret_cast<const SnapshotRow *>(base), header.rowCount);
+        out.meshes = std::span<const std::uint64_t>(
+            reinterpret_cast<const std::uint64_t *>(base + header.rowCount * sizeof(SnapshotRow)), header.meshCount);
+        return true;
+    }
+
+    bool SnapshotReader::Decode(std::uint32_t index)
+    {
+        const FrameHeader &header = Header(index);
+        std::span<const std::uint8_t> payload(m_bytes.data() + m_frames[index].offset + sizeof(FrameHeader), header.storedSize);
+
+#ifdef ABYSS_SNAPSHOT_LZ4
+        if (header.codec == SnapshotCodec::Lz4)
+        {
+            m_scratch.resize(header.encodedSize);
+            const int size = LZ4_decompress_safe(reinterpret_cast<const char *>(payload.data()),
+                                                 reinterpret_cast<char *>(m_scratch.data()),
+                                                 static_cast<int>(payload.size()),
+                                                 static_cast<int>(m_scratch.size()));
+            if (size != static_cast<int>(header.encodedSize))
+            {
+                return false;
+            }
+            payload = m_scratch;
+        }
+#else
+        if (header.codec == SnapshotCodec::Lz4)
+        {
+            return false;
+        }
+#endif
+
+        std::span<const std::uint8_t> delta = payload;
+        if (header.codec != SnapshotCodec::None)
+        {
+            m_delta.resize(header.rawSize);
+            if (!DecodeZeroRuns(payload, m_delta.data(), m_delta.size()))
+            {
+                return false;
+            }
+            delta = m_delta;
+        }
+        else if (payload.size() != header.rawSize)
+        {
+            return false;
+        }
+
+        // Growing m_state keeps the previous frame in place for the XOR
+        const std::size_t previousSize = (header.flags & KeyframeFlag) ? 0 : m_stateSize;
+        m_state.resize((header.rawSize + sizeof(std::uint64_t) - 1) / sizeof(std::uint64_t));
+        ApplyDelta(reinterpret_cast<std::uint8_t *>(m_state.data()), previousSize, delta);
+        m_stateSize = header.rawSize;
+        m_decoded = index;
+        return true;
+    }
+} // namespace abyss
@@ -0,0 +1,48 @@
+#include <abyss/TransformCache.h>
+
+namespace abyss
+{
+    std::uint32_t TransformCache::Project(const math::Matrix &viewProjection, const math::Viewport &viewport)
+    {
+        const std::size_t count = m_sources.size();
+        m_screenX.resize(count);
+        m_screenY.resize(count);
+        m_depth.resize(count);
+        m_visible.resize(count);
+
+        math::ProjectPoints(viewProjection, viewport,
+                            {m_x, m_y, m_z},
+                            {m_screenX, m_screenY, m_depth, m_visible});
+
+        std::uint32_t visible = 0;
+        for (std::uint8_t v : m_visible)
+        {
+            visible += v;
+        }
+        m_visibleCount = visible;
+        return visible;
+    }
+
+    void TransformCache::Clear()
+    {
+        m_sources.clear();
+        m_x.clear();
+        m_y.clear();
+        m_z.clear();
+        m_screenX.clear();
+        m_screenY.clear();
+        m_depth.clear();
+        m_visible.clear();
+        m_visibleCount = 0;
+    }
+
+    std::uint32_t TransformCache::Size() const
+    {
+        return static_cast<std::uint32_t>(m_sources.size());
+    }
+
+    std::uint32_t TransformCache::VisibleCount() const
+    {
+        return m_visibleCount;
+    }
+} // namespace abyss
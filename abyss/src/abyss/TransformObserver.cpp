@@ -0,0 +1,216 @@
+#include <abyss/TransformObserver.h>
+#include <abyss/math/Simd.hpp>
+#include <algorithm>
+#include <cstring>
+#include <type_traits>
+
+namespace abyss
+{
+    namespace
+    {
+        static_assert(sizeof(math::Matrix) == 16 * sizeof(float) && std::is_standard_layout_v<math::Matrix>);
+
+        // murmur3 finalizer
+        std::uint32_t Mix(std::uint32_t h)
+        {
+            h ^= h >> 16;
+            h *= 0x85EBCA6Bu;
+            h ^= h >> 13;
+            h *= 0xC2B2AE35u;
+            h ^= h >> 16;
+            return h;
+        }
+
+        std::uint32_t RotateLeft(std::uint32_t v, int bits)
+        {
+            return (v << bits) | (v >> (32 - bits));
+        }
+    } // namespace
+
+    std::uint32_t TransformObserver::HashMatrix(const math::Matrix *world)
+    {
+        if (!world)
+        {
+            return 0;
+        }
+
+        // Fold the four rows into one (acc = rotl(acc, 5) ^ row), then mix the lanes.
+        // A change confined to one row always changes the folded lanes.
+        std::uint32_t lanes[4];
+#if ABYSS_MATH_SSE2
+        const auto *rows = reinterpret_cast<const __m128i *>(world);
+        __m128i acc = _mm_loadu_si128(rows + 0);
+        for (int i = 1; i < 4; ++i)
+        {
+            acc = _mm_or_si128(_mm_slli_epi32(acc, 5), _mm_srli_epi32(acc, 27));
+            acc = _mm_xor_si128(acc, _mm_loadu_si128(rows + i));
+        }
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(lanes), acc);
+#else
+        std::uint32_t bits[16];
+        std::memcpy(bits, world, sizeof(bits));
+        for (int lane = 0; lane < 4; ++lane)
+        {
+            std::uint32_t acc = bits[lane];
+            for (int i = 1; i < 4; ++i)
+            {
+                acc = RotateLeft(acc, 5) ^ bits[i * 4 + lane];
+            }
+            lanes[lane] = acc;
+        }
+#endif
+        std::uint32_t h = 0x9E3779B9u;
+        for (std::uint32_t lane : lanes)
+        {
+            h = Mix(RotateLeft(h, 13) ^ lane);
+        }
+        return h;
+    }
+
+    void TransformObserver::Update(const Array<Transform *> &transforms)
+    {
+        Update(transforms, [](const Transform &) -> const math::Matrix * { return nullptr; });
+    }
+
+    void TransformObserver::Diff()
+    {
+        m_added.clear();
+        m_removed.clear();
+        m_moved.clear();
+        m_kept.clear();
+        m_oldHashes.clear();
+        m_newHashes.clear();
+
+        // The engine mostly keeps its order and appends: the shared prefix is kept as is
+        const std::size_t shared = std::min(m_previous.size(), m_current.size());
+        std::size_t prefix = 0;
+        while (prefix < shared && m_previous[prefix].transform == m_current[prefix].transform)
+        {
+            Keep(m_current[prefix].transform, m_previous[prefix].hash, m_current[prefix].hash);
+            ++prefix;
+        }
+        if (prefix < m_previous.size() || prefix < m_current.size())
+        {
+            DiffTail(prefix);
+        }
+
+        // Most kept transforms do not move: compare four hashes per step and only
+        // look at the lanes of a block that differ
+        const std::size_t kept = m_kept.size();
+        std::size_t i = 0;
+#if ABYSS_MATH_SSE2
+        for (; i + 4 <= kept; i += 4)
+        {
+            const __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i *>(m_oldHashes.data() + i));
+            const __m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i *>(m_newHashes.data() + i));
+            const int same = _mm_movemask_ps(_mm_castsi128_ps(_mm_cmpeq_epi32(a, b)));
+            if (same == 0xF)
+            {
+                continue;
+            }
+            for (int lane = 0; lane < 4; ++lane)
+            {
+                if (!(same & (1 << lane)))
+                {
+                    m_moved.push_back(m_kept[i + lane]);
+                }
+            }
+        }
+#endif
+        for (; i < kept; ++i)
+        {
+            if (m_oldHashes[i] != m_newHashes[i])
+            {
+                m_moved.push_back(m_kept[i]);
+            }
+        }
+
+        m_previous.swap(m_current);
+    }
+
+    void TransformObserver::DiffTail(std::size_t prefix)
+    {
+        // Every previous transform goes in, so a duplicate of a prefix entry is caught too;
+        // at most half full. assign() reuses the buffer once it is large enough
+        const std::size_t needed = m_previous.size() + (m_current.size() - prefix);
+        std::size_t capacity = 16;
+        while (capacity < needed * 2)
+        {
+            capacity <<= 1;
+        }
+        m_slots.assign(capacity, Slot{nullptr, 0, false});
+        for (std::size_t p = 0; p < m_previous.size(); ++p)
+        {
+            m_slots[FindSlot(m_previous[p].transform)] = {m_previous[p].transform, m_previous[p].hash, p < prefix};
+        }
+
+        // New entries in array order; duplicates are dropped from m_current in place
+        std::size_t write = prefix;
+        for (std::size_t c = prefix; c < m_current.size(); ++c)
+        {
+            const Entry cur = m_current[c];
+            Slot &slot = m_slots[FindSlot(cur.transform)];
+            if (slot.current)
+            {
+                continue;
+            }
+            if (slot.transform)
+            {
+                Keep(cur.transform, slot.oldHash, cur.hash);
+            }
+            else
+            {
+                slot.transform = cur.transform;
+                m_added.push_back(cur.transform);
+            }
+            slot.current = true;
+            m_current[write++] = cur;
+        }
+        m_current.resize(write);
+
+        for (std::size_t p = prefix; p < m_previous.size(); ++p)
+        {
+            if (!m_slots[FindSlot(m_previous[p].transform)].current)
+            {
+                m_removed.push_back(m_previous[p].transform);
+            }
+        }
+    }
+
+    std::size_t TransformObserver::FindSlot(const Transform *transform) const
+    {
+        const auto address = static_cast<std::uint64_t>(reinterpret_cast<std::uintptr_t>(transform));
+        const std::size_t mask = m_slots.size() - 1;
+        std::size_t i = Mix(static_cast<std::uint32_t>((address >> 4) ^ (address >> 32))) & mask;
+        while (m_slots[i].transform && m_slots[i].transform != transform)
+        {
+            i = (i + 1) & mask;
+        }
+        return i;
+    }
+
+    void TransformObserver::Keep(Transform *transform, std::uint32_t oldHash, std::uint32_t newHash)
+    {
+        m_kept.push_back(transform);
+        m_oldHashes.push_back(oldHash);
+        m_newHashes.push_back(newHash);
+    }
+
+    void TransformObserver::Reset()
+    {
+        m_previous.clear();
+        m_current.clear();
+        m_slots.clear();
+        m_kept.clear();
+        m_oldHashes.clear();
+        m_newHashes.clear();
+        m_added.clear();
+        m_removed.clear();
+        m_moved.clear();
+    }
+
+    std::uint32_t TransformObserver::Size() const
+    {
+        return static_cast<std::uint32_t>(m_previous.size());
+    }
+} // namespace abyss
@@ -0,0 +1,207 @@
+#include <abyss/Utf.h>
+#include <abyss/math/Simd.hpp>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+#include <vector>
+
+namespace abyss::utf {
+    namespace {
+        constexpr char32_t Replacement = 0xFFFD;
+
+#if ABYSS_MATH_SSE2
+        // 16 ASCII bytes -> 16 UTF-16 units; false if any byte is >= 0x80
+        bool WidenAscii16(const char* in, std::uint16_t* out) {
+            const __m128i bytes = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in));
+            if (_mm_movemask_epi8(bytes) != 0) return false;
+            const __m128i zero = _mm_setzero_si128();
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(out), _mm_unpacklo_epi8(bytes, zero));
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(out + 8), _mm_unpackhi_epi8(bytes, zero));
+            return true;
+        }
+
+        // 16 UTF-16 units -> 16 bytes; false if any unit is >= 0x80
+        bool NarrowAscii16(const std::uint16_t* in, char* out) {
+            const __m128i lo = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in));
+            const __m128i hi = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + 8));
+            const __m128i high = _mm_and_si128(_mm_or_si128(lo, hi), _mm_set1_epi16(static_cast<short>(0xFF80)));
+            if (_mm_movemask_epi8(_mm_cmpeq_epi16(high, _mm_setzero_si128())) != 0xFFFF) return false;
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(out), _mm_packus_epi16(lo, hi));
+            return true;
+        }
+#endif
+
+        // Decodes one code point at in[0] (in[0] >= 0x80); maximal invalid subparts become U+FFFD
+        char32_t DecodeUtf8(const unsigned char* in, std::size_t available, std::size_t& consumed) {
+            const unsigned char lead = in[0];
+            std::size_t length;
+            char32_t cp;
+            unsigned char lower = 0x80, upper = 0xBF;
+            if (lead >= 0xC2 && lead <= 0xDF) {
+                length = 2;
+                cp = lead & 0x1F;
+            } else if (lead >= 0xE0 && lead <= 0xEF) {
+                length = 3;
+                cp = lead & 0x0F;
+                if (lead == 0xE0) lower = 0xA0;
+                if (lead == 0xED) upper = 0x9F; // No surrogates
+            } else if (lead >= 0xF0 && lead <= 0xF4) {
+                length = 4;
+                cp = lead & 0x07;
+                if (lead == 0xF0) lower = 0x90;
+                if (lead == 0xF4) upper = 0x8F; // <= U+10FFFF
+            } else {
+                consumed = 1;
+                return Replacement;
+            }
+
+            for (std::size_t k = 1; k < length; ++k) {
+                if (k >= available || in[k] < lower || in[k] > upper) {
+                    consumed = k;
+                    return Replacement;
+                }
+                cp = (cp << 6) | (in[k] & 0x3F);
+                lower = 0x80;
+                upper = 0xBF;
+            }
+            consumed = length;
+            return cp;
+        }
+
+        template <typename Unit>
+        std::size_t DecodeInto(std::string_view utf8, Unit* out, std::size_t capacity) {
+            static_assert(sizeof(Unit) == 2 || sizeof(Unit) == 4);
+            const auto* in = reinterpret_cast<const unsigned char*>(utf8.data());
+            const std::size_t size = utf8.size();
+            std::size_t i = 0, o = 0;
+            while (i < size) {
+#if ABYSS_MATH_SSE2
+                if constexpr (sizeof(Unit) == 2) {
+                    if (size - i >= 16 && capacity - o >= 16 &&
+                        WidenAscii16(utf8.data() + i, reinterpret_cast<std::uint16_t*>(out + o))) {
+                        i += 16;
+                        o += 16;
+                        continue;
+                    }
+                }
+#endif
+                if (o == capacity) break;
+                if (in[i] < 0x80) {
+                    out[o++] = static_cast<Unit>(in[i++]);
+                    continue;
+                }
+
+                std::size_t consumed;
+                const char32_t cp = DecodeUtf8(in + i, size - i, consumed);
+                if (sizeof(Unit) == 2 && cp >= 0x10000) {
+                    if (capacity - o < 2) break;
+                    const char32_t v = cp - 0x10000;
+                    out[o++] = static_cast<Unit>(0xD800 + (v >> 10));
+                    out[o++] = static_cast<Unit>(0xDC00 + (v & 0x3FF));
+                } else {
+                    out[o++] = static_cast<Unit>(cp);
+                }
+                i += consumed;
+            }
+            return o;
+        }
+
+        template <typename Unit>
+        std::size_t EncodeInto(const Unit* in, std::size_t size, char* out, std::size_t capacity) {
+            static_assert(sizeof(Unit) == 2 || sizeof(Unit) == 4);
+            using U = std::make_unsigned_t<Unit>;
+            std::size_t i = 0, o = 0;
+            while (i < size) {
+#if ABYSS_MATH_SSE2
+                if constexpr (sizeof(Unit) == 2) {
+                    if (size - i >= 16 && capacity - o >= 16 &&
+                        NarrowAscii16(reinterpret_cast<const std::uint16_t*>(in + i), out + o)) {
+                        i += 16;
+                        o += 16;
+                        continue;
+                    }
+                }
+#endif
+                char32_t cp = static_cast<U>(in[i]);
+                std::size_t consumed = 1;
+                if (cp < 0x80) {
+                    if (o == capacity) break;
+                    out[o++] = static_cast<char>(cp);
+                    ++i;
+                    continue;
+                }
+                if constexpr (sizeof(Unit) == 2) {
+                    if (cp >= 0xD800 && cp <= 0xDBFF && i + 1 < size) {
+                        const char32_t low = static_cast<U>(in[i + 1]);
+                        if (low >= 0xDC00 && low <= 0xDFFF) {
+                            cp = 0x10000 + ((cp - 0xD800) << 10) + (low - 0xDC00);
+                            consumed = 2;
+                        }
+                    }
+                }
+                if ((cp >= 0xD800 && cp <= 0xDFFF) || cp > 0x10FFFF) {
+                    cp = Replacement; // Lone surrogate or out of range
+                }
+
+                const std::size_t length = cp < 0x800 ? 2 : (cp < 0x10000 ? 3 : 4);
+                if (capacity - o < length) break;
+                switch (length) {
+                case 2:
+                    out[o++] = static_cast<char>(0xC0 | (cp >> 6));
+                    break;
+                case 3:
+                    out[o++] = static_cast<char>(0xE0 | (cp >> 12));
+                    out[o++] = static_cast<char>(0x80 | ((cp >> 6) & 0x3F));
+                    break;
+                default:
+                    out[o++] = static_cast<char>(0xF0 | (cp >> 18));
+                    out[o++] = static_cast<char>(0x80 | ((cp >> 12) & 0x3F));
+                    out[o++] = static_cast<char>(0x80 | ((cp >> 6) & 0x3F));
+                    break;
+                }
+                out[o++] = static_cast<char>(0x80 | (cp & 0x3F));
+                i += consumed;
+            }
+            return o;
+        }
+    }
+
+    std::size_t ToWide(std::string_view utf8, std::span<wchar_t> out) {
+        return DecodeInto(utf8, out.data(), out.size());
+    }
+
+    std::size_t ToUtf16(std::string_view utf8, std::span<char16_t> out) {
+        return DecodeInto(utf8, out.data(), out.size());
+    }
+
+    std::size_t ToUtf8(std::wstring_view wide, std::span<char> out) {
+        return EncodeInto(wide.data(), wide.size(), out.data(), out.size());
+    }
+
+    std::size_t ToUtf8(std::u16string_view utf16, std::span<char> out) {
+        return EncodeInto(utf16.data(), utf16.size(), out.data(), out.size());
+    }
+
+    void AppendUtf8(std::wstring_view wide, std::string& out) {
+        const std::size_t offset = out.size();
+        out.resize_and_overwrite(offset + MaxUtf8Length(wide.size()), [&](char* buffer, std::size_t size) {
+            return offset + EncodeInto(wide.data(), wide.size(), buffer + offset, size - offset);
+        });
+    }
+
+    std::wstring_view ToWideScratch(std::string_view utf8) {
+        thread_local std::vector<wchar_t> scratch;
+        if (scratch.size() < MaxWideLength(utf8.size())) {
+            scratch.resize(MaxWideLength(utf8.size()));
+        }
+        return std::wstring_view(scratch.data(), ToWide(utf8, scratch));
+    }
+
+    std::string_view ToUtf8Scratch(std::wstring_view wide) {
+        thread_local std::vector<char> scratch;
+        if (scratch.size() < MaxUtf8Length(wide.size())) {
+            scratch.resize(MaxUtf8Length(wide.size()));
+        }
+        return std::string_view(scratch.data(), ToUtf8(wide, scratch));
+    }
+}
@@ -0,0 +1,127 @@
+#include <abyss/math/Batch.hpp>
+#include "Kernels.hpp"
+#include <algorithm>
+#include <type_traits>
+
+namespace abyss
+{
+    namespace math
+    {
+        // The kernels view spans as packed float arrays
+        static_assert(sizeof(Vector) == 3 * sizeof(float) && std::is_standard_layout_v<Vector>);
+        static_assert(sizeof(Matrix) == 16 * sizeof(float) && std::is_standard_layout_v<Matrix>);
+
+        namespace
+        {
+            const float *Floats(const Vector *v) { return reinterpret_cast<const float *>(v); }
+            float *Floats(Vector *v) { return reinterpret_cast<float *>(v); }
+            const float *Floats(const Matrix *m) { return reinterpret_cast<const float *>(m); }
+            float *Floats(Matrix *m) { return reinterpret_cast<float *>(m); }
+        }
+
+        void TransformPoints(const Matrix &m, std::span<const Vector> in, std::span<Vector> out)
+        {
+            const std::size_t count = in.size() < out.size() ? in.size() : out.size();
+            detail::TransformPoints(Floats(&m), Floats(in.data()), Floats(out.data()), count, true);
+        }
+
+        void RotateVectors(const Matrix &m, std::span<const Vector> in, std::span<Vector> out)
+        {
+            const std::size_t count = in.size() < out.size() ? in.size() : out.size();
+            detail::TransformPoints(Floats(&m), Floats(in.data()), Floats(out.data()), count, false);
+        }
+
+        void MultiplyMatrices(std::span<const Matrix> a, std::span<const Matrix> b, std::span<Matrix> out)
+        {
+            std::size_t count = a.size() < b.size() ? a.size() : b.size();
+            count = count < out.size() ? count : out.size();
+            for (std::size_t i = 0; i < count; ++i)
+            {
+                detail::Multiply(Floats(&a[i]), Floats(&b[i]), Floats(&out[i]));
+            }
+        }
+
+        void MultiplyMatrices(std::span<const Matrix> a, const Matrix &b, std::span<Matrix> out)
+        {
+            const std::size_t count = a.size() < out.size() ? a.size() : out.size();
+            const Matrix right = b; // b may alias an element of out
+            for (std::size_t i = 0; i < count; ++i)
+            {
+                detail::Multiply(Floats(&a[i]), Floats(&right), Floats(&out[i]));
+            }
+        }
+
+        std::size_t ProjectPoints(const Matrix &viewProjection, const Viewport &viewport, const PointSpans &in, const ScreenSpans &out)
+        {
+            const std::size_t count = std::min({in.x.size(), in.y.size(), in.z.size(),
+                                                out.x.size(), out.y.size(), out.depth.size(), out.visible.size()});
+            const float *m = Floats(&viewProjection);
+            const float halfWidth = viewport.width * 0.5f;
+            const float halfHeight = viewport.height * 0.5f;
+            const float centerX = viewport.x + halfWidth;
+            const float centerY = viewport.y + halfHeight;
+            constexpr float minW = 1e-6f;
+
+            std::size_t i = 0;
+#if ABYSS_MATH_SSE2
+            __m128 rows[16];
+            for (int k = 0; k < 16; ++k)
+            {
+                rows[k] = _mm_set1_ps(m[k]);
+            }
+            const __m128 vHalfWidth = _mm_set1_ps(halfWidth), vHalfHeight = _mm_set1_ps(halfHeight);
+            const __m128 vCenterX = _mm_set1_ps(centerX), vCenterY = _mm_set1_ps(centerY);
+            const __m128 vMinW = _mm_set1_ps(minW), zero = _mm_setzero_ps();
+            const __m128 signMask = _mm_set1_ps(-0.0f);
+
+            for (; i + 4 <= count; i += 4)
+            {
+                const __m128 x = _mm_loadu_ps(in.x.data() + i);
+                const __m128 y = _mm_loadu_ps(in.y.data() + i);
+                const __m128 z = _mm_loadu_ps(in.z.data() + i);
+
+                __m128 clip[4];
+                for (int c = 0; c < 4; ++c)
+                {
+                    clip[c] = _mm_add_ps(_mm_add_ps(_mm_mul_ps(x, rows[c]), _mm_mul_ps(y, rows[4 + c])),
+                                         _mm_add_ps(_mm_mul_ps(z, rows[8 + c]), rows[12 + c]));
+                }
+
+                // Inside when w > 0, |x| <= w, |y| <= w and 0 <= z <= w
+                const __m128 w = clip[3];
+                __m128 inside = _mm_cmpgt_ps(w, vMinW);
+                inside = _mm_and_ps(inside, _mm_cmple_ps(_mm_andnot_ps(signMask, clip[0]), w));
+                inside = _mm_and_ps(inside, _mm_cmple_ps(_mm_andnot_ps(signMask, clip[1]), w));
+                inside = _mm_and_ps(inside, _mm_cmpge_ps(clip[2], zero));
+                inside = _mm_and_ps(inside, _mm_cmple_ps(clip[2], w));
+
+                const __m128 invW = _mm_div_ps(_mm_set1_ps(1.0f), _mm_max_ps(w, vMinW));
+                _mm_storeu_ps(out.x.data() + i, _mm_add_ps(vCenterX, _mm_mul_ps(_mm_mul_ps(clip[0], invW), vHalfWidth)));
+                _mm_storeu_ps(out.y.data() + i, _mm_sub_ps(vCenterY, _mm_mul_ps(_mm_mul_ps(clip[1], invW), vHalfHeight)));
+                _mm_storeu_ps(out.depth.data() + i, _mm_mul_ps(clip[2], invW));
+
+                const int mask = _mm_movemask_ps(inside);
+                for (int lane = 0; lane < 4; ++lane)
+                {
+                    out.visible[i + lane] = static_cast<std::uint8_t>((mask >> lane) & 1);
+                }
+            }
+#endif
+            for (; i < count; ++i)
+            {
+                const float x = in.x[i], y = in.y[i], z = in.z[i];
+                const float cx = x * m[0] + y * m[4] + z * m[8] + m[12];
+                const float cy = x * m[1] + y * m[5] + z * m[9] + m[13];
+                const float cz = x * m[2] + y * m[6] + z * m[10] + m[14];
+                const float cw = x * m[3] + y * m[7] + z * m[11] + m[15];
+                const bool inside = cw > minW && (cx < 0.0f ? -cx : cx) <= cw && (cy < 0.0f ? -cy : cy) <= cw && cz >= 0.0f && cz <= cw;
+                const float invW = 1.0f / (cw > minW ? cw : minW);
+                out.x[i] = centerX + cx * invW * halfWidth;
+                out.y[i] = centerY - cy * invW * halfHeight;
+                out.depth[i] = cz * invW;
+                out.visible[i] = inside ? 1 : 0;
+            }
+            return count;
+        }
+    }
+} // namespace abyss
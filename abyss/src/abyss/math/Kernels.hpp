@@ -0,0 +1,117 @@
+#ifndef MATH_KERNELS
+#define MATH_KERNELS
+#include <abyss/math/Simd.hpp>
+#include <cstddef>
+
+/**
+ * @brief Shared inner loops of Matrix.cpp and Batch.cpp (private to abyss)
+ *
+ * Matrices are 16 floats, one basis row per 4 floats (right, up, dir,
+ * position), and points are row vectors: p' = p * M. Vectors are 3 packed
+ * floats. No alignment is assumed: matrices and vectors may live in game
+ * memory.
+ */
+namespace abyss::math::detail
+{
+    /// out = a * b (out may alias a or b)
+    inline void Multiply(const float *a, const float *b, float *out)
+    {
+#if ABYSS_MATH_SSE2
+        const __m128 b0 = _mm_loadu_ps(b + 0);
+        const __m128 b1 = _mm_loadu_ps(b + 4);
+        const __m128 b2 = _mm_loadu_ps(b + 8);
+        const __m128 b3 = _mm_loadu_ps(b + 12);
+        __m128 rows[4];
+        for (int i = 0; i < 4; ++i)
+        {
+            const __m128 r = _mm_loadu_ps(a + i * 4);
+            __m128 acc = _mm_mul_ps(_mm_shuffle_ps(r, r, _MM_SHUFFLE(0, 0, 0, 0)), b0);
+            acc = _mm_add_ps(acc, _mm_mul_ps(_mm_shuffle_ps(r, r, _MM_SHUFFLE(1, 1, 1, 1)), b1));
+            acc = _mm_add_ps(acc, _mm_mul_ps(_mm_shuffle_ps(r, r, _MM_SHUFFLE(2, 2, 2, 2)), b2));
+            acc = _mm_add_ps(acc, _mm_mul_ps(_mm_shuffle_ps(r, r, _MM_SHUFFLE(3, 3, 3, 3)), b3));
+            rows[i] = acc;
+        }
+        for (int i = 0; i < 4; ++i)
+        {
+            _mm_storeu_ps(out + i * 4, rows[i]);
+        }
+#else
+        float result[16];
+        for (int i = 0; i < 4; ++i)
+        {
+            for (int j = 0; j < 4; ++j)
+            {
+                result[i * 4 + j] = a[i * 4 + 0] * b[0 * 4 + j] + a[i * 4 + 1] * b[1 * 4 + j] +
+                                    a[i * 4 + 2] * b[2 * 4 + j] + a[i * 4 + 3] * b[3 * 4 + j];
+            }
+        }
+        for (int i = 0; i < 16; ++i)
+        {
+            out[i] = result[i];
+        }
+#endif
+    }
+
+    /// out = in * M, with (translate) or without the position row (out may alias in)
+    inline void TransformPoint(const float *m, const float *in, float *out, bool translate)
+    {
+        const float x = in[0], y = in[1], z = in[2];
+        const float w = translate ? 1.0f : 0.0f;
+        out[0] = x * m[0] + y * m[4] + z * m[8] + w * m[12];
+        out[1] = x * m[1] + y * m[5] + z * m[9] + w * m[13];
+        out[2] = x * m[2] + y * m[6] + z * m[10] + w * m[14];
+    }
+
+    /**
+     * @brief out[i] = in[i] * M for count packed 3-float vectors (out may alias in)
+     *
+     * The SSE2 path loads four vectors (12 floats, three registers) at a time,
+     * transposes them to x/y/z registers, runs 9 multiply-adds for 4 points and
+     * transposes back.
+     */
+    inline void TransformPoints(const float *m, const float *in, float *out, std::size_t count, bool translate)
+    {
+        std::size_t i = 0;
+#if ABYSS_MATH_SSE2
+        const __m128 m0 = _mm_set1_ps(m[0]), m1 = _mm_set1_ps(m[1]), m2 = _mm_set1_ps(m[2]);
+        const __m128 m4 = _mm_set1_ps(m[4]), m5 = _mm_set1_ps(m[5]), m6 = _mm_set1_ps(m[6]);
+        const __m128 m8 = _mm_set1_ps(m[8]), m9 = _mm_set1_ps(m[9]), m10 = _mm_set1_ps(m[10]);
+        const __m128 tx = translate ? _mm_set1_ps(m[12]) : _mm_setzero_ps();
+        const __m128 ty = translate ? _mm_set1_ps(m[13]) : _mm_setzero_ps();
+        const __m128 tz = translate ? _mm_set1_ps(m[14]) : _mm_setzero_ps();
+
+        for (; i + 4 <= count; i += 4)
+        {
+            const float *src = in + i * 3;
+            // a = x0 y0 z0 x1, b = y1 z1 x2 y2, c = z2 x3 y3 z3
+            const __m128 a = _mm_loadu_ps(src + 0);
+            const __m128 b = _mm_loadu_ps(src + 4);
+            const __m128 c = _mm_loadu_ps(src + 8);
+
+            const __m128 x = _mm_shuffle_ps(a, _mm_shuffle_ps(b, c, _MM_SHUFFLE(1, 1, 2, 2)), _MM_SHUFFLE(2, 0, 3, 0));
+            const __m128 y = _mm_shuffle_ps(_mm_shuffle_ps(a, b, _MM_SHUFFLE(0, 0, 1, 1)),
+                                            _mm_shuffle_ps(b, c, _MM_SHUFFLE(2, 2, 3, 3)), _MM_SHUFFLE(2, 0, 2, 0));
+            const __m128 z = _mm_shuffle_ps(_mm_shuffle_ps(a, b, _MM_SHUFFLE(1, 1, 2, 2)),
+                                            _mm_shuffle_ps(c, c, _MM_SHUFFLE(3, 3, 0, 0)), _MM_SHUFFLE(2, 0, 2, 0));
+
+            const __m128 rx = _mm_add_ps(_mm_add_ps(_mm_mul_ps(x, m0), _mm_mul_ps(y, m4)), _mm_add_ps(_mm_mul_ps(z, m8), tx));
+            const __m128 ry = _mm_add_ps(_mm_add_ps(_mm_mul_ps(x, m1), _mm_mul_ps(y, m5)), _mm_add_ps(_mm_mul_ps(z, m9), ty));
+            const __m128 rz = _mm_add_ps(_mm_add_ps(_mm_mul_ps(x, m2), _mm_mul_ps(y, m6)), _mm_add_ps(_mm_mul_ps(z, m10), tz));
+
+            const __m128 xyLo = _mm_unpacklo_ps(rx, ry); // x0 y0 x1 y1
+            const __m128 xyHi = _mm_unpackhi_ps(rx, ry); // x2 y2 x3 y3
+            float *dst = out + i * 3;
+            _mm_storeu_ps(dst + 0, _mm_shuffle_ps(xyLo, _mm_shuffle_ps(rz, xyLo, _MM_SHUFFLE(2, 2, 0, 0)), _MM_SHUFFLE(2, 0, 1, 0)));
+            _mm_storeu_ps(dst + 4, _mm_shuffle_ps(_mm_shuffle_ps(xyLo, rz, _MM_SHUFFLE(1, 1, 3, 3)), xyHi, _MM_SHUFFLE(1, 0, 2, 0)));
+            _mm_storeu_ps(dst + 8, _mm_shuffle_ps(_mm_shuffle_ps(rz, xyHi, _MM_SHUFFLE(2, 2, 2, 2)),
+                                                  _mm_shuffle_ps(xyHi, rz, _MM_SHUFFLE(3, 3, 3, 3)), _MM_SHUFFLE(2, 0, 2, 0)));
+        }
+#endif
+        for (; i < count; ++i)
+        {
+            TransformPoint(m, in + i * 3, out + i * 3, translate);
+        }
+    }
+}
+
+#endif /* MATH_KERNELS */
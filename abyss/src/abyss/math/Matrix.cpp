@@ -1 +1,290 @@
-#include <abyss/math/Matrix.hpp>
\ No newline at end of file
+#include <abyss/math/Matrix.hpp>
+#include "Kernels.hpp"
+#include <cmath>
+
+namespace abyss
+{
+    namespace math
+    {
+        namespace
+        {
+            const float *Row(const float *m, int row)
+            {
+                return m + row * 4;
+            }
+
+            Vector RowVector(const float *m, int row)
+            {
+                return Vector(m[row * 4 + 0], m[row * 4 + 1], m[row * 4 + 2]);
+            }
+
+            void SetRow(float *m, int row, const Vector &value)
+            {
+                m[row * 4 + 0] = value[0];
+                m[row * 4 + 1] = value[1];
+                m[row * 4 + 2] = value[2];
+            }
+        }
+
+        Matrix::Matrix()
+            : m{} {}
+
+        Matrix Matrix::operator*(const Matrix &other) const
+        {
+            Matrix result;
+            detail::Multiply(m, other.m, result.m);
+            return result;
+        }
+
+        Matrix Matrix::operator+(const Matrix &other) const
+        {
+            Matrix result(*this);
+            return result += other;
+        }
+
+        Matrix Matrix::operator-(const Matrix &other) const
+        {
+            Matrix result(*this);
+            return result -= other;
+        }
+
+        Matrix Matrix::operator*(float scalar) const
+        {
+            Matrix result(*this);
+            return result *= scalar;
+        }
+
+        Matrix Matrix::operator/(float scalar) const
+        {
+            Matrix result(*this);
+            return result /= scalar;
+        }
+
+        Matrix &Matrix::operator*=(const Matrix &other)
+        {
+            detail::Multiply(m, other.m, m);
+            return *this;
+        }
+
+        Matrix &Matrix::operator+=(const Matrix &other)
+        {
+            for (int i = 0; i < 16; ++i)
+            {
+                m[i] += other.m[i];
+            }
+            return *this;
+        }
+
+        Matrix &Matrix::operator-=(const Matrix &other)
+        {
+            for (int i = 0; i < 16; ++i)
+            {
+                m[i] -= other.m[i];
+            }
+            return *this;
+        }
+
+        Matrix &Matrix::operator*=(float scalar)
+        {
+            for (int i = 0; i < 16; ++i)
+            {
+                m[i] *= scalar;
+            }
+            return *this;
+        }
+
+        Matrix &Matrix::operator/=(float scalar)
+        {
+            return *this *= 1.0f / scalar;
+        }
+
+        bool Matrix::operator==(const Matrix &other) const
+        {
+            for (int i = 0; i < 16; ++i)
+            {
+                if (m[i] != other.m[i])
+                {
+                    return false;
+                }
+            }
+            return true;
+        }
+
+        bool Matrix::operator!=(const Matrix &other) const
+        {
+            return !(*this == other);
+        }
+
+        float Matrix::operator[](std::size_t index) const
+        {
+            return m[index];
+        }
+
+        float &Matrix::operator[](std::size_t index)
+        {
+            return m[index];
+        }
+
+        Matrix Matrix::Identity()
+        {
+            Matrix result;
+            result.m[0] = result.m[5] = result.m[10] = result.m[15] = 1.0f;
+            return result;
+        }
+
+        Vector Matrix::Right() const
+        {
+            return RowVector(m, 0);
+        }
+
+        Vector Matrix::Up() const
+        {
+            return RowVector(m, 1);
+        }
+
+        Vector Matrix::Dir() const
+        {
+            return RowVector(m, 2);
+        }
+
+        Vector Matrix::Position() const
+        {
+            return RowVector(m, 3);
+        }
+
+        Vector Matrix::Transform(Vector point) const
+        {
+            Vector result;
+            detail::TransformPoint(m, &point[0], &result[0], true);
+            return result;
+        }
+
+        Vector Matrix::Rotate(Vector direction) const
+        {
+            Vector result;
+            detail::TransformPoint(m, &direction[0], &result[0], false);
+            return result;
+        }
+
+        // The inverse variants assume an orthonormal rotation part (a rigid transform),
+        // which is what the engine stores; use Inverse() for scaled matrices.
+        Vector Matrix::InverseTransform(Vector point) const
+        {
+            return InverseRotate(point - Position());
+        }
+
+        Vector Matrix::InverseRotate(Vector direction) const
+        {
+            return Vector(direction.Dot(Right()), direction.Dot(Up()), direction.Dot(Dir()));
+        }
+
+        // The Set* functions keep the other two components of the transform:
+        // SetScaling keeps orientation and position, SetRotation keeps the per-axis
+        // scale and position, SetTranslation keeps the basis.
+        Matrix Matrix::SetScaling(float sx, float sy, float sz) const
+        {
+            Matrix result(*this);
+            SetRow(result.m, 0, Right().Normalize() * sx);
+            SetRow(result.m, 1, Up().Normalize() * sy);
+            SetRow(result.m, 2, Dir().Normalize() * sz);
+            return result;
+        }
+
+        Matrix Matrix::SetTranslation(float tx, float ty, float tz) const
+        {
+            Matrix result(*this);
+            SetRow(result.m, 3, Vector(tx, ty, tz));
+            return result;
+        }
+
+        Matrix Matrix::SetRotation(float pitch, float yaw, float roll) const
+        {
+            // Roll about Z, then pitch about X, then yaw about Y (row vectors: Rz * Rx * Ry)
+            const float cp = std::cos(pitch), sp = std::sin(pitch);
+            const float cy = std::cos(yaw), sy = std::sin(yaw);
+            const float cr = std::cos(roll), sr = std::sin(roll);
+
+            const Vector right(cr * cy + sr * sp * sy, sr * cp, -cr * sy + sr * sp * cy);
+            const Vector up(-sr * cy + cr * sp * sy, cr * cp, sr * sy + cr * sp * cy);
+            const Vector dir(cp * sy, -sp, cp * cy);
+
+            Matrix result(*this);
+            SetRow(result.m, 0, right * Right().Length());
+            SetRow(result.m, 1, up * Up().Length());
+            SetRow(result.m, 2, dir * Dir().Length());
+            return result;
+        }
+
+        Matrix Matrix::Inverse() const
+        {
+            // Affine inverse: [A 0; t 1]^-1 = [A^-1 0; -t * A^-1 1]
+            const float *r0 = Row(m, 0), *r1 = Row(m, 1), *r2 = Row(m, 2);
+            const float c00 = r1[1] * r2[2] - r1[2] * r2[1];
+            const float c01 = r1[2] * r2[0] - r1[0] * r2[2];
+            const float c02 = r1[0] * r2[1] - r1[1] * r2[0];
+            const float det = r0[0] * c00 + r0[1] * c01 + r0[2] * c02;
+            if (std::fabs(det) < 1e-12f)
+            {
+                return Matrix(); // Singular: zero matrix
+            }
+            const float inv = 1.0f / det;
+
+            Matrix result;
+            result.m[0] = c00 * inv;
+            result.m[1] = (r0[2] * r2[1] - r0[1] * r2[2]) * inv;
+            result.m[2] = (r0[1] * r1[2] - r0[2] * r1[1]) * inv;
+            result.m[4] = c01 * inv;
+            result.m[5] = (r0[0] * r2[2] - r0[2] * r2[0]) * inv;
+            result.m[6] = (r0[2] * r1[0] - r0[0] * r1[2]) * inv;
+            result.m[8] = c02 * inv;
+            result.m[9] = (r0[1] * r2[0] - r0[0] * r2[1]) * inv;
+            result.m[10] = (r0[0] * r1[1] - r0[1] * r1[0]) * inv;
+
+            float translation[3];
+            detail::TransformPoint(result.m, Row(m, 3), translation, false);
+            result.m[12] = -translation[0];
+            result.m[13] = -translation[1];
+            result.m[14] = -translation[2];
+            result.m[15] = 1.0f;
+            return result;
+        }
+
+        Matrix Matrix::LookAt(const Vector &eye, const Vector &target, const Vector &up) const
+        {
+            // Left-handed view matrix, as D3DXMatrixLookAtLH
+            const Vector zAxis = (target - eye).Normalize();
+            const Vector xAxis = up.Cross(zAxis).Normalize();
+            const Vector yAxis = zAxis.Cross(xAxis);
+
+            Matrix result;
+            result.m[0] = xAxis[0];
+            result.m[1] = yAxis[0];
+            result.m[2] = zAxis[0];
+            result.m[4] = xAxis[1];
+            result.m[5] = yAxis[1];
+            result.m[6] = zAxis[1];
+            result.m[8] = xAxis[2];
+            result.m[9] = yAxis[2];
+            result.m[10] = zAxis[2];
+            result.m[12] = -xAxis.Dot(eye);
+            result.m[13] = -yAxis.Dot(eye);
+            result.m[14] = -zAxis.Dot(eye);
+            result.m[15] = 1.0f;
+            return result;
+        }
+
+        Matrix Matrix::OpenGL() const
+        {
+            // OpenGL uses column vectors: the same transform is the transpose
+            Matrix result;
+            for (int i = 0; i < 4; ++i)
+            {
+                for (int j = 0; j < 4; ++j)
+                {
+                    result.m[j * 4 + i] = m[i * 4 + j];
+                }
+            }
+            return result;
+        }
+    }
+} // namespace abyss
@@ -0,0 +1,119 @@
+#include <abyss/math/Vector.hpp>
+#include <cmath>
+
+namespace abyss
+{
+    namespace math
+    {
+        Vector::Vector()
+            : v{0.0f, 0.0f, 0.0f} {}
+
+        Vector::Vector(float x, float y, float z)
+            : v{x, y, z} {}
+
+        Vector Vector::operator+(const Vector &other) const
+        {
+            return Vector(v[0] + other.v[0], v[1] + other.v[1], v[2] + other.v[2]);
+        }
+
+        Vector Vector::operator-(const Vector &other) const
+        {
+            return Vector(v[0] - other.v[0], v[1] - other.v[1], v[2] - other.v[2]);
+        }
+
+        Vector Vector::operator*(float scalar) const
+        {
+            return Vector(v[0] * scalar, v[1] * scalar, v[2] * scalar);
+        }
+
+        Vector Vector::operator/(float scalar) const
+        {
+            const float inv = 1.0f / scalar;
+            return Vector(v[0] * inv, v[1] * inv, v[2] * inv);
+        }
+
+        Vector &Vector::operator+=(const Vector &other)
+        {
+            v[0] += other.v[0];
+            v[1] += other.v[1];
+            v[2] += other.v[2];
+            return *this;
+        }
+
+        Vector &Vector::operator-=(const Vector &other)
+        {
+            v[0] -= other.v[0];
+            v[1] -= other.v[1];
+            v[2] -= other.v[2];
+            return *this;
+        }
+
+        Vector &Vector::operator*=(float scalar)
+        {
+            v[0] *= scalar;
+            v[1] *= scalar;
+            v[2] *= scalar;
+            return *this;
+        }
+
+        Vector &Vector::operator/=(float scalar)
+        {
+            return *this *= 1.0f / scalar;
+        }
+
+        bool Vector::operator==(const Vector &other) const
+        {
+            return v[0] == other.v[0] && v[1] == other.v[1] && v[2] == other.v[2];
+        }
+
+        bool Vector::operator!=(const Vector &other) const
+        {
+            return !(*this == other);
+        }
+
+        float Vector::operator[](std::size_t index) const
+        {
+            return v[index];
+        }
+
+        float &Vector::operator[](std::size_t index)
+        {
+            return v[index];
+        }
+
+        float Vector::Dot(const Vector &other) const
+        {
+            return v[0] * other.v[0] + v[1] * other.v[1] + v[2] * other.v[2];
+        }
+
+        Vector Vector::Cross(const Vector &other) const
+        {
+            return Vector(v[1] * other.v[2] - v[2] * other.v[1],
+                          v[2] * other.v[0] - v[0] * other.v[2],
+                          v[0] * other.v[1] - v[1] * other.v[0]);
+        }
+
+        float Vector::Length() const
+        {
+            return std::sqrt(Dot(*this));
+        }
+
+        Vector Vector::Normalize() const
+        {
+            // A zero vector stays zero instead of turning into NaNs
+            const float length = Length();
+            if (length <= 0.0f)
+            {
+                return Vector();
+            }
+            return *this * (1.0f / length);
+        }
+
+        Vector Vector::Lerp(const Vector &target, float t) const
+        {
+            return Vector(v[0] + (target.v[0] - v[0]) * t,
+                          v[1] + (target.v[1] - v[1]) * t,
+                          v[2] + (target.v[2] - v[2]) * t);
+        }
+    }
+} // namespace abyss
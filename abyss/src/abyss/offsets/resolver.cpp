@@ -0,0 +1,386 @@
+#include <abyss/offsets/resolver.hpp>
+#include <abyss/offsets/pc.hpp>
+#include <yu/io.h>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstring>
+#include <string_view>
+#include <system_error>
+#include <thread>
+
+namespace abyss::offsets
+{
+    namespace
+    {
+        constexpr std::uint32_t NoOffset = 0xFFFFFFFF;
+
+        /// Bytes per scan chunk; chunks overlap by the longest pattern
+        constexpr std::size_t ChunkSize = 256 * 1024;
+
+        struct CacheHeader
+        {
+            char magic[4];
+            std::uint32_t version;
+            std::uint32_t timeDateStamp;
+            std::uint32_t checkSum;
+            std::uint32_t sizeOfImage;
+            std::uint32_t tableHash;
+            std::uint32_t count;
+        };
+        constexpr char CacheMagic[4] = {'A', 'B', 'O', 'C'};
+        constexpr std::uint32_t CacheVersion = 1;
+
+        /// FNV-1a over everything that decides a result, so editing the table invalidates the cache
+        std::uint32_t TableHash(std::span<const Signature> table)
+        {
+            std::uint32_t hash = 2166136261u;
+            auto mix = [&hash](const void *data, std::size_t size)
+            {
+                const auto *bytes = static_cast<const std::uint8_t *>(data);
+                for (std::size_t i = 0; i < size; ++i)
+                {
+                    hash = (hash ^ bytes[i]) * 16777619u;
+                }
+            };
+            for (const Signature &signature : table)
+            {
+                const std::string_view name = signature.name ? signature.name : "";
+                const std::string_view pattern = signature.pattern ? signature.pattern : "";
+                mix(name.data(), name.size());
+                mix(&signature.kind, sizeof(signature.kind));
+                mix(pattern.data(), pattern.size());
+                mix(&signature.adjust, sizeof(signature.adjust));
+                mix("", 1);
+            }
+            return hash;
+        }
+
+        struct Chunk
+        {
+            std::span<const std::uint8_t> bytes;
+            std::uint32_t rva;
+        };
+
+        /// Lowers target to value if value is smaller
+        void StoreMin(std::atomic<std::uint32_t> &target, std::uint32_t value)
+        {
+            std::uint32_t current = target.load(std::memory_order_relaxed);
+            while (value < current && !target.compare_exchange_weak(current, value, std::memory_order_relaxed))
+            {
+            }
+        }
+
+        /// Offset table of the known PC build; signatures are added as they are captured
+        constexpr Signature Table[] = {
+            {"globals.canvas", SignatureKind::Absolute, nullptr, 0, globals::canvas},
+            {"globals.init", SignatureKind::Address, nullptr, 0, functions::globals::init},
+            {"stdlib.malloc", SignatureKind::Import, "*!malloc", 0, functions::stdlib::malloc},
+            {"stdlib.free", SignatureKind::Import, "*!free", 0, functions::stdlib::free},
+            {"stdlib.realloc", SignatureKind::Import, "*!realloc", 0, functions::stdlib::realloc},
+            {"stdlib.newarray", SignatureKind::Import, "*!??_U@YAPAXI@Z", 0, functions::stdlib::newarray},
+            {"stdlib.deletearray", SignatureKind::Import, "*!??_V@YAXPAX@Z", 0, functions::stdlib::deletearray},
+        };
+        static_assert(std::size(Table) == static_cast<std::size_t>(Id::Count), "Table is indexed by Id");
+
+        Resolver g_resolver;
+    } // namespace
+
+    ResolveReport Resolver::Resolve(const ModuleImage &image, std::span<const Signature> table, const std::filesystem::path &cachePath)
+    {
+        const auto start = std::chrono::steady_clock::now();
+
+        m_table = table;
+        m_base = image.Base();
+        m_rvas.assign(table.size(), NoOffset);
+        m_sources.assign(table.size(), OffsetSource::Fallback);
+
+        ResolveReport report;
+        const std::uint32_t hash = TableHash(table);
+        if (cachePath.empty() || !LoadCache(image, cachePath, hash))
+        {
+            Scan(image);
+            if (!cachePath.empty())
+            {
+                report.cacheWritten = SaveCache(image, cachePath, hash);
+            }
+        }
+
+        for (OffsetSource source : m_sources)
+        {
+            switch (source)
+            {
+            case OffsetSource::Cache:
+                ++report.cached;
+                break;
+            case OffsetSource::Scan:
+                ++report.scanned;
+                break;
+            case OffsetSource::Fallback:
+                ++report.fallback;
+                break;
+            }
+        }
+
+        report.microseconds = static_cast<std::uint64_t>(
+            std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count());
+        return report;
+    }
+
+    std::uintptr_t Resolver::Get(std::size_t index) const
+    {
+        if (index >= m_table.size())
+        {
+            return 0;
+        }
+        if (m_rvas[index] == NoOffset)
+        {
+            return m_table[index].fallback;
+        }
+        return m_base + m_rvas[index];
+    }
+
+    OffsetSource Resolver::SourceOf(std::size_t index) const
+    {
+        return index < m_sources.size() ? m_sources[index] : OffsetSource::Fallback;
+    }
+
+    bool Resolver::LoadCache(const ModuleImage &image, const std::filesystem::path &path, std::uint32_t tableHash)
+    {
+        std::error_code ec;
+        if (!std::filesystem::exists(path, ec))
+        {
+            return false;
+        }
+        auto bytes = yu::io::ReadBytes(path);
+        if (!bytes || bytes->size() != sizeof(CacheHeader) + m_table.size() * sizeof(std::uint32_t))
+        {
+            return false;
+        }
+
+        CacheHeader header;
+        std::memcpy(&header, bytes->data(), sizeof(header));
+        if (std::memcmp(header.magic, CacheMagic, sizeof(CacheMagic)) != 0 || header.version != CacheVersion ||
+            header.timeDateStamp != image.TimeDateStamp() || header.checkSum != image.CheckSum() ||
+            header.sizeOfImage != image.SizeOfImage() || header.tableHash != tableHash ||
+            header.count != m_table.size())
+        {
+            return false;
+        }
+
+        const std::uint8_t *entries = bytes->data() + sizeof(header);
+        for (std::size_t i = 0; i < m_table.size(); ++i)
+        {
+            std::uint32_t rva;
+            std::memcpy(&rva, entries + i * sizeof(rva), sizeof(rva));
+            if (rva != NoOffset && image.Contains(rva))
+            {
+                m_rvas[i] = rva;
+                m_sources[i] = OffsetSource::Cache;
+            }
+        }
+        return true;
+    }
+
+    bool Resolver::SaveCache(const ModuleImage &image, const std::filesystem::path &path, std::uint32_t tableHash) const
+    {
+        CacheHeader header{};
+        std::memcpy(header.magic, CacheMagic, sizeof(CacheMagic));
+        header.version = CacheVersion;
+        header.timeDateStamp = image.TimeDateStamp();
+        header.checkSum = image.CheckSum();
+        header.sizeOfImage = image.SizeOfImage();
+        header.tableHash = tableHash;
+        header.count = static_cast<std::uint32_t>(m_table.size());
+
+        yu::io::ByteBuffer bytes(sizeof(header) + m_rvas.size() * sizeof(std::uint32_t));
+        std::memcpy(bytes.data(), &header, sizeof(header));
+        std::memcpy(bytes.data() + sizeof(header), m_rvas.data(), m_rvas.size() * sizeof(std::uint32_t));
+        return yu::io::WriteBytes(path, bytes).has_value();
+    }
+
+    void Resolver::Scan(const ModuleImage &image)
+    {
+        // Imports come straight from the import directory
+        std::vector<std::size_t> pending;
+        std::vector<Pattern> patterns;
+        for (std::size_t i = 0; i < m_table.size(); ++i)
+        {
+            const Signature &signature = m_table[i];
+            if (!signature.pattern)
+            {
+                continue;
+            }
+
+            if (signature.kind == SignatureKind::Import)
+            {
+                const std::string_view text = signature.pattern;
+                const std::size_t bang = text.find('!');
+                if (bang == std::string_view::npos)
+                {
+                    continue;
+                }
+                if (const std::uint32_t slot = image.FindImport(text.substr(0, bang), text.substr(bang + 1)))
+                {
+                    m_rvas[i] = slot + signature.adjust;
+                    m_sources[i] = OffsetSource::Scan;
+                }
+                continue;
+            }
+
+            Pattern pattern(signature.pattern);
+            if (!pattern.Empty())
+            {
+                pending.push_back(i);
+                patterns.push_back(std::move(pattern));
+            }
+        }
+        if (patterns.empty())
+        {
+            return;
+        }
+
+        std::size_t longest = 0;
+        for (const Pattern &pattern : patterns)
+        {
+            longest = std::max(longest, pattern.Size());
+        }
+
+        std::vector<Chunk> chunks;
+        for (const CodeSection &section : image.CodeSections())
+        {
+            const std::size_t size = section.bytes.size();
+            for (std::size_t offset = 0; offset < size; offset += ChunkSize)
+            {
+                const std::size_t length = std::min(size - offset, ChunkSize + longest - 1);
+                chunks.push_back({section.bytes.subspan(offset, length), section.rva + static_cast<std::uint32_t>(offset)});
+            }
+        }
+
+        // Lowest match of each pattern across all chunks
+        std::vector<std::atomic<std::uint32_t>> best(patterns.size());
+        for (auto &match : best)
+        {
+            match.store(NoOffset, std::memory_order_relaxed);
+        }
+
+        std::atomic<std::size_t> next{0};
+        auto worker = [&]
+        {
+            for (std::size_t c = next.fetch_add(1, std::memory_order_relaxed); c < chunks.size();
+                 c = next.fetch_add(1, std::memory_order_relaxed))
+            {
+                const Chunk &chunk = chunks[c];
+                for (std::size_t p = 0; p < patterns.size(); ++p)
+                {
+                    // An earlier chunk already matched
+                    if (best[p].load(std::memory_order_relaxed) < chunk.rva)
+                    {
+                        continue;
+                    }
+                    const std::size_t at = Find(chunk.bytes, patterns[p]);
+                    if (at != NotFound)
+                    {
+                        StoreMin(best[p], chunk.rva + static_cast<std::uint32_t>(at));
+                    }
+                }
+            }
+        };
+
+        const unsigned hardware = std::max(1u, std::thread::hardware_concurrency());
+        const std::size_t threadCount = std::min<std::size_t>(hardware, chunks.size());
+        std::vector<std::thread> threads;
+        threads.reserve(threadCount);
+        for (std::size_t t = 1; t < threadCount; ++t)
+        {
+            try
+            {
+                threads.emplace_back(worker);
+            }
+            catch (const std::system_error &)
+            {
+                break; // The calling thread scans whatever is left
+            }
+        }
+        worker();
+        for (std::thread &thread : threads)
+        {
+            thread.join();
+        }
+
+        const auto *base = reinterpret_cast<const std::uint8_t *>(image.Base());
+        for (std::size_t p = 0; p < patterns.size(); ++p)
+        {
+            const std::uint32_t match = best[p].load(std::memory_order_relaxed);
+            if (match == NoOffset)
+            {
+                continue;
+            }
+
+            const std::size_t index = pending[p];
+            const Signature &signature = m_table[index];
+            const std::uint32_t at = match + static_cast<std::uint32_t>(signature.adjust);
+            std::uint32_t rva = NoOffset;
+            switch (signature.kind)
+            {
+            case SignatureKind::Address:
+                rva = at;
+                break;
+            case SignatureKind::Absolute:
+                if (image.Contains(at, 4))
+                {
+                    std::uint32_t address;
+                    std::memcpy(&address, base + at, sizeof(address));
+                    if (address >= image.Base() && address - image.Base() < image.SizeOfImage())
+                    {
+                        rva = static_cast<std::uint32_t>(address - image.Base());
+                    }
+                }
+                break;
+            case SignatureKind::Relative:
+                if (image.Contains(at, 4))
+                {
+                    std::int32_t displacement;
+                    std::memcpy(&displacement, base + at, sizeof(displacement));
+                    rva = at + 4 + static_cast<std::uint32_t>(displacement);
+                }
+                break;
+            case SignatureKind::Import:
+                break;
+            }
+
+            if (rva != NoOffset && image.Contains(rva))
+            {
+                m_rvas[index] = rva;
+                m_sources[index] = OffsetSource::Scan;
+            }
+        }
+    }
+
+    std::span<const Signature> Signatures()
+    {
+        return Table;
+    }
+
+    ResolveReport Initialize(const void *moduleBase, const std::filesystem::path &cachePath)
+    {
+        ModuleImage image;
+        if (!image.Parse(moduleBase))
+        {
+            ResolveReport report;
+            report.fallback = static_cast<std::uint32_t>(std::size(Table));
+            return report;
+        }
+        return g_resolver.Resolve(image, Table, cachePath);
+    }
+
+    std::uintptr_t Get(Id id)
+    {
+        const auto index = static_cast<std::size_t>(id);
+        if (const std::uintptr_t address = g_resolver.Get(index))
+        {
+            return address;
+        }
+        return Table[index].fallback;
+    }
+} // namespace abyss::offsets
@@ -0,0 +1,299 @@
+#include <abyss/offsets/scanner.hpp>
+#include <algorithm>
+#include <bit>
+#include <cstring>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define ABYSS_SCANNER_SSE2 1
+#include <emmintrin.h>
+#endif
+
+namespace abyss::offsets
+{
+    namespace
+    {
+        int HexDigit(char c)
+        {
+            if (c >= '0' && c <= '9')
+            {
+                return c - '0';
+            }
+            if (c >= 'a' && c <= 'f')
+            {
+                return c - 'a' + 10;
+            }
+            if (c >= 'A' && c <= 'F')
+            {
+                return c - 'A' + 10;
+            }
+            return -1;
+        }
+
+        /// Headers in a loaded image are aligned, but nothing here relies on it
+        template <typename T>
+        T Read(const std::uint8_t *base, std::uint32_t offset)
+        {
+            T value;
+            std::memcpy(&value, base + offset, sizeof(T));
+            return value;
+        }
+
+        bool EqualsIgnoreCase(std::string_view a, std::string_view b)
+        {
+            return std::ranges::equal(a, b, [](char x, char y)
+                                      {
+                                          auto lower = [](char c)
+                                          { return c >= 'A' && c <= 'Z' ? static_cast<char>(c - 'A' + 'a') : c; };
+                                          return lower(x) == lower(y);
+                                      });
+        }
+
+        // PE layout (winnt.h), read by offset so abyss does not need windows.h
+        constexpr std::uint16_t DosMagic = 0x5A4D;             // "MZ"
+        constexpr std::uint32_t NtSignature = 0x00004550;      // "PE\0\0"
+        constexpr std::uint16_t OptionalMagic32 = 0x10B;
+        constexpr std::uint16_t OptionalMagic64 = 0x20B;
+        constexpr std::uint32_t SectionHeaderSize = 40;
+        constexpr std::uint32_t ImportDescriptorSize = 20;
+        constexpr std::uint32_t ScnCntCode = 0x00000020;
+        constexpr std::uint32_t ScnMemExecute = 0x20000000;
+    } // namespace
+
+    Pattern::Pattern(std::string_view text)
+    {
+        std::size_t i = 0;
+        while (i < text.size())
+        {
+            const char c = text[i];
+            if (c == ' ')
+            {
+                ++i;
+                continue;
+            }
+
+            if (c == '?')
+            {
+                i += (i + 1 < text.size() && text[i + 1] == '?') ? 2 : 1;
+                m_bytes.push_back(0);
+                m_mask.push_back(0);
+                continue;
+            }
+
+            const int high = HexDigit(c);
+            const int low = i + 1 < text.size() ? HexDigit(text[i + 1]) : -1;
+            if (high < 0 || low < 0)
+            {
+                m_bytes.clear();
+                m_mask.clear();
+                return;
+            }
+            m_bytes.push_back(static_cast<std::uint8_t>(high << 4 | low));
+            m_mask.push_back(0xFF);
+            i += 2;
+        }
+
+        const auto first = std::ranges::find(m_mask, 0xFF);
+        if (first == m_mask.end())
+        {
+            m_bytes.clear();
+            m_mask.clear();
+            return;
+        }
+        m_first = static_cast<std::size_t>(first - m_mask.begin());
+        m_last = m_mask.size() - 1 - static_cast<std::size_t>(std::ranges::find(m_mask.rbegin(), m_mask.rend(), 0xFF) - m_mask.rbegin());
+    }
+
+    bool Pattern::Matches(const std::uint8_t *at) const
+    {
+        const std::size_t size = m_bytes.size();
+        for (std::size_t i = 0; i < size; ++i)
+        {
+            if ((at[i] & m_mask[i]) != m_bytes[i])
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    std::size_t Find(std::span<const std::uint8_t> haystack, const Pattern &pattern)
+    {
+        const std::size_t size = pattern.Size();
+        if (size == 0 || haystack.size() < size)
+        {
+            return NotFound;
+        }
+
+        const std::uint8_t *data = haystack.data();
+        const std::size_t last = haystack.size() - size; // Last position a match may start at
+        const std::size_t a = pattern.FirstAnchor();
+        const std::size_t b = pattern.LastAnchor();
+        std::size_t i = 0;
+
+#ifdef ABYSS_SCANNER_SSE2
+        // Positions i..i+15 are candidates; the loads at i+a and i+b stay inside the haystack
+        const __m128i first = _mm_set1_epi8(static_cast<char>(pattern.Bytes()[a]));
+        const __m128i lastByte = _mm_set1_epi8(static_cast<char>(pattern.Bytes()[b]));
+        for (; i + 16 <= last + 1; i += 16)
+        {
+            const __m128i ca = _mm_cmpeq_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i *>(data + i + a)), first);
+            const __m128i cb = _mm_cmpeq_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i *>(data + i + b)), lastByte);
+            auto candidates = static_cast<std::uint32_t>(_mm_movemask_epi8(_mm_and_si128(ca, cb)));
+            while (candidates != 0)
+            {
+                const std::size_t at = i + static_cast<std::size_t>(std::countr_zero(candidates));
+                if (pattern.Matches(data + at))
+                {
+                    return at;
+                }
+                candidates &= candidates - 1;
+            }
+        }
+#endif
+
+        const std::uint8_t firstByte = pattern.Bytes()[a];
+        for (; i <= last; ++i)
+        {
+            if (data[i + a] == firstByte && pattern.Matches(data + i))
+            {
+                return i;
+            }
+        }
+        return NotFound;
+    }
+
+    bool ModuleImage::Parse(const void *base)
+    {
+        *this = {};
+        const auto *image = static_cast<const std::uint8_t *>(base);
+        if (!image || Read<std::uint16_t>(image, 0) != DosMagic)
+        {
+            return false;
+        }
+
+        const auto nt = Read<std::uint32_t>(image, 0x3C);
+        if (Read<std::uint32_t>(image, nt) != NtSignature)
+        {
+            return false;
+        }
+
+        const std::uint32_t fileHeader = nt + 4;
+        const auto sectionCount = Read<std::uint16_t>(image, fileHeader + 2);
+        const auto optionalSize = Read<std::uint16_t>(image, fileHeader + 16);
+        const std::uint32_t optional = fileHeader + 20;
+
+        const auto magic = Read<std::uint16_t>(image, optional);
+        if (magic != OptionalMagic32 && magic != OptionalMagic64)
+        {
+            return false;
+        }
+        m_pe64 = magic == OptionalMagic64;
+
+        m_base = image;
+        m_timeDateStamp = Read<std::uint32_t>(image, fileHeader + 4);
+        m_sizeOfImage = Read<std::uint32_t>(image, optional + 56);
+        m_checkSum = Read<std::uint32_t>(image, optional + 64);
+
+        const std::uint32_t directoryCount = Read<std::uint32_t>(image, optional + (m_pe64 ? 108 : 92));
+        const std::uint32_t directories = optional + (m_pe64 ? 112 : 96);
+        if (directoryCount > 1)
+        {
+            m_importRva = Read<std::uint32_t>(image, directories + 8);
+            m_importSize = Read<std::uint32_t>(image, directories + 12);
+        }
+
+        const std::uint32_t sections = optional + optionalSize;
+        for (std::uint16_t s = 0; s < sectionCount; ++s)
+        {
+            const std::uint32_t header = sections + s * SectionHeaderSize;
+            const auto characteristics = Read<std::uint32_t>(image, header + 36);
+            if (!(characteristics & (ScnCntCode | ScnMemExecute)))
+            {
+                continue;
+            }
+
+            const auto rva = Read<std::uint32_t>(image, header + 12);
+            std::uint32_t size = Read<std::uint32_t>(image, header + 8);
+            if (size == 0)
+            {
+                size = Read<std::uint32_t>(image, header + 16);
+            }
+            if (rva >= m_sizeOfImage)
+            {
+                continue;
+            }
+            size = std::min(size, m_sizeOfImage - rva);
+
+            CodeSection section{};
+            std::memcpy(section.name, image + header, 8);
+            section.rva = rva;
+            section.bytes = {image + rva, size};
+            m_sections.push_back(section);
+        }
+        return true;
+    }
+
+    std::uint32_t ModuleImage::FindImport(std::string_view module, std::string_view symbol) const
+    {
+        if (!m_base || m_importRva == 0 || !Contains(m_importRva, ImportDescriptorSize))
+        {
+            return 0;
+        }
+
+        const std::uint32_t thunkSize = m_pe64 ? 8 : 4;
+        for (std::uint32_t descriptor = m_importRva; Contains(descriptor, ImportDescriptorSize); descriptor += ImportDescriptorSize)
+        {
+            const auto names = Read<std::uint32_t>(m_base, descriptor);
+            const auto dllName = Read<std::uint32_t>(m_base, descriptor + 12);
+            const auto slots = Read<std::uint32_t>(m_base, descriptor + 16);
+            if (dllName == 0 && slots == 0)
+            {
+                break;
+            }
+            // Without the name table the slots already hold resolved addresses
+            if (names == 0 || !Contains(dllName))
+            {
+                continue;
+            }
+
+            const char *dll = reinterpret_cast<const char *>(m_base + dllName);
+            if (module != "*" && !EqualsIgnoreCase(module, std::string_view(dll, strnlen(dll, m_sizeOfImage - dllName))))
+            {
+                continue;
+            }
+
+            for (std::uint32_t index = 0;; ++index)
+            {
+                const std::uint32_t thunk = names + index * thunkSize;
+                if (!Contains(thunk, thunkSize))
+                {
+                    break;
+                }
+
+                std::uint64_t entry = m_pe64 ? Read<std::uint64_t>(m_base, thunk) : Read<std::uint32_t>(m_base, thunk);
+                if (entry == 0)
+                {
+                    break;
+                }
+                const std::uint64_t ordinalFlag = m_pe64 ? 1ull << 63 : 1ull << 31;
+                if (entry & ordinalFlag)
+                {
+                    continue;
+                }
+
+                // IMAGE_IMPORT_BY_NAME: u16 hint, then the name
+                const auto byName = static_cast<std::uint32_t>(entry);
+                if (!Contains(byName, 3))
+                {
+                    continue;
+                }
+                const char *name = reinterpret_cast<const char *>(m_base + byName + 2);
+                if (std::string_view(name, strnlen(name, m_sizeOfImage - byName - 2)) == symbol)
+                {
+                    return slots + index * thunkSize;
+                }
+            }
+        }
+        return 0;
+    }
+} // namespace abyss::offsets
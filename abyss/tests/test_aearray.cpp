@@ -1,8 +1,12 @@
 #include <abyss/AEArray.h>  // Assuming the class is in Array.hpp
+#include <abyss/ArrayView.h>
 #include <boost/ut.hpp>
 #include <string>
 #include <algorithm>
 #include <memory>
+#include <numeric>
+#include <ranges>
+#include <span>
 #include <yu/yu.h>
 
 namespace ut = boost::ut;
@@ -416,5 +420,235 @@ int main() {
         expect(arr[0] == static_cast<int>(large_count));
     };
     
+    "Array geometric growth"_test = [] {
+        Array<int, GeometricGrowth> arr;
+        for (int i = 0; i < 100; ++i) {
+            arr.Add(i);
+        }
+        expect(arr.Size() == 100_u);
+        expect(arr.Capacity() == 128_u);  // 4, 8, ..., 128
+        expect(arr[99] == 99_i);
+
+        // Removals keep the allocation
+        arr.RemoveAt(0);
+        arr.Remove(50);
+        expect(arr.Size() == 98_u);
+        expect(arr.Capacity() == 128_u);
+        expect(arr[0] == 1_i);
+
+        arr.ShrinkToFit();
+        expect(arr.Capacity() == 98_u);
+        expect(arr[97] == 99_i);
+    };
+
+    "Array engine growth stays exact"_test = [] {
+        Array<int> arr;
+        arr.PushBack(1);
+        arr.PushBack(2);
+        arr.Add(3);
+        expect(arr.Capacity() == 3_u);
+        arr.RemoveAt(0);
+        expect(arr.Capacity() == 2_u);
+    };
+
+    "Array Reserve and ShrinkToFit"_test = [] {
+        Array<int> arr;
+        arr.ShrinkToFit();  // Nothing allocated: stays empty
+        expect(!arr.IsValid());
+
+        arr.Reserve(16);
+        expect(arr.Capacity() == 16_u);
+        expect(arr.Size() == 0_u);
+        for (int i = 0; i < 16; ++i) {
+            arr.EmplaceBack(i);
+        }
+        expect(arr.Capacity() == 16_u);  // No reallocation while there is room
+        arr.Reserve(8);
+        expect(arr.Capacity() == 16_u);  // Reserve never shrinks
+
+        arr.SetLength(0);
+        arr.ShrinkToFit();
+        expect(arr.Capacity() == 1_u);
+    };
+
+    "Array EmplaceBack constructs in place"_test = [] {
+        reset_test_class_counters();
+        {
+            Array<TestClass, GeometricGrowth> arr;
+            arr.Reserve(4);
+            TestClass& item = arr.EmplaceBack(7);
+            expect(item.value == 7_i);
+            expect(TestClass::constructor_count == 1_i);  // No temporary
+
+            arr.EmplaceBack(8);
+            arr.PushBack(TestClass(9));
+            // Growth with an argument that lives inside the array
+            arr.EmplaceBack(arr[0]);
+            arr.EmplaceBack(arr[1]);
+            expect(arr.Size() == 5_u);
+            expect(arr[3].value == 7_i);
+            expect(arr[4].value == 8_i);
+        }
+        expect(TestClass::constructor_count == TestClass::destructor_count);
+    };
+
+    "Array PushBack moves"_test = [] {
+        Array<std::unique_ptr<int>, GeometricGrowth> arr;
+        arr.PushBack(std::make_unique<int>(1));
+        arr.EmplaceBack(new int(2));
+        for (int i = 0; i < 10; ++i) {
+            arr.PushBack(std::make_unique<int>(i));
+        }
+        expect(arr.Size() == 12_u);
+        expect(*arr[0] == 1_i);
+        expect(*arr[1] == 2_i);
+        expect(*arr[11] == 9_i);
+    };
+
+    "Array AppendRange and InsertRange"_test = [] {
+        Array<int> arr;
+        const int head[] = {1, 2, 3};
+        arr.AppendRange(head);
+        expect(arr.Size() == 3_u);
+        expect(arr.Capacity() == 3_u);  // Engine policy: exact fit
+
+        const int middle[] = {8, 9};
+        arr.InsertRange(1, middle);
+        expect(arr.Size() == 5_u);
+        expect(arr[0] == 1_i && arr[1] == 8_i && arr[2] == 9_i && arr[3] == 2_i && arr[4] == 3_i);
+
+        // Source inside the array, straddling the insertion point: 1 8 [9 2] 3
+        arr.InsertRange(3, std::span<const int>(&arr[2], 2));
+        const int expected[] = {1, 8, 9, 9, 2, 2, 3};
+        expect(arr.Size() == 7_u);
+        expect(std::equal(std::begin(expected), std::end(expected), &arr[0]));
+
+        arr.AppendRange(std::span<const int>(&arr[0], arr.Size()));
+        expect(arr.Size() == 14_u);
+        expect(arr[7] == 1_i && arr[13] == 3_i);
+
+        arr.InsertRange(100, middle);  // Clamped to the end
+        expect(arr[14] == 8_i && arr[15] == 9_i);
+    };
+
+    "Array EraseRange, EraseIf and RemoveAtUnordered"_test = [] {
+        Array<int, GeometricGrowth> arr;
+        for (int i = 0; i < 10; ++i) {
+            arr.PushBack(i);
+        }
+        const auto capacity = arr.Capacity();
+
+        arr.EraseRange(2, 3);  // 0 1 5 6 7 8 9
+        expect(arr.Size() == 7_u);
+        expect(arr[2] == 5_i);
+        expect(arr.Capacity() == capacity);  // Geometric policy keeps its capacity
+
+        expect(arr.EraseIf([](int v) { return v % 2 == 1; }) == 4_u);  // 0 6 8
+        expect(arr.Size() == 3_u);
+        expect(arr[0] == 0_i && arr[1] == 6_i && arr[2] == 8_i);
+
+        arr.RemoveAtUnordered(0);  // 8 6
+        expect(arr.Size() == 2_u);
+        expect(arr[0] == 8_i && arr[1] == 6_i);
+
+        arr.EraseRange(1, 100);  // Clamped to the end
+        expect(arr.Size() == 1_u);
+
+        Array<int> exact;
+        const int values[] = {1, 2, 3, 4, 5};
+        exact.AppendRange(values);
+        exact.EraseRange(0, 2);
+        expect(exact.Capacity() == 3_u);  // Engine policy shrinks
+        expect(exact.EraseIf([](int) { return true; }) == 3_u);
+        expect(exact.Capacity() == 1_u);
+    };
+
+    "Array range operations on non-trivial types"_test = [] {
+        reset_test_class_counters();
+        {
+            Array<TestClass, GeometricGrowth> arr;
+            const TestClass values[] = {TestClass(1), TestClass(2), TestClass(3), TestClass(4)};
+            arr.AppendRange(values);
+            arr.InsertRange(2, std::span<const TestClass>(&arr[0], 2));  // 1 2 1 2 3 4
+            expect(arr.Size() == 6_u);
+            expect(arr[2].value == 1_i && arr[3].value == 2_i && arr[5].value == 4_i);
+
+            arr.Reserve(16);
+            arr.InsertRange(0, values);  // In place: 1 2 3 4 1 2 1 2 3 4
+            expect(arr.Size() == 10_u);
+            expect(arr[4].value == 1_i && arr[9].value == 4_i);
+
+            arr.EraseRange(0, 4);
+            expect(arr.EraseIf([](const TestClass& c) { return c.value == 2; }) == 2_u);  // 1 1 3 4
+            arr.RemoveAtUnordered(1);  // 1 4 3
+            expect(arr.Size() == 3_u);
+            expect(arr[0].value == 1_i && arr[1].value == 4_i && arr[2].value == 3_i);
+        }
+        expect(TestClass::constructor_count == TestClass::destructor_count);
+    };
+
+    "Array iterators and span views"_test = [] {
+        static_assert(std::ranges::contiguous_range<Array<int>>);
+        static_assert(std::ranges::sized_range<const Array<int>>);
+
+        Array<int> arr;
+        expect(arr.begin() == arr.end());
+        const int values[] = {5, 3, 9, 1};
+        arr.AppendRange(values);
+
+        std::span<int> writable = arr;
+        std::span<const int> readable = arr;
+        expect(writable.size() == 4_u);
+        expect(readable.data() == arr.data());
+
+        std::ranges::sort(arr);
+        expect(arr[0] == 1_i && arr[3] == 9_i);
+        expect(std::accumulate(arr.cbegin(), arr.cend(), 0) == 18_i);
+
+        int visited = 0;
+        for (int& v : arr) {
+            v *= 2;
+            ++visited;
+        }
+        expect(visited == 4_i);
+        expect(std::ranges::find(arr, 18) == arr.end() - 1);
+    };
+
+    "ArrayView wraps a live array without owning it"_test = [] {
+        static_assert(std::ranges::view<ArrayView<int>>);
+        static_assert(std::ranges::borrowed_range<ArrayView<const int>>);
+
+        expect(ArrayView<int>().empty());
+        expect(!ArrayView<int>().IsValid());
+
+        Array<int> arr;
+        const int values[] = {1, 2, 3};
+        arr.AppendRange(values);
+
+        // As the mod sees the game's arrays: only an address
+        const auto address = reinterpret_cast<std::uintptr_t>(&arr);
+        {
+            ArrayView<int> view = ArrayView<int>::At(address);
+            expect(view.IsValid());
+            expect(view.size() == 3_u);
+            view[1] = 20;
+            for (int& v : view) {
+                v += 1;
+            }
+        }  // The view's destructor leaves the array alone
+        expect(arr.Size() == 3_u);
+        expect(arr[0] == 2_i && arr[1] == 21_i && arr[2] == 4_i);
+
+        // The view follows reallocations of the underlying array
+        const ArrayView<const int> view = ArrayView<const int>::At(address);
+        arr.Add(7);
+        expect(view.size() == 4_u);
+        expect(view.data() == arr.data());
+        expect(view.AsSpan().back() == 7_i);
+
+        auto doubled = view | std::views::transform([](int v) { return v * 2; });
+        expect(*std::ranges::begin(doubled) == 4_i);
+    };
+
     return 0;
 }
\ No newline at end of file
@@ -1,10 +1,29 @@
 #include <boost/ut.hpp>
 #include <abyss/AEString.h>
+#include <abyss/Utf.h>
+#include <Windows.h>
 #include <string>
 #include <vector>
 
 namespace ut = boost::ut;
 
+namespace {
+    // The previous implementation (two Win32 passes and an allocation per call), kept as the reference
+    std::wstring LegacyToWide(std::string_view sv) {
+        int wideLen = MultiByteToWideChar(CP_UTF8, 0, sv.data(), static_cast<int>(sv.size()), nullptr, 0);
+        std::wstring result(static_cast<std::size_t>(wideLen > 0 ? wideLen : 0), L'\0');
+        MultiByteToWideChar(CP_UTF8, 0, sv.data(), static_cast<int>(sv.size()), result.data(), wideLen);
+        return result;
+    }
+
+    std::string LegacyToUTF8(std::wstring_view ws) {
+        int utf8Len = WideCharToMultiByte(CP_UTF8, 0, ws.data(), static_cast<int>(ws.size()), nullptr, 0, nullptr, nullptr);
+        std::string result(static_cast<std::size_t>(utf8Len > 0 ? utf8Len : 0), '\0');
+        WideCharToMultiByte(CP_UTF8, 0, ws.data(), static_cast<int>(ws.size()), result.data(), utf8Len, nullptr, nullptr);
+        return result;
+    }
+}
+
 int main() {
     using namespace ut;
     using namespace ut::spec;
@@ -261,5 +280,73 @@ int main() {
                 expect(a == L"C");
             };
         };
+
+        describe("transcoding") = [] {
+            it("should match the Win32 conversion") = [] {
+                // Lengths around the 16-character SIMD blocks, ASCII runs broken by multi-byte characters
+                const std::string samples[] = {
+                    "", "a", "exactly sixteen!", "seventeen chars!!", std::string(40, 'x') + "é" + std::string(20, 'y'),
+                    "Hello 世界 ✨", "Emoji 🎯 between ASCII runs of some length", "ÀÉÎÕÜ àéîõü ßñ",
+                };
+                for (const auto& sample : samples) {
+                    const std::wstring expected = LegacyToWide(sample);
+                    std::vector<wchar_t> wide(abyss::utf::MaxWideLength(sample.size()));
+                    const auto wideLen = abyss::utf::ToWide(sample, wide);
+                    expect(std::wstring(wide.data(), wideLen) == expected);
+
+                    std::vector<char> utf8(abyss::utf::MaxUtf8Length(wideLen));
+                    const auto utf8Len = abyss::utf::ToUtf8(std::wstring_view(wide.data(), wideLen), utf8);
+                    expect(std::string(utf8.data(), utf8Len) == sample);
+                    expect(LegacyToUTF8(expected) == sample);
+
+                    std::vector<char16_t> utf16(abyss::utf::MaxWideLength(sample.size()));
+                    const auto utf16Len = abyss::utf::ToUtf16(sample, utf16);
+                    std::vector<char> fromUtf16(utf16Len * 3);
+                    const auto back = abyss::utf::ToUtf8(std::u16string_view(utf16.data(), utf16Len), fromUtf16);
+                    expect(std::string(fromUtf16.data(), back) == sample);
+                }
+            };
+
+            it("should replace invalid input with U+FFFD") = [] {
+                std::wstring wide(16, L'\0');
+                // Lone continuation byte, truncated 3-byte sequence, overlong encoding
+                expect(abyss::utf::ToWide("a\x80" "b", wide) == 3_u);
+                expect(wide[1] == L'\xFFFD');
+                expect(abyss::utf::ToWide("\xE4\xB8", wide) == 1_u);
+                expect(wide[0] == L'\xFFFD');
+                expect(abyss::utf::ToWide("\xC0\xAF", wide) == 2_u);
+
+                const char16_t lone[] = {u'a', 0xD800, u'b'};
+                char utf8[16];
+                const auto n = abyss::utf::ToUtf8(std::u16string_view(lone, 3), utf8);
+                expect(std::string(utf8, n) == "a\xEF\xBF\xBD" "b");
+            };
+
+            it("should stop at the last whole character that fits") = [] {
+                char small[5];
+                const abyss::String s{"ab世界"};
+                expect(s.ToUTF8(std::span<char>(small)) == 5_u);
+                expect(std::string(small, 5) == "ab世");
+
+                const char16_t pair[] = {u'x', 0xD83C, 0xDFAF};  // x🎯
+                char16_t out[2];
+                expect(abyss::utf::ToUtf16("x🎯", std::span<char16_t>(out)) == 1_u);
+                std::string back(8, '\0');
+                expect(abyss::utf::ToUtf8(std::u16string_view(pair, 3), back) == 5_u);
+            };
+
+            it("should append without reallocating a reserved string") = [] {
+                const abyss::String s{"Overlay text, converted every frame"};
+                std::string out;
+                out.reserve(256);
+                const char* buffer = out.data();
+                for (int i = 0; i < 3; ++i) {
+                    s.AppendUTF8(out);
+                }
+                expect(out.data() == buffer);
+                expect(out.size() == 3 * s.size());
+                expect(std::string_view(abyss::utf::ToUtf8Scratch(s.c_str())) == s.ToUTF8());
+            };
+        };
     };
 }
\ No newline at end of file
@@ -0,0 +1,97 @@
+#include <boost/ut.hpp>
+#include <abyss/Interner.h>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace ut = boost::ut;
+
+int main() {
+    using namespace ut;
+    using namespace ut::spec;
+
+    cfg<override> = {.tag = {"abyss::Interner"}};
+
+    describe("abyss::Interner") = [] {
+        it("should return stable ids") = [] {
+            abyss::Interner interner;
+            const auto mesh = interner.Intern(std::wstring_view(L"mesh_01"));
+            const auto station = interner.Intern(std::wstring_view(L"station"));
+            expect(mesh != abyss::InvalidInternId);
+            expect(mesh != station);
+            expect(interner.Intern(std::wstring_view(L"mesh_01")) == mesh);
+            expect(interner.Find(L"station") == station);
+            expect(interner.Find(L"missing") == abyss::InvalidInternId);
+            expect(interner.Size() == 2_u);
+
+            const auto empty = interner.Intern(std::wstring_view());
+            expect(empty != abyss::InvalidInternId);
+            expect(interner.Wide(empty).empty());
+        };
+
+        it("should intern UTF-8 and engine strings with the same id") = [] {
+            abyss::Interner interner;
+            const auto id = interner.Intern(std::wstring_view(L"Hello 世界"));
+            expect(interner.Intern(std::string_view("Hello 世界")) == id);
+            expect(interner.Intern(abyss::String{L"Hello 世界"}) == id);
+
+            const std::string longName(1000, 'n');  // Converted outside the stack buffer
+            const auto longId = interner.Intern(std::string_view(longName));
+            expect(interner.Wide(longId).size() == 1000_u);
+        };
+
+        it("should convert and cache the UTF-8 form") = [] {
+            abyss::Interner interner;
+            const auto id = interner.Intern(std::wstring_view(L"Größe"));
+            const std::string_view first = interner.Utf8(id);
+            expect(first == std::string_view("Größe"));
+            expect(first.data()[first.size()] == '\0');
+            expect(interner.Utf8(id).data() == first.data());  // Cached
+            expect(interner.Wide(id) == std::wstring_view(L"Größe"));
+            expect(interner.Wide(id).data()[5] == L'\0');
+            expect(interner.Utf8(abyss::InvalidInternId).empty());
+            expect(interner.Utf8(1000).empty());
+        };
+
+        it("should keep ids and views valid across growth") = [] {
+            abyss::Interner interner;
+            const auto first = interner.Intern(std::wstring_view(L"first"));
+            const std::wstring_view firstView = interner.Wide(first);
+            for (int i = 0; i < 5000; ++i) {
+                interner.Intern(std::wstring_view(L"name_" + std::to_wstring(i)));
+            }
+            expect(interner.Size() == 5001_u);
+            expect(interner.Find(L"first") == first);
+            expect(interner.Wide(first).data() == firstView.data());
+            expect(interner.Find(L"name_4999") == 5001_u);
+            expect(interner.Footprint() > 0_u);
+        };
+
+        it("should hand out one id per string across threads") = [] {
+            abyss::Interner interner;
+            constexpr int threadCount = 4;
+            constexpr int names = 2000;
+            std::vector<std::vector<abyss::InternId>> ids(threadCount, std::vector<abyss::InternId>(names));
+            std::vector<std::thread> threads;
+            for (int t = 0; t < threadCount; ++t) {
+                threads.emplace_back([&, t] {
+                    for (int i = 0; i < names; ++i) {
+                        const std::wstring name = L"item_" + std::to_wstring(i);
+                        ids[t][i] = interner.Intern(std::wstring_view(name));
+                    }
+                });
+            }
+            for (auto& thread : threads) {
+                thread.join();
+            }
+
+            expect(interner.Size() == static_cast<std::uint32_t>(names));
+            for (int t = 1; t < threadCount; ++t) {
+                expect(ids[t] == ids[0]);
+            }
+            expect(interner.Wide(ids[0][42]) == std::wstring_view(L"item_42"));
+        };
+    };
+
+    return 0;
+}
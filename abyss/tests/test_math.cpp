@@ -0,0 +1,183 @@
+#include <abyss/math/Batch.hpp>
+#include <abyss/math/Matrix.hpp>
+#include <abyss/math/Vector.hpp>
+#include <boost/ut.hpp>
+#include <cmath>
+#include <vector>
+
+namespace ut = boost::ut;
+using namespace boost::ut::literals;
+
+namespace {
+    bool near(float a, float b, float eps = 1e-4f) {
+        return std::fabs(a - b) <= eps * (1.0f + std::fabs(a) + std::fabs(b));
+    }
+
+    bool near(const abyss::math::Vector& a, const abyss::math::Vector& b, float eps = 1e-4f) {
+        return near(a[0], b[0], eps) && near(a[1], b[1], eps) && near(a[2], b[2], eps);
+    }
+
+    bool near(const abyss::math::Matrix& a, const abyss::math::Matrix& b, float eps = 1e-4f) {
+        for (std::size_t i = 0; i < 16; ++i) {
+            if (!near(a[i], b[i], eps)) return false;
+        }
+        return true;
+    }
+
+    // Rotation + translation + non-uniform scale
+    abyss::math::Matrix sample_matrix() {
+        return abyss::math::Matrix::Identity()
+            .SetRotation(0.3f, -1.1f, 0.7f)
+            .SetScaling(2.0f, 0.5f, 1.5f)
+            .SetTranslation(10.0f, -4.0f, 2.5f);
+    }
+}
+
+int main() {
+    using namespace ut;
+    using namespace abyss::math;
+
+    "Vector arithmetic"_test = [] {
+        const Vector a(1.0f, 2.0f, 3.0f);
+        const Vector b(4.0f, -5.0f, 6.0f);
+
+        expect(Vector() == Vector(0.0f, 0.0f, 0.0f));
+        expect(a + b == Vector(5.0f, -3.0f, 9.0f));
+        expect(a - b == Vector(-3.0f, 7.0f, -3.0f));
+        expect(a * 2.0f == Vector(2.0f, 4.0f, 6.0f));
+        expect(near(a / 4.0f, Vector(0.25f, 0.5f, 0.75f)));
+        expect(a != b);
+        expect(near(a.Dot(b), 12.0f));
+        expect(a.Cross(b) == Vector(27.0f, 6.0f, -13.0f));
+        expect(near(Vector(3.0f, 4.0f, 0.0f).Length(), 5.0f));
+        expect(near(Vector(0.0f, 0.0f, 9.0f).Normalize(), Vector(0.0f, 0.0f, 1.0f)));
+        expect(Vector().Normalize() == Vector());
+        expect(near(a.Lerp(b, 0.5f), Vector(2.5f, -1.5f, 4.5f)));
+
+        Vector c = a;
+        c += b;
+        c -= a;
+        c *= 2.0f;
+        c /= 2.0f;
+        expect(near(c, b));
+    };
+
+    "Matrix identity and accessors"_test = [] {
+        const Matrix id = Matrix::Identity();
+        const Vector p(1.0f, 2.0f, 3.0f);
+
+        expect(Matrix()[0] == 0.0_f);
+        expect(id.Transform(p) == p);
+        expect(id * id == id);
+        expect(id.Right() == Vector(1.0f, 0.0f, 0.0f));
+        expect(id.Up() == Vector(0.0f, 1.0f, 0.0f));
+        expect(id.Dir() == Vector(0.0f, 0.0f, 1.0f));
+
+        const Matrix t = id.SetTranslation(5.0f, 6.0f, 7.0f);
+        expect(t.Position() == Vector(5.0f, 6.0f, 7.0f));
+        expect(t.Transform(p) == Vector(6.0f, 8.0f, 10.0f));
+        expect(t.Rotate(p) == p);
+
+        Matrix copy;
+        copy = t;
+        expect(copy == t);
+    };
+
+    "Matrix rotation"_test = [] {
+        // Yaw a quarter turn: +Z turns into +X in a left-handed frame
+        const Matrix yaw = Matrix::Identity().SetRotation(0.0f, 1.5707963f, 0.0f);
+        expect(near(yaw.Rotate(Vector(0.0f, 0.0f, 1.0f)), Vector(1.0f, 0.0f, 0.0f)));
+
+        const Matrix r = Matrix::Identity().SetRotation(0.3f, -1.1f, 0.7f);
+        expect(near(r.Right().Length(), 1.0f));
+        expect(near(r.Right().Dot(r.Up()), 0.0f));
+        expect(near(r.Up().Dot(r.Dir()), 0.0f));
+
+        const Matrix rt = r.SetTranslation(1.0f, 2.0f, 3.0f);
+        const Vector p(-2.0f, 4.0f, 0.5f);
+        expect(near(rt.InverseTransform(rt.Transform(p)), p));
+        expect(near(rt.InverseRotate(rt.Rotate(p)), p));
+    };
+
+    "Matrix product and inverse"_test = [] {
+        const Matrix m = sample_matrix();
+        const Matrix n = Matrix::Identity().SetRotation(-0.5f, 0.2f, 1.9f).SetTranslation(-1.0f, 0.0f, 8.0f);
+        const Vector p(3.0f, -1.0f, 2.0f);
+
+        // Row vectors: (p * m) * n == p * (m * n)
+        expect(near((m * n).Transform(p), n.Transform(m.Transform(p))));
+        expect(near(m * m.Inverse(), Matrix::Identity()));
+        expect(near(m.Inverse().Transform(m.Transform(p)), p));
+        expect(Matrix().Inverse() == Matrix());
+
+        Matrix acc = m;
+        acc *= n;
+        expect(near(acc, m * n));
+        expect(near((m + n) - n, m));
+        expect(near((m * 3.0f) / 3.0f, m));
+        expect(near(m.OpenGL().OpenGL(), m));
+        expect(m.OpenGL()[1] == m[4]);
+    };
+
+    "Matrix look at"_test = [] {
+        const Vector eye(0.0f, 0.0f, -10.0f);
+        const Matrix view = Matrix::Identity().LookAt(eye, Vector(0.0f, 0.0f, 0.0f), Vector(0.0f, 1.0f, 0.0f));
+
+        expect(near(view.Transform(eye), Vector()));
+        expect(near(view.Transform(Vector(0.0f, 0.0f, 0.0f)), Vector(0.0f, 0.0f, 10.0f)));
+        expect(near(view.Transform(Vector(1.0f, 0.0f, -10.0f)), Vector(1.0f, 0.0f, 0.0f)));
+    };
+
+    "Batch transforms match the scalar path"_test = [] {
+        const Matrix m = sample_matrix();
+        // 11 points: two SIMD blocks of four and a scalar tail of three
+        std::vector<Vector> points;
+        for (int i = 0; i < 11; ++i) {
+            points.emplace_back(static_cast<float>(i), static_cast<float>(i * i) * 0.5f, -static_cast<float>(i) * 2.0f);
+        }
+
+        std::vector<Vector> transformed(points.size());
+        std::vector<Vector> rotated(points.size());
+        TransformPoints(m, points, transformed);
+        RotateVectors(m, points, rotated);
+        for (std::size_t i = 0; i < points.size(); ++i) {
+            expect(near(transformed[i], m.Transform(points[i])));
+            expect(near(rotated[i], m.Rotate(points[i])));
+        }
+
+        // In place
+        std::vector<Vector> inPlace = points;
+        TransformPoints(m, inPlace, inPlace);
+        for (std::size_t i = 0; i < points.size(); ++i) {
+            expect(near(inPlace[i], transformed[i]));
+        }
+
+        // Shorter destination: only out.size() points are written
+        std::vector<Vector> shortOut(2);
+        TransformPoints(m, points, shortOut);
+        expect(near(shortOut[1], transformed[1]));
+    };
+
+    "Batch matrix products"_test = [] {
+        const Matrix m = sample_matrix();
+        std::vector<Matrix> a;
+        std::vector<Matrix> b;
+        for (int i = 0; i < 5; ++i) {
+            a.push_back(Matrix::Identity().SetRotation(0.1f * i, 0.2f * i, 0.3f * i).SetTranslation(1.0f * i, 0.0f, 0.0f));
+            b.push_back(m.SetTranslation(0.0f, 1.0f * i, 0.0f));
+        }
+
+        std::vector<Matrix> out(a.size());
+        MultiplyMatrices(a, b, out);
+        for (std::size_t i = 0; i < a.size(); ++i) {
+            expect(near(out[i], a[i] * b[i]));
+        }
+
+        MultiplyMatrices(a, m, out);
+        for (std::size_t i = 0; i < a.size(); ++i) {
+            expect(near(out[i], a[i] * m));
+        }
+    };
+
+    return 0;
+}
@@ -0,0 +1,89 @@
+#include <boost/ut.hpp>
+#include <abyss/AEArray.h>
+#include <abyss/AEString.h>
+#include <abyss/SmallString.h>
+#include <abyss/TransformObserver.h>
+#include <yu/testing.h>
+#include <array>
+#include <string>
+
+namespace ut = boost::ut;
+
+int main() {
+    yu::testing::InstallCountingAllocator();
+
+    using namespace ut;
+    using namespace ut::spec;
+
+    cfg<override> = {.tag = {"abyss no-alloc"}};
+
+    describe("abyss::Array") = [] {
+        it("should not allocate in AddCached within capacity") = [] {
+            abyss::Array<int> array;
+            array.Reserve(256);
+            YU_EXPECT_NO_ALLOC {
+                for (int i = 0; i < 256; ++i) array.AddCached(i);
+            };
+            expect(array.Size() == 256_u);
+            expect(array[255] == 255_i);
+        };
+
+        it("should allocate once per doubling in AddCached") = [] {
+            abyss::Array<int> array;
+            yu::testing::AllocationScope scope;
+            for (int i = 0; i < 1024; ++i) array.AddCached(i);
+            expect(scope.Count() <= 11_u);  // 1, 2, 4, ... 1024
+        };
+    };
+
+    describe("abyss::String") = [] {
+        it("should convert into a caller buffer without allocating") = [] {
+            const abyss::String text = abyss::String::FromUTF8("Größe und Maß");
+            std::array<char, 64> buffer{};
+            std::string reused;
+            reused.reserve(64);
+            std::size_t written = 0;
+            YU_EXPECT_NO_ALLOC {
+                written = text.ToUTF8(buffer);
+                reused.clear();
+                text.AppendUTF8(reused);
+            };
+            expect(std::string_view(buffer.data(), written) == std::string_view("Größe und Maß"));
+            expect(reused == std::string("Größe und Maß"));
+        };
+
+        it("should keep short names inline in SmallString") = [] {
+            std::uint32_t size = 0;
+            bool inlined = false;
+            YU_EXPECT_NO_ALLOC {
+                abyss::SmallString name(L"Vossk");
+                size = name.size();
+                inlined = name.IsInline();
+            };
+            expect(size == 5_u);
+            expect(inlined);
+        };
+    };
+
+    describe("abyss::TransformObserver") = [] {
+        it("should not allocate on a steady scene") = [] {
+            std::array<abyss::Transform, 64> transforms{};
+            abyss::Array<abyss::Transform*> live;
+            for (auto& transform : transforms) live.AddCached(&transform);
+
+            abyss::TransformObserver observer;
+            // Two warm-ups: the previous and current buffers swap every update
+            observer.Update(live);
+            observer.Update(live);
+            bool changed = true;
+            YU_EXPECT_NO_ALLOC {
+                observer.Update(live);
+                changed = observer.Changed();
+            };
+            expect(!changed);
+            live.Clear();
+        };
+    };
+
+    return 0;
+}
@@ -0,0 +1,197 @@
+#include <boost/ut.hpp>
+#include <abyss/offsets/resolver.hpp>
+#include <abyss/offsets/scanner.hpp>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <vector>
+
+namespace ut = boost::ut;
+
+namespace {
+    using abyss::offsets::Find;
+    using abyss::offsets::NotFound;
+    using abyss::offsets::Pattern;
+
+    std::size_t NaiveFind(std::span<const std::uint8_t> haystack, const Pattern& pattern) {
+        for (std::size_t i = 0; i + pattern.Size() <= haystack.size(); ++i) {
+            if (pattern.Matches(haystack.data() + i)) return i;
+        }
+        return NotFound;
+    }
+
+    template <typename T>
+    void Put(std::vector<std::uint8_t>& image, std::size_t offset, T value) {
+        std::memcpy(image.data() + offset, &value, sizeof(T));
+    }
+
+    // Smallest PE32 image ModuleImage::Parse accepts: headers and one .text section at 0x1000
+    constexpr std::uint32_t TextRva = 0x1000;
+    constexpr std::uint32_t ImageSize = 0x3000;
+
+    std::vector<std::uint8_t> MakeImage(std::uint32_t timeDateStamp) {
+        std::vector<std::uint8_t> image(ImageSize, 0xCC);
+        std::memset(image.data(), 0, TextRva);
+        Put<std::uint16_t>(image, 0, 0x5A4D);         // "MZ"
+        Put<std::uint32_t>(image, 0x3C, 0x80);
+        Put<std::uint32_t>(image, 0x80, 0x00004550);  // "PE\0\0"
+        Put<std::uint16_t>(image, 0x84 + 2, 1);       // Sections
+        Put<std::uint32_t>(image, 0x84 + 4, timeDateStamp);
+        Put<std::uint16_t>(image, 0x84 + 16, 0xE0);   // Optional header size
+        const std::size_t optional = 0x98;
+        Put<std::uint16_t>(image, optional, 0x10B);
+        Put<std::uint32_t>(image, optional + 56, ImageSize);
+        Put<std::uint32_t>(image, optional + 92, 16); // Data directories, no imports
+        const std::size_t section = optional + 0xE0;
+        std::memcpy(image.data() + section, ".text", 5);
+        Put<std::uint32_t>(image, section + 8, 0x1000);
+        Put<std::uint32_t>(image, section + 12, TextRva);
+        Put<std::uint32_t>(image, section + 36, 0x60000020); // Code, execute, read
+
+        // A function start, and a call whose rel32 points 0x100 bytes past its end
+        const std::uint8_t function[] = {0x55, 0x8B, 0xEC, 0x83, 0xEC, 0x10, 0x53};
+        std::memcpy(image.data() + TextRva + 0x234, function, sizeof(function));
+        const std::uint8_t call[] = {0x85, 0xC9, 0xE8};
+        std::memcpy(image.data() + TextRva + 0x800, call, sizeof(call));
+        Put<std::int32_t>(image, TextRva + 0x803, 0x100);
+        return image;
+    }
+
+    constexpr abyss::offsets::Signature Table[] = {
+        {"test.function", abyss::offsets::SignatureKind::Address, "55 8B EC 83 EC ?? 53", 0, 0x401111},
+        {"test.call", abyss::offsets::SignatureKind::Relative, "85 C9 E8 ?? ?? ?? ??", 3, 0x402222},
+        {"test.missing", abyss::offsets::SignatureKind::Address, "DE AD BE EF", 0, 0x403333},
+        {"test.unknown", abyss::offsets::SignatureKind::Address, nullptr, 0, 0x404444},
+    };
+}
+
+int main() {
+    using namespace ut;
+    using namespace ut::spec;
+
+    cfg<override> = {.tag = {"abyss::offsets scanner"}};
+
+    describe("abyss::offsets::Pattern") = [] {
+        it("should parse bytes and both wildcard forms") = [] {
+            const Pattern pattern("8B 0D ?? ?? ? ?? 85 c9");
+            expect(pattern.Size() == 8_u);
+            expect(pattern.Bytes()[0] == 0x8B && pattern.Bytes()[1] == 0x0D && pattern.Bytes()[7] == 0xC9);
+            expect(pattern.Mask()[0] == 0xFF && pattern.Mask()[2] == 0 && pattern.Mask()[4] == 0 && pattern.Mask()[6] == 0xFF);
+            expect(pattern.FirstAnchor() == 0_u);
+            expect(pattern.LastAnchor() == 7_u);
+
+            const Pattern padded("?? E8 ?? 90 ??");
+            expect(padded.Size() == 5_u);
+            expect(padded.FirstAnchor() == 1_u);
+            expect(padded.LastAnchor() == 3_u);
+        };
+
+        it("should give an empty pattern for malformed text") = [] {
+            expect(Pattern("").Empty());
+            expect(Pattern("?? ?").Empty()) << "wildcards only";
+            expect(Pattern("8B 0").Empty()) << "odd digit";
+            expect(Pattern("8B 0G").Empty());
+            expect(Pattern("8B,0D").Empty());
+            expect(!Pattern("8B0D").Empty()) << "spaces are optional";
+        };
+    };
+
+    describe("abyss::offsets::Find") = [] {
+        it("should find a match on either side of the 16-byte blocks") = [] {
+            const Pattern pattern("?? 55 ?? 8B EC");
+            std::vector<std::uint8_t> buffer(200, 0x90);
+            for (std::size_t size = pattern.Size(); size <= 80; ++size) {
+                // Unaligned start, match ending on the last byte
+                std::span<std::uint8_t> haystack(buffer.data() + 1, size);
+                std::fill(buffer.begin(), buffer.end(), 0x90);
+                const std::size_t at = size - pattern.Size();
+                haystack[at + 1] = 0x55;
+                haystack[at + 3] = 0x8B;
+                haystack[at + 4] = 0xEC;
+                expect(Find(haystack, pattern) == at) << "haystack of" << size;
+                // The last byte missing: no match, and no read past the end
+                expect(Find(haystack.first(size - 1), pattern) == NotFound) << "haystack of" << size;
+            }
+        };
+
+        it("should return the first of several matches") = [] {
+            const Pattern pattern("E8 ?? ?? ?? ?? 85 C0");
+            std::vector<std::uint8_t> haystack(100, 0);
+            for (std::size_t at : {70u, 41u, 18u}) {
+                haystack[at] = 0xE8;
+                haystack[at + 5] = 0x85;
+                haystack[at + 6] = 0xC0;
+            }
+            expect(Find(haystack, pattern) == 18_u);
+            expect(Find(std::span(haystack).subspan(19), pattern) == 22_u);
+            expect(Find(std::span(haystack).first(4), pattern) == NotFound);
+        };
+
+        it("should agree with a byte by byte search") = [] {
+            // Three of the 256 byte values: anchors match often, full matches now and then
+            std::uint32_t state = 12345;
+            std::vector<std::uint8_t> haystack(4099);
+            for (auto& byte : haystack) {
+                state = state * 1664525u + 1013904223u;
+                byte = static_cast<std::uint8_t>(0x40 + (state >> 24) % 3);
+            }
+            for (const char* text : {"40 41 42", "41 ?? ?? 41", "42 42 ?? 40 40", "?? 40 41 ?? 42 ??", "43"}) {
+                const Pattern pattern(text);
+                for (std::size_t offset : {0u, 1u, 7u, 15u}) {
+                    const auto span = std::span<const std::uint8_t>(haystack).subspan(offset);
+                    expect(Find(span, pattern) == NaiveFind(span, pattern)) << text << "at" << offset;
+                }
+            }
+        };
+    };
+
+    describe("abyss::offsets::Resolver") = [] {
+        it("should scan, write the cache and read it back") = [] {
+            const std::filesystem::path cache = std::filesystem::temp_directory_path() / "abyss_test_offsets.bin";
+            std::error_code ec;
+            std::filesystem::remove(cache, ec);
+
+            std::vector<std::uint8_t> bytes = MakeImage(0x5E000001);
+            abyss::offsets::ModuleImage image;
+            expect(image.Parse(bytes.data()));
+            expect(image.CodeSections().size() == 1_u);
+            const std::uintptr_t base = image.Base();
+
+            abyss::offsets::Resolver scanned;
+            const auto first = scanned.Resolve(image, Table, cache);
+            expect(first.scanned == 2_u);
+            expect(first.fallback == 2_u);
+            expect(first.cacheWritten);
+            expect(scanned.Get(0) == base + TextRva + 0x234);
+            expect(scanned.Get(1) == base + TextRva + 0x807 + 0x100);
+            expect(scanned.Get(2) == std::uintptr_t{0x403333});
+            expect(scanned.SourceOf(3) == abyss::offsets::OffsetSource::Fallback);
+
+            abyss::offsets::Resolver cached;
+            const auto second = cached.Resolve(image, Table, cache);
+            expect(second.cached == 2_u);
+            expect(second.scanned == 0_u);
+            expect(second.fallback == 2_u);
+            expect(!second.cacheWritten);
+            expect(cached.SourceOf(0) == abyss::offsets::OffsetSource::Cache);
+            for (std::size_t i = 0; i < std::size(Table); ++i) {
+                expect(cached.Get(i) == scanned.Get(i)) << "entry" << i;
+            }
+
+            // Another build of the executable: the cache is stale
+            bytes = MakeImage(0x5E000002);
+            expect(image.Parse(bytes.data()));
+            abyss::offsets::Resolver rebuilt;
+            const auto third = rebuilt.Resolve(image, Table, cache);
+            expect(third.cached == 0_u);
+            expect(third.scanned == 2_u);
+            expect(rebuilt.Get(0) == image.Base() + TextRva + 0x234);
+
+            // So is a cache written for another table
+            abyss::offsets::Resolver shorter;
+            expect(shorter.Resolve(image, std::span(Table).first(2), cache).cached == 0_u);
+
+            std::filesystem::remove(cache, ec);
+        };
+    };
+}
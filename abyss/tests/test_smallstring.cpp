@@ -0,0 +1,132 @@
+#include <boost/ut.hpp>
+#include <abyss/SmallString.h>
+#include <string>
+#include <unordered_set>
+
+namespace ut = boost::ut;
+
+int main() {
+    using namespace ut;
+    using namespace ut::spec;
+
+    cfg<override> = {.tag = {"abyss::SmallString"}};
+
+    describe("abyss::SmallString") = [] {
+        it("should keep short strings inline") = [] {
+            abyss::SmallString empty;
+            expect(empty.Empty());
+            expect(empty.IsInline());
+            expect(empty.c_str()[0] == L'\0');
+
+            abyss::SmallString s{L"Canvas"};
+            expect(s.IsInline());
+            expect(s.size() == 6_u);
+            expect(std::wstring_view(s) == L"Canvas");
+
+            abyss::SmallString edge{L"exactly15chars!"};
+            expect(edge.size() == abyss::SmallString::InlineCapacity);
+            expect(edge.IsInline());
+        };
+
+        it("should move long strings to the heap") = [] {
+            abyss::SmallString s{L"a string that does not fit inline"};
+            expect(!s.IsInline());
+            expect(std::wstring(s.c_str()) == L"a string that does not fit inline");
+
+            s = abyss::SmallString{L"short"};
+            expect(s.IsInline());
+            expect(std::wstring_view(s) == L"short");
+        };
+
+        it("should keep a heap buffer's capacity across a shrink") = [] {
+            const abyss::SmallString longest{L"a string that does not fit inline"};
+            const abyss::SmallString shorter{L"still too long to be inline"};
+            abyss::SmallString s = longest;
+            const wchar_t* heap = s.c_str();
+
+            s = shorter;
+            expect(s.c_str() == heap) << "shrunk in place";
+            expect(s == shorter);
+            s = longest;
+            expect(s.c_str() == heap) << "grown back without reallocating";
+            expect(s == longest);
+            expect(s.Hash() == longest.Hash());
+
+            // Short enough for the inline buffer: the heap buffer is freed
+            s = abyss::SmallString{L"tiny"};
+            expect(s.IsInline());
+            s = longest;
+            expect(!s.IsInline());
+            expect(s == longest);
+        };
+
+        it("should copy and move") = [] {
+            abyss::SmallString shortStr{L"id"};
+            abyss::SmallString longStr{L"a string that does not fit inline"};
+
+            abyss::SmallString copyShort = shortStr;
+            abyss::SmallString copyLong = longStr;
+            expect(copyShort == shortStr);
+            expect(copyLong == longStr);
+            expect(copyLong.c_str() != longStr.c_str());
+
+            const wchar_t* heap = copyLong.c_str();
+            abyss::SmallString moved = std::move(copyLong);
+            expect(moved.c_str() == heap);  // Heap buffer is stolen
+            expect(copyLong.Empty());
+
+            abyss::SmallString movedShort = std::move(copyShort);
+            expect(movedShort == shortStr);
+            expect(movedShort.IsInline());
+
+            moved = moved;
+            expect(moved == longStr);
+        };
+
+        it("should compare by length, hash and characters") = [] {
+            abyss::SmallString a{L"mesh_01"};
+            abyss::SmallString b{L"mesh_01"};
+            abyss::SmallString c{L"mesh_02"};
+            expect(a.Hash() == b.Hash());
+            expect(a.Hash() != c.Hash());
+            expect(a == b);
+            expect(a != c);
+            expect(a != abyss::SmallString{L"mesh_0"});
+
+            // The cached hash is dropped when the string changes
+            const auto before = a.Hash();
+            a = abyss::SmallString{L"mesh_02"};
+            expect(a.Hash() != before);
+            expect(a == c);
+
+            std::unordered_set<abyss::SmallString> set{a, b, c};
+            expect(set.size() == 2_u);
+        };
+
+        it("should interoperate with the engine string") = [] {
+            abyss::String engine{L"Transform"};
+            abyss::SmallString s{engine};
+            expect(s == engine);
+
+            const abyss::StringView view = s.View();
+            expect(view.text == s.c_str());
+            expect(view.length == 9_u);
+
+            abyss::String back = s.ToString();
+            expect(back == engine);
+        };
+
+        it("should convert from and to UTF-8") = [] {
+            abyss::SmallString s{std::string_view("Hello 世界")};
+            expect(s.size() == 8_u);
+            expect(s.IsInline());
+            expect(s.ToUTF8() == std::string("Hello 世界"));
+
+            abyss::SmallString big{std::string_view("Hello 世界, this one needs the heap")};
+            expect(!big.IsInline());
+            expect(big.ToUTF8() == std::string("Hello 世界, this one needs the heap"));
+        };
+    };
+
+    return 0;
+}
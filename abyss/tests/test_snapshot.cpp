@@ -0,0 +1,134 @@
+#include <boost/ut.hpp>
+#include <abyss/Snapshot.h>
+#include <yu/io.h>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <vector>
+
+namespace ut = boost::ut;
+
+namespace {
+    using abyss::SnapshotCodec;
+    using abyss::SnapshotRow;
+
+    // A scene whose size changes every frame: only the first row moves, the rest stay put
+    struct Frame {
+        std::vector<SnapshotRow> rows;
+        std::vector<std::uint64_t> meshes;
+    };
+
+    Frame MakeFrame(std::uint64_t n) {
+        Frame frame;
+        const std::uint32_t count = 3 + static_cast<std::uint32_t>(n % 3);
+        for (std::uint32_t i = 0; i < count; ++i) {
+            SnapshotRow row{};
+            row.address = 0x10000 + i * 0x40;
+            row.world[0] = 1.0f;
+            row.world[12] = i == 0 ? static_cast<float>(n) : static_cast<float>(i);
+            row.flags = SnapshotRow::HasWorld;
+            row.meshOffset = static_cast<std::uint32_t>(frame.meshes.size());
+            row.meshCount = i;
+            for (std::uint32_t m = 0; m < i; ++m) frame.meshes.push_back(0xA000 + i * 16 + m);
+            frame.rows.push_back(row);
+        }
+        return frame;
+    }
+
+    bool Matches(const abyss::SnapshotFrame& read, std::uint64_t n) {
+        const Frame expected = MakeFrame(n);
+        if (read.frame != n || read.rows.size() != expected.rows.size() || read.meshes.size() != expected.meshes.size()) {
+            return false;
+        }
+        for (std::size_t i = 0; i < expected.rows.size(); ++i) {
+            if (std::memcmp(&read.rows[i], &expected.rows[i], sizeof(SnapshotRow)) != 0) return false;
+            const auto meshes = read.MeshesOf(read.rows[i]);
+            for (std::uint32_t m = 0; m < meshes.size(); ++m) {
+                if (meshes[m] != expected.meshes[expected.rows[i].meshOffset + m]) return false;
+            }
+        }
+        return true;
+    }
+
+    bool Record(const std::filesystem::path& path, SnapshotCodec codec, std::uint32_t frames) {
+        abyss::SnapshotWriter writer;
+        if (!writer.Open(path, {.keyframeInterval = 4, .codec = codec, .backgroundFlush = false})) return false;
+        for (std::uint32_t n = 0; n < frames; ++n) {
+            const Frame frame = MakeFrame(n);
+            if (!writer.WriteFrame(n, frame.rows, frame.meshes)) return false;
+        }
+        return writer.FrameCount() == frames && writer.Close();
+    }
+
+    bool RoundTrips(const std::filesystem::path& path, SnapshotCodec codec) {
+        if (!Record(path, codec, 10)) return false;
+        abyss::SnapshotReader reader;
+        if (!reader.Open(path) || reader.FrameCount() != 10 || reader.KeyframeInterval() != 4) return false;
+        abyss::SnapshotFrame frame;
+        for (std::uint32_t n = 0; n < 10; ++n) {
+            if (!reader.ReadFrame(n, frame) || !Matches(frame, n)) return false;
+        }
+        return true;
+    }
+}
+
+int main() {
+    using namespace ut;
+    using namespace ut::spec;
+
+    cfg<override> = {.tag = {"abyss::Snapshot"}};
+
+    const std::filesystem::path directory = std::filesystem::temp_directory_path() / "abyss_test_snapshot";
+    std::filesystem::create_directories(directory);
+    yu::io::SetBasePath(directory);
+
+    describe("abyss::SnapshotWriter and SnapshotReader") = [&] {
+        it("should round trip raw and zero-run frames") = [] {
+            expect(RoundTrips("raw.absn", SnapshotCodec::None));
+            expect(RoundTrips("zerorun.absn", SnapshotCodec::ZeroRun));
+        };
+
+        it("should round trip LZ4 frames (zero-run frames without LZ4 support)") = [] {
+            expect(RoundTrips("lz4.absn", SnapshotCodec::Lz4));
+            abyss::SnapshotReader reader;
+            expect(reader.Open("lz4.absn"));
+#ifdef ABYSS_SNAPSHOT_LZ4
+            expect(reader.Header(0).codec == SnapshotCodec::Lz4);
+#else
+            expect(reader.Header(0).codec == SnapshotCodec::ZeroRun);
+#endif
+        };
+
+        it("should seek to any frame from its keyframe") = [] {
+            expect(Record("seek.absn", SnapshotCodec::ZeroRun, 10));
+            abyss::SnapshotReader reader;
+            expect(reader.Open("seek.absn"));
+            expect(reader.FrameCount() == 10_u);
+            expect((reader.Header(4).flags & abyss::snapshot_format::KeyframeFlag) != 0_u);
+            expect((reader.Header(7).flags & abyss::snapshot_format::KeyframeFlag) == 0_u);
+
+            // Forward past a keyframe, back to an earlier one, then within the same run
+            abyss::SnapshotFrame frame;
+            for (std::uint32_t n : {7u, 2u, 9u, 5u, 6u, 0u}) {
+                expect(reader.ReadFrame(n, frame) && Matches(frame, n)) << "frame" << n;
+            }
+            expect(!reader.ReadFrame(10, frame));
+        };
+
+        it("should index frames up to a truncated tail") = [&] {
+            expect(Record("truncated.absn", SnapshotCodec::ZeroRun, 10));
+            const std::filesystem::path file = directory / "truncated.absn";
+            std::filesystem::resize_file(file, std::filesystem::file_size(file) - 3);
+
+            abyss::SnapshotReader reader;
+            expect(reader.Open("truncated.absn"));
+            expect(reader.FrameCount() == 9_u);
+            abyss::SnapshotFrame frame;
+            expect(reader.ReadFrame(8, frame) && Matches(frame, 8));
+            expect(!reader.ReadFrame(9, frame));
+        };
+    };
+
+    std::error_code ec;
+    std::filesystem::remove_all(directory, ec);
+}
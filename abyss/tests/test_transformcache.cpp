@@ -0,0 +1,116 @@
+#include <abyss/TransformCache.h>
+#include <abyss/math/Batch.hpp>
+#include <boost/ut.hpp>
+#include <cmath>
+#include <vector>
+#include <yu/yu.h>
+
+namespace ut = boost::ut;
+using namespace boost::ut::literals;
+
+namespace {
+    // Left-handed perspective projection, as D3DXMatrixPerspectiveFovLH
+    abyss::math::Matrix perspective(float fovY, float aspect, float zn, float zf) {
+        abyss::math::Matrix p;
+        const float yScale = 1.0f / std::tan(fovY * 0.5f);
+        p[0] = yScale / aspect;
+        p[5] = yScale;
+        p[10] = zf / (zf - zn);
+        p[11] = 1.0f;
+        p[14] = -zn * zf / (zf - zn);
+        return p;
+    }
+
+    bool near(float a, float b, float eps = 1e-3f) {
+        return std::fabs(a - b) <= eps * (1.0f + std::fabs(a) + std::fabs(b));
+    }
+}
+
+int main() {
+    yu::Initialize();
+    using namespace ut;
+    using namespace abyss;
+    using namespace abyss::math;
+
+    const Matrix view = Matrix::Identity().LookAt(Vector(0.0f, 0.0f, -10.0f), Vector(), Vector(0.0f, 1.0f, 0.0f));
+    const Matrix viewProjection = view * perspective(1.5707963f, 1.0f, 1.0f, 100.0f);
+    const Viewport viewport{0.0f, 0.0f, 800.0f, 800.0f};
+
+    "ProjectPoints maps the view axis to the viewport center"_test = [&] {
+        // 9 points: two SIMD blocks and a scalar tail
+        std::vector<float> x{0.0f, 5.0f, 0.0f, 0.0f, 100.0f, -5.0f, 0.0f, 2.0f, 0.0f};
+        std::vector<float> y{0.0f, 0.0f, 5.0f, 0.0f, 0.0f, 0.0f, -5.0f, 2.0f, 0.0f};
+        std::vector<float> z{0.0f, 0.0f, 0.0f, -20.0f, 0.0f, 0.0f, 0.0f, 10.0f, 200.0f};
+        std::vector<float> sx(9), sy(9), depth(9);
+        std::vector<std::uint8_t> visible(9);
+
+        expect(ProjectPoints(viewProjection, viewport, {x, y, z}, {sx, sy, depth, visible}) == 9_u);
+
+        expect(visible[0] == 1_u);
+        expect(near(sx[0], 400.0f) && near(sy[0], 400.0f));
+        // 90 degree fov at distance 10: x = 5 lands halfway to the right edge, y = 5 halfway up
+        expect(near(sx[1], 600.0f) && near(sy[1], 400.0f));
+        expect(near(sx[2], 400.0f) && near(sy[2], 200.0f));
+        expect(near(sx[5], 200.0f) && near(sy[6], 600.0f));
+        expect(visible[3] == 0_u);  // behind the camera
+        expect(visible[4] == 0_u);  // outside the frustum
+        expect(visible[8] == 0_u);  // past the far plane
+        expect(visible[7] == 1_u);
+        expect(depth[7] > depth[0]);
+
+        // Every lane agrees with Matrix::Transform followed by the perspective divide
+        for (std::size_t i = 0; i < x.size(); ++i) {
+            if (!visible[i]) continue;
+            const Vector p(x[i], y[i], z[i]);
+            const float w = p[0] * viewProjection[3] + p[1] * viewProjection[7] + p[2] * viewProjection[11] + viewProjection[15];
+            const Vector clip = viewProjection.Transform(p);
+            expect(near(sx[i], 400.0f + clip[0] / w * 400.0f));
+            expect(near(sy[i], 400.0f - clip[1] / w * 400.0f));
+        }
+    };
+
+    "TransformCache gathers positions and projects them"_test = [&] {
+        Transform transforms[3];
+        Matrix worlds[3] = {
+            Matrix::Identity(),
+            Matrix::Identity().SetTranslation(5.0f, 0.0f, 0.0f),
+            Matrix::Identity().SetTranslation(0.0f, 0.0f, -50.0f),
+        };
+
+        Array<Transform*> live;
+        live.AddCached(&transforms[0]);
+        live.AddCached(nullptr);
+        live.AddCached(&transforms[1]);
+        live.AddCached(&transforms[2]);
+
+        auto worldOf = [&](const Transform& t) -> const Matrix* {
+            return &worlds[&t - transforms];
+        };
+
+        TransformCache cache;
+        cache.Gather(live, worldOf);
+        expect(cache.Size() == 3_u);
+        expect(cache.Sources()[1] == &transforms[1]);
+        expect(cache.X()[1] == 5.0_f);
+        expect(cache.Z()[2] == -50.0_f);
+
+        expect(cache.Project(viewProjection, viewport) == 2_u);
+        expect(cache.VisibleCount() == 2_u);
+        expect(near(cache.ScreenX()[0], 400.0f));
+        expect(near(cache.ScreenX()[1], 600.0f));
+        expect(cache.Visible()[2] == 0_u);
+
+        // Accessor can skip transforms; the buffers are reused
+        cache.Gather(live, [&](const Transform& t) -> const Matrix* {
+            return &t == &transforms[1] ? nullptr : &worlds[&t - transforms];
+        });
+        expect(cache.Size() == 2_u);
+        expect(cache.Sources()[1] == &transforms[2]);
+
+        cache.Clear();
+        expect(cache.Size() == 0_u);
+        live.Clear();
+    };
+
+    return 0;
+}
@@ -0,0 +1,168 @@
+#include <boost/ut.hpp>
+#include <abyss/TransformObserver.h>
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+namespace ut = boost::ut;
+
+namespace {
+    using abyss::Transform;
+    using abyss::math::Matrix;
+
+    bool contains(std::span<Transform* const> events, const Transform* t) {
+        return std::find(events.begin(), events.end(), t) != events.end();
+    }
+}
+
+int main() {
+    using namespace ut;
+    using namespace ut::spec;
+
+    cfg<override> = {.tag = {"abyss::TransformObserver"}};
+
+    describe("abyss::TransformObserver") = [] {
+        it("should report every transform as added on the first update") = [] {
+            Transform transforms[3];
+            abyss::Array<Transform*> live;
+            live.AddCached(&transforms[2]);
+            live.AddCached(nullptr);
+            live.AddCached(&transforms[0]);
+            live.AddCached(&transforms[1]);
+            live.AddCached(&transforms[0]);  // duplicate
+
+            abyss::TransformObserver observer;
+            observer.Update(live);
+            expect(observer.Added().size() == 3_u);
+            expect(observer.Removed().empty());
+            expect(observer.Moved().empty());
+            expect(observer.Size() == 3_u);
+            // Array order, first occurrence of a duplicate
+            expect(observer.Added()[0] == &transforms[2]);
+            expect(observer.Added()[1] == &transforms[0]);
+            expect(observer.Added()[2] == &transforms[1]);
+
+            observer.Update(live);
+            expect(!observer.Changed());
+            live.Clear();
+        };
+
+        it("should split membership changes into added and removed") = [] {
+            std::vector<Transform> transforms(40);
+            abyss::Array<Transform*> live;
+            for (std::size_t i = 0; i < 30; ++i) live.AddCached(&transforms[i]);
+
+            abyss::TransformObserver observer;
+            observer.Update(live);
+
+            // Drop every third transform, add the last ten, and shuffle the order
+            abyss::Array<Transform*> next;
+            for (std::size_t i = 40; i-- > 0;) {
+                if (i < 30 && i % 3 == 0) continue;
+                next.AddCached(&transforms[i]);
+            }
+            observer.Update(next);
+
+            expect(observer.Added().size() == 10_u);
+            expect(observer.Removed().size() == 10_u);
+            expect(observer.Moved().empty());
+            expect(observer.Size() == 30_u);
+            for (std::size_t i = 0; i < 40; ++i) {
+                const bool added = i >= 30;
+                const bool removed = i < 30 && i % 3 == 0;
+                expect(contains(observer.Added(), &transforms[i]) == added);
+                expect(contains(observer.Removed(), &transforms[i]) == removed);
+            }
+
+            // Removed in the previous frame's order
+            expect(observer.Removed()[0] == &transforms[0]);
+            expect(observer.Removed()[9] == &transforms[27]);
+
+            // Same transforms in a new order: no event
+            abyss::Array<Transform*> shuffled;
+            for (std::uint32_t i = 0; i < next.Size(); i += 2) shuffled.AddCached(next[i]);
+            for (std::uint32_t i = 1; i < next.Size(); i += 2) shuffled.AddCached(next[i]);
+            observer.Update(shuffled);
+            expect(!observer.Changed());
+            expect(observer.Size() == 30_u);
+            observer.Update(next);
+            expect(!observer.Changed());
+
+            // Appended, with a duplicate of a kept transform
+            next.AddCached(&transforms[0]);
+            next.AddCached(&transforms[35]);
+            observer.Update(next);
+            expect(observer.Added().size() == 1_u && observer.Added()[0] == &transforms[0]);
+            expect(observer.Removed().empty());
+            expect(observer.Size() == 31_u);
+            next.RemoveAt(next.Size() - 1);
+            next.RemoveAt(next.Size() - 1);
+            shuffled.Clear();
+
+            observer.Reset();
+            expect(observer.Size() == 0_u);
+            observer.Update(next);
+            expect(observer.Added().size() == 30_u);
+            live.Clear();
+            next.Clear();
+        };
+
+        it("should detect moved transforms from their matrix hash") = [] {
+            // 11 transforms: two blocks of four hashes and a tail
+            constexpr std::size_t count = 11;
+            std::vector<Transform> transforms(count);
+            std::vector<Matrix> worlds(count, Matrix::Identity());
+            abyss::Array<Transform*> live;
+            for (std::size_t i = 0; i < count; ++i) {
+                worlds[i] = Matrix::Identity().SetTranslation(static_cast<float>(i), 0.0f, 0.0f);
+                live.AddCached(&transforms[i]);
+            }
+            auto worldOf = [&](const Transform& t) -> const Matrix* {
+                const std::size_t i = static_cast<std::size_t>(&t - transforms.data());
+                return i == 3 ? nullptr : &worlds[i];
+            };
+
+            abyss::TransformObserver observer;
+            observer.Update(live, worldOf);
+            observer.Update(live, worldOf);
+            expect(!observer.Changed());
+
+            worlds[1][13] = 2.0f;   // position
+            worlds[5][0] = -1.0f;   // rotation only
+            worlds[10][14] = 7.0f;  // scalar tail
+            worlds[3][12] = 9.0f;   // no matrix: never moves
+            observer.Update(live, worldOf);
+            expect(observer.Moved().size() == 3_u);
+            expect(contains(observer.Moved(), &transforms[1]));
+            expect(contains(observer.Moved(), &transforms[5]));
+            expect(contains(observer.Moved(), &transforms[10]));
+            expect(observer.Added().empty() && observer.Removed().empty());
+
+            // Moved back to the same bits: moved again, then steady
+            worlds[1][13] = 0.0f;
+            observer.Update(live, worldOf);
+            expect(observer.Moved().size() == 1_u);
+            observer.Update(live, worldOf);
+            expect(!observer.Changed());
+            live.Clear();
+        };
+
+        it("should hash matrices bitwise") = [] {
+            Matrix a = Matrix::Identity();
+            Matrix b = Matrix::Identity();
+            expect(abyss::TransformObserver::HashMatrix(&a) == abyss::TransformObserver::HashMatrix(&b));
+            expect(abyss::TransformObserver::HashMatrix(nullptr) == 0_u);
+            for (std::size_t i = 0; i < 16; ++i) {
+                b = a;
+                b[i] += 0.5f;
+                expect(abyss::TransformObserver::HashMatrix(&a) != abyss::TransformObserver::HashMatrix(&b)) << "element" << i;
+            }
+            b = a;
+            b[12] = -0.0f;
+            a[12] = 0.0f;
+            expect(abyss::TransformObserver::HashMatrix(&a) != abyss::TransformObserver::HashMatrix(&b));
+        };
+    };
+
+    return 0;
+}
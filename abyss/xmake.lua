@@ -1,3 +1,13 @@
+option("abyss_lz4")
+    set_default(false)
+    set_showmenu(true)
+    set_description("LZ4 block compression for abyss snapshots")
+option_end()
+
+if has_config("abyss_lz4") then
+    add_requires("lz4", {configs = {arch = "x86"}})
+end
+
 target("abyss")
     set_kind("static")
     set_languages("cxx23")
@@ -5,6 +15,10 @@ target("abyss")
     add_includedirs("include", {public = true})
     add_defines("NOMINMAX")
     add_deps("yu")
+    if has_config("abyss_lz4") then
+        add_packages("lz4")
+        add_defines("ABYSS_SNAPSHOT_LZ4")
+    end
 
 for _, testfile in ipairs(os.files("tests/*.cpp")) do
     local testname = path.basename(testfile)
@@ -13,13 +27,25 @@ for _, testfile in ipairs(os.files("tests/*.cpp")) do
         set_kind("binary")
         set_default(false)
         add_files(testfile)
-        add_deps("abyss", "boost.ut")
+        add_deps("abyss", "boost.ut", "yu.testing")
         add_tests("default", {
             output = true,
             verbose = true
         })
 end
 
+-- Microbenchmarks (yu/bench.h harness): `xmake run bench_array --json out.json`
+for _, benchfile in ipairs(os.files("bench/*.cpp")) do
+    local benchname = path.basename(benchfile)
+    target(benchname)
+        set_languages("c++23")
+        set_kind("binary")
+        set_default(false)
+        add_files(benchfile)
+        add_deps("abyss", "yu.bench")
+        add_tests("smoke", {runargs = {"--min-time", "1"}})
+end
+
 -- Documentation generation task
 task("docs")
     set_category("action")
@@ -1,8 +1,14 @@
+#include <cstddef>
+
 namespace game {
     extern bool globals_initialized;
     extern bool yu_ready;
     extern bool quit;
 
-    extern void* whitelisted_allocs[65536];
-    bool is_whitelisted_alloc(void* ptr);
-}
\ No newline at end of file
+    // Provenance of allocations made through the CRT before yu_ready (see provenance.cpp)
+    bool whitelist_alloc(void* ptr) noexcept;
+    bool is_whitelisted_alloc(void* ptr) noexcept;
+    bool unwhitelist_alloc(void* ptr) noexcept;
+    std::size_t whitelisted_alloc_count() noexcept;
+    std::size_t whitelist_overflow_count() noexcept;
+}
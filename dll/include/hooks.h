@@ -1,4 +1,34 @@
+#pragma once
+#include <yu/hook.h>
+#include <cstddef>
+#include <span>
+#include <string_view>
+
+// Every detour of the dll goes through this registry: sites are registered as their targets
+// become known and attached together by Commit, one Detours transaction (one round of
+// thread suspension and code patching) per batch. Each site's detour checks Enabled()
+// and calls straight through when it is off, so hooks are toggled without re-patching.
 namespace hooks {
-    void InstallHooks();
-    void EarlyMemoryHookSetup();
-}
\ No newline at end of file
+    // Game hooks (init and the engine allocator); needs abyss::stdlib and gof2::globals bound
+    void RegisterGameHooks();
+
+    // Queue a site for the next Commit; registering a site twice is a no-op
+    void Register(yu::hook::Site& site);
+    void Register(std::span<yu::hook::Site* const> sites);
+
+    // Attach every registered site that is not attached yet, in one transaction.
+    // A site Detours refuses is logged and left out; returns the number attached
+    std::size_t Commit();
+
+    // Enable or disable a site by name ("game.init") or a whole group ("memory");
+    // returns the number of sites switched (pinned sites refuse to be disabled).
+    // The memory group has one switch, memory.malloc: realloc and free stay pinned so the
+    // records of blocks allocated while it was on follow them until they are freed
+    std::size_t SetEnabled(std::string_view nameOrGroup, bool enabled);
+
+    // Registered sites, in registration order
+    std::span<yu::hook::Site* const> Sites();
+
+    // Table of every site for the overlay: toggles, calls per frame, total calls and time
+    void RenderTable();
+}
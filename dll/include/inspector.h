@@ -0,0 +1,121 @@
+#pragma once
+#include <abyss/AEArray.h>
+#include <abyss/PaintCanvas.h>
+#include <imgui.h>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+#include <vector>
+
+// Scene inspector behind KaamoWidget: copies the canvas arrays into reusable buffers
+// every few frames, only when they changed, and draws them with ImGuiListClipper.
+namespace kaamo::inspector {
+    // Identity of a live abyss::Array; same header and same items = unchanged
+    struct ArrayHeader {
+        const void* items = nullptr;
+        std::uint32_t count = 0;
+        std::uint32_t capacity = 0;
+
+        bool operator==(const ArrayHeader&) const = default;
+    };
+
+    template <typename T>
+    ArrayHeader HeaderOf(const abyss::Array<T>& arr) {
+        return { arr.Size() > 0 ? arr.data() : nullptr, arr.Size(), arr.Capacity() };
+    }
+
+    // Copy of one live array; the buffer only grows, so steady-state refreshes never allocate
+    template <typename T>
+    class ArraySnapshot {
+        static_assert(std::is_trivially_copyable_v<T>, "snapshots are memcpy'd from game memory");
+
+    public:
+        // Returns true if the source changed since the previous refresh
+        bool Refresh(const abyss::Array<T>& source) {
+            const ArrayHeader header = HeaderOf(source);
+            const auto* items = static_cast<const T*>(header.items);
+            if (header == m_header &&
+                (header.count == 0 || std::memcmp(m_items.data(), items, sizeof(T) * header.count) == 0))
+                return false;
+
+            m_header = header;
+            m_items.assign(items, items + header.count);
+            ++m_generation;
+            return true;
+        }
+
+        void Clear() {
+            m_header = {};
+            m_items.clear();
+            ++m_generation;
+        }
+
+        const T* Data() const { return m_items.data(); }
+        std::uint32_t Size() const { return static_cast<std::uint32_t>(m_items.size()); }
+        const T& operator[](std::uint32_t index) const { return m_items[index]; }
+        const ArrayHeader& Header() const { return m_header; }
+        std::uint64_t Generation() const { return m_generation; }
+
+    private:
+        ArrayHeader m_header;
+        std::vector<T> m_items;
+        std::uint64_t m_generation = 0;
+    };
+
+    struct TransformRow {
+        abyss::Transform* transform = nullptr;
+        ArrayHeader meshes;
+        std::uint32_t meshOffset = 0; // first mesh in SceneSnapshot::Meshes()
+    };
+
+    // Flattened copy of PaintCanvas::transforms and every Transform::meshes
+    class SceneSnapshot {
+    public:
+        // Returns true if anything changed since the previous refresh
+        bool Refresh(const abyss::PaintCanvas* canvas);
+
+        const std::vector<TransformRow>& Rows() const { return m_rows; }
+        const std::uintptr_t* Meshes(const TransformRow& row) const { return m_meshes.data() + row.meshOffset; }
+        std::uint32_t TotalMeshes() const { return static_cast<std::uint32_t>(m_meshes.size()); }
+        const ArrayHeader& TransformsHeader() const { return m_transforms.Header(); }
+        std::uint64_t Generation() const { return m_generation; }
+
+    private:
+        bool MeshesChanged() const;
+        void Rebuild();
+
+        const abyss::PaintCanvas* m_canvas = nullptr;
+        ArraySnapshot<abyss::Transform*> m_transforms;
+        std::vector<TransformRow> m_rows;
+        std::vector<std::uintptr_t> m_meshes;
+        std::uint64_t m_generation = 0;
+    };
+
+    // Draw rows [0, count) through ImGuiListClipper; drawRow(index) must emit exactly one line
+    template <typename DrawRow>
+    void ClippedRows(std::uint32_t count, DrawRow&& drawRow) {
+        ImGuiListClipper clipper;
+        clipper.Begin(static_cast<int>(count));
+        while (clipper.Step()) {
+            for (int i = clipper.DisplayStart; i < clipper.DisplayEnd; ++i) {
+                drawRow(static_cast<std::uint32_t>(i));
+            }
+        }
+        clipper.End();
+    }
+
+    class SceneInspector {
+    public:
+        // Refresh the snapshot when due, then draw it into the current window
+        void Render(const abyss::PaintCanvas* canvas);
+
+        int refreshInterval = 30; // frames between snapshots
+
+    private:
+        SceneSnapshot m_snapshot;
+        int m_framesSinceRefresh = 0;
+        bool m_forceRefresh = true;
+        std::uint32_t m_selected = UINT32_MAX;
+        double m_lastRefreshMs = 0.0;
+    };
+}
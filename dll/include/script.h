@@ -0,0 +1,38 @@
+#pragma once
+#include <script_heap.h>
+#include <cstdint>
+#include <filesystem>
+
+// Lua mods: every scripts/*.lua next to the game runs in one Lua state on the render thread.
+// Engine objects (PaintCanvas, Transform, abyss::Array, abyss::String) are sol2 usertypes that
+// reference game memory in place; nothing is copied into Lua tables, so a reference is only valid
+// while the engine keeps the object (do not hold one across frames).
+//
+//     kaamo.on_frame(function(dt)
+//         local canvas = kaamo.canvas()
+//         if canvas then kaamo.log("transforms: " .. #canvas.transforms) end
+//     end)
+//
+// The on_frame callbacks share an instruction budget per frame; a callback that runs out is
+// stopped with a Lua error, and the next frame starts with the callback after it.
+namespace kaamo::script {
+    constexpr yu::mem::TagId ScriptTag = yu::mem::Tags::UserStart + 4; // "LuaScripts": the Lua heap's arena blocks
+    constexpr std::uint32_t DefaultFrameBudget = 200000; // VM instructions per frame, all callbacks together
+
+    struct Stats {
+        std::uint32_t scripts = 0;              // files loaded
+        std::uint32_t callbacks = 0;            // on_frame callbacks still running
+        std::uint32_t lastFrameInstructions = 0; // rounded to the budget check interval
+        std::uint64_t budgetStops = 0;          // callbacks stopped by the budget
+        std::uint64_t errors = 0;               // script and callback errors (the callback is dropped)
+        Heap::Stats heap;
+    };
+
+    // Scripts load on the first frame; call before the overlay hooks are attached
+    void Install(std::filesystem::path directory, std::uint32_t frameBudget = DefaultFrameBudget);
+
+    Stats GetStats(); // render thread
+
+    // Script and Lua heap stats for the overlay
+    void RenderPanel();
+}
@@ -0,0 +1,78 @@
+#pragma once
+#include <yu/memory_arena.h>
+#include <yu/memory_os.h>
+#include <cstddef>
+#include <cstdint>
+
+namespace kaamo::script {
+    // The Lua state's allocator (a lua_Alloc). Blocks up to MaxSmallBlock bytes are rounded to a
+    // power-of-two class, carved from a yu arena and recycled through one free list per class;
+    // larger blocks come from a private OS heap. Neither path reaches the hooked game heap, the CRT
+    // or the tracker's per-allocation records, and Lua's churn never shows up as game allocations.
+    //
+    // Not thread-safe: the Lua state runs on the render thread only.
+    class Heap {
+    public:
+        static constexpr std::size_t MinSmallBlock = 16;
+        static constexpr std::size_t MaxSmallBlock = 2048;
+        static constexpr std::size_t ClassCount = 8; // 16, 32, ..., 2048
+        static constexpr std::size_t DefaultLimit = 64 * 1024 * 1024;
+
+        struct Stats {
+            std::size_t used = 0;       // bytes Lua holds, as requested
+            std::size_t peak = 0;
+            std::size_t arenaBytes = 0; // pages held by the arena
+            std::size_t largeBytes = 0; // bytes in the private heap
+            std::uint64_t allocations = 0;
+            std::uint64_t failures = 0; // requests refused by the limit or the OS
+        };
+
+        explicit Heap(yu::mem::TagId tag, std::size_t limit = DefaultLimit) noexcept;
+        Heap(const Heap&) = delete;
+        Heap& operator=(const Heap&) = delete;
+
+        // lua_Alloc: ud is the Heap
+        static void* Alloc(void* ud, void* ptr, std::size_t osize, std::size_t nsize) noexcept;
+
+        void* Allocate(std::size_t size) noexcept;
+        void Free(void* ptr, std::size_t size) noexcept;
+        void* Reallocate(void* ptr, std::size_t oldSize, std::size_t newSize) noexcept;
+
+        const Stats& GetStats() const { return m_stats; }
+        void SetLimit(std::size_t limit) { m_limit = limit; }
+
+        // Size class of a small block (0 for 16 bytes), ClassCount for large blocks
+        static std::size_t ClassOf(std::size_t size);
+        static std::size_t ClassSize(std::size_t cls) { return MinSmallBlock << cls; }
+
+        // Large blocks a failed shrink can leave in place at once
+        static constexpr std::size_t MaxKeptBlocks = 16;
+
+    private:
+        void* AllocateBlock(std::size_t size) noexcept;
+        // Real size of a large block a failed shrink left in place, 0 for any other block
+        std::size_t KeptSize(void* ptr) const noexcept;
+        bool Keep(void* ptr, std::size_t size) noexcept;
+        void ReleaseKept(void* ptr) noexcept;
+
+        struct FreeBlock {
+            FreeBlock* next;
+        };
+
+        // Lua frees a block by the size it last asked for. A large block kept by a shrink no
+        // longer matches that size, which may even name a small class, so it is looked up here
+        // first: it must go back to the private heap, with the size it was allocated with
+        struct KeptBlock {
+            void* ptr;
+            std::size_t size;
+        };
+
+        yu::mem::Arena m_arena;
+        yu::mem::os::PrivateHeap m_large;
+        FreeBlock* m_free[ClassCount] = {};
+        KeptBlock m_kept[MaxKeptBlocks] = {};
+        std::size_t m_keptCount = 0;
+        std::size_t m_limit;
+        Stats m_stats;
+    };
+}
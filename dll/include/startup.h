@@ -0,0 +1,27 @@
+#include <functional>
+#include <memory>
+
+namespace kaamo::startup {
+    // A startup step running on its own thread. Completion is signalled on a
+    // manual-reset event, so dependent steps wait for exactly what they need
+    // instead of sleeping; a step that never finishes can be given up on.
+    class Stage {
+    public:
+        Stage(const char* name, std::function<bool()> work);
+        Stage(const Stage&) = delete;
+        Stage& operator=(const Stage&) = delete;
+
+        // Wait for the step; false if it failed or is still running after timeoutMs
+        bool Wait(unsigned long timeoutMs = 0xFFFFFFFF);
+
+        const char* Name() const { return m_name; }
+        bool Done() const;
+        // Run time of the step, 0 until it is done
+        double Milliseconds() const;
+
+    private:
+        struct State;
+        const char* m_name;
+        std::shared_ptr<State> m_state; // Shared with the thread, so an abandoned step stays valid
+    };
+}
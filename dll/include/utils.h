@@ -1,3 +1,14 @@
 namespace kaamo::utils {
     void OpenConsole();
+    // Pick exact/sampled allocation tracking from KAAMO_MEMORY_MODE and KAAMO_MEMORY_SAMPLE_BYTES,
+    // call-site capture from KAAMO_MEMORY_CALLSITES (off|caller|stack) and lifetime profiling from
+    // KAAMO_MEMORY_LIFETIMES=1; starts the snapshot thread, periodic if KAAMO_MEMORY_SNAPSHOT_MS is set
+    void ConfigureMemoryTracking();
+    // Keep DirectInput devices acquired and filter their input (KAAMO_INPUT_MODE=filter)
+    // instead of releasing them while the overlay has the mouse
+    void ConfigureInput();
+    // Pick text, async or binary (kaamo.log.bin) logging from KAAMO_LOG_MODE
+    void ConfigureLogging();
+    // Lua instructions per frame for all on_frame callbacks, from KAAMO_SCRIPT_BUDGET
+    unsigned int ScriptFrameBudget();
 }
\ No newline at end of file
@@ -0,0 +1,155 @@
+#include <hooks.h>
+#include <Windows.h>
+#include <detours.h>
+#include <imgui.h>
+#include <yu/yu.h>
+#include <atomic>
+#include <cstdint>
+
+namespace {
+    constexpr std::size_t kMaxSites = 32;
+
+    // Written by the startup thread only; the count is published after the slot
+    yu::hook::Site* g_sites[kMaxSites] = {};
+    std::atomic<std::size_t> g_count = 0;
+
+    // Calls at the previous RenderTable, for the per-frame column
+    std::uint64_t g_lastCalls[kMaxSites] = {};
+
+    bool Matches(const yu::hook::Site& site, std::string_view nameOrGroup) {
+        const std::string_view name = site.Name();
+        if (name == nameOrGroup) return true;
+        return name.size() > nameOrGroup.size() && name.starts_with(nameOrGroup) && name[nameOrGroup.size()] == '.';
+    }
+
+    // One transaction over every pending site except those already refused.
+    // Returns the index of the site Detours refused (the transaction is then aborted), or sites.size() once committed
+    std::size_t TryCommit(std::span<yu::hook::Site* const> sites, const bool* refused, LONG& error) {
+        DetourTransactionBegin();
+        DetourUpdateThread(GetCurrentThread());
+        for (std::size_t i = 0; i < sites.size(); ++i) {
+            if (sites[i]->Attached() || refused[i]) continue;
+            error = DetourAttach(sites[i]->Original(), sites[i]->Detour());
+            if (error != NO_ERROR) {
+                DetourTransactionAbort();
+                return i;
+            }
+        }
+        error = DetourTransactionCommit();
+        return sites.size();
+    }
+}
+
+void hooks::Register(yu::hook::Site& site) {
+    const std::size_t count = g_count.load(std::memory_order_relaxed);
+    for (std::size_t i = 0; i < count; ++i) {
+        if (g_sites[i] == &site) return;
+    }
+    if (count == kMaxSites) {
+        YU_LOG_ERROR("Hook registry full, {} not registered", site.Name());
+        return;
+    }
+    g_sites[count] = &site;
+    g_count.store(count + 1, std::memory_order_release);
+}
+
+void hooks::Register(std::span<yu::hook::Site* const> sites) {
+    for (yu::hook::Site* site : sites) Register(*site);
+}
+
+std::size_t hooks::Commit() {
+    const std::span<yu::hook::Site* const> sites = Sites();
+    bool refused[kMaxSites] = {};
+
+    // Detours fails the whole transaction on the first refused attach: drop that site and retry
+    LONG error = NO_ERROR;
+    for (std::size_t bad; (bad = TryCommit(sites, refused, error)) < sites.size();) {
+        YU_LOG_ERROR("Could not hook {} (target {}): error {}", sites[bad]->Name(), *sites[bad]->Original(), error);
+        refused[bad] = true;
+    }
+    if (error != NO_ERROR) {
+        YU_LOG_ERROR("Hook transaction failed: error {}", error);
+        return 0;
+    }
+
+    std::size_t attached = 0;
+    for (std::size_t i = 0; i < sites.size(); ++i) {
+        if (sites[i]->Attached() || refused[i]) continue;
+        sites[i]->SetAttached(true);
+        ++attached;
+    }
+    YU_LOG_INFO("Attached {} hooks in one transaction", attached);
+    return attached;
+}
+
+std::size_t hooks::SetEnabled(std::string_view nameOrGroup, bool enabled) {
+    std::size_t switched = 0;
+    for (yu::hook::Site* site : Sites()) {
+        if (Matches(*site, nameOrGroup) && site->SetEnabled(enabled)) ++switched;
+    }
+    return switched;
+}
+
+std::span<yu::hook::Site* const> hooks::Sites() {
+    return {g_sites, g_count.load(std::memory_order_acquire)};
+}
+
+void hooks::RenderTable() {
+    const std::span<yu::hook::Site* const> sites = Sites();
+    constexpr ImGuiTableFlags flags = ImGuiTableFlags_RowBg | ImGuiTableFlags_BordersInnerV | ImGuiTableFlags_SizingFixedFit;
+    if (!ImGui::BeginTable("hooks", 7, flags)) return;
+
+    ImGui::TableSetupColumn("Hook");
+    ImGui::TableSetupColumn("On");
+    ImGui::TableSetupColumn("Timed");
+    ImGui::TableSetupColumn("Calls/frame");
+    ImGui::TableSetupColumn("Calls");
+    ImGui::TableSetupColumn("Total ms");
+    ImGui::TableSetupColumn("ns/call");
+    ImGui::TableHeadersRow();
+
+    for (std::size_t i = 0; i < sites.size(); ++i) {
+        yu::hook::Site& site = *sites[i];
+        const yu::hook::Site::Stats stats = site.GetStats();
+        const std::uint64_t perFrame = stats.calls >= g_lastCalls[i] ? stats.calls - g_lastCalls[i] : stats.calls;
+        g_lastCalls[i] = stats.calls;
+
+        ImGui::PushID(static_cast<int>(i));
+        ImGui::TableNextRow();
+        ImGui::TableNextColumn();
+        if (site.Attached()) ImGui::TextUnformatted(site.Name());
+        else ImGui::TextDisabled("%s (not attached)", site.Name());
+
+        ImGui::TableNextColumn();
+        bool enabled = site.Enabled();
+        ImGui::BeginDisabled(site.Pinned());
+        if (ImGui::Checkbox("##on", &enabled)) site.SetEnabled(enabled);
+        ImGui::EndDisabled();
+        if (site.Pinned() && ImGui::IsItemHovered(ImGuiHoveredFlags_AllowWhenDisabled)) {
+            ImGui::SetTooltip("Pinned: the detour always runs");
+        }
+
+        ImGui::TableNextColumn();
+        bool timed = site.Timed();
+        if (ImGui::Checkbox("##timed", &timed)) site.SetTimed(timed);
+
+        ImGui::TableNextColumn();
+        ImGui::Text("%llu", static_cast<unsigned long long>(perFrame));
+        ImGui::TableNextColumn();
+        ImGui::Text("%llu", static_cast<unsigned long long>(stats.calls));
+        ImGui::TableNextColumn();
+        ImGui::Text("%.3f", static_cast<double>(stats.nanoseconds) / 1e6);
+        ImGui::TableNextColumn();
+        if (stats.timedCalls > 0) ImGui::Text("%.0f", static_cast<double>(stats.nanoseconds) / static_cast<double>(stats.timedCalls));
+        else ImGui::TextDisabled("-");
+        ImGui::PopID();
+    }
+    ImGui::EndTable();
+
+    if (ImGui::Button("Reset stats")) {
+        for (std::size_t i = 0; i < sites.size(); ++i) {
+            sites[i]->ResetStats();
+            g_lastCalls[i] = 0;
+        }
+    }
+}
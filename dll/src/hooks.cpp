@@ -1,6 +1,6 @@
 #include <hooks.h>
 #include <Windows.h>
-#include <detours.h>
+#include <intrin.h>
 #include <gof2/globals.hpp>
 #include <abyss/offsets/offsets.hpp>
 #include <yu/yu.h>
@@ -12,7 +12,26 @@
 // Get reference to lightweight tracker for direct access (faster, no wrapper overhead)
 static yu::mem::LightweightTracker& g_tracker = yu::mem::LightweightTracker::Instance();
 
+std::uintptr_t __stdcall InitHook(std::uintptr_t a1, std::uintptr_t a2, std::uintptr_t a3);
+void* malloc_hook(std::size_t size);
+void* realloc_hook(void* ptr, std::size_t newSize);
+void free_hook(void* ptr);
+
+// Detours rewrites the bound function pointers into trampolines: calling them is calling the original.
+// memory.malloc alone switches recording: realloc and free are pinned, so a block recorded while it
+// was on still has its record moved or erased, and the tracker never keeps a freed address
+static yu::hook::Site g_initSite("game.init", reinterpret_cast<void**>(&gof2::globals::init),
+                                 reinterpret_cast<void*>(&InitHook));
+static yu::hook::Site g_mallocSite("memory.malloc", reinterpret_cast<void**>(&abyss::stdlib::malloc),
+                                   reinterpret_cast<void*>(&malloc_hook));
+static yu::hook::Site g_reallocSite("memory.realloc", reinterpret_cast<void**>(&abyss::stdlib::realloc),
+                                    reinterpret_cast<void*>(&realloc_hook), true);
+static yu::hook::Site g_freeSite("memory.free", reinterpret_cast<void**>(&abyss::stdlib::free),
+                                 reinterpret_cast<void*>(&free_hook), true);
+
 std::uintptr_t __stdcall InitHook(std::uintptr_t a1, std::uintptr_t a2, std::uintptr_t a3) {
+    if (!g_initSite.Enabled()) return gof2::globals::init(a1, a2, a3);
+    yu::hook::Site::Scope scope(g_initSite);
     YU_LOG_INFO("InitHook called with args: {}, {}, {}", a1, a2, a3);
     auto ret = gof2::globals::init(a1, a2, a3);
     game::globals_initialized = true;
@@ -40,12 +59,13 @@ void* operator new(std::size_t size) {
     if (!game::yu_ready)
     {
         void* ptr = _malloc_base(size);
-        game::whitelisted_allocs[(reinterpret_cast<std::uintptr_t>(ptr) >> 4) % 65536] = ptr;
+        game::whitelist_alloc(ptr);
         return ptr;
     }
     void* ptr = abyss::stdlib::malloc(size);
     // Direct call to lightweight tracker - lock-free, zero allocations
-    g_tracker.RecordAllocation(ptr, static_cast<std::uint32_t>(size));
+    g_tracker.RecordAllocation(ptr, static_cast<std::uint32_t>(size), 0,
+                               yu::mem::LightweightTracker::AllocationType::Heap, _ReturnAddress());
     return ptr;
 }
 
@@ -53,17 +73,19 @@ void* operator new[](std::size_t size) {
     if (!game::yu_ready)
     {
         void* ptr = _malloc_base(size);
-        game::whitelisted_allocs[(reinterpret_cast<std::uintptr_t>(ptr) >> 4) % 65536] = ptr;
+        game::whitelist_alloc(ptr);
         return ptr;
     }
     void* ptr = abyss::stdlib::newarray(size);
-    g_tracker.RecordAllocation(ptr, static_cast<std::uint32_t>(size));
+    g_tracker.RecordAllocation(ptr, static_cast<std::uint32_t>(size), 0,
+                               yu::mem::LightweightTracker::AllocationType::Heap, _ReturnAddress());
     return ptr;
 }
 
 void operator delete(void* ptr) noexcept {
     if (!ptr) return;
-    if (!game::yu_ready || game::is_whitelisted_alloc(ptr))
+    // Pre-ready CRT blocks go back to the CRT; the lookup is a single load once they're gone
+    if (game::unwhitelist_alloc(ptr) || !game::yu_ready)
     {
         _free_base(ptr);
         return;
@@ -75,7 +97,8 @@ void operator delete(void* ptr) noexcept {
 
 void operator delete[](void* ptr) noexcept {
     if (!ptr) return;
-    if (!game::yu_ready || game::is_whitelisted_alloc(ptr))
+    // Pre-ready CRT blocks go back to the CRT; the lookup is a single load once they're gone
+    if (game::unwhitelist_alloc(ptr) || !game::yu_ready)
     {
         _free_base(ptr);
         return;
@@ -86,38 +109,43 @@ void operator delete[](void* ptr) noexcept {
 
 
 void* malloc_hook(std::size_t size) {
+    if (!g_mallocSite.Enabled()) return abyss::stdlib::malloc(size);
+    yu::hook::Site::Scope scope(g_mallocSite);
     void* addr = abyss::stdlib::malloc(size);
     // Direct call to lightweight tracker - lock-free, zero allocations
-    g_tracker.RecordAllocation(addr, static_cast<std::uint32_t>(size));
+    // The return address is the engine code that called malloc
+    g_tracker.RecordAllocation(addr, static_cast<std::uint32_t>(size), 0,
+                               yu::mem::LightweightTracker::AllocationType::Heap, _ReturnAddress());
     return addr;
 }
 
 void* realloc_hook(void* ptr, std::size_t newSize) {
-    g_tracker.RecordDeallocation(ptr);
+    if (!g_reallocSite.Enabled()) return abyss::stdlib::realloc(ptr, newSize);
+    yu::hook::Site::Scope scope(g_reallocSite);
     void* addr = abyss::stdlib::realloc(ptr, newSize);
-    g_tracker.RecordAllocation(addr, static_cast<std::uint32_t>(newSize));
+    if (!g_mallocSite.Enabled()) {
+        // Not recording: the block leaves the tracker rather than starting a record of its own
+        if (ptr && (addr || newSize == 0)) g_tracker.RecordDeallocation(ptr);
+        return addr;
+    }
+    // One event: an in-place resize only touches the record and the size delta, a moved block takes its record along
+    g_tracker.RecordReallocation(ptr, addr, static_cast<std::uint32_t>(newSize), 0,
+                                 yu::mem::LightweightTracker::AllocationType::Heap, _ReturnAddress());
     return addr;
 }
 
 void free_hook(void* ptr) {
+    if (!g_freeSite.Enabled()) return abyss::stdlib::free(ptr);
+    yu::hook::Site::Scope scope(g_freeSite);
     g_tracker.RecordDeallocation(ptr);
     abyss::stdlib::free(ptr);
 }
 
 
-void hooks::InstallHooks() {
-    DetourTransactionBegin();
-    DetourUpdateThread(GetCurrentThread());
-    DetourAttach(&(PVOID&)gof2::globals::init, (PVOID)InitHook);
-    DetourTransactionCommit();
-}
-
-void hooks::EarlyMemoryHookSetup() 
+void hooks::RegisterGameHooks()
 {
-    DetourTransactionBegin();
-    DetourUpdateThread(GetCurrentThread());
-    DetourAttach(&(PVOID&)abyss::stdlib::malloc, (PVOID)malloc_hook);
-    DetourAttach(&(PVOID&)abyss::stdlib::realloc, (PVOID)realloc_hook);
-    DetourAttach(&(PVOID&)abyss::stdlib::free, (PVOID)free_hook);
-    DetourTransactionCommit();
-}
\ No newline at end of file
+    // Called once per game start and logs: worth timing
+    g_initSite.SetTimed(true);
+    static yu::hook::Site* const sites[] = {&g_mallocSite, &g_reallocSite, &g_freeSite, &g_initSite};
+    Register(sites);
+}
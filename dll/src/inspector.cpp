@@ -0,0 +1,110 @@
+#include <inspector.h>
+#include <dx9hook/d9prof.hpp>
+#include <cstdio>
+
+namespace kaamo::inspector {
+    bool SceneSnapshot::Refresh(const abyss::PaintCanvas* canvas) {
+        if (!canvas) {
+            if (!m_canvas && m_rows.empty()) return false;
+            m_canvas = nullptr;
+            m_transforms.Clear();
+            m_rows.clear();
+            m_meshes.clear();
+            ++m_generation;
+            return true;
+        }
+
+        const bool canvasChanged = canvas != m_canvas;
+        m_canvas = canvas;
+        const bool transformsChanged = m_transforms.Refresh(canvas->transforms);
+        if (!canvasChanged && !transformsChanged && !MeshesChanged()) return false;
+
+        Rebuild();
+        ++m_generation;
+        return true;
+    }
+
+    bool SceneSnapshot::MeshesChanged() const {
+        for (const TransformRow& row : m_rows) {
+            if (!row.transform) continue;
+            const ArrayHeader header = HeaderOf(row.transform->meshes);
+            if (!(header == row.meshes)) return true;
+            if (header.count > 0 &&
+                std::memcmp(Meshes(row), header.items, sizeof(std::uintptr_t) * header.count) != 0)
+                return true;
+        }
+        return false;
+    }
+
+    void SceneSnapshot::Rebuild() {
+        // clear() keeps the capacity: only growth allocates
+        m_rows.clear();
+        m_meshes.clear();
+        for (std::uint32_t i = 0; i < m_transforms.Size(); ++i) {
+            TransformRow row;
+            row.transform = m_transforms[i];
+            row.meshOffset = static_cast<std::uint32_t>(m_meshes.size());
+            if (row.transform) {
+                row.meshes = HeaderOf(row.transform->meshes);
+                const auto* meshes = static_cast<const std::uintptr_t*>(row.meshes.items);
+                m_meshes.insert(m_meshes.end(), meshes, meshes + row.meshes.count);
+            }
+            m_rows.push_back(row);
+        }
+    }
+
+    void SceneInspector::Render(const abyss::PaintCanvas* canvas) {
+        if (m_forceRefresh || ++m_framesSinceRefresh >= refreshInterval) {
+            D9PROF_ZONE("inspector.refresh");
+            const std::int64_t begin = d9prof::Now();
+            m_snapshot.Refresh(canvas);
+            m_lastRefreshMs = d9prof::ToMs(d9prof::Now() - begin);
+            m_framesSinceRefresh = 0;
+            m_forceRefresh = false;
+        }
+
+        if (!canvas) {
+            ImGui::Text("Canvas not available");
+            return;
+        }
+
+        const auto& rows = m_snapshot.Rows();
+        const ArrayHeader& header = m_snapshot.TransformsHeader();
+        ImGui::Text("Transforms: %u (capacity %u), meshes: %u", header.count, header.capacity, m_snapshot.TotalMeshes());
+        ImGui::Text("Snapshot #%llu, refresh %.3f ms", static_cast<unsigned long long>(m_snapshot.Generation()), m_lastRefreshMs);
+        ImGui::SetNextItemWidth(120.0f);
+        ImGui::SliderInt("Refresh every (frames)", &refreshInterval, 1, 240);
+        ImGui::SameLine();
+        if (ImGui::Button("Refresh now")) m_forceRefresh = true;
+
+        if (m_selected >= rows.size()) m_selected = UINT32_MAX;
+
+        char label[64];
+        if (ImGui::BeginChild("transforms", ImVec2(0.0f, 240.0f), true)) {
+            ClippedRows(static_cast<std::uint32_t>(rows.size()), [&](std::uint32_t i) {
+                const TransformRow& row = rows[i];
+                std::snprintf(label, sizeof(label), "#%u  %p  meshes: %u", i, static_cast<void*>(row.transform), row.meshes.count);
+                ImGui::PushID(static_cast<int>(i));
+                if (ImGui::Selectable(label, m_selected == i)) m_selected = i;
+                ImGui::PopID();
+            });
+        }
+        ImGui::EndChild();
+
+        if (m_selected == UINT32_MAX) {
+            ImGui::TextDisabled("Select a transform to list its meshes");
+            return;
+        }
+
+        const TransformRow& row = rows[m_selected];
+        ImGui::Text("Transform #%u %p: %u meshes (capacity %u)", m_selected,
+                    static_cast<void*>(row.transform), row.meshes.count, row.meshes.capacity);
+        if (ImGui::BeginChild("meshes", ImVec2(0.0f, 160.0f), true)) {
+            const std::uintptr_t* meshes = m_snapshot.Meshes(row);
+            ClippedRows(row.meshes.count, [&](std::uint32_t i) {
+                ImGui::Text("[%u] %p", i, reinterpret_cast<void*>(meshes[i]));
+            });
+        }
+        ImGui::EndChild();
+    }
+}
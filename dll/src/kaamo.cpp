@@ -2,19 +2,25 @@
 #include <utils.h>
 #include <yu/yu.h>
 #include <yu/memory_lightweight.h>
+#include <yu/memory_snapshot.h>
 #include <abyss/offsets/offsets.hpp>
 #include <hooks.h>
 #include <game.h>
 #include <abyss/stdlib.h>
+#include <gof2/globals.hpp>
 #include <iostream>
 #include <Windows.h>
 #include <abyss/PaintCanvas.h>
 #include <dx9hook/d9hook.hpp>
 #include <dx9hook/d9draw.hpp>
 #include <dx9hook/dinput.hpp>
+#include <dx9hook/d9memory.hpp>
+#include <dx9hook/d9input.hpp>
 #include <abyss/AEArray.h>
 #include <abyss/Transform.h>
-#include <functional>
+#include <inspector.h>
+#include <startup.h>
+#include <script.h>
 
 
 class KaamoWidget : public d9widget
@@ -25,125 +31,78 @@ public:
         // Initialization code for the widget
     }
 
+    const char* GetName() override
+    {
+        return "Kaamo Overlay";
+    }
+
     void Render(float dt) override
     {
         ImGui::Begin("Kaamo Overlay");
         ImGui::Text("Kaamo DLL is active.");
 
-        // Render canvas transforms
-        abyss::PaintCanvas* canvas = *reinterpret_cast<abyss::PaintCanvas**>(abyss::offsets::globals::canvas);
-        if (canvas)
+        abyss::PaintCanvas* canvas = *reinterpret_cast<abyss::PaintCanvas**>(abyss::offsets::Get(abyss::offsets::Id::Canvas));
+        if (ImGui::CollapsingHeader("Canvas Transforms", ImGuiTreeNodeFlags_DefaultOpen))
         {
-            RenderAEArray("Canvas Transforms", canvas->transforms);
+            inspector.Render(canvas);
         }
-        else
+        if (ImGui::CollapsingHeader("Hooks"))
         {
-            ImGui::Text("Canvas not available");
+            hooks::RenderTable();
         }
-
-        ImGui::End();
-    }
-
-private:
-    template <typename T>
-    void RenderAEArray(const char* label, const abyss::Array<T>& arr, std::function<void(const T&, uint32_t)> customRenderer = nullptr)
-    {
-        if (ImGui::TreeNode(label))
+        if (ImGui::CollapsingHeader("Scripts"))
         {
-            ImGui::Text("Size: %u", arr.Size());
-            ImGui::Text("Capacity: %u", arr.Capacity());
-
-            if (arr.Size() > 0 && ImGui::TreeNode("Elements"))
-            {
-                for (uint32_t i = 0; i < arr.Size(); ++i)
-                {
-                    ImGui::PushID(i);
-                    if (ImGui::TreeNode("Element", "Element %u", i))
-                    {
-                        if (customRenderer)
-                        {
-                            customRenderer(arr[i], i);
-                        }
-                        else
-                        {
-                            // Default rendering
-                            RenderElement(arr[i]);
-                        }
-                        ImGui::TreePop();
-                    }
-                    ImGui::PopID();
-                }
-                ImGui::TreePop();
-            }
-            ImGui::TreePop();
+            kaamo::script::RenderPanel();
         }
-    }
 
-    template <typename T>
-    void RenderElement(const T& element)
-    {
-        if constexpr (std::is_pointer_v<T>)
-        {
-            ImGui::Text("Pointer: %p", (void*)element);
-            // Try to cast to known types
-            if constexpr (std::is_same_v<std::remove_pointer_t<T>, abyss::Transform>)
-            {
-                RenderTransform(static_cast<abyss::Transform*>(element));
-            }
-        }
-        else if constexpr (std::is_arithmetic_v<T>)
-        {
-            ImGui::Text("Value: %f", static_cast<double>(element));
-        }
-        else if constexpr (std::is_same_v<T, std::string>)
-        {
-            ImGui::Text("String: %s", element.c_str());
-        }
-        else if constexpr (std::is_same_v<T, std::uintptr_t>)
-        {
-            ImGui::Text("uintptr_t: %p", (void*)element);
-        }
-        else
-        {
-            // For non-pointer types, show basic info
-            ImGui::Text("Value at index (non-pointer)");
-            
-        }
+        ImGui::End();
     }
 
-    void RenderTransform(abyss::Transform* transform)
-    {
-        if (!transform)
-        {
-            ImGui::Text("Null transform");
-            return;
-        }
-        ImGui::Text("Transform pointer: %p", (void*)transform);
-        RenderAEArray("Meshes", transform->meshes);
-        // Add more fields if Transform has them, e.g.:
-        // ImGui::Text("Position: %.2f, %.2f, %.2f", transform->position.x, ...);
-        // If Transform has an array field, render it recursively
-        // RenderAEArray("Child Transforms", transform->children);
-    }
+private:
+    kaamo::inspector::SceneInspector inspector;
 };
 
 namespace kaamo
 {
     void EntryPoint()
     {
-        hooks::EarlyMemoryHookSetup();
+        // Independent steps start at once; each dependent step waits on the one it needs
+        abyss::offsets::ResolveReport offsets{};
+        startup::Stage offsetStage("offsets", [&offsets] {
+            offsets = abyss::offsets::Initialize(GetModuleHandleW(nullptr),
+                                                 yu::io::GetExecutablePath() / "kaamo_offsets.bin");
+            return true;
+        });
+        startup::Stage d3dStage("d3d9", [] { return d9::CaptureDevice(30000); });
+        startup::Stage inputStage("dinput", [] { return dinput::CaptureVTable(); });
+
         utils::OpenConsole();
+
+        // Hooks attach to the resolved functions
+        offsetStage.Wait();
+        abyss::stdlib::Bind();
+        gof2::globals::Bind();
+        // Allocator and init hooks in one transaction, as soon as their targets are known
+        hooks::RegisterGameHooks();
+        hooks::Commit();
+
         yu::Initialize();
         yu::Logger::Instance().SetColorOutput(false);
-        yu::SetLogFile("kaamo.log");
-        YU_LOG_INFO("Kaamo DLL initialized");
-        
+        startup::Stage logStage("log", [] { return yu::SetLogFile("kaamo.log"); });
+
         // Use lightweight tracker directly for tag registration
         auto& tracker = yu::mem::LightweightTracker::Instance();
         tracker.RegisterTag(101, "AEString");
         tracker.RegisterTag(102, "AEArray");
+        tracker.RegisterTag(103, "AESmallString");
+        tracker.RegisterTag(script::ScriptTag, "LuaScripts");
 
-        hooks::InstallHooks();
+        logStage.Wait();
+        utils::ConfigureLogging();
+        YU_LOG_INFO("Kaamo DLL initialized");
+        YU_LOG_INFO("Offsets: {} cached, {} scanned, {} fallback in {} us",
+                    offsets.cached, offsets.scanned, offsets.fallback, offsets.microseconds);
+        utils::ConfigureMemoryTracking();
         
         YU_LOG_INFO("Allocation tests");
         {
@@ -155,31 +114,83 @@ namespace kaamo
             abyss::stdlib::free(ptr2);
         }
 
-        std::this_thread::sleep_for(std::chrono::seconds(2));
+        // Every allocation hook is attached and the tracker configured: leave the CRT path
         tracker.PrintReport();
         game::yu_ready = true;
+        YU_LOG_INFO("Pre-ready CRT allocations still live: {} ({} untracked)",
+                    game::whitelisted_alloc_count(), game::whitelist_overflow_count());
 
-        d9::HookDirectX();
-        d9::HookWindow();
-        dinput::InitHook();
+        // The overlay hooks only need their vtables, captured meanwhile; both go in one transaction
+        const bool overlay = d3dStage.Wait();
+        const bool input = inputStage.Wait();
+        if (overlay)
+        {
+            hooks::Register(d9::PrepareHooks());
+        }
+        else
+        {
+            YU_LOG_WARN("No D3D9 device vtable, overlay disabled");
+        }
+        if (input)
+        {
+            utils::ConfigureInput();
+            hooks::Register(dinput::PrepareHooks());
+        }
+        else
+        {
+            YU_LOG_WARN("No dinput device vtable, input stays with the game");
+        }
+        if (overlay)
+        {
+            // Scripts run from hkEndScene: set up before it is attached
+            script::Install(yu::io::GetExecutablePath() / "scripts", utils::ScriptFrameBudget());
+        }
+        hooks::Commit();
+        // Hotkeys only need the game window, which may exist even when the device capture failed
+        bool windowHooked = d9::HookWindow();
         d9draw::RegisterWidget(new KaamoWidget());
+        d9draw::RegisterWidget(new d9memory());
+
+        YU_LOG_INFO("Startup stages: {} {:.1f} ms, {} {:.1f} ms, {} {:.1f} ms, {} {:.1f} ms",
+                    offsetStage.Name(), offsetStage.Milliseconds(), logStage.Name(), logStage.Milliseconds(),
+                    d3dStage.Name(), d3dStage.Milliseconds(), inputStage.Name(), inputStage.Milliseconds());
 
-        while (!game::quit)
+        // Hotkeys arrive from the window hook; this thread sleeps until F5
+        HANDLE quitEvent = CreateEventW(nullptr, TRUE, FALSE, nullptr);
+        d9input::RegisterHotkey(VK_DELETE, []
+        {
+            // Written by the snapshot thread; never stalls allocating threads
+            yu::mem::MemorySnapshotter::Instance().RequestSnapshot();
+
+            abyss::PaintCanvas* canvas = *reinterpret_cast<abyss::PaintCanvas**>(abyss::offsets::Get(abyss::offsets::Id::Canvas));
+            YU_LOG_INFO("Canvas {}", reinterpret_cast<void*>(canvas));
+            YU_LOG_INFO("Transforms count: {}", canvas ? canvas->transforms.Size() : 0);
+        });
+        d9input::RegisterHotkey(VK_F5, [quitEvent]
+        {
+            game::quit = true;
+            SetEvent(quitEvent);
+        });
+        d9input::Start();
+
+        if (!windowHooked)
+        {
+            YU_LOG_WARN("No game window yet, polling F5 until it can be hooked");
+        }
+        // Without the window hook nothing sets the event: poll F5, and hook the window once it exists
+        while (WaitForSingleObject(quitEvent, windowHooked ? INFINITE : 100) == WAIT_TIMEOUT)
         {
-            if (GetAsyncKeyState(VK_DELETE) & 0x8000)
-            {
-                //tracker.PrintReport();
-                
-                abyss::PaintCanvas* canvas = *reinterpret_cast<abyss::PaintCanvas**>(abyss::offsets::globals::canvas);
-                YU_LOG_INFO("Canvas {}", reinterpret_cast<void*>(canvas));
-                YU_LOG_INFO("Transforms count: {}", canvas ? canvas->transforms.Size() : 0);
-            }
             if (GetAsyncKeyState(VK_F5) & 0x8000)
             {
                 game::quit = true;
+                break;
             }
-            std::this_thread::sleep_for(std::chrono::milliseconds(100));
+            windowHooked = d9::HookWindow();
         }
+        d9input::Stop();
+        CloseHandle(quitEvent);
+        
+        yu::mem::MemorySnapshotter::Instance().Stop();
         
         // Write final memory report to file before shutdown
         YU_LOG_INFO("Game closing - writing final memory report...");
@@ -195,14 +206,4 @@ namespace kaamo
 
 bool game::globals_initialized = false;
 bool game::quit = false;
-bool game::yu_ready = false;
-void* game::whitelisted_allocs[65536] = {};
-
-bool game::is_whitelisted_alloc(void* ptr) {
-    for (void* addr : whitelisted_allocs) {
-        if (addr == ptr) {
-            return true;
-        }
-    }
-    return false;
-}
\ No newline at end of file
+bool game::yu_ready = false;
\ No newline at end of file
@@ -0,0 +1,97 @@
+// Provenance index for allocations served by the CRT before game::yu_ready.
+//
+// Until yu is ready, the hooked operator new falls back to _malloc_base, and
+// those blocks must later go back through _free_base instead of the engine
+// allocator. Every hooked delete asks "is this one of ours?", so the answer
+// has to be O(1) and must not allocate: this is a fixed-capacity,
+// open-addressed pointer set living in .bss, with lock-free insert/remove and
+// tombstones so removals never break probe chains.
+#include <game.h>
+#include <atomic>
+#include <cstdint>
+
+namespace {
+    constexpr std::size_t kCapacityBits = 17;
+    constexpr std::size_t kCapacity = std::size_t{1} << kCapacityBits; // 128K slots, 512 KB on x86
+    constexpr std::size_t kMask = kCapacity - 1;
+
+    // Inserts never probe further than this, so lookups can stop here too
+    constexpr std::size_t kMaxProbes = 128;
+
+    // Never a valid heap block address
+    void* const kTombstone = reinterpret_cast<void*>(std::uintptr_t{1});
+
+    std::atomic<void*> g_slots[kCapacity];
+    std::atomic<std::size_t> g_count{0};
+    std::atomic<std::size_t> g_overflows{0};
+
+    std::size_t home_slot(void* ptr) noexcept {
+        // CRT blocks are 8/16-byte aligned: drop the dead low bits, then
+        // Fibonacci-hash so neighbouring blocks spread across the table
+        std::uint64_t h = (static_cast<std::uint64_t>(reinterpret_cast<std::uintptr_t>(ptr)) >> 4)
+                          * 0x9E3779B97F4A7C15ull;
+        return static_cast<std::size_t>(h >> (64 - kCapacityBits));
+    }
+
+    std::atomic<void*>* find_slot(void* ptr) noexcept {
+        std::size_t idx = home_slot(ptr);
+        for (std::size_t probe = 0; probe < kMaxProbes; ++probe) {
+            auto& slot = g_slots[(idx + probe) & kMask];
+            void* current = slot.load(std::memory_order_acquire);
+            if (current == ptr) return &slot;
+            if (current == nullptr) return nullptr;
+        }
+        return nullptr;
+    }
+}
+
+bool game::whitelist_alloc(void* ptr) noexcept {
+    if (!ptr) return false;
+
+    std::size_t idx = home_slot(ptr);
+    for (std::size_t probe = 0; probe < kMaxProbes; ++probe) {
+        auto& slot = g_slots[(idx + probe) & kMask];
+        void* current = slot.load(std::memory_order_relaxed);
+        // A live block address is unique, so reusing a tombstone cannot
+        // shadow a second copy of the same pointer further down the chain
+        while (current == nullptr || current == kTombstone) {
+            if (slot.compare_exchange_weak(current, ptr,
+                    std::memory_order_acq_rel, std::memory_order_relaxed)) {
+                g_count.fetch_add(1, std::memory_order_relaxed);
+                return true;
+            }
+        }
+    }
+    // Untracked: the block will be treated as engine memory once yu_ready is set
+    g_overflows.fetch_add(1, std::memory_order_relaxed);
+    return false;
+}
+
+bool game::is_whitelisted_alloc(void* ptr) noexcept {
+    if (!ptr || g_count.load(std::memory_order_relaxed) == 0) return false;
+    return find_slot(ptr) != nullptr;
+}
+
+bool game::unwhitelist_alloc(void* ptr) noexcept {
+    // Once every pre-ready block is gone, frees cost a single load
+    if (!ptr || g_count.load(std::memory_order_relaxed) == 0) return false;
+
+    auto* slot = find_slot(ptr);
+    if (!slot) return false;
+
+    void* expected = ptr;
+    if (slot->compare_exchange_strong(expected, kTombstone,
+            std::memory_order_acq_rel, std::memory_order_relaxed)) {
+        g_count.fetch_sub(1, std::memory_order_relaxed);
+        return true;
+    }
+    return false;
+}
+
+std::size_t game::whitelisted_alloc_count() noexcept {
+    return g_count.load(std::memory_order_relaxed);
+}
+
+std::size_t game::whitelist_overflow_count() noexcept {
+    return g_overflows.load(std::memory_order_relaxed);
+}
@@ -0,0 +1,331 @@
+#include <script.h>
+#include <sol/sol.hpp>
+#include <abyss/AEArray.h>
+#include <abyss/AEString.h>
+#include <abyss/Interner.h>
+#include <abyss/PaintCanvas.h>
+#include <abyss/Transform.h>
+#include <abyss/offsets/offsets.hpp>
+#include <dx9hook/d9draw.hpp>
+#include <dx9hook/d9prof.hpp>
+#include <imgui.h>
+#include <yu/yu.h>
+#include <algorithm>
+#include <array>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <vector>
+
+// abyss::Array has begin/end/size: sol2 would otherwise push it as a container with its own metatable
+namespace sol {
+    template <typename T, typename Growth>
+    struct is_container<abyss::Array<T, Growth>> : std::false_type {};
+}
+
+namespace kaamo::script {
+    namespace {
+        constexpr int kBudgetInterval = 1000;            // instructions between budget checks
+        constexpr std::int64_t kLoadBudget = 50'000'000; // per file, for its top-level chunk
+
+        enum class Property : int { Unknown = -1, Size, Capacity, Address, Transforms, Meshes };
+        constexpr std::array<std::string_view, 5> kPropertyNames = {"size", "capacity", "address", "transforms", "meshes"};
+
+        // Property lookups on engine objects without hashing the name every time. Lua interns short
+        // strings, so once a name was resolved its string pointer identifies it; the string is
+        // anchored in the registry so the pointer is never reused for another string.
+        class NameCache {
+        public:
+            Property Find(lua_State* L, int index) {
+                if (lua_type(L, index) != LUA_TSTRING) return Property::Unknown;
+                std::size_t length = 0;
+                const char* key = lua_tolstring(L, index, &length);
+                const std::size_t start = (reinterpret_cast<std::uintptr_t>(key) >> 4) & (kSlots - 1);
+                for (std::size_t i = 0; i < kSlots; ++i) {
+                    const Slot& slot = m_slots[(start + i) & (kSlots - 1)];
+                    if (slot.key == key) return slot.property;
+                    if (!slot.key) break;
+                }
+
+                const std::string_view name(key, length);
+                const auto found = std::find(kPropertyNames.begin(), kPropertyNames.end(), name);
+                if (found == kPropertyNames.end()) return Property::Unknown; // Unknown names are not cached
+                const auto property = static_cast<Property>(found - kPropertyNames.begin());
+                Remember(L, index, key, start, property);
+                return property;
+            }
+
+        private:
+            static constexpr std::size_t kSlots = 64;
+
+            struct Slot {
+                const char* key = nullptr;
+                Property property = Property::Unknown;
+            };
+
+            void Remember(lua_State* L, int index, const char* key, std::size_t start, Property property) {
+                for (std::size_t i = 0; i < kSlots; ++i) {
+                    Slot& slot = m_slots[(start + i) & (kSlots - 1)];
+                    if (slot.key) continue;
+                    lua_pushvalue(L, index);
+                    luaL_ref(L, LUA_REGISTRYINDEX);
+                    slot = {key, property};
+                    return;
+                }
+                // Full (many copies of long names): those lookups stay uncached
+            }
+
+            Slot m_slots[kSlots];
+        };
+
+        struct Runtime {
+            Runtime(std::filesystem::path scripts, std::uint32_t budget)
+                : heap(ScriptTag), lua(sol::default_at_panic, &Heap::Alloc, &heap),
+                  directory(std::move(scripts)), frameBudget(budget) {}
+
+            Heap heap; // Before lua: the state is closed first
+            sol::state lua;
+            NameCache names;
+            std::filesystem::path directory;
+            std::uint32_t frameBudget;
+            std::int64_t budgetLeft = 0;
+            bool budgetHit = false;
+            bool loaded = false;
+            bool running = false;
+
+            std::vector<sol::protected_function> callbacks;
+            std::vector<sol::protected_function> pending; // Registered while callbacks run
+            std::vector<bool> dropped;
+            std::size_t next = 0; // First callback of the next frame
+            std::string scratch;  // UTF-8 conversions, reused
+            Stats stats;
+        };
+
+        Runtime* g_runtime = nullptr; // Never freed: the state may be used until the process exits
+
+        void BudgetHook(lua_State* L, lua_Debug*) {
+            g_runtime->budgetLeft -= kBudgetInterval;
+            if (g_runtime->budgetLeft > 0) return;
+            g_runtime->budgetHit = true;
+            luaL_error(L, "instruction budget exceeded");
+        }
+
+        // pcall, xpcall and coroutine.resume would hand the budget error back to the script as a
+        // value, so their wrappers raise it again: only the callback's own protected call stops it
+        int RaiseBudget(lua_State* L, int, lua_KContext) {
+            if (g_runtime->budgetHit) return luaL_error(L, "instruction budget exceeded");
+            return lua_gettop(L);
+        }
+
+        int BudgetGuard(lua_State* L) {
+            lua_pushvalue(L, lua_upvalueindex(1));
+            lua_insert(L, 1);
+            lua_callk(L, lua_gettop(L) - 1, LUA_MULTRET, 0, &RaiseBudget);
+            return RaiseBudget(L, LUA_OK, 0);
+        }
+
+        // Replaces table.name (a global when table is null) with a BudgetGuard around it
+        void GuardBudget(lua_State* L, const char* table, const char* name) {
+            if (table) lua_getglobal(L, table);
+            else lua_pushglobaltable(L);
+            lua_getfield(L, -1, name);
+            lua_pushcclosure(L, &BudgetGuard, 1);
+            lua_setfield(L, -2, name);
+            lua_pop(L, 1);
+        }
+
+        sol::object Nil(lua_State* L) {
+            return sol::make_object(L, sol::lua_nil);
+        }
+
+        template <typename T>
+        sol::object ArrayIndex(const abyss::Array<T>& self, sol::stack_object key, sol::this_state state) {
+            lua_State* L = state;
+            if (key.get_type() == sol::type::number) {
+                // 1-based like Lua sequences; the bounds are the live ones
+                const lua_Integer index = lua_tointeger(L, key.stack_index());
+                if (index < 1 || index > static_cast<lua_Integer>(self.Size())) return Nil(L);
+                T item = self[static_cast<std::uint32_t>(index - 1)];
+                return sol::make_object(L, item);
+            }
+            switch (g_runtime->names.Find(L, key.stack_index())) {
+                case Property::Size: return sol::make_object(L, self.Size());
+                case Property::Capacity: return sol::make_object(L, self.Capacity());
+                case Property::Address: return sol::make_object(L, reinterpret_cast<std::uintptr_t>(&self));
+                default: return Nil(L);
+            }
+        }
+
+        template <typename T>
+        void BindArray(sol::state& lua, const char* name) {
+            lua.new_usertype<abyss::Array<T>>(name, sol::no_constructor,
+                sol::meta_function::index, &ArrayIndex<T>,
+                sol::meta_function::length, [](const abyss::Array<T>& self) { return self.Size(); });
+        }
+
+        sol::object TransformIndex(abyss::Transform& self, sol::stack_object key, sol::this_state state) {
+            lua_State* L = state;
+            switch (g_runtime->names.Find(L, key.stack_index())) {
+                case Property::Meshes: return sol::make_object(L, &self.meshes);
+                case Property::Address: return sol::make_object(L, reinterpret_cast<std::uintptr_t>(&self));
+                default: return Nil(L);
+            }
+        }
+
+        sol::object CanvasIndex(abyss::PaintCanvas& self, sol::stack_object key, sol::this_state state) {
+            lua_State* L = state;
+            switch (g_runtime->names.Find(L, key.stack_index())) {
+                case Property::Transforms: return sol::make_object(L, &self.transforms);
+                case Property::Address: return sol::make_object(L, reinterpret_cast<std::uintptr_t>(&self));
+                default: return Nil(L);
+            }
+        }
+
+        // Lua copies the string it is handed; the conversion itself reuses one buffer
+        std::string_view StringUtf8(const abyss::String& self) {
+            g_runtime->scratch.clear();
+            self.AppendUTF8(g_runtime->scratch);
+            return g_runtime->scratch;
+        }
+
+        void Bind(Runtime& rt) {
+            sol::state& lua = rt.lua;
+            lua.open_libraries(sol::lib::base, sol::lib::string, sol::lib::table, sol::lib::math,
+                               sol::lib::utf8, sol::lib::coroutine);
+
+            BindArray<abyss::Transform*>(lua, "TransformArray");
+            BindArray<std::uintptr_t>(lua, "MeshArray");
+            lua.new_usertype<abyss::Transform>("Transform", sol::no_constructor,
+                sol::meta_function::index, &TransformIndex);
+            lua.new_usertype<abyss::PaintCanvas>("PaintCanvas", sol::no_constructor,
+                sol::meta_function::index, &CanvasIndex);
+            lua.new_usertype<abyss::String>("String", sol::no_constructor,
+                "utf8", &StringUtf8,
+                "intern", [](const abyss::String& self) { return abyss::Interner::Global().Intern(self); },
+                sol::meta_function::length, &abyss::String::size,
+                sol::meta_function::to_string, &StringUtf8,
+                sol::meta_function::equal_to, [](const abyss::String& a, const abyss::String& b) { return a == b; });
+
+            sol::table kaamo = lua.create_named_table("kaamo");
+            kaamo.set_function("on_frame", [](sol::protected_function callback) {
+                (g_runtime->running ? g_runtime->pending : g_runtime->callbacks).push_back(std::move(callback));
+            });
+            kaamo.set_function("log", [](std::string_view text) { YU_LOG_INFO("[lua] {}", text); });
+            kaamo.set_function("canvas", []() {
+                return *reinterpret_cast<abyss::PaintCanvas**>(abyss::offsets::Get(abyss::offsets::Id::Canvas));
+            });
+            // Unchecked: the address must hold an abyss::String for as long as the script uses it
+            kaamo.set_function("string_at", [](std::uintptr_t address) { return reinterpret_cast<abyss::String*>(address); });
+
+            lua_State* L = lua.lua_state();
+            GuardBudget(L, nullptr, "pcall");
+            GuardBudget(L, nullptr, "xpcall");
+            GuardBudget(L, "coroutine", "resume");
+            lua_sethook(L, &BudgetHook, LUA_MASKCOUNT, kBudgetInterval); // Coroutines inherit it
+        }
+
+        void Load(Runtime& rt) {
+            rt.loaded = true;
+            std::vector<std::filesystem::path> files;
+            std::error_code ec;
+            for (const auto& entry : std::filesystem::directory_iterator(rt.directory, ec)) {
+                if (entry.path().extension() == ".lua") files.push_back(entry.path());
+            }
+            std::sort(files.begin(), files.end()); // Load order by name
+
+            for (const auto& file : files) {
+                rt.budgetLeft = kLoadBudget;
+                rt.budgetHit = false;
+                sol::protected_function_result result = rt.lua.safe_script_file(file.string(), sol::script_pass_on_error);
+                if (!result.valid()) {
+                    const sol::error error = result;
+                    YU_LOG_ERROR("Script {}: {}", file.filename().string(), error.what());
+                    ++rt.stats.errors;
+                    continue;
+                }
+                ++rt.stats.scripts;
+            }
+            YU_LOG_INFO("Loaded {} scripts, {} frame callbacks", rt.stats.scripts, rt.callbacks.size());
+        }
+
+        void RunFrame(float dt) {
+            Runtime& rt = *g_runtime;
+            if (!rt.loaded) Load(rt);
+            if (rt.callbacks.empty()) return;
+
+            D9PROF_ZONE("scripts");
+            const std::size_t count = rt.callbacks.size();
+            rt.dropped.assign(count, false);
+            rt.budgetLeft = rt.frameBudget;
+            rt.running = true;
+
+            std::size_t ran = 0;
+            for (; ran < count && rt.budgetLeft > 0; ++ran) {
+                const std::size_t i = (rt.next + ran) % count;
+                rt.budgetHit = false;
+                sol::protected_function_result result = rt.callbacks[i](dt);
+                if (result.valid()) continue;
+
+                if (rt.budgetHit) {
+                    ++rt.stats.budgetStops;
+                    ++ran;
+                    break;
+                }
+                const sol::error error = result;
+                YU_LOG_ERROR("Script callback dropped: {}", error.what());
+                ++rt.stats.errors;
+                rt.dropped[i] = true;
+            }
+            rt.running = false;
+            rt.stats.lastFrameInstructions = rt.frameBudget - static_cast<std::uint32_t>(std::max<std::int64_t>(rt.budgetLeft, 0));
+
+            // Callbacks the budget left out run first next frame
+            std::size_t next = (rt.next + ran) % count;
+            std::size_t kept = 0;
+            for (std::size_t i = 0; i < count; ++i) {
+                if (rt.dropped[i]) {
+                    if (i < next) --next;
+                    continue;
+                }
+                if (kept != i) rt.callbacks[kept] = std::move(rt.callbacks[i]);
+                ++kept;
+            }
+            rt.callbacks.resize(kept);
+            rt.next = kept > 0 ? next % kept : 0;
+
+            for (auto& callback : rt.pending) rt.callbacks.push_back(std::move(callback));
+            rt.pending.clear();
+        }
+    }
+
+    void Install(std::filesystem::path directory, std::uint32_t frameBudget) {
+        if (g_runtime) return;
+        g_runtime = new Runtime(std::move(directory), frameBudget);
+        Bind(*g_runtime);
+        d9draw::RegisterFrameCallback([](float dt) { RunFrame(dt); });
+    }
+
+    Stats GetStats() {
+        if (!g_runtime) return {};
+        Stats stats = g_runtime->stats;
+        stats.callbacks = static_cast<std::uint32_t>(g_runtime->callbacks.size());
+        stats.heap = g_runtime->heap.GetStats();
+        return stats;
+    }
+
+    void RenderPanel() {
+        if (!g_runtime) {
+            ImGui::TextDisabled("Scripting not installed");
+            return;
+        }
+        const Stats stats = GetStats();
+        ImGui::Text("Scripts: %u, frame callbacks: %u", stats.scripts, stats.callbacks);
+        ImGui::Text("Instructions last frame: %u / %u", stats.lastFrameInstructions, g_runtime->frameBudget);
+        ImGui::Text("Budget stops: %llu, errors: %llu", static_cast<unsigned long long>(stats.budgetStops),
+                    static_cast<unsigned long long>(stats.errors));
+        ImGui::Text("Lua heap: %.1f KB used, %.1f KB peak", stats.heap.used / 1024.0, stats.heap.peak / 1024.0);
+        ImGui::Text("Arena %.1f KB, large blocks %.1f KB, %llu allocations, %llu refused", stats.heap.arenaBytes / 1024.0,
+                    stats.heap.largeBytes / 1024.0, static_cast<unsigned long long>(stats.heap.allocations),
+                    static_cast<unsigned long long>(stats.heap.failures));
+    }
+}
@@ -0,0 +1,132 @@
+#include <script_heap.h>
+#include <algorithm>
+#include <cstring>
+
+namespace kaamo::script {
+    Heap::Heap(yu::mem::TagId tag, std::size_t limit) noexcept
+        : m_arena(tag, 256 * 1024), m_limit(limit) {}
+
+    std::size_t Heap::ClassOf(std::size_t size) {
+        if (size > MaxSmallBlock) return ClassCount;
+        std::size_t cls = 0;
+        while (ClassSize(cls) < size) ++cls;
+        return cls;
+    }
+
+    void* Heap::Allocate(std::size_t size) noexcept {
+        if (m_stats.used + size > m_limit) {
+            ++m_stats.failures;
+            return nullptr;
+        }
+        return AllocateBlock(size);
+    }
+
+    void* Heap::AllocateBlock(std::size_t size) noexcept {
+        void* ptr = nullptr;
+        const std::size_t cls = ClassOf(size);
+        if (cls < ClassCount) {
+            if (FreeBlock* block = m_free[cls]) {
+                m_free[cls] = block->next;
+                ptr = block;
+            } else {
+                ptr = m_arena.Allocate(ClassSize(cls));
+                m_stats.arenaBytes = m_arena.Capacity();
+            }
+        } else {
+            ptr = m_large.Allocate(size);
+            if (ptr) m_stats.largeBytes += size;
+        }
+
+        if (!ptr) {
+            ++m_stats.failures;
+            return nullptr;
+        }
+        m_stats.used += size;
+        m_stats.peak = std::max(m_stats.peak, m_stats.used);
+        ++m_stats.allocations;
+        return ptr;
+    }
+
+    void Heap::Free(void* ptr, std::size_t size) noexcept {
+        if (!ptr) return;
+        m_stats.used -= size;
+        if (m_keptCount != 0 && KeptSize(ptr) != 0) {
+            ReleaseKept(ptr);
+            return;
+        }
+        const std::size_t cls = ClassOf(size);
+        if (cls < ClassCount) {
+            auto* block = static_cast<FreeBlock*>(ptr);
+            block->next = m_free[cls];
+            m_free[cls] = block;
+        } else {
+            m_large.Free(ptr, size);
+            m_stats.largeBytes -= size;
+        }
+    }
+
+    void* Heap::Reallocate(void* ptr, std::size_t oldSize, std::size_t newSize) noexcept {
+        const std::size_t keptSize = m_keptCount != 0 ? KeptSize(ptr) : 0;
+        const std::size_t oldClass = keptSize != 0 ? ClassCount : ClassOf(oldSize);
+
+        // Same small class: the block already fits
+        if (oldClass < ClassCount && oldClass == ClassOf(newSize)) {
+            m_stats.used = m_stats.used - oldSize + newSize;
+            m_stats.peak = std::max(m_stats.peak, m_stats.used);
+            return ptr;
+        }
+
+        // Lua relies on shrinking never failing: shrinks ignore the limit
+        const bool shrink = newSize <= oldSize;
+        if (!shrink && m_stats.used - oldSize + newSize > m_limit) {
+            ++m_stats.failures;
+            return nullptr;
+        }
+        void* moved = AllocateBlock(newSize);
+        if (!moved) {
+            if (!shrink) return nullptr;
+            // A small block is then recycled as the smaller class, which it more than fits. A
+            // large block stays owned by the private heap and is remembered with its real size
+            if (oldClass == ClassCount && keptSize == 0 && !Keep(ptr, oldSize)) return nullptr;
+            m_stats.used = m_stats.used - oldSize + newSize;
+            return ptr;
+        }
+        std::memcpy(moved, ptr, std::min(oldSize, newSize));
+        Free(ptr, oldSize);
+        return moved;
+    }
+
+    std::size_t Heap::KeptSize(void* ptr) const noexcept {
+        for (std::size_t i = 0; i < m_keptCount; ++i) {
+            if (m_kept[i].ptr == ptr) return m_kept[i].size;
+        }
+        return 0;
+    }
+
+    bool Heap::Keep(void* ptr, std::size_t size) noexcept {
+        if (m_keptCount == MaxKeptBlocks) return false;
+        m_kept[m_keptCount++] = {ptr, size};
+        return true;
+    }
+
+    void Heap::ReleaseKept(void* ptr) noexcept {
+        for (std::size_t i = 0; i < m_keptCount; ++i) {
+            if (m_kept[i].ptr != ptr) continue;
+            m_large.Free(ptr, m_kept[i].size);
+            m_stats.largeBytes -= m_kept[i].size;
+            m_kept[i] = m_kept[--m_keptCount];
+            return;
+        }
+    }
+
+    void* Heap::Alloc(void* ud, void* ptr, std::size_t osize, std::size_t nsize) noexcept {
+        auto* heap = static_cast<Heap*>(ud);
+        if (nsize == 0) {
+            heap->Free(ptr, osize);
+            return nullptr;
+        }
+        // A new block gets a type tag in osize, not a size
+        if (!ptr) return heap->Allocate(nsize);
+        return heap->Reallocate(ptr, osize, nsize);
+    }
+}
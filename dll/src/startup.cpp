@@ -0,0 +1,54 @@
+#include <startup.h>
+#include <Windows.h>
+#include <atomic>
+#include <chrono>
+#include <system_error>
+#include <thread>
+
+namespace kaamo::startup {
+    struct Stage::State {
+        std::function<bool()> work;
+        HANDLE done = nullptr;
+        std::atomic<bool> result{false};
+        std::atomic<double> milliseconds{0.0};
+
+        ~State() {
+            if (done) CloseHandle(done);
+        }
+
+        void Run() {
+            const auto start = std::chrono::steady_clock::now();
+            const bool ok = work ? work() : true;
+            milliseconds.store(std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count(),
+                               std::memory_order_relaxed);
+            result.store(ok, std::memory_order_relaxed);
+            SetEvent(done); // Release: the stores above are visible to waiters
+        }
+    };
+
+    Stage::Stage(const char* name, std::function<bool()> work)
+        : m_name(name), m_state(std::make_shared<State>()) {
+        m_state->work = std::move(work);
+        m_state->done = CreateEventW(nullptr, TRUE, FALSE, nullptr);
+
+        try {
+            std::thread([state = m_state] { state->Run(); }).detach();
+        } catch (const std::system_error&) {
+            // No thread: run the step inline
+            m_state->Run();
+        }
+    }
+
+    bool Stage::Wait(unsigned long timeoutMs) {
+        if (WaitForSingleObject(m_state->done, timeoutMs) != WAIT_OBJECT_0) return false;
+        return m_state->result.load(std::memory_order_relaxed);
+    }
+
+    bool Stage::Done() const {
+        return WaitForSingleObject(m_state->done, 0) == WAIT_OBJECT_0;
+    }
+
+    double Stage::Milliseconds() const {
+        return Done() ? m_state->milliseconds.load(std::memory_order_relaxed) : 0.0;
+    }
+}
@@ -1,6 +1,13 @@
 #include <utils.h>
 #include <Windows.h>
 #include <iostream>
+#include <cstdlib>
+#include <cstring>
+#include <yu/yu.h>
+#include <yu/memory_lightweight.h>
+#include <yu/memory_snapshot.h>
+#include <dx9hook/dinput.hpp>
+#include <script.h>
 
 namespace kaamo::utils {
     void OpenConsole() {
@@ -9,4 +16,102 @@ namespace kaamo::utils {
         freopen_s(&dummyfile, "CONOUT$", "w", stdout);
         freopen_s(&dummyfile, "CONIN$", "r", stdin);
     }
-}
+
+    void ConfigureMemoryTracking() {
+        using Tracker = yu::mem::LightweightTracker;
+        auto& tracker = Tracker::Instance();
+        char value[32];
+
+        DWORD len = GetEnvironmentVariableA("KAAMO_MEMORY_CALLSITES", value, sizeof(value));
+        if (len > 0 && len < sizeof(value)) {
+            if (_stricmp(value, "caller") == 0) {
+                tracker.SetCallSiteMode(Tracker::CallSiteMode::ReturnAddress);
+                YU_LOG_INFO("Memory call sites: caller");
+            } else if (_stricmp(value, "stack") == 0) {
+                tracker.SetCallSiteMode(Tracker::CallSiteMode::StackTrace);
+                YU_LOG_INFO("Memory call sites: stack");
+            } else if (_stricmp(value, "off") == 0) {
+                tracker.SetCallSiteMode(Tracker::CallSiteMode::Off);
+            } else {
+                YU_LOG_WARN("KAAMO_MEMORY_CALLSITES: unknown value '{}' (caller, stack or off)", value);
+            }
+        }
+
+        // Lifetime histograms at free time: frames alive per size class and call site
+        len = GetEnvironmentVariableA("KAAMO_MEMORY_LIFETIMES", value, sizeof(value));
+        if (len > 0 && len < sizeof(value) && std::strcmp(value, "0") != 0) {
+            tracker.SetLifetimeProfiling(true);
+            YU_LOG_INFO("Memory lifetime profiling on");
+        }
+
+        // Snapshots are taken on request (DELETE) and, if set, every N ms
+        std::uint32_t snapshotMs = 0;
+        len = GetEnvironmentVariableA("KAAMO_MEMORY_SNAPSHOT_MS", value, sizeof(value));
+        if (len > 0 && len < sizeof(value)) {
+            snapshotMs = static_cast<std::uint32_t>(std::strtoul(value, nullptr, 0));
+        }
+        if (yu::mem::MemorySnapshotter::Instance().Start("memory_snapshot", snapshotMs)) {
+            if (snapshotMs > 0) YU_LOG_INFO("Memory snapshots every {} ms", snapshotMs);
+        } else {
+            YU_LOG_WARN("Memory snapshot thread unavailable");
+        }
+
+        // Exact is the default: leak hunts set nothing, play sessions opt in
+        len = GetEnvironmentVariableA("KAAMO_MEMORY_MODE", value, sizeof(value));
+        if (len == 0 || len >= sizeof(value) || _stricmp(value, "sampled") != 0) {
+            tracker.SetTrackingMode(Tracker::TrackingMode::Exact);
+            YU_LOG_INFO("Memory tracking: exact");
+            return;
+        }
+
+        std::size_t sampleBytes = yu::mem::LightweightConfig::DefaultSampleBytes;
+        len = GetEnvironmentVariableA("KAAMO_MEMORY_SAMPLE_BYTES", value, sizeof(value));
+        if (len > 0 && len < sizeof(value)) {
+            unsigned long parsed = std::strtoul(value, nullptr, 0);
+            if (parsed > 0) sampleBytes = parsed;
+        }
+        tracker.SetTrackingMode(Tracker::TrackingMode::Sampled, sampleBytes);
+        YU_LOG_INFO("Memory tracking: sampled, 1 per {} bytes", tracker.GetSampleInterval());
+    }
+
+    void ConfigureInput() {
+        char value[16];
+        DWORD len = GetEnvironmentVariableA("KAAMO_INPUT_MODE", value, sizeof(value));
+        if (len == 0 || len >= sizeof(value) || _stricmp(value, "filter") != 0) return;
+
+        dinput::SetMode(dinput::Mode::Filter);
+        YU_LOG_INFO("DirectInput: filtered while the overlay has the mouse");
+    }
+
+    void ConfigureLogging() {
+        char value[16];
+        DWORD len = GetEnvironmentVariableA("KAAMO_LOG_MODE", value, sizeof(value));
+        if (len == 0) return;
+        const bool fits = len < sizeof(value);
+        if (fits && _stricmp(value, "text") == 0) return;
+        if (!fits || (_stricmp(value, "async") != 0 && _stricmp(value, "binary") != 0)) {
+            YU_LOG_WARN("Unknown KAAMO_LOG_MODE (use text, async or binary), staying synchronous");
+            return;
+        }
+
+        auto& logger = yu::Logger::Instance();
+        if (!logger.EnableAsync()) {
+            YU_LOG_WARN("Async logging unavailable, staying synchronous");
+            return;
+        }
+        // Binary: YU_LOG_* calls go to kaamo.log.bin, decode with yu-logdecode
+        if (_stricmp(value, "binary") == 0 && logger.SetBinaryLogFile("kaamo.log.bin")) {
+            yu::LogInfo("Binary logging to kaamo.log.bin");
+        }
+    }
+
+    unsigned int ScriptFrameBudget() {
+        char value[16];
+        const DWORD len = GetEnvironmentVariableA("KAAMO_SCRIPT_BUDGET", value, sizeof(value));
+        if (len > 0 && len < sizeof(value)) {
+            const unsigned long parsed = std::strtoul(value, nullptr, 0);
+            if (parsed > 0) return static_cast<unsigned int>(parsed);
+        }
+        return kaamo::script::DefaultFrameBudget;
+    }
+}
\ No newline at end of file
@@ -0,0 +1,118 @@
+#include <boost/ut.hpp>
+#include <script_heap.h>
+#include <cstdint>
+#include <cstring>
+
+namespace ut = boost::ut;
+using kaamo::script::Heap;
+
+int main() {
+    using namespace ut;
+    using namespace ut::spec;
+
+    cfg<override> = {.tag = {"kaamo::script::Heap"}};
+
+    describe("kaamo::script::Heap::ClassOf") = [] {
+        it("should round small sizes up to a power-of-two class") = [] {
+            expect(Heap::ClassOf(1) == 0_u);
+            expect(Heap::ClassOf(16) == 0_u);
+            expect(Heap::ClassOf(17) == 1_u);
+            expect(Heap::ClassOf(1024) == 6_u);
+            expect(Heap::ClassOf(1025) == 7_u);
+            expect(Heap::ClassOf(Heap::MaxSmallBlock) == Heap::ClassCount - 1);
+            expect(Heap::ClassOf(Heap::MaxSmallBlock + 1) == Heap::ClassCount);
+            expect(Heap::ClassSize(Heap::ClassCount - 1) == Heap::MaxSmallBlock);
+        };
+    };
+
+    describe("kaamo::script::Heap small blocks") = [] {
+        it("should recycle a freed block for the next request of its class") = [] {
+            Heap heap(yu::mem::Tags::Temporary);
+            void* first = heap.Allocate(20);
+            void* second = heap.Allocate(30);
+            expect(first != nullptr && second != nullptr);
+            heap.Free(first, 20);
+            heap.Free(second, 30);
+
+            // Last freed, first reused; another class does not see them
+            expect(heap.Allocate(64) != second);
+            expect(heap.Allocate(25) == second);
+            expect(heap.Allocate(32) == first);
+        };
+
+        it("should keep a block in place within its class") = [] {
+            Heap heap(yu::mem::Tags::Temporary);
+            void* ptr = heap.Allocate(40);
+            expect(heap.Reallocate(ptr, 40, 64) == ptr);
+            expect(heap.Reallocate(ptr, 64, 33) == ptr);
+            expect(heap.GetStats().used == 33_u);
+            expect(heap.GetStats().peak == 64_u);
+        };
+    };
+
+    describe("kaamo::script::Heap accounting") = [] {
+        it("should track used and large bytes across grows and shrinks") = [] {
+            Heap heap(yu::mem::Tags::Temporary);
+            auto* ptr = static_cast<std::uint8_t*>(heap.Allocate(100));
+            std::memset(ptr, 0x5A, 100);
+
+            // Small to large
+            auto* grown = static_cast<std::uint8_t*>(heap.Reallocate(ptr, 100, 8192));
+            expect(grown != nullptr);
+            expect(grown[0] == 0x5A && grown[99] == 0x5A);
+            expect(heap.GetStats().used == 8192_u);
+            expect(heap.GetStats().largeBytes == 8192_u);
+
+            // Large to large
+            auto* larger = static_cast<std::uint8_t*>(heap.Reallocate(grown, 8192, 16384));
+            expect(larger[99] == 0x5A);
+            expect(heap.GetStats().used == 16384_u);
+            expect(heap.GetStats().largeBytes == 16384_u);
+
+            // Large back to small: the private heap is emptied
+            auto* shrunk = static_cast<std::uint8_t*>(heap.Reallocate(larger, 16384, 50));
+            expect(shrunk[49] == 0x5A);
+            expect(heap.GetStats().used == 50_u);
+            expect(heap.GetStats().largeBytes == 0_u);
+            // Both copies were live while the block moved
+            expect(heap.GetStats().peak == 24576_u);
+
+            heap.Free(shrunk, 50);
+            expect(heap.GetStats().used == 0_u);
+            expect(heap.GetStats().failures == 0_u);
+        };
+
+        it("should refuse growth past the limit but never a shrink") = [] {
+            Heap heap(yu::mem::Tags::Temporary, 4096);
+            void* ptr = heap.Allocate(3000);
+            expect(ptr != nullptr);
+            expect(heap.Allocate(2000) == nullptr);
+            expect(heap.Reallocate(ptr, 3000, 5000) == nullptr);
+            expect(heap.GetStats().failures == 2_u);
+            expect(heap.GetStats().used == 3000_u);
+
+            heap.SetLimit(1024);
+            void* shrunk = heap.Reallocate(ptr, 3000, 2500);
+            expect(shrunk != nullptr);
+            expect(heap.GetStats().used == 2500_u);
+            heap.Free(shrunk, 2500);
+            expect(heap.GetStats().used == 0_u);
+            expect(heap.GetStats().largeBytes == 0_u);
+        };
+    };
+
+    describe("kaamo::script::Heap::Alloc") = [] {
+        it("should map lua_Alloc calls onto the heap") = [] {
+            Heap heap(yu::mem::Tags::Temporary);
+            // A new block carries a Lua type tag in osize
+            void* ptr = Heap::Alloc(&heap, nullptr, 4, 24);
+            expect(ptr != nullptr);
+            expect(heap.GetStats().used == 24_u);
+            ptr = Heap::Alloc(&heap, ptr, 24, 3000);
+            expect(heap.GetStats().used == 3000_u);
+            expect(Heap::Alloc(&heap, ptr, 3000, 0) == nullptr);
+            expect(heap.GetStats().used == 0_u);
+            expect(heap.GetStats().allocations == 2_u);
+        };
+    };
+}
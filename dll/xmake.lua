@@ -14,4 +14,18 @@ target("kaamoclubmodapi")
     after_build(function (target)
         os.cp(target:targetfile(), "build")
         os.cp(target:targetfile(), game_path .. "/kaamoclubmodapi.dll")
-    end)
\ No newline at end of file
+    end)
+
+-- Unit tests for the parts that only need yu (boost-ut), run with `xmake test`
+target("test_script_heap")
+    set_languages("c++23")
+    set_kind("binary")
+    set_default(false)
+    add_files("tests/test_script_heap.cpp", "src/script_heap.cpp")
+    add_includedirs("include")
+    add_deps("yu", "boost.ut", "yu.testing")
+    add_defines("NOMINMAX")
+    add_tests("default", {
+        output = true,
+        verbose = true
+    })
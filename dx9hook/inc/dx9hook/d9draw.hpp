@@ -4,6 +4,7 @@
 
 #include <Windows.h>
 #include <d3d9.h>
+#include <functional>
 #include <vector>
 
 class d9widget
@@ -11,6 +12,13 @@ class d9widget
 	public:
 	virtual void Init() = 0;
 	virtual void Render(float dt) = 0;
+	virtual const char* GetName() { return "widget"; } // zone name in d9prof, must outlive the widget
+
+	// Heavy data gathering, run by d9sched at GetUpdateHz(); publish results for Render (d9snapshot)
+	virtual void Update() {}
+	virtual float GetUpdateHz() { return 0.0f; } // 0: Update is never called
+	virtual double GetBudgetMs() { return 1.0; } // update time before d9sched backs off
+	virtual bool UpdateOnRenderThread() { return false; } // Update reads game state: run it in hkEndScene
 
 	bool& IsInit() {return bInit;}
 	
@@ -25,8 +33,11 @@ public:
 	static BOOL bInit;
 	static bool bSetPos;
 
+	using tFrameCallback = std::function<void(float dt)>;
+
 	static HRESULT APIENTRY hkEndScene(LPDIRECT3DDEVICE9 D3D9Device);
 	static void RegisterWidget(d9widget* widget);
+	static void RegisterFrameCallback(tFrameCallback callback); // runs in hkEndScene every frame, overlay shown or not
 
 private:
 	static ImVec2 vWindowPos;
@@ -35,6 +46,7 @@ private:
 	static void InitImGui(LPDIRECT3DDEVICE9 pDevice);
 
 	static std::vector<d9widget*> aWidgets;
+	static std::vector<tFrameCallback> aFrameCallbacks;
 };
 
 #endif /* D9DRAW_HPP */
\ No newline at end of file
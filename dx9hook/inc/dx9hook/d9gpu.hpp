@@ -0,0 +1,61 @@
+#ifndef D9GPU_HPP
+#define D9GPU_HPP
+#include <d3d9.h>
+#include <cstdint>
+
+/**
+    @brief : GPU timing of the overlay with D3D9 timestamp queries.
+
+    Each query set brackets one d9prof frame (hkEndScene to hkEndScene) inside a
+    TIMESTAMPDISJOINT pair, with timestamps at the start of the overlay draw, at
+    its end and at the next hkEndScene. Sets are read back without flushing a few
+    frames later, so nothing waits on the GPU, and the results are attached to
+    the frame they measured as d9prof counters:
+
+    - gpu.overlay : GPU time of the overlay draw (ms)
+    - gpu.game    : GPU time of everything else until the next EndScene (ms)
+    - gpu.frame   : sum of both (ms), to compare with the CPU frame time
+
+    Disabled by default; queries are created on first use and released on Reset
+    and unhook.
+**/
+class d9gpu
+{
+public:
+	static constexpr uint32_t QuerySets = 6; // frames in flight before a frame is skipped
+
+	static bool bEnabled; // issue timestamp queries
+
+	static void NewFrame(LPDIRECT3DDEVICE9 pDevice);
+	static void OverlayDone();
+	static void Release();
+
+	static bool IsSupported();
+	static uint64_t GetSkippedFrames();
+	static uint64_t GetDisjointFrames();
+
+private:
+	struct QuerySet
+	{
+		IDirect3DQuery9* pDisjoint;
+		IDirect3DQuery9* pFrequency;
+		IDirect3DQuery9* pOverlayBegin;
+		IDirect3DQuery9* pOverlayEnd;
+		IDirect3DQuery9* pFrameEnd;
+		uint64_t uFrame; // d9prof frame measured by this set
+		bool bOpen; // queries are being issued
+		bool bPending; // issued, waiting for the results
+	};
+
+	static QuerySet aSets[QuerySets];
+	static QuerySet* pOpenSet;
+	static bool bCreated;
+	static bool bUnsupported;
+	static uint64_t uSkippedFrames;
+	static uint64_t uDisjointFrames;
+
+	static bool CreateQueries(LPDIRECT3DDEVICE9 pDevice);
+	static void Collect();
+};
+
+#endif /* D9GPU_HPP */
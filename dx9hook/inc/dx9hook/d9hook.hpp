@@ -2,6 +2,8 @@
 #define D9HOOK_HPP
 #include <d3d9.h>
 #include <cstdint>
+#include <span>
+#include <yu/hook.h>
 extern LRESULT ImGui_ImplWin32_WndProcHandler(HWND hWnd, UINT msg, WPARAM wParam, LPARAM lParam);
 
 using tEndScene = HRESULT(APIENTRY*)(LPDIRECT3DDEVICE9 pDevice);
@@ -16,9 +18,11 @@ public:
 	static HWND window;
 	static HMODULE hDDLModule;
 
-	static void HookDirectX();
+	static bool CaptureDevice(DWORD timeoutMs = INFINITE); // dummy device vtable, safe off the hook thread
+	static std::span<yu::hook::Site* const> PrepareHooks(); // EndScene and Reset sites for a hook registry, empty without a vtable
+	static void HookDirectX(); // PrepareHooks and attach them in a transaction of their own
 	static void UnHookDirectX();
-	static void HookWindow();
+	static bool HookWindow(); // once; finds the game window if needed, false while there is none
 	static void UnHookWindow();
 
 	static bool WantsMouse(); // does imgui/d9 want the mouse ?
@@ -26,9 +30,13 @@ public:
 private:
 	static int windowHeight, windowWidth;
 	static void* d3d9Device[119];
+	static bool bCaptured;
 	static WNDPROC OWndProc;
 	static tReset oReset;
 	static bool isMouseWanted;
+	static yu::hook::Site siteEndScene; // disabled: the overlay is skipped, the game draws alone
+	static yu::hook::Site siteReset; // pinned: ImGui's device objects must be released around every Reset
+	static yu::hook::Site* const aSites[2];
 
 	static BOOL CALLBACK enumWind(HWND handle, LPARAM lp);
 	static HWND GetProcessWindow();
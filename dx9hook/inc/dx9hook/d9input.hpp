@@ -0,0 +1,62 @@
+#ifndef D9INPUT_HPP
+#define D9INPUT_HPP
+#include <Windows.h>
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include <yu/concurrent.h>
+
+/**
+    @brief : Hotkeys fed by the window message hook.
+
+    d9::WndProc hands every key press (auto-repeat excluded) to OnKeyMessage,
+    which runs on the game's window thread: it marks the key as pressed and
+    pushes it into a fixed single-producer / single-consumer ring. A worker
+    thread sleeps on an event until a press arrives and runs the actions
+    registered for that key, so nothing polls GetAsyncKeyState.
+
+    Render-thread code that must act inside EndScene (toggling the overlay,
+    unhooking) calls ConsumePress once per frame: one atomic exchange, no
+    syscall, and each press is seen exactly once.
+**/
+class d9input
+{
+public:
+	static constexpr uint32_t QueueSize = 256; // pending presses (power of two)
+
+	using tAction = std::function<void()>;
+
+	static void Start();
+	static void Stop();
+
+	static void RegisterHotkey(UINT vk, tAction action); // runs on the input worker
+	static bool ConsumePress(UINT vk); // pressed since the last call ?
+
+	static void OnKeyMessage(UINT msg, WPARAM wParam, LPARAM lParam); // called by d9::WndProc
+
+	static uint64_t GetDroppedPresses(); // lost to a full queue
+
+private:
+	struct Hotkey
+	{
+		UINT vk;
+		tAction action;
+	};
+
+	static yu::concurrent::SpscRing<UINT, QueueSize> qPresses; // window thread -> worker
+	static std::atomic<uint64_t> uDropped;
+	static std::atomic<uint8_t> aPressed[256];
+
+	static std::vector<Hotkey> aHotkeys;
+	static std::mutex mHotkeys;
+	static std::thread tWorker;
+	static HANDLE hWake;
+	static std::atomic<bool> bStopping;
+
+	static void WorkerLoop();
+};
+
+#endif /* D9INPUT_HPP */
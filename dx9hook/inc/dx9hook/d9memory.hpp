@@ -0,0 +1,54 @@
+#ifndef D9MEMORY_HPP
+#define D9MEMORY_HPP
+#include <dx9hook/d9draw.hpp>
+#include <yu/memory_lightweight.h>
+#include <cstdint>
+
+/**
+    @brief : Live memory telemetry widget for the yu LightweightTracker.
+
+    Sample() runs from hkEndScene every frame, shown or not, and only reads the
+    tracker's atomic counters: no record walk, no lock, no allocation. Each
+    sample goes into ring buffers of History frames: total bytes, bytes per
+    tag, allocations per second and the frame time. Allocation bursts (sector
+    jumps) can then be lined up with frame hitches.
+
+    The size-class histogram is the tracker's own power-of-two histogram of
+    live blocks. It is kept up to date by RecordAllocation/RecordDeallocation.
+
+    Sample() also advances the tracker's frame counter. With lifetime
+    profiling on, the Lifetimes table shows per size class how many frames
+    freed blocks lived, and the share freed in the frame that allocated them.
+
+    In sampled tracking mode every value is an estimate.
+**/
+class d9memory : public d9widget
+{
+public:
+	static constexpr uint32_t History = 512; // frames kept in the time series
+	static constexpr uint32_t MaxTags = static_cast<uint32_t>(yu::mem::LightweightConfig::MaxTags);
+	static constexpr uint32_t SizeClasses = static_cast<uint32_t>(yu::mem::LightweightConfig::SizeClasses);
+	static constexpr uint32_t LifetimeBuckets = static_cast<uint32_t>(yu::mem::LightweightConfig::LifetimeBuckets);
+
+	static bool bPaused; // stop appending samples (the view keeps the last History frames)
+
+	static void Sample();
+
+	void Init() override;
+	void Render(float dt) override;
+	const char* GetName() override { return "d9memory"; }
+
+private:
+	static float aTotalMb[History];
+	static float aAllocRate[History];
+	static float aFrameMs[History];
+	static float aTagMb[MaxTags][History];
+	static uint32_t uHead; // next slot to write
+	static uint32_t uCount; // valid samples
+	static uint64_t uLastAllocs;
+	static int64_t iLastSample;
+
+	int iHistogramMode = 0; // size-class histogram of live blocks (0) or live bytes (1)
+};
+
+#endif /* D9MEMORY_HPP */
@@ -0,0 +1,107 @@
+#ifndef D9PROF_HPP
+#define D9PROF_HPP
+#include <Windows.h>
+#include <atomic>
+#include <cstdint>
+
+/**
+    @brief : Frame instrumentation for the overlay.
+
+    A frame runs from one hkEndScene to the next. Scoped zones (D9PROF_ZONE) and
+    named counters are recorded into the current frame of a fixed ring of
+    FrameHistory frames. Recording is lock-free: a zone claims its slot with a
+    single fetch_add, and a frame that runs out of slots drops zones (see
+    GetDroppedZones) instead of blocking. Completed frames are read by the view
+    and the exporters on the render thread.
+
+    Timestamps come from QueryPerformanceCounter, which is backed by the
+    invariant TSC on current Windows but, unlike raw RDTSC, is consistent across
+    cores and converted with a known frequency.
+
+    Zone and counter names are stored by pointer: pass string literals or
+    strings that outlive the profiler.
+**/
+class d9prof
+{
+public:
+	static constexpr uint32_t MaxZones = 64; // zones per frame
+	static constexpr uint32_t MaxCounters = 16; // counters per frame
+	static constexpr uint32_t FrameHistory = 128; // frames kept (power of two)
+	static constexpr double BudgetMs = 0.5; // overlay budget per frame
+
+	struct Zone
+	{
+		std::atomic<const char*> name; // nullptr until the zone is published
+		int64_t begin;
+		int64_t end;
+		uint32_t threadId;
+		uint32_t depth;
+	};
+
+	struct Counter
+	{
+		std::atomic<const char*> name; // nullptr until the counter is published
+		double value;
+	};
+
+	struct Frame
+	{
+		std::atomic<uint64_t> index; // frame number held by this slot
+		int64_t begin;
+		int64_t end; // 0 while the frame is current
+		std::atomic<uint32_t> zoneCount;
+		std::atomic<uint32_t> counterCount;
+		Zone zones[MaxZones];
+		Counter counters[MaxCounters];
+	};
+
+	static std::atomic<bool> bEnabled; // record zones and counters
+	static bool bShowView; // draw the profiler window from hkEndScene
+
+	static void NewFrame();
+	static void RecordZone(const char* name, int64_t begin, int64_t end, uint32_t depth);
+	static void SetCounter(const char* name, double value);
+	static void SetCounter(const char* name, double value, uint64_t frame);
+
+	static uint64_t CurrentFrame();
+	static const Frame* GetFrame(uint64_t frame); // completed frames only
+	static uint64_t GetDroppedZones();
+
+	static int64_t Now();
+	static double ToMs(int64_t ticks);
+
+	static void RenderView();
+	static bool ExportCsv(const char* path);
+	static bool ExportChromeTrace(const char* path);
+
+private:
+	static Frame aFrames[FrameHistory];
+	static std::atomic<uint64_t> uFrame;
+	static std::atomic<uint64_t> uDroppedZones;
+	static int64_t iFrequency;
+	static uint32_t uRenderThread;
+};
+
+/**
+    @brief : RAII zone, records [construction, destruction) into the current frame.
+**/
+class d9zone
+{
+public:
+	explicit d9zone(const char* name);
+	~d9zone();
+
+	d9zone(const d9zone&) = delete;
+	d9zone& operator=(const d9zone&) = delete;
+
+private:
+	const char* szName;
+	int64_t iBegin;
+	uint32_t uDepth;
+};
+
+#define D9PROF_CONCAT_IMPL(a, b) a##b
+#define D9PROF_CONCAT(a, b) D9PROF_CONCAT_IMPL(a, b)
+#define D9PROF_ZONE(name) d9zone D9PROF_CONCAT(d9zone_, __LINE__)(name)
+
+#endif /* D9PROF_HPP */
@@ -0,0 +1,75 @@
+#ifndef D9SCHED_HPP
+#define D9SCHED_HPP
+#include <Windows.h>
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include <yu/concurrent.h>
+
+class d9widget;
+
+/**
+    @brief : Runs the Update() of the registered widgets at their own rate.
+
+    A widget that declares an update rate (d9widget::GetUpdateHz) has its
+    Update() run by the scheduler instead of doing the work in Render():
+    on a worker thread by default, or at the start of hkEndScene for widgets
+    that must read game state on the render thread (UpdateOnRenderThread).
+
+    Each update is timed against the widget's budget (GetBudgetMs). A widget
+    over budget is backed off, its interval doubling up to MaxBackoff times,
+    and recovers once it runs well within budget again. Render-thread updates
+    also share FrameBudgetMs per frame: due updates that do not fit are
+    deferred to the next frame, so the overlay cannot turn into a frame spike.
+
+    Updates run only while the overlay is displayed.
+**/
+class d9sched
+{
+public:
+	static constexpr uint32_t MaxBackoff = 8; // largest interval multiplier
+	static constexpr double FrameBudgetMs = 0.5; // render-thread updates per frame
+
+	static void Add(d9widget* widget); // called by d9draw::RegisterWidget
+	static void Stop();
+
+	static void RunRenderUpdates(); // called by hkEndScene
+
+	static uint64_t GetDeferred(); // updates postponed past their due time
+
+private:
+	struct Entry
+	{
+		d9widget* widget;
+		int64_t nextDue; // d9prof::Now() ticks
+		uint32_t backoff; // interval multiplier
+		double lastMs;
+	};
+
+	static std::vector<Entry> aWorker;
+	static std::vector<Entry> aRender;
+	static std::mutex mWorker; // held by the worker while it updates
+	static std::mutex mRender; // never contended with the worker
+	static std::thread tWorker;
+	static HANDLE hWake;
+	static std::atomic<bool> bStopping;
+	static std::atomic<uint64_t> uDeferred;
+
+	static void WorkerLoop();
+	static void Run(Entry& entry, int64_t now);
+	static int64_t Interval(const Entry& entry);
+};
+
+/**
+    @brief : Latest value published by one thread, read by others without a lock.
+
+    A seqlock (yu::concurrent::SeqLock): Publish() never waits, Read() never
+    returns a half-written value. For the results of d9widget::Update, read
+    in Render().
+**/
+template <typename T>
+using d9snapshot = yu::concurrent::SeqLock<T>;
+
+#endif /* D9SCHED_HPP */
@@ -2,6 +2,8 @@
 #define DINPUT_HPP
 #define DIRECTINPUT_VERSION 0x0800
 #include <dinput.h>
+#include <span>
+#include <yu/hook.h>
 /// @brief Direct Input Hook
 /// @authors modified by ElCapor from ,itsclonkandre (iv sdk net), modified from (InGameTimecycEditor) by akifle47.
 namespace dinput
@@ -12,7 +14,30 @@ namespace dinput
         HRESULT __stdcall DInput8DeviceGetDeviceDataHook(IDirectInputDevice8* device, DWORD cbData, LPDIDEVICEOBJECTDATA rgdod, LPDWORD pdwInOut, DWORD flags);
         HRESULT __stdcall DInput8DeviceAcquireHook(IDirectInputDevice8* device);
     }
-    void InitHook();
+    /// @brief How the overlay takes the mouse from the game
+    enum class Mode
+    {
+        Acquisition, // release the device while the overlay wants the mouse (switched on focus changes only)
+        Filter       // keep the device acquired and hide its input from the game while the overlay wants the mouse
+    };
+
+    /// @brief Totals since the hooks were installed
+    struct Stats
+    {
+        unsigned long long calls;    // hooked polls
+        unsigned long long switches; // Acquire/Unacquire calls made
+        unsigned long long avoided;  // Acquire/Unacquire calls skipped, the device was already in that state
+        unsigned long long filtered; // polls whose input was hidden from the game (Filter mode)
+    };
+
+    void SetMode(Mode mode);
+    Mode GetMode();
+    Stats GetStats();
+    void PublishCounters(); // per-frame dinput.calls/switches/avoided counters in d9prof
+
+    bool CaptureVTable(); // dummy device vtable, safe off the hook thread
+    std::span<yu::hook::Site* const> PrepareHooks(); // GetDeviceState, GetDeviceData and Acquire sites, empty without a vtable
+    void InitHook(); // PrepareHooks and attach them in a transaction of their own
     bool GetVTable(void** table);
 }
 
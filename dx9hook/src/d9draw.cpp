@@ -1,5 +1,12 @@
 #include <dx9hook/d9draw.hpp>
 #include <dx9hook/d9hook.hpp>
+#include <dx9hook/d9prof.hpp>
+#include <dx9hook/d9gpu.hpp>
+#include <dx9hook/d9memory.hpp>
+#include <dx9hook/d9input.hpp>
+#include <dx9hook/d9sched.hpp>
+#include <dx9hook/dinput.hpp>
+#include <yu/memory_frame.h>
 #include <imgui_impl_dx9.h>
 #include <imgui_impl_win32.h>
 
@@ -9,6 +16,7 @@ bool d9draw::bSetPos = false; // Status to update ImGui window size / position.
 ImVec2 d9draw::vWindowPos = { 0, 0 }; // Last ImGui window position.
 ImVec2 d9draw::vWindowSize = { 0, 0 }; // Last ImGui window size.
 std::vector<d9widget*> d9draw::aWidgets = {};
+std::vector<d9draw::tFrameCallback> d9draw::aFrameCallbacks = {};
 /**
     @brief : Hook of the EndScene function.
     @param  D3D9Device : Current Direct3D9 Device Object.
@@ -16,46 +24,95 @@ std::vector<d9widget*> d9draw::aWidgets = {};
 **/
 HRESULT d9draw::hkEndScene(const LPDIRECT3DDEVICE9 D3D9Device)
 {
-	if (!d9::pDevice)
-		d9::pDevice = D3D9Device;
-
-	if (!bInit)
-		InitImGui(D3D9Device);
+	if (!d9::siteEndScene.Enabled())
+		return d9::oEndScene(D3D9Device);
+	yu::hook::Site::Scope scope(d9::siteEndScene);
 
-	if (GetAsyncKeyState(VK_DELETE) & 1)
+	d9prof::NewFrame();
 	{
-		bDisplay = !bDisplay;
-		d9::isMouseWanted = !d9::isMouseWanted;
-	}
-		
+		D9PROF_ZONE("EndScene");
 
-	if (GetAsyncKeyState(VK_F8) & 1)
-	{
-		d9::UnHookDirectX();
-		CreateThread(nullptr, 0, (LPTHREAD_START_ROUTINE)FreeLibrary, d9::hDDLModule, 0, nullptr);
-		return d9::oEndScene(D3D9Device);
-	}
+		if (!d9::pDevice)
+			d9::pDevice = D3D9Device;
 
-	ImGui_ImplDX9_NewFrame();
-	ImGui_ImplWin32_NewFrame();
-	ImGui::NewFrame();
+		if (!bInit)
+		{
+			D9PROF_ZONE("InitImGui");
+			InitImGui(D3D9Device);
+		}
+
+		d9gpu::NewFrame(D3D9Device);
 
-	if (bDisplay)
-	{
-		for (auto& widget : d9draw::aWidgets)
 		{
-			if (!widget->IsInit())
+			D9PROF_ZONE("Input");
+			if (d9input::ConsumePress(VK_DELETE))
 			{
-				widget->Init();
-				widget->IsInit() = true;
+				bDisplay = !bDisplay;
+				d9::isMouseWanted = !d9::isMouseWanted;
+			}
+
+			if (d9input::ConsumePress(VK_F8))
+			{
+				d9::UnHookDirectX();
+				CreateThread(nullptr, 0, (LPTHREAD_START_ROUTINE)FreeLibrary, d9::hDDLModule, 0, nullptr);
+				return d9::oEndScene(D3D9Device);
 			}
-			widget->Render(ImGui::GetIO().DeltaTime);
 		}
-	}
 
-	ImGui::EndFrame();
-	ImGui::Render();
-	ImGui_ImplDX9_RenderDrawData(ImGui::GetDrawData());
+		{
+			D9PROF_ZONE("NewFrame");
+			ImGui_ImplDX9_NewFrame();
+			ImGui_ImplWin32_NewFrame();
+			ImGui::NewFrame();
+		}
+
+		d9sched::RunRenderUpdates();
+
+		if (!aFrameCallbacks.empty())
+		{
+			D9PROF_ZONE("FrameCallbacks");
+			for (auto& callback : aFrameCallbacks)
+				callback(ImGui::GetIO().DeltaTime);
+		}
+
+		if (bDisplay)
+		{
+			for (auto& widget : d9draw::aWidgets)
+			{
+				D9PROF_ZONE(widget->GetName());
+				if (!widget->IsInit())
+				{
+					widget->Init();
+					widget->IsInit() = true;
+				}
+				widget->Render(ImGui::GetIO().DeltaTime);
+			}
+
+			if (d9prof::bShowView)
+			{
+				D9PROF_ZONE("d9prof");
+				d9prof::RenderView();
+			}
+		}
+
+		{
+			D9PROF_ZONE("RenderDrawData");
+			ImGui::EndFrame();
+			ImGui::Render();
+			ImGui_ImplDX9_RenderDrawData(ImGui::GetDrawData());
+			d9gpu::OverlayDone();
+		}
+
+		// Frame scratch allocated during this frame stays valid through the next one
+		yu::mem::FrameArena::EndFrame();
+		const yu::mem::FrameArena& scratch = yu::mem::FrameArena::ThisThread();
+		d9prof::SetCounter("frame.scratch", static_cast<double>(scratch.LastFrameBytes()));
+		d9prof::SetCounter("frame.scratch.peak", static_cast<double>(scratch.HighWater()));
+
+		// Memory telemetry keeps sampling while the overlay is hidden
+		d9memory::Sample();
+		dinput::PublishCounters();
+	}
 
 	return d9::oEndScene(D3D9Device);
 }
@@ -63,6 +120,16 @@ HRESULT d9draw::hkEndScene(const LPDIRECT3DDEVICE9 D3D9Device)
 void d9draw::RegisterWidget(d9widget *widget)
 {
 	d9draw::aWidgets.push_back(widget);
+	d9sched::Add(widget);
+}
+
+/**
+    @brief : Function that add a callback run on the render thread every frame, inside the ImGui frame.
+    @param  callback : Called with the frame time in seconds.
+**/
+void d9draw::RegisterFrameCallback(tFrameCallback callback)
+{
+	d9draw::aFrameCallbacks.push_back(std::move(callback));
 }
 /**
     @brief : function that init ImGui for rendering.
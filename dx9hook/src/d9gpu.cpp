@@ -0,0 +1,178 @@
+#include <dx9hook/d9gpu.hpp>
+#include <dx9hook/d9prof.hpp>
+
+bool d9gpu::bEnabled = false; // GPU timing is opt-in.
+d9gpu::QuerySet d9gpu::aSets[QuerySets] = {}; // Query sets in flight.
+d9gpu::QuerySet* d9gpu::pOpenSet = nullptr; // Set of the current frame.
+bool d9gpu::bCreated = false; // Queries exist on the current device.
+bool d9gpu::bUnsupported = false; // The device has no timestamp queries.
+uint64_t d9gpu::uSkippedFrames = 0; // Frames without a free query set.
+uint64_t d9gpu::uDisjointFrames = 0; // Frames discarded because the timestamps were disjoint.
+
+/**
+    @brief : Close the query set of the previous frame, collect finished sets and open one for the new frame.
+             Called on each hkEndScene, before the overlay is drawn.
+    @param  pDevice : Current Direct3D9 Device Object.
+**/
+void d9gpu::NewFrame(const LPDIRECT3DDEVICE9 pDevice)
+{
+	if (pOpenSet)
+	{
+		pOpenSet->pFrameEnd->Issue(D3DISSUE_END);
+		pOpenSet->pDisjoint->Issue(D3DISSUE_END);
+		pOpenSet->bOpen = false;
+		pOpenSet->bPending = true;
+		pOpenSet = nullptr;
+	}
+
+	if (!bCreated)
+	{
+		if (!bEnabled || bUnsupported)
+			return;
+		if (!CreateQueries(pDevice))
+		{
+			bUnsupported = true;
+			Release();
+			return;
+		}
+	}
+
+	Collect();
+
+	if (!bEnabled)
+	{
+		// Keep the queries until the sets in flight are read back
+		for (const QuerySet& set : aSets)
+			if (set.bPending)
+				return;
+		Release();
+		return;
+	}
+
+	for (QuerySet& set : aSets)
+	{
+		if (!set.bPending)
+		{
+			pOpenSet = &set;
+			break;
+		}
+	}
+	if (!pOpenSet)
+	{
+		++uSkippedFrames;
+		return;
+	}
+
+	pOpenSet->uFrame = d9prof::CurrentFrame();
+	pOpenSet->bOpen = true;
+	pOpenSet->pDisjoint->Issue(D3DISSUE_BEGIN);
+	pOpenSet->pFrequency->Issue(D3DISSUE_END);
+	pOpenSet->pOverlayBegin->Issue(D3DISSUE_END);
+}
+
+/**
+    @brief : Mark the end of the overlay draw. Called after ImGui_ImplDX9_RenderDrawData.
+**/
+void d9gpu::OverlayDone()
+{
+	if (pOpenSet)
+		pOpenSet->pOverlayEnd->Issue(D3DISSUE_END);
+}
+
+/**
+    @brief : Release every query. Must be called before IDirect3DDevice9::Reset and on unhook.
+**/
+void d9gpu::Release()
+{
+	for (QuerySet& set : aSets)
+	{
+		for (IDirect3DQuery9** query : { &set.pDisjoint, &set.pFrequency, &set.pOverlayBegin, &set.pOverlayEnd, &set.pFrameEnd })
+		{
+			if (*query)
+			{
+				(*query)->Release();
+				*query = nullptr;
+			}
+		}
+		set.bOpen = false;
+		set.bPending = false;
+	}
+	pOpenSet = nullptr;
+	bCreated = false;
+}
+
+bool d9gpu::IsSupported()
+{
+	return !bUnsupported;
+}
+
+uint64_t d9gpu::GetSkippedFrames()
+{
+	return uSkippedFrames;
+}
+
+uint64_t d9gpu::GetDisjointFrames()
+{
+	return uDisjointFrames;
+}
+
+/**
+    @brief : Create the queries of every set.
+    @retval : False if the device does not support timestamp queries.
+**/
+bool d9gpu::CreateQueries(const LPDIRECT3DDEVICE9 pDevice)
+{
+	if (!pDevice)
+		return false;
+
+	for (QuerySet& set : aSets)
+	{
+		if (pDevice->CreateQuery(D3DQUERYTYPE_TIMESTAMPDISJOINT, &set.pDisjoint) != D3D_OK ||
+			pDevice->CreateQuery(D3DQUERYTYPE_TIMESTAMPFREQ, &set.pFrequency) != D3D_OK ||
+			pDevice->CreateQuery(D3DQUERYTYPE_TIMESTAMP, &set.pOverlayBegin) != D3D_OK ||
+			pDevice->CreateQuery(D3DQUERYTYPE_TIMESTAMP, &set.pOverlayEnd) != D3D_OK ||
+			pDevice->CreateQuery(D3DQUERYTYPE_TIMESTAMP, &set.pFrameEnd) != D3D_OK)
+			return false;
+	}
+
+	bCreated = true;
+	return true;
+}
+
+/**
+    @brief : Read back every finished set without flushing, and publish its timings to d9prof.
+**/
+void d9gpu::Collect()
+{
+	for (QuerySet& set : aSets)
+	{
+		if (!set.bPending)
+			continue;
+
+		// The disjoint end is issued last: once it is ready, the rest of the set is too
+		BOOL disjoint = TRUE;
+		const HRESULT hr = set.pDisjoint->GetData(&disjoint, sizeof(disjoint), 0);
+		if (hr == S_FALSE)
+			continue;
+
+		set.bPending = false;
+		UINT64 frequency = 0, overlayBegin = 0, overlayEnd = 0, frameEnd = 0;
+		if (hr != S_OK ||
+			set.pFrequency->GetData(&frequency, sizeof(frequency), 0) != S_OK ||
+			set.pOverlayBegin->GetData(&overlayBegin, sizeof(overlayBegin), 0) != S_OK ||
+			set.pOverlayEnd->GetData(&overlayEnd, sizeof(overlayEnd), 0) != S_OK ||
+			set.pFrameEnd->GetData(&frameEnd, sizeof(frameEnd), 0) != S_OK)
+			continue; // device lost: drop the frame
+
+		if (disjoint || frequency == 0 || overlayEnd < overlayBegin || frameEnd < overlayEnd)
+		{
+			++uDisjointFrames;
+			continue;
+		}
+
+		const double msPerTick = 1000.0 / static_cast<double>(frequency);
+		d9prof::SetCounter("gpu.overlay", static_cast<double>(overlayEnd - overlayBegin) * msPerTick, set.uFrame);
+		d9prof::SetCounter("gpu.game", static_cast<double>(frameEnd - overlayEnd) * msPerTick, set.uFrame);
+		d9prof::SetCounter("gpu.frame", static_cast<double>(frameEnd - overlayBegin) * msPerTick, set.uFrame);
+	}
+}
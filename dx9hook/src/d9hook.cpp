@@ -1,5 +1,9 @@
 #include <dx9hook/d9hook.hpp>
 #include <dx9hook/d9draw.hpp>
+#include <dx9hook/d9prof.hpp>
+#include <dx9hook/d9gpu.hpp>
+#include <dx9hook/d9input.hpp>
+#include <dx9hook/d9sched.hpp>
 #include <imgui_impl_dx9.h>
 #include <imgui_impl_win32.h>
 #include <detours.h>
@@ -13,24 +17,75 @@ HMODULE d9::hDDLModule = nullptr; // HMODULE of the DLL
 int d9::windowHeight = 0; // Height of the window
 int d9::windowWidth = 0; // Width of the window
 void* d9::d3d9Device[119]; // Array of pointer of the DirectX functions.
+bool d9::bCaptured = false; // d3d9Device holds the dummy device vtable.
 WNDPROC d9::OWndProc = nullptr; // Pointer of the original window message handler.
 
 bool d9::isMouseWanted = true;
 
+yu::hook::Site d9::siteEndScene("d3d9.EndScene", reinterpret_cast<void**>(&d9::oEndScene), reinterpret_cast<void*>(&d9draw::hkEndScene));
+yu::hook::Site d9::siteReset("d3d9.Reset", reinterpret_cast<void**>(&d9::oReset), reinterpret_cast<void*>(&d9::hkReset), true);
+yu::hook::Site* const d9::aSites[2] = { &d9::siteEndScene, &d9::siteReset };
+
 /**
-    @brief : Function that hook the Reset and EndScene function.
+    @brief : Function that copy the vtable of a dummy device once the game window exists.
+    @param  timeoutMs : How long to wait for the game window.
+    @retval : True if the vtable was captured else False.
 **/
-void d9::HookDirectX()
+bool d9::CaptureDevice(const DWORD timeoutMs)
 {
-	if (GetD3D9Device(d3d9Device, sizeof(d3d9Device)))
+	if (bCaptured)
+		return true;
+
+	// The dummy device needs the game window; startup may run before the game creates it
+	const ULONGLONG start = GetTickCount64();
+	while (!GetProcessWindow())
 	{
+		if (timeoutMs != INFINITE && GetTickCount64() - start >= timeoutMs)
+			return false;
+		Sleep(10);
+	}
+
+	bCaptured = GetD3D9Device(d3d9Device, sizeof(d3d9Device)) != FALSE;
+	return bCaptured;
+}
+
+/**
+    @brief : Function that point the EndScene and Reset sites at the captured vtable.
+    @retval : The sites to attach, empty if no vtable was captured.
+**/
+std::span<yu::hook::Site* const> d9::PrepareHooks()
+{
+	if (!CaptureDevice(0))
+		return {};
+
+	if (!siteEndScene.Attached())
 		oEndScene = (tEndScene)d3d9Device[42];
+	if (!siteReset.Attached())
 		oReset = (tReset)d3d9Device[16];
-		DetourTransactionBegin();
-		DetourUpdateThread(GetCurrentThread());
-		DetourAttach(&(PVOID&)oEndScene, d9draw::hkEndScene);
-		DetourAttach(&(PVOID&)oReset, hkReset);
-		DetourTransactionCommit();
+	siteEndScene.SetTimed(true); // once per frame, the clock reads do not matter
+	return aSites;
+}
+
+/**
+    @brief : Function that hook the Reset and EndScene function.
+**/
+void d9::HookDirectX()
+{
+	const std::span<yu::hook::Site* const> sites = PrepareHooks();
+	if (sites.empty())
+		return;
+
+	DetourTransactionBegin();
+	DetourUpdateThread(GetCurrentThread());
+	for (yu::hook::Site* site : sites)
+	{
+		if (!site->Attached())
+			DetourAttach(site->Original(), site->Detour());
+	}
+	if (DetourTransactionCommit() == NO_ERROR)
+	{
+		for (yu::hook::Site* site : sites)
+			site->SetAttached(true);
 	}
 }
 
@@ -48,12 +103,23 @@ void d9::UnHookDirectX()
 	}
 
 	d9draw::bInit = FALSE;
+	d9gpu::Release();
+	d9input::Stop();
+	d9sched::Stop();
 
+	// Also undoes sites a hook registry attached
 	DetourTransactionBegin();
 	DetourUpdateThread(GetCurrentThread());
-	DetourDetach(&(PVOID&)oEndScene, d9draw::hkEndScene);
-	DetourDetach(&(PVOID&)oReset, hkReset);
-	DetourTransactionCommit();
+	for (yu::hook::Site* site : aSites)
+	{
+		if (site->Attached())
+			DetourDetach(site->Original(), site->Detour());
+	}
+	if (DetourTransactionCommit() == NO_ERROR)
+	{
+		for (yu::hook::Site* site : aSites)
+			site->SetAttached(false);
+	}
 }
 
 /**
@@ -136,11 +202,18 @@ BOOL d9::GetD3D9Device(void** pTable, const size_t size)
 }
 
 /**
-	@brief : Function that setup the WndProc callback function.
+	@brief : Function that setup the WndProc callback function, once.
+	@retval : True if the window procedure is hooked, False while the game has no window.
 **/
-void d9::HookWindow()
+bool d9::HookWindow()
 {
+	if (OWndProc)
+		return true;
+	if (!window && !GetProcessWindow())
+		return false;
+
 	OWndProc = (WNDPROC)SetWindowLongPtr(window, GWLP_WNDPROC, (LONG_PTR)WndProc);
+	return OWndProc != nullptr;
 }
 
 
@@ -149,12 +222,16 @@ void d9::HookWindow()
 **/
 void d9::UnHookWindow()
 {
+	if (!OWndProc)
+		return;
+
 	SetWindowLongPtr(window, GWLP_WNDPROC, (LONG_PTR)OWndProc);
+	OWndProc = nullptr;
 }
 
 bool d9::WantsMouse()
 {
-    return isMouseWanted;
+    return isMouseWanted && siteEndScene.Enabled(); // no overlay, no mouse for it
 }
 /**
     @brief : A callback function, which you define in your application, that processes messages sent to a window. (https://learn.microsoft.com/en-us/windows/win32/api/winuser/nc-winuser-wndproc)
@@ -166,7 +243,10 @@ bool d9::WantsMouse()
 **/
 LRESULT WINAPI d9::WndProc(const HWND hWnd, const UINT msg, const WPARAM wParam, const LPARAM lParam)
 {
-	if (d9draw::bDisplay && ImGui_ImplWin32_WndProcHandler(hWnd, msg, wParam, lParam))
+	// Hotkeys see every press, including those ImGui keeps from the game
+	d9input::OnKeyMessage(msg, wParam, lParam);
+
+	if (d9draw::bDisplay && siteEndScene.Enabled() && ImGui_ImplWin32_WndProcHandler(hWnd, msg, wParam, lParam))
 	{
 		//ImGui::GetIO().MouseDrawCursor = ImGui::IsWindowHovered(ImGuiHoveredFlags_AnyWindow);
 		return true;	
@@ -189,8 +269,16 @@ LRESULT WINAPI d9::WndProc(const HWND hWnd, const UINT msg, const WPARAM wParam,
 **/
 HRESULT d9::hkReset(D3DPRESENT_PARAMETERS* pPresentationParameters)
 {
-	ImGui_ImplDX9_InvalidateDeviceObjects();
+	yu::hook::Site::Scope scope(siteReset);
+	{
+		D9PROF_ZONE("Reset");
+		d9gpu::Release();
+		ImGui_ImplDX9_InvalidateDeviceObjects();
+	}
 	const auto ret = d9::oReset(pPresentationParameters);
-	ImGui_ImplDX9_CreateDeviceObjects();
+	{
+		D9PROF_ZONE("Reset");
+		ImGui_ImplDX9_CreateDeviceObjects();
+	}
 	return ret;
 }
\ No newline at end of file
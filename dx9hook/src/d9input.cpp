@@ -0,0 +1,129 @@
+#include <dx9hook/d9input.hpp>
+
+yu::concurrent::SpscRing<UINT, d9input::QueueSize> d9input::qPresses; // Pressed virtual keys waiting for the worker.
+std::atomic<uint64_t> d9input::uDropped = 0; // Presses lost to a full queue.
+std::atomic<uint8_t> d9input::aPressed[256] = {}; // Pressed since the last ConsumePress, per key.
+
+std::vector<d9input::Hotkey> d9input::aHotkeys = {};
+std::mutex d9input::mHotkeys;
+std::thread d9input::tWorker;
+HANDLE d9input::hWake = nullptr; // Auto-reset event, set for every press; never closed.
+std::atomic<bool> d9input::bStopping = false;
+
+/**
+    @brief : Function that start the hotkey worker.
+**/
+void d9input::Start()
+{
+	if (tWorker.joinable())
+		return;
+
+	if (!hWake)
+		hWake = CreateEventW(nullptr, FALSE, FALSE, nullptr);
+
+	bStopping = false;
+	tWorker = std::thread(WorkerLoop);
+	SetEvent(hWake); // Presses queued before the worker existed
+}
+
+/**
+    @brief : Function that stop the hotkey worker, after the action in progress.
+**/
+void d9input::Stop()
+{
+	if (!tWorker.joinable())
+		return;
+
+	bStopping = true;
+	SetEvent(hWake);
+
+	// An action may stop the worker itself (unloading from a hotkey)
+	if (tWorker.get_id() == std::this_thread::get_id())
+		tWorker.detach();
+	else
+		tWorker.join();
+}
+
+/**
+    @brief : Function that register an action for a key.
+    @param  vk : Virtual key code.
+    @param  action : Function run on the input worker for each press.
+**/
+void d9input::RegisterHotkey(const UINT vk, tAction action)
+{
+	std::lock_guard lock(mHotkeys);
+	aHotkeys.push_back({ vk & 0xFF, std::move(action) });
+}
+
+/**
+    @brief : Function that test and clear the pressed flag of a key.
+    @param  vk : Virtual key code.
+    @retval : True if the key was pressed since the last call.
+**/
+bool d9input::ConsumePress(const UINT vk)
+{
+	std::atomic<uint8_t>& pressed = aPressed[vk & 0xFF];
+	// The plain load keeps the common case (not pressed) free of a locked instruction
+	return pressed.load(std::memory_order_relaxed) != 0 && pressed.exchange(0, std::memory_order_acquire) != 0;
+}
+
+/**
+    @brief : Function that record a key message from the window procedure.
+    @param  msg : The message.
+    @param  wParam : Virtual key code for key messages.
+    @param  lParam : Key flags; bit 30 is set for auto-repeat.
+**/
+void d9input::OnKeyMessage(const UINT msg, const WPARAM wParam, const LPARAM lParam)
+{
+	if (msg != WM_KEYDOWN && msg != WM_SYSKEYDOWN)
+		return;
+	if (lParam & (1 << 30))
+		return;
+
+	const UINT vk = static_cast<UINT>(wParam) & 0xFF;
+	aPressed[vk].store(1, std::memory_order_release);
+
+	if (!qPresses.TryPush(vk))
+	{
+		uDropped.fetch_add(1, std::memory_order_relaxed);
+		return;
+	}
+
+	if (hWake)
+		SetEvent(hWake);
+}
+
+uint64_t d9input::GetDroppedPresses()
+{
+	return uDropped.load(std::memory_order_relaxed);
+}
+
+/**
+    @brief : Function that run the registered actions of every queued press.
+**/
+void d9input::WorkerLoop()
+{
+	std::vector<tAction> actions;
+	while (!bStopping.load(std::memory_order_acquire))
+	{
+		WaitForSingleObject(hWake, INFINITE);
+
+		UINT vk;
+		while (!bStopping.load(std::memory_order_acquire) && qPresses.TryPop(vk))
+		{
+
+			// Copied out, so an action may register hotkeys
+			actions.clear();
+			{
+				std::lock_guard lock(mHotkeys);
+				for (const Hotkey& hotkey : aHotkeys)
+				{
+					if (hotkey.vk == vk)
+						actions.push_back(hotkey.action);
+				}
+			}
+			for (const tAction& action : actions)
+				action();
+		}
+	}
+}
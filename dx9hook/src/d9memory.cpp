@@ -0,0 +1,232 @@
+#include <dx9hook/d9memory.hpp>
+#include <dx9hook/d9prof.hpp>
+#include <imgui.h>
+#include <cstdio>
+
+bool d9memory::bPaused = false; // Sampling is suspended.
+float d9memory::aTotalMb[History] = {}; // Total tracked MB per frame.
+float d9memory::aAllocRate[History] = {}; // Allocations per second per frame.
+float d9memory::aFrameMs[History] = {}; // Frame time per frame.
+float d9memory::aTagMb[MaxTags][History] = {}; // Tracked MB of each tag per frame.
+uint32_t d9memory::uHead = 0; // Next slot of the rings.
+uint32_t d9memory::uCount = 0; // Valid samples in the rings.
+uint64_t d9memory::uLastAllocs = 0; // Allocation count of the previous sample.
+int64_t d9memory::iLastSample = 0; // Timestamp of the previous sample.
+
+namespace
+{
+	constexpr float BytesPerMb = 1024.0f * 1024.0f;
+
+	/**
+	    @brief : Largest value of a ring, for the plot scale.
+	**/
+	float MaxOf(const float* values, uint32_t count)
+	{
+		float max = 0.0f;
+		for (uint32_t i = 0; i < count; ++i)
+		{
+			if (values[i] > max)
+				max = values[i];
+		}
+		return max;
+	}
+
+	/**
+	    @brief : Format a byte count with a readable unit.
+	**/
+	void FormatBytes(char* buffer, size_t size, double bytes)
+	{
+		if (bytes >= 1024.0 * 1024.0 * 1024.0)
+			snprintf(buffer, size, "%.2f GB", bytes / (1024.0 * 1024.0 * 1024.0));
+		else if (bytes >= 1024.0 * 1024.0)
+			snprintf(buffer, size, "%.2f MB", bytes / (1024.0 * 1024.0));
+		else if (bytes >= 1024.0)
+			snprintf(buffer, size, "%.1f KB", bytes / 1024.0);
+		else
+			snprintf(buffer, size, "%.0f B", bytes);
+	}
+}
+
+/**
+    @brief : Start the tracker's next frame and append one sample of its counters to the rings. Called on each hkEndScene.
+**/
+void d9memory::Sample()
+{
+	const int64_t now = d9prof::Now();
+	auto& tracker = yu::mem::LightweightTracker::Instance();
+	tracker.AdvanceFrame(); // record lifetimes are counted in presented frames
+	const uint64_t allocs = tracker.GetTotalAllocCount();
+
+	if (iLastSample == 0 || bPaused)
+	{
+		iLastSample = now;
+		uLastAllocs = allocs;
+		return;
+	}
+
+	const double ms = d9prof::ToMs(now - iLastSample);
+	const uint32_t slot = uHead;
+	aTotalMb[slot] = static_cast<float>(tracker.GetTotalBytes()) / BytesPerMb;
+	aAllocRate[slot] = ms > 0.0 ? static_cast<float>(static_cast<double>(allocs - uLastAllocs) * 1000.0 / ms) : 0.0f;
+	aFrameMs[slot] = static_cast<float>(ms);
+	for (uint32_t tag = 0; tag < MaxTags; ++tag)
+		aTagMb[tag][slot] = static_cast<float>(tracker.GetTagBytes(static_cast<yu::mem::LightweightTracker::TagId>(tag))) / BytesPerMb;
+
+	uHead = (uHead + 1) % History;
+	if (uCount < History)
+		++uCount;
+	iLastSample = now;
+	uLastAllocs = allocs;
+}
+
+void d9memory::Init()
+{
+}
+
+/**
+    @brief : Draw the telemetry window: totals, time series, per-tag bytes, the size-class histogram and the lifetimes.
+    @param  dt : Frame time (unused, Sample measures its own).
+**/
+void d9memory::Render(float dt)
+{
+	(void)dt;
+	ImGui::SetNextWindowSize(ImVec2(520, 600), ImGuiCond_FirstUseEver);
+	if (!ImGui::Begin("Memory"))
+	{
+		ImGui::End();
+		return;
+	}
+
+	const auto& tracker = yu::mem::LightweightTracker::Instance();
+	char total[32], peak[32];
+	FormatBytes(total, sizeof(total), static_cast<double>(tracker.GetTotalBytes()));
+	FormatBytes(peak, sizeof(peak), static_cast<double>(tracker.GetPeakBytes()));
+	ImGui::Text("Total %s | peak %s%s | %zu live blocks | dropped %zu", total, peak,
+		yu::mem::LightweightTracker::HasExactStats ? "" : " (sampled)",
+		tracker.GetActiveCount(), tracker.GetDroppedCount());
+	if (const size_t interval = tracker.GetSampleInterval())
+		ImGui::TextDisabled("Sampled tracking, 1 per %zu bytes: values are estimates", interval);
+	ImGui::Checkbox("Pause", &bPaused);
+
+	if (uCount == 0)
+	{
+		ImGui::Text("No samples yet.");
+		ImGui::End();
+		return;
+	}
+
+	// Full rings start at the oldest sample, which is the next one to be overwritten
+	const int count = static_cast<int>(uCount);
+	const int offset = uCount == History ? static_cast<int>(uHead) : 0;
+	const uint32_t last = (uHead + History - 1) % History;
+	char overlay[64];
+
+	if (ImGui::CollapsingHeader("Time series", ImGuiTreeNodeFlags_DefaultOpen))
+	{
+		snprintf(overlay, sizeof(overlay), "total %.2f MB", aTotalMb[last]);
+		ImGui::PlotLines("##total", aTotalMb, count, offset, overlay, 0.0f, MaxOf(aTotalMb, uCount) * 1.1f, ImVec2(-1.0f, 60.0f));
+		snprintf(overlay, sizeof(overlay), "allocs/s %.0f", aAllocRate[last]);
+		ImGui::PlotHistogram("##rate", aAllocRate, count, offset, overlay, 0.0f, MaxOf(aAllocRate, uCount), ImVec2(-1.0f, 60.0f));
+		snprintf(overlay, sizeof(overlay), "frame %.2f ms", aFrameMs[last]);
+		ImGui::PlotLines("##frame", aFrameMs, count, offset, overlay, 0.0f, MaxOf(aFrameMs, uCount), ImVec2(-1.0f, 40.0f));
+	}
+
+	if (ImGui::CollapsingHeader("Tags", ImGuiTreeNodeFlags_DefaultOpen) &&
+		ImGui::BeginTable("##tags", 4, ImGuiTableFlags_RowBg | ImGuiTableFlags_SizingStretchProp))
+	{
+		ImGui::TableSetupColumn("Tag");
+		ImGui::TableSetupColumn("Current");
+		ImGui::TableSetupColumn("Peak");
+		ImGui::TableSetupColumn("History", ImGuiTableColumnFlags_WidthFixed, 160.0f);
+		ImGui::TableHeadersRow();
+		for (uint32_t tag = 0; tag < MaxTags; ++tag)
+		{
+			const auto id = static_cast<yu::mem::LightweightTracker::TagId>(tag);
+			if (tracker.GetTagAllocCount(id) == 0)
+				continue;
+			ImGui::TableNextRow();
+			ImGui::TableNextColumn();
+			ImGui::TextUnformatted(tracker.GetTagName(id));
+			ImGui::TableNextColumn();
+			FormatBytes(total, sizeof(total), static_cast<double>(tracker.GetTagBytes(id)));
+			ImGui::TextUnformatted(total);
+			ImGui::TableNextColumn();
+			FormatBytes(peak, sizeof(peak), static_cast<double>(tracker.GetTagPeakBytes(id)));
+			ImGui::TextUnformatted(peak);
+			ImGui::TableNextColumn();
+			ImGui::PushID(static_cast<int>(tag));
+			ImGui::PlotLines("##tag", aTagMb[tag], count, offset, nullptr, 0.0f, MaxOf(aTagMb[tag], uCount) * 1.1f, ImVec2(-1.0f, 18.0f));
+			ImGui::PopID();
+		}
+		ImGui::EndTable();
+	}
+
+	if (ImGui::CollapsingHeader("Size classes", ImGuiTreeNodeFlags_DefaultOpen))
+	{
+		ImGui::RadioButton("Blocks", &iHistogramMode, 0);
+		ImGui::SameLine();
+		ImGui::RadioButton("Bytes", &iHistogramMode, 1);
+		const bool bytes = iHistogramMode == 1;
+
+		// Class k holds [2^k, 2^(k+1)); the plot stops after the largest class in use
+		float classes[SizeClasses];
+		uint32_t used = 0;
+		for (uint32_t cls = 0; cls < SizeClasses; ++cls)
+		{
+			const size_t value = bytes ? tracker.GetSizeClassBytes(cls) : tracker.GetSizeClassCount(cls);
+			classes[cls] = static_cast<float>(value);
+			if (value > 0)
+				used = cls + 1;
+		}
+		ImGui::PlotHistogram("##classes", classes, static_cast<int>(used), 0, bytes ? "live bytes by size" : "live blocks by size",
+			0.0f, MaxOf(classes, used), ImVec2(-1.0f, 80.0f));
+		if (ImGui::IsItemHovered() && used > 0)
+		{
+			const float x = (ImGui::GetIO().MousePos.x - ImGui::GetItemRectMin().x) / ImGui::GetItemRectSize().x;
+			const uint32_t cls = static_cast<uint32_t>(x * used) < used ? static_cast<uint32_t>(x * used) : used - 1;
+			FormatBytes(total, sizeof(total), cls == 0 ? 0.0 : static_cast<double>(1ull << cls));
+			FormatBytes(peak, sizeof(peak), static_cast<double>((1ull << (cls + 1)) - 1));
+			ImGui::SetTooltip("%s - %s: %zu blocks, %zu bytes", total, peak,
+				tracker.GetSizeClassCount(cls), tracker.GetSizeClassBytes(cls));
+		}
+	}
+
+	if (tracker.IsLifetimeProfiling() && ImGui::CollapsingHeader("Lifetimes") &&
+		ImGui::BeginTable("##lifetimes", 4, ImGuiTableFlags_RowBg | ImGuiTableFlags_SizingStretchProp))
+	{
+		// Same-frame frees are the blocks a frame allocator or a pool would take over
+		ImGui::TableSetupColumn("Size");
+		ImGui::TableSetupColumn("Frees");
+		ImGui::TableSetupColumn("Same frame");
+		ImGui::TableSetupColumn("Frames alive (log2)", ImGuiTableColumnFlags_WidthFixed, 160.0f);
+		ImGui::TableHeadersRow();
+		for (uint32_t cls = 0; cls < SizeClasses; ++cls)
+		{
+			float buckets[LifetimeBuckets];
+			size_t frees = 0;
+			for (uint32_t b = 0; b < LifetimeBuckets; ++b)
+			{
+				const size_t count = tracker.GetLifetimeCount(cls, b);
+				buckets[b] = static_cast<float>(count);
+				frees += count;
+			}
+			if (frees == 0)
+				continue;
+			ImGui::TableNextRow();
+			ImGui::TableNextColumn();
+			FormatBytes(total, sizeof(total), cls == 0 ? 0.0 : static_cast<double>(1ull << cls));
+			ImGui::TextUnformatted(total);
+			ImGui::TableNextColumn();
+			ImGui::Text("%zu", frees);
+			ImGui::TableNextColumn();
+			ImGui::Text("%.0f%%", static_cast<double>(buckets[0]) * 100.0 / static_cast<double>(frees));
+			ImGui::TableNextColumn();
+			ImGui::PushID(static_cast<int>(cls));
+			ImGui::PlotHistogram("##age", buckets, static_cast<int>(LifetimeBuckets), 0, nullptr, 0.0f, MaxOf(buckets, LifetimeBuckets), ImVec2(-1.0f, 18.0f));
+			ImGui::PopID();
+		}
+		ImGui::EndTable();
+	}
+
+	ImGui::End();
+}
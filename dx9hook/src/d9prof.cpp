@@ -0,0 +1,506 @@
+#include <dx9hook/d9prof.hpp>
+#include <dx9hook/d9gpu.hpp>
+#include <imgui.h>
+#include <cstdio>
+#include <cstring>
+
+std::atomic<bool> d9prof::bEnabled = true; // Zones and counters are recorded.
+bool d9prof::bShowView = false; // Profiler window visibility.
+d9prof::Frame d9prof::aFrames[FrameHistory] = {}; // Ring of the last frames.
+std::atomic<uint64_t> d9prof::uFrame = 0; // Number of the current frame.
+std::atomic<uint64_t> d9prof::uDroppedZones = 0; // Zones lost to a full frame.
+uint32_t d9prof::uRenderThread = 0; // Thread that calls NewFrame (hkEndScene).
+int64_t d9prof::iFrequency = []
+{
+	LARGE_INTEGER frequency;
+	QueryPerformanceFrequency(&frequency);
+	return frequency.QuadPart;
+}();
+
+static thread_local uint32_t tZoneDepth = 0; // Open zones on this thread.
+
+namespace
+{
+	/**
+	    @brief : Visit the published zones of a frame.
+	**/
+	template <typename Fn>
+	void ForEachZone(const d9prof::Frame& frame, Fn&& fn)
+	{
+		uint32_t count = frame.zoneCount.load(std::memory_order_acquire);
+		if (count > d9prof::MaxZones)
+			count = d9prof::MaxZones;
+		for (uint32_t i = 0; i < count; ++i)
+		{
+			const d9prof::Zone& zone = frame.zones[i];
+			if (const char* name = zone.name.load(std::memory_order_acquire))
+				fn(name, zone);
+		}
+	}
+
+	/**
+	    @brief : Visit the published counters of a frame.
+	**/
+	template <typename Fn>
+	void ForEachCounter(const d9prof::Frame& frame, Fn&& fn)
+	{
+		uint32_t count = frame.counterCount.load(std::memory_order_acquire);
+		if (count > d9prof::MaxCounters)
+			count = d9prof::MaxCounters;
+		for (uint32_t i = 0; i < count; ++i)
+		{
+			const d9prof::Counter& counter = frame.counters[i];
+			if (const char* name = counter.name.load(std::memory_order_acquire))
+				fn(name, counter.value);
+		}
+	}
+
+	/**
+	    @brief : Running total / max of one zone or counter name over the history.
+	**/
+	struct Aggregate
+	{
+		const char* name;
+		double total;
+		double max;
+		uint32_t samples;
+	};
+
+	void Accumulate(Aggregate* table, uint32_t& count, uint32_t capacity, const char* name, double value)
+	{
+		for (uint32_t i = 0; i < count; ++i)
+		{
+			if (table[i].name == name || std::strcmp(table[i].name, name) == 0)
+			{
+				table[i].total += value;
+				if (value > table[i].max)
+					table[i].max = value;
+				++table[i].samples;
+				return;
+			}
+		}
+		if (count < capacity)
+			table[count++] = { name, value, value, 1 };
+	}
+
+	/**
+	    @brief : Write a string as a JSON string literal body.
+	**/
+	void WriteJsonString(FILE* file, const char* text)
+	{
+		for (; *text; ++text)
+		{
+			const unsigned char c = static_cast<unsigned char>(*text);
+			if (c == '"' || c == '\\')
+				std::fprintf(file, "\\%c", c);
+			else if (c < 0x20)
+				std::fprintf(file, "\\u%04x", c);
+			else
+				std::fputc(c, file);
+		}
+	}
+}
+
+/**
+    @brief : Close the current frame and open the next one. Called on each hkEndScene.
+**/
+void d9prof::NewFrame()
+{
+	const int64_t now = Now();
+	const uint64_t current = uFrame.load(std::memory_order_relaxed);
+	uRenderThread = GetCurrentThreadId();
+	aFrames[current & (FrameHistory - 1)].end = now;
+
+	// Recycle the slot of the oldest frame
+	const uint64_t next = current + 1;
+	Frame& frame = aFrames[next & (FrameHistory - 1)];
+	uint32_t zones = frame.zoneCount.load(std::memory_order_relaxed);
+	uint32_t counters = frame.counterCount.load(std::memory_order_relaxed);
+	for (uint32_t i = 0; i < zones && i < MaxZones; ++i)
+		frame.zones[i].name.store(nullptr, std::memory_order_relaxed);
+	for (uint32_t i = 0; i < counters && i < MaxCounters; ++i)
+		frame.counters[i].name.store(nullptr, std::memory_order_relaxed);
+	frame.zoneCount.store(0, std::memory_order_relaxed);
+	frame.counterCount.store(0, std::memory_order_relaxed);
+	frame.begin = now;
+	frame.end = 0;
+	frame.index.store(next, std::memory_order_relaxed);
+	uFrame.store(next, std::memory_order_release);
+}
+
+/**
+    @brief : Append a zone to the current frame.
+    @param  name : Zone name (must outlive the profiler).
+    @param  begin : Start, in QPC ticks.
+    @param  end : End, in QPC ticks.
+    @param  depth : Nesting depth on the calling thread.
+**/
+void d9prof::RecordZone(const char* name, const int64_t begin, const int64_t end, const uint32_t depth)
+{
+	if (!bEnabled.load(std::memory_order_relaxed))
+		return;
+
+	Frame& frame = aFrames[uFrame.load(std::memory_order_acquire) & (FrameHistory - 1)];
+	const uint32_t slot = frame.zoneCount.fetch_add(1, std::memory_order_relaxed);
+	if (slot >= MaxZones)
+	{
+		uDroppedZones.fetch_add(1, std::memory_order_relaxed);
+		return;
+	}
+
+	Zone& zone = frame.zones[slot];
+	zone.begin = begin;
+	zone.end = end;
+	zone.threadId = GetCurrentThreadId();
+	zone.depth = depth;
+	zone.name.store(name, std::memory_order_release);
+}
+
+/**
+    @brief : Set a named value on the current frame.
+**/
+void d9prof::SetCounter(const char* name, const double value)
+{
+	SetCounter(name, value, CurrentFrame());
+}
+
+/**
+    @brief : Set a named value on a given frame, for results that arrive late (GPU queries).
+    @param  frame : Frame number; ignored once it has left the ring.
+**/
+void d9prof::SetCounter(const char* name, const double value, const uint64_t frame)
+{
+	if (!bEnabled.load(std::memory_order_relaxed))
+		return;
+
+	Frame& slot = aFrames[frame & (FrameHistory - 1)];
+	if (slot.index.load(std::memory_order_acquire) != frame)
+		return;
+
+	const uint32_t index = slot.counterCount.fetch_add(1, std::memory_order_relaxed);
+	if (index >= MaxCounters)
+		return;
+
+	slot.counters[index].value = value;
+	slot.counters[index].name.store(name, std::memory_order_release);
+}
+
+uint64_t d9prof::CurrentFrame()
+{
+	return uFrame.load(std::memory_order_acquire);
+}
+
+/**
+    @brief : Get a completed frame.
+    @retval : nullptr for the current frame, a frame that left the ring or the frame before the first NewFrame.
+**/
+const d9prof::Frame* d9prof::GetFrame(const uint64_t frame)
+{
+	if (frame >= CurrentFrame())
+		return nullptr;
+
+	const Frame& slot = aFrames[frame & (FrameHistory - 1)];
+	if (slot.index.load(std::memory_order_acquire) != frame || slot.begin == 0 || slot.end == 0)
+		return nullptr;
+	return &slot;
+}
+
+uint64_t d9prof::GetDroppedZones()
+{
+	return uDroppedZones.load(std::memory_order_relaxed);
+}
+
+int64_t d9prof::Now()
+{
+	LARGE_INTEGER now;
+	QueryPerformanceCounter(&now);
+	return now.QuadPart;
+}
+
+double d9prof::ToMs(const int64_t ticks)
+{
+	return static_cast<double>(ticks) * 1000.0 / static_cast<double>(iFrequency);
+}
+
+/**
+    @brief : Draw the profiler window: overlay cost per frame against the budget, a bar
+             per zone, a flame graph of the last frame and the counters.
+**/
+void d9prof::RenderView()
+{
+	ImGui::SetNextWindowSize(ImVec2(480, 520), ImGuiCond_FirstUseEver);
+	if (!ImGui::Begin("d9prof", &bShowView))
+	{
+		ImGui::End();
+		return;
+	}
+
+	bool enabled = bEnabled.load(std::memory_order_relaxed);
+	if (ImGui::Checkbox("Record", &enabled))
+		bEnabled.store(enabled, std::memory_order_relaxed);
+	ImGui::SameLine();
+	if (d9gpu::IsSupported())
+		ImGui::Checkbox("GPU timing", &d9gpu::bEnabled);
+	else
+		ImGui::TextDisabled("No GPU timestamps");
+	ImGui::SameLine();
+	if (ImGui::Button("Export CSV"))
+		ExportCsv("d9prof.csv");
+	ImGui::SameLine();
+	if (ImGui::Button("Export trace"))
+		ExportChromeTrace("d9prof.json");
+
+	// Overlay cost of a frame = its top-level zones, on every thread
+	static float overlayMs[FrameHistory];
+	Aggregate zoneStats[MaxZones];
+	Aggregate counterStats[MaxCounters];
+	uint32_t zoneStatCount = 0, counterStatCount = 0;
+	int frames = 0, overBudget = 0;
+	double overlayTotal = 0.0, overlayMax = 0.0, frameTotal = 0.0;
+
+	const uint64_t current = CurrentFrame();
+	const uint64_t first = current >= FrameHistory ? current - FrameHistory + 1 : 0;
+	const Frame* last = nullptr;
+	for (uint64_t i = first; i < current; ++i)
+	{
+		const Frame* frame = GetFrame(i);
+		if (!frame)
+			continue;
+
+		double overlay = 0.0;
+		ForEachZone(*frame, [&](const char* name, const Zone& zone)
+		{
+			const double ms = ToMs(zone.end - zone.begin);
+			if (zone.depth == 0)
+				overlay += ms;
+			Accumulate(zoneStats, zoneStatCount, MaxZones, name, ms);
+		});
+		ForEachCounter(*frame, [&](const char* name, const double value)
+		{
+			Accumulate(counterStats, counterStatCount, MaxCounters, name, value);
+		});
+
+		overlayMs[frames++] = static_cast<float>(overlay);
+		overlayTotal += overlay;
+		if (overlay > overlayMax)
+			overlayMax = overlay;
+		if (overlay > BudgetMs)
+			++overBudget;
+		frameTotal += ToMs(frame->end - frame->begin);
+		last = frame;
+	}
+
+	if (frames == 0)
+	{
+		ImGui::Text("No completed frames yet.");
+		ImGui::End();
+		return;
+	}
+
+	ImGui::Text("Frame %.2f ms | overlay avg %.3f ms, max %.3f ms (budget %.2f ms)",
+		frameTotal / frames, overlayTotal / frames, overlayMax, BudgetMs);
+	ImGui::Text("Over budget: %d / %d frames | dropped zones: %llu",
+		overBudget, frames, static_cast<unsigned long long>(GetDroppedZones()));
+	ImGui::PlotHistogram("##overlay", overlayMs, frames, 0, "overlay ms", 0.0f,
+		static_cast<float>(BudgetMs * 2.0), ImVec2(-1.0f, 60.0f));
+
+	// One bar per zone: average per frame, relative to the budget
+	if (ImGui::CollapsingHeader("Zones", ImGuiTreeNodeFlags_DefaultOpen))
+	{
+		for (uint32_t i = 0; i < zoneStatCount; ++i)
+		{
+			const Aggregate& stat = zoneStats[i];
+			const double avg = stat.total / frames;
+			char label[96];
+			std::snprintf(label, sizeof(label), "%.3f ms (max %.3f, %u calls)", avg, stat.max, stat.samples);
+			const bool over = avg > BudgetMs;
+			if (over)
+				ImGui::PushStyleColor(ImGuiCol_PlotHistogram, ImVec4(0.9f, 0.2f, 0.2f, 1.0f));
+			ImGui::ProgressBar(static_cast<float>(avg / BudgetMs), ImVec2(200.0f, 0.0f), label);
+			if (over)
+				ImGui::PopStyleColor();
+			ImGui::SameLine();
+			ImGui::TextUnformatted(stat.name);
+		}
+	}
+
+	// Flame graph of the longest top-level zone of the last frame on the render thread
+	if (last && ImGui::CollapsingHeader("Last frame", ImGuiTreeNodeFlags_DefaultOpen))
+	{
+		const Zone* root = nullptr;
+		uint32_t maxDepth = 0;
+		ForEachZone(*last, [&](const char*, const Zone& zone)
+		{
+			if (zone.threadId != uRenderThread)
+				return;
+			if (zone.depth == 0 && (!root || zone.end - zone.begin > root->end - root->begin))
+				root = &zone;
+			if (zone.depth > maxDepth)
+				maxDepth = zone.depth;
+		});
+
+		if (root && root->end > root->begin)
+		{
+			constexpr float rowHeight = 18.0f;
+			const ImVec2 origin = ImGui::GetCursorScreenPos();
+			const float width = ImGui::GetContentRegionAvail().x;
+			const double span = static_cast<double>(root->end - root->begin);
+			ImDrawList* draw = ImGui::GetWindowDrawList();
+
+			ForEachZone(*last, [&](const char* name, const Zone& zone)
+			{
+				if (zone.threadId != uRenderThread || zone.begin < root->begin || zone.end > root->end)
+					return;
+				const ImVec2 min(origin.x + static_cast<float>((zone.begin - root->begin) / span) * width,
+					origin.y + zone.depth * rowHeight);
+				const ImVec2 max(origin.x + static_cast<float>((zone.end - root->begin) / span) * width,
+					min.y + rowHeight - 1.0f);
+				const ImU32 color = ImGui::GetColorU32(ImGuiCol_PlotHistogram, 0.6f + 0.1f * (zone.depth % 4));
+				draw->AddRectFilled(min, ImVec2(max.x > min.x + 1.0f ? max.x : min.x + 1.0f, max.y), color);
+				if (max.x - min.x > ImGui::CalcTextSize(name).x + 4.0f)
+					draw->AddText(ImVec2(min.x + 2.0f, min.y + 2.0f), IM_COL32_WHITE, name);
+				if (ImGui::IsMouseHoveringRect(min, max))
+					ImGui::SetTooltip("%s: %.3f ms", name, ToMs(zone.end - zone.begin));
+			});
+			ImGui::Dummy(ImVec2(width, (maxDepth + 1) * rowHeight));
+		}
+	}
+
+	if (counterStatCount > 0 && ImGui::CollapsingHeader("Counters", ImGuiTreeNodeFlags_DefaultOpen))
+	{
+		// GPU busy for most of the CPU frame means the game is GPU-bound
+		const Aggregate* gpuFrame = nullptr;
+		const Aggregate* gpuOverlay = nullptr;
+		for (uint32_t i = 0; i < counterStatCount; ++i)
+		{
+			if (std::strcmp(counterStats[i].name, "gpu.frame") == 0)
+				gpuFrame = &counterStats[i];
+			else if (std::strcmp(counterStats[i].name, "gpu.overlay") == 0)
+				gpuOverlay = &counterStats[i];
+		}
+		if (gpuFrame && gpuOverlay && gpuFrame->total > 0.0)
+		{
+			const double gpuMs = gpuFrame->total / gpuFrame->samples;
+			ImGui::Text("GPU busy %.0f%% of the frame, overlay %.1f%% of GPU time",
+				100.0 * gpuMs / (frameTotal / frames), 100.0 * gpuOverlay->total / gpuFrame->total);
+			ImGui::Text("GPU frames skipped: %llu, disjoint: %llu",
+				static_cast<unsigned long long>(d9gpu::GetSkippedFrames()),
+				static_cast<unsigned long long>(d9gpu::GetDisjointFrames()));
+		}
+		for (uint32_t i = 0; i < counterStatCount; ++i)
+		{
+			const Aggregate& stat = counterStats[i];
+			ImGui::Text("%s: avg %.3f, max %.3f", stat.name, stat.total / stat.samples, stat.max);
+		}
+	}
+
+	ImGui::End();
+}
+
+/**
+    @brief : Write the completed frames of the ring as CSV, one row per zone or counter.
+    @param  path : Output file.
+    @retval : True if the file was written.
+**/
+bool d9prof::ExportCsv(const char* path)
+{
+	FILE* file = nullptr;
+	if (fopen_s(&file, path, "w") != 0 || !file)
+		return false;
+
+	std::fprintf(file, "frame,kind,name,thread,depth,start_ms,value\n");
+	const uint64_t current = CurrentFrame();
+	for (uint64_t i = current >= FrameHistory ? current - FrameHistory + 1 : 0; i < current; ++i)
+	{
+		const Frame* frame = GetFrame(i);
+		if (!frame)
+			continue;
+		std::fprintf(file, "%llu,frame,frame,%u,0,0,%.6f\n",
+			static_cast<unsigned long long>(i), uRenderThread, ToMs(frame->end - frame->begin));
+		ForEachZone(*frame, [&](const char* name, const Zone& zone)
+		{
+			std::fprintf(file, "%llu,zone,%s,%u,%u,%.6f,%.6f\n", static_cast<unsigned long long>(i), name,
+				zone.threadId, zone.depth, ToMs(zone.begin - frame->begin), ToMs(zone.end - zone.begin));
+		});
+		ForEachCounter(*frame, [&](const char* name, const double value)
+		{
+			std::fprintf(file, "%llu,counter,%s,,,,%.6f\n", static_cast<unsigned long long>(i), name, value);
+		});
+	}
+
+	std::fclose(file);
+	return true;
+}
+
+/**
+    @brief : Write the completed frames of the ring in the Chrome trace event format (chrome://tracing, Perfetto).
+    @param  path : Output file.
+    @retval : True if the file was written.
+**/
+bool d9prof::ExportChromeTrace(const char* path)
+{
+	FILE* file = nullptr;
+	if (fopen_s(&file, path, "w") != 0 || !file)
+		return false;
+
+	const uint64_t current = CurrentFrame();
+	int64_t origin = 0;
+	bool firstEvent = true;
+	auto separator = [&]()
+	{
+		std::fputs(firstEvent ? "\n" : ",\n", file);
+		firstEvent = false;
+	};
+
+	std::fputs("{\"displayTimeUnit\":\"ms\",\"traceEvents\":[", file);
+	for (uint64_t i = current >= FrameHistory ? current - FrameHistory + 1 : 0; i < current; ++i)
+	{
+		const Frame* frame = GetFrame(i);
+		if (!frame)
+			continue;
+		if (origin == 0)
+			origin = frame->begin;
+
+		const double frameUs = ToMs(frame->begin - origin) * 1000.0;
+		separator();
+		std::fprintf(file, "{\"name\":\"frame %llu\",\"ph\":\"X\",\"pid\":1,\"tid\":0,\"ts\":%.3f,\"dur\":%.3f}",
+			static_cast<unsigned long long>(i), frameUs, ToMs(frame->end - frame->begin) * 1000.0);
+
+		ForEachZone(*frame, [&](const char* name, const Zone& zone)
+		{
+			separator();
+			std::fputs("{\"name\":\"", file);
+			WriteJsonString(file, name);
+			std::fprintf(file, "\",\"ph\":\"X\",\"pid\":1,\"tid\":%u,\"ts\":%.3f,\"dur\":%.3f}",
+				zone.threadId, ToMs(zone.begin - origin) * 1000.0, ToMs(zone.end - zone.begin) * 1000.0);
+		});
+		ForEachCounter(*frame, [&](const char* name, const double value)
+		{
+			separator();
+			std::fputs("{\"name\":\"", file);
+			WriteJsonString(file, name);
+			std::fprintf(file, "\",\"ph\":\"C\",\"pid\":1,\"ts\":%.3f,\"args\":{\"value\":%.6f}}", frameUs, value);
+		});
+	}
+	std::fputs("\n]}\n", file);
+
+	std::fclose(file);
+	return true;
+}
+
+d9zone::d9zone(const char* name)
+	: szName(name), iBegin(0), uDepth(0)
+{
+	if (!d9prof::bEnabled.load(std::memory_order_relaxed))
+		return;
+	uDepth = tZoneDepth++;
+	iBegin = d9prof::Now();
+}
+
+d9zone::~d9zone()
+{
+	if (iBegin == 0)
+		return;
+	--tZoneDepth;
+	d9prof::RecordZone(szName, iBegin, d9prof::Now(), uDepth);
+}
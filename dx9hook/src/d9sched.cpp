@@ -0,0 +1,165 @@
+#include <dx9hook/d9sched.hpp>
+#include <dx9hook/d9draw.hpp>
+#include <dx9hook/d9prof.hpp>
+
+std::vector<d9sched::Entry> d9sched::aWorker = {}; // Widgets updated on the worker thread.
+std::vector<d9sched::Entry> d9sched::aRender = {}; // Widgets updated in hkEndScene.
+std::mutex d9sched::mWorker;
+std::mutex d9sched::mRender;
+std::thread d9sched::tWorker;
+HANDLE d9sched::hWake = nullptr; // Auto-reset event: new widget or stop; never closed.
+std::atomic<bool> d9sched::bStopping = false;
+std::atomic<uint64_t> d9sched::uDeferred = 0;
+
+/**
+    @brief : Function that schedule the updates of a widget.
+    @param  widget : Registered widget; widgets without an update rate are ignored.
+**/
+void d9sched::Add(d9widget* widget)
+{
+	if (!widget || widget->GetUpdateHz() <= 0.0f)
+		return;
+
+	if (widget->UpdateOnRenderThread())
+	{
+		std::lock_guard lock(mRender);
+		aRender.push_back({ widget, 0, 1, 0.0 });
+		return;
+	}
+
+	{
+		std::lock_guard lock(mWorker);
+		aWorker.push_back({ widget, 0, 1, 0.0 });
+
+		if (!tWorker.joinable())
+		{
+			if (!hWake)
+				hWake = CreateEventW(nullptr, FALSE, FALSE, nullptr);
+			bStopping = false;
+			tWorker = std::thread(WorkerLoop);
+		}
+	}
+	if (hWake)
+		SetEvent(hWake);
+}
+
+/**
+    @brief : Function that stop the worker thread after the update in progress.
+**/
+void d9sched::Stop()
+{
+	if (!tWorker.joinable())
+		return;
+
+	bStopping = true;
+	SetEvent(hWake);
+	tWorker.join();
+}
+
+/**
+    @brief : Function that run the due render-thread updates that fit in the frame budget.
+**/
+void d9sched::RunRenderUpdates()
+{
+	if (!d9draw::bDisplay)
+		return;
+
+	D9PROF_ZONE("d9sched");
+	std::lock_guard lock(mRender);
+	const int64_t frameStart = d9prof::Now();
+	uint64_t deferred = 0;
+	for (Entry& entry : aRender)
+	{
+		const int64_t now = d9prof::Now();
+		if (now < entry.nextDue)
+			continue;
+
+		// The first due update always runs; the next ones only if they fit
+		const double spent = d9prof::ToMs(now - frameStart);
+		if (spent > 0.0 && spent + entry.lastMs > FrameBudgetMs)
+		{
+			++deferred;
+			continue;
+		}
+		Run(entry, now);
+	}
+	if (deferred)
+		uDeferred.fetch_add(deferred, std::memory_order_relaxed);
+	d9prof::SetCounter("sched.deferred", static_cast<double>(deferred));
+}
+
+uint64_t d9sched::GetDeferred()
+{
+	return uDeferred.load(std::memory_order_relaxed);
+}
+
+/**
+    @brief : Function that update a widget and pick its next due time.
+**/
+void d9sched::Run(Entry& entry, const int64_t now)
+{
+	{
+		D9PROF_ZONE(entry.widget->GetName());
+		entry.widget->Update();
+	}
+	const int64_t end = d9prof::Now();
+	entry.lastMs = d9prof::ToMs(end - now);
+
+	const double budget = entry.widget->GetBudgetMs();
+	if (entry.lastMs > budget)
+	{
+		if (entry.backoff < MaxBackoff)
+		{
+			entry.backoff *= 2;
+			uDeferred.fetch_add(1, std::memory_order_relaxed);
+		}
+	}
+	else if (entry.lastMs < budget / 2 && entry.backoff > 1)
+	{
+		entry.backoff /= 2;
+	}
+
+	// Late updates are not caught up: the next one is an interval after this one
+	entry.nextDue = end + Interval(entry);
+}
+
+/**
+    @brief : Function that get the current update interval of a widget in d9prof ticks.
+**/
+int64_t d9sched::Interval(const Entry& entry)
+{
+	static const double ticksPerMs = 1.0 / d9prof::ToMs(1);
+	const double ms = 1000.0 / entry.widget->GetUpdateHz() * entry.backoff;
+	return static_cast<int64_t>(ms * ticksPerMs);
+}
+
+/**
+    @brief : Function that sleep until the next worker update is due, then run it.
+**/
+void d9sched::WorkerLoop()
+{
+	while (!bStopping.load(std::memory_order_acquire))
+	{
+		DWORD waitMs = INFINITE;
+		{
+			std::lock_guard lock(mWorker);
+			const int64_t now = d9prof::Now();
+			for (Entry& entry : aWorker)
+			{
+				if (!d9draw::bDisplay)
+				{
+					waitMs = 100; // Check again for the overlay to come back
+					break;
+				}
+				if (now >= entry.nextDue)
+					Run(entry, now);
+
+				const double untilDue = d9prof::ToMs(entry.nextDue - d9prof::Now());
+				const DWORD ms = untilDue <= 0.0 ? 0 : static_cast<DWORD>(untilDue) + 1;
+				if (ms < waitMs)
+					waitMs = ms;
+			}
+		}
+		WaitForSingleObject(hWake, waitMs);
+	}
+}
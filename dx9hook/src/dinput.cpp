@@ -1,6 +1,10 @@
 #include <dx9hook/dinput.hpp>
 #include <dx9hook/d9hook.hpp>
+#include <dx9hook/d9prof.hpp>
 #include <detours.h>
+#include <atomic>
+#include <cstdint>
+#include <cstring>
 typedef HRESULT(__stdcall DInput8DeviceGetDeviceStateT)(IDirectInputDevice8*, DWORD, LPVOID);
 typedef HRESULT(__stdcall DInput8DeviceGetDeviceDataT)(IDirectInputDevice8*, DWORD, LPDIDEVICEOBJECTDATA, LPDWORD, DWORD);
 typedef HRESULT(__stdcall DInput8DeviceAcquireT)(IDirectInputDevice8*);
@@ -8,64 +12,253 @@ typedef HRESULT(__stdcall DInput8DeviceAcquireT)(IDirectInputDevice8*);
 static DInput8DeviceGetDeviceStateT* g_sDInput8DeviceGetDeviceStateOriginal = nullptr;
 static DInput8DeviceGetDeviceDataT* g_sDInput8DeviceGetDeviceDataOriginal = nullptr;
 static DInput8DeviceAcquireT* g_sDInput8DeviceAcquireOriginal = nullptr;
+static void* g_sVTable[32];
+static bool g_sVTableCaptured = false;
+
+// Disabled, the hooks only keep the device bookkeeping below in step with the game's own calls
+static yu::hook::Site g_sGetDeviceStateSite("dinput.GetDeviceState", reinterpret_cast<void**>(&g_sDInput8DeviceGetDeviceStateOriginal),
+                                            reinterpret_cast<void*>(&dinput::hook::DInput8DeviceGetDeviceStateHook));
+static yu::hook::Site g_sGetDeviceDataSite("dinput.GetDeviceData", reinterpret_cast<void**>(&g_sDInput8DeviceGetDeviceDataOriginal),
+                                           reinterpret_cast<void*>(&dinput::hook::DInput8DeviceGetDeviceDataHook));
+static yu::hook::Site g_sAcquireSite("dinput.Acquire", reinterpret_cast<void**>(&g_sDInput8DeviceAcquireOriginal),
+                                     reinterpret_cast<void*>(&dinput::hook::DInput8DeviceAcquireHook));
+static yu::hook::Site* const g_sSites[] = { &g_sGetDeviceStateSite, &g_sGetDeviceDataSite, &g_sAcquireSite };
+
+static std::atomic<dinput::Mode> g_sMode = dinput::Mode::Acquisition;
+
+// Acquisition we last asked for, per device: switching only on a change saves a COM call per poll
+enum class DeviceState : uint8_t
+{
+    Unknown,
+    Acquired,
+    Released
+};
+
+struct TrackedDevice
+{
+    std::atomic<IDirectInputDevice8*> device;
+    std::atomic<DeviceState> state;
+};
+
+static constexpr size_t kMaxTrackedDevices = 8;
+static TrackedDevice g_sDevices[kMaxTrackedDevices] = {};
+
+static std::atomic<uint64_t> g_sCalls = 0;    // Hooked polls
+static std::atomic<uint64_t> g_sSwitches = 0; // Acquire/Unacquire calls made
+static std::atomic<uint64_t> g_sAvoided = 0;  // Acquire/Unacquire calls skipped, state unchanged
+static std::atomic<uint64_t> g_sFiltered = 0; // Polls whose input was hidden from the game
+static dinput::Stats g_sPublished = {};       // Totals at the last PublishCounters
+
+/**
+    @brief : Function that find (or start tracking) a device.
+    @retval : nullptr when every slot is taken; the device is then switched on every poll.
+**/
+static TrackedDevice* FindDevice(IDirectInputDevice8* device)
+{
+    for (TrackedDevice& slot : g_sDevices)
+    {
+        IDirectInputDevice8* current = slot.device.load(std::memory_order_acquire);
+        if (current == device)
+            return &slot;
+        if (!current && slot.device.compare_exchange_strong(current, device, std::memory_order_acq_rel))
+            return &slot;
+        if (current == device) // Another thread inserted it first
+            return &slot;
+    }
+    return nullptr;
+}
+
+/**
+    @brief : Function that acquire or release a device, only if it is not in that state already.
+**/
+static void SetAcquired(IDirectInputDevice8* device, const bool acquired)
+{
+    TrackedDevice* tracked = FindDevice(device);
+    const DeviceState wanted = acquired ? DeviceState::Acquired : DeviceState::Released;
+    if (tracked && tracked->state.load(std::memory_order_relaxed) == wanted)
+    {
+        g_sAvoided.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+
+    const HRESULT hr = acquired ? device->Acquire() : device->Unacquire();
+    g_sSwitches.fetch_add(1, std::memory_order_relaxed);
+    if (tracked)
+        tracked->state.store(SUCCEEDED(hr) ? wanted : DeviceState::Unknown, std::memory_order_relaxed);
+}
+
+/**
+    @brief : Function that forget the state of a device that reported it lost its acquisition.
+**/
+static void CheckLost(IDirectInputDevice8* device, const HRESULT hr)
+{
+    if (hr != DIERR_NOTACQUIRED && hr != DIERR_INPUTLOST)
+        return;
+    if (TrackedDevice* tracked = FindDevice(device))
+        tracked->state.store(DeviceState::Unknown, std::memory_order_relaxed);
+}
 
 HRESULT __stdcall dinput::hook::DInput8DeviceGetDeviceStateHook(IDirectInputDevice8 *device, DWORD cbData, LPVOID lpvData)
 {
     HRESULT hr = g_sDInput8DeviceGetDeviceStateOriginal(device, cbData, lpvData);
+    if (!g_sGetDeviceStateSite.Enabled())
+    {
+        CheckLost(device, hr);
+        return hr;
+    }
+    yu::hook::Site::Scope scope(g_sGetDeviceStateSite);
+    D9PROF_ZONE("dinput.GetDeviceState");
+
+    if (cbData != sizeof(DIMOUSESTATE) && cbData != sizeof(DIMOUSESTATE2))
+        return hr;
 
-	if (d9::WantsMouse())
-	{
-		if (cbData == sizeof(DIMOUSESTATE) || cbData == sizeof(DIMOUSESTATE2))
-			device->Unacquire();
-	}
-    else {
-        if (cbData == sizeof(DIMOUSESTATE) || cbData == sizeof(DIMOUSESTATE2))
-			device->Acquire();
+    g_sCalls.fetch_add(1, std::memory_order_relaxed);
+    CheckLost(device, hr);
+
+    if (g_sMode.load(std::memory_order_relaxed) == Mode::Filter)
+    {
+        // The device stays acquired; the game sees a still mouse while the overlay has it
+        SetAcquired(device, true);
+        if (d9::WantsMouse() && SUCCEEDED(hr) && lpvData)
+        {
+            memset(lpvData, 0, cbData);
+            g_sFiltered.fetch_add(1, std::memory_order_relaxed);
+        }
+        return hr;
     }
 
+    SetAcquired(device, !d9::WantsMouse());
 	return hr;
 }
 
 HRESULT __stdcall dinput::hook::DInput8DeviceGetDeviceDataHook(IDirectInputDevice8 *device, DWORD cbData, LPDIDEVICEOBJECTDATA rgdod, LPDWORD pdwInOut, DWORD flags)
 {
     HRESULT hr = g_sDInput8DeviceGetDeviceDataOriginal(device, cbData, rgdod, pdwInOut, flags);
+    if (!g_sGetDeviceDataSite.Enabled())
+    {
+        CheckLost(device, hr);
+        return hr;
+    }
+    yu::hook::Site::Scope scope(g_sGetDeviceDataSite);
+    D9PROF_ZONE("dinput.GetDeviceData");
 
-	if (d9::WantsMouse())
-		device->Unacquire();
-    else
-        device->Acquire();
+    g_sCalls.fetch_add(1, std::memory_order_relaxed);
+    CheckLost(device, hr);
+
+    if (g_sMode.load(std::memory_order_relaxed) == Mode::Filter)
+    {
+        // Buffered events are read (so they do not pile up) and dropped
+        SetAcquired(device, true);
+        if (d9::WantsMouse() && SUCCEEDED(hr) && rgdod && pdwInOut)
+        {
+            *pdwInOut = 0;
+            g_sFiltered.fetch_add(1, std::memory_order_relaxed);
+        }
+        return hr;
+    }
 
+    SetAcquired(device, !d9::WantsMouse());
 	return hr;
 }
 
 HRESULT __stdcall dinput::hook::DInput8DeviceAcquireHook(IDirectInputDevice8 *device)
 {
-    if (d9::WantsMouse())
-		return DI_OK;
+    if (g_sAcquireSite.Enabled())
+    {
+        yu::hook::Site::Scope scope(g_sAcquireSite);
+        D9PROF_ZONE("dinput.Acquire");
+        if (d9::WantsMouse() && g_sMode.load(std::memory_order_relaxed) == Mode::Acquisition)
+            return DI_OK;
+    }
+
+	const HRESULT hr = g_sDInput8DeviceAcquireOriginal(device);
+    if (SUCCEEDED(hr))
+    {
+        if (TrackedDevice* tracked = FindDevice(device))
+            tracked->state.store(DeviceState::Acquired, std::memory_order_relaxed);
+    }
+    return hr;
+}
+
+void dinput::SetMode(const Mode mode)
+{
+    g_sMode.store(mode, std::memory_order_relaxed);
+}
 
-	return g_sDInput8DeviceAcquireOriginal(device);
+dinput::Mode dinput::GetMode()
+{
+    return g_sMode.load(std::memory_order_relaxed);
+}
+
+dinput::Stats dinput::GetStats()
+{
+    Stats stats;
+    stats.calls = g_sCalls.load(std::memory_order_relaxed);
+    stats.switches = g_sSwitches.load(std::memory_order_relaxed);
+    stats.avoided = g_sAvoided.load(std::memory_order_relaxed);
+    stats.filtered = g_sFiltered.load(std::memory_order_relaxed);
+    return stats;
+}
+
+/**
+    @brief : Function that add this frame's call counts to the d9prof counters (called from hkEndScene).
+**/
+void dinput::PublishCounters()
+{
+    const Stats stats = GetStats();
+    d9prof::SetCounter("dinput.calls", static_cast<double>(stats.calls - g_sPublished.calls));
+    d9prof::SetCounter("dinput.switches", static_cast<double>(stats.switches - g_sPublished.switches));
+    d9prof::SetCounter("dinput.avoided", static_cast<double>(stats.avoided - g_sPublished.avoided));
+    g_sPublished = stats;
+}
+
+
+bool dinput::CaptureVTable()
+{
+    if (!g_sVTableCaptured)
+        g_sVTableCaptured = GetVTable(g_sVTable);
+    return g_sVTableCaptured;
+}
+
+/**
+    @brief : Function that point the device sites at the captured vtable.
+    @retval : The sites to attach, empty if no vtable was captured.
+**/
+std::span<yu::hook::Site* const> dinput::PrepareHooks()
+{
+    if (!CaptureVTable())
+    {
+        //Console::error("Failed to get d8input device table");
+        return {};
+    }
+
+    void** vtable = g_sVTable;
+    if (!g_sDInput8DeviceAcquireOriginal && !g_sDInput8DeviceGetDeviceDataOriginal && !g_sDInput8DeviceGetDeviceStateOriginal)
+    {
+        g_sDInput8DeviceGetDeviceStateOriginal = (DInput8DeviceGetDeviceStateT*)vtable[9];
+        g_sDInput8DeviceGetDeviceDataOriginal = (DInput8DeviceGetDeviceDataT*)vtable[10];
+        g_sDInput8DeviceAcquireOriginal = (DInput8DeviceAcquireT*)vtable[7];
+    }
+    return g_sSites;
 }
 
 void dinput::InitHook()
 {
-    void* vtable[32];
-    if (GetVTable(vtable))
+    const std::span<yu::hook::Site* const> sites = PrepareHooks();
+    if (sites.empty())
+        return;
+
+    DetourTransactionBegin();
+    DetourUpdateThread(GetCurrentThread());
+    for (yu::hook::Site* site : sites)
     {
-        if (!g_sDInput8DeviceAcquireOriginal && !g_sDInput8DeviceGetDeviceDataOriginal && !g_sDInput8DeviceGetDeviceStateOriginal)
-        {
-            g_sDInput8DeviceGetDeviceStateOriginal = (DInput8DeviceGetDeviceStateT*)vtable[9];
-            g_sDInput8DeviceGetDeviceDataOriginal = (DInput8DeviceGetDeviceDataT*)vtable[10];
-            g_sDInput8DeviceAcquireOriginal = (DInput8DeviceAcquireT*)vtable[7];
-            DetourTransactionBegin();
-	        DetourUpdateThread(GetCurrentThread());
-            DetourAttach(&(PVOID&)g_sDInput8DeviceGetDeviceStateOriginal,hook::DInput8DeviceGetDeviceStateHook);
-            DetourAttach(&(PVOID&)g_sDInput8DeviceGetDeviceDataOriginal,hook::DInput8DeviceGetDeviceDataHook);
-            DetourAttach(&(PVOID&)g_sDInput8DeviceAcquireOriginal,hook::DInput8DeviceAcquireHook);
-            DetourTransactionCommit();
-        }
+        if (!site->Attached())
+            DetourAttach(site->Original(), site->Detour());
     }
-    else {
-        //Console::error("Failed to get d8input device table");
+    if (DetourTransactionCommit() == NO_ERROR)
+    {
+        for (yu::hook::Site* site : sites)
+            site->SetAttached(true);
     }
 }
 
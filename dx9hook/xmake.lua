@@ -4,6 +4,7 @@ target("dx9hook")
     add_files("src/*.cpp")
     add_includedirs("inc", {public = true})
     add_packages("imgui", "microsoft-detours")
+    add_deps("yu")
     if is_plat("windows") then
         add_syslinks("dinput8","d3d9", "dxguid", "ws2_32", "mswsock", "advapi32", "shell32", "user32", "gdi32")
     end
@@ -0,0 +1,127 @@
+/**
+ * @file bench_concurrent.cpp
+ * @brief Microbenchmarks for yu/concurrent.h
+ *
+ * Cross-thread cases run the producer and consumer as harness threads; their
+ * ns/op is the time per value handed over.
+ */
+
+#include <yu/bench.h>
+#include <yu/concurrent.h>
+
+#include <cstdint>
+#include <memory>
+
+namespace {
+
+using yu::concurrent::CpuRelax;
+
+struct Sample {
+    std::uint32_t version;
+    std::uint32_t payload[15];
+};
+
+using Ring = yu::concurrent::SpscRing<std::uint32_t, 1024>;
+using Queue = yu::concurrent::MpscQueue<std::uint32_t, 1024>;
+
+} // anonymous namespace
+
+int main(int argc, char** argv) {
+    auto ring = std::make_unique<Ring>();
+    auto queue = std::make_unique<Queue>();
+    auto seqlock = std::make_unique<yu::concurrent::SeqLock<Sample>>();
+    auto triple = std::make_unique<yu::concurrent::TripleBuffer<Sample>>();
+
+    yu::bench::Register("SpscRing push+pop, one thread", [&](yu::bench::State& state) {
+        std::uint32_t value = 0;
+        for (auto _ : state) {
+            ring->TryPush(value);
+            ring->TryPop(value);
+        }
+        yu::bench::DoNotOptimize(value);
+    });
+
+    yu::bench::Register("SpscRing handover", [&](yu::bench::State& state) {
+        std::uint32_t value = 0;
+        if (state.Thread() == 0) {
+            for (auto _ : state) {
+                while (!ring->TryPush(value)) CpuRelax();
+                ++value;
+            }
+        } else {
+            for (auto _ : state) {
+                while (!ring->TryPop(value)) CpuRelax();
+            }
+        }
+        yu::bench::DoNotOptimize(value);
+    }).Threads({2});
+
+    // Thread 0 consumes what all the other (producer) threads push
+    yu::bench::Register("MpscQueue handover", [&](yu::bench::State& state) {
+        std::uint32_t value = 0;
+        if (state.Thread() == 0) {
+            const int producers = state.Threads() - 1;
+            for (auto _ : state) {
+                for (int p = 0; p < producers; ++p) {
+                    while (!queue->TryPop(value)) CpuRelax();
+                }
+            }
+        } else {
+            for (auto _ : state) {
+                while (!queue->TryPush(value)) CpuRelax();
+                ++value;
+            }
+        }
+        yu::bench::DoNotOptimize(value);
+    }).Threads({2, 3, 5});
+
+    yu::bench::Register("SeqLock publish 64 bytes", [&](yu::bench::State& state) {
+        Sample sample{};
+        for (auto _ : state) {
+            ++sample.version;
+            seqlock->Publish(sample);
+        }
+    });
+
+    yu::bench::Register("SeqLock read", [&](yu::bench::State& state) {
+        Sample sample{};
+        for (auto _ : state) {
+            seqlock->Read(sample);
+            yu::bench::DoNotOptimize(sample);
+        }
+    });
+
+    // Thread 0 publishes while thread 1 reads
+    yu::bench::Register("SeqLock read, writer publishing", [&](yu::bench::State& state) {
+        Sample sample{};
+        for (auto _ : state) {
+            if (state.Thread() == 0) {
+                ++sample.version;
+                seqlock->Publish(sample);
+            } else {
+                seqlock->Read(sample);
+                yu::bench::DoNotOptimize(sample);
+            }
+        }
+    }).Threads({2});
+
+    yu::bench::Register("TripleBuffer publish", [&](yu::bench::State& state) {
+        std::uint32_t version = 0;
+        for (auto _ : state) {
+            triple->Back().version = ++version;
+            triple->Publish();
+        }
+    });
+
+    yu::bench::Register("TripleBuffer publish+fetch, one thread", [&](yu::bench::State& state) {
+        std::uint32_t version = 0;
+        for (auto _ : state) {
+            triple->Back().version = ++version;
+            triple->Publish();
+            triple->Fetch();
+            yu::bench::DoNotOptimize(triple->Front());
+        }
+    });
+
+    return yu::bench::Main(argc, argv);
+}
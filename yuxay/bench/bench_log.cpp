@@ -0,0 +1,64 @@
+/**
+ * @file bench_log.cpp
+ * @brief Logger throughput, synchronous and asynchronous
+ *
+ * Console output is turned off; file cases write to bench_log.txt.
+ */
+
+#include <yu/bench.h>
+#include <yu/log.h>
+
+#include <cstdint>
+#include <cstdio>
+
+namespace {
+
+yu::Logger& Log() { return yu::Logger::Instance(); }
+
+} // anonymous namespace
+
+int main(int argc, char** argv) {
+    Log().SetConsoleOutput(false);
+    Log().SetMinLevel(yu::LogLevel::Info);
+
+    yu::bench::Register("Logger::Log below min level", [](yu::bench::State& state) {
+        for (auto _ : state) Log().Log(yu::LogLevel::Debug, "filtered out");
+    });
+
+    yu::bench::Register("Logger::Log sync, no output", [](yu::bench::State& state) {
+        for (auto _ : state) Log().Log(yu::LogLevel::Info, "frame finished");
+    });
+
+    yu::bench::Register("Logger::Log sync, file", [](yu::bench::State& state) {
+        for (auto _ : state) Log().Log(yu::LogLevel::Info, "frame finished");
+    }).Setup([] { (void)Log().SetLogFile("bench_log.txt"); });
+
+    // Entries dropped on a full ring make enqueue look cheaper; the count is printed at the end
+    const auto restartAsync = [] {
+        Log().DisableAsync();
+        yu::AsyncLogConfig config;
+        config.capacity = 1 << 16;
+        config.flushPolicy = yu::LogFlushPolicy::Manual;
+        Log().EnableAsync(config);
+    };
+
+    yu::bench::Register("Logger::Log async enqueue, file", [](yu::bench::State& state) {
+        for (auto _ : state) Log().Log(yu::LogLevel::Info, "frame finished");
+    }).Setup(restartAsync).Threads({1, 4});
+
+    yu::bench::Register("YU_LOG_INFO async, two arguments", [](yu::bench::State& state) {
+        std::uint64_t frame = 0;
+        for (auto _ : state) {
+            YU_LOG_INFO("frame {} took {} ms", frame, 16.6);
+            ++frame;
+        }
+    }).Setup(restartAsync);
+
+    const int result = yu::bench::Main(argc, argv);
+    if (Log().GetDroppedCount() != 0) {
+        std::printf("async ring dropped %zu entries\n", Log().GetDroppedCount());
+    }
+    Log().DisableAsync();
+    Log().CloseLogFile();
+    return result;
+}
@@ -0,0 +1,98 @@
+/**
+ * @file bench_memory.cpp
+ * @brief LightweightTracker hot path under 1 to 8 threads
+ */
+
+#include <yu/bench.h>
+#include <yu/memory.h>
+
+#include <cstdint>
+
+namespace {
+
+using yu::mem::LightweightTracker;
+
+/// Fake addresses: 16-byte aligned and unique per thread, like real heap blocks
+void* Address(int thread, std::uint64_t index) noexcept {
+    const std::uintptr_t base = (static_cast<std::uintptr_t>(thread) + 1) << 24;
+    return reinterpret_cast<void*>(base + ((index & 0xFFFFF) << 4));
+}
+
+} // anonymous namespace
+
+int main(int argc, char** argv) {
+    LightweightTracker& tracker = LightweightTracker::Instance();
+
+    yu::bench::Register("tracker record+free", [&](yu::bench::State& state) {
+        std::uint64_t i = 0;
+        for (auto _ : state) {
+            void* ptr = Address(state.Thread(), i++);
+            tracker.RecordAllocation(ptr, 64, LightweightTracker::Tags::General);
+            tracker.RecordDeallocation(ptr);
+        }
+    }).Threads({1, 2, 4, 8});
+
+    // 256 blocks alive per thread, so lookups probe a populated table
+    yu::bench::Register("tracker record+free, 256 live", [&](yu::bench::State& state) {
+        constexpr std::uint64_t Live = 256;
+        for (std::uint64_t i = 0; i < Live; ++i) {
+            tracker.RecordAllocation(Address(state.Thread(), i), 64, LightweightTracker::Tags::General);
+        }
+        std::uint64_t i = Live;
+        for (auto _ : state) {
+            tracker.RecordAllocation(Address(state.Thread(), i), 64, LightweightTracker::Tags::General);
+            tracker.RecordDeallocation(Address(state.Thread(), i - Live));
+            ++i;
+        }
+        for (std::uint64_t j = i - Live; j < i; ++j) tracker.RecordDeallocation(Address(state.Thread(), j));
+    }).Threads({1, 2, 4, 8});
+
+    yu::bench::Register("tracker free of untracked pointer", [&](yu::bench::State& state) {
+        std::uint64_t i = 0;
+        for (auto _ : state) tracker.RecordDeallocation(Address(state.Thread() + 16, i++));
+    }).Threads({1, 8});
+
+    // The realloc hook before RecordReallocation, against the in-place and moving paths
+    yu::bench::Register("tracker realloc as free+record", [&](yu::bench::State& state) {
+        void* ptr = Address(state.Thread(), 0);
+        tracker.RecordAllocation(ptr, 64, LightweightTracker::Tags::General);
+        std::uint32_t size = 64;
+        for (auto _ : state) {
+            size ^= 64 ^ 96;
+            tracker.RecordDeallocation(ptr);
+            tracker.RecordAllocation(ptr, size, LightweightTracker::Tags::General);
+        }
+        tracker.RecordDeallocation(ptr);
+    }).Threads({1, 4});
+
+    yu::bench::Register("tracker realloc in place", [&](yu::bench::State& state) {
+        void* ptr = Address(state.Thread(), 0);
+        tracker.RecordAllocation(ptr, 64, LightweightTracker::Tags::General);
+        std::uint32_t size = 64;
+        for (auto _ : state) {
+            size ^= 64 ^ 96;
+            tracker.RecordReallocation(ptr, ptr, size);
+        }
+        tracker.RecordDeallocation(ptr);
+    }).Threads({1, 4});
+
+    yu::bench::Register("tracker realloc moved", [&](yu::bench::State& state) {
+        std::uint64_t i = 0;
+        tracker.RecordAllocation(Address(state.Thread(), i), 64, LightweightTracker::Tags::General);
+        for (auto _ : state) {
+            tracker.RecordReallocation(Address(state.Thread(), i), Address(state.Thread(), i + 1), 64);
+            ++i;
+        }
+        tracker.RecordDeallocation(Address(state.Thread(), i));
+    }).Threads({1, 4});
+
+    yu::bench::Register("yu::mem::Allocate+Free 64 bytes", [](yu::bench::State& state) {
+        for (auto _ : state) {
+            void* ptr = yu::mem::Allocate(64, yu::mem::Tags::General);
+            yu::bench::DoNotOptimize(ptr);
+            yu::mem::Free(ptr);
+        }
+    }).Threads({1, 4});
+
+    return yu::bench::Main(argc, argv);
+}
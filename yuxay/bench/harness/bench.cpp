@@ -0,0 +1,228 @@
+/**
+ * @file bench.cpp
+ * @brief Timing loop, allocation counting and output of the bench harness
+ */
+
+#include "yu/bench.h"
+
+#include <yu/alloc_count.h>
+#include <yu/io.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <deque>
+#include <format>
+#include <string_view>
+#include <thread>
+
+namespace yu {
+namespace bench {
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+/// Iterations after which a case is reported even if it ran faster than the minimum time
+constexpr std::uint64_t MaxIterations = 1ull << 34;
+
+using testing::AllocationCount;
+
+std::deque<Case>& Cases() {
+    static std::deque<Case> cases;  // Stable references for Register's callers
+    return cases;
+}
+
+struct Measurement {
+    Clock::duration elapsed{};
+    AllocationCount allocations;
+    std::uint64_t items{1};
+};
+
+Measurement Measure(const Case& benchCase, std::uint64_t iterations, int threads) {
+    if (benchCase.SetupFunction()) {
+        benchCase.SetupFunction()();
+    }
+
+    Measurement measurement;
+    if (threads <= 1) {
+        State state(iterations, 0, 1);
+        const AllocationCount before = testing::GlobalAllocations();
+        const auto start = Clock::now();
+        benchCase.Body()(state);
+        measurement.elapsed = Clock::now() - start;
+        const AllocationCount after = testing::GlobalAllocations();
+        measurement.allocations = {after.count - before.count, after.bytes - before.bytes};
+        measurement.items = state.ItemsPerIteration();
+        return measurement;
+    }
+
+    // Threads wait at a spinning barrier so they start together
+    std::atomic<int> ready{0};
+    std::atomic<bool> go{false};
+    std::atomic<int> running{threads};
+    std::vector<State> states;
+    states.reserve(threads);
+    for (int t = 0; t < threads; ++t) states.emplace_back(iterations, t, threads);
+
+    std::vector<std::thread> workers;
+    workers.reserve(threads);
+    for (int t = 0; t < threads; ++t) {
+        workers.emplace_back([&, t] {
+            ready.fetch_add(1, std::memory_order_acq_rel);
+            while (!go.load(std::memory_order_acquire)) std::this_thread::yield();
+            benchCase.Body()(states[t]);
+            running.fetch_sub(1, std::memory_order_acq_rel);
+        });
+    }
+    while (ready.load(std::memory_order_acquire) < threads) std::this_thread::yield();
+
+    const AllocationCount before = testing::GlobalAllocations();
+    const auto start = Clock::now();
+    go.store(true, std::memory_order_release);
+    while (running.load(std::memory_order_acquire) > 0) std::this_thread::yield();
+    measurement.elapsed = Clock::now() - start;
+    const AllocationCount after = testing::GlobalAllocations();
+
+    for (std::thread& worker : workers) worker.join();
+    measurement.allocations = {after.count - before.count, after.bytes - before.bytes};
+    measurement.items = states[0].ItemsPerIteration();
+    return measurement;
+}
+
+void AppendJsonString(std::string& out, std::string_view text) {
+    out += '"';
+    for (const char c : text) {
+        switch (c) {
+            case '"':  out += "\\\""; break;
+            case '\\': out += "\\\\"; break;
+            case '\n': out += "\\n"; break;
+            case '\t': out += "\\t"; break;
+            default:
+                if (static_cast<unsigned char>(c) < 0x20) out += std::format("\\u{:04x}", c);
+                else out += c;
+        }
+    }
+    out += '"';
+}
+
+std::string ToJson(const std::vector<Result>& results, std::string_view label) {
+    std::string out = "{\n  \"label\": ";
+    AppendJsonString(out, label);
+    out += ",\n  \"results\": [";
+    for (std::size_t i = 0; i < results.size(); ++i) {
+        const Result& r = results[i];
+        out += i == 0 ? "\n    {" : ",\n    {";
+        out += "\"name\": ";
+        AppendJsonString(out, r.name);
+        out += std::format(", \"threads\": {}, \"iterations\": {}, \"ns_per_op\": {:.3f}, \"ops_per_second\": {:.0f}, "
+                           "\"allocs_per_op\": {:.4f}, \"bytes_per_op\": {:.2f}}}",
+                           r.threads, r.iterations, r.nsPerOp, r.opsPerSecond, r.allocsPerOp, r.bytesPerOp);
+    }
+    out += "\n  ]\n}\n";
+    return out;
+}
+
+void PrintResult(const Result& r) {
+    std::printf("%-48s %3d %12llu %12.2f %14.0f %10.3f %10.1f\n", r.name.c_str(), r.threads,
+                static_cast<unsigned long long>(r.iterations), r.nsPerOp, r.opsPerSecond, r.allocsPerOp,
+                r.bytesPerOp);
+    std::fflush(stdout);
+}
+
+} // anonymous namespace
+
+// ============================================================================
+// Registration and Running
+// ============================================================================
+
+Case& Register(std::string name, Function body) {
+    return Cases().emplace_back(std::move(name), std::move(body));
+}
+
+std::vector<Result> Run(const Case& benchCase, double minTimeMs) {
+    std::vector<Result> results;
+    const auto minTime = std::chrono::duration<double, std::milli>(minTimeMs);
+
+    for (const int threads : benchCase.ThreadCounts()) {
+        std::uint64_t iterations = 1;
+        Measurement measurement;
+        for (;;) {
+            measurement = Measure(benchCase, iterations, threads);
+            if (measurement.elapsed >= minTime || iterations >= MaxIterations) break;
+
+            // Aim 20% past the minimum, growing at most 100x per step
+            const double elapsedMs = std::max(
+                std::chrono::duration<double, std::milli>(measurement.elapsed).count(), 1e-6);
+            const double scale = std::clamp(minTimeMs * 1.2 / elapsedMs, 2.0, 100.0);
+            iterations = std::min(MaxIterations, static_cast<std::uint64_t>(static_cast<double>(iterations) * scale));
+        }
+
+        const double ops = static_cast<double>(iterations) * static_cast<double>(measurement.items);
+        const double totalOps = ops * threads;
+        const double ns = std::chrono::duration<double, std::nano>(measurement.elapsed).count();
+
+        Result result;
+        result.name = benchCase.Name();
+        result.threads = threads;
+        result.iterations = iterations;
+        result.nsPerOp = ns / ops;
+        result.opsPerSecond = ns > 0 ? totalOps * 1e9 / ns : 0;
+        result.allocsPerOp = static_cast<double>(measurement.allocations.count) / totalOps;
+        result.bytesPerOp = static_cast<double>(measurement.allocations.bytes) / totalOps;
+        results.push_back(std::move(result));
+    }
+    return results;
+}
+
+int Main(int argc, char** argv) {
+    std::string_view filter;
+    std::string_view jsonPath;
+    std::string_view label;
+    double minTimeMs = 200.0;
+
+    for (int i = 1; i < argc; ++i) {
+        const std::string_view arg = argv[i];
+        const bool hasValue = i + 1 < argc;
+        if (arg == "--filter" && hasValue) {
+            filter = argv[++i];
+        } else if (arg == "--json" && hasValue) {
+            jsonPath = argv[++i];
+        } else if (arg == "--label" && hasValue) {
+            label = argv[++i];
+        } else if (arg == "--min-time" && hasValue) {
+            minTimeMs = std::atof(argv[++i]);
+        } else {
+            std::fprintf(stderr, "usage: %s [--filter <text>] [--min-time <ms>] [--json <path>] [--label <text>]\n",
+                         argv[0]);
+            return 1;
+        }
+    }
+
+    testing::InstallCountingAllocator();
+
+    std::printf("%-48s %3s %12s %12s %14s %10s %10s\n", "case", "thr", "iterations", "ns/op", "ops/s",
+                "allocs/op", "bytes/op");
+    std::vector<Result> all;
+    for (const Case& benchCase : Cases()) {
+        if (!filter.empty() && benchCase.Name().find(filter) == std::string::npos) continue;
+        for (Result& result : Run(benchCase, minTimeMs)) {
+            PrintResult(result);
+            all.push_back(std::move(result));
+        }
+    }
+
+    if (!jsonPath.empty()) {
+        const auto written = io::WriteString(std::string(jsonPath), ToJson(all, label));
+        if (!written) {
+            std::fprintf(stderr, "could not write %.*s\n", static_cast<int>(jsonPath.size()), jsonPath.data());
+            return 1;
+        }
+    }
+    return 0;
+}
+
+} // namespace bench
+} // namespace yu
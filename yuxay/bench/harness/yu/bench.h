@@ -0,0 +1,174 @@
+/**
+ * @file bench.h
+ * @brief Microbenchmark harness for the yu and abyss bench targets
+ *
+ * Every bench target registers its cases in main() and hands over to
+ * yu::bench::Main, which times each case, counts heap allocations and prints
+ * a table (or writes JSON with --json, to compare runs across commits).
+ *
+ * ```cpp
+ * int main(int argc, char** argv) {
+ *     yu::bench::Register("Array::Add", [](yu::bench::State& state) {
+ *         for (auto _ : state) { ... }
+ *     });
+ *     return yu::bench::Main(argc, argv);
+ * }
+ * ```
+ *
+ * A case runs with a growing iteration count until one run lasts at least
+ * the minimum time, and that run is reported. With Threads({...}) the body
+ * runs on that many threads at once (same iteration count each), released
+ * together; ns/op is then the wall time per iteration of one thread.
+ *
+ * Allocations are counted process-wide while a case runs, with the
+ * counters of yu.testing (yu/alloc_count.h): every global operator new and
+ * every yu::mem allocation.
+ *
+ * Options: --filter <text>, --min-time <ms>, --json <path>, --label <text>.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <initializer_list>
+#include <string>
+#include <utility>
+#include <vector>
+
+#if defined(_MSC_VER) && !defined(__clang__)
+    #include <intrin.h>
+#endif
+
+namespace yu {
+namespace bench {
+
+// ============================================================================
+// State
+// ============================================================================
+
+/// Handed to a case body; iterate over it to run the timed loop
+class State {
+public:
+    /// What `for (auto _ : state)` binds: the user-provided destructor
+    /// keeps -Wunused-variable quiet about the unused loop variable
+    struct Value {
+        ~Value() noexcept {}
+    };
+
+    struct Iterator {
+        std::uint64_t remaining;
+
+        bool operator!=(const Iterator&) const noexcept { return remaining != 0; }
+        void operator++() noexcept { --remaining; }
+        Value operator*() const noexcept { return {}; }
+    };
+
+    State(std::uint64_t iterations, int thread, int threads) noexcept
+        : m_iterations(iterations), m_thread(thread), m_threads(threads) {}
+
+    [[nodiscard]] Iterator begin() const noexcept { return {m_iterations}; }
+    [[nodiscard]] Iterator end() const noexcept { return {0}; }
+
+    /// Iterations this thread runs
+    [[nodiscard]] std::uint64_t Iterations() const noexcept { return m_iterations; }
+
+    /// Index of this thread, 0 to Threads() - 1
+    [[nodiscard]] int Thread() const noexcept { return m_thread; }
+    [[nodiscard]] int Threads() const noexcept { return m_threads; }
+
+    /// Count this many operations per iteration (ns/op divides by it)
+    void SetItemsPerIteration(std::uint64_t items) noexcept { m_items = items; }
+    [[nodiscard]] std::uint64_t ItemsPerIteration() const noexcept { return m_items; }
+
+private:
+    std::uint64_t m_iterations;
+    std::uint64_t m_items = 1;
+    int m_thread;
+    int m_threads;
+};
+
+using Function = std::function<void(State&)>;
+
+/// A registered case
+class Case {
+public:
+    Case(std::string name, Function body) : m_name(std::move(name)), m_body(std::move(body)) {}
+
+    /// Run once per thread count (default: one thread)
+    Case& Threads(std::initializer_list<int> counts) {
+        m_threads.assign(counts.begin(), counts.end());
+        return *this;
+    }
+
+    /// Run once before each timed run (single-threaded, not timed)
+    Case& Setup(std::function<void()> setup) {
+        m_setup = std::move(setup);
+        return *this;
+    }
+
+    [[nodiscard]] const std::string& Name() const noexcept { return m_name; }
+    [[nodiscard]] const Function& Body() const noexcept { return m_body; }
+    [[nodiscard]] const std::vector<int>& ThreadCounts() const noexcept { return m_threads; }
+    [[nodiscard]] const std::function<void()>& SetupFunction() const noexcept { return m_setup; }
+
+private:
+    std::string m_name;
+    Function m_body;
+    std::vector<int> m_threads{1};
+    std::function<void()> m_setup;
+};
+
+/// One measured case and thread count
+struct Result {
+    std::string   name;
+    int           threads{1};
+    std::uint64_t iterations{0};   ///< Per thread, of the reported run
+    double        nsPerOp{0};      ///< Wall time per operation of one thread
+    double        opsPerSecond{0}; ///< All threads together
+    double        allocsPerOp{0};
+    double        bytesPerOp{0};
+};
+
+// ============================================================================
+// Registration and Running
+// ============================================================================
+
+/// Add a case to the suite run by Main
+Case& Register(std::string name, Function body);
+
+/// Run the registered cases
+/// @return 0, or 1 for bad arguments or an unwritable JSON file
+int Main(int argc, char** argv);
+
+/// Run one case outside Main (used by Main; handy from a debugger)
+std::vector<Result> Run(const Case& benchCase, double minTimeMs);
+
+// ============================================================================
+// Optimizer Barriers
+// ============================================================================
+
+/// Make the compiler assume value is read
+template<typename T>
+inline void DoNotOptimize(const T& value) noexcept {
+#if defined(_MSC_VER) && !defined(__clang__)
+    static const void* volatile sink;
+    sink = &value;
+    _ReadWriteBarrier();
+#else
+    asm volatile("" : : "r,m"(value) : "memory");
+#endif
+}
+
+/// Make the compiler assume all memory is read and written
+inline void ClobberMemory() noexcept {
+#if defined(_MSC_VER) && !defined(__clang__)
+    _ReadWriteBarrier();
+#else
+    asm volatile("" : : : "memory");
+#endif
+}
+
+} // namespace bench
+} // namespace yu
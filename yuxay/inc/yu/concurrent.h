@@ -0,0 +1,322 @@
+/**
+ * @file concurrent.h
+ * @brief Bounded queues and snapshot primitives for handing data between threads
+ *
+ * Header-only building blocks for passing data out of hooks (where a lock
+ * could stall the game thread) to our own threads and back:
+ *
+ * - SpscRing: one producer, one consumer, wait-free on both sides
+ * - MpscQueue: any number of producers, one consumer
+ * - SeqLock: one writer publishes a trivially copyable value, readers never block it
+ * - TripleBuffer: one writer, one reader, each always owns a whole buffer
+ *
+ * All of them have a fixed capacity chosen at compile time and never
+ * allocate. Indices written by different threads sit on separate cache
+ * lines so producers and consumers do not false-share.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <thread>
+#include <type_traits>
+#include <utility>
+
+#if defined(_M_IX86) || defined(_M_X64) || defined(__i386__) || defined(__x86_64__)
+    #include <immintrin.h>
+#endif
+
+namespace yu {
+namespace concurrent {
+
+/// Destructive interference size assumed for padding
+constexpr std::size_t CacheLineSize = 64;
+
+/// Hint to the CPU that the caller is spinning
+inline void CpuRelax() noexcept {
+#if defined(_M_IX86) || defined(_M_X64) || defined(__i386__) || defined(__x86_64__)
+    _mm_pause();
+#else
+    std::this_thread::yield();
+#endif
+}
+
+// ============================================================================
+// SpscRing
+// ============================================================================
+
+/// Bounded single-producer / single-consumer ring
+///
+/// Each side keeps a cached copy of the other side's index and only reloads
+/// it when the ring looks full (producer) or empty (consumer), so the shared
+/// cache lines move only when they have to.
+template<typename T, std::size_t Capacity>
+class SpscRing {
+    static_assert(Capacity >= 2 && (Capacity & (Capacity - 1)) == 0, "Capacity must be a power of two");
+    static_assert(std::is_default_constructible_v<T>, "SpscRing stores default-constructed slots");
+
+public:
+    static constexpr std::size_t Mask = Capacity - 1;
+
+    /// Producer: append a value
+    /// @return false if the ring is full
+    template<typename U>
+    bool TryPush(U&& value) noexcept(std::is_nothrow_assignable_v<T&, U&&>) {
+        const std::size_t head = m_head.load(std::memory_order_relaxed);
+        if (head - m_cachedTail >= Capacity) {
+            m_cachedTail = m_tail.load(std::memory_order_acquire);
+            if (head - m_cachedTail >= Capacity) return false;
+        }
+        m_items[head & Mask] = std::forward<U>(value);
+        m_head.store(head + 1, std::memory_order_release);
+        return true;
+    }
+
+    /// Consumer: take the oldest value
+    /// @return false if the ring is empty
+    bool TryPop(T& out) noexcept(std::is_nothrow_move_assignable_v<T>) {
+        const std::size_t tail = m_tail.load(std::memory_order_relaxed);
+        if (tail == m_cachedHead) {
+            m_cachedHead = m_head.load(std::memory_order_acquire);
+            if (tail == m_cachedHead) return false;
+        }
+        out = std::move(m_items[tail & Mask]);
+        m_tail.store(tail + 1, std::memory_order_release);
+        return true;
+    }
+
+    /// Values queued; exact only from the producer or consumer thread
+    [[nodiscard]] std::size_t Size() const noexcept {
+        return m_head.load(std::memory_order_acquire) - m_tail.load(std::memory_order_acquire);
+    }
+
+    [[nodiscard]] bool Empty() const noexcept { return Size() == 0; }
+
+private:
+    // Producer line
+    alignas(CacheLineSize) std::atomic<std::size_t> m_head{0};
+    std::size_t m_cachedTail = 0;
+
+    // Consumer line
+    alignas(CacheLineSize) std::atomic<std::size_t> m_tail{0};
+    std::size_t m_cachedHead = 0;
+
+    alignas(CacheLineSize) T m_items[Capacity];
+};
+
+// ============================================================================
+// MpscQueue
+// ============================================================================
+
+/// Bounded multi-producer / single-consumer queue (per-slot sequence numbers)
+///
+/// Producers claim a slot with one compare-exchange and publish it with a
+/// release store of the slot's sequence. A full queue fails the push instead
+/// of waiting. A producer preempted between claiming and publishing holds the
+/// consumer back at that slot until it resumes; it never blocks other producers.
+template<typename T, std::size_t Capacity>
+class MpscQueue {
+    static_assert(Capacity >= 2 && (Capacity & (Capacity - 1)) == 0, "Capacity must be a power of two");
+    static_assert(std::is_default_constructible_v<T>, "MpscQueue stores default-constructed slots");
+
+public:
+    static constexpr std::size_t Mask = Capacity - 1;
+
+    MpscQueue() noexcept {
+        for (std::size_t i = 0; i < Capacity; ++i) {
+            m_cells[i].sequence.store(i, std::memory_order_relaxed);
+        }
+    }
+
+    MpscQueue(const MpscQueue&) = delete;
+    MpscQueue& operator=(const MpscQueue&) = delete;
+
+    /// Any thread: append a value
+    /// @return false if the queue is full
+    template<typename U>
+    bool TryPush(U&& value) noexcept(std::is_nothrow_assignable_v<T&, U&&>) {
+        std::size_t position = m_enqueue.load(std::memory_order_relaxed);
+        Cell* cell;
+        for (;;) {
+            cell = &m_cells[position & Mask];
+            const std::size_t sequence = cell->sequence.load(std::memory_order_acquire);
+            const auto diff = static_cast<std::ptrdiff_t>(sequence - position);
+            if (diff == 0) {
+                if (m_enqueue.compare_exchange_weak(position, position + 1, std::memory_order_relaxed)) break;
+            } else if (diff < 0) {
+                return false;  // Slot still holds a value from one lap ago
+            } else {
+                position = m_enqueue.load(std::memory_order_relaxed);
+            }
+        }
+        cell->value = std::forward<U>(value);
+        cell->sequence.store(position + 1, std::memory_order_release);
+        return true;
+    }
+
+    /// Consumer: take the oldest published value
+    /// @return false if the queue is empty (or its oldest slot is still being written)
+    bool TryPop(T& out) noexcept(std::is_nothrow_move_assignable_v<T>) {
+        const std::size_t position = m_dequeue.load(std::memory_order_relaxed);
+        Cell& cell = m_cells[position & Mask];
+        if (cell.sequence.load(std::memory_order_acquire) != position + 1) return false;
+        out = std::move(cell.value);
+        cell.sequence.store(position + Capacity, std::memory_order_release);
+        m_dequeue.store(position + 1, std::memory_order_relaxed);
+        return true;
+    }
+
+    /// Approximate number of queued values
+    [[nodiscard]] std::size_t Size() const noexcept {
+        const std::size_t enqueue = m_enqueue.load(std::memory_order_acquire);
+        const std::size_t dequeue = m_dequeue.load(std::memory_order_acquire);
+        return enqueue - dequeue <= Capacity ? enqueue - dequeue : 0;
+    }
+
+    [[nodiscard]] bool Empty() const noexcept { return Size() == 0; }
+
+private:
+    struct Cell {
+        std::atomic<std::size_t> sequence;
+        T value{};
+    };
+
+    alignas(CacheLineSize) std::atomic<std::size_t> m_enqueue{0};  // Producers
+    alignas(CacheLineSize) std::atomic<std::size_t> m_dequeue{0};  // Consumer (atomic for Size)
+    alignas(CacheLineSize) Cell m_cells[Capacity];
+};
+
+// ============================================================================
+// SeqLock
+// ============================================================================
+
+/// Latest value published by one writer, read by any thread without a lock
+///
+/// Publish() stores the value between two increments of a sequence number;
+/// Read() retries while the sequence is odd or changed during its copy. A
+/// reader therefore never sees a half-written value and the writer never
+/// waits. The value is copied through relaxed atomic words, so readers racing
+/// the writer are well-defined (and clean under ThreadSanitizer).
+template<typename T>
+class alignas(CacheLineSize) SeqLock {
+    static_assert(std::is_trivially_copyable_v<T>, "SeqLock copies the value bytewise");
+
+public:
+    /// Writer: replace the value (one writer at a time)
+    void Publish(const T& value) noexcept {
+        Word words[WordCount] = {};
+        std::memcpy(words, &value, sizeof(T));
+
+        const std::uint32_t sequence = m_sequence.load(std::memory_order_relaxed);
+        m_sequence.store(sequence + 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+        for (std::size_t i = 0; i < WordCount; ++i) {
+            m_words[i].store(words[i], std::memory_order_relaxed);
+        }
+        m_sequence.store(sequence + 2, std::memory_order_release);
+    }
+
+    /// Copy the latest value
+    /// @return false until the first Publish
+    bool Read(T& out) const noexcept {
+        Word words[WordCount];
+        for (;;) {
+            const std::uint32_t before = m_sequence.load(std::memory_order_acquire);
+            if (before == 0) return false;
+            if (before & 1) {
+                CpuRelax();
+                continue;
+            }
+            for (std::size_t i = 0; i < WordCount; ++i) {
+                words[i] = m_words[i].load(std::memory_order_relaxed);
+            }
+            std::atomic_thread_fence(std::memory_order_acquire);
+            if (m_sequence.load(std::memory_order_relaxed) == before) break;
+        }
+        std::memcpy(&out, words, sizeof(T));
+        return true;
+    }
+
+    /// Publishes so far
+    [[nodiscard]] std::uint32_t Version() const noexcept {
+        return m_sequence.load(std::memory_order_acquire) / 2;
+    }
+
+private:
+    using Word = std::uint32_t;
+    static constexpr std::size_t WordCount = (sizeof(T) + sizeof(Word) - 1) / sizeof(Word);
+
+    std::atomic<std::uint32_t> m_sequence{0};
+    std::atomic<Word> m_words[WordCount] = {};
+};
+
+// ============================================================================
+// TripleBuffer
+// ============================================================================
+
+/// One writer and one reader exchanging whole values without copying or waiting
+///
+/// The writer fills its back buffer and publishes it by swapping it with the
+/// shared middle buffer; the reader swaps the middle buffer with its front
+/// buffer when a new one was published. Neither side ever touches the other
+/// side's buffer, and intermediate values the reader did not fetch are
+/// simply overwritten.
+template<typename T>
+class TripleBuffer {
+public:
+    TripleBuffer() = default;
+
+    /// Initialize all three buffers
+    explicit TripleBuffer(const T& initial) {
+        for (Slot& slot : m_slots) slot.value = initial;
+    }
+
+    TripleBuffer(const TripleBuffer&) = delete;
+    TripleBuffer& operator=(const TripleBuffer&) = delete;
+
+    /// Writer: the buffer to fill (holds an older value, not the last published one)
+    [[nodiscard]] T& Back() noexcept { return m_slots[m_back].value; }
+
+    /// Writer: hand the back buffer to the reader
+    void Publish() noexcept {
+        const std::uint8_t previous = m_middle.exchange(m_back | Fresh, std::memory_order_acq_rel);
+        m_back = previous & IndexMask;
+    }
+
+    /// Writer: copy a value into the back buffer and publish it
+    void Publish(const T& value) {
+        Back() = value;
+        Publish();
+    }
+
+    /// Reader: switch to the latest published buffer
+    /// @return false if nothing was published since the last call
+    bool Fetch() noexcept {
+        if ((m_middle.load(std::memory_order_relaxed) & Fresh) == 0) return false;
+        const std::uint8_t previous = m_middle.exchange(m_front, std::memory_order_acq_rel);
+        m_front = previous & IndexMask;
+        return true;
+    }
+
+    /// Reader: the buffer fetched last
+    [[nodiscard]] const T& Front() const noexcept { return m_slots[m_front].value; }
+
+private:
+    static constexpr std::uint8_t IndexMask = 0x3;
+    static constexpr std::uint8_t Fresh = 0x4;  // Middle buffer not fetched yet
+
+    struct alignas(CacheLineSize) Slot {
+        T value{};
+    };
+
+    Slot m_slots[3];
+    alignas(CacheLineSize) std::atomic<std::uint8_t> m_middle{1};
+    alignas(CacheLineSize) std::uint8_t m_back = 0;   // Writer only
+    alignas(CacheLineSize) std::uint8_t m_front = 2;  // Reader only
+};
+
+} // namespace concurrent
+} // namespace yu
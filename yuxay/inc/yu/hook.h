@@ -0,0 +1,156 @@
+/**
+ * @file hook.h
+ * @brief Runtime switch and call statistics for one detoured function
+ *
+ * A Site describes a detour: the pointer the patching library rewrites
+ * (a function pointer that becomes the trampoline), the function it jumps to
+ * and a name. yu does not patch anything itself; the dll's hook registry
+ * attaches sites in batched Detours transactions.
+ *
+ * Every detour checks its site first. Disabled, it calls straight through to
+ * the original, so a hook can be turned off and on without re-patching code:
+ *
+ * ```cpp
+ * void* malloc_hook(std::size_t size) {
+ *     if (!g_mallocSite.Enabled()) return original_malloc(size);
+ *     yu::hook::Site::Scope scope(g_mallocSite);
+ *     ...
+ * }
+ * ```
+ *
+ * Enabled() is one relaxed load. A Scope adds one relaxed increment, plus two
+ * clock reads when the site is timed (SetTimed), to the enabled path. The
+ * increment goes to the calling thread's shard (as in ShardedStats,
+ * memory_stats.h), so threads hammering malloc rarely share a cache line;
+ * GetStats() sums the shards.
+ */
+
+#pragma once
+
+#include "memory_stats.h"
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+
+namespace yu {
+namespace hook {
+
+// ============================================================================
+// Site
+// ============================================================================
+
+class Site {
+    using Clock = std::chrono::steady_clock;
+
+    /// Counter blocks per site (power of two); threads spread over them
+    static constexpr std::size_t CallShards = 16;
+
+    struct alignas(64) CallShard {
+        std::atomic<std::uint64_t> calls{0};
+        std::atomic<std::uint64_t> timedCalls{0};
+        std::atomic<std::uint64_t> nanoseconds{0};
+    };
+
+public:
+    /// Totals since the site was created (or ResetStats)
+    struct Stats {
+        std::uint64_t calls = 0;        ///< Enabled calls
+        std::uint64_t timedCalls = 0;   ///< Calls made while the site was timed
+        std::uint64_t nanoseconds = 0;  ///< Time inside those calls
+    };
+
+    /// Counts one call and, if the site is timed, its duration
+    class Scope {
+    public:
+        explicit Scope(Site& site) noexcept
+            : m_shard(site.m_shards[mem::detail::CurrentShard<CallShards>()]) {
+            m_shard.calls.fetch_add(1, std::memory_order_relaxed);
+            if (site.m_timed.load(std::memory_order_relaxed)) m_start = Clock::now();
+        }
+
+        ~Scope() {
+            if (m_start != Clock::time_point{}) {
+                const auto elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - m_start);
+                m_shard.timedCalls.fetch_add(1, std::memory_order_relaxed);
+                m_shard.nanoseconds.fetch_add(static_cast<std::uint64_t>(elapsed.count()), std::memory_order_relaxed);
+            }
+        }
+
+        Scope(const Scope&) = delete;
+        Scope& operator=(const Scope&) = delete;
+
+    private:
+        CallShard& m_shard;
+        Clock::time_point m_start{};
+    };
+
+    /// @param name     Stable string (a literal); "group.function" groups sites for SetEnabled by prefix
+    /// @param original Pointer rewritten to the trampoline when attached, e.g. &reinterpret_cast<void*&>(oEndScene)
+    /// @param detour   Function the target jumps to
+    /// @param pinned   Detour must always run (it keeps other state valid); SetEnabled(false) is refused
+    Site(const char* name, void** original, void* detour, bool pinned = false) noexcept
+        : m_name(name), m_original(original), m_detour(detour), m_pinned(pinned) {}
+
+    Site(const Site&) = delete;
+    Site& operator=(const Site&) = delete;
+
+    [[nodiscard]] const char* Name() const noexcept { return m_name; }
+    [[nodiscard]] void** Original() const noexcept { return m_original; }
+    [[nodiscard]] void* Detour() const noexcept { return m_detour; }
+    [[nodiscard]] bool Pinned() const noexcept { return m_pinned; }
+
+    /// Hot path: should the detour do its work
+    [[nodiscard]] bool Enabled() const noexcept { return m_enabled.load(std::memory_order_relaxed); }
+
+    /// @return false if the site is pinned and enabled was false
+    bool SetEnabled(bool enabled) noexcept {
+        if (!enabled && m_pinned) return false;
+        m_enabled.store(enabled, std::memory_order_relaxed);
+        return true;
+    }
+
+    /// Measure time spent in the detour (off by default: two clock reads per call)
+    void SetTimed(bool timed) noexcept { m_timed.store(timed, std::memory_order_relaxed); }
+    [[nodiscard]] bool Timed() const noexcept { return m_timed.load(std::memory_order_relaxed); }
+
+    /// Whether the code is currently patched; kept by whoever attaches and detaches the site
+    [[nodiscard]] bool Attached() const noexcept { return m_attached.load(std::memory_order_acquire); }
+    void SetAttached(bool attached) noexcept { m_attached.store(attached, std::memory_order_release); }
+
+    /// Sum of the shards; calls still in flight on other threads may be missing
+    [[nodiscard]] Stats GetStats() const noexcept {
+        Stats stats;
+        for (const CallShard& shard : m_shards) {
+            stats.calls += shard.calls.load(std::memory_order_relaxed);
+            stats.timedCalls += shard.timedCalls.load(std::memory_order_relaxed);
+            stats.nanoseconds += shard.nanoseconds.load(std::memory_order_relaxed);
+        }
+        return stats;
+    }
+
+    void ResetStats() noexcept {
+        for (CallShard& shard : m_shards) {
+            shard.calls.store(0, std::memory_order_relaxed);
+            shard.timedCalls.store(0, std::memory_order_relaxed);
+            shard.nanoseconds.store(0, std::memory_order_relaxed);
+        }
+    }
+
+private:
+    const char* m_name;
+    void** m_original;
+    void* m_detour;
+    bool m_pinned;
+
+    std::atomic<bool> m_enabled{true};
+    std::atomic<bool> m_timed{false};
+    std::atomic<bool> m_attached{false};
+
+    // Written by every hooked call: one line per thread shard
+    CallShard m_shards[CallShards];
+};
+
+} // namespace hook
+} // namespace yu
@@ -5,7 +5,7 @@
  * Features:
  * - Read/write bytes and strings to files
  * - Configurable base path for relative file operations
- * - Memory-mapped file support (optional)
+ * - Memory-mapped file support (see io_mapped.h)
  * - Cross-platform path handling
  * - Result types for error handling
  */
@@ -39,6 +39,7 @@ enum class IOError {
     InvalidPath,
     ReadError,
     WriteError,
+    TooLarge,
     Unknown
 };
 
@@ -53,10 +54,19 @@ enum class IOError {
         case IOError::InvalidPath:       return "Invalid path";
         case IOError::ReadError:         return "Read error";
         case IOError::WriteError:        return "Write error";
+        case IOError::TooLarge:          return "Too large for the address space";
         default:                         return "Unknown error";
     }
 }
 
+namespace detail {
+
+/// Map the calling thread's last OS error (GetLastError/errno) to an IOError
+/// @param fallback Returned for errors without a closer match
+[[nodiscard]] IOError LastOSError(IOError fallback = IOError::ReadError) noexcept;
+
+} // namespace detail
+
 // ============================================================================
 // Result Types (using C++23 std::expected)
 // ============================================================================
@@ -0,0 +1,128 @@
+/**
+ * @file io_async.h
+ * @brief Batched asynchronous file reads
+ *
+ * AsyncReader takes a batch of (path, offset, length) requests and reads
+ * them in the background, so the disk latency of many files overlaps
+ * instead of adding up one file at a time. On Windows the reads are
+ * overlapped I/O on an I/O completion port serviced by one thread; elsewhere
+ * a small thread pool issues pread calls.
+ *
+ * A request reads into a caller-provided buffer or into a buffer from the
+ * reader's pool. Give pooled buffers back with Recycle() once they have
+ * been consumed. Results come back as futures or through a callback.
+ *
+ * Each path is resolved once against the FileSystem base path. There is no
+ * separate existence check: a missing file fails at open time.
+ */
+
+#pragma once
+
+#include "io.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <functional>
+#include <future>
+#include <limits>
+#include <span>
+#include <vector>
+
+namespace yu {
+namespace io {
+
+// ============================================================================
+// Requests and Completions
+// ============================================================================
+
+/// One read of a batch
+struct ReadRequest {
+    /// Read until the end of the file
+    static constexpr std::size_t ToEnd = std::numeric_limits<std::size_t>::max();
+
+    std::filesystem::path   path;
+    std::uint64_t           offset{0};
+    std::size_t             length{ToEnd};
+
+    /// Destination; empty to read into a pooled buffer. The read is clamped
+    /// to its size, and it must stay alive until the request completes.
+    std::span<std::uint8_t> buffer{};
+};
+
+/// A finished read
+struct ReadCompletion {
+    /// Position of the request in its batch
+    std::size_t index{0};
+
+    /// The bytes read: inside the request's buffer, or inside pooled
+    /// (shorter than asked only at the end of the file)
+    std::span<const std::uint8_t> bytes{};
+
+    /// Owns the bytes when the request had no buffer; hand back with Recycle()
+    ByteBuffer pooled{};
+};
+
+using ReadResult = Result<ReadCompletion>;
+
+/// Called once per request with its position in the batch, which a failed
+/// result has no other way to tell. On Windows the calls come from the one
+/// completion thread in completion order; elsewhere from the pread workers,
+/// concurrently (up to workerThreads at once), so the callback must be
+/// thread-safe.
+using ReadCallback = std::function<void(std::size_t index, ReadResult&& result)>;
+
+/// Configuration for AsyncReader
+struct AsyncReadConfig {
+    /// Reads issued to the OS at once (each holds an open file)
+    std::size_t maxInFlight{32};
+
+    /// Worker threads of the pread fallback (unused on Windows)
+    std::size_t workerThreads{4};
+
+    /// Recycled buffers kept for reuse
+    std::size_t maxPooledBuffers{16};
+};
+
+// ============================================================================
+// AsyncReader
+// ============================================================================
+
+class AsyncReader {
+public:
+    explicit AsyncReader(const AsyncReadConfig& config = {});
+
+    /// Cancel what is still queued or in flight (completed with IOError::ReadError)
+    /// and stop the I/O threads
+    ~AsyncReader();
+
+    AsyncReader(const AsyncReader&) = delete;
+    AsyncReader& operator=(const AsyncReader&) = delete;
+
+    /// Queue a batch; one future per request, in request order
+    [[nodiscard]] std::vector<std::future<ReadResult>> Submit(std::vector<ReadRequest> requests);
+
+    /// Queue a batch; callback is invoked once per request as it completes
+    /// (see ReadCallback for the threads it runs on)
+    void Submit(std::vector<ReadRequest> requests, ReadCallback callback);
+
+    /// Queue a batch and wait for all of it, results in request order
+    [[nodiscard]] std::vector<ReadResult> ReadAll(std::vector<ReadRequest> requests);
+
+    /// Return a pooled buffer for reuse by later requests
+    void Recycle(ByteBuffer buffer);
+
+    /// Requests queued or in flight
+    [[nodiscard]] std::size_t Pending() const noexcept;
+
+    /// Whether the reader's I/O threads started
+    [[nodiscard]] bool IsRunning() const noexcept { return m_state != nullptr; }
+
+private:
+    struct State;
+
+    State* m_state = nullptr;
+};
+
+} // namespace io
+} // namespace yu
@@ -0,0 +1,160 @@
+/**
+ * @file io_mapped.h
+ * @brief Read-only memory-mapped files
+ *
+ * MappedFile opens a file and maps it (CreateFileMapping/MapViewOfFile on
+ * Windows, mmap elsewhere) so its contents can be read in place as a
+ * std::span, without a stream and without a copy into a ByteBuffer.
+ *
+ * A file smaller than the address space can be viewed whole. A larger one
+ * (a game archive in a 32-bit process) is read through windows: each
+ * MappedView maps only [offset, offset + length) and unmaps it when it
+ * goes out of scope. Several views of the same file can be alive at once.
+ *
+ * Paths are resolved against the FileSystem base path, like ReadBytes.
+ */
+
+#pragma once
+
+#include "io.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <span>
+#include <utility>
+
+namespace yu {
+namespace io {
+
+// ============================================================================
+// Access Hints
+// ============================================================================
+
+/// How the mapped data will be read, passed on to the OS page cache
+enum class AccessHint {
+    Normal,     // No particular pattern
+    Sequential, // Front to back, once (read-ahead, pages dropped early)
+    Random      // Scattered lookups (no read-ahead)
+};
+
+// ============================================================================
+// MappedView
+// ============================================================================
+
+/// One mapped window of a file; unmapped on destruction
+class MappedView {
+public:
+    MappedView() noexcept = default;
+    ~MappedView() noexcept { Unmap(); }
+
+    MappedView(MappedView&& other) noexcept { *this = std::move(other); }
+    MappedView& operator=(MappedView&& other) noexcept;
+
+    MappedView(const MappedView&) = delete;
+    MappedView& operator=(const MappedView&) = delete;
+
+    /// The bytes of the window (empty for an empty window)
+    [[nodiscard]] std::span<const std::uint8_t> Data() const noexcept { return {m_data, m_size}; }
+
+    /// Position of the first byte of Data() in the file
+    [[nodiscard]] std::uint64_t Offset() const noexcept { return m_offset; }
+
+    [[nodiscard]] std::size_t Size() const noexcept { return m_size; }
+    [[nodiscard]] bool Empty() const noexcept { return m_size == 0; }
+
+    /// Release the mapping now (Data() becomes empty)
+    void Unmap() noexcept;
+
+private:
+    friend class MappedFile;
+
+    void*                m_base = nullptr; // Start of the OS mapping (aligned down)
+    std::size_t          m_mappedSize = 0; // Length of the OS mapping
+    const std::uint8_t*  m_data = nullptr;
+    std::size_t          m_size = 0;
+    std::uint64_t        m_offset = 0;
+};
+
+// ============================================================================
+// MappedFile
+// ============================================================================
+
+/// Read-only file opened for mapping
+class MappedFile {
+public:
+    /// Open a file for mapping
+    /// @param path File path (relative to base path or absolute)
+    /// @param hint Expected access pattern
+    /// @return The opened file, or IOError on failure
+    [[nodiscard]] static Result<MappedFile> Open(const std::filesystem::path& path,
+                                                 AccessHint hint = AccessHint::Normal);
+
+    /// Alignment of window offsets: a window starts on this boundary
+    /// internally, whatever offset is requested (64 KiB on Windows, a page elsewhere)
+    [[nodiscard]] static std::size_t WindowAlignment() noexcept;
+
+    MappedFile() noexcept = default;
+    ~MappedFile() noexcept { Close(); }
+
+    MappedFile(MappedFile&& other) noexcept { *this = std::move(other); }
+    MappedFile& operator=(MappedFile&& other) noexcept;
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    [[nodiscard]] bool IsOpen() const noexcept;
+
+    /// File size in bytes, as it was when the file was opened
+    [[nodiscard]] std::uint64_t Size() const noexcept { return m_size; }
+
+    [[nodiscard]] AccessHint Hint() const noexcept { return m_hint; }
+
+    /// The whole file, mapped on first use and kept until Close
+    /// @return The file's bytes, or IOError::TooLarge if the file does not fit
+    ///         in the address space (use MapWindow instead)
+    /// @note Not thread-safe on first use; MapWindow is.
+    [[nodiscard]] Result<std::span<const std::uint8_t>> View();
+
+    /// Map [offset, offset + length), clamped to the end of the file
+    /// @param offset Any byte offset up to Size()
+    /// @param length Bytes wanted
+    /// @return A view that keeps the window mapped, or IOError on failure
+    [[nodiscard]] Result<MappedView> MapWindow(std::uint64_t offset, std::size_t length) const;
+
+    /// Walk the file front to back through windows of windowSize bytes
+    /// @param windowSize Bytes per window, best a multiple of WindowAlignment()
+    ///        (0 uses WindowAlignment())
+    /// @param callback Called as callback(std::uint64_t offset, std::span<const std::uint8_t> bytes);
+    ///        returning false stops the walk
+    /// @return true if every window was mapped and visited
+    template<typename Callback>
+    Result<bool> ForEachWindow(std::size_t windowSize, Callback&& callback) const {
+        if (windowSize == 0) windowSize = WindowAlignment();
+        for (std::uint64_t offset = 0; offset < m_size; offset += windowSize) {
+            auto window = MapWindow(offset, windowSize);
+            if (!window) return std::unexpected(window.error());
+            if (!callback(offset, window->Data())) return false;
+        }
+        return true;
+    }
+
+    /// Unmap the whole-file view and close the file
+    /// Views returned by MapWindow stay valid: the OS keeps their mapping alive.
+    void Close() noexcept;
+
+private:
+#ifdef _WIN32
+    void*         m_file = nullptr;    // File HANDLE
+    void*         m_mapping = nullptr; // File mapping HANDLE (none for an empty file)
+#else
+    int           m_fd = -1;
+#endif
+    std::uint64_t m_size = 0;
+    AccessHint    m_hint = AccessHint::Normal;
+    MappedView    m_whole;
+    bool          m_wholeMapped = false;
+};
+
+} // namespace io
+} // namespace yu
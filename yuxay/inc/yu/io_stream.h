@@ -0,0 +1,181 @@
+/**
+ * @file io_stream.h
+ * @brief Buffered streaming file writer
+ *
+ * StreamWriter collects small writes (report lines, dump records, log
+ * entries) in a large page-aligned buffer and hands the file system whole
+ * buffers, so a dump of thousands of lines costs a few syscalls instead of
+ * thousands.
+ *
+ * With backgroundFlush, two buffers alternate: while one is filled, a
+ * flusher thread writes the other. Without it, full buffers are written on
+ * the calling thread, and nothing is ever heap-allocated: the buffers come
+ * from OS pages, so the path can be used next to the allocation hooks.
+ *
+ * Modes:
+ * - Truncate: create or replace the file
+ * - Append: write at the end of the file (log files)
+ * - Atomic: write to "<path>.tmp" and rename it over the path on Close,
+ *   so readers only ever see the old file or the complete new one
+ */
+
+#pragma once
+
+#include "io.h"
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <mutex>
+#include <span>
+#include <string_view>
+#include <thread>
+
+namespace yu {
+namespace io {
+
+// ============================================================================
+// Configuration
+// ============================================================================
+
+/// How StreamWriter opens its file
+enum class StreamMode {
+    Truncate,
+    Append,
+    Atomic
+};
+
+/// Configuration for StreamWriter::Open
+struct StreamWriterConfig {
+    /// Size of each buffer (rounded up to whole pages)
+    std::size_t bufferSize{256 * 1024};
+
+    /// Write full buffers on a flusher thread while the next one fills
+    bool backgroundFlush{false};
+
+    /// Bypass the OS file cache (FILE_FLAG_NO_BUFFERING / O_DIRECT).
+    /// Writes then go out in whole pages; ignored in Append mode.
+    bool unbuffered{false};
+
+    /// Return from each write only once it reached the disk
+    /// (FILE_FLAG_WRITE_THROUGH / O_DSYNC)
+    bool writeThrough{false};
+};
+
+// ============================================================================
+// StreamWriter
+// ============================================================================
+
+class StreamWriter {
+public:
+    StreamWriter() noexcept = default;
+
+    /// Close (and commit, in Atomic mode) if still open
+    ~StreamWriter() noexcept { (void)Close(); }
+
+    StreamWriter(const StreamWriter&) = delete;
+    StreamWriter& operator=(const StreamWriter&) = delete;
+
+    /// Open a file by its OS path, as given (no base path, no allocation
+    /// unless backgroundFlush starts a thread)
+    /// @param path UTF-8 on Windows (opened through the wide API)
+    [[nodiscard]] Result<bool> Open(const char* path, StreamMode mode = StreamMode::Truncate,
+                                    const StreamWriterConfig& config = {}) noexcept;
+
+#ifdef _WIN32
+    /// Open a file by its wide OS path, e.g. std::filesystem::path::c_str()
+    [[nodiscard]] Result<bool> Open(const wchar_t* path, StreamMode mode = StreamMode::Truncate,
+                                    const StreamWriterConfig& config = {}) noexcept;
+#endif
+
+    /// Open a file relative to the base path, creating parent directories
+    [[nodiscard]] Result<bool> Open(const std::filesystem::path& path, StreamMode mode = StreamMode::Truncate,
+                                    const StreamWriterConfig& config = {});
+
+    [[nodiscard]] bool IsOpen() const noexcept { return m_open; }
+
+    /// Append bytes; false once any write has failed
+    bool Write(const void* data, std::size_t size) noexcept;
+
+    bool Write(std::string_view text) noexcept { return Write(text.data(), text.size()); }
+    bool Write(std::span<const std::uint8_t> bytes) noexcept { return Write(bytes.data(), bytes.size()); }
+
+    bool Put(char c) noexcept {
+        if (m_used < m_capacity) {
+            m_current[m_used++] = static_cast<std::uint8_t>(c);
+            return true;
+        }
+        return Write(&c, 1);
+    }
+
+    /// Append text followed by a newline
+    bool WriteLine(std::string_view text) noexcept { return Write(text) && Put('\n'); }
+
+    /// Hand everything written so far to the OS and wait for it
+    /// @note In unbuffered mode the last partial page stays buffered until Close.
+    Result<bool> Flush() noexcept;
+
+    /// Flush and close; in Atomic mode rename the temporary file over the
+    /// target (or remove it if a write failed)
+    Result<bool> Close() noexcept;
+
+    /// Atomic mode: close and remove the temporary file, keeping the old one
+    void Discard() noexcept;
+
+    /// First write error, IOError::None while everything succeeded
+    [[nodiscard]] IOError GetError() const noexcept { return m_error.load(std::memory_order_acquire); }
+
+    /// Bytes accepted by Write so far
+    [[nodiscard]] std::uint64_t BytesWritten() const noexcept { return m_flushed + m_used; }
+
+private:
+#ifdef _WIN32
+    using PathChar = wchar_t;                // Paths stay wide: no ANSI code page round trip
+#else
+    using PathChar = char;
+#endif
+    static constexpr std::size_t MaxPath = 520;  // Path characters, terminator included
+
+    Result<bool> OpenNative(const PathChar* path, StreamMode mode, const StreamWriterConfig& config) noexcept;
+    /// Write a full (or final) buffer, on this thread or the flusher
+    void Submit(bool wait) noexcept;
+    /// Write len bytes of buf at the file position (returns false on error)
+    bool WriteOut(const std::uint8_t* buf, std::size_t len) noexcept;
+    void WaitIdle() noexcept;
+    void FlusherLoop() noexcept;
+    void Fail(IOError error) noexcept;
+    void Release() noexcept;
+
+    // File
+#ifdef _WIN32
+    void*         m_file = nullptr;          // HANDLE
+#else
+    int           m_fd = -1;
+#endif
+    StreamMode    m_mode = StreamMode::Truncate;
+    bool          m_open = false;
+    bool          m_unbuffered = false;
+    PathChar      m_path[MaxPath]{};             // Target path (Atomic mode)
+    std::atomic<IOError> m_error{IOError::None};
+
+    // Buffers (OS pages)
+    std::uint8_t* m_buffers[2]{};
+    std::uint8_t* m_current = nullptr;
+    std::size_t   m_capacity = 0;
+    std::size_t   m_used = 0;
+    std::uint64_t m_flushed = 0;             // Bytes handed off before m_current
+
+    // Flusher thread (backgroundFlush)
+    std::thread             m_flusher;
+    std::mutex              m_mutex;
+    std::condition_variable m_wake;
+    std::condition_variable m_idle;
+    const std::uint8_t*     m_pendingData = nullptr;
+    std::size_t             m_pendingSize = 0;
+    bool                    m_stopping = false;
+};
+
+} // namespace io
+} // namespace yu
@@ -0,0 +1,259 @@
+/**
+ * @file jobs.h
+ * @brief Work-stealing job system
+ *
+ * JobSystem runs small jobs on a fixed set of worker threads, so work done
+ * for a hook (snapshots, reports, scans, batch math) can leave the render
+ * thread without spawning a thread per task.
+ *
+ * - Jobs live in a ring of preallocated slots (OS pages): creating and
+ *   running a job never touches the heap. The callable is stored inline and
+ *   must fit in JobStorageSize bytes.
+ * - Each worker owns a Chase-Lev deque: it pushes and pops its own jobs at
+ *   the bottom, idle workers steal from the top. Threads that are not
+ *   workers submit through a shared queue.
+ * - A job created with a parent keeps the parent from finishing until the
+ *   child finishes; continuations run once their ancestor has finished.
+ * - Wait() does not block idle: the waiting thread executes jobs meanwhile.
+ *
+ * When every slot is in use or a queue is full, the submitting thread runs
+ * queued jobs until there is room. Only when the system is not running does
+ * a job run at once on the calling thread, so submitting never fails. Jobs
+ * created but not yet run hold their slot: keep fewer than maxJobs of them.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <mutex>
+#include <new>
+#include <span>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace yu {
+namespace jobs {
+
+// ============================================================================
+// Handles and Configuration
+// ============================================================================
+
+/// Bytes available for a job's callable (captures included)
+constexpr std::size_t JobStorageSize = 48;
+
+/// Continuations one job can hold
+constexpr std::uint32_t MaxContinuations = 4;
+
+/// Reference to a job; stale once the job finished and its slot was reused
+struct JobHandle {
+    static constexpr std::uint32_t InvalidIndex = std::numeric_limits<std::uint32_t>::max();
+
+    std::uint32_t index{InvalidIndex};
+    std::uint32_t generation{0};
+
+    /// An invalid handle stands for a job that already ran (the system was not running)
+    [[nodiscard]] bool Valid() const noexcept { return index != InvalidIndex; }
+};
+
+/// Configuration for JobSystem::Start
+struct JobSystemConfig {
+    /// Worker threads; 0 for one less than the hardware threads (at least 1)
+    std::uint32_t workerThreads{0};
+
+    /// Jobs alive at once (rounded up to a power of two)
+    std::uint32_t maxJobs{4096};
+
+    /// Capacity of each worker deque and of the shared queue (rounded up to a power of two)
+    std::uint32_t queueCapacity{1024};
+};
+
+/// Counters since Start
+struct JobStats {
+    std::uint64_t executed{0};
+    std::uint64_t stolen{0};   ///< Executed by a thread that took them from another worker
+    std::uint64_t inlined{0};  ///< Run at once because the system was not running
+};
+
+namespace detail {
+
+using JobFunction = void (*)(void* storage) noexcept;
+
+template<typename Fn>
+void InvokeJob(void* storage) noexcept {
+    Fn& fn = *static_cast<Fn*>(storage);
+    fn();
+    fn.~Fn();
+}
+
+template<typename Fn>
+void DestroyJob(void* storage) noexcept {
+    static_cast<Fn*>(storage)->~Fn();
+}
+
+struct Job;
+struct WorkDeque;
+struct SharedQueue;
+
+} // namespace detail
+
+// ============================================================================
+// JobSystem
+// ============================================================================
+
+class JobSystem {
+public:
+    /// Process-wide instance (started by the application)
+    static JobSystem& Instance() noexcept;
+
+    JobSystem() noexcept = default;
+    ~JobSystem() noexcept { Stop(); }
+
+    JobSystem(const JobSystem&) = delete;
+    JobSystem& operator=(const JobSystem&) = delete;
+
+    /// Allocate the slot ring and queues and start the workers
+    /// @return false if already running or out of memory
+    bool Start(const JobSystemConfig& config = {});
+
+    /// Finish every queued job, then stop the workers and free the slots.
+    /// Jobs created but never run are destroyed without running.
+    void Stop() noexcept;
+
+    [[nodiscard]] bool IsRunning() const noexcept { return m_running.load(std::memory_order_acquire); }
+    [[nodiscard]] std::uint32_t WorkerCount() const noexcept { return m_workerCount; }
+
+    /// Store a job without running it (see Run and AddContinuation)
+    /// @param fn Callable taking no arguments; noexcept in practice (an exception terminates)
+    /// @param parent Job that will not finish before this one
+    /// @return Handle, invalid if the job already ran because the system is not running
+    template<typename F>
+    JobHandle Create(F&& fn, JobHandle parent = {});
+
+    /// Queue a created job
+    void Run(JobHandle job) noexcept;
+
+    /// Create and run
+    template<typename F>
+    JobHandle Schedule(F&& fn, JobHandle parent = {}) {
+        JobHandle job = Create(std::forward<F>(fn), parent);
+        Run(job);
+        return job;
+    }
+
+    /// Run continuation (created, not yet run) once ancestor has finished
+    /// @return false if ancestor already holds MaxContinuations; then nothing was changed
+    bool AddContinuation(JobHandle ancestor, JobHandle continuation) noexcept;
+
+    /// Execute jobs until job has finished
+    void Wait(JobHandle job) noexcept;
+
+    [[nodiscard]] bool IsDone(JobHandle job) const noexcept;
+
+    /// Call fn(chunk) for consecutive chunks of items across the workers and wait for all of them
+    /// @param grain Items per chunk; 0 for about four chunks per worker
+    template<typename T, typename F>
+    void ParallelFor(std::span<T> items, std::size_t grain, F&& fn);
+
+    [[nodiscard]] JobStats GetStats() const noexcept;
+
+private:
+    /// Claim a slot, running queued jobs while none is free; storage is null when the job has to run inline
+    JobHandle Allocate(detail::JobFunction invoke, detail::JobFunction destroy, JobHandle parent,
+                       void** storage) noexcept;
+    void JoinParent(JobHandle parent, detail::Job& child) noexcept;
+    void Execute(std::uint32_t index) noexcept;
+    void Finish(std::uint32_t index) noexcept;
+    bool Push(std::uint32_t index) noexcept;
+    bool TryExecuteOne() noexcept;
+    bool TakeJob(int worker, std::uint32_t& index) noexcept;
+    void WorkerLoop(int worker) noexcept;
+    void Release() noexcept;
+
+    // Slots
+    detail::Job*             m_jobs = nullptr;
+    std::uint32_t            m_jobMask = 0;
+    std::atomic<std::uint32_t> m_nextJob{0};
+
+    // Queues
+    detail::WorkDeque*       m_deques = nullptr;
+    detail::SharedQueue*     m_shared = nullptr;
+    std::uint32_t            m_queueCapacity = 0;
+    std::size_t              m_pageBytes = 0;
+
+    // Workers
+    std::vector<std::thread> m_threads;
+    std::uint32_t            m_workerCount = 0;
+    std::atomic<bool>        m_running{false};
+    std::atomic<bool>        m_stopping{false};
+
+    // Sleeping: workers wait for m_queued > 0
+    std::atomic<std::uint32_t> m_queued{0};
+    std::atomic<std::uint32_t> m_sleepers{0};
+    std::mutex               m_sleepMutex;
+    std::condition_variable  m_wake;
+
+    // Stats
+    std::atomic<std::uint64_t> m_executed{0};
+    std::atomic<std::uint64_t> m_stolen{0};
+    std::atomic<std::uint64_t> m_inlined{0};
+};
+
+// ============================================================================
+// Template Implementation
+// ============================================================================
+
+template<typename F>
+JobHandle JobSystem::Create(F&& fn, JobHandle parent) {
+    using Fn = std::decay_t<F>;
+    static_assert(sizeof(Fn) <= JobStorageSize, "Job captures exceed JobStorageSize; capture a pointer instead");
+    static_assert(alignof(Fn) <= alignof(std::max_align_t), "Over-aligned job callable");
+
+    void* storage = nullptr;
+    const JobHandle job = Allocate(&detail::InvokeJob<Fn>, &detail::DestroyJob<Fn>, parent, &storage);
+    if (!storage) {
+        m_inlined.fetch_add(1, std::memory_order_relaxed);
+        fn();
+        return {};
+    }
+    ::new (storage) Fn(std::forward<F>(fn));
+    return job;
+}
+
+template<typename T, typename F>
+void JobSystem::ParallelFor(std::span<T> items, std::size_t grain, F&& fn) {
+    if (items.empty()) {
+        return;
+    }
+    if (grain == 0) {
+        grain = std::max<std::size_t>(1, items.size() / (std::max<std::size_t>(1, m_workerCount) * 4));
+    }
+    if (!IsRunning() || items.size() <= grain) {
+        fn(items);
+        return;
+    }
+
+    // Children keep the empty root from finishing until every chunk is done
+    const JobHandle root = Create([] {});
+    if (!root.Valid()) {
+        fn(items);
+        return;
+    }
+
+    auto* body = &fn;
+    for (std::size_t offset = 0; offset < items.size(); offset += grain) {
+        const std::span<T> chunk = items.subspan(offset, std::min(grain, items.size() - offset));
+        Run(Create([body, chunk] { (*body)(chunk); }, root));
+    }
+    Run(root);
+    Wait(root);
+}
+
+} // namespace jobs
+} // namespace yu
@@ -8,6 +8,10 @@
  * - Thread-safe logging
  * - Format string support using std::format
  * - Source location tracking (C++20/23)
+ * - Optional asynchronous mode: callers format into a lock-free ring and a
+ *   background thread does the I/O
+ * - Optional binary mode on top of it: YU_LOG_* calls only store a call-site
+ *   id, a TSC timestamp and raw arguments (see log_binary.h, yu-logdecode)
  */
 
 #pragma once
@@ -20,8 +24,13 @@
 #include <mutex>
 #include <chrono>
 #include <print>
+#include <atomic>
+#include <cstddef>
 #include <cstdint>
 
+#include "io_stream.h"
+#include "log_binary.h"
+
 namespace yu {
 
 /// Log severity levels
@@ -44,6 +53,73 @@ enum class LogLevel : std::uint8_t {
     }
 }
 
+/// When the asynchronous writer flushes the console and file
+enum class LogFlushPolicy : std::uint8_t {
+    EveryBatch = 0,  // After each drained batch (closest to synchronous behaviour)
+    Interval   = 1,  // Every flushIntervalMs, or at once for entries >= flushLevel
+    Manual     = 2   // Only on Logger::Flush() and shutdown
+};
+
+/// Configuration for Logger::EnableAsync
+struct AsyncLogConfig {
+    /// Number of ring slots (rounded up to a power of two); entries are dropped when full
+    std::size_t capacity{1024};
+    
+    LogFlushPolicy flushPolicy{LogFlushPolicy::Interval};
+    std::uint32_t  flushIntervalMs{250};
+    LogLevel       flushLevel{LogLevel::Warning};
+    
+    /// Writer sleep when the ring is empty
+    std::uint32_t  idleSleepMs{2};
+};
+
+/// Compile-time description of one YU_LOG_* call site
+/// Every macro expansion owns a static constexpr LogSite, so the id costs
+/// nothing at run time and binary records only need to carry the id.
+struct LogSite {
+    LogLevel             level;
+    const char*          format;
+    std::source_location location;
+    std::uint32_t        id;
+
+    consteval LogSite(LogLevel lvl, const char* fmt, std::source_location loc) noexcept
+        : level(lvl), format(fmt), location(loc), id(MakeId(fmt, loc)) {}
+
+private:
+    static consteval std::uint32_t MakeId(const char* fmt, std::source_location loc) noexcept {
+        std::uint32_t hash = binlog::Fnv1a(loc.file_name());
+        const std::uint32_t line = loc.line();
+        for (int i = 0; i < 4; ++i) {
+            hash ^= (line >> (i * 8)) & 0xFF;
+            hash *= 16777619u;
+        }
+        return binlog::Fnv1a(fmt, hash);
+    }
+};
+
+namespace detail {
+
+/// One entry in the asynchronous log ring (one per cache-line group)
+struct alignas(64) LogSlot {
+    static constexpr std::size_t Size = 256;
+    static constexpr std::size_t HeaderSize = 40;
+    static constexpr std::size_t TextCapacity = Size - HeaderSize;
+    
+    std::atomic<std::size_t> sequence{0};  // Publication state, see Logger::ClaimSlot
+    std::uint32_t            line{0};
+    std::uint16_t            length{0};
+    LogLevel                 level{LogLevel::Debug};
+    bool                     truncated{false};
+    std::int64_t             timestamp{0};  // system_clock ticks, or TSC for binary entries
+    const char*              file{nullptr};  // From std::source_location (static storage)
+    const LogSite*           site{nullptr};  // Set for binary entries: text holds encoded arguments
+    char                     text[TextCapacity];
+};
+
+static_assert(sizeof(LogSlot) == LogSlot::Size, "LogSlot header no longer fits in HeaderSize");
+
+} // namespace detail
+
 /// Logger configuration and state
 class Logger {
 public:
@@ -83,18 +159,102 @@ public:
     void CloseLogFile();
     
     /// Check if file logging is active
-    [[nodiscard]] bool IsFileLogging() const noexcept { return m_fileStream.is_open(); }
+    [[nodiscard]] bool IsFileLogging() const noexcept { return m_fileWriter.IsOpen(); }
+
+    /// Switch to asynchronous output
+    /// Log calls then only copy the entry into a preallocated ring; a writer
+    /// thread formats and writes batches. Calls never block and never allocate:
+    /// if the ring is full the entry is dropped and counted.
+    /// @param config Ring size and flush policy (capacity is fixed by the first call)
+    /// @return true if the writer thread is running
+    bool EnableAsync(const AsyncLogConfig& config = {});
+    
+    /// Drain the ring, stop the writer thread and return to synchronous output
+    void DisableAsync();
+    
+    /// Check if asynchronous output is active
+    [[nodiscard]] bool IsAsync() const noexcept { return m_asyncEnabled.load(std::memory_order_relaxed); }
+    
+    /// Get number of entries dropped because the ring was full
+    [[nodiscard]] std::size_t GetDroppedCount() const noexcept { return m_dropped.load(std::memory_order_relaxed); }
+    
+    /// Write out everything logged so far and flush the console and file
+    void Flush();
+    
+    /// Set the binary log file (empty path returns to text output)
+    /// While set and asynchronous mode is active, YU_LOG_* calls are stored
+    /// as binary records in this file instead of text; decode them with the
+    /// yu-logdecode tool. Plain Log() messages still go to the text outputs.
+    /// @param filepath Path to the .bin file (truncated)
+    /// @return true if the file was opened
+    bool SetBinaryLogFile(std::string_view filepath);
+    
+    /// Check if YU_LOG_* calls are currently written as binary records
+    [[nodiscard]] bool IsBinaryLogging() const noexcept {
+        return m_binaryEnabled.load(std::memory_order_relaxed) && m_asyncEnabled.load(std::memory_order_relaxed);
+    }
 
     /// Core logging function
     void Log(LogLevel level, std::string_view message, 
              const std::source_location& loc = std::source_location::current());
 
+    /// Format and log in one step (used by the YU_LOG_* macros)
+    /// In asynchronous mode the message is formatted straight into a ring slot
+    /// (truncated to detail::LogSlot::TextCapacity), so nothing is allocated.
+    template<typename... Args>
+    void Write(LogLevel level, const std::source_location& loc,
+               std::format_string<Args...> fmt, Args&&... args) {
+        if (level < m_minLevel) return;
+        if (AsyncProducer producer(*this); producer) {
+            detail::LogSlot* slot = ClaimSlot();
+            if (!slot) return;  // Ring full: dropped
+            try {
+                auto result = std::format_to_n(slot->text, detail::LogSlot::TextCapacity,
+                                               fmt, std::forward<Args>(args)...);
+                slot->length = static_cast<std::uint16_t>(
+                    result.size < static_cast<std::ptrdiff_t>(detail::LogSlot::TextCapacity)
+                        ? result.size : static_cast<std::ptrdiff_t>(detail::LogSlot::TextCapacity));
+                slot->truncated = result.size > static_cast<std::ptrdiff_t>(detail::LogSlot::TextCapacity);
+            } catch (...) {
+                // A throwing formatter must not leave the slot unpublished
+                slot->length = 0;
+                slot->truncated = true;
+            }
+            PublishSlot(slot, level, loc);
+            return;
+        }
+        Log(level, std::format(fmt, std::forward<Args>(args)...), loc);
+    }
+
+    /// Log from a YU_LOG_* call site
+    /// In binary mode only the site id, a TSC timestamp and the raw arguments
+    /// are stored; otherwise this is the same as the source_location overload.
+    template<typename... Args>
+    void Write(const LogSite& site, std::format_string<Args...> fmt, Args&&... args) {
+        if (site.level < m_minLevel) return;
+        if (m_binaryEnabled.load(std::memory_order_relaxed)) {
+            AsyncProducer producer(*this);
+            if (!producer) {
+                Write(site.level, site.location, fmt, std::forward<Args>(args)...);
+                return;
+            }
+            detail::LogSlot* slot = ClaimSlot();
+            if (!slot) return;  // Ring full: dropped
+            binlog::ArgEncoder encoder(slot->text, detail::LogSlot::TextCapacity);
+            (encoder.Put(args), ...);
+            slot->length = static_cast<std::uint16_t>(encoder.Size());
+            slot->truncated = encoder.Truncated();
+            PublishBinarySlot(slot, site);
+            return;
+        }
+        Write(site.level, site.location, fmt, std::forward<Args>(args)...);
+    }
+
     /// Formatted logging with variadic arguments
     template<typename... Args>
     void LogFmt(LogLevel level, std::format_string<Args...> fmt, Args&&... args,
                 const std::source_location& loc = std::source_location::current()) {
-        if (level < m_minLevel) return;
-        Log(level, std::format(fmt, std::forward<Args>(args)...), loc);
+        Write(level, loc, fmt, std::forward<Args>(args)...);
     }
 
     // Prevent copying
@@ -102,18 +262,85 @@ public:
     Logger& operator=(const Logger&) = delete;
 
 private:
+    struct AsyncState;
+
+    /// Marks a thread writing into the ring, so DisableAsync can wait for it
+    /// before the final drain (and the destructor before freeing the ring)
+    class AsyncProducer {
+    public:
+        explicit AsyncProducer(Logger& logger) noexcept : m_logger(logger) {
+            if (!logger.m_asyncEnabled.load(std::memory_order_relaxed)) return;
+            // Counted before the flag is checked again; pairs with the exchange in DisableAsync
+            logger.m_asyncProducers.fetch_add(1, std::memory_order_seq_cst);
+            m_counted = true;
+            m_active = logger.m_asyncEnabled.load(std::memory_order_seq_cst);
+        }
+        ~AsyncProducer() {
+            if (m_counted) m_logger.m_asyncProducers.fetch_sub(1, std::memory_order_release);
+        }
+        AsyncProducer(const AsyncProducer&) = delete;
+        AsyncProducer& operator=(const AsyncProducer&) = delete;
+
+        explicit operator bool() const noexcept { return m_active; }
+
+    private:
+        Logger& m_logger;
+        bool    m_counted{false};
+        bool    m_active{false};
+    };
+
     Logger() = default;
     ~Logger();
 
     [[nodiscard]] std::string FormatTimestamp() const;
+    [[nodiscard]] static std::string FormatTimestamp(std::chrono::system_clock::time_point time);
     [[nodiscard]] std::string FormatLogEntry(LogLevel level, std::string_view message,
                                               const std::source_location& loc) const;
+    [[nodiscard]] static std::string FormatLogEntry(LogLevel level, std::string_view message,
+                                                     std::chrono::system_clock::time_point time,
+                                                     std::string_view file, std::uint32_t line);
+
+    /// Write a formatted entry to the console and file (caller holds m_mutex)
+    void WriteEntry(LogLevel level, std::string_view entry);
+
+    /// Open m_logPath for appending (caller holds m_mutex)
+    bool OpenLogFile();
+
+    /// Report a failed file write on the console and reopen the file once (caller holds m_mutex)
+    void CheckLogFile();
+
+    /// Reserve the next ring slot, or nullptr (and count a drop) if the ring is full
+    [[nodiscard]] detail::LogSlot* ClaimSlot() noexcept;
+    
+    /// Stamp and hand a filled slot to the writer thread
+    void PublishSlot(detail::LogSlot* slot, LogLevel level, const std::source_location& loc) noexcept;
+    void PublishBinarySlot(detail::LogSlot* slot, const LogSite& site) noexcept;
+
+    /// Writer thread body
+    void WriterLoop();
+    
+    /// Drain every published slot into the console/file under m_mutex, returns entries written
+    std::size_t DrainRing(bool& flushNow);
 
     LogLevel      m_minLevel{LogLevel::Debug};
     bool          m_consoleOutput{true};
     bool          m_colorOutput{true};
-    std::ofstream m_fileStream;
+    io::StreamWriter m_fileWriter;   // Append mode, buffered; flushed per entry (sync) or per policy (async)
+    std::filesystem::path m_logPath; // Reopened once after a write error
+    bool          m_logReopened{false};
     std::mutex    m_mutex;
+
+    // Asynchronous mode (allocated by the first EnableAsync, kept until exit)
+    AsyncState*              m_async{nullptr};
+    std::atomic<bool>        m_asyncEnabled{false};
+    std::atomic<std::uint32_t> m_asyncProducers{0};    // Threads between the flag check and the publish
+    std::atomic<std::size_t> m_dropped{0};
+
+    // Binary mode (stream written by the async writer thread, opened and closed under m_mutex)
+    std::ofstream              m_binaryStream;
+    std::atomic<bool>          m_binaryEnabled{false};
+    std::atomic<std::uint32_t> m_binaryGeneration{0};  // Bumped per file, resets the emitted-site set
+    double                     m_tscPerSecond{0.0};
 };
 
 // ============================================================================
@@ -148,25 +375,28 @@ inline void LogError(std::string_view message,
 // Formatted logging macros (captures source location correctly)
 // ============================================================================
 
+/// Log at a level through a static call-site descriptor (shared by the macros below)
+#define YU_LOG_AT(level, fmt, ...) \
+    do { \
+        static constexpr ::yu::LogSite yu_log_site_{level, fmt, std::source_location::current()}; \
+        ::yu::Logger::Instance().Write(yu_log_site_, fmt __VA_OPT__(,) __VA_ARGS__); \
+    } while (0)
+
 /// Log formatted debug message
 #define YU_LOG_DEBUG(fmt, ...) \
-    ::yu::Logger::Instance().Log(::yu::LogLevel::Debug, \
-        std::format(fmt __VA_OPT__(,) __VA_ARGS__), std::source_location::current())
+    YU_LOG_AT(::yu::LogLevel::Debug, fmt __VA_OPT__(,) __VA_ARGS__)
 
 /// Log formatted info message
 #define YU_LOG_INFO(fmt, ...) \
-    ::yu::Logger::Instance().Log(::yu::LogLevel::Info, \
-        std::format(fmt __VA_OPT__(,) __VA_ARGS__), std::source_location::current())
+    YU_LOG_AT(::yu::LogLevel::Info, fmt __VA_OPT__(,) __VA_ARGS__)
 
 /// Log formatted warning message
 #define YU_LOG_WARN(fmt, ...) \
-    ::yu::Logger::Instance().Log(::yu::LogLevel::Warning, \
-        std::format(fmt __VA_OPT__(,) __VA_ARGS__), std::source_location::current())
+    YU_LOG_AT(::yu::LogLevel::Warning, fmt __VA_OPT__(,) __VA_ARGS__)
 
 /// Log formatted error message
 #define YU_LOG_ERROR(fmt, ...) \
-    ::yu::Logger::Instance().Log(::yu::LogLevel::Error, \
-        std::format(fmt __VA_OPT__(,) __VA_ARGS__), std::source_location::current())
+    YU_LOG_AT(::yu::LogLevel::Error, fmt __VA_OPT__(,) __VA_ARGS__)
 
 // ============================================================================
 // Global configuration helpers
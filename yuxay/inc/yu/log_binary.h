@@ -0,0 +1,181 @@
+/**
+ * @file log_binary.h
+ * @brief Structured binary log format shared by yu::Logger and yu-logdecode
+ *
+ * In binary mode a YU_LOG_* call writes only its call-site id, a TSC
+ * timestamp and its raw, typed arguments. Formatting happens offline, in
+ * the decoder, from a site table the writer emits the first time it sees
+ * each id.
+ *
+ * File layout (little endian):
+ * - BinaryLogHeader
+ * - A stream of records, each starting with a BinaryRecord byte:
+ *   - Site:  u32 id, u8 level, u32 line, u16 fileLen, file, u16 formatLen, format
+ *   - Entry: u32 id, u64 tsc, u8 flags, u16 payloadLen, payload
+ *   - Sync:  u64 tsc, i64 unix time in ns (lets the decoder correct drift)
+ *
+ * An entry payload is a sequence of LogArgType-tagged values:
+ * - Int/UInt/Pointer: 8 bytes
+ * - Float: 8-byte double
+ * - Char/Bool: 1 byte
+ * - String: u16 length, then bytes (a null C string is stored as "(null)")
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <format>
+#include <string>
+#include <string_view>
+#include <type_traits>
+
+#if defined(_MSC_VER)
+    #include <intrin.h>
+#elif defined(__i386__) || defined(__x86_64__)
+    #include <x86intrin.h>
+#endif
+
+namespace yu {
+namespace binlog {
+
+/// File magic, "YULOGBIN"
+inline constexpr char Magic[8] = {'Y', 'U', 'L', 'O', 'G', 'B', 'I', 'N'};
+inline constexpr std::uint32_t Version = 1;
+
+/// File header (written once at the start of the .bin file)
+struct BinaryLogHeader {
+    char          magic[8];
+    std::uint32_t version;
+    std::uint32_t reserved;
+    double        tscPerSecond;   // Measured when the file was opened
+    std::uint64_t tscBase;        // TSC at open
+    std::int64_t  unixNsBase;     // Wall clock at open
+};
+
+/// Record type byte
+enum class BinaryRecord : std::uint8_t {
+    Site  = 1,
+    Entry = 2,
+    Sync  = 3
+};
+
+/// Entry flags
+inline constexpr std::uint8_t EntryTruncated = 0x01;
+
+/// Argument type tag
+enum class LogArgType : std::uint8_t {
+    Int     = 1,
+    UInt    = 2,
+    Float   = 3,
+    String  = 4,
+    Pointer = 5,
+    Char    = 6,
+    Bool    = 7
+};
+
+/// Read the time-stamp counter
+[[nodiscard]] inline std::uint64_t ReadTsc() noexcept {
+#if defined(_MSC_VER) || defined(__i386__) || defined(__x86_64__)
+    return __rdtsc();
+#else
+    return 0;
+#endif
+}
+
+/// Compile-time FNV-1a, used for call-site ids
+[[nodiscard]] constexpr std::uint32_t Fnv1a(std::string_view text, std::uint32_t hash = 2166136261u) noexcept {
+    for (char c : text) {
+        hash ^= static_cast<std::uint8_t>(c);
+        hash *= 16777619u;
+    }
+    return hash;
+}
+
+// ============================================================================
+// Argument encoding
+// ============================================================================
+
+/// Appends typed arguments to a fixed buffer; stops (and flags truncation) when it fills
+class ArgEncoder {
+public:
+    ArgEncoder(char* buffer, std::size_t capacity) noexcept
+        : m_buffer(buffer), m_capacity(capacity) {}
+
+    template <typename T>
+    void Put(const T& value) noexcept {
+        using U = std::remove_cvref_t<T>;
+        if constexpr (std::is_same_v<U, bool>) {
+            PutFixed(LogArgType::Bool, static_cast<std::uint8_t>(value));
+        } else if constexpr (std::is_same_v<U, char>) {
+            PutFixed(LogArgType::Char, value);
+        } else if constexpr (std::is_integral_v<U> && std::is_signed_v<U>) {
+            PutFixed(LogArgType::Int, static_cast<std::int64_t>(value));
+        } else if constexpr (std::is_integral_v<U>) {
+            PutFixed(LogArgType::UInt, static_cast<std::uint64_t>(value));
+        } else if constexpr (std::is_floating_point_v<U>) {
+            PutFixed(LogArgType::Float, static_cast<double>(value));
+        } else if constexpr (std::is_pointer_v<U> && std::is_convertible_v<U, std::string_view>) {
+            // A C string may be null: string_view would read from address 0
+            PutString(value ? std::string_view(value) : std::string_view("(null)"));
+        } else if constexpr (std::is_convertible_v<const U&, std::string_view>) {
+            PutString(std::string_view(value));
+        } else if constexpr (std::is_pointer_v<U> || std::is_null_pointer_v<U>) {
+            PutFixed(LogArgType::Pointer, static_cast<std::uint64_t>(reinterpret_cast<std::uintptr_t>(value)));
+        } else {
+            // Anything with a custom formatter is formatted here, on the stack
+            char text[128];
+            std::string_view formatted;
+            try {
+                auto result = std::format_to_n(text, sizeof(text), "{}", value);
+                formatted = std::string_view(text, static_cast<std::size_t>(
+                    result.size < static_cast<std::ptrdiff_t>(sizeof(text)) ? result.size : sizeof(text)));
+            } catch (...) {
+                m_truncated = true;
+            }
+            PutString(formatted);
+        }
+    }
+
+    [[nodiscard]] std::size_t Size() const noexcept { return m_size; }
+    [[nodiscard]] bool Truncated() const noexcept { return m_truncated; }
+
+private:
+    template <typename V>
+    void PutFixed(LogArgType type, V value) noexcept {
+        if (m_truncated || m_size + 1 + sizeof(V) > m_capacity) {
+            m_truncated = true;
+            return;
+        }
+        m_buffer[m_size++] = static_cast<char>(type);
+        std::memcpy(m_buffer + m_size, &value, sizeof(V));
+        m_size += sizeof(V);
+    }
+
+    void PutString(std::string_view text) noexcept {
+        if (m_truncated || m_size + 3 > m_capacity) {
+            m_truncated = true;
+            return;
+        }
+        std::size_t length = text.size();
+        if (length > m_capacity - m_size - 3) {
+            length = m_capacity - m_size - 3;
+            m_truncated = true;
+        }
+        const auto length16 = static_cast<std::uint16_t>(length);
+        m_buffer[m_size++] = static_cast<char>(LogArgType::String);
+        std::memcpy(m_buffer + m_size, &length16, sizeof(length16));
+        m_size += sizeof(length16);
+        std::memcpy(m_buffer + m_size, text.data(), length);
+        m_size += length;
+    }
+
+    char*       m_buffer;
+    std::size_t m_capacity;
+    std::size_t m_size{0};
+    bool        m_truncated{false};
+};
+
+} // namespace binlog
+} // namespace yu
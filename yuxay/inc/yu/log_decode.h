@@ -0,0 +1,40 @@
+/**
+ * @file log_decode.h
+ * @brief Decoder for the structured binary log format (see log_binary.h)
+ *
+ * Used by the yu-logdecode tool. It lives in the library, next to the
+ * encoder, so the tests can round-trip records through both sides and the
+ * format cannot drift between them.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <ostream>
+#include <string>
+#include <string_view>
+
+namespace yu {
+namespace binlog {
+
+/// Outcome of DecodeLog
+struct DecodeResult {
+    std::size_t entries{0};       // Entries written out
+    std::size_t unknownSites{0};  // Entries skipped because their site was never defined
+    std::string error;            // Empty on success
+};
+
+/// Format an entry payload (ArgEncoder output) with its site's format string
+/// Arguments are widened as encoded (Int: int64, Float: double, ...), each
+/// replacement field keeps its own format spec.
+/// @param format Format string of the call site
+/// @param payload Encoded arguments
+[[nodiscard]] std::string FormatPayload(std::string_view format, std::string_view payload);
+
+/// Decode a whole binary log into text lines, in the text logger's layout
+/// @param data Contents of the .bin file
+/// @param out Receives one line per entry
+[[nodiscard]] DecodeResult DecodeLog(std::string_view data, std::ostream& out);
+
+} // namespace binlog
+} // namespace yu
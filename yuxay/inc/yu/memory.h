@@ -12,8 +12,8 @@
  * 
  * 2. DetailedTracker (memory_detailed.h)
  *    - Full allocation records with source location and timestamps
- *    - Uses std::unordered_map internally (allocates memory)
- *    - Use for development/debugging when NOT hooking memory
+ *    - Records live in a private heap, sharded by address
+ *    - Safe to use from the memory hooks; heavier per allocation
  * 
  * The default MemoryTracker class now uses LightweightTracker internally
  * for safe operation during DLL injection scenarios.
@@ -200,6 +200,15 @@ public:
 #endif
     }
     
+    /// Record a reallocation (the record follows the block, see LightweightTracker::RecordReallocation)
+    void RecordReallocation(void* oldPtr, void* newPtr, std::size_t size, TagId tag, AllocationType type) {
+#if YU_MEMORY_TRACKING_ENABLED
+        m_tracker.RecordReallocation(oldPtr, newPtr, static_cast<std::uint32_t>(size),
+            static_cast<std::uint16_t>(tag),
+            static_cast<LightweightTracker::AllocationType>(type));
+#endif
+    }
+    
     /// Get total memory currently allocated
     [[nodiscard]] std::size_t GetTotalAllocatedBytes() const noexcept {
         return m_tracker.GetTotalBytes();
@@ -365,10 +374,6 @@ inline void FreeAligned(void* ptr) {
         return Allocate(size, tag, loc);
     }
     
-#if YU_MEMORY_TRACKING_ENABLED
-    MemoryTracker::Instance().RecordDeallocation(ptr);
-#endif
-    
     void* newPtr = nullptr;
     ReallocFunc customRealloc = detail::g_customRealloc.load(std::memory_order_acquire);
     AllocationType type = customRealloc ? AllocationType::Custom : AllocationType::Heap;
@@ -379,9 +384,10 @@ inline void FreeAligned(void* ptr) {
         newPtr = std::realloc(ptr, size);
     }
     
+    // One event; a failed realloc leaves the old block and its record alone
     if (newPtr) {
 #if YU_MEMORY_TRACKING_ENABLED
-        MemoryTracker::Instance().RecordAllocation(newPtr, size, alignof(std::max_align_t), tag, type, loc);
+        MemoryTracker::Instance().RecordReallocation(ptr, newPtr, size, tag, type);
 #endif
     }
     return newPtr;
@@ -0,0 +1,245 @@
+/**
+ * @file memory_arena.h
+ * @brief Bump arena with scoped reset marks, backed by OS pages
+ *
+ * Allocation is a pointer bump; nothing is freed individually. Rewinding to a
+ * mark (or resetting) makes the memory reusable without returning the pages,
+ * so steady-state per-frame or per-load scratch work never reaches the heap
+ * (or the hooked malloc/operator new).
+ *
+ * Blocks come from memory_os.h and are reported to the tracker as
+ * AllocationType::Arena under the arena's tag, one record per block: the
+ * report shows the arena's footprint, Used()/Peak() show what is in use.
+ *
+ * An Arena is not thread-safe; use one per thread (or per frame on the
+ * render thread).
+ */
+
+#pragma once
+
+#include "memory.h"
+#include "memory_os.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+namespace yu {
+namespace mem {
+
+// ============================================================================
+// Arena
+// ============================================================================
+
+class Arena {
+    struct Block {
+        Block*      next;
+        std::size_t size;   // Total bytes of the pages, header included
+        std::size_t used;   // Bytes used after the header
+    };
+
+public:
+    /// Default size of each block of pages
+    static constexpr std::size_t DefaultBlockSize = 64 * 1024;
+
+    /// Position to rewind to
+    struct Mark {
+        Block*      block = nullptr;
+        std::size_t used = 0;
+    };
+
+    explicit Arena(TagId tag = Tags::Temporary, std::size_t blockSize = DefaultBlockSize) noexcept
+        : m_tag(tag), m_blockSize(blockSize > sizeof(Block) ? blockSize : DefaultBlockSize) {}
+
+    ~Arena() noexcept { Release(); }
+
+    Arena(const Arena&) = delete;
+    Arena& operator=(const Arena&) = delete;
+
+    /// Allocate size bytes (never nullptr unless the OS is out of pages)
+    [[nodiscard]] void* Allocate(std::size_t size, std::size_t alignment = alignof(std::max_align_t)) noexcept {
+        if (size == 0) size = 1;
+        if (m_current) {
+            if (void* ptr = BumpIn(m_current, size, alignment)) return ptr;
+        }
+        // Reuse the blocks left behind by a rewind before asking the OS
+        Block* next = m_current ? m_current->next : m_head;
+        while (next) {
+            m_usedBefore += m_current ? m_current->used : 0;
+            m_current = next;
+            m_current->used = 0;
+            if (void* ptr = BumpIn(m_current, size, alignment)) return ptr;
+            next = m_current->next;
+        }
+        if (!AddBlock(size + alignment)) return nullptr;
+        return BumpIn(m_current, size, alignment);
+    }
+
+    /// Allocate uninitialized storage for count objects of T
+    template<typename T>
+    [[nodiscard]] T* AllocateArray(std::size_t count) noexcept {
+        return static_cast<T*>(Allocate(sizeof(T) * count, alignof(T)));
+    }
+
+    /// Construct a T in the arena; its destructor is never run
+    template<typename T, typename... Args>
+    [[nodiscard]] T* New(Args&&... args) {
+        static_assert(std::is_trivially_destructible_v<T>,
+                      "arena objects are dropped on reset without running destructors");
+        void* mem = Allocate(sizeof(T), alignof(T));
+        return mem ? new (mem) T(std::forward<Args>(args)...) : nullptr;
+    }
+
+    /// Current position
+    [[nodiscard]] Mark GetMark() const noexcept {
+        return Mark{m_current, m_current ? m_current->used : 0};
+    }
+
+    /// Drop every allocation made after mark (the blocks are kept for reuse)
+    void Rewind(const Mark& mark) noexcept {
+        m_current = mark.block;
+        if (m_current) m_current->used = mark.used;
+        m_usedBefore = 0;
+        if (!m_current) return;  // Back to the start: the next allocation reuses m_head
+        for (Block* b = m_head; b != m_current; b = b->next) {
+            m_usedBefore += b->used;
+        }
+    }
+
+    /// Drop every allocation (the blocks are kept for reuse)
+    void Reset() noexcept {
+        Rewind(Mark{});
+    }
+
+    /// Drop every allocation and return the pages to the OS
+    void Release() noexcept {
+        Block* block = m_head;
+        while (block) {
+            Block* next = block->next;
+#if YU_MEMORY_TRACKING_ENABLED
+            MemoryTracker::Instance().RecordDeallocation(block);
+#endif
+            os::FreePages(block, block->size);
+            block = next;
+        }
+        m_head = m_current = nullptr;
+        m_usedBefore = 0;
+        m_capacity = 0;
+    }
+
+    /// Bytes handed out since the last reset, alignment padding included
+    [[nodiscard]] std::size_t Used() const noexcept {
+        return m_usedBefore + (m_current ? m_current->used : 0);
+    }
+
+    /// Highest Used() so far
+    [[nodiscard]] std::size_t Peak() const noexcept { return m_peak; }
+
+    /// Bytes of pages held, headers included
+    [[nodiscard]] std::size_t Capacity() const noexcept { return m_capacity; }
+
+    [[nodiscard]] TagId Tag() const noexcept { return m_tag; }
+
+private:
+    void* BumpIn(Block* block, std::size_t size, std::size_t alignment) noexcept {
+        const auto base = reinterpret_cast<std::uintptr_t>(block + 1);
+        const std::uintptr_t aligned = (base + block->used + alignment - 1) & ~(static_cast<std::uintptr_t>(alignment) - 1);
+        const std::size_t end = static_cast<std::size_t>(aligned - base) + size;
+        if (end > block->size - sizeof(Block)) return nullptr;
+        block->used = end;
+        const std::size_t used = Used();
+        if (used > m_peak) m_peak = used;
+        return reinterpret_cast<void*>(aligned);
+    }
+
+    bool AddBlock(std::size_t minPayload) noexcept {
+        std::size_t size = m_blockSize;
+        if (size - sizeof(Block) < minPayload) {
+            size = (minPayload + sizeof(Block) + DefaultBlockSize - 1) / DefaultBlockSize * DefaultBlockSize;
+        }
+        auto* block = static_cast<Block*>(os::AllocatePages(size));
+        if (!block) return false;
+        block->size = size;
+        block->used = 0;
+#if YU_MEMORY_TRACKING_ENABLED
+        MemoryTracker::Instance().RecordAllocation(block, size, alignof(std::max_align_t), m_tag, AllocationType::Arena);
+#endif
+        m_capacity += size;
+
+        // Insert after the current block so blocks kept by a rewind stay in order
+        if (m_current) {
+            block->next = m_current->next;
+            m_current->next = block;
+            m_usedBefore += m_current->used;
+        } else {
+            block->next = m_head;
+            m_head = block;
+        }
+        m_current = block;
+        return true;
+    }
+
+    TagId       m_tag;
+    std::size_t m_blockSize;
+    Block*      m_head = nullptr;
+    Block*      m_current = nullptr;
+    std::size_t m_usedBefore = 0;   // Used bytes of the blocks before m_current
+    std::size_t m_peak = 0;
+    std::size_t m_capacity = 0;
+};
+
+// ============================================================================
+// Scoped Reset
+// ============================================================================
+
+/// Rewinds an arena to where it was when the scope was entered
+class ArenaScope {
+public:
+    explicit ArenaScope(Arena& arena) noexcept : m_arena(arena), m_mark(arena.GetMark()) {}
+    ~ArenaScope() noexcept { m_arena.Rewind(m_mark); }
+
+    ArenaScope(const ArenaScope&) = delete;
+    ArenaScope& operator=(const ArenaScope&) = delete;
+
+private:
+    Arena&      m_arena;
+    Arena::Mark m_mark;
+};
+
+// ============================================================================
+// Standard Allocator Adaptor
+// ============================================================================
+
+/// std allocator drawing from an Arena; deallocate is a no-op
+/// @note Containers using it must not outlive the next reset of the arena.
+template<typename T>
+class ArenaAllocator {
+public:
+    using value_type = T;
+
+    explicit ArenaAllocator(Arena& arena) noexcept : m_arena(&arena) {}
+
+    template<typename U>
+    ArenaAllocator(const ArenaAllocator<U>& other) noexcept : m_arena(other.GetArena()) {}
+
+    [[nodiscard]] T* allocate(std::size_t n) {
+        void* ptr = m_arena->Allocate(sizeof(T) * n, alignof(T));
+        if (!ptr) throw std::bad_alloc();
+        return static_cast<T*>(ptr);
+    }
+
+    void deallocate(T*, std::size_t) noexcept {}
+
+    [[nodiscard]] Arena* GetArena() const noexcept { return m_arena; }
+
+    template<typename U>
+    bool operator==(const ArenaAllocator<U>& other) const noexcept { return m_arena == other.GetArena(); }
+
+private:
+    Arena* m_arena;
+};
+
+} // namespace mem
+} // namespace yu
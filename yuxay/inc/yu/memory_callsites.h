@@ -0,0 +1,211 @@
+/**
+ * @file memory_callsites.h
+ * @brief Lock-free call-site table for LightweightTracker
+ *
+ * Interns short return-address chains into a fixed-size open-addressed table
+ * and keeps live/total counters per site. Records refer to their site by a
+ * 16-bit id (0 = unknown), so attributing a free costs no lookup.
+ *
+ * The table lives in OS pages (memory_os.h) and is only allocated when
+ * call-site capture is first enabled. It never grows: sites that do not fit
+ * are counted as overflow and their allocations are reported as unknown.
+ */
+
+#pragma once
+
+#include "memory_os.h"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+namespace yu {
+namespace mem {
+
+/// One interned call site with its counters
+struct CallSite {
+    std::atomic<std::uint32_t> hash{0};      // 0 = empty slot
+    std::atomic<bool>          ready{false};  // frames are published
+    std::uint8_t               depth{0};
+    std::atomic<std::size_t>   liveBytes{0};
+    std::atomic<std::size_t>   liveCount{0};
+    std::atomic<std::size_t>   allocCount{0};
+    std::atomic<std::size_t>   allocBytes{0};
+    std::size_t                reportedAllocs{0};  // allocCount at the previous report (cold path only)
+    void*                      frames[8]{};
+};
+
+/// Fixed-capacity, lock-free call-site interning table
+/// @tparam Config Provides MaxCallSites (power of two, <= 32768) and
+///         MaxCallSiteFrames (<= 8)
+template <typename Config>
+class CallSiteTable {
+public:
+    static_assert((Config::MaxCallSites & (Config::MaxCallSites - 1)) == 0,
+                  "MaxCallSites must be a power of two");
+    static_assert(Config::MaxCallSites <= 32768, "Site ids are 16-bit");
+    static_assert(Config::MaxCallSiteFrames > 0 && Config::MaxCallSiteFrames <= 8,
+                  "MaxCallSiteFrames must be in [1, 8]");
+
+    using SiteId = std::uint16_t;
+
+    /// Probes before a new site is counted as overflow
+    static constexpr std::size_t MaxProbes = 32;
+
+    CallSiteTable() noexcept = default;
+    ~CallSiteTable() noexcept { Release(); }
+
+    CallSiteTable(const CallSiteTable&) = delete;
+    CallSiteTable& operator=(const CallSiteTable&) = delete;
+
+    /// Allocate the table (idempotent, thread-safe)
+    bool Initialize() noexcept {
+        if (m_sites.load(std::memory_order_acquire)) return true;
+        auto* sites = static_cast<CallSite*>(os::AllocatePages(TableBytes()));
+        if (!sites) return false;
+        CallSite* expected = nullptr;
+        if (!m_sites.compare_exchange_strong(expected, sites,
+                std::memory_order_acq_rel, std::memory_order_acquire)) {
+            os::FreePages(sites, TableBytes());
+        }
+        return true;
+    }
+
+    void Release() noexcept {
+        os::FreePages(m_sites.exchange(nullptr, std::memory_order_acq_rel), TableBytes());
+    }
+
+    [[nodiscard]] bool IsValid() const noexcept {
+        return m_sites.load(std::memory_order_acquire) != nullptr;
+    }
+
+    /// Find or add the site for a return-address chain (lock-free)
+    /// @return Site id, or 0 if the table is missing or full
+    [[nodiscard]] SiteId Intern(void* const* frames, std::size_t depth) noexcept {
+        CallSite* sites = m_sites.load(std::memory_order_acquire);
+        if (!sites || depth == 0) return 0;
+        if (depth > Config::MaxCallSiteFrames) depth = Config::MaxCallSiteFrames;
+
+        const std::uint32_t hash = HashFrames(frames, depth);
+        const std::size_t mask = Config::MaxCallSites - 1;
+        const std::size_t idx = hash & mask;
+        for (std::size_t probe = 0; probe < MaxProbes; ++probe) {
+            const std::size_t i = (idx + probe) & mask;
+            CallSite& site = sites[i];
+            std::uint32_t current = site.hash.load(std::memory_order_acquire);
+            if (current == 0) {
+                if (site.hash.compare_exchange_strong(current, hash,
+                        std::memory_order_acq_rel, std::memory_order_acquire)) {
+                    // Claimed: publish the frames for the report
+                    for (std::size_t f = 0; f < depth; ++f) site.frames[f] = frames[f];
+                    site.depth = static_cast<std::uint8_t>(depth);
+                    site.ready.store(true, std::memory_order_release);
+                    m_count.fetch_add(1, std::memory_order_relaxed);
+                    return ToId(i);
+                }
+                // Lost the race; current now holds the winner's hash
+            }
+            // Sites are identified by their 32-bit hash alone
+            if (current == hash) return ToId(i);
+        }
+        m_overflows.fetch_add(1, std::memory_order_relaxed);
+        return 0;
+    }
+
+    void OnAllocation(SiteId id, std::size_t bytes, std::size_t count) noexcept {
+        if (CallSite* site = Get(id)) {
+            site->liveBytes.fetch_add(bytes, std::memory_order_relaxed);
+            site->liveCount.fetch_add(count, std::memory_order_relaxed);
+            site->allocCount.fetch_add(count, std::memory_order_relaxed);
+            site->allocBytes.fetch_add(bytes, std::memory_order_relaxed);
+        }
+    }
+
+    void OnDeallocation(SiteId id, std::size_t bytes, std::size_t count) noexcept {
+        if (CallSite* site = Get(id)) {
+            site->liveBytes.fetch_sub(bytes, std::memory_order_relaxed);
+            site->liveCount.fetch_sub(count, std::memory_order_relaxed);
+        }
+    }
+
+    /// Apply a resize of one of the site's blocks (the block keeps its site)
+    void OnResize(SiteId id, std::size_t oldBytes, std::size_t newBytes,
+                  std::size_t oldCount, std::size_t newCount) noexcept {
+        if (CallSite* site = Get(id)) {
+            // Unsigned wrap-around turns a shrink into a subtraction
+            site->liveBytes.fetch_add(newBytes - oldBytes, std::memory_order_relaxed);
+            if (newCount != oldCount) {
+                site->liveCount.fetch_add(newCount - oldCount, std::memory_order_relaxed);
+            }
+            if (newBytes > oldBytes) {
+                site->allocBytes.fetch_add(newBytes - oldBytes, std::memory_order_relaxed);
+            }
+        }
+    }
+
+    /// Get a site by id (nullptr for 0 or an unused id)
+    [[nodiscard]] CallSite* Get(SiteId id) const noexcept {
+        CallSite* sites = m_sites.load(std::memory_order_acquire);
+        if (!sites || id == 0) return nullptr;
+        return &sites[id - 1];
+    }
+
+    /// Visit every published site: void(SiteId id, CallSite& site)
+    template <typename Callback>
+    void ForEach(Callback&& callback) const noexcept {
+        CallSite* sites = m_sites.load(std::memory_order_acquire);
+        if (!sites) return;
+        for (std::size_t i = 0; i < Config::MaxCallSites; ++i) {
+            if (sites[i].ready.load(std::memory_order_acquire)) {
+                callback(ToId(i), sites[i]);
+            }
+        }
+    }
+
+    /// Forget every site (not safe against concurrent interning)
+    void Clear() noexcept {
+        if (CallSite* sites = m_sites.load(std::memory_order_acquire)) {
+            std::memset(static_cast<void*>(sites), 0, TableBytes());
+        }
+        m_count.store(0, std::memory_order_relaxed);
+        m_overflows.store(0, std::memory_order_relaxed);
+    }
+
+    /// Get number of interned sites
+    [[nodiscard]] std::size_t GetCount() const noexcept {
+        return m_count.load(std::memory_order_relaxed);
+    }
+
+    /// Get number of lookups that found no free slot
+    [[nodiscard]] std::size_t GetOverflowCount() const noexcept {
+        return m_overflows.load(std::memory_order_relaxed);
+    }
+
+private:
+    static constexpr std::size_t TableBytes() noexcept {
+        return sizeof(CallSite) * Config::MaxCallSites;
+    }
+
+    static constexpr SiteId ToId(std::size_t index) noexcept {
+        return static_cast<SiteId>(index + 1);
+    }
+
+    static std::uint32_t HashFrames(void* const* frames, std::size_t depth) noexcept {
+        std::uint64_t h = 0xCBF29CE484222325ull;
+        for (std::size_t f = 0; f < depth; ++f) {
+            h ^= static_cast<std::uint64_t>(reinterpret_cast<std::uintptr_t>(frames[f]));
+            h *= 0x9E3779B97F4A7C15ull;
+            h ^= h >> 29;
+        }
+        const std::uint32_t hash = static_cast<std::uint32_t>(h >> 32);
+        return hash != 0 ? hash : 1;
+    }
+
+    std::atomic<CallSite*>   m_sites{nullptr};
+    std::atomic<std::size_t> m_count{0};
+    std::atomic<std::size_t> m_overflows{0};
+};
+
+} // namespace mem
+} // namespace yu
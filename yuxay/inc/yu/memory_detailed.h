@@ -8,8 +8,10 @@
  * - Memory leak detection with full stack info is important
  * - Performance is secondary to information completeness
  * 
- * Note: This tracker DOES allocate memory internally. It should NOT be used
- * when hooking the application's memory functions. Use LightweightTracker instead.
+ * Recording never goes through the CRT heap: records live in a private heap
+ * (os::PrivateHeap) sharded by address, so the tracker can be used from the
+ * memory hooks. Only the query and reporting functions allocate. Prefer
+ * LightweightTracker when only counts and sampled call sites are needed.
  * 
  * Use this for:
  * - Development/debugging builds
@@ -18,16 +20,19 @@
  */
 
 #pragma once
+#include "memory_lightweight.h"
+#include "memory_os.h"
+
 #include <string>
 #include <string_view>
 #include <cstddef>
 #include <cstdint>
+#include <cstring>
 #include <memory>
 #include <source_location>
-#include <unordered_map>
 #include <vector>
-#include <mutex>
 #include <atomic>
+#include <bit>
 #include <chrono>
 #include <format>
 #include <iostream>
@@ -42,6 +47,12 @@ namespace mem {
 /// Maximum tag name length
 constexpr std::size_t DetailedMaxTagNameLength = 64;
 
+/// Maximum number of distinct tags with statistics (power of two)
+constexpr std::size_t DetailedMaxTags = 256;
+
+/// Number of address shards, each with its own lock (power of two)
+constexpr std::size_t DetailedShardCount = 64;
+
 // ============================================================================
 // Memory Tag System
 // ============================================================================
@@ -140,10 +151,59 @@ struct DetailedTagStats {
 
 /// Full-featured memory tracking system with detailed records
 /// 
-/// WARNING: This tracker allocates memory internally using std::unordered_map.
-/// Do NOT use this tracker when hooking the application's memory allocator,
-/// as it will cause infinite recursion. Use LightweightTracker instead.
+/// Records and tag statistics never touch the CRT heap: record nodes and
+/// bucket arrays come from a private heap (os::PrivateHeap), and tag names
+/// live inline in a fixed table. Records are sharded by address, each shard
+/// behind its own spinlock, so the tracker can run next to a hooked
+/// malloc/operator new without recursing and without serializing every
+/// thread on one lock. Tag statistics are atomics updated outside the locks.
+///
+/// Only the query and reporting functions allocate (the vectors and strings
+/// they return); allocations they make are not recorded.
 class DetailedTracker {
+    struct Node {
+        Node*                    next;
+        DetailedAllocationRecord record;
+    };
+
+    struct Slab {
+        Slab* next;
+    };
+
+    struct alignas(64) Shard {
+        Spinlock    lock;
+        Node**      buckets = nullptr;
+        std::size_t bucketCount = 0;
+        std::size_t count = 0;
+        Node*       freeNodes = nullptr;
+        Slab*       slabs = nullptr;
+    };
+
+    struct TagSlot {
+        std::atomic<std::uint32_t> key{0};      // Tag id + 1; 0 is an empty slot
+        std::atomic<bool>          named{false};
+        char                       name[DetailedMaxTagNameLength]{};
+        std::atomic<std::size_t>   currentBytes{0};
+        std::atomic<std::size_t>   peakBytes{0};
+        std::atomic<std::size_t>   totalAllocated{0};
+        std::atomic<std::size_t>   totalFreed{0};
+        std::atomic<std::uint64_t> allocationCount{0};
+        std::atomic<std::uint64_t> freeCount{0};
+    };
+
+    /// Sets the recursion flag for a scope, so allocations made inside the tracker are skipped
+    class RecursionGuard {
+    public:
+        RecursionGuard() noexcept : m_previous(s_insideTracker) { s_insideTracker = true; }
+        ~RecursionGuard() noexcept { s_insideTracker = m_previous; }
+
+        RecursionGuard(const RecursionGuard&) = delete;
+        RecursionGuard& operator=(const RecursionGuard&) = delete;
+
+    private:
+        bool m_previous;
+    };
+
 public:
     /// Get singleton instance
     [[nodiscard]] static DetailedTracker& Instance() noexcept {
@@ -158,24 +218,34 @@ public:
     
     ~DetailedTracker() {
         s_shuttingDown.store(true, std::memory_order_release);
+        for (Shard& shard : m_shards) {
+            // Wait for a record in flight on another thread before freeing its shard
+            SpinlockGuard lock(shard.lock);
+            ReleaseShard(shard);
+        }
     }
     
     // ========================================================================
     // Tag Management
     // ========================================================================
     
-    /// Register a new tag name
+    /// Register a new tag name (truncated to DetailedMaxTagNameLength - 1 chars)
     void RegisterTag(DetailedTagId id, std::string_view name) {
-        std::lock_guard lock(m_mutex);
-        m_tagNames[id] = std::string(name);
+        TagSlot* slot = FindTag(id, true);
+        if (!slot) return;
+
+        SpinlockGuard lock(m_tagNameLock);
+        const std::size_t length = (std::min)(name.size(), DetailedMaxTagNameLength - 1);
+        std::memcpy(slot->name, name.data(), length);
+        slot->name[length] = '\0';
+        slot->named.store(true, std::memory_order_release);
     }
     
     /// Get tag name by ID
     [[nodiscard]] std::string_view GetTagName(DetailedTagId id) const {
-        std::lock_guard lock(m_mutex);
-        auto it = m_tagNames.find(id);
-        if (it != m_tagNames.end()) {
-            return it->second;
+        const TagSlot* slot = FindTag(id);
+        if (slot && slot->named.load(std::memory_order_acquire)) {
+            return slot->name;
         }
         return "Unknown";
     }
@@ -193,9 +263,9 @@ public:
         
         // Prevent recursion from internal allocations
         if (s_insideTracker) return;
-        s_insideTracker = true;
+        RecursionGuard guard;
         
-        DetailedAllocationRecord record{
+        const DetailedAllocationRecord record{
             .address = ptr,
             .size = size,
             .alignment = alignment,
@@ -206,32 +276,51 @@ public:
             .timestamp = std::chrono::steady_clock::now()
         };
         
+        const std::uint64_t hash = HashAddress(ptr);
+        Shard& shard = m_shards[hash >> (64 - ShardBits)];
+        bool replaced = false;
+        DetailedAllocationRecord previous;
         {
-            std::lock_guard lock(m_mutex);
-            m_allocations[ptr] = record;
-            
-            // Update tag stats
-            auto& stats = m_tagStats[tag];
-            if (stats.name.empty()) {
-                auto it = m_tagNames.find(tag);
-                stats.name = (it != m_tagNames.end()) ? it->second : "Unknown";
-                stats.id = tag;
+            SpinlockGuard lock(shard.lock);
+            if (Node* node = FindNode(shard, hash, ptr)) {
+                // Address recorded twice without a free in between: keep the newer record
+                previous = node->record;
+                node->record = record;
+                replaced = true;
+            } else {
+                if (shard.count >= shard.bucketCount &&
+                    !Rehash(shard, shard.bucketCount ? shard.bucketCount * 2 : InitialBuckets) &&
+                    !shard.buckets) {
+                    m_dropped.fetch_add(1, std::memory_order_relaxed);
+                    return;
+                }
+                node = AcquireNode(shard);
+                if (!node) {
+                    m_dropped.fetch_add(1, std::memory_order_relaxed);
+                    return;
+                }
+                node->record = record;
+                Node*& head = shard.buckets[BucketIndex(hash, shard.bucketCount)];
+                node->next = head;
+                head = node;
+                ++shard.count;
             }
-            stats.currentBytes += size;
-            stats.totalAllocated += size;
-            stats.allocationCount++;
-            stats.peakBytes = std::max(stats.peakBytes, stats.currentBytes);
         }
         
-        // Update global stats (atomic)
-        std::size_t newTotal = m_totalAllocated.fetch_add(size, std::memory_order_relaxed) + size;
-        std::size_t currentPeak = m_peakAllocated.load(std::memory_order_relaxed);
-        while (newTotal > currentPeak && 
-               !m_peakAllocated.compare_exchange_weak(currentPeak, newTotal,
-                    std::memory_order_relaxed, std::memory_order_relaxed)) {
+        if (replaced) {
+            ReleaseStats(previous.tag, previous.size);
+            m_totalAllocated.fetch_sub(previous.size, std::memory_order_relaxed);
+        }
+        if (TagSlot* slot = FindTag(tag, true)) {
+            const std::size_t current = slot->currentBytes.fetch_add(size, std::memory_order_relaxed) + size;
+            RaisePeak(slot->peakBytes, current);
+            slot->totalAllocated.fetch_add(size, std::memory_order_relaxed);
+            slot->allocationCount.fetch_add(1, std::memory_order_relaxed);
         }
         
-        s_insideTracker = false;
+        // Update global stats (atomic)
+        std::size_t newTotal = m_totalAllocated.fetch_add(size, std::memory_order_relaxed) + size;
+        RaisePeak(m_peakAllocated, newTotal);
     }
     
     /// Record a deallocation
@@ -241,30 +330,32 @@ public:
         
         // Prevent recursion from internal allocations
         if (s_insideTracker) return;
-        s_insideTracker = true;
-        
-        std::lock_guard lock(m_mutex);
+        RecursionGuard guard;
         
-        auto it = m_allocations.find(ptr);
-        if (it != m_allocations.end()) {
-            const auto& record = it->second;
-            std::size_t size = record.size;
-            DetailedTagId tag = record.tag;
-            
-            // Update tag stats
-            auto statsIt = m_tagStats.find(tag);
-            if (statsIt != m_tagStats.end()) {
-                auto& stats = statsIt->second;
-                stats.currentBytes -= std::min(stats.currentBytes, size);
-                stats.totalFreed += size;
-                stats.freeCount++;
+        const std::uint64_t hash = HashAddress(ptr);
+        Shard& shard = m_shards[hash >> (64 - ShardBits)];
+        std::size_t size = 0;
+        DetailedTagId tag = 0;
+        {
+            SpinlockGuard lock(shard.lock);
+            if (!shard.buckets) return;
+            Node** link = &shard.buckets[BucketIndex(hash, shard.bucketCount)];
+            while (*link && (*link)->record.address != ptr) {
+                link = &(*link)->next;
             }
+            Node* node = *link;
+            if (!node) return;
             
-            m_totalAllocated.fetch_sub(size, std::memory_order_relaxed);
-            m_allocations.erase(it);
+            size = node->record.size;
+            tag = node->record.tag;
+            *link = node->next;
+            node->next = shard.freeNodes;
+            shard.freeNodes = node;
+            --shard.count;
         }
         
-        s_insideTracker = false;
+        ReleaseStats(tag, size);
+        m_totalAllocated.fetch_sub(size, std::memory_order_relaxed);
     }
     
     // ========================================================================
@@ -273,21 +364,21 @@ public:
     
     /// Get statistics for a specific tag
     [[nodiscard]] DetailedTagStats GetTagStats(DetailedTagId tag) const {
-        std::lock_guard lock(m_mutex);
-        auto it = m_tagStats.find(tag);
-        if (it != m_tagStats.end()) {
-            return it->second;
-        }
-        return DetailedTagStats{};
+        const TagSlot* slot = FindTag(tag);
+        if (!slot) return DetailedTagStats{};
+        RecursionGuard guard;
+        return MakeStats(*slot);
     }
     
     /// Get all tag statistics
     [[nodiscard]] std::vector<DetailedTagStats> GetAllTagStats() const {
-        std::lock_guard lock(m_mutex);
+        RecursionGuard guard;
         std::vector<DetailedTagStats> result;
-        result.reserve(m_tagStats.size());
-        for (const auto& [id, stats] : m_tagStats) {
-            result.push_back(stats);
+        for (const TagSlot& slot : m_tags) {
+            if (slot.key.load(std::memory_order_acquire) != 0 &&
+                slot.allocationCount.load(std::memory_order_relaxed) > 0) {
+                result.push_back(MakeStats(slot));
+            }
         }
         return result;
     }
@@ -302,33 +393,47 @@ public:
         return m_peakAllocated.load(std::memory_order_relaxed);
     }
     
+    /// Number of allocations that could not be recorded because the private heap was exhausted
+    [[nodiscard]] std::uint64_t GetDroppedCount() const noexcept {
+        return m_dropped.load(std::memory_order_relaxed);
+    }
+    
+    /// Bytes the tracker holds in its private heap
+    [[nodiscard]] std::size_t GetFootprint() const noexcept {
+        return m_footprint.load(std::memory_order_relaxed);
+    }
+    
     /// Get all active allocations
     [[nodiscard]] std::vector<DetailedAllocationRecord> GetActiveAllocations() const {
-        std::lock_guard lock(m_mutex);
+        RecursionGuard guard;
         std::vector<DetailedAllocationRecord> result;
-        result.reserve(m_allocations.size());
-        for (const auto& [ptr, record] : m_allocations) {
+        result.reserve(CheckLeaks());
+        ForEachRecord([&](const DetailedAllocationRecord& record) {
             result.push_back(record);
-        }
+        });
         return result;
     }
     
     /// Get active allocations for a specific tag
     [[nodiscard]] std::vector<DetailedAllocationRecord> GetActiveAllocations(DetailedTagId tag) const {
-        std::lock_guard lock(m_mutex);
+        RecursionGuard guard;
         std::vector<DetailedAllocationRecord> result;
-        for (const auto& [ptr, record] : m_allocations) {
+        ForEachRecord([&](const DetailedAllocationRecord& record) {
             if (record.tag == tag) {
                 result.push_back(record);
             }
-        }
+        });
         return result;
     }
     
     /// Check for memory leaks (returns count of leaked allocations)
     [[nodiscard]] std::size_t CheckLeaks() const {
-        std::lock_guard lock(m_mutex);
-        return m_allocations.size();
+        std::size_t count = 0;
+        for (Shard& shard : m_shards) {
+            SpinlockGuard lock(shard.lock);
+            count += shard.count;
+        }
+        return count;
     }
     
     // ========================================================================
@@ -337,7 +442,9 @@ public:
     
     /// Generate a detailed memory report
     [[nodiscard]] std::string GenerateReport() const {
-        std::lock_guard lock(m_mutex);
+        RecursionGuard guard;
+        const std::vector<DetailedTagStats> tagStats = GetAllTagStats();
+        const std::vector<DetailedAllocationRecord> allocations = GetActiveAllocations();
         
         std::string report;
         report.reserve(4096);
@@ -345,21 +452,19 @@ public:
         report += "=== YU Detailed Memory Report ===\n\n";
         report += std::format("Total Allocated: {} bytes\n", m_totalAllocated.load());
         report += std::format("Peak Allocated:  {} bytes\n", m_peakAllocated.load());
-        report += std::format("Active Allocations: {}\n\n", m_allocations.size());
+        report += std::format("Active Allocations: {}\n\n", allocations.size());
         
         report += "--- Tag Statistics ---\n";
-        for (const auto& [id, stats] : m_tagStats) {
-            if (stats.allocationCount > 0) {
-                report += std::format("[{}] Current: {} bytes, Peak: {} bytes, "
-                                      "Allocs: {}, Frees: {}\n",
-                                      stats.name, stats.currentBytes, stats.peakBytes,
-                                      stats.allocationCount, stats.freeCount);
-            }
+        for (const auto& stats : tagStats) {
+            report += std::format("[{}] Current: {} bytes, Peak: {} bytes, "
+                                  "Allocs: {}, Frees: {}\n",
+                                  stats.name, stats.currentBytes, stats.peakBytes,
+                                  stats.allocationCount, stats.freeCount);
         }
         
-        if (!m_allocations.empty()) {
+        if (!allocations.empty()) {
             report += "\n--- Active Allocations ---\n";
-            for (const auto& [ptr, record] : m_allocations) {
+            for (const auto& record : allocations) {
                 report += record.ToString() + "\n";
             }
         }
@@ -376,13 +481,33 @@ public:
     // Control
     // ========================================================================
     
-    /// Reset all tracking data
+    /// Reset all tracking data (tag names are kept; private heap memory is kept for reuse)
     void Reset() {
-        std::lock_guard lock(m_mutex);
-        m_allocations.clear();
-        m_tagStats.clear();
+        for (Shard& shard : m_shards) {
+            SpinlockGuard lock(shard.lock);
+            for (std::size_t i = 0; i < shard.bucketCount; ++i) {
+                Node* node = shard.buckets[i];
+                while (node) {
+                    Node* next = node->next;
+                    node->next = shard.freeNodes;
+                    shard.freeNodes = node;
+                    node = next;
+                }
+                shard.buckets[i] = nullptr;
+            }
+            shard.count = 0;
+        }
+        for (TagSlot& slot : m_tags) {
+            slot.currentBytes.store(0, std::memory_order_relaxed);
+            slot.peakBytes.store(0, std::memory_order_relaxed);
+            slot.totalAllocated.store(0, std::memory_order_relaxed);
+            slot.totalFreed.store(0, std::memory_order_relaxed);
+            slot.allocationCount.store(0, std::memory_order_relaxed);
+            slot.freeCount.store(0, std::memory_order_relaxed);
+        }
         m_totalAllocated.store(0, std::memory_order_relaxed);
         m_peakAllocated.store(0, std::memory_order_relaxed);
+        m_dropped.store(0, std::memory_order_relaxed);
     }
     
     /// Enable/disable tracking at runtime
@@ -399,30 +524,185 @@ public:
     DetailedTracker& operator=(const DetailedTracker&) = delete;
     
 private:
+    static constexpr std::size_t ShardBits = std::countr_zero(DetailedShardCount);
+    static constexpr std::size_t InitialBuckets = 256;
+    static constexpr std::size_t SlabSize = 64 * 1024;
+    
+    static_assert((DetailedShardCount & (DetailedShardCount - 1)) == 0, "shard count must be a power of two");
+    static_assert((DetailedMaxTags & (DetailedMaxTags - 1)) == 0, "tag table size must be a power of two");
+    
     DetailedTracker() {
         // Register default tags
-        m_tagNames[DetailedTags::General]   = "General";
-        m_tagNames[DetailedTags::Graphics]  = "Graphics";
-        m_tagNames[DetailedTags::Audio]     = "Audio";
-        m_tagNames[DetailedTags::Physics]   = "Physics";
-        m_tagNames[DetailedTags::AI]        = "AI";
-        m_tagNames[DetailedTags::Network]   = "Network";
-        m_tagNames[DetailedTags::UI]        = "UI";
-        m_tagNames[DetailedTags::Gameplay]  = "Gameplay";
-        m_tagNames[DetailedTags::Resource]  = "Resource";
-        m_tagNames[DetailedTags::Temporary] = "Temporary";
+        RegisterTag(DetailedTags::General,   "General");
+        RegisterTag(DetailedTags::Graphics,  "Graphics");
+        RegisterTag(DetailedTags::Audio,     "Audio");
+        RegisterTag(DetailedTags::Physics,   "Physics");
+        RegisterTag(DetailedTags::AI,        "AI");
+        RegisterTag(DetailedTags::Network,   "Network");
+        RegisterTag(DetailedTags::UI,        "UI");
+        RegisterTag(DetailedTags::Gameplay,  "Gameplay");
+        RegisterTag(DetailedTags::Resource,  "Resource");
+        RegisterTag(DetailedTags::Temporary, "Temporary");
+    }
+    
+    [[nodiscard]] static std::uint64_t HashAddress(const void* ptr) noexcept {
+        // Fibonacci hashing; the low bits are alignment and carry no information
+        return (static_cast<std::uint64_t>(reinterpret_cast<std::uintptr_t>(ptr)) >> 4) * 0x9E3779B97F4A7C15ull;
+    }
+    
+    [[nodiscard]] static std::size_t BucketIndex(std::uint64_t hash, std::size_t bucketCount) noexcept {
+        // The top bits pick the shard, so index buckets from the bits below them
+        return static_cast<std::size_t>(hash >> 24) & (bucketCount - 1);
+    }
+    
+    static void RaisePeak(std::atomic<std::size_t>& peak, std::size_t value) noexcept {
+        std::size_t current = peak.load(std::memory_order_relaxed);
+        while (value > current &&
+               !peak.compare_exchange_weak(current, value, std::memory_order_relaxed, std::memory_order_relaxed)) {
+        }
+    }
+    
+    [[nodiscard]] static Node* FindNode(const Shard& shard, std::uint64_t hash, const void* ptr) noexcept {
+        if (!shard.buckets) return nullptr;
+        Node* node = shard.buckets[BucketIndex(hash, shard.bucketCount)];
+        while (node && node->record.address != ptr) {
+            node = node->next;
+        }
+        return node;
+    }
+    
+    /// Find the slot of a tag, claiming a free one if claim is set (lock-free)
+    [[nodiscard]] TagSlot* FindTag(DetailedTagId id, bool claim) noexcept {
+        const std::uint32_t key = id + 1;
+        if (key == 0) return nullptr;
+        std::size_t index = static_cast<std::size_t>((static_cast<std::uint64_t>(key) * 0x9E3779B97F4A7C15ull) >> 32);
+        for (std::size_t probe = 0; probe < DetailedMaxTags; ++probe, ++index) {
+            TagSlot& slot = m_tags[index & (DetailedMaxTags - 1)];
+            std::uint32_t current = slot.key.load(std::memory_order_acquire);
+            if (current == 0) {
+                if (!claim) return nullptr;
+                if (slot.key.compare_exchange_strong(current, key, std::memory_order_acq_rel)) {
+                    return &slot;
+                }
+            }
+            if (current == key) return &slot;
+        }
+        return nullptr;
+    }
+    
+    [[nodiscard]] const TagSlot* FindTag(DetailedTagId id) const noexcept {
+        return const_cast<DetailedTracker*>(this)->FindTag(id, false);
+    }
+    
+    void ReleaseStats(DetailedTagId tag, std::size_t size) noexcept {
+        if (TagSlot* slot = FindTag(tag, false)) {
+            slot->currentBytes.fetch_sub(size, std::memory_order_relaxed);
+            slot->totalFreed.fetch_add(size, std::memory_order_relaxed);
+            slot->freeCount.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+    
+    [[nodiscard]] DetailedTagStats MakeStats(const TagSlot& slot) const {
+        DetailedTagStats stats;
+        stats.name = slot.named.load(std::memory_order_acquire) ? slot.name : "Unknown";
+        stats.id = slot.key.load(std::memory_order_relaxed) - 1;
+        stats.currentBytes = slot.currentBytes.load(std::memory_order_relaxed);
+        stats.peakBytes = slot.peakBytes.load(std::memory_order_relaxed);
+        stats.totalAllocated = slot.totalAllocated.load(std::memory_order_relaxed);
+        stats.totalFreed = slot.totalFreed.load(std::memory_order_relaxed);
+        stats.allocationCount = slot.allocationCount.load(std::memory_order_relaxed);
+        stats.freeCount = slot.freeCount.load(std::memory_order_relaxed);
+        return stats;
+    }
+    
+    /// Visit every record, one shard lock at a time
+    template<typename Fn>
+    void ForEachRecord(Fn&& fn) const {
+        for (Shard& shard : m_shards) {
+            SpinlockGuard lock(shard.lock);
+            for (std::size_t i = 0; i < shard.bucketCount; ++i) {
+                for (const Node* node = shard.buckets[i]; node; node = node->next) {
+                    fn(node->record);
+                }
+            }
+        }
+    }
+    
+    // Shard helpers below are called with the shard's lock held
+    
+    [[nodiscard]] Node* AcquireNode(Shard& shard) noexcept {
+        if (!shard.freeNodes) {
+            auto* slab = static_cast<Slab*>(m_heap.Allocate(SlabSize));
+            if (!slab) return nullptr;
+            slab->next = shard.slabs;
+            shard.slabs = slab;
+            m_footprint.fetch_add(SlabSize, std::memory_order_relaxed);
+            
+            constexpr std::size_t first = (sizeof(Slab) + alignof(Node) - 1) / alignof(Node) * alignof(Node);
+            char* base = reinterpret_cast<char*>(slab) + first;
+            const std::size_t count = (SlabSize - first) / sizeof(Node);
+            for (std::size_t i = count; i > 0; --i) {
+                auto* node = reinterpret_cast<Node*>(base + (i - 1) * sizeof(Node));
+                node->next = shard.freeNodes;
+                shard.freeNodes = node;
+            }
+        }
+        Node* node = shard.freeNodes;
+        shard.freeNodes = node->next;
+        return node;
+    }
+    
+    bool Rehash(Shard& shard, std::size_t bucketCount) noexcept {
+        auto* buckets = static_cast<Node**>(m_heap.Allocate(sizeof(Node*) * bucketCount));
+        if (!buckets) return false;
+        for (std::size_t i = 0; i < shard.bucketCount; ++i) {
+            Node* node = shard.buckets[i];
+            while (node) {
+                Node* next = node->next;
+                Node*& head = buckets[BucketIndex(HashAddress(node->record.address), bucketCount)];
+                node->next = head;
+                head = node;
+                node = next;
+            }
+        }
+        if (shard.buckets) {
+            m_heap.Free(shard.buckets, sizeof(Node*) * shard.bucketCount);
+            m_footprint.fetch_sub(sizeof(Node*) * shard.bucketCount, std::memory_order_relaxed);
+        }
+        m_footprint.fetch_add(sizeof(Node*) * bucketCount, std::memory_order_relaxed);
+        shard.buckets = buckets;
+        shard.bucketCount = bucketCount;
+        return true;
+    }
+    
+    void ReleaseShard(Shard& shard) noexcept {
+        for (Slab* slab = shard.slabs; slab;) {
+            Slab* next = slab->next;
+            m_heap.Free(slab, SlabSize);
+            slab = next;
+        }
+        if (shard.buckets) {
+            m_heap.Free(shard.buckets, sizeof(Node*) * shard.bucketCount);
+        }
+        shard.buckets = nullptr;
+        shard.bucketCount = 0;
+        shard.count = 0;
+        shard.freeNodes = nullptr;
+        shard.slabs = nullptr;
     }
     
     static inline std::atomic<bool> s_shuttingDown{false};
     static inline thread_local bool s_insideTracker{false};
     
-    mutable std::mutex m_mutex;
-    std::unordered_map<void*, DetailedAllocationRecord> m_allocations;
-    std::unordered_map<DetailedTagId, DetailedTagStats> m_tagStats;
-    std::unordered_map<DetailedTagId, std::string> m_tagNames;
-    std::atomic<std::size_t> m_totalAllocated{0};
-    std::atomic<std::size_t> m_peakAllocated{0};
-    std::atomic<bool> m_enabled{true};
+    os::PrivateHeap            m_heap;
+    mutable Shard              m_shards[DetailedShardCount];
+    TagSlot                    m_tags[DetailedMaxTags];
+    Spinlock                   m_tagNameLock;
+    std::atomic<std::size_t>   m_totalAllocated{0};
+    std::atomic<std::size_t>   m_peakAllocated{0};
+    std::atomic<std::size_t>   m_footprint{0};
+    std::atomic<std::uint64_t> m_dropped{0};
+    std::atomic<bool>          m_enabled{true};
 };
 
 // ============================================================================
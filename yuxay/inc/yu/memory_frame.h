@@ -0,0 +1,166 @@
+/**
+ * @file memory_frame.h
+ * @brief Double-buffered, per-thread frame scratch memory
+ *
+ * Everything that lives for one frame (formatted text, temporary arrays,
+ * widget strings) can come from FrameArena::ThisThread() instead of the
+ * heap. Each thread owns two arenas: allocations made during frame N stay
+ * valid until the end of frame N + 1, then their arena is reset and reused.
+ *
+ * The frame clock is global: the render loop calls FrameArena::EndFrame()
+ * once per frame, and other threads catch up (and reset their own arenas)
+ * on their next allocation.
+ */
+
+#pragma once
+
+#include "memory_arena.h"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <format>
+#include <new>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace yu {
+namespace mem {
+
+// ============================================================================
+// FrameArena
+// ============================================================================
+
+class FrameArena {
+public:
+    /// The calling thread's frame arena
+    [[nodiscard]] static FrameArena& ThisThread() noexcept {
+        thread_local FrameArena arena;
+        return arena;
+    }
+
+    /// Advance the global frame clock; the calling thread resets right away
+    static void EndFrame() noexcept {
+        s_frame.fetch_add(1, std::memory_order_release);
+        ThisThread().Sync();
+    }
+
+    /// Number of EndFrame calls so far
+    [[nodiscard]] static std::uint64_t FrameIndex() noexcept {
+        return s_frame.load(std::memory_order_acquire);
+    }
+
+    /// Highest per-frame usage of any thread, in bytes
+    [[nodiscard]] static std::size_t GlobalHighWater() noexcept {
+        return s_highWater.load(std::memory_order_relaxed);
+    }
+
+    /// Allocate memory that stays valid until the end of the next frame
+    [[nodiscard]] void* Allocate(std::size_t size, std::size_t alignment = alignof(std::max_align_t)) noexcept {
+        Sync();
+        return m_arenas[m_current].Allocate(size, alignment);
+    }
+
+    template<typename T>
+    [[nodiscard]] T* AllocateArray(std::size_t count) noexcept {
+        return static_cast<T*>(Allocate(sizeof(T) * count, alignof(T)));
+    }
+
+    /// Bytes allocated by this thread in the current frame
+    [[nodiscard]] std::size_t CurrentBytes() const noexcept { return m_arenas[m_current].Used(); }
+    /// Bytes this thread allocated in its last completed frame
+    [[nodiscard]] std::size_t LastFrameBytes() const noexcept { return m_lastFrameBytes; }
+    /// This thread's highest per-frame usage
+    [[nodiscard]] std::size_t HighWater() const noexcept { return m_highWater; }
+    /// Pages held by both arenas
+    [[nodiscard]] std::size_t Capacity() const noexcept {
+        return m_arenas[0].Capacity() + m_arenas[1].Capacity();
+    }
+
+    FrameArena(const FrameArena&) = delete;
+    FrameArena& operator=(const FrameArena&) = delete;
+
+private:
+    FrameArena() noexcept
+        : m_arenas{Arena(Tags::Temporary), Arena(Tags::Temporary)}
+        , m_frame(s_frame.load(std::memory_order_acquire)) {}
+
+    void Sync() noexcept {
+        const std::uint64_t frame = s_frame.load(std::memory_order_acquire);
+        if (frame == m_frame) return;
+
+        m_lastFrameBytes = m_arenas[m_current].Used();
+        if (m_lastFrameBytes > m_highWater) {
+            m_highWater = m_lastFrameBytes;
+            std::size_t global = s_highWater.load(std::memory_order_relaxed);
+            while (global < m_highWater &&
+                   !s_highWater.compare_exchange_weak(global, m_highWater, std::memory_order_relaxed)) {}
+        }
+
+        // The other arena holds frame m_frame - 1, which has now expired
+        m_current ^= 1;
+        m_arenas[m_current].Reset();
+        if (frame - m_frame >= 2) {
+            // Skipped frames: what the previous arena holds is stale too
+            m_arenas[m_current ^ 1].Reset();
+        }
+        m_frame = frame;
+    }
+
+    Arena         m_arenas[2];
+    std::uint32_t m_current = 0;
+    std::uint64_t m_frame;
+    std::size_t   m_lastFrameBytes = 0;
+    std::size_t   m_highWater = 0;
+
+    static inline std::atomic<std::uint64_t> s_frame{0};
+    static inline std::atomic<std::size_t>   s_highWater{0};
+};
+
+// ============================================================================
+// Standard Allocator Adaptor
+// ============================================================================
+
+/// Stateless std allocator drawing from the calling thread's FrameArena
+/// @note A container using it is valid until the end of the next frame and
+///       must only grow on the thread that created it.
+template<typename T>
+struct FrameAllocator {
+    using value_type = T;
+
+    FrameAllocator() noexcept = default;
+
+    template<typename U>
+    FrameAllocator(const FrameAllocator<U>&) noexcept {}
+
+    [[nodiscard]] T* allocate(std::size_t n) {
+        void* ptr = FrameArena::ThisThread().Allocate(sizeof(T) * n, alignof(T));
+        if (!ptr) throw std::bad_alloc();
+        return static_cast<T*>(ptr);
+    }
+
+    void deallocate(T*, std::size_t) noexcept {}
+
+    template<typename U>
+    bool operator==(const FrameAllocator<U>&) const noexcept { return true; }
+};
+
+template<typename T>
+using FrameVector = std::vector<T, FrameAllocator<T>>;
+
+using FrameString = std::basic_string<char, std::char_traits<char>, FrameAllocator<char>>;
+
+/// Format into frame memory (null-terminated, valid until the end of the next frame)
+template<typename... Args>
+[[nodiscard]] std::string_view FrameFormat(std::format_string<Args...> fmt, Args&&... args) {
+    const std::size_t size = std::formatted_size(fmt, std::forward<Args>(args)...);
+    char* text = FrameArena::ThisThread().AllocateArray<char>(size + 1);
+    if (!text) return {};
+    std::format_to(text, fmt, std::forward<Args>(args)...);
+    text[size] = '\0';
+    return std::string_view(text, size);
+}
+
+} // namespace mem
+} // namespace yu
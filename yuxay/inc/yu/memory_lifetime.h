@@ -0,0 +1,125 @@
+/**
+ * @file memory_lifetime.h
+ * @brief Allocation lifetime histograms for LightweightTracker
+ *
+ * Every record carries the low 16 bits of the tracker's frame counter at
+ * allocation time. When lifetime profiling is on, a free looks at how many
+ * frames the block lived and bumps one log2 bucket:
+ * - per power-of-two size class (inline, always available)
+ * - per call site (OS pages, allocated when profiling is first enabled;
+ *   only filled while call-site capture is on)
+ *
+ * Bucket 0 counts blocks freed in the frame that allocated them: the
+ * candidates for a frame allocator or a pool. Nothing here allocates and the
+ * hot path is one relaxed increment per histogram.
+ */
+
+#pragma once
+
+#include "memory_os.h"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+namespace yu {
+namespace mem {
+
+// ============================================================================
+// Lifetime Table
+// ============================================================================
+
+/// Lifetime histograms by size class and by call site
+/// @tparam Config Provides SizeClasses, MaxCallSites and LifetimeBuckets
+template <typename Config>
+class LifetimeTable {
+public:
+    static constexpr std::size_t Buckets = Config::LifetimeBuckets;
+    static_assert(Buckets >= 2 && Buckets <= 17, "Lifetime buckets cover at most 16-bit ages");
+
+    LifetimeTable() noexcept = default;
+    ~LifetimeTable() noexcept { Release(); }
+
+    LifetimeTable(const LifetimeTable&) = delete;
+    LifetimeTable& operator=(const LifetimeTable&) = delete;
+
+    /// Allocate the per-site histograms (idempotent, thread-safe)
+    bool Initialize() noexcept {
+        if (m_sites.load(std::memory_order_acquire)) return true;
+        auto* sites = static_cast<std::atomic<std::size_t>*>(os::AllocatePages(SiteBytes()));
+        if (!sites) return false;
+        std::atomic<std::size_t>* expected = nullptr;
+        if (!m_sites.compare_exchange_strong(expected, sites,
+                std::memory_order_acq_rel, std::memory_order_acquire)) {
+            os::FreePages(sites, SiteBytes());
+        }
+        return true;
+    }
+
+    void Release() noexcept {
+        os::FreePages(m_sites.exchange(nullptr, std::memory_order_acq_rel), SiteBytes());
+    }
+
+    /// Bucket of an age in frames: [0], [1], [2-3], [4-7] ... [2^(Buckets-2)+]
+    [[nodiscard]] static constexpr std::size_t BucketOf(std::uint32_t frames) noexcept {
+        std::size_t bucket = 0;
+        while (frames != 0 && bucket + 1 < Buckets) {
+            frames >>= 1;
+            ++bucket;
+        }
+        return bucket;
+    }
+
+    /// Count a free (lock-free)
+    /// @param sizeClass Size class of the block (SizeClassOf)
+    /// @param site Call-site id of the block, 0 = unknown
+    /// @param frames Frames the block lived
+    /// @param count Blocks represented (sampling weight)
+    void OnFree(std::size_t sizeClass, std::uint16_t site, std::uint32_t frames, std::size_t count) noexcept {
+        const std::size_t bucket = BucketOf(frames);
+        m_classes[sizeClass][bucket].fetch_add(count, std::memory_order_relaxed);
+        if (site != 0 && site <= Config::MaxCallSites) {
+            if (std::atomic<std::size_t>* sites = m_sites.load(std::memory_order_acquire)) {
+                sites[(site - 1) * Buckets + bucket].fetch_add(count, std::memory_order_relaxed);
+            }
+        }
+    }
+
+    /// Get frees of a size class in a bucket
+    [[nodiscard]] std::size_t SizeClassCount(std::size_t sizeClass, std::size_t bucket) const noexcept {
+        return m_classes[sizeClass][bucket].load(std::memory_order_relaxed);
+    }
+
+    /// Get frees of a call site in a bucket (0 without site histograms)
+    [[nodiscard]] std::size_t SiteCount(std::uint16_t site, std::size_t bucket) const noexcept {
+        const std::atomic<std::size_t>* sites = m_sites.load(std::memory_order_acquire);
+        if (!sites || site == 0 || site > Config::MaxCallSites) return 0;
+        return sites[(site - 1) * Buckets + bucket].load(std::memory_order_relaxed);
+    }
+
+    [[nodiscard]] bool HasSites() const noexcept {
+        return m_sites.load(std::memory_order_acquire) != nullptr;
+    }
+
+    /// Zero every histogram (not safe against concurrent frees)
+    void Clear() noexcept {
+        for (auto& row : m_classes) {
+            for (auto& bucket : row) bucket.store(0, std::memory_order_relaxed);
+        }
+        if (std::atomic<std::size_t>* sites = m_sites.load(std::memory_order_acquire)) {
+            std::memset(static_cast<void*>(sites), 0, SiteBytes());
+        }
+    }
+
+private:
+    static constexpr std::size_t SiteBytes() noexcept {
+        return sizeof(std::atomic<std::size_t>) * Config::MaxCallSites * Buckets;
+    }
+
+    std::atomic<std::size_t> m_classes[Config::SizeClasses][Buckets]{};
+    std::atomic<std::atomic<std::size_t>*> m_sites{nullptr};
+};
+
+} // namespace mem
+} // namespace yu
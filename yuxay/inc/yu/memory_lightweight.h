@@ -3,7 +3,7 @@
  * @brief Lightweight lock-free memory tracking for DLL injection
  * 
  * This tracker is designed for high-performance scenarios where:
- * - Zero internal allocations are required (uses preallocated buffers)
+ * - Zero internal allocations are required (records live in OS pages)
  * - Lock-free operations are needed (uses atomics and spinlocks)
  * - Minimal per-allocation overhead is acceptable
  * - The tracker must not interfere with hooked memory functions
@@ -23,10 +23,19 @@
     #include <intrin.h>
     #define YU_PAUSE() _mm_pause()
 #else
+    #include <fcntl.h>
+    #include <time.h>
     #include <unistd.h>
     #define YU_PAUSE() __builtin_ia32_pause()
 #endif
 
+#include "io_stream.h"
+#include "memory_callsites.h"
+#include "memory_lifetime.h"
+#include "memory_records.h"
+#include "memory_sampling.h"
+#include "memory_stats.h"
+
 #include <atomic>
 #include <cstddef>
 #include <cstdint>
@@ -41,24 +50,48 @@ namespace mem {
 
 /// Configuration for the lightweight tracker
 struct LightweightConfig {
-    /// Maximum number of concurrent allocations that can be tracked
+    /// Number of record slots in the first table segment (power of two)
     /// Should be at least 2x the expected peak active allocations for good hash table performance
     /// At 50% load factor, linear probing is efficient; above 70% it degrades rapidly
     static constexpr std::size_t MaxAllocations = 262144;  // 256K slots
     
+    /// Maximum number of table segments; each one doubles the previous size,
+    /// so the table can hold up to MaxAllocations * (2^MaxSegments - 1) records
+    static constexpr std::size_t MaxSegments = 6;
+    
     /// Maximum number of tags supported (kept small for static array)
     static constexpr std::size_t MaxTags = 64;
     
     /// Maximum length of tag names (stored inline)
     static constexpr std::size_t MaxTagNameLength = 32;
     
-    /// Number of probes before giving up on insertion (hash collision handling)
-    /// Increase this if you see dropped allocations even with low load factor
+    /// Power-of-two size classes in the live histogram (class 31 holds 2 GB and up)
+    static constexpr std::size_t SizeClasses = 32;
+    
+    /// Number of probes in a segment before moving on to the next one
+    /// (a segment that runs out of probes is skipped until it drains)
     static constexpr std::size_t MaxProbes = 64;
     
-    /// Use dynamic allocation for records buffer (VirtualAlloc on Windows)
-    /// This avoids compiler heap issues with large static arrays
-    static constexpr bool UseDynamicBuffer = true;
+    /// Number of per-thread counter blocks (power of two, YU_MEMORY_SHARDED_STATS only)
+    static constexpr std::size_t StatShards = 16;
+    
+    /// Allocations on a shard between peak samples (YU_MEMORY_SHARDED_STATS only)
+    static constexpr std::size_t PeakSampleInterval = 256;
+    
+    /// Default mean sampling interval in bytes for TrackingMode::Sampled
+    static constexpr std::size_t DefaultSampleBytes = 512 * 1024;
+    
+    /// Distinct call sites that can be attributed (power of two)
+    static constexpr std::size_t MaxCallSites = 4096;
+    
+    /// Return addresses kept per call site in CallSiteMode::StackTrace
+    static constexpr std::size_t MaxCallSiteFrames = 6;
+    
+    /// Sites listed in each ranking of the call-site report
+    static constexpr std::size_t TopCallSites = 16;
+    
+    /// Log2 buckets of the lifetime histograms: [0], [1], [2-3] ... [1024+] frames
+    static constexpr std::size_t LifetimeBuckets = 12;
 };
 
 // ============================================================================
@@ -115,44 +148,13 @@ private:
 };
 
 // ============================================================================
-// Compact Allocation Record
+// Tag Names
 // ============================================================================
 
-/// Minimal allocation record - 16 bytes on 32-bit, 24 bytes on 64-bit
-struct CompactRecord {
-    std::atomic<void*> address{nullptr};  // nullptr = free slot
-    std::uint32_t      size{0};
-    std::uint16_t      tag{0};
-    std::uint8_t       flags{0};          // AllocationType in lower 4 bits
-    std::uint8_t       reserved{0};
-    
-    bool isEmpty() const noexcept {
-        return address.load(std::memory_order_relaxed) == nullptr;
-    }
-};
-
-// ============================================================================
-// Atomic Tag Statistics
-// ============================================================================
-
-/// Per-tag statistics using only atomic operations
-struct alignas(64) AtomicTagStats {  // Cache-line aligned to prevent false sharing
-    std::atomic<std::size_t>  currentBytes{0};
-    std::atomic<std::size_t>  peakBytes{0};
-    std::atomic<std::uint64_t> allocCount{0};
-    std::atomic<std::uint64_t> freeCount{0};
+/// Per-tag name storage (counters live in the statistics policy, memory_stats.h)
+struct TagInfo {
     char name[LightweightConfig::MaxTagNameLength]{};
     std::atomic<bool> registered{false};
-    
-    void updatePeak() noexcept {
-        std::size_t current = currentBytes.load(std::memory_order_relaxed);
-        std::size_t peak = peakBytes.load(std::memory_order_relaxed);
-        while (current > peak) {
-            if (peakBytes.compare_exchange_weak(peak, current, std::memory_order_relaxed)) {
-                break;
-            }
-        }
-    }
 };
 
 // ============================================================================
@@ -162,8 +164,8 @@ struct alignas(64) AtomicTagStats {  // Cache-line aligned to prevent false shar
 /// Lock-free memory tracker with zero internal allocations
 /// 
 /// This tracker uses:
-/// - Fixed-size hash table with linear probing for allocation records
-/// - Atomic operations for all statistics updates
+/// - Segmented hash table with linear probing and tombstones (memory_records.h)
+/// - Atomic statistics, shared or per-thread sharded (memory_stats.h)
 /// - Spinlock only for report generation (cold path)
 /// - No std::string, std::unordered_map, or any allocating containers
 class LightweightTracker {
@@ -194,6 +196,19 @@ public:
         Custom = 4
     };
     
+    /// What the hot path records
+    enum class TrackingMode : std::uint8_t {
+        Exact   = 0,  // Every allocation gets a record (leak hunting)
+        Sampled = 1   // ~One allocation per sample interval bytes, scaled up in the stats
+    };
+    
+    /// How recorded allocations are attributed to call sites
+    enum class CallSiteMode : std::uint8_t {
+        Off           = 0,  // No attribution
+        ReturnAddress = 1,  // The caller passed to RecordAllocation
+        StackTrace    = 2   // Short RtlCaptureStackBackTrace chain (caller only off Windows)
+    };
+    
     /// Get singleton instance
     static LightweightTracker& Instance() noexcept {
         static LightweightTracker instance;
@@ -209,121 +224,202 @@ public:
     /// @param size Size in bytes
     /// @param tag Memory tag for categorization
     /// @param type Allocation type
+    /// @param caller Return address of the allocating call (used by CallSiteMode)
     void RecordAllocation(void* ptr, std::uint32_t size, TagId tag = 0,
-                          AllocationType type = AllocationType::Heap) noexcept {
-        if (!ptr || !m_records || !m_enabled.load(std::memory_order_relaxed)) return;
-        
-        // Hash-based slot selection
-        std::size_t hash = reinterpret_cast<std::uintptr_t>(ptr);
-        hash = hash ^ (hash >> 16);  // Better distribution
-        std::size_t idx = hash % LightweightConfig::MaxAllocations;
-        
-        // Linear probing with CAS
-        for (std::size_t probe = 0; probe < LightweightConfig::MaxProbes; ++probe) {
-            auto& slot = m_records[(idx + probe) % LightweightConfig::MaxAllocations];
-            void* expected = nullptr;
-            
-            if (slot.address.compare_exchange_strong(expected, ptr,
-                    std::memory_order_acq_rel, std::memory_order_relaxed)) {
-                // Successfully claimed this slot
-                slot.size = size;
-                slot.tag = tag;
-                slot.flags = static_cast<std::uint8_t>(type);
-                
-                // Update statistics atomically
-                m_totalBytes.fetch_add(size, std::memory_order_relaxed);
-                m_activeCount.fetch_add(1, std::memory_order_relaxed);
-                
-                if (tag < LightweightConfig::MaxTags) {
-                    m_tagStats[tag].currentBytes.fetch_add(size, std::memory_order_relaxed);
-                    m_tagStats[tag].allocCount.fetch_add(1, std::memory_order_relaxed);
-                    m_tagStats[tag].updatePeak();
-                }
-                
-                // Update global peak
-                updateGlobalPeak();
-                return;
-            }
+                          AllocationType type = AllocationType::Heap,
+                          const void* caller = nullptr) noexcept {
+        if (!ptr || !m_table.IsValid() || !m_enabled.load(std::memory_order_relaxed)) return;
+        
+        // Sampled mode: most allocations stop at a thread-local countdown
+        const std::uint8_t shift = m_sampleShift.load(std::memory_order_relaxed);
+        if (shift != 0 && !ShouldSample(size, shift)) return;
+        
+        // Only recorded allocations pay for the capture
+        const CallSiteMode siteMode = m_callSiteMode.load(std::memory_order_relaxed);
+        const std::uint16_t site = siteMode != CallSiteMode::Off ? captureCallSite(siteMode, caller) : 0;
+        
+        // The payload is complete before the address becomes visible to Find and the walks
+        RecordInfo info;
+        info.size = size;
+        info.tag = tag;
+        info.flags = static_cast<std::uint8_t>(type);
+        info.sampleShift = shift;
+        info.site = site;
+        info.birth = static_cast<std::uint16_t>(m_frame.load(std::memory_order_relaxed));
+        if (!m_table.Insert(ptr, info)) {
+            // Every segment saturated and no more can be added
+            m_droppedAllocations.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+        
+        const SampleWeight weight = GetSampleWeight(size, shift);
+        m_stats.OnAllocation(weight.bytes, tag, weight.count, SizeClassOf(size));
+        if (site != 0) {
+            m_sites.OnAllocation(site, weight.bytes, weight.count);
         }
-        // Table full or too many collisions - silently drop (acceptable for tracking)
-        m_droppedAllocations.fetch_add(1, std::memory_order_relaxed);
     }
     
     /// Record a deallocation (lock-free)
     /// @param ptr Pointer to freed memory
     void RecordDeallocation(void* ptr) noexcept {
-        if (!ptr || !m_records || !m_enabled.load(std::memory_order_relaxed)) return;
+        if (!ptr || !m_table.IsValid() || !m_enabled.load(std::memory_order_relaxed)) return;
         
-        // Find the record
-        std::size_t hash = reinterpret_cast<std::uintptr_t>(ptr);
-        hash = hash ^ (hash >> 16);
-        std::size_t idx = hash % LightweightConfig::MaxAllocations;
+        // Erase leaves a tombstone, so records further down the cluster stay reachable
+        RecordInfo record;
+        if (!m_table.Erase(ptr, record)) {
+            // Not found - could be allocation we couldn't track
+            return;
+        }
         
-        for (std::size_t probe = 0; probe < LightweightConfig::MaxProbes; ++probe) {
-            auto& slot = m_records[(idx + probe) % LightweightConfig::MaxAllocations];
-            
-            if (slot.address.load(std::memory_order_relaxed) == ptr) {
-                // Found the record - capture data before clearing
-                std::uint32_t size = slot.size;
-                TagId tag = slot.tag;
-                
-                // Clear the slot with CAS to handle races
-                void* expected = ptr;
-                if (slot.address.compare_exchange_strong(expected, nullptr,
-                        std::memory_order_acq_rel, std::memory_order_relaxed)) {
-                    // Successfully freed this slot
-                    m_totalBytes.fetch_sub(size, std::memory_order_relaxed);
-                    m_activeCount.fetch_sub(1, std::memory_order_relaxed);
-                    
-                    if (tag < LightweightConfig::MaxTags) {
-                        auto& stats = m_tagStats[tag];
-                        std::size_t current = stats.currentBytes.load(std::memory_order_relaxed);
-                        if (current >= size) {
-                            stats.currentBytes.fetch_sub(size, std::memory_order_relaxed);
-                        } else {
-                            stats.currentBytes.store(0, std::memory_order_relaxed);
-                        }
-                        stats.freeCount.fetch_add(1, std::memory_order_relaxed);
-                    }
-                }
+        // Weight comes from the record, so mode changes in between are harmless
+        const SampleWeight weight = GetSampleWeight(record.size, record.sampleShift);
+        m_stats.OnDeallocation(weight.bytes, record.tag, weight.count, SizeClassOf(record.size));
+        if (record.site != 0) {
+            m_sites.OnDeallocation(record.site, weight.bytes, weight.count);
+        }
+        if (m_lifetimeProfiling.load(std::memory_order_relaxed)) {
+            // Ages wrap after 65536 frames (18 minutes at 60 fps): an older block lands in a younger bucket
+            const std::uint16_t age = static_cast<std::uint16_t>(
+                static_cast<std::uint16_t>(m_frame.load(std::memory_order_relaxed)) - record.birth);
+            m_lifetimes.OnFree(SizeClassOf(record.size), record.site, age, weight.count);
+        }
+    }
+    
+    /// Record a reallocation as one event (lock-free)
+    /// The record keeps its tag, call site, birth frame and sampling weight:
+    /// in place it is resized, a moved block takes it to its new address in
+    /// one find/claim pass. Only the size delta reaches the counters, and the
+    /// block counts neither as a new allocation nor as a free.
+    /// Called after realloc returns: if another thread is handed oldPtr in
+    /// between, the two records at that address may trade payloads, which
+    /// keeps the totals balanced once both blocks are gone.
+    /// @param oldPtr Block passed to realloc (nullptr: plain allocation)
+    /// @param newPtr Block realloc returned (nullptr with newSize 0: the block was freed;
+    ///               nullptr otherwise: realloc failed and oldPtr is still live)
+    /// @param newSize New size in bytes
+    /// @param tag, type, caller Used only when oldPtr has no record
+    void RecordReallocation(void* oldPtr, void* newPtr, std::uint32_t newSize, TagId tag = 0,
+                            AllocationType type = AllocationType::Heap,
+                            const void* caller = nullptr) noexcept {
+        if (!oldPtr) {
+            RecordAllocation(newPtr, newSize, tag, type, caller);
+            return;
+        }
+        if (!newPtr) {
+            if (newSize == 0) RecordDeallocation(oldPtr);
+            return;
+        }
+        if (!m_table.IsValid() || !m_enabled.load(std::memory_order_relaxed)) return;
+        
+        CompactRecord* slot = m_table.Find(oldPtr);
+        if (!slot) {
+            // Untracked (sampled out, or allocated before tracking): the new block gets its own chance
+            RecordAllocation(newPtr, newSize, tag, type, caller);
+            return;
+        }
+        const RecordInfo record = slot->Info();
+        
+        if (newPtr != oldPtr) {
+            // The new address is published with the full payload, then the old one goes
+            RecordInfo moved = record;
+            moved.size = newSize;
+            if (!m_table.Insert(newPtr, moved)) {
+                // Every segment saturated: the block leaves the table
+                m_droppedAllocations.fetch_add(1, std::memory_order_relaxed);
+                RecordDeallocation(oldPtr);
                 return;
             }
-            
-            // Empty slot means not found
-            if (slot.isEmpty()) break;
+            m_table.EraseAt(*slot, oldPtr);
+        } else {
+            slot->size = newSize;
+        }
+        
+        const SampleWeight before = GetSampleWeight(record.size, record.sampleShift);
+        const SampleWeight after = GetSampleWeight(newSize, record.sampleShift);
+        m_stats.OnReallocation(before.bytes, after.bytes, record.tag, before.count, after.count,
+                               SizeClassOf(record.size), SizeClassOf(newSize));
+        if (record.site != 0) {
+            m_sites.OnResize(record.site, before.bytes, after.bytes, before.count, after.count);
         }
-        // Not found - could be allocation we couldn't track
     }
     
     // ========================================================================
     // Statistics - Lock-Free Reads
     // ========================================================================
     
+    /// True if peaks are exact (false with YU_MEMORY_SHARDED_STATS, where
+    /// peaks are sampled lower bounds and totals are summed on read)
+    static constexpr bool HasExactStats = TrackerStats<LightweightConfig>::IsExact;
+    
     /// Get total bytes currently allocated
     [[nodiscard]] std::size_t GetTotalBytes() const noexcept {
-        return m_totalBytes.load(std::memory_order_relaxed);
+        return m_stats.TotalBytes();
     }
     
     /// Get peak bytes ever allocated
     [[nodiscard]] std::size_t GetPeakBytes() const noexcept {
-        return m_peakBytes.load(std::memory_order_relaxed);
+        return m_stats.PeakBytes();
     }
     
     /// Get number of active allocations
     [[nodiscard]] std::size_t GetActiveCount() const noexcept {
-        return m_activeCount.load(std::memory_order_relaxed);
+        return m_stats.ActiveCount();
     }
     
     /// Get bytes for a specific tag
     [[nodiscard]] std::size_t GetTagBytes(TagId tag) const noexcept {
         if (tag >= LightweightConfig::MaxTags) return 0;
-        return m_tagStats[tag].currentBytes.load(std::memory_order_relaxed);
+        return m_stats.TagBytes(tag);
     }
     
     /// Get allocation count for a specific tag
     [[nodiscard]] std::uint64_t GetTagAllocCount(TagId tag) const noexcept {
         if (tag >= LightweightConfig::MaxTags) return 0;
-        return m_tagStats[tag].allocCount.load(std::memory_order_relaxed);
+        return m_stats.TagAllocCount(tag);
+    }
+    
+    /// Get peak bytes of a specific tag
+    [[nodiscard]] std::size_t GetTagPeakBytes(TagId tag) const noexcept {
+        if (tag >= LightweightConfig::MaxTags) return 0;
+        return m_stats.TagPeakBytes(tag);
+    }
+    
+    /// Get free count for a specific tag
+    [[nodiscard]] std::uint64_t GetTagFreeCount(TagId tag) const noexcept {
+        if (tag >= LightweightConfig::MaxTags) return 0;
+        return m_stats.TagFreeCount(tag);
+    }
+    
+    /// Get bytes currently allocated in a size class (see SizeClassOf)
+    [[nodiscard]] std::size_t GetSizeClassBytes(std::size_t sizeClass) const noexcept {
+        if (sizeClass >= LightweightConfig::SizeClasses) return 0;
+        return m_stats.SizeClassBytes(sizeClass);
+    }
+    
+    /// Get number of live blocks in a size class
+    [[nodiscard]] std::size_t GetSizeClassCount(std::size_t sizeClass) const noexcept {
+        if (sizeClass >= LightweightConfig::SizeClasses) return 0;
+        return m_stats.SizeClassCount(sizeClass);
+    }
+    
+    /// Get number of allocations ever made in a size class
+    [[nodiscard]] std::uint64_t GetSizeClassAllocCount(std::size_t sizeClass) const noexcept {
+        if (sizeClass >= LightweightConfig::SizeClasses) return 0;
+        return m_stats.SizeClassAllocCount(sizeClass);
+    }
+    
+    /// Get number of allocations ever recorded (differences give allocation rates)
+    [[nodiscard]] std::uint64_t GetTotalAllocCount() const noexcept {
+        std::uint64_t total = 0;
+        for (std::size_t i = 0; i < LightweightConfig::SizeClasses; ++i) {
+            total += m_stats.SizeClassAllocCount(i);
+        }
+        return total;
+    }
+    
+    /// Get number of reallocations recorded by RecordReallocation (not in the allocation counts)
+    [[nodiscard]] std::uint64_t GetReallocCount() const noexcept {
+        return m_stats.ReallocCount();
     }
     
     /// Get number of dropped allocations (table was full)
@@ -331,6 +427,38 @@ public:
         return m_droppedAllocations.load(std::memory_order_relaxed);
     }
     
+    /// Scan the record table and report its health (cold path, no lock)
+    /// @return Load factor, tombstones, segment count and probe distances
+    [[nodiscard]] RecordTableStats GetTableStats() const noexcept {
+        return m_table.GetStats();
+    }
+    
+    /// Lifetime bucket of an age in frames: [0], [1], [2-3], [4-7] ... [1024+]
+    [[nodiscard]] static constexpr std::size_t LifetimeBucketOf(std::uint32_t frames) noexcept {
+        return LifetimeTable<LightweightConfig>::BucketOf(frames);
+    }
+    
+    /// Get frees of a size class, by lifetime bucket (lifetime profiling only)
+    [[nodiscard]] std::size_t GetLifetimeCount(std::size_t sizeClass, std::size_t bucket) const noexcept {
+        if (sizeClass >= LightweightConfig::SizeClasses || bucket >= LightweightConfig::LifetimeBuckets) return 0;
+        return m_lifetimes.SizeClassCount(sizeClass, bucket);
+    }
+    
+    /// Get frees of a call site, by lifetime bucket (needs call-site capture too)
+    [[nodiscard]] std::size_t GetSiteLifetimeCount(std::uint16_t site, std::size_t bucket) const noexcept {
+        if (bucket >= LightweightConfig::LifetimeBuckets) return 0;
+        return m_lifetimes.SiteCount(site, bucket);
+    }
+    
+    /// Get blocks freed in the frame that allocated them, over all size classes
+    [[nodiscard]] std::size_t GetSameFrameFreeCount() const noexcept {
+        std::size_t total = 0;
+        for (std::size_t i = 0; i < LightweightConfig::SizeClasses; ++i) {
+            total += m_lifetimes.SizeClassCount(i, 0);
+        }
+        return total;
+    }
+    
     // ========================================================================
     // Tag Management - Lock-Free
     // ========================================================================
@@ -339,7 +467,7 @@ public:
     void RegisterTag(TagId id, const char* name) noexcept {
         if (id >= LightweightConfig::MaxTags || !name) return;
         
-        auto& stats = m_tagStats[id];
+        auto& stats = m_tagInfo[id];
         bool expected = false;
         if (stats.registered.compare_exchange_strong(expected, true, std::memory_order_acq_rel)) {
             // Copy name safely
@@ -355,8 +483,8 @@ public:
     /// Get tag name
     [[nodiscard]] const char* GetTagName(TagId id) const noexcept {
         if (id >= LightweightConfig::MaxTags) return "Unknown";
-        if (!m_tagStats[id].registered.load(std::memory_order_relaxed)) return "Unregistered";
-        return m_tagStats[id].name;
+        if (!m_tagInfo[id].registered.load(std::memory_order_relaxed)) return "Unregistered";
+        return m_tagInfo[id].name;
     }
     
     // ========================================================================
@@ -372,29 +500,74 @@ public:
         return m_enabled.load(std::memory_order_relaxed);
     }
     
+    /// Switch between exact and sampled tracking (safe at any time)
+    /// Live records keep the weight they were recorded with, so totals stay
+    /// consistent across switches; in sampled mode totals are estimates and
+    /// the active allocation list only holds the sampled blocks.
+    /// @param mode Tracking mode
+    /// @param sampleBytes Mean bytes between samples (rounded to a power of two)
+    void SetTrackingMode(TrackingMode mode,
+                         std::size_t sampleBytes = LightweightConfig::DefaultSampleBytes) noexcept {
+        const std::uint8_t shift = mode == TrackingMode::Sampled ? SampleIntervalToShift(sampleBytes) : 0;
+        m_sampleShift.store(shift, std::memory_order_relaxed);
+    }
+    
+    [[nodiscard]] TrackingMode GetTrackingMode() const noexcept {
+        return m_sampleShift.load(std::memory_order_relaxed) != 0 ? TrackingMode::Sampled : TrackingMode::Exact;
+    }
+    
+    /// Enable or disable call-site attribution (safe at any time)
+    /// The site table is allocated from OS pages on first use.
+    void SetCallSiteMode(CallSiteMode mode) noexcept {
+        if (mode != CallSiteMode::Off && !m_sites.Initialize()) {
+            mode = CallSiteMode::Off;
+        }
+        m_callSiteMode.store(mode, std::memory_order_relaxed);
+    }
+    
+    [[nodiscard]] CallSiteMode GetCallSiteMode() const noexcept {
+        return m_callSiteMode.load(std::memory_order_relaxed);
+    }
+    
+    /// Start the next frame (call once per frame, e.g. from the present hook)
+    /// Records are stamped with the frame they were allocated in; lifetimes
+    /// are counted in frames, so without this call every free is "same frame".
+    void AdvanceFrame() noexcept {
+        m_frame.fetch_add(1, std::memory_order_relaxed);
+    }
+    
+    [[nodiscard]] std::uint32_t GetFrame() const noexcept {
+        return m_frame.load(std::memory_order_relaxed);
+    }
+    
+    /// Build lifetime histograms at free time (safe at any time)
+    /// Records are always stamped, so blocks allocated before enabling are
+    /// measured too. The per-site histograms come from OS pages on first use.
+    void SetLifetimeProfiling(bool enabled) noexcept {
+        if (enabled) {
+            m_lifetimes.Initialize();  // Without site pages only the size-class histograms are kept
+        }
+        m_lifetimeProfiling.store(enabled, std::memory_order_relaxed);
+    }
+    
+    [[nodiscard]] bool IsLifetimeProfiling() const noexcept {
+        return m_lifetimeProfiling.load(std::memory_order_relaxed);
+    }
+    
+    /// Get mean sampling interval in bytes (0 in exact mode)
+    [[nodiscard]] std::size_t GetSampleInterval() const noexcept {
+        const std::uint8_t shift = m_sampleShift.load(std::memory_order_relaxed);
+        return shift != 0 ? std::size_t{1} << shift : 0;
+    }
+    
     /// Reset all tracking data (uses spinlock for safety)
     void Reset() noexcept {
         SpinlockGuard guard(m_reportLock);
         
-        if (m_records) {
-            for (std::size_t i = 0; i < LightweightConfig::MaxAllocations; ++i) {
-                m_records[i].address.store(nullptr, std::memory_order_relaxed);
-                m_records[i].size = 0;
-                m_records[i].tag = 0;
-                m_records[i].flags = 0;
-            }
-        }
-        
-        for (std::size_t i = 0; i < LightweightConfig::MaxTags; ++i) {
-            m_tagStats[i].currentBytes.store(0, std::memory_order_relaxed);
-            m_tagStats[i].peakBytes.store(0, std::memory_order_relaxed);
-            m_tagStats[i].allocCount.store(0, std::memory_order_relaxed);
-            m_tagStats[i].freeCount.store(0, std::memory_order_relaxed);
-        }
-        
-        m_totalBytes.store(0, std::memory_order_relaxed);
-        m_peakBytes.store(0, std::memory_order_relaxed);
-        m_activeCount.store(0, std::memory_order_relaxed);
+        m_table.Clear();
+        m_stats.Reset();
+        m_sites.Clear();
+        m_lifetimes.Clear();
         m_droppedAllocations.store(0, std::memory_order_relaxed);
     }
     
@@ -435,27 +608,292 @@ public:
         };
         
         append("=== YU Lightweight Memory Report ===\n");
-        append("Total: "); appendNum(m_totalBytes.load()); append(" bytes\n");
-        append("Peak:  "); appendNum(m_peakBytes.load()); append(" bytes\n");
-        append("Active: "); appendNum(m_activeCount.load()); append(" allocations\n");
+        if (const std::size_t interval = GetSampleInterval()) {
+            append("Mode: Sampled, 1 per "); appendNum(interval);
+            append(" bytes (totals and counts are estimates)\n");
+        } else {
+            append("Mode: Exact\n");
+        }
+        append("Total: "); appendNum(m_stats.TotalBytes()); append(" bytes\n");
+        append("Peak:  "); appendNum(m_stats.PeakBytes());
+        append(HasExactStats ? " bytes\n" : " bytes (sampled)\n");
+        append("Active: "); appendNum(m_stats.ActiveCount()); append(" allocations\n");
+        append("Reallocs: "); appendNum(static_cast<std::size_t>(m_stats.ReallocCount())); append("\n");
         append("Dropped: "); appendNum(m_droppedAllocations.load()); append(" (table full)\n\n");
         
+        const RecordTableStats table = m_table.GetStats();
+        append("--- Record Table ---\n");
+        append("Records: "); appendNum(table.live); append(" / "); appendNum(table.capacity);
+        append(" ("); appendNum(static_cast<std::size_t>(table.loadFactor * 100.0)); append("% load)\n");
+        append("Segments: "); appendNum(table.segments);
+        append(", Tombstones: "); appendNum(table.tombstones); append("\n");
+        append("Probe distance: avg "); appendNum(static_cast<std::size_t>(table.averageProbe));
+        append("."); appendNum(static_cast<std::size_t>(table.averageProbe * 100.0) % 100 / 10);
+        appendNum(static_cast<std::size_t>(table.averageProbe * 100.0) % 10);
+        append(", max "); appendNum(table.maxProbe); append("\n\n");
+        
         append("--- Tag Statistics ---\n");
         for (std::size_t i = 0; i < LightweightConfig::MaxTags; ++i) {
-            const auto& stats = m_tagStats[i];
-            if (stats.allocCount.load(std::memory_order_relaxed) > 0) {
+            const std::uint64_t allocs = m_stats.TagAllocCount(i);
+            if (allocs > 0) {
+                const auto& info = m_tagInfo[i];
                 append("[");
-                if (stats.registered.load(std::memory_order_relaxed)) {
-                    append(stats.name);
+                if (info.registered.load(std::memory_order_relaxed)) {
+                    append(info.name);
                 } else {
                     append("Tag "); appendNum(i);
                 }
                 append("] ");
-                append("Current: "); appendNum(stats.currentBytes.load()); append(" bytes, ");
-                append("Peak: "); appendNum(stats.peakBytes.load()); append(" bytes, ");
-                append("Allocs: "); appendNum(stats.allocCount.load()); append(", ");
-                append("Frees: "); appendNum(stats.freeCount.load()); append("\n");
+                append("Current: "); appendNum(m_stats.TagBytes(i)); append(" bytes, ");
+                append("Peak: "); appendNum(m_stats.TagPeakBytes(i)); append(" bytes, ");
+                append("Allocs: "); appendNum(static_cast<std::size_t>(allocs)); append(", ");
+                append("Frees: "); appendNum(static_cast<std::size_t>(m_stats.TagFreeCount(i))); append("\n");
+            }
+        }
+        
+        buffer[written] = '\0';
+        return written;
+    }
+    
+    /// Generate the call-site rankings into a preallocated buffer
+    /// Lists the top sites by live bytes and by allocation rate since the
+    /// previous call (or since capture started). Frames are absolute return
+    /// addresses, directly comparable with abyss::offsets.
+    /// @param buffer Output buffer
+    /// @param bufferSize Size of output buffer
+    /// @return Number of characters written (excluding null terminator)
+    std::size_t GenerateCallSiteReport(char* buffer, std::size_t bufferSize) const noexcept {
+        if (!buffer || bufferSize == 0) return 0;
+        
+        SpinlockGuard guard(m_reportLock);
+        
+        std::size_t written = 0;
+        auto append = [&](const char* str) {
+            while (*str && written < bufferSize - 1) {
+                buffer[written++] = *str++;
+            }
+        };
+        
+        auto appendNum = [&](std::size_t num) {
+            char temp[32];
+            int i = 0;
+            if (num == 0) {
+                temp[i++] = '0';
+            } else {
+                while (num > 0 && i < 31) {
+                    temp[i++] = '0' + (num % 10);
+                    num /= 10;
+                }
+            }
+            while (--i >= 0 && written < bufferSize - 1) {
+                buffer[written++] = temp[i];
+            }
+        };
+        
+        auto appendHex = [&](std::uintptr_t value) {
+            const char hexChars[] = "0123456789ABCDEF";
+            append("0x");
+            for (int shift = (sizeof(void*) * 8) - 4; shift >= 0 && written < bufferSize - 1; shift -= 4) {
+                buffer[written++] = hexChars[(value >> shift) & 0xF];
+            }
+        };
+        
+        append("--- Call Sites ---\n");
+        if (!m_sites.IsValid()) {
+            append("(capture disabled)\n");
+            buffer[written] = '\0';
+            return written;
+        }
+        append("Sites: "); appendNum(m_sites.GetCount());
+        append(", Overflow: "); appendNum(m_sites.GetOverflowCount()); append("\n");
+        
+        // Rates are measured over the interval since the previous report
+        const std::uint64_t now = GetTickCount64Ms();
+        const std::uint64_t elapsedMs = now > m_lastSiteReportMs ? now - m_lastSiteReportMs : 1;
+        m_lastSiteReportMs = now;
+        
+        // Fixed-size top-N rankings by insertion (no allocation)
+        constexpr std::size_t TopN = LightweightConfig::TopCallSites;
+        struct Ranked {
+            const CallSite* site;
+            std::size_t key;
+        };
+        Ranked byLive[TopN]{};
+        Ranked byRate[TopN]{};
+        auto insertRanked = [](Ranked (&ranking)[TopN], const CallSite* site, std::size_t key) {
+            if (key == 0 || (ranking[TopN - 1].site && ranking[TopN - 1].key >= key)) return;
+            std::size_t pos = TopN - 1;
+            while (pos > 0 && (!ranking[pos - 1].site || ranking[pos - 1].key < key)) {
+                ranking[pos] = ranking[pos - 1];
+                --pos;
+            }
+            ranking[pos] = Ranked{site, key};
+        };
+        
+        m_sites.ForEach([&](std::uint16_t, CallSite& site) {
+            const std::size_t allocs = site.allocCount.load(std::memory_order_relaxed);
+            insertRanked(byLive, &site, site.liveBytes.load(std::memory_order_relaxed));
+            insertRanked(byRate, &site, allocs - site.reportedAllocs);
+            site.reportedAllocs = allocs;
+        });
+        
+        auto appendSite = [&](const CallSite& site) {
+            append(" ");
+            for (std::size_t f = 0; f < site.depth; ++f) {
+                append(" ");
+                appendHex(reinterpret_cast<std::uintptr_t>(site.frames[f]));
+            }
+            append("\n");
+        };
+        
+        append("\nTop by live bytes:\n");
+        for (const Ranked& entry : byLive) {
+            if (!entry.site) break;
+            append("  "); appendNum(entry.key); append(" bytes in ");
+            appendNum(entry.site->liveCount.load(std::memory_order_relaxed)); append(" blocks");
+            appendSite(*entry.site);
+        }
+        
+        append("\nTop by allocation rate (over "); appendNum(static_cast<std::size_t>(elapsedMs));
+        append(" ms):\n");
+        for (const Ranked& entry : byRate) {
+            if (!entry.site) break;
+            append("  "); appendNum(static_cast<std::size_t>(entry.key * 1000 / elapsedMs));
+            append("/s ("); appendNum(entry.key); append(" allocs)");
+            appendSite(*entry.site);
+        }
+        
+        buffer[written] = '\0';
+        return written;
+    }
+    
+    /// Generate the lifetime histograms into a preallocated buffer
+    /// One row per size class with frees, then the call sites with the most
+    /// blocks freed in the frame that allocated them: where pooling or the
+    /// frame allocator would pay off most.
+    /// @param buffer Output buffer
+    /// @param bufferSize Size of output buffer
+    /// @return Number of characters written (excluding null terminator)
+    std::size_t GenerateLifetimeReport(char* buffer, std::size_t bufferSize) const noexcept {
+        if (!buffer || bufferSize == 0) return 0;
+        
+        SpinlockGuard guard(m_reportLock);
+        
+        std::size_t written = 0;
+        auto append = [&](const char* str) {
+            while (*str && written < bufferSize - 1) {
+                buffer[written++] = *str++;
+            }
+        };
+        
+        auto appendNum = [&](std::size_t num) {
+            char temp[32];
+            int i = 0;
+            if (num == 0) {
+                temp[i++] = '0';
+            } else {
+                while (num > 0 && i < 31) {
+                    temp[i++] = '0' + (num % 10);
+                    num /= 10;
+                }
             }
+            while (--i >= 0 && written < bufferSize - 1) {
+                buffer[written++] = temp[i];
+            }
+        };
+        
+        auto appendHex = [&](std::uintptr_t value) {
+            const char hexChars[] = "0123456789ABCDEF";
+            append("0x");
+            for (int shift = (sizeof(void*) * 8) - 4; shift >= 0 && written < bufferSize - 1; shift -= 4) {
+                buffer[written++] = hexChars[(value >> shift) & 0xF];
+            }
+        };
+        
+        constexpr std::size_t Buckets = LightweightConfig::LifetimeBuckets;
+        append("--- Lifetimes (frames) ---\n");
+        if (!m_lifetimeProfiling.load(std::memory_order_relaxed)) {
+            append("(profiling disabled)\n");
+            buffer[written] = '\0';
+            return written;
+        }
+        
+        std::size_t frees = 0;
+        std::size_t sameFrame = 0;
+        for (std::size_t cls = 0; cls < LightweightConfig::SizeClasses; ++cls) {
+            for (std::size_t b = 0; b < Buckets; ++b) frees += m_lifetimes.SizeClassCount(cls, b);
+            sameFrame += m_lifetimes.SizeClassCount(cls, 0);
+        }
+        append("Frame: "); appendNum(m_frame.load(std::memory_order_relaxed));
+        append(", Frees: "); appendNum(frees);
+        append(", Same frame: "); appendNum(sameFrame);
+        append(" ("); appendNum(frees > 0 ? sameFrame * 100 / frees : 0); append("%)\n");
+        
+        // Header: bucket lower bounds, the last one open
+        append("Buckets: 0 1");
+        for (std::size_t b = 2; b < Buckets; ++b) {
+            append(" "); appendNum(std::size_t{1} << (b - 1));
+            append(b + 1 < Buckets ? "-" : "+");
+            if (b + 1 < Buckets) appendNum((std::size_t{1} << b) - 1);
+        }
+        append("\n");
+        
+        for (std::size_t cls = 0; cls < LightweightConfig::SizeClasses; ++cls) {
+            std::size_t classFrees = 0;
+            for (std::size_t b = 0; b < Buckets; ++b) classFrees += m_lifetimes.SizeClassCount(cls, b);
+            if (classFrees == 0) continue;
+            
+            // Class k holds [2^k, 2^(k+1)) bytes, class 0 also holds empty blocks
+            append("["); appendNum(cls == 0 ? 0 : std::size_t{1} << cls);
+            if (cls + 1 < LightweightConfig::SizeClasses) {
+                append("-"); appendNum((std::size_t{1} << (cls + 1)) - 1); append(" B] ");
+            } else {
+                append("+ B] ");
+            }
+            appendNum(classFrees); append(" frees, ");
+            appendNum(m_lifetimes.SizeClassCount(cls, 0) * 100 / classFrees); append("% same frame:");
+            for (std::size_t b = 0; b < Buckets; ++b) {
+                append(" "); appendNum(m_lifetimes.SizeClassCount(cls, b));
+            }
+            append("\n");
+        }
+        
+        if (!m_sites.IsValid() || !m_lifetimes.HasSites()) {
+            buffer[written] = '\0';
+            return written;
+        }
+        
+        // Fixed-size top-N ranking by insertion (no allocation)
+        constexpr std::size_t TopN = LightweightConfig::TopCallSites;
+        struct Ranked {
+            std::uint16_t id;
+            const CallSite* site;
+            std::size_t key;
+        };
+        Ranked bySameFrame[TopN]{};
+        m_sites.ForEach([&](std::uint16_t id, const CallSite& site) {
+            const std::size_t key = m_lifetimes.SiteCount(id, 0);
+            if (key == 0 || (bySameFrame[TopN - 1].site && bySameFrame[TopN - 1].key >= key)) return;
+            std::size_t pos = TopN - 1;
+            while (pos > 0 && (!bySameFrame[pos - 1].site || bySameFrame[pos - 1].key < key)) {
+                bySameFrame[pos] = bySameFrame[pos - 1];
+                --pos;
+            }
+            bySameFrame[pos] = Ranked{id, &site, key};
+        });
+        
+        append("\nTop by same-frame frees:\n");
+        for (const Ranked& entry : bySameFrame) {
+            if (!entry.site) break;
+            std::size_t siteFrees = 0;
+            for (std::size_t b = 0; b < Buckets; ++b) siteFrees += m_lifetimes.SiteCount(entry.id, b);
+            append("  "); appendNum(entry.key); append(" of "); appendNum(siteFrees); append(" frees");
+            append(" ");
+            for (std::size_t f = 0; f < entry.site->depth; ++f) {
+                append(" ");
+                appendHex(reinterpret_cast<std::uintptr_t>(entry.site->frames[f]));
+            }
+            append("\n");
         }
         
         buffer[written] = '\0';
@@ -481,28 +919,39 @@ public:
     bool WriteReportToFile(const char* filename) const noexcept {
         if (!filename) return false;
         
-        #ifdef _WIN32
-        HANDLE hFile = CreateFileA(filename, GENERIC_WRITE, 0, nullptr,
-                                   CREATE_ALWAYS, FILE_ATTRIBUTE_NORMAL, nullptr);
-        if (hFile == INVALID_HANDLE_VALUE) return false;
+        // Staged in a page buffer and written in large blocks; sync flush, so no thread or heap use
+        io::StreamWriter file;
+        io::StreamWriterConfig config;
+        config.bufferSize = 64 * 1024;
+        if (!file.Open(filename, io::StreamMode::Truncate, config)) return false;
         
         // Write basic report
         char buffer[8192];
         std::size_t len = GenerateReport(buffer, sizeof(buffer));
-        DWORD written = 0;
-        WriteFile(hFile, buffer, static_cast<DWORD>(len), &written, nullptr);
+        file.Write(buffer, len);
+        
+        // Call-site rankings, if capture was ever enabled
+        if (m_sites.IsValid()) {
+            len = GenerateCallSiteReport(buffer, sizeof(buffer));
+            file.Put('\n');
+            file.Write(buffer, len);
+        }
+        
+        // Lifetime histograms, while profiling
+        if (m_lifetimeProfiling.load(std::memory_order_relaxed)) {
+            len = GenerateLifetimeReport(buffer, sizeof(buffer));
+            file.Put('\n');
+            file.Write(buffer, len);
+        }
         
         // Write active allocations section
-        const char* header = "\n--- Active Allocations ---\n";
-        WriteFile(hFile, header, static_cast<DWORD>(std::strlen(header)), &written, nullptr);
+        file.Write(std::string_view("\n--- Active Allocations ---\n"));
         
         SpinlockGuard guard(m_reportLock);
         
         std::size_t count = 0;
-        for (std::size_t i = 0; i < LightweightConfig::MaxAllocations && count < 10000; ++i) {
-            const auto& slot = m_records[i];
-            void* addr = slot.address.load(std::memory_order_relaxed);
-            if (addr != nullptr) {
+        m_table.ForEach([&](void* addr, const CompactRecord& slot) {
+            if (count < 10000) {
                 // Format: Address: 0xXXXXXXXX, Size: NNNN, Tag: TTT
                 char line[128];
                 std::size_t pos = 0;
@@ -543,8 +992,8 @@ public:
                 // Tag name or number
                 TagId tag = slot.tag;
                 if (tag < LightweightConfig::MaxTags && 
-                    m_tagStats[tag].registered.load(std::memory_order_relaxed)) {
-                    const char* tagName = m_tagStats[tag].name;
+                    m_tagInfo[tag].registered.load(std::memory_order_relaxed)) {
+                    const char* tagName = m_tagInfo[tag].name;
                     while (*tagName && pos < 120) line[pos++] = *tagName++;
                 } else {
                     std::uint16_t t = tag;
@@ -561,10 +1010,10 @@ public:
                 }
                 
                 line[pos++] = '\n';
-                WriteFile(hFile, line, static_cast<DWORD>(pos), &written, nullptr);
+                file.Write(line, pos);
                 ++count;
             }
-        }
+        });
         
         // Write total count
         char footer[64];
@@ -584,32 +1033,15 @@ public:
         }
         while (--numPos >= 0) footer[footerPos++] = numBuf[numPos];
         footer[footerPos++] = '\n';
-        WriteFile(hFile, footer, static_cast<DWORD>(footerPos), &written, nullptr);
-        
-        CloseHandle(hFile);
-        return true;
-        #else
-        // POSIX implementation
-        int fd = open(filename, O_WRONLY | O_CREAT | O_TRUNC, 0644);
-        if (fd < 0) return false;
+        file.Write(footer, footerPos);
         
-        char buffer[8192];
-        std::size_t len = GenerateReport(buffer, sizeof(buffer));
-        write(fd, buffer, len);
-        
-        close(fd);
-        return true;
-        #endif
+        return file.Close().has_value();
     }
     
     /// Get number of active allocations for iteration
     [[nodiscard]] std::size_t CountActiveAllocations() const noexcept {
         std::size_t count = 0;
-        for (std::size_t i = 0; i < LightweightConfig::MaxAllocations; ++i) {
-            if (m_records[i].address.load(std::memory_order_relaxed) != nullptr) {
-                ++count;
-            }
-        }
+        m_table.ForEach([&](void*, const CompactRecord&) { ++count; });
         return count;
     }
     
@@ -618,13 +1050,22 @@ public:
     template<typename Callback>
     void ForEachAllocation(Callback&& callback) const noexcept {
         SpinlockGuard guard(m_reportLock);
-        for (std::size_t i = 0; i < LightweightConfig::MaxAllocations; ++i) {
-            const auto& slot = m_records[i];
-            void* addr = slot.address.load(std::memory_order_relaxed);
-            if (addr != nullptr) {
-                callback(addr, slot.size, slot.tag);
-            }
-        }
+        m_table.ForEach([&](void* addr, const CompactRecord& slot) {
+            callback(addr, slot.size, slot.tag);
+        });
+    }
+    
+    /// Position of an incremental walk (see ScanAllocations)
+    using ScanCursor = RecordTable<LightweightConfig>::Cursor;
+    
+    /// Visit the allocations in the next maxSlots record slots (no lock)
+    /// Used by the background snapshot walk (memory_snapshot.h), which covers
+    /// the table in chunks so allocating threads are never held up.
+    /// @param callback Function called for each allocation: void(void* addr, const CompactRecord& record)
+    /// @return false once the whole table has been covered
+    template<typename Callback>
+    bool ScanAllocations(ScanCursor& cursor, std::size_t maxSlots, Callback&& callback) const noexcept {
+        return m_table.ForEachChunk(cursor, maxSlots, callback);
     }
     
     // Prevent copying
@@ -632,36 +1073,17 @@ public:
     LightweightTracker& operator=(const LightweightTracker&) = delete;
     
     ~LightweightTracker() noexcept {
-        // Free the dynamically allocated records buffer
-        if (m_records) {
-            #ifdef _WIN32
-            VirtualFree(m_records, 0, MEM_RELEASE);
-            #else
-            std::free(m_records);
-            #endif
-            m_records = nullptr;
-        }
+        // Return the record segments, site table and lifetime histograms to the OS
+        m_table.Release();
+        m_sites.Release();
+        m_lifetimes.Release();
     }
     
 private:
     LightweightTracker() noexcept {
-        // Allocate records buffer using OS allocation (bypasses CRT which may be hooked)
-        #ifdef _WIN32
-        m_records = static_cast<CompactRecord*>(
-            VirtualAlloc(nullptr, 
-                        sizeof(CompactRecord) * LightweightConfig::MaxAllocations,
-                        MEM_COMMIT | MEM_RESERVE, 
-                        PAGE_READWRITE));
-        #else
-        m_records = static_cast<CompactRecord*>(
-            std::aligned_alloc(alignof(CompactRecord),
-                              sizeof(CompactRecord) * LightweightConfig::MaxAllocations));
-        #endif
-        
-        // Zero-initialize the buffer (VirtualAlloc does this on Windows, but be explicit)
-        if (m_records) {
-            std::memset(m_records, 0, sizeof(CompactRecord) * LightweightConfig::MaxAllocations);
-        }
+        // First record segment comes from OS pages (bypasses CRT which may be hooked)
+        m_table.Initialize();
+        m_lastSiteReportMs = GetTickCount64Ms();
         
         // Initialize default tag names
         RegisterTag(Tags::General, "General");
@@ -676,30 +1098,60 @@ private:
         RegisterTag(Tags::Temporary, "Temporary");
     }
     
-    void updateGlobalPeak() noexcept {
-        std::size_t current = m_totalBytes.load(std::memory_order_relaxed);
-        std::size_t peak = m_peakBytes.load(std::memory_order_relaxed);
-        while (current > peak) {
-            if (m_peakBytes.compare_exchange_weak(peak, current, std::memory_order_relaxed)) {
-                break;
-            }
+    /// Intern the current call site (recorded allocations only)
+    std::uint16_t captureCallSite(CallSiteMode mode, const void* caller) noexcept {
+        void* frames[LightweightConfig::MaxCallSiteFrames];
+        std::size_t depth = 0;
+        #ifdef _WIN32
+        if (mode == CallSiteMode::StackTrace) {
+            // Skip this frame; RecordAllocation is usually inlined into the hook
+            depth = RtlCaptureStackBackTrace(1, static_cast<DWORD>(LightweightConfig::MaxCallSiteFrames),
+                                             frames, nullptr);
+        }
+        #else
+        (void)mode;
+        #endif
+        if (depth == 0 && caller) {
+            frames[0] = const_cast<void*>(caller);
+            depth = 1;
         }
+        return m_sites.Intern(frames, depth);
     }
     
-    // Dynamically allocated hash table for allocation records (allocated via VirtualAlloc)
-    CompactRecord* m_records{nullptr};
+    static std::uint64_t GetTickCount64Ms() noexcept {
+        #ifdef _WIN32
+        return GetTickCount64();
+        #else
+        timespec ts;
+        clock_gettime(CLOCK_MONOTONIC, &ts);
+        return static_cast<std::uint64_t>(ts.tv_sec) * 1000 + static_cast<std::uint64_t>(ts.tv_nsec) / 1000000;
+        #endif
+    }
     
-    // Per-tag statistics (cache-line aligned)
-    AtomicTagStats m_tagStats[LightweightConfig::MaxTags]{};
+    // Segmented hash table for allocation records (OS pages, grows lock-free)
+    mutable RecordTable<LightweightConfig> m_table;
     
-    // Global statistics
-    alignas(64) std::atomic<std::size_t> m_totalBytes{0};
-    std::atomic<std::size_t> m_peakBytes{0};
-    std::atomic<std::size_t> m_activeCount{0};
-    std::atomic<std::size_t> m_droppedAllocations{0};
+    // Tag names
+    TagInfo m_tagInfo[LightweightConfig::MaxTags]{};
+    
+    // Byte/count totals and peaks (exact or sharded, see memory_stats.h)
+    TrackerStats<LightweightConfig> m_stats;
+    
+    alignas(64) std::atomic<std::size_t> m_droppedAllocations{0};
     
     // Control
     std::atomic<bool> m_enabled{true};
+    std::atomic<std::uint8_t> m_sampleShift{0};  // 0 = TrackingMode::Exact
+    std::atomic<CallSiteMode> m_callSiteMode{CallSiteMode::Off};
+    
+    // Call-site attribution (allocated on first SetCallSiteMode)
+    CallSiteTable<LightweightConfig> m_sites;
+    mutable std::uint64_t m_lastSiteReportMs{0};
+    
+    // Lifetime profiling: the frame stamped into records and the histograms built at free
+    alignas(64) std::atomic<std::uint32_t> m_frame{0};
+    std::atomic<bool> m_lifetimeProfiling{false};
+    LifetimeTable<LightweightConfig> m_lifetimes;
     
     // Only for report generation (cold path)
     mutable Spinlock m_reportLock;
@@ -0,0 +1,120 @@
+/**
+ * @file memory_os.h
+ * @brief Page-level OS allocation that bypasses the CRT heap
+ *
+ * Internal storage for the trackers (and anything else that runs next to a
+ * hooked malloc/operator new) must never recurse into the allocator it is
+ * observing. These helpers go straight to VirtualAlloc/mmap.
+ *
+ * Pages are always returned zero-filled and read/write. PrivateHeap serves
+ * smaller blocks from a heap of its own (HeapCreate on Windows).
+ */
+
+#pragma once
+
+#ifdef _WIN32
+    #ifndef WIN32_LEAN_AND_MEAN
+        #define WIN32_LEAN_AND_MEAN
+    #endif
+    #include <Windows.h>
+#else
+    #include <sys/mman.h>
+    #include <unistd.h>
+#endif
+
+#include <cstddef>
+
+namespace yu {
+namespace mem {
+namespace os {
+
+/// Get the OS page size
+[[nodiscard]] inline std::size_t PageSize() noexcept {
+#ifdef _WIN32
+    SYSTEM_INFO info;
+    GetSystemInfo(&info);
+    return static_cast<std::size_t>(info.dwPageSize);
+#else
+    return static_cast<std::size_t>(sysconf(_SC_PAGESIZE));
+#endif
+}
+
+/// Reserve and commit zero-filled pages
+/// @param size Size in bytes (rounded up to whole pages by the OS)
+/// @return Pointer to the pages, or nullptr on failure
+[[nodiscard]] inline void* AllocatePages(std::size_t size) noexcept {
+    if (size == 0) return nullptr;
+#ifdef _WIN32
+    return VirtualAlloc(nullptr, size, MEM_COMMIT | MEM_RESERVE, PAGE_READWRITE);
+#else
+    void* ptr = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    return ptr == MAP_FAILED ? nullptr : ptr;
+#endif
+}
+
+/// Release pages obtained from AllocatePages
+/// @param ptr Pointer returned by AllocatePages
+/// @param size The size that was passed to AllocatePages
+inline void FreePages(void* ptr, std::size_t size) noexcept {
+    if (!ptr) return;
+#ifdef _WIN32
+    (void)size;
+    VirtualFree(ptr, 0, MEM_RELEASE);
+#else
+    munmap(ptr, size);
+#endif
+}
+
+/// Private heap that is never detoured, for storage sized below whole pages
+///
+/// On Windows this is a HeapCreate heap: HeapAlloc on it does not go through
+/// the CRT malloc/operator new that the hooks replace. Elsewhere each block is
+/// its own page mapping.
+class PrivateHeap {
+public:
+    PrivateHeap() noexcept {
+#ifdef _WIN32
+        m_heap = HeapCreate(0, 0, 0);
+#endif
+    }
+
+    ~PrivateHeap() noexcept {
+#ifdef _WIN32
+        if (m_heap) HeapDestroy(m_heap);
+#endif
+    }
+
+    PrivateHeap(const PrivateHeap&) = delete;
+    PrivateHeap& operator=(const PrivateHeap&) = delete;
+
+    /// Allocate zero-filled memory, or nullptr on failure
+    [[nodiscard]] void* Allocate(std::size_t size) noexcept {
+        if (size == 0) return nullptr;
+#ifdef _WIN32
+        return m_heap ? HeapAlloc(m_heap, HEAP_ZERO_MEMORY, size) : nullptr;
+#else
+        return AllocatePages(size);
+#endif
+    }
+
+    /// Free memory obtained from Allocate
+    /// @param size The size that was passed to Allocate
+    void Free(void* ptr, std::size_t size) noexcept {
+        if (!ptr) return;
+#ifdef _WIN32
+        (void)size;
+        HeapFree(m_heap, 0, ptr);
+#else
+        FreePages(ptr, size);
+#endif
+    }
+
+private:
+#ifdef _WIN32
+    HANDLE m_heap = nullptr;
+#endif
+};
+
+} // namespace os
+} // namespace mem
+} // namespace yu
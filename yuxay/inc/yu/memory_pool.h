@@ -0,0 +1,224 @@
+/**
+ * @file memory_pool.h
+ * @brief Fixed-size block pools backed by OS pages
+ *
+ * FixedBlockPool hands out blocks of one size from slabs of pages, keeping
+ * freed blocks on an intrusive free list, so Allocate/Deallocate are a few
+ * instructions and never touch the heap. Pool<T> constructs objects in it;
+ * PoolAllocator<T> lets node-based std containers (list, map, unordered_map
+ * nodes) draw from it.
+ *
+ * Slabs are reported to the tracker as AllocationType::Pool under the pool's
+ * tag, one record per slab; LiveCount() shows the blocks in use.
+ *
+ * A pool is not thread-safe; guard it externally if it is shared.
+ */
+
+#pragma once
+
+#include "memory.h"
+#include "memory_os.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <utility>
+
+namespace yu {
+namespace mem {
+
+// ============================================================================
+// FixedBlockPool
+// ============================================================================
+
+class FixedBlockPool {
+    struct FreeBlock { FreeBlock* next; };
+    struct Slab { Slab* next; std::size_t size; };
+
+public:
+    /// Default size of each slab of pages
+    static constexpr std::size_t DefaultSlabSize = 64 * 1024;
+
+    /// @param blockSize Size of each block (at least a pointer)
+    /// @param alignment Alignment of each block (power of two)
+    FixedBlockPool(std::size_t blockSize, std::size_t alignment = alignof(std::max_align_t),
+                   TagId tag = Tags::General, std::size_t slabSize = DefaultSlabSize) noexcept
+        : m_alignment(alignment < alignof(FreeBlock) ? alignof(FreeBlock) : alignment)
+        , m_blockSize(AlignUp(blockSize < sizeof(FreeBlock) ? sizeof(FreeBlock) : blockSize, m_alignment))
+        , m_slabSize(slabSize)
+        , m_tag(tag) {
+        if (m_slabSize < FirstOffset() + m_blockSize * 8) {
+            m_slabSize = AlignUp(FirstOffset() + m_blockSize * 8, DefaultSlabSize);
+        }
+    }
+
+    ~FixedBlockPool() noexcept { Release(); }
+
+    FixedBlockPool(const FixedBlockPool&) = delete;
+    FixedBlockPool& operator=(const FixedBlockPool&) = delete;
+
+    /// Take one block (nullptr only if the OS is out of pages)
+    [[nodiscard]] void* Allocate() noexcept {
+        if (!m_free && !AddSlab()) return nullptr;
+        FreeBlock* block = m_free;
+        m_free = block->next;
+        ++m_live;
+        return block;
+    }
+
+    /// Return a block obtained from Allocate
+    void Deallocate(void* ptr) noexcept {
+        if (!ptr) return;
+        auto* block = static_cast<FreeBlock*>(ptr);
+        block->next = m_free;
+        m_free = block;
+        --m_live;
+    }
+
+    /// Return every slab to the OS; outstanding blocks become invalid
+    void Release() noexcept {
+        Slab* slab = m_slabs;
+        while (slab) {
+            Slab* next = slab->next;
+#if YU_MEMORY_TRACKING_ENABLED
+            MemoryTracker::Instance().RecordDeallocation(slab);
+#endif
+            os::FreePages(slab, slab->size);
+            slab = next;
+        }
+        m_slabs = nullptr;
+        m_free = nullptr;
+        m_live = 0;
+        m_capacity = 0;
+    }
+
+    [[nodiscard]] std::size_t BlockSize() const noexcept { return m_blockSize; }
+    [[nodiscard]] std::size_t Alignment() const noexcept { return m_alignment; }
+    /// Blocks currently handed out
+    [[nodiscard]] std::size_t LiveCount() const noexcept { return m_live; }
+    /// Blocks in all slabs
+    [[nodiscard]] std::size_t Capacity() const noexcept { return m_capacity; }
+    [[nodiscard]] TagId Tag() const noexcept { return m_tag; }
+
+private:
+    static std::size_t AlignUp(std::size_t value, std::size_t alignment) noexcept {
+        return (value + alignment - 1) & ~(alignment - 1);
+    }
+
+    std::size_t FirstOffset() const noexcept {
+        return AlignUp(sizeof(Slab), m_alignment);
+    }
+
+    bool AddSlab() noexcept {
+        auto* slab = static_cast<Slab*>(os::AllocatePages(m_slabSize));
+        if (!slab) return false;
+        slab->size = m_slabSize;
+        slab->next = m_slabs;
+        m_slabs = slab;
+#if YU_MEMORY_TRACKING_ENABLED
+        MemoryTracker::Instance().RecordAllocation(slab, m_slabSize, m_alignment, m_tag, AllocationType::Pool);
+#endif
+
+        // Thread the new blocks onto the free list in address order
+        char* base = reinterpret_cast<char*>(slab);
+        const std::size_t count = (m_slabSize - FirstOffset()) / m_blockSize;
+        for (std::size_t i = count; i > 0; --i) {
+            auto* block = reinterpret_cast<FreeBlock*>(base + FirstOffset() + (i - 1) * m_blockSize);
+            block->next = m_free;
+            m_free = block;
+        }
+        m_capacity += count;
+        return true;
+    }
+
+    std::size_t m_alignment;
+    std::size_t m_blockSize;
+    std::size_t m_slabSize;
+    TagId       m_tag;
+    Slab*       m_slabs = nullptr;
+    FreeBlock*  m_free = nullptr;
+    std::size_t m_live = 0;
+    std::size_t m_capacity = 0;
+};
+
+// ============================================================================
+// Pool<T>
+// ============================================================================
+
+/// Object pool for T
+template<typename T>
+class Pool {
+public:
+    explicit Pool(TagId tag = Tags::General, std::size_t slabSize = FixedBlockPool::DefaultSlabSize) noexcept
+        : m_pool(sizeof(T), alignof(T), tag, slabSize) {}
+
+    /// Construct a T in the pool
+    template<typename... Args>
+    [[nodiscard]] T* New(Args&&... args) {
+        void* mem = m_pool.Allocate();
+        return mem ? new (mem) T(std::forward<Args>(args)...) : nullptr;
+    }
+
+    /// Destroy a T obtained from New
+    void Delete(T* ptr) noexcept {
+        if (!ptr) return;
+        ptr->~T();
+        m_pool.Deallocate(ptr);
+    }
+
+    [[nodiscard]] std::size_t LiveCount() const noexcept { return m_pool.LiveCount(); }
+    [[nodiscard]] FixedBlockPool& Blocks() noexcept { return m_pool; }
+
+private:
+    FixedBlockPool m_pool;
+};
+
+// ============================================================================
+// Standard Allocator Adaptor
+// ============================================================================
+
+/// std allocator serving single objects of up to BlockSize() bytes from a pool
+///
+/// Rebinding keeps the pool, so a container's nodes come from it as long as
+/// the pool blocks are large enough for them. Arrays and larger objects (for
+/// example an unordered_map's bucket array) fall back to the tagged heap.
+template<typename T>
+class PoolAllocator {
+public:
+    using value_type = T;
+
+    explicit PoolAllocator(FixedBlockPool& pool) noexcept : m_pool(&pool) {}
+
+    template<typename U>
+    PoolAllocator(const PoolAllocator<U>& other) noexcept : m_pool(other.GetPool()) {}
+
+    [[nodiscard]] T* allocate(std::size_t n) {
+        void* ptr = FitsPool(n) ? m_pool->Allocate()
+                                : AllocateAligned(sizeof(T) * n, alignof(T), m_pool->Tag());
+        if (!ptr) throw std::bad_alloc();
+        return static_cast<T*>(ptr);
+    }
+
+    void deallocate(T* ptr, std::size_t n) noexcept {
+        if (FitsPool(n)) {
+            m_pool->Deallocate(ptr);
+        } else {
+            FreeAligned(ptr);
+        }
+    }
+
+    [[nodiscard]] FixedBlockPool* GetPool() const noexcept { return m_pool; }
+
+    template<typename U>
+    bool operator==(const PoolAllocator<U>& other) const noexcept { return m_pool == other.GetPool(); }
+
+private:
+    bool FitsPool(std::size_t n) const noexcept {
+        return n == 1 && sizeof(T) <= m_pool->BlockSize() && alignof(T) <= m_pool->Alignment();
+    }
+
+    FixedBlockPool* m_pool;
+};
+
+} // namespace mem
+} // namespace yu
@@ -0,0 +1,463 @@
+/**
+ * @file memory_records.h
+ * @brief Segmented, lock-free allocation record table for LightweightTracker
+ *
+ * Open-addressed hash table keyed by allocation address:
+ * - Deleted slots become tombstones, so a free never cuts a probe chain and
+ *   later lookups in the same cluster still find their record
+ * - An insert reserves its slot, fills the payload and only then publishes
+ *   the address, so a reader that finds the address sees the whole record
+ * - Tombstones are reused by later inserts
+ * - The table grows by publishing additional, doubling-size segments
+ *   (VirtualAlloc/mmap, never the CRT) with a single CAS; existing records
+ *   never move, so the hot path stays lock-free
+ * - Health statistics (load factor, tombstones, probe distances) are computed
+ *   by a cold-path scan, so they add nothing to insert/erase
+ */
+
+#pragma once
+
+#include "memory_os.h"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+namespace yu {
+namespace mem {
+
+// ============================================================================
+// Compact Allocation Record
+// ============================================================================
+
+/// Copy of the payload of a record (everything but the address)
+struct RecordInfo {
+    std::uint32_t size{0};
+    std::uint16_t tag{0};
+    std::uint8_t  flags{0};
+    std::uint8_t  sampleShift{0};
+    std::uint16_t site{0};
+    std::uint16_t birth{0};
+};
+
+/// Minimal allocation record - 16 bytes on 32-bit, 24 bytes on 64-bit
+struct CompactRecord {
+    std::atomic<void*> address{nullptr};  // nullptr = empty slot, Tombstone() = deleted, Reserved() = being filled
+    std::uint32_t      size{0};
+    std::uint16_t      tag{0};
+    std::uint8_t       flags{0};          // AllocationType in lower 4 bits
+    std::uint8_t       sampleShift{0};    // log2 of the sampling interval, 0 = exact
+    std::uint16_t      site{0};           // Call-site id, 0 = unknown (memory_callsites.h)
+    std::uint16_t      birth{0};          // Tracker frame at allocation, low 16 bits (memory_lifetime.h)
+
+    /// Marker left behind by an erase (never a valid allocation address)
+    [[nodiscard]] static void* Tombstone() noexcept {
+        return reinterpret_cast<void*>(std::uintptr_t{1});
+    }
+
+    /// Marker of a slot claimed by an insert whose payload is not written yet
+    [[nodiscard]] static void* Reserved() noexcept {
+        return reinterpret_cast<void*>(std::uintptr_t{2});
+    }
+
+    /// True for an address that names a live record (not empty, deleted or reserved)
+    [[nodiscard]] static bool IsRecordAddress(const void* addr) noexcept {
+        return reinterpret_cast<std::uintptr_t>(addr) > std::uintptr_t{2};
+    }
+
+    bool isEmpty() const noexcept {
+        return address.load(std::memory_order_relaxed) == nullptr;
+    }
+
+    /// True if the slot holds a live record
+    bool isLive() const noexcept {
+        return IsRecordAddress(address.load(std::memory_order_acquire));
+    }
+
+    [[nodiscard]] RecordInfo Info() const noexcept {
+        return RecordInfo{size, tag, flags, sampleShift, site, birth};
+    }
+};
+static_assert(sizeof(void*) != 4 || sizeof(CompactRecord) == 16, "CompactRecord grew past 16 bytes on 32-bit");
+
+namespace detail {
+
+/// Hash an allocation address
+/// Allocator pointers are 8/16-byte aligned, so the low bits carry no
+/// information; a Fibonacci multiply spreads the remaining bits and the
+/// well-mixed high half of the product is returned.
+[[nodiscard]] inline std::size_t HashPointer(const void* ptr) noexcept {
+    std::uint64_t h = static_cast<std::uint64_t>(reinterpret_cast<std::uintptr_t>(ptr)) >> 3;
+    h *= 0x9E3779B97F4A7C15ull;
+    return static_cast<std::size_t>(h >> 32);
+}
+
+} // namespace detail
+
+// ============================================================================
+// Table Statistics
+// ============================================================================
+
+/// Health of a record table (see RecordTable::GetStats)
+struct RecordTableStats {
+    /// Number of log2 buckets in the probe distance histogram
+    static constexpr std::size_t ProbeBuckets = 8;
+
+    std::size_t capacity{0};        // Total slots over all segments
+    std::size_t live{0};            // Slots holding a record
+    std::size_t tombstones{0};      // Deleted slots not yet reused
+    std::size_t segments{0};        // Published segments
+    std::size_t maxProbe{0};        // Longest distance from a record to its home slot
+    double      averageProbe{0.0};  // Mean distance from a record to its home slot
+    double      loadFactor{0.0};    // live / capacity
+
+    /// Records by distance from their home slot: [0], [1], [2-3], [4-7] ... [64+]
+    std::size_t probeHistogram[ProbeBuckets]{};
+};
+
+// ============================================================================
+// Record Table
+// ============================================================================
+
+/// Lock-free, segmented open-addressing table of CompactRecords
+/// @tparam Config Provides MaxAllocations (slots in the first segment, power
+///         of two), MaxSegments and MaxProbes
+template <typename Config>
+class RecordTable {
+public:
+    static_assert((Config::MaxAllocations & (Config::MaxAllocations - 1)) == 0,
+                  "MaxAllocations must be a power of two");
+    static_assert(Config::MaxSegments > 0 && Config::MaxSegments <= 16,
+                  "MaxSegments must be in [1, 16]");
+
+    RecordTable() noexcept = default;
+    ~RecordTable() noexcept { Release(); }
+
+    RecordTable(const RecordTable&) = delete;
+    RecordTable& operator=(const RecordTable&) = delete;
+
+    /// Allocate the first segment
+    bool Initialize() noexcept {
+        if (m_segmentCount.load(std::memory_order_acquire) > 0) return true;
+        return Grow(0);
+    }
+
+    /// Release every segment
+    void Release() noexcept {
+        for (std::size_t i = 0; i < Config::MaxSegments; ++i) {
+            CompactRecord* records = m_segments[i].records.exchange(nullptr, std::memory_order_acq_rel);
+            os::FreePages(records, SegmentBytes(i));
+        }
+        m_segmentCount.store(0, std::memory_order_release);
+    }
+
+    /// Check if the table has storage
+    [[nodiscard]] bool IsValid() const noexcept {
+        return m_segmentCount.load(std::memory_order_acquire) > 0;
+    }
+
+    /// Add a record for ptr (lock-free)
+    /// The payload is written before the address is published (release), so a
+    /// concurrent Find or walk never sees the address with a stale payload.
+    /// @return The published record, or nullptr if every segment is saturated
+    ///         and no more can be added
+    CompactRecord* Insert(void* ptr, const RecordInfo& info) noexcept {
+        const std::size_t hash = detail::HashPointer(ptr);
+        std::size_t count = m_segmentCount.load(std::memory_order_acquire);
+
+        // Newest segment first: it is the largest and least loaded
+        for (std::size_t s = count; s-- > 0;) {
+            if (m_segments[s].saturated.load(std::memory_order_relaxed)) continue;
+            if (CompactRecord* slot = TryInsert(s, ptr, hash, info)) return slot;
+        }
+
+        // Everything is saturated. Before growing, give back segments that
+        // frees have drained (a full scan, but only on the way to a new segment)
+        if (count < Config::MaxSegments && ReopenDrained() > 0) {
+            for (std::size_t s = count; s-- > 0;) {
+                if (m_segments[s].saturated.load(std::memory_order_relaxed)) continue;
+                if (CompactRecord* slot = TryInsert(s, ptr, hash, info)) return slot;
+            }
+        }
+
+        // Publish a new segment and use it
+        while (count < Config::MaxSegments) {
+            if (!Grow(count)) break;
+            count = m_segmentCount.load(std::memory_order_acquire);
+            if (CompactRecord* slot = TryInsert(count - 1, ptr, hash, info)) return slot;
+        }
+
+        // Out of segments: frees may have drained older ones since they saturated
+        for (std::size_t s = count; s-- > 0;) {
+            if (CompactRecord* slot = TryInsert(s, ptr, hash, info)) return slot;
+        }
+        return nullptr;
+    }
+
+    /// Find the live record for ptr (lock-free)
+    [[nodiscard]] CompactRecord* Find(void* ptr) noexcept {
+        const std::size_t hash = detail::HashPointer(ptr);
+        const std::size_t count = m_segmentCount.load(std::memory_order_acquire);
+        for (std::size_t s = count; s-- > 0;) {
+            if (CompactRecord* slot = FindIn(s, ptr, hash)) return slot;
+        }
+        return nullptr;
+    }
+
+    /// Remove the record for ptr, leaving a tombstone (lock-free)
+    /// @param ptr Address to remove
+    /// @param out Receives the payload of the removed record
+    /// @return true if a record was found and removed by this call
+    bool Erase(void* ptr, RecordInfo& out) noexcept {
+        CompactRecord* slot = Find(ptr);
+        if (!slot) return false;
+
+        // Capture the payload before the slot can be reused
+        out = slot->Info();
+        return EraseAt(*slot, ptr);
+    }
+
+    /// Remove the record in a slot returned by Find or Insert, leaving a tombstone (lock-free)
+    /// Lets a caller that already holds the slot skip the probe of Erase.
+    /// @return true if the slot still held ptr and was cleared by this call
+    bool EraseAt(CompactRecord& slot, void* ptr) noexcept {
+        void* expected = ptr;
+        return slot.address.compare_exchange_strong(expected, CompactRecord::Tombstone(),
+                    std::memory_order_acq_rel, std::memory_order_relaxed);
+    }
+
+    /// Visit every live record: void(void* addr, const CompactRecord& record)
+    /// @note Not synchronized with the hot path; records may change during the walk
+    template <typename Callback>
+    void ForEach(Callback&& callback) const noexcept {
+        const std::size_t count = m_segmentCount.load(std::memory_order_acquire);
+        for (std::size_t s = 0; s < count; ++s) {
+            const CompactRecord* records = m_segments[s].records.load(std::memory_order_acquire);
+            if (!records) continue;
+            const std::size_t capacity = SegmentCapacity(s);
+            for (std::size_t i = 0; i < capacity; ++i) {
+                void* addr = records[i].address.load(std::memory_order_acquire);
+                if (CompactRecord::IsRecordAddress(addr)) {
+                    callback(addr, records[i]);
+                }
+            }
+        }
+    }
+
+    /// Position of an incremental walk (see ForEachChunk)
+    struct Cursor {
+        std::size_t segment{0};
+        std::size_t slot{0};
+    };
+
+    /// Visit the live records in the next maxSlots slots after cursor and advance it
+    /// Lets a background scan cover the table in bounded steps; like ForEach it
+    /// is not synchronized with the hot path.
+    /// @return false once the walk has covered every published segment
+    template <typename Callback>
+    bool ForEachChunk(Cursor& cursor, std::size_t maxSlots, Callback&& callback) const noexcept {
+        const std::size_t count = m_segmentCount.load(std::memory_order_acquire);
+        while (maxSlots > 0 && cursor.segment < count) {
+            const CompactRecord* records = m_segments[cursor.segment].records.load(std::memory_order_acquire);
+            const std::size_t capacity = SegmentCapacity(cursor.segment);
+            const std::size_t end = cursor.slot + maxSlots < capacity ? cursor.slot + maxSlots : capacity;
+            if (records) {
+                for (std::size_t i = cursor.slot; i < end; ++i) {
+                    void* addr = records[i].address.load(std::memory_order_acquire);
+                    if (CompactRecord::IsRecordAddress(addr)) {
+                        callback(addr, records[i]);
+                    }
+                }
+            }
+            maxSlots -= end - cursor.slot;
+            cursor.slot = end;
+            if (cursor.slot == capacity) {
+                ++cursor.segment;
+                cursor.slot = 0;
+            }
+        }
+        return cursor.segment < count;
+    }
+
+    /// Empty every segment (not safe against concurrent inserts/erases)
+    void Clear() noexcept {
+        const std::size_t count = m_segmentCount.load(std::memory_order_acquire);
+        for (std::size_t s = 0; s < count; ++s) {
+            CompactRecord* records = m_segments[s].records.load(std::memory_order_acquire);
+            if (records) {
+                std::memset(static_cast<void*>(records), 0, SegmentBytes(s));
+            }
+            m_segments[s].saturated.store(false, std::memory_order_relaxed);
+        }
+    }
+
+    /// Re-open saturated segments that frees have drained below half load (cold path, full scan)
+    /// Insert calls this before it grows the table.
+    /// @return Number of segments re-opened
+    std::size_t ReopenDrained() noexcept {
+        std::size_t reopened = 0;
+        const std::size_t count = m_segmentCount.load(std::memory_order_acquire);
+        for (std::size_t s = 0; s < count; ++s) {
+            if (!m_segments[s].saturated.load(std::memory_order_relaxed)) continue;
+            const CompactRecord* records = m_segments[s].records.load(std::memory_order_acquire);
+            if (!records) continue;
+            const std::size_t capacity = SegmentCapacity(s);
+            std::size_t live = 0;
+            for (std::size_t i = 0; i < capacity; ++i) {
+                if (CompactRecord::IsRecordAddress(records[i].address.load(std::memory_order_relaxed))) ++live;
+            }
+            if (live * 2 < capacity) {
+                m_segments[s].saturated.store(false, std::memory_order_relaxed);
+                ++reopened;
+            }
+        }
+        return reopened;
+    }
+
+    /// Scan the table and compute health statistics (cold path, read-only)
+    [[nodiscard]] RecordTableStats GetStats() const noexcept {
+        RecordTableStats stats;
+        std::size_t probeSum = 0;
+        const std::size_t count = m_segmentCount.load(std::memory_order_acquire);
+        stats.segments = count;
+
+        for (std::size_t s = 0; s < count; ++s) {
+            const CompactRecord* records = m_segments[s].records.load(std::memory_order_acquire);
+            if (!records) continue;
+            const std::size_t capacity = SegmentCapacity(s);
+            const std::size_t mask = capacity - 1;
+            std::size_t live = 0;
+
+            for (std::size_t i = 0; i < capacity; ++i) {
+                void* addr = records[i].address.load(std::memory_order_relaxed);
+                if (addr == CompactRecord::Tombstone()) {
+                    ++stats.tombstones;
+                    continue;
+                }
+                if (!CompactRecord::IsRecordAddress(addr)) continue;
+                ++live;
+                std::size_t distance = (i - (detail::HashPointer(addr) & mask)) & mask;
+                probeSum += distance;
+                if (distance > stats.maxProbe) stats.maxProbe = distance;
+
+                std::size_t bucket = 0;
+                while (distance > 0 && bucket + 1 < RecordTableStats::ProbeBuckets) {
+                    distance >>= 1;
+                    ++bucket;
+                }
+                ++stats.probeHistogram[bucket];
+            }
+
+            stats.live += live;
+            stats.capacity += capacity;
+        }
+
+        if (stats.live > 0) {
+            stats.averageProbe = static_cast<double>(probeSum) / static_cast<double>(stats.live);
+        }
+        if (stats.capacity > 0) {
+            stats.loadFactor = static_cast<double>(stats.live) / static_cast<double>(stats.capacity);
+        }
+        return stats;
+    }
+
+    /// Get total slots over all published segments
+    [[nodiscard]] std::size_t GetCapacity() const noexcept {
+        std::size_t total = 0;
+        const std::size_t count = m_segmentCount.load(std::memory_order_acquire);
+        for (std::size_t s = 0; s < count; ++s) total += SegmentCapacity(s);
+        return total;
+    }
+
+    /// Get number of published segments
+    [[nodiscard]] std::size_t GetSegmentCount() const noexcept {
+        return m_segmentCount.load(std::memory_order_acquire);
+    }
+
+private:
+    struct Segment {
+        std::atomic<CompactRecord*> records{nullptr};
+        std::atomic<bool>           saturated{false};  // An insert ran out of probes here
+    };
+
+    static constexpr std::size_t SegmentCapacity(std::size_t index) noexcept {
+        return Config::MaxAllocations << index;
+    }
+
+    static constexpr std::size_t SegmentBytes(std::size_t index) noexcept {
+        return sizeof(CompactRecord) * SegmentCapacity(index);
+    }
+
+    CompactRecord* TryInsert(std::size_t s, void* ptr, std::size_t hash, const RecordInfo& info) noexcept {
+        CompactRecord* records = m_segments[s].records.load(std::memory_order_acquire);
+        if (!records) return nullptr;
+
+        const std::size_t mask = SegmentCapacity(s) - 1;
+        const std::size_t idx = hash & mask;
+        for (std::size_t probe = 0; probe < Config::MaxProbes; ++probe) {
+            CompactRecord& slot = records[(idx + probe) & mask];
+            void* current = slot.address.load(std::memory_order_relaxed);
+            while (current == nullptr || current == CompactRecord::Tombstone()) {
+                // Reserve, fill, publish: Find skips a reserved slot like a tombstone
+                if (slot.address.compare_exchange_weak(current, CompactRecord::Reserved(),
+                        std::memory_order_acquire, std::memory_order_relaxed)) {
+                    slot.size = info.size;
+                    slot.tag = info.tag;
+                    slot.flags = info.flags;
+                    slot.sampleShift = info.sampleShift;
+                    slot.site = info.site;
+                    slot.birth = info.birth;
+                    slot.address.store(ptr, std::memory_order_release);
+                    return &slot;
+                }
+            }
+        }
+        m_segments[s].saturated.store(true, std::memory_order_relaxed);
+        return nullptr;
+    }
+
+    CompactRecord* FindIn(std::size_t s, void* ptr, std::size_t hash) noexcept {
+        CompactRecord* records = m_segments[s].records.load(std::memory_order_acquire);
+        if (!records) return nullptr;
+
+        const std::size_t mask = SegmentCapacity(s) - 1;
+        const std::size_t idx = hash & mask;
+        // Inserts never go past MaxProbes, so neither does a lookup
+        for (std::size_t probe = 0; probe < Config::MaxProbes; ++probe) {
+            CompactRecord& slot = records[(idx + probe) & mask];
+            void* current = slot.address.load(std::memory_order_acquire);
+            if (current == ptr) return &slot;
+            if (current == nullptr) return nullptr;
+        }
+        return nullptr;
+    }
+
+    /// Publish segment `index` if nobody else has yet
+    bool Grow(std::size_t index) noexcept {
+        if (index >= Config::MaxSegments) return false;
+
+        Segment& seg = m_segments[index];
+        if (!seg.records.load(std::memory_order_acquire)) {
+            auto* records = static_cast<CompactRecord*>(os::AllocatePages(SegmentBytes(index)));
+            if (!records) return false;
+            CompactRecord* expected = nullptr;
+            if (!seg.records.compare_exchange_strong(expected, records,
+                    std::memory_order_acq_rel, std::memory_order_acquire)) {
+                // Another thread won the race
+                os::FreePages(records, SegmentBytes(index));
+            }
+        }
+
+        std::size_t expectedCount = index;
+        m_segmentCount.compare_exchange_strong(expectedCount, index + 1,
+            std::memory_order_acq_rel, std::memory_order_acquire);
+        return true;
+    }
+
+    Segment m_segments[Config::MaxSegments];
+    std::atomic<std::size_t> m_segmentCount{0};
+};
+
+} // namespace mem
+} // namespace yu
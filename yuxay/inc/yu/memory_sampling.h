@@ -0,0 +1,120 @@
+/**
+ * @file memory_sampling.h
+ * @brief Byte-interval allocation sampler for LightweightTracker
+ *
+ * In sampled mode the tracker records roughly one allocation per N bytes
+ * allocated on each thread. Sample points form a Poisson process over the
+ * allocated bytes: each thread counts down a geometric (exponential) byte
+ * interval with mean N, and the allocation that crosses zero is recorded.
+ *
+ * An allocation of size s is therefore recorded with probability
+ * p = 1 - exp(-s / N), and the tracker scales each recorded allocation by
+ * 1/p (bytes s/p, count 1/p), which makes the totals unbiased estimates.
+ * Large allocations (s >> N) are always recorded with weight ~1.
+ *
+ * N is a power of two, so a record only needs to store log2(N) to recompute
+ * its weight when it is freed, even if the interval changed in between.
+ */
+
+#pragma once
+
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+
+namespace yu {
+namespace mem {
+
+namespace detail {
+
+/// Per-thread sampler state (zero-initialized, no TLS constructor)
+struct SamplerState {
+    std::int64_t  bytesUntilSample{0};
+    std::uint32_t rng{0};
+};
+
+/// Thread-local rather than per stats shard (memory_stats.h): the countdown
+/// is a plain read-modify-write on every sampled-mode allocation, and threads
+/// that share a shard would race on it. Being zero-initialized, it needs no
+/// TLS callback, and threads that existed before the DLL was injected get it too.
+inline thread_local SamplerState t_samplerState{};
+
+/// Draw an exponential byte interval with mean 2^shift
+[[nodiscard]] inline std::int64_t NextSampleInterval(SamplerState& state, std::uint8_t shift) noexcept {
+    // xorshift32: plenty for spacing samples
+    std::uint32_t x = state.rng;
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    state.rng = x;
+
+    // Uniform in (0, 1], so the log is finite
+    const double u = (static_cast<double>(x >> 8) + 1.0) * (1.0 / 16777216.0);
+    const double interval = -std::log(u) * static_cast<double>(std::uint64_t{1} << shift);
+    return static_cast<std::int64_t>(interval) + 1;
+}
+
+/// Slow path of ShouldSample: the countdown reached zero (or the thread is new)
+inline bool SampleSlowPath(SamplerState& state, std::size_t size, std::uint8_t shift) noexcept {
+    if (state.rng == 0) {
+        // First allocation on this thread: seed from the state's own address,
+        // then start a fresh interval so the first allocation is not favoured
+        std::uint32_t seed = static_cast<std::uint32_t>(reinterpret_cast<std::uintptr_t>(&state));
+        seed = seed * 2654435761u;
+        state.rng = seed ? seed : 0x9E3779B9u;
+        state.bytesUntilSample = NextSampleInterval(state, shift) - static_cast<std::int64_t>(size);
+        if (state.bytesUntilSample > 0) return false;
+    }
+    state.bytesUntilSample = NextSampleInterval(state, shift);
+    return true;
+}
+
+} // namespace detail
+
+/// Decide whether the calling thread's next allocation is recorded
+/// @param size Allocation size in bytes
+/// @param shift log2 of the mean sampling interval (must be > 0)
+[[nodiscard]] inline bool ShouldSample(std::size_t size, std::uint8_t shift) noexcept {
+    detail::SamplerState& state = detail::t_samplerState;
+    state.bytesUntilSample -= static_cast<std::int64_t>(size);
+    if (state.bytesUntilSample > 0) return false;
+    return detail::SampleSlowPath(state, size, shift);
+}
+
+/// Scaled-up contribution of one recorded allocation
+struct SampleWeight {
+    std::size_t bytes{0};
+    std::size_t count{0};
+};
+
+/// Compute the weight of a record
+/// @param size Allocation size in bytes
+/// @param shift log2 of the interval it was sampled with (0 = exact, weight 1)
+[[nodiscard]] inline SampleWeight GetSampleWeight(std::uint32_t size, std::uint8_t shift) noexcept {
+    if (shift == 0) return SampleWeight{size, 1};
+
+    const double interval = static_cast<double>(std::uint64_t{1} << shift);
+    const double probability = -std::expm1(-static_cast<double>(size) / interval);
+    if (!(probability > 0.0)) {
+        // Zero-byte allocation: counts once, weighs nothing
+        return SampleWeight{0, 1};
+    }
+    const double scale = 1.0 / probability;
+    return SampleWeight{
+        static_cast<std::size_t>(static_cast<double>(size) * scale + 0.5),
+        static_cast<std::size_t>(scale + 0.5)
+    };
+}
+
+/// Round a sampling interval in bytes to a shift (nearest power of two, at least 2^1)
+[[nodiscard]] constexpr std::uint8_t SampleIntervalToShift(std::size_t bytes) noexcept {
+    if (bytes <= 2) return 1;
+    std::uint8_t shift = 1;
+    while (shift < 30 && (std::size_t{1} << (shift + 1)) <= bytes) ++shift;
+    // Round up if bytes is closer to the next power of two
+    if (shift < 30 && bytes - (std::size_t{1} << shift) > ((std::size_t{1} << shift) >> 1)) ++shift;
+    return shift;
+}
+
+} // namespace mem
+} // namespace yu
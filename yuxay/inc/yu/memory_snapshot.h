@@ -0,0 +1,143 @@
+/**
+ * @file memory_snapshot.h
+ * @brief Incremental, non-blocking memory snapshots of the LightweightTracker
+ *
+ * A snapshot walks the record table in chunks without taking any lock,
+ * yielding between chunks, and folds every live record into per-tag and
+ * per-size-class histograms. The result goes into a preallocated
+ * MemorySnapshot and is formatted into a preallocated text buffer, then
+ * written with a single file write: taking one mid-game never stalls the
+ * allocating threads and never allocates.
+ *
+ * MemorySnapshotter runs the walk on a background thread, on request (the
+ * overlay's report key) and/or periodically. Periodic files are timestamped
+ * and use a fixed line layout, so two snapshots of a long session can be
+ * compared with a plain diff.
+ *
+ * The walk is not synchronized with the hot path: a snapshot is a consistent
+ * picture of each record, not of the whole table at one instant.
+ */
+
+#pragma once
+
+#include "memory_lightweight.h"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <thread>
+
+namespace yu {
+namespace mem {
+
+// ============================================================================
+// Snapshot Data
+// ============================================================================
+
+/// Histograms of the live allocations at one point in a session
+struct MemorySnapshot {
+    /// Size classes, as in the tracker's live histogram (see SizeClassOf)
+    static constexpr std::size_t SizeClasses = LightweightConfig::SizeClasses;
+
+    /// Tags with their own histogram row; higher tags share the last row
+    static constexpr std::size_t MaxTags = 256;
+
+    struct Bucket {
+        std::size_t bytes{0};
+        std::size_t count{0};
+    };
+
+    std::uint64_t sequence{0};       // Snapshots taken before this one
+    std::uint64_t uptimeMs{0};       // Since the snapshotter started
+    std::int64_t  unixSeconds{0};    // Wall clock when the walk started
+    std::uint64_t scanMs{0};         // Duration of the walk
+    std::size_t   chunks{0};         // Steps the walk took
+    std::size_t   sampleInterval{0}; // 0 in exact mode
+
+    // Tracker counters, read when the walk ends
+    std::size_t totalBytes{0};
+    std::size_t peakBytes{0};
+    std::size_t activeCount{0};
+    std::size_t dropped{0};
+
+    // Histograms of the records seen by the walk (sample weights applied)
+    Bucket tags[MaxTags]{};
+    Bucket sizeClasses[SizeClasses]{};
+    std::size_t records{0};
+};
+
+// ============================================================================
+// Snapshotter
+// ============================================================================
+
+/// Takes MemorySnapshots on a background thread and writes them to files
+class MemorySnapshotter {
+public:
+    /// Record slots visited per step of the walk
+    static constexpr std::size_t DefaultChunkSlots = 16384;
+
+    /// Size of the preallocated text buffer (a snapshot longer than this is truncated)
+    static constexpr std::size_t TextCapacity = 64 * 1024;
+
+    [[nodiscard]] static MemorySnapshotter& Instance() noexcept;
+
+    /// Start the background thread
+    /// @param prefix File name prefix (may include a directory); files are
+    ///        named <prefix>_<YYYYMMDD-HHMMSS>_<sequence>.txt
+    /// @param intervalMs Period of automatic snapshots, 0 for on-request only
+    /// @return true if the thread is running
+    bool Start(const char* prefix = "memory_snapshot", std::uint32_t intervalMs = 0) noexcept;
+
+    /// Stop the background thread (a snapshot in progress is finished first)
+    void Stop() noexcept;
+
+    [[nodiscard]] bool IsRunning() const noexcept { return m_running.load(std::memory_order_acquire); }
+
+    /// Ask the background thread for a snapshot (never blocks; requests made
+    /// while one is pending are merged)
+    void RequestSnapshot() noexcept { m_requested.store(true, std::memory_order_release); }
+
+    /// Take a snapshot on the calling thread and write it to path
+    /// Uses the same preallocated buffers; do not call while the background
+    /// thread is running.
+    bool WriteSnapshot(const char* path) noexcept;
+
+    /// Walk the tracker's records into out (calling thread, no allocation)
+    static void Capture(MemorySnapshot& out, std::size_t chunkSlots = DefaultChunkSlots) noexcept;
+
+    /// Format a snapshot as text
+    /// @return Number of characters written (excluding null terminator)
+    static std::size_t Format(const MemorySnapshot& snapshot, char* buffer, std::size_t bufferSize) noexcept;
+
+    /// Snapshots written so far
+    [[nodiscard]] std::uint64_t GetSnapshotCount() const noexcept { return m_sequence.load(std::memory_order_relaxed); }
+
+    /// Path of the most recent snapshot file (empty before the first)
+    [[nodiscard]] const char* GetLastPath() const noexcept { return m_lastPath; }
+
+    MemorySnapshotter(const MemorySnapshotter&) = delete;
+    MemorySnapshotter& operator=(const MemorySnapshotter&) = delete;
+
+private:
+    MemorySnapshotter() noexcept = default;
+    ~MemorySnapshotter() noexcept;
+
+    bool EnsureBuffers() noexcept;
+    bool TakeAndWrite(const char* path) noexcept;
+    void WorkerLoop() noexcept;
+
+    MemorySnapshot* m_snapshot = nullptr;   // OS pages
+    char*           m_text = nullptr;       // OS pages, TextCapacity bytes
+
+    std::thread                m_worker;
+    std::atomic<bool>          m_running{false};
+    std::atomic<bool>          m_requested{false};
+    std::atomic<std::uint64_t> m_sequence{0};
+    std::uint32_t              m_intervalMs{0};
+    std::uint64_t              m_startMs{0};
+    char                       m_prefix[200]{};
+    char                       m_lastPath[260]{};
+};
+
+} // namespace mem
+} // namespace yu
@@ -0,0 +1,497 @@
+/**
+ * @file memory_stats.h
+ * @brief Statistics policies for LightweightTracker
+ *
+ * Two interchangeable policies keep the global and per-tag byte/count totals:
+ * - ExactStats: one set of shared atomics, peaks updated on every allocation.
+ *   Exact, but every RecordAllocation on every thread writes the same cache lines.
+ * - ShardedStats: one cache-line aligned counter block per thread shard.
+ *   Threads mostly touch their own shard, totals are summed lazily when read,
+ *   and peaks are sampled (see ShardedStats for the exact guarantees).
+ *
+ * Both take a count with every update so sampled records (memory_sampling.h)
+ * can stand in for more than one allocation, and keep a power-of-two
+ * size-class histogram of the live blocks next to the totals. A reallocation
+ * is a single event: only the size delta is applied, and it is counted
+ * neither as an allocation nor as a free.
+ *
+ * The policy is chosen at compile time with YU_MEMORY_SHARDED_STATS
+ * (defaults to sharded in release builds, exact in debug builds).
+ */
+
+#pragma once
+
+#ifdef _WIN32
+    #ifndef WIN32_LEAN_AND_MEAN
+        #define WIN32_LEAN_AND_MEAN
+    #endif
+    #include <Windows.h>
+#endif
+
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+
+#ifndef YU_MEMORY_SHARDED_STATS
+    #ifdef NDEBUG
+        #define YU_MEMORY_SHARDED_STATS 1
+    #else
+        #define YU_MEMORY_SHARDED_STATS 0
+    #endif
+#endif
+
+namespace yu {
+namespace mem {
+
+namespace detail {
+
+/// Raise peak to at least value
+inline void UpdatePeak(std::atomic<std::size_t>& peak, std::size_t value) noexcept {
+    std::size_t current = peak.load(std::memory_order_relaxed);
+    while (value > current) {
+        if (peak.compare_exchange_weak(current, value, std::memory_order_relaxed)) {
+            break;
+        }
+    }
+}
+
+/// Pick the calling thread's shard in [0, ShardCount)
+/// Thread ids are handed out sequentially, so the low bits spread well.
+template <std::size_t ShardCount>
+[[nodiscard]] inline std::size_t CurrentShard() noexcept {
+    static_assert((ShardCount & (ShardCount - 1)) == 0, "ShardCount must be a power of two");
+#ifdef _WIN32
+    // The thread id is read straight from the TEB, which is as cheap as a TLS
+    // read and needs no per-thread state. (Zero-initialized thread_local state,
+    // as in memory_sampling.h, would work too: the loader gives an injected
+    // DLL's TLS to threads that already exist.)
+    return static_cast<std::size_t>(GetCurrentThreadId() >> 2) & (ShardCount - 1);
+#else
+    static std::atomic<std::size_t> s_nextShard{0};
+    static thread_local std::size_t s_shard = s_nextShard.fetch_add(1, std::memory_order_relaxed);
+    return s_shard & (ShardCount - 1);
+#endif
+}
+
+} // namespace detail
+
+/// Power-of-two size class of an allocation: class k holds [2^k, 2^(k+1)), class 0 also holds 0
+[[nodiscard]] constexpr std::size_t SizeClassOf(std::uint32_t size) noexcept {
+    return size > 1 ? static_cast<std::size_t>(std::bit_width(size)) - 1 : 0;
+}
+
+// ============================================================================
+// Exact Statistics
+// ============================================================================
+
+/// Shared atomic counters with exact peaks (the original tracker behaviour)
+/// @tparam Config Provides MaxTags and SizeClasses
+template <typename Config>
+class ExactStats {
+public:
+    static constexpr bool IsExact = true;
+
+    void OnAllocation(std::size_t size, std::size_t tag, std::size_t count, std::size_t sizeClass) noexcept {
+        const std::size_t total = m_totalBytes.fetch_add(size, std::memory_order_relaxed) + size;
+        m_activeCount.fetch_add(count, std::memory_order_relaxed);
+
+        auto& cls = m_classes[sizeClass];
+        cls.bytes.fetch_add(size, std::memory_order_relaxed);
+        cls.count.fetch_add(count, std::memory_order_relaxed);
+        cls.allocs.fetch_add(count, std::memory_order_relaxed);
+
+        if (tag < Config::MaxTags) {
+            auto& stats = m_tags[tag];
+            const std::size_t current = stats.currentBytes.fetch_add(size, std::memory_order_relaxed) + size;
+            stats.allocCount.fetch_add(count, std::memory_order_relaxed);
+            detail::UpdatePeak(stats.peakBytes, current);
+        }
+
+        detail::UpdatePeak(m_peakBytes, total);
+    }
+
+    void OnDeallocation(std::size_t size, std::size_t tag, std::size_t count, std::size_t sizeClass) noexcept {
+        m_totalBytes.fetch_sub(size, std::memory_order_relaxed);
+        m_activeCount.fetch_sub(count, std::memory_order_relaxed);
+
+        auto& cls = m_classes[sizeClass];
+        cls.bytes.fetch_sub(size, std::memory_order_relaxed);
+        cls.count.fetch_sub(count, std::memory_order_relaxed);
+
+        if (tag < Config::MaxTags) {
+            auto& stats = m_tags[tag];
+            std::size_t current = stats.currentBytes.load(std::memory_order_relaxed);
+            if (current >= size) {
+                stats.currentBytes.fetch_sub(size, std::memory_order_relaxed);
+            } else {
+                stats.currentBytes.store(0, std::memory_order_relaxed);
+            }
+            stats.freeCount.fetch_add(count, std::memory_order_relaxed);
+        }
+    }
+
+    void OnReallocation(std::size_t oldSize, std::size_t newSize, std::size_t tag,
+                        std::size_t oldCount, std::size_t newCount,
+                        std::size_t oldClass, std::size_t newClass) noexcept {
+        // Unsigned wrap-around turns a shrink into a subtraction
+        const std::size_t delta = newSize - oldSize;
+        const std::size_t total = m_totalBytes.fetch_add(delta, std::memory_order_relaxed) + delta;
+        if (newCount != oldCount) {
+            m_activeCount.fetch_add(newCount - oldCount, std::memory_order_relaxed);
+        }
+        m_reallocCount.fetch_add(1, std::memory_order_relaxed);
+
+        if (oldClass == newClass && oldCount == newCount) {
+            m_classes[newClass].bytes.fetch_add(delta, std::memory_order_relaxed);
+        } else {
+            m_classes[oldClass].bytes.fetch_sub(oldSize, std::memory_order_relaxed);
+            m_classes[oldClass].count.fetch_sub(oldCount, std::memory_order_relaxed);
+            m_classes[newClass].bytes.fetch_add(newSize, std::memory_order_relaxed);
+            m_classes[newClass].count.fetch_add(newCount, std::memory_order_relaxed);
+        }
+
+        if (tag < Config::MaxTags) {
+            auto& stats = m_tags[tag];
+            if (newSize >= oldSize) {
+                const std::size_t current = stats.currentBytes.fetch_add(delta, std::memory_order_relaxed) + delta;
+                detail::UpdatePeak(stats.peakBytes, current);
+            } else if (stats.currentBytes.load(std::memory_order_relaxed) >= oldSize - newSize) {
+                stats.currentBytes.fetch_add(delta, std::memory_order_relaxed);
+            } else {
+                stats.currentBytes.store(0, std::memory_order_relaxed);
+            }
+        }
+
+        if (newSize > oldSize) {
+            detail::UpdatePeak(m_peakBytes, total);
+        }
+    }
+
+    [[nodiscard]] std::size_t TotalBytes() const noexcept {
+        return m_totalBytes.load(std::memory_order_relaxed);
+    }
+
+    [[nodiscard]] std::size_t PeakBytes() const noexcept {
+        return m_peakBytes.load(std::memory_order_relaxed);
+    }
+
+    [[nodiscard]] std::size_t ActiveCount() const noexcept {
+        return m_activeCount.load(std::memory_order_relaxed);
+    }
+
+    [[nodiscard]] std::size_t TagBytes(std::size_t tag) const noexcept {
+        return m_tags[tag].currentBytes.load(std::memory_order_relaxed);
+    }
+
+    [[nodiscard]] std::size_t TagPeakBytes(std::size_t tag) const noexcept {
+        return m_tags[tag].peakBytes.load(std::memory_order_relaxed);
+    }
+
+    [[nodiscard]] std::uint64_t TagAllocCount(std::size_t tag) const noexcept {
+        return m_tags[tag].allocCount.load(std::memory_order_relaxed);
+    }
+
+    [[nodiscard]] std::uint64_t TagFreeCount(std::size_t tag) const noexcept {
+        return m_tags[tag].freeCount.load(std::memory_order_relaxed);
+    }
+
+    [[nodiscard]] std::size_t SizeClassBytes(std::size_t sizeClass) const noexcept {
+        return m_classes[sizeClass].bytes.load(std::memory_order_relaxed);
+    }
+
+    [[nodiscard]] std::size_t SizeClassCount(std::size_t sizeClass) const noexcept {
+        return m_classes[sizeClass].count.load(std::memory_order_relaxed);
+    }
+
+    [[nodiscard]] std::uint64_t SizeClassAllocCount(std::size_t sizeClass) const noexcept {
+        return m_classes[sizeClass].allocs.load(std::memory_order_relaxed);
+    }
+
+    [[nodiscard]] std::uint64_t ReallocCount() const noexcept {
+        return m_reallocCount.load(std::memory_order_relaxed);
+    }
+
+    void Reset() noexcept {
+        for (auto& cls : m_classes) {
+            cls.bytes.store(0, std::memory_order_relaxed);
+            cls.count.store(0, std::memory_order_relaxed);
+            cls.allocs.store(0, std::memory_order_relaxed);
+        }
+        for (auto& stats : m_tags) {
+            stats.currentBytes.store(0, std::memory_order_relaxed);
+            stats.peakBytes.store(0, std::memory_order_relaxed);
+            stats.allocCount.store(0, std::memory_order_relaxed);
+            stats.freeCount.store(0, std::memory_order_relaxed);
+        }
+        m_totalBytes.store(0, std::memory_order_relaxed);
+        m_peakBytes.store(0, std::memory_order_relaxed);
+        m_activeCount.store(0, std::memory_order_relaxed);
+        m_reallocCount.store(0, std::memory_order_relaxed);
+    }
+
+private:
+    struct alignas(64) TagCounters {  // Cache-line aligned to prevent false sharing
+        std::atomic<std::size_t>   currentBytes{0};
+        std::atomic<std::size_t>   peakBytes{0};
+        std::atomic<std::uint64_t> allocCount{0};
+        std::atomic<std::uint64_t> freeCount{0};
+    };
+
+    struct alignas(64) ClassCounters {
+        std::atomic<std::size_t>   bytes{0};
+        std::atomic<std::size_t>   count{0};
+        std::atomic<std::uint64_t> allocs{0};
+    };
+
+    TagCounters m_tags[Config::MaxTags]{};
+    ClassCounters m_classes[Config::SizeClasses]{};
+
+    alignas(64) std::atomic<std::size_t> m_totalBytes{0};
+    std::atomic<std::size_t> m_peakBytes{0};
+    std::atomic<std::size_t> m_activeCount{0};
+    std::atomic<std::uint64_t> m_reallocCount{0};
+};
+
+// ============================================================================
+// Sharded Statistics
+// ============================================================================
+
+/// Per-thread-shard counters, aggregated when read
+///
+/// Each shard holds net deltas. A block freed on another thread is subtracted
+/// from that thread's shard, so a single shard can go "negative"; the deltas
+/// are kept in unsigned wrap-around arithmetic and only the sum over all shards
+/// is meaningful.
+///
+/// Peaks are not tracked on every allocation. Every PeakSampleInterval
+/// allocations on a shard, the allocating thread sums the shards and raises
+/// the global and tag peaks. Every read of the totals does the same. The
+/// reported peak is therefore a lower bound of the true peak, and it can miss
+/// short spikes that happen between samples.
+/// @tparam Config Provides MaxTags, SizeClasses, StatShards (power of two) and PeakSampleInterval
+template <typename Config>
+class ShardedStats {
+public:
+    static constexpr bool IsExact = false;
+
+    static_assert((Config::StatShards & (Config::StatShards - 1)) == 0,
+                  "StatShards must be a power of two");
+
+    void OnAllocation(std::size_t size, std::size_t tag, std::size_t count, std::size_t sizeClass) noexcept {
+        Shard& shard = m_shards[detail::CurrentShard<Config::StatShards>()];
+        Add(shard.totalBytes, size);
+        Add(shard.activeCount, count);
+        Add(shard.classBytes[sizeClass], size);
+        Add(shard.classCount[sizeClass], count);
+        Add(shard.classAllocs[sizeClass], count);
+
+        if (tag < Config::MaxTags) {
+            Add(shard.tagBytes[tag], size);
+            Add(shard.tagAllocs[tag], count);
+        }
+
+        TickPeaks(shard, tag);
+    }
+
+    void OnDeallocation(std::size_t size, std::size_t tag, std::size_t count, std::size_t sizeClass) noexcept {
+        Shard& shard = m_shards[detail::CurrentShard<Config::StatShards>()];
+        Add(shard.totalBytes, 0 - size);
+        Add(shard.activeCount, 0 - count);
+        Add(shard.classBytes[sizeClass], 0 - size);
+        Add(shard.classCount[sizeClass], 0 - count);
+
+        if (tag < Config::MaxTags) {
+            Add(shard.tagBytes[tag], 0 - size);
+            Add(shard.tagFrees[tag], count);
+        }
+    }
+
+    void OnReallocation(std::size_t oldSize, std::size_t newSize, std::size_t tag,
+                        std::size_t oldCount, std::size_t newCount,
+                        std::size_t oldClass, std::size_t newClass) noexcept {
+        Shard& shard = m_shards[detail::CurrentShard<Config::StatShards>()];
+        Add(shard.totalBytes, newSize - oldSize);
+        Add(shard.reallocs, 1);
+        if (newCount != oldCount) {
+            Add(shard.activeCount, newCount - oldCount);
+        }
+        if (oldClass == newClass && oldCount == newCount) {
+            Add(shard.classBytes[newClass], newSize - oldSize);
+        } else {
+            Add(shard.classBytes[oldClass], 0 - oldSize);
+            Add(shard.classCount[oldClass], 0 - oldCount);
+            Add(shard.classBytes[newClass], newSize);
+            Add(shard.classCount[newClass], newCount);
+        }
+        if (tag < Config::MaxTags) {
+            Add(shard.tagBytes[tag], newSize - oldSize);
+        }
+
+        // Only growth can raise a peak
+        if (newSize > oldSize) {
+            TickPeaks(shard, tag);
+        }
+    }
+
+    [[nodiscard]] std::size_t TotalBytes() const noexcept {
+        const std::size_t total = Gauge(Sum(&Shard::totalBytes));
+        detail::UpdatePeak(m_peakBytes, total);
+        return total;
+    }
+
+    [[nodiscard]] std::size_t PeakBytes() const noexcept {
+        detail::UpdatePeak(m_peakBytes, Gauge(Sum(&Shard::totalBytes)));
+        return m_peakBytes.load(std::memory_order_relaxed);
+    }
+
+    [[nodiscard]] std::size_t ActiveCount() const noexcept {
+        return Gauge(Sum(&Shard::activeCount));
+    }
+
+    [[nodiscard]] std::size_t TagBytes(std::size_t tag) const noexcept {
+        const std::size_t bytes = Gauge(SumTag(&Shard::tagBytes, tag));
+        detail::UpdatePeak(m_tagPeaks[tag], bytes);
+        return bytes;
+    }
+
+    [[nodiscard]] std::size_t TagPeakBytes(std::size_t tag) const noexcept {
+        detail::UpdatePeak(m_tagPeaks[tag], Gauge(SumTag(&Shard::tagBytes, tag)));
+        return m_tagPeaks[tag].load(std::memory_order_relaxed);
+    }
+
+    [[nodiscard]] std::uint64_t TagAllocCount(std::size_t tag) const noexcept {
+        return SumTag(&Shard::tagAllocs, tag);
+    }
+
+    [[nodiscard]] std::uint64_t TagFreeCount(std::size_t tag) const noexcept {
+        return SumTag(&Shard::tagFrees, tag);
+    }
+
+    [[nodiscard]] std::size_t SizeClassBytes(std::size_t sizeClass) const noexcept {
+        return Gauge(SumClass(&Shard::classBytes, sizeClass));
+    }
+
+    [[nodiscard]] std::size_t SizeClassCount(std::size_t sizeClass) const noexcept {
+        return Gauge(SumClass(&Shard::classCount, sizeClass));
+    }
+
+    [[nodiscard]] std::uint64_t SizeClassAllocCount(std::size_t sizeClass) const noexcept {
+        return SumClass(&Shard::classAllocs, sizeClass);
+    }
+
+    [[nodiscard]] std::uint64_t ReallocCount() const noexcept {
+        return Sum(&Shard::reallocs);
+    }
+
+    void Reset() noexcept {
+        for (auto& shard : m_shards) {
+            shard.totalBytes.store(0, std::memory_order_relaxed);
+            shard.activeCount.store(0, std::memory_order_relaxed);
+            shard.peakCountdown.store(0, std::memory_order_relaxed);
+            shard.reallocs.store(0, std::memory_order_relaxed);
+            for (std::size_t t = 0; t < Config::MaxTags; ++t) {
+                shard.tagBytes[t].store(0, std::memory_order_relaxed);
+                shard.tagAllocs[t].store(0, std::memory_order_relaxed);
+                shard.tagFrees[t].store(0, std::memory_order_relaxed);
+            }
+            for (std::size_t c = 0; c < Config::SizeClasses; ++c) {
+                shard.classBytes[c].store(0, std::memory_order_relaxed);
+                shard.classCount[c].store(0, std::memory_order_relaxed);
+                shard.classAllocs[c].store(0, std::memory_order_relaxed);
+            }
+        }
+        for (auto& peak : m_tagPeaks) peak.store(0, std::memory_order_relaxed);
+        m_peakBytes.store(0, std::memory_order_relaxed);
+    }
+
+private:
+    using Counter = std::atomic<std::size_t>;
+
+    struct alignas(64) Shard {
+        Counter totalBytes{0};
+        Counter activeCount{0};
+        Counter peakCountdown{0};
+        Counter reallocs{0};
+        Counter tagBytes[Config::MaxTags]{};
+        Counter tagAllocs[Config::MaxTags]{};
+        Counter tagFrees[Config::MaxTags]{};
+        Counter classBytes[Config::SizeClasses]{};
+        Counter classCount[Config::SizeClasses]{};
+        Counter classAllocs[Config::SizeClasses]{};
+    };
+
+    /// Shard-local increment; the line is rarely shared, so the RMW stays cheap
+    static void Add(Counter& counter, std::size_t delta) noexcept {
+        counter.fetch_add(delta, std::memory_order_relaxed);
+    }
+
+    /// Reading a gauge (bytes, live blocks) while it is updated can catch a free
+    /// on one shard without its allocation on another: the wrapped sum is then
+    /// negative as a signed value, so it is clamped at 0 instead of returning
+    /// (and latching as a peak) a value near SIZE_MAX. Monotonic counters need no clamp.
+    [[nodiscard]] static std::size_t Gauge(std::size_t wrappedSum) noexcept {
+        return static_cast<std::ptrdiff_t>(wrappedSum) < 0 ? 0 : wrappedSum;
+    }
+
+    [[nodiscard]] std::size_t Sum(Counter Shard::*field) const noexcept {
+        std::size_t total = 0;
+        for (const auto& shard : m_shards) {
+            total += (shard.*field).load(std::memory_order_relaxed);
+        }
+        return total;
+    }
+
+    [[nodiscard]] std::size_t SumTag(Counter (Shard::*field)[Config::MaxTags], std::size_t tag) const noexcept {
+        std::size_t total = 0;
+        for (const auto& shard : m_shards) {
+            total += (shard.*field)[tag].load(std::memory_order_relaxed);
+        }
+        return total;
+    }
+
+    [[nodiscard]] std::size_t SumClass(Counter (Shard::*field)[Config::SizeClasses], std::size_t sizeClass) const noexcept {
+        std::size_t total = 0;
+        for (const auto& shard : m_shards) {
+            total += (shard.*field)[sizeClass].load(std::memory_order_relaxed);
+        }
+        return total;
+    }
+
+    void TickPeaks(Shard& shard, std::size_t tag) noexcept {
+        // Countdown is shared by the threads on this shard; an occasional
+        // lost decrement only delays the next sample
+        std::size_t countdown = shard.peakCountdown.load(std::memory_order_relaxed);
+        if (countdown == 0) {
+            shard.peakCountdown.store(Config::PeakSampleInterval, std::memory_order_relaxed);
+            SamplePeaks(tag);
+        } else {
+            shard.peakCountdown.store(countdown - 1, std::memory_order_relaxed);
+        }
+    }
+
+    void SamplePeaks(std::size_t tag) noexcept {
+        detail::UpdatePeak(m_peakBytes, Gauge(Sum(&Shard::totalBytes)));
+        if (tag < Config::MaxTags) {
+            detail::UpdatePeak(m_tagPeaks[tag], Gauge(SumTag(&Shard::tagBytes, tag)));
+        }
+    }
+
+    Shard m_shards[Config::StatShards]{};
+
+    // Sampled peaks, only written on sample points and reads
+    alignas(64) mutable Counter m_peakBytes{0};
+    mutable Counter m_tagPeaks[Config::MaxTags]{};
+};
+
+/// Statistics policy used by LightweightTracker
+#if YU_MEMORY_SHARDED_STATS
+template <typename Config>
+using TrackerStats = ShardedStats<Config>;
+#else
+template <typename Config>
+using TrackerStats = ExactStats<Config>;
+#endif
+
+} // namespace mem
+} // namespace yu
@@ -7,9 +7,12 @@
  * 
  * Features:
  * - Logging with file output support
- * - File I/O with base path management
+ * - File I/O with base path management, memory-mapped and batched async reads
  * - Tagged memory allocation and tracking
  * - RAII helpers and utilities
+ * - Lock-free queues and snapshot primitives
+ * - Work-stealing job system
+ * - Runtime switches and call statistics for detours
  * 
  * @version 1.0.0
  * @author RayShip Development
@@ -20,8 +23,18 @@
 // Core headers
 #include "yu/log.h"
 #include "yu/io.h"
+#include "yu/io_mapped.h"
+#include "yu/io_async.h"
+#include "yu/io_stream.h"
 #include "yu/memory.h"
+#include "yu/memory_arena.h"
+#include "yu/memory_pool.h"
+#include "yu/memory_frame.h"
+#include "yu/memory_snapshot.h"
 #include "yu/raii.h"
+#include "yu/concurrent.h"
+#include "yu/jobs.h"
+#include "yu/hook.h"
 
 /// Yu library version information
 namespace yu {
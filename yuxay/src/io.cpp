@@ -12,6 +12,7 @@
     #define NOMINMAX
     #include <windows.h>
 #else
+    #include <cerrno>
     #include <unistd.h>
     #include <linux/limits.h>
 #endif
@@ -19,6 +20,33 @@
 namespace yu {
 namespace io {
 
+IOError detail::LastOSError(IOError fallback) noexcept {
+#ifdef _WIN32
+    switch (GetLastError()) {
+        case ERROR_FILE_NOT_FOUND:     return IOError::FileNotFound;
+        case ERROR_PATH_NOT_FOUND:     return IOError::DirectoryNotFound;
+        case ERROR_ACCESS_DENIED:
+        case ERROR_SHARING_VIOLATION:  return IOError::AccessDenied;
+        case ERROR_INVALID_NAME:       return IOError::InvalidPath;
+        case ERROR_DISK_FULL:          return IOError::DiskFull;
+        case ERROR_NOT_ENOUGH_MEMORY:  return IOError::TooLarge;
+        default:                       return fallback;
+    }
+#else
+    switch (errno) {
+        case ENOENT:       return IOError::FileNotFound;
+        case ENOTDIR:      return IOError::DirectoryNotFound;
+        case EACCES:
+        case EPERM:        return IOError::AccessDenied;
+        case ENAMETOOLONG: return IOError::InvalidPath;
+        case ENOSPC:       return IOError::DiskFull;
+        case ENOMEM:
+        case EOVERFLOW:    return IOError::TooLarge;
+        default:           return fallback;
+    }
+#endif
+}
+
 // ============================================================================
 // FileSystem Implementation
 // ============================================================================
@@ -146,19 +174,20 @@ IOError MapOfstreamError(const std::ofstream& stream) {
     return IOError::Unknown;
 }
 
+/// Why a file could not be opened; only checked after the open failed
+IOError OpenFailure(const std::filesystem::path& resolved) {
+    std::error_code ec;
+    return std::filesystem::exists(resolved, ec) ? IOError::AccessDenied : IOError::FileNotFound;
+}
+
 } // anonymous namespace
 
 Result<ByteBuffer> ReadBytes(const std::filesystem::path& path) {
     auto resolved = FileSystem::Instance().ResolvePath(path);
     
-    std::error_code ec;
-    if (!std::filesystem::exists(resolved, ec)) {
-        return std::unexpected(IOError::FileNotFound);
-    }
-    
     std::ifstream file(resolved, std::ios::binary | std::ios::ate);
     if (!file.is_open()) {
-        return std::unexpected(IOError::AccessDenied);
+        return std::unexpected(OpenFailure(resolved));
     }
     
     auto size = file.tellg();
@@ -192,14 +221,9 @@ Result<std::string> ReadString(const std::filesystem::path& path) {
 Result<ByteBuffer> ReadBytesLimited(const std::filesystem::path& path, std::size_t maxBytes) {
     auto resolved = FileSystem::Instance().ResolvePath(path);
     
-    std::error_code ec;
-    if (!std::filesystem::exists(resolved, ec)) {
-        return std::unexpected(IOError::FileNotFound);
-    }
-    
     std::ifstream file(resolved, std::ios::binary | std::ios::ate);
     if (!file.is_open()) {
-        return std::unexpected(IOError::AccessDenied);
+        return std::unexpected(OpenFailure(resolved));
     }
     
     auto size = file.tellg();
@@ -227,14 +251,9 @@ Result<ByteBuffer> ReadBytesRange(const std::filesystem::path& path,
                                    std::size_t offset, std::size_t count) {
     auto resolved = FileSystem::Instance().ResolvePath(path);
     
-    std::error_code ec;
-    if (!std::filesystem::exists(resolved, ec)) {
-        return std::unexpected(IOError::FileNotFound);
-    }
-    
     std::ifstream file(resolved, std::ios::binary | std::ios::ate);
     if (!file.is_open()) {
-        return std::unexpected(IOError::AccessDenied);
+        return std::unexpected(OpenFailure(resolved));
     }
     
     auto fileSize = file.tellg();
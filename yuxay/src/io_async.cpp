@@ -0,0 +1,469 @@
+/**
+ * @file io_async.cpp
+ * @brief Implementation of batched asynchronous file reads
+ */
+
+#include "yu/io_async.h"
+
+#include <algorithm>
+#include <atomic>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <utility>
+
+#ifdef _WIN32
+    #define WIN32_LEAN_AND_MEAN
+    #define NOMINMAX
+    #include <windows.h>
+#else
+    #include <cerrno>
+    #include <condition_variable>
+    #include <fcntl.h>
+    #include <sys/stat.h>
+    #include <unistd.h>
+#endif
+
+namespace yu {
+namespace io {
+
+namespace {
+
+/// Where the results of one batch go
+struct BatchSink {
+    ReadCallback                           callback;
+    std::vector<std::promise<ReadResult>>  promises;
+
+    void Deliver(std::size_t index, ReadResult&& result) {
+        if (callback) {
+            callback(index, std::move(result));
+        } else {
+            promises[index].set_value(std::move(result));
+        }
+    }
+};
+
+/// One request on its way through the reader
+struct Operation {
+#ifdef _WIN32
+    OVERLAPPED    overlapped{};                  // Must stay the first member
+    HANDLE        file = INVALID_HANDLE_VALUE;
+#else
+    int           fd = -1;
+#endif
+    ReadRequest                 request;
+    std::size_t                 index = 0;
+    std::shared_ptr<BatchSink>  sink;
+
+    std::uint8_t* destination = nullptr;
+    std::size_t   want = 0;                      // Bytes to read, clamped to the file and buffer
+    std::size_t   done = 0;
+    ByteBuffer    pooled;
+};
+
+#ifdef _WIN32
+/// Completion keys: packets without an OVERLAPPED are control messages
+constexpr ULONG_PTR ReadKey = 0;
+constexpr ULONG_PTR WakeKey = 1;
+constexpr ULONG_PTR QuitKey = 2;
+
+/// ReadFile takes a DWORD length; large requests are read in pieces
+constexpr std::size_t MaxReadChunk = std::size_t{1} << 30;
+#endif
+
+} // anonymous namespace
+
+// ============================================================================
+// Reader State
+// ============================================================================
+
+struct AsyncReader::State {
+    AsyncReadConfig config;
+
+    mutable std::mutex       mutex;
+    std::deque<Operation*>   queue;               // Submitted, not started
+    std::vector<ByteBuffer>  pool;
+    bool                     stopping = false;
+    std::atomic<std::size_t> pending{0};
+
+#ifdef _WIN32
+    HANDLE                   port = nullptr;
+    std::thread              thread;
+    std::vector<Operation*>  active;              // I/O thread only
+#else
+    std::condition_variable  wake;
+    std::vector<std::thread> workers;
+#endif
+
+    ByteBuffer AcquireBuffer(std::size_t size) {
+        {
+            std::lock_guard lock(mutex);
+            auto it = std::find_if(pool.begin(), pool.end(),
+                                   [size](const ByteBuffer& buffer) { return buffer.capacity() >= size; });
+            if (it != pool.end()) {
+                ByteBuffer buffer = std::move(*it);
+                *it = std::move(pool.back());
+                pool.pop_back();
+                buffer.resize(size);
+                return buffer;
+            }
+        }
+        return ByteBuffer(size);
+    }
+
+    /// Open the file and size the read; false (with error set) on failure
+    bool Prepare(Operation& op, IOError& error) {
+        auto resolved = FileSystem::Instance().ResolvePath(op.request.path);
+        std::uint64_t fileSize = 0;
+
+#ifdef _WIN32
+        op.file = CreateFileW(resolved.c_str(), GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_DELETE, nullptr,
+                              OPEN_EXISTING, FILE_FLAG_OVERLAPPED | FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+        if (op.file == INVALID_HANDLE_VALUE) {
+            error = detail::LastOSError();
+            return false;
+        }
+        LARGE_INTEGER size;
+        if (!GetFileSizeEx(op.file, &size) || !CreateIoCompletionPort(op.file, port, ReadKey, 0)) {
+            error = detail::LastOSError();
+            return false;
+        }
+        fileSize = static_cast<std::uint64_t>(size.QuadPart);
+#else
+        op.fd = open(resolved.c_str(), O_RDONLY | O_CLOEXEC);
+        if (op.fd < 0) {
+            error = detail::LastOSError();
+            return false;
+        }
+        struct stat info;
+        if (fstat(op.fd, &info) != 0) {
+            error = detail::LastOSError();
+            return false;
+        }
+        fileSize = static_cast<std::uint64_t>(info.st_size);
+#endif
+
+        if (op.request.offset > fileSize) {
+            error = IOError::ReadError;
+            return false;
+        }
+
+        const std::uint64_t available = fileSize - op.request.offset;
+        std::uint64_t want = std::min<std::uint64_t>(op.request.length, available);
+        if (!op.request.buffer.empty()) {
+            want = std::min<std::uint64_t>(want, op.request.buffer.size());
+            op.want = static_cast<std::size_t>(want);
+            op.destination = op.request.buffer.data();
+        } else {
+            if (want > std::numeric_limits<std::size_t>::max()) {
+                error = IOError::TooLarge;
+                return false;
+            }
+            op.want = static_cast<std::size_t>(want);
+            op.pooled = AcquireBuffer(op.want);
+            op.destination = op.pooled.data();
+        }
+        return true;
+    }
+
+    /// Close the file, hand the result to the batch and free the operation
+    void Finish(Operation* op, IOError error) {
+#ifdef _WIN32
+        if (op->file != INVALID_HANDLE_VALUE) CloseHandle(op->file);
+#else
+        if (op->fd >= 0) close(op->fd);
+#endif
+        if (error != IOError::None) {
+            Recycle(std::move(op->pooled));
+            op->sink->Deliver(op->index, std::unexpected(error));
+        } else {
+            ReadCompletion completion;
+            completion.index = op->index;
+            if (op->request.buffer.empty()) {
+                op->pooled.resize(op->done);
+                completion.pooled = std::move(op->pooled);
+                completion.bytes = completion.pooled;
+            } else {
+                completion.bytes = std::span<const std::uint8_t>(op->destination, op->done);
+            }
+            op->sink->Deliver(op->index, std::move(completion));
+        }
+        delete op;
+        pending.fetch_sub(1, std::memory_order_acq_rel);
+    }
+
+    void Recycle(ByteBuffer buffer) {
+        if (buffer.capacity() == 0) return;
+        std::lock_guard lock(mutex);
+        if (pool.size() < config.maxPooledBuffers) {
+            buffer.clear();
+            pool.push_back(std::move(buffer));
+        }
+    }
+
+#ifdef _WIN32
+    /// Issue the next piece of an operation; false if it failed at once
+    bool IssueRead(Operation* op, IOError& error) {
+        const std::uint64_t position = op->request.offset + op->done;
+        const std::size_t chunk = std::min(op->want - op->done, MaxReadChunk);
+        op->overlapped = OVERLAPPED{};
+        op->overlapped.Offset = static_cast<DWORD>(position & 0xFFFFFFFFu);
+        op->overlapped.OffsetHigh = static_cast<DWORD>(position >> 32);
+        if (!ReadFile(op->file, op->destination + op->done, static_cast<DWORD>(chunk), nullptr, &op->overlapped) &&
+            GetLastError() != ERROR_IO_PENDING) {
+            error = detail::LastOSError();
+            return false;
+        }
+        return true;
+    }
+
+    void Complete(Operation* op, IOError error) {
+        active.erase(std::find(active.begin(), active.end(), op));
+        Finish(op, error);
+    }
+
+    /// Open and issue queued operations up to maxInFlight
+    void StartQueued() {
+        while (active.size() < config.maxInFlight) {
+            Operation* op = nullptr;
+            {
+                std::lock_guard lock(mutex);
+                if (queue.empty()) return;
+                op = queue.front();
+                queue.pop_front();
+            }
+
+            IOError error = IOError::None;
+            if (!Prepare(*op, error)) {
+                Finish(op, error);
+                continue;
+            }
+            if (op->want == 0) {
+                Finish(op, IOError::None);
+                continue;
+            }
+            active.push_back(op);
+            if (!IssueRead(op, error)) {
+                Complete(op, error);
+            }
+        }
+    }
+
+    void CompletionLoop() {
+        bool quitting = false;
+        for (;;) {
+            if (!quitting) {
+                StartQueued();
+            } else if (active.empty()) {
+                return;
+            }
+
+            DWORD bytes = 0;
+            ULONG_PTR key = 0;
+            OVERLAPPED* overlapped = nullptr;
+            const BOOL ok = GetQueuedCompletionStatus(port, &bytes, &key, &overlapped, INFINITE);
+
+            if (!overlapped) {
+                if (key == QuitKey && !quitting) {
+                    // In-flight reads complete with ERROR_OPERATION_ABORTED below
+                    quitting = true;
+                    for (Operation* op : active) {
+                        CancelIoEx(op->file, &op->overlapped);
+                    }
+                }
+                continue;
+            }
+
+            Operation* op = reinterpret_cast<Operation*>(overlapped);
+            if (!ok) {
+                if (GetLastError() == ERROR_HANDLE_EOF) {
+                    Complete(op, IOError::None);
+                } else {
+                    Complete(op, quitting ? IOError::ReadError : detail::LastOSError());
+                }
+                continue;
+            }
+
+            op->done += bytes;
+            if (bytes == 0 || op->done == op->want || quitting) {
+                Complete(op, quitting && op->done != op->want ? IOError::ReadError : IOError::None);
+                continue;
+            }
+            IOError error = IOError::None;
+            if (!IssueRead(op, error)) {
+                Complete(op, error);
+            }
+        }
+    }
+#else
+    void WorkerLoop() {
+        for (;;) {
+            Operation* op = nullptr;
+            {
+                std::unique_lock lock(mutex);
+                wake.wait(lock, [this] { return stopping || !queue.empty(); });
+                if (stopping) return;
+                op = queue.front();
+                queue.pop_front();
+            }
+
+            IOError error = IOError::None;
+            if (!Prepare(*op, error)) {
+                Finish(op, error);
+                continue;
+            }
+            while (op->done < op->want) {
+                const ssize_t count = pread(op->fd, op->destination + op->done, op->want - op->done,
+                                            static_cast<off_t>(op->request.offset + op->done));
+                if (count < 0) {
+                    if (errno == EINTR) continue;
+                    error = detail::LastOSError();
+                    break;
+                }
+                if (count == 0) break;
+                op->done += static_cast<std::size_t>(count);
+            }
+            Finish(op, error);
+        }
+    }
+#endif
+
+    /// Fail every operation that never started
+    void FailQueued() {
+        std::deque<Operation*> left;
+        {
+            std::lock_guard lock(mutex);
+            left.swap(queue);
+        }
+        for (Operation* op : left) {
+            Finish(op, IOError::ReadError);
+        }
+    }
+};
+
+namespace {
+
+/// Queue a batch on the reader and wake its I/O threads
+template<typename ReaderState>
+void Enqueue(ReaderState* state, std::vector<ReadRequest>&& requests, std::shared_ptr<BatchSink>&& sink) {
+    if (!state) {
+        for (std::size_t i = 0; i < requests.size(); ++i) {
+            sink->Deliver(i, std::unexpected(IOError::Unknown));
+        }
+        return;
+    }
+
+    std::vector<Operation*> ops;
+    ops.reserve(requests.size());
+    for (std::size_t i = 0; i < requests.size(); ++i) {
+        auto* op = new Operation();
+        op->request = std::move(requests[i]);
+        op->index = i;
+        op->sink = sink;
+        ops.push_back(op);
+    }
+
+    state->pending.fetch_add(ops.size(), std::memory_order_acq_rel);
+    {
+        std::lock_guard lock(state->mutex);
+        state->queue.insert(state->queue.end(), ops.begin(), ops.end());
+    }
+#ifdef _WIN32
+    PostQueuedCompletionStatus(state->port, 0, WakeKey, nullptr);
+#else
+    state->wake.notify_all();
+#endif
+}
+
+} // anonymous namespace
+
+// ============================================================================
+// AsyncReader Implementation
+// ============================================================================
+
+AsyncReader::AsyncReader(const AsyncReadConfig& config) {
+    auto state = std::make_unique<State>();
+    state->config = config;
+    state->config.maxInFlight = std::max<std::size_t>(config.maxInFlight, 1);
+
+#ifdef _WIN32
+    state->port = CreateIoCompletionPort(INVALID_HANDLE_VALUE, nullptr, 0, 1);
+    if (!state->port) return;
+    State* raw = state.get();
+    state->thread = std::thread([raw] { raw->CompletionLoop(); });
+#else
+    State* raw = state.get();
+    const std::size_t workers = std::max<std::size_t>(config.workerThreads, 1);
+    for (std::size_t i = 0; i < workers; ++i) {
+        state->workers.emplace_back([raw] { raw->WorkerLoop(); });
+    }
+#endif
+
+    m_state = state.release();
+}
+
+AsyncReader::~AsyncReader() {
+    if (!m_state) return;
+
+    {
+        std::lock_guard lock(m_state->mutex);
+        m_state->stopping = true;
+    }
+#ifdef _WIN32
+    PostQueuedCompletionStatus(m_state->port, 0, QuitKey, nullptr);
+    if (m_state->thread.joinable()) m_state->thread.join();
+    CloseHandle(m_state->port);
+#else
+    m_state->wake.notify_all();
+    for (auto& worker : m_state->workers) {
+        worker.join();
+    }
+#endif
+    m_state->FailQueued();
+
+    delete m_state;
+    m_state = nullptr;
+}
+
+void AsyncReader::Submit(std::vector<ReadRequest> requests, ReadCallback callback) {
+    auto sink = std::make_shared<BatchSink>();
+    sink->callback = std::move(callback);
+    Enqueue(m_state, std::move(requests), std::move(sink));
+}
+
+std::vector<std::future<ReadResult>> AsyncReader::Submit(std::vector<ReadRequest> requests) {
+    // A sink without a callback fulfils one promise per request
+    auto sink = std::make_shared<BatchSink>();
+    sink->promises.resize(requests.size());
+
+    std::vector<std::future<ReadResult>> futures;
+    futures.reserve(requests.size());
+    for (auto& promise : sink->promises) {
+        futures.push_back(promise.get_future());
+    }
+
+    Enqueue(m_state, std::move(requests), std::move(sink));
+    return futures;
+}
+
+std::vector<ReadResult> AsyncReader::ReadAll(std::vector<ReadRequest> requests) {
+    auto futures = Submit(std::move(requests));
+    std::vector<ReadResult> results;
+    results.reserve(futures.size());
+    for (auto& future : futures) {
+        results.push_back(future.get());
+    }
+    return results;
+}
+
+void AsyncReader::Recycle(ByteBuffer buffer) {
+    if (m_state) m_state->Recycle(std::move(buffer));
+}
+
+std::size_t AsyncReader::Pending() const noexcept {
+    return m_state ? m_state->pending.load(std::memory_order_acquire) : 0;
+}
+
+} // namespace io
+} // namespace yu
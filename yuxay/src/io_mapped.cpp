@@ -0,0 +1,246 @@
+/**
+ * @file io_mapped.cpp
+ * @brief Implementation of read-only memory-mapped files
+ */
+
+#include "yu/io_mapped.h"
+
+#include <limits>
+
+#ifdef _WIN32
+    #define WIN32_LEAN_AND_MEAN
+    #define NOMINMAX
+    #include <windows.h>
+#else
+    #include <fcntl.h>
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+    #include <unistd.h>
+#endif
+
+namespace yu {
+namespace io {
+
+namespace {
+
+#ifndef _WIN32
+int AdviceFor(AccessHint hint) {
+    switch (hint) {
+        case AccessHint::Sequential: return POSIX_MADV_SEQUENTIAL;
+        case AccessHint::Random:     return POSIX_MADV_RANDOM;
+        default:                     return POSIX_MADV_NORMAL;
+    }
+}
+#endif
+
+} // anonymous namespace
+
+// ============================================================================
+// MappedView Implementation
+// ============================================================================
+
+MappedView& MappedView::operator=(MappedView&& other) noexcept {
+    if (this != &other) {
+        Unmap();
+        m_base = std::exchange(other.m_base, nullptr);
+        m_mappedSize = std::exchange(other.m_mappedSize, 0);
+        m_data = std::exchange(other.m_data, nullptr);
+        m_size = std::exchange(other.m_size, 0);
+        m_offset = std::exchange(other.m_offset, 0);
+    }
+    return *this;
+}
+
+void MappedView::Unmap() noexcept {
+    if (m_base) {
+#ifdef _WIN32
+        UnmapViewOfFile(m_base);
+#else
+        munmap(m_base, m_mappedSize);
+#endif
+    }
+    m_base = nullptr;
+    m_mappedSize = 0;
+    m_data = nullptr;
+    m_size = 0;
+    m_offset = 0;
+}
+
+// ============================================================================
+// MappedFile Implementation
+// ============================================================================
+
+std::size_t MappedFile::WindowAlignment() noexcept {
+#ifdef _WIN32
+    SYSTEM_INFO info;
+    GetSystemInfo(&info);
+    return static_cast<std::size_t>(info.dwAllocationGranularity);
+#else
+    return static_cast<std::size_t>(sysconf(_SC_PAGESIZE));
+#endif
+}
+
+Result<MappedFile> MappedFile::Open(const std::filesystem::path& path, AccessHint hint) {
+    auto resolved = FileSystem::Instance().ResolvePath(path);
+
+    MappedFile file;
+    file.m_hint = hint;
+
+#ifdef _WIN32
+    // The cache manager uses the same hints for the pages behind a mapping
+    DWORD flags = FILE_ATTRIBUTE_NORMAL;
+    if (hint == AccessHint::Sequential) flags |= FILE_FLAG_SEQUENTIAL_SCAN;
+    if (hint == AccessHint::Random) flags |= FILE_FLAG_RANDOM_ACCESS;
+
+    HANDLE handle = CreateFileW(resolved.c_str(), GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_DELETE,
+                                nullptr, OPEN_EXISTING, flags, nullptr);
+    if (handle == INVALID_HANDLE_VALUE) {
+        return std::unexpected(detail::LastOSError());
+    }
+    file.m_file = handle;
+
+    LARGE_INTEGER size;
+    if (!GetFileSizeEx(handle, &size)) {
+        return std::unexpected(detail::LastOSError());
+    }
+    file.m_size = static_cast<std::uint64_t>(size.QuadPart);
+
+    // A mapping of an empty file cannot be created; it has nothing to view anyway
+    if (file.m_size > 0) {
+        file.m_mapping = CreateFileMappingW(handle, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        if (!file.m_mapping) {
+            return std::unexpected(detail::LastOSError());
+        }
+    }
+#else
+    file.m_fd = open(resolved.c_str(), O_RDONLY | O_CLOEXEC);
+    if (file.m_fd < 0) {
+        return std::unexpected(detail::LastOSError());
+    }
+
+    struct stat info;
+    if (fstat(file.m_fd, &info) != 0) {
+        return std::unexpected(detail::LastOSError());
+    }
+    if (!S_ISREG(info.st_mode)) {
+        return std::unexpected(IOError::InvalidPath);
+    }
+    file.m_size = static_cast<std::uint64_t>(info.st_size);
+
+    if (hint != AccessHint::Normal) {
+        posix_fadvise(file.m_fd, 0, 0, hint == AccessHint::Sequential ? POSIX_FADV_SEQUENTIAL : POSIX_FADV_RANDOM);
+    }
+#endif
+
+    return file;
+}
+
+MappedFile& MappedFile::operator=(MappedFile&& other) noexcept {
+    if (this != &other) {
+        Close();
+#ifdef _WIN32
+        m_file = std::exchange(other.m_file, nullptr);
+        m_mapping = std::exchange(other.m_mapping, nullptr);
+#else
+        m_fd = std::exchange(other.m_fd, -1);
+#endif
+        m_size = std::exchange(other.m_size, 0);
+        m_hint = std::exchange(other.m_hint, AccessHint::Normal);
+        m_whole = std::move(other.m_whole);
+        m_wholeMapped = std::exchange(other.m_wholeMapped, false);
+    }
+    return *this;
+}
+
+bool MappedFile::IsOpen() const noexcept {
+#ifdef _WIN32
+    return m_file != nullptr;
+#else
+    return m_fd >= 0;
+#endif
+}
+
+Result<std::span<const std::uint8_t>> MappedFile::View() {
+    if (!IsOpen()) {
+        return std::unexpected(IOError::ReadError);
+    }
+    if (!m_wholeMapped) {
+        if (m_size > std::numeric_limits<std::size_t>::max()) {
+            return std::unexpected(IOError::TooLarge);
+        }
+        auto view = MapWindow(0, static_cast<std::size_t>(m_size));
+        if (!view) {
+            return std::unexpected(view.error());
+        }
+        m_whole = std::move(*view);
+        m_wholeMapped = true;
+    }
+    return m_whole.Data();
+}
+
+Result<MappedView> MappedFile::MapWindow(std::uint64_t offset, std::size_t length) const {
+    if (!IsOpen() || offset > m_size) {
+        return std::unexpected(IOError::ReadError);
+    }
+
+    MappedView view;
+    view.m_offset = offset;
+
+    const std::uint64_t available = m_size - offset;
+    if (length > available) {
+        length = static_cast<std::size_t>(available);
+    }
+    if (length == 0) {
+        return view;
+    }
+
+    // The OS maps from an aligned offset; the view skips the bytes before the one asked for
+    const std::uint64_t alignment = WindowAlignment();
+    const std::uint64_t base = offset - offset % alignment;
+    const std::size_t lead = static_cast<std::size_t>(offset - base);
+    if (length > std::numeric_limits<std::size_t>::max() - lead) {
+        return std::unexpected(IOError::TooLarge);
+    }
+    const std::size_t mappedSize = lead + length;
+
+#ifdef _WIN32
+    void* address = MapViewOfFile(m_mapping, FILE_MAP_READ,
+                                  static_cast<DWORD>(base >> 32), static_cast<DWORD>(base & 0xFFFFFFFFu),
+                                  mappedSize);
+    if (!address) {
+        return std::unexpected(detail::LastOSError());
+    }
+#else
+    void* address = mmap(nullptr, mappedSize, PROT_READ, MAP_PRIVATE, m_fd, static_cast<off_t>(base));
+    if (address == MAP_FAILED) {
+        return std::unexpected(detail::LastOSError());
+    }
+    if (m_hint != AccessHint::Normal) {
+        posix_madvise(address, mappedSize, AdviceFor(m_hint));
+    }
+#endif
+
+    view.m_base = address;
+    view.m_mappedSize = mappedSize;
+    view.m_data = static_cast<const std::uint8_t*>(address) + lead;
+    view.m_size = length;
+    return view;
+}
+
+void MappedFile::Close() noexcept {
+    m_whole.Unmap();
+    m_wholeMapped = false;
+#ifdef _WIN32
+    if (m_mapping) CloseHandle(m_mapping);
+    if (m_file) CloseHandle(m_file);
+    m_mapping = nullptr;
+    m_file = nullptr;
+#else
+    if (m_fd >= 0) close(m_fd);
+    m_fd = -1;
+#endif
+    m_size = 0;
+}
+
+} // namespace io
+} // namespace yu
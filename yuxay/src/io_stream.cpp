@@ -0,0 +1,422 @@
+/**
+ * @file io_stream.cpp
+ * @brief Implementation of the buffered streaming file writer
+ */
+
+#include "yu/io_stream.h"
+#include "yu/memory_os.h"
+
+#include <algorithm>
+#include <cstring>
+#include <system_error>
+
+#ifdef _WIN32
+    #define WIN32_LEAN_AND_MEAN
+    #define NOMINMAX
+    #include <windows.h>
+#else
+    #include <cerrno>
+    #include <cstdio>
+    #include <fcntl.h>
+    #include <unistd.h>
+#endif
+
+namespace yu {
+namespace io {
+
+namespace {
+
+/// Largest single write call (WriteFile takes a DWORD length)
+constexpr std::size_t MaxWriteChunk = std::size_t{1} << 30;
+
+/// Length of TempSuffix, terminator included
+constexpr std::size_t TempSuffixSize = 5;
+
+/// Suffix of the temporary file in Atomic mode, as narrow or wide path characters
+template<typename Char>
+constexpr Char TempSuffix[TempSuffixSize] = {'.', 't', 'm', 'p', '\0'};
+
+template<typename Char>
+std::size_t PathLength(const Char* path) noexcept {
+    std::size_t len = 0;
+    while (path[len]) ++len;
+    return len;
+}
+
+/// Build "<path>.tmp" into out (Open checked that it fits)
+template<typename Char>
+void TempPath(const Char* path, Char* out) noexcept {
+    const std::size_t len = PathLength(path);
+    std::memcpy(out, path, len * sizeof(Char));
+    std::memcpy(out + len, TempSuffix<Char>, sizeof(TempSuffix<Char>));
+}
+
+} // anonymous namespace
+
+// ============================================================================
+// Open / Close
+// ============================================================================
+
+Result<bool> StreamWriter::Open(const char* path, StreamMode mode, const StreamWriterConfig& config) noexcept {
+#ifdef _WIN32
+    if (!path || !*path) {
+        return std::unexpected(IOError::InvalidPath);
+    }
+    // Widen on the stack; a path that does not fit could not be opened anyway
+    wchar_t widePath[MaxPath];
+    if (MultiByteToWideChar(CP_UTF8, MB_ERR_INVALID_CHARS, path, -1, widePath, static_cast<int>(MaxPath)) == 0) {
+        return std::unexpected(IOError::InvalidPath);
+    }
+    return OpenNative(widePath, mode, config);
+#else
+    return OpenNative(path, mode, config);
+#endif
+}
+
+#ifdef _WIN32
+Result<bool> StreamWriter::Open(const wchar_t* path, StreamMode mode, const StreamWriterConfig& config) noexcept {
+    return OpenNative(path, mode, config);
+}
+#endif
+
+Result<bool> StreamWriter::OpenNative(const PathChar* path, StreamMode mode, const StreamWriterConfig& config) noexcept {
+    if (m_open) {
+        (void)Close();
+    }
+    if (!path || !*path) {
+        return std::unexpected(IOError::InvalidPath);
+    }
+
+    const std::size_t pathLen = PathLength(path);
+    if (pathLen + TempSuffixSize > MaxPath) {
+        return std::unexpected(IOError::InvalidPath);
+    }
+    std::memcpy(m_path, path, (pathLen + 1) * sizeof(PathChar));
+
+    m_mode = mode;
+    m_unbuffered = config.unbuffered && mode != StreamMode::Append;
+    m_error.store(IOError::None, std::memory_order_relaxed);
+    m_used = 0;
+    m_flushed = 0;
+
+    // Whole pages: the alignment FILE_FLAG_NO_BUFFERING/O_DIRECT ask for
+    const std::size_t page = mem::os::PageSize();
+    m_capacity = std::max(config.bufferSize, page);
+    m_capacity = (m_capacity + page - 1) / page * page;
+
+    m_buffers[0] = static_cast<std::uint8_t*>(mem::os::AllocatePages(m_capacity));
+    if (config.backgroundFlush) {
+        m_buffers[1] = static_cast<std::uint8_t*>(mem::os::AllocatePages(m_capacity));
+    }
+    if (!m_buffers[0] || (config.backgroundFlush && !m_buffers[1])) {
+        Release();
+        return std::unexpected(IOError::TooLarge);
+    }
+    m_current = m_buffers[0];
+
+    PathChar tempPath[MaxPath + TempSuffixSize];
+    const PathChar* openPath = path;
+    if (mode == StreamMode::Atomic) {
+        TempPath(path, tempPath);
+        openPath = tempPath;
+    }
+
+#ifdef _WIN32
+    DWORD flags = FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN;
+    if (m_unbuffered) flags |= FILE_FLAG_NO_BUFFERING;
+    if (config.writeThrough) flags |= FILE_FLAG_WRITE_THROUGH;
+
+    // FILE_APPEND_DATA without FILE_WRITE_DATA makes every write land at the end
+    const DWORD access = mode == StreamMode::Append ? FILE_APPEND_DATA | SYNCHRONIZE : GENERIC_WRITE;
+    const DWORD disposition = mode == StreamMode::Append ? OPEN_ALWAYS : CREATE_ALWAYS;
+    HANDLE handle = CreateFileW(openPath, access, FILE_SHARE_READ, nullptr, disposition, flags, nullptr);
+    if (handle == INVALID_HANDLE_VALUE) {
+        const IOError error = detail::LastOSError(IOError::WriteError);
+        Release();
+        return std::unexpected(error);
+    }
+    m_file = handle;
+#else
+    int flags = O_WRONLY | O_CREAT | O_CLOEXEC;
+    flags |= mode == StreamMode::Append ? O_APPEND : O_TRUNC;
+    if (config.writeThrough) flags |= O_DSYNC;
+#ifdef O_DIRECT
+    if (m_unbuffered) {
+        m_fd = open(openPath, flags | O_DIRECT, 0644);
+    }
+#endif
+    if (m_fd < 0) {
+        // Some file systems (tmpfs) refuse O_DIRECT; write through the cache instead
+        m_unbuffered = false;
+        m_fd = open(openPath, flags, 0644);
+    }
+    if (m_fd < 0) {
+        const IOError error = detail::LastOSError(IOError::WriteError);
+        Release();
+        return std::unexpected(error);
+    }
+#endif
+
+    m_open = true;
+
+    if (config.backgroundFlush) {
+        m_stopping = false;
+        try {
+            m_flusher = std::thread([this] { FlusherLoop(); });
+        } catch (const std::system_error&) {
+            // No thread: full buffers are written on the calling thread
+        }
+    }
+    return true;
+}
+
+Result<bool> StreamWriter::Open(const std::filesystem::path& path, StreamMode mode, const StreamWriterConfig& config) {
+    auto resolved = FileSystem::Instance().ResolvePath(path);
+    if (resolved.has_parent_path()) {
+        std::error_code ec;
+        std::filesystem::create_directories(resolved.parent_path(), ec);
+    }
+    return OpenNative(resolved.c_str(), mode, config);
+}
+
+Result<bool> StreamWriter::Close() noexcept {
+    if (!m_open) {
+        return true;
+    }
+
+    (void)Flush();
+
+    // Unbuffered: the last partial page goes out padded, then the file is cut to length
+    if (m_unbuffered && m_used > 0 && GetError() == IOError::None) {
+        const std::size_t page = mem::os::PageSize();
+        const std::size_t padded = (m_used + page - 1) / page * page;
+        std::memset(m_current + m_used, 0, padded - m_used);
+        if (WriteOut(m_current, padded)) {
+            const std::uint64_t total = m_flushed + m_used;
+#ifdef _WIN32
+            LARGE_INTEGER end;
+            end.QuadPart = static_cast<LONGLONG>(total);
+            if (!SetFilePointerEx(m_file, end, nullptr, FILE_BEGIN) || !SetEndOfFile(m_file)) {
+                Fail(detail::LastOSError(IOError::WriteError));
+            }
+#else
+            if (ftruncate(m_fd, static_cast<off_t>(total)) != 0) {
+                Fail(detail::LastOSError(IOError::WriteError));
+            }
+#endif
+            m_flushed = total;
+            m_used = 0;
+        }
+    }
+
+    const bool commit = m_mode == StreamMode::Atomic;
+    Release();
+
+    const IOError error = GetError();
+    if (commit) {
+        PathChar tempPath[MaxPath + TempSuffixSize];
+        TempPath(m_path, tempPath);
+        if (error != IOError::None) {
+#ifdef _WIN32
+            DeleteFileW(tempPath);
+#else
+            unlink(tempPath);
+#endif
+        } else {
+#ifdef _WIN32
+            if (!MoveFileExW(tempPath, m_path, MOVEFILE_REPLACE_EXISTING | MOVEFILE_WRITE_THROUGH)) {
+                return std::unexpected(detail::LastOSError(IOError::WriteError));
+            }
+#else
+            if (std::rename(tempPath, m_path) != 0) {
+                return std::unexpected(detail::LastOSError(IOError::WriteError));
+            }
+#endif
+        }
+    }
+
+    if (error != IOError::None) {
+        return std::unexpected(error);
+    }
+    return true;
+}
+
+void StreamWriter::Discard() noexcept {
+    if (!m_open) return;
+
+    // Pending data is dropped, not written
+    WaitIdle();
+    m_used = 0;
+    const bool remove = m_mode == StreamMode::Atomic;
+    Release();
+
+    if (remove) {
+        PathChar tempPath[MaxPath + TempSuffixSize];
+        TempPath(m_path, tempPath);
+#ifdef _WIN32
+        DeleteFileW(tempPath);
+#else
+        unlink(tempPath);
+#endif
+    }
+}
+
+void StreamWriter::Release() noexcept {
+    if (m_flusher.joinable()) {
+        {
+            std::lock_guard lock(m_mutex);
+            m_stopping = true;
+        }
+        m_wake.notify_one();
+        m_flusher.join();
+    }
+
+#ifdef _WIN32
+    if (m_file) CloseHandle(m_file);
+    m_file = nullptr;
+#else
+    if (m_fd >= 0) close(m_fd);
+    m_fd = -1;
+#endif
+
+    for (auto& buffer : m_buffers) {
+        mem::os::FreePages(buffer, m_capacity);
+        buffer = nullptr;
+    }
+    m_current = nullptr;
+    m_capacity = 0;
+    m_open = false;
+}
+
+// ============================================================================
+// Writing
+// ============================================================================
+
+bool StreamWriter::Write(const void* data, std::size_t size) noexcept {
+    if (!m_open || GetError() != IOError::None) {
+        return false;
+    }
+
+    const auto* bytes = static_cast<const std::uint8_t*>(data);
+    while (size > 0) {
+        const std::size_t count = std::min(size, m_capacity - m_used);
+        std::memcpy(m_current + m_used, bytes, count);
+        m_used += count;
+        bytes += count;
+        size -= count;
+        if (m_used == m_capacity) {
+            Submit(false);
+        }
+    }
+    return GetError() == IOError::None;
+}
+
+Result<bool> StreamWriter::Flush() noexcept {
+    if (m_open) {
+        Submit(true);
+    }
+    const IOError error = GetError();
+    if (error != IOError::None) {
+        return std::unexpected(error);
+    }
+    return true;
+}
+
+void StreamWriter::Submit(bool wait) noexcept {
+    // The other buffer may still be on its way out
+    WaitIdle();
+
+    // Unbuffered writes must be whole pages; the tail moves to the next buffer
+    std::size_t length = m_used;
+    if (m_unbuffered) {
+        const std::size_t page = mem::os::PageSize();
+        length -= length % page;
+    }
+    if (length == 0) {
+        return;
+    }
+
+    const std::size_t tail = m_used - length;
+    if (m_flusher.joinable()) {
+        std::uint8_t* next = m_current == m_buffers[0] ? m_buffers[1] : m_buffers[0];
+        std::memcpy(next, m_current + length, tail);
+        {
+            std::lock_guard lock(m_mutex);
+            m_pendingData = m_current;
+            m_pendingSize = length;
+        }
+        m_wake.notify_one();
+        m_current = next;
+        if (wait) {
+            WaitIdle();
+        }
+    } else {
+        WriteOut(m_current, length);
+        std::memmove(m_current, m_current + length, tail);
+    }
+
+    m_flushed += length;
+    m_used = tail;
+}
+
+bool StreamWriter::WriteOut(const std::uint8_t* buf, std::size_t len) noexcept {
+    while (len > 0) {
+        const std::size_t chunk = std::min(len, MaxWriteChunk);
+#ifdef _WIN32
+        DWORD written = 0;
+        if (!WriteFile(m_file, buf, static_cast<DWORD>(chunk), &written, nullptr) || written == 0) {
+            Fail(detail::LastOSError(IOError::WriteError));
+            return false;
+        }
+#else
+        const ssize_t written = write(m_fd, buf, chunk);
+        if (written < 0 && errno == EINTR) {
+            continue;
+        }
+        if (written <= 0) {
+            Fail(detail::LastOSError(IOError::WriteError));
+            return false;
+        }
+#endif
+        buf += written;
+        len -= static_cast<std::size_t>(written);
+    }
+    return true;
+}
+
+void StreamWriter::Fail(IOError error) noexcept {
+    IOError expected = IOError::None;
+    m_error.compare_exchange_strong(expected, error, std::memory_order_acq_rel);
+}
+
+// ============================================================================
+// Flusher Thread
+// ============================================================================
+
+void StreamWriter::WaitIdle() noexcept {
+    if (!m_flusher.joinable()) return;
+    std::unique_lock lock(m_mutex);
+    m_idle.wait(lock, [this] { return m_pendingData == nullptr; });
+}
+
+void StreamWriter::FlusherLoop() noexcept {
+    std::unique_lock lock(m_mutex);
+    for (;;) {
+        m_wake.wait(lock, [this] { return m_pendingData != nullptr || m_stopping; });
+        if (m_pendingData) {
+            const std::uint8_t* data = m_pendingData;
+            const std::size_t size = m_pendingSize;
+            lock.unlock();
+            WriteOut(data, size);
+            lock.lock();
+            m_pendingData = nullptr;
+            m_pendingSize = 0;
+            m_idle.notify_all();
+            continue;
+        }
+        if (m_stopping) return;
+    }
+}
+
+} // namespace io
+} // namespace yu
@@ -0,0 +1,527 @@
+/**
+ * @file jobs.cpp
+ * @brief Implementation of the work-stealing job system
+ */
+
+#include "yu/jobs.h"
+#include "yu/memory_lightweight.h"
+#include "yu/memory_os.h"
+
+#include <bit>
+#include <system_error>
+
+namespace yu {
+namespace jobs {
+
+namespace {
+
+/// Spins before an idle worker goes to sleep
+constexpr int IdleSpins = 64;
+
+constexpr std::size_t CacheLine = 64;
+
+enum JobState : std::uint8_t {
+    Free = 0,
+    Created,
+    Queued,
+    Done
+};
+
+thread_local JobSystem* t_system = nullptr;
+thread_local int t_worker = -1;
+thread_local std::uint32_t t_stealSeed = 0;
+
+std::size_t AlignUp(std::size_t value, std::size_t alignment) noexcept {
+    return (value + alignment - 1) / alignment * alignment;
+}
+
+} // anonymous namespace
+
+namespace detail {
+
+struct alignas(CacheLine) Job {
+    alignas(std::max_align_t) unsigned char storage[JobStorageSize];
+    JobFunction invoke = nullptr;
+    JobFunction destroy = nullptr;
+    std::atomic<std::int32_t> unfinished{0};   ///< This job plus its unfinished children
+    std::atomic<std::uint32_t> generation{0};
+    std::atomic<std::uint8_t> state{Free};
+    std::uint32_t parent = JobHandle::InvalidIndex;
+
+    // Continuations, guarded by lock
+    mem::Spinlock lock;
+    bool finished = false;
+    std::uint32_t continuationCount = 0;
+    JobHandle continuations[MaxContinuations];
+};
+
+/// Chase-Lev deque (fixed capacity): the owner pushes and pops at the bottom, thieves take the top
+struct WorkDeque {
+    alignas(CacheLine) std::atomic<std::int64_t> top{0};
+    alignas(CacheLine) std::atomic<std::int64_t> bottom{0};
+    alignas(CacheLine) std::atomic<std::uint32_t>* buffer = nullptr;
+    std::int64_t mask = 0;
+
+    bool Push(std::uint32_t value) noexcept {
+        const std::int64_t b = bottom.load(std::memory_order_relaxed);
+        const std::int64_t t = top.load(std::memory_order_acquire);
+        if (b - t > mask) return false;
+        buffer[b & mask].store(value, std::memory_order_relaxed);
+        bottom.store(b + 1, std::memory_order_release);
+        return true;
+    }
+
+    bool Pop(std::uint32_t& value) noexcept {
+        const std::int64_t b = bottom.load(std::memory_order_relaxed) - 1;
+        bottom.store(b, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        std::int64_t t = top.load(std::memory_order_relaxed);
+        if (t > b) {
+            bottom.store(b + 1, std::memory_order_relaxed);
+            return false;
+        }
+
+        value = buffer[b & mask].load(std::memory_order_relaxed);
+        if (t == b) {
+            // Last item: race the thieves for it
+            const bool won = top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst,
+                                                         std::memory_order_relaxed);
+            bottom.store(b + 1, std::memory_order_relaxed);
+            return won;
+        }
+        return true;
+    }
+
+    bool Steal(std::uint32_t& value) noexcept {
+        std::int64_t t = top.load(std::memory_order_acquire);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        const std::int64_t b = bottom.load(std::memory_order_acquire);
+        if (t >= b) return false;
+
+        const std::uint32_t candidate = buffer[t & mask].load(std::memory_order_relaxed);
+        if (!top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed)) {
+            return false;
+        }
+        value = candidate;
+        return true;
+    }
+};
+
+/// Bounded queue for jobs submitted by threads that are not workers
+struct SharedQueue {
+    alignas(CacheLine) mem::Spinlock lock;
+    std::uint32_t head = 0;
+    std::uint32_t tail = 0;
+    std::uint32_t mask = 0;
+    std::uint32_t* buffer = nullptr;
+    alignas(CacheLine) std::atomic<std::uint32_t> size{0}; ///< Lets takers skip the lock when empty
+
+    bool Push(std::uint32_t value) noexcept {
+        mem::SpinlockGuard guard(lock);
+        const bool ok = tail - head <= mask;
+        if (ok) {
+            buffer[tail++ & mask] = value;
+            size.fetch_add(1, std::memory_order_release);
+        }
+        return ok;
+    }
+
+    bool Pop(std::uint32_t& value) noexcept {
+        if (size.load(std::memory_order_acquire) == 0) return false;
+        mem::SpinlockGuard guard(lock);
+        const bool ok = head != tail;
+        if (ok) {
+            value = buffer[head++ & mask];
+            size.fetch_sub(1, std::memory_order_relaxed);
+        }
+        return ok;
+    }
+};
+
+} // namespace detail
+
+// ============================================================================
+// Start / Stop
+// ============================================================================
+
+JobSystem& JobSystem::Instance() noexcept {
+    static JobSystem instance;
+    return instance;
+}
+
+bool JobSystem::Start(const JobSystemConfig& config) {
+    if (m_running.load(std::memory_order_acquire)) {
+        return false;
+    }
+
+    std::uint32_t workers = config.workerThreads;
+    if (workers == 0) {
+        const unsigned hardware = std::thread::hardware_concurrency();
+        workers = hardware > 1 ? hardware - 1 : 1;
+    }
+    const std::uint32_t jobCount = std::bit_ceil(std::max<std::uint32_t>(config.maxJobs, 2));
+    const std::uint32_t capacity = std::bit_ceil(std::max<std::uint32_t>(config.queueCapacity, 2));
+
+    // One block of OS pages: slots, deques, shared queue, then the queue buffers
+    const std::size_t jobsBytes = AlignUp(sizeof(detail::Job) * jobCount, CacheLine);
+    const std::size_t dequesBytes = AlignUp(sizeof(detail::WorkDeque) * workers, CacheLine);
+    const std::size_t sharedBytes = AlignUp(sizeof(detail::SharedQueue), CacheLine);
+    const std::size_t buffersBytes = sizeof(std::uint32_t) * capacity * (workers + 1);
+    m_pageBytes = jobsBytes + dequesBytes + sharedBytes + buffersBytes;
+
+    auto* block = static_cast<std::uint8_t*>(mem::os::AllocatePages(m_pageBytes));
+    if (!block) {
+        m_pageBytes = 0;
+        return false;
+    }
+
+    m_jobs = reinterpret_cast<detail::Job*>(block);
+    for (std::uint32_t i = 0; i < jobCount; ++i) {
+        ::new (&m_jobs[i]) detail::Job();
+    }
+    m_jobMask = jobCount - 1;
+    m_nextJob.store(0, std::memory_order_relaxed);
+
+    auto* buffers = reinterpret_cast<std::uint32_t*>(block + jobsBytes + dequesBytes + sharedBytes);
+    m_deques = reinterpret_cast<detail::WorkDeque*>(block + jobsBytes);
+    for (std::uint32_t w = 0; w < workers; ++w) {
+        auto* deque = ::new (&m_deques[w]) detail::WorkDeque();
+        deque->buffer = reinterpret_cast<std::atomic<std::uint32_t>*>(buffers + static_cast<std::size_t>(w) * capacity);
+        deque->mask = capacity - 1;
+    }
+    m_shared = ::new (block + jobsBytes + dequesBytes) detail::SharedQueue();
+    m_shared->buffer = buffers + static_cast<std::size_t>(workers) * capacity;
+    m_shared->mask = capacity - 1;
+    m_queueCapacity = capacity;
+
+    m_workerCount = workers;
+    m_executed.store(0, std::memory_order_relaxed);
+    m_stolen.store(0, std::memory_order_relaxed);
+    m_inlined.store(0, std::memory_order_relaxed);
+    m_queued.store(0, std::memory_order_relaxed);
+    m_stopping.store(false, std::memory_order_relaxed);
+    m_running.store(true, std::memory_order_release);
+
+    m_threads.reserve(workers);
+    for (std::uint32_t w = 0; w < workers; ++w) {
+        try {
+            m_threads.emplace_back([this, w] { WorkerLoop(static_cast<int>(w)); });
+        } catch (const std::system_error&) {
+            // Fewer threads: their deques stay empty, and the remaining workers still take shared jobs
+            break;
+        }
+    }
+    if (m_threads.empty()) {
+        m_running.store(false, std::memory_order_release);
+        Release();
+        return false;
+    }
+    return true;
+}
+
+void JobSystem::Stop() noexcept {
+    if (!m_running.exchange(false, std::memory_order_acq_rel)) {
+        return;
+    }
+
+    // New jobs run inline from here on; queued ones still run
+    while (m_queued.load(std::memory_order_acquire) > 0) {
+        if (!TryExecuteOne()) std::this_thread::yield();
+    }
+
+    {
+        std::lock_guard lock(m_sleepMutex);
+        m_stopping.store(true, std::memory_order_release);
+    }
+    m_wake.notify_all();
+    for (std::thread& thread : m_threads) {
+        thread.join();
+    }
+    m_threads.clear();
+
+    for (std::uint32_t i = 0; i <= m_jobMask; ++i) {
+        detail::Job& job = m_jobs[i];
+        if (job.state.load(std::memory_order_acquire) == Created) {
+            job.destroy(job.storage);
+        }
+    }
+    Release();
+}
+
+void JobSystem::Release() noexcept {
+    if (m_jobs) {
+        for (std::uint32_t i = 0; i <= m_jobMask; ++i) m_jobs[i].~Job();
+        for (std::uint32_t w = 0; w < m_workerCount; ++w) m_deques[w].~WorkDeque();
+        m_shared->~SharedQueue();
+        mem::os::FreePages(m_jobs, m_pageBytes);
+    }
+    m_jobs = nullptr;
+    m_deques = nullptr;
+    m_shared = nullptr;
+    m_jobMask = 0;
+    m_workerCount = 0;
+    m_pageBytes = 0;
+}
+
+// ============================================================================
+// Jobs
+// ============================================================================
+
+JobHandle JobSystem::Allocate(detail::JobFunction invoke, detail::JobFunction destroy, JobHandle parent,
+                              void** storage) noexcept {
+    *storage = nullptr;
+    if (!IsRunning()) {
+        return {};
+    }
+
+    // Every slot in use: help run queued jobs until one is free. Only Stop() ends the wait.
+    while (IsRunning()) {
+        for (std::uint32_t tries = 0; tries <= m_jobMask; ++tries) {
+            const std::uint32_t index = m_nextJob.fetch_add(1, std::memory_order_relaxed) & m_jobMask;
+            detail::Job& job = m_jobs[index];
+            std::uint8_t state = job.state.load(std::memory_order_acquire);
+            if (state != Free && state != Done) continue;
+            if (!job.state.compare_exchange_strong(state, Created, std::memory_order_acq_rel)) continue;
+
+            const std::uint32_t generation = job.generation.fetch_add(1, std::memory_order_acq_rel) + 1;
+            job.invoke = invoke;
+            job.destroy = destroy;
+            job.unfinished.store(1, std::memory_order_relaxed);
+            job.parent = JobHandle::InvalidIndex;
+            {
+                // A stale AddContinuation may still be looking at the previous job
+                mem::SpinlockGuard guard(job.lock);
+                job.finished = false;
+                job.continuationCount = 0;
+            }
+
+            // A parent whose slot this job just took has finished
+            if (parent.Valid() && parent.index != index) {
+                JoinParent(parent, job);
+            }
+
+            *storage = job.storage;
+            return {index, generation};
+        }
+        if (!TryExecuteOne()) {
+            YU_PAUSE();
+        }
+    }
+    return {};
+}
+
+void JobSystem::JoinParent(JobHandle parent, detail::Job& child) noexcept {
+    // Join only while the parent is unfinished: counting up from 0 would let it finish twice
+    detail::Job& owner = m_jobs[parent.index];
+    std::int32_t unfinished = owner.unfinished.load(std::memory_order_acquire);
+    while (unfinished > 0 &&
+           !owner.unfinished.compare_exchange_weak(unfinished, unfinished + 1, std::memory_order_acq_rel,
+                                                   std::memory_order_acquire)) {
+    }
+    if (unfinished <= 0) {
+        return;
+    }
+    if (owner.generation.load(std::memory_order_acquire) != parent.generation) {
+        // The slot was reused by another job between the handle and the increment: give the count back
+        Finish(parent.index);
+        return;
+    }
+    child.parent = parent.index;
+}
+
+void JobSystem::Run(JobHandle handle) noexcept {
+    if (!handle.Valid() || !m_jobs) {
+        return;
+    }
+    detail::Job& job = m_jobs[handle.index];
+    if (job.generation.load(std::memory_order_acquire) != handle.generation) {
+        return;
+    }
+    std::uint8_t expected = Created;
+    if (!job.state.compare_exchange_strong(expected, Queued, std::memory_order_acq_rel)) {
+        return;
+    }
+
+    // Queue full: running a job frees room, since it is taken from the queue this thread pushes to
+    while (!Push(handle.index)) {
+        if (!TryExecuteOne()) {
+            YU_PAUSE();
+        }
+    }
+}
+
+bool JobSystem::AddContinuation(JobHandle ancestor, JobHandle continuation) noexcept {
+    if (!continuation.Valid()) {
+        return true;
+    }
+    if (IsDone(ancestor)) {
+        Run(continuation);
+        return true;
+    }
+
+    detail::Job& job = m_jobs[ancestor.index];
+    job.lock.lock();
+    if (job.generation.load(std::memory_order_acquire) != ancestor.generation || job.finished) {
+        job.lock.unlock();
+        Run(continuation);
+        return true;
+    }
+    if (job.continuationCount == MaxContinuations) {
+        job.lock.unlock();
+        return false;
+    }
+    job.continuations[job.continuationCount++] = continuation;
+    job.lock.unlock();
+    return true;
+}
+
+bool JobSystem::IsDone(JobHandle handle) const noexcept {
+    if (!handle.Valid() || !m_jobs) {
+        return true;
+    }
+    const detail::Job& job = m_jobs[handle.index];
+    return job.generation.load(std::memory_order_acquire) != handle.generation ||
+           job.state.load(std::memory_order_acquire) == Done;
+}
+
+void JobSystem::Wait(JobHandle handle) noexcept {
+    while (!IsDone(handle)) {
+        if (!TryExecuteOne()) {
+            YU_PAUSE();
+        }
+    }
+}
+
+void JobSystem::Execute(std::uint32_t index) noexcept {
+    detail::Job& job = m_jobs[index];
+    job.invoke(job.storage);
+    m_executed.fetch_add(1, std::memory_order_relaxed);
+    Finish(index);
+}
+
+void JobSystem::Finish(std::uint32_t index) noexcept {
+    detail::Job& job = m_jobs[index];
+    if (job.unfinished.fetch_sub(1, std::memory_order_acq_rel) != 1) {
+        return;
+    }
+
+    // Copy everything out first: the slot may be reused as soon as it is Done
+    JobHandle continuations[MaxContinuations];
+    job.lock.lock();
+    job.finished = true;
+    const std::uint32_t count = job.continuationCount;
+    for (std::uint32_t i = 0; i < count; ++i) {
+        continuations[i] = job.continuations[i];
+    }
+    job.lock.unlock();
+    const std::uint32_t parent = job.parent;
+    job.state.store(Done, std::memory_order_release);
+
+    for (std::uint32_t i = 0; i < count; ++i) {
+        Run(continuations[i]);
+    }
+    if (parent != JobHandle::InvalidIndex) {
+        Finish(parent);
+    }
+}
+
+JobStats JobSystem::GetStats() const noexcept {
+    JobStats stats;
+    stats.executed = m_executed.load(std::memory_order_relaxed);
+    stats.stolen = m_stolen.load(std::memory_order_relaxed);
+    stats.inlined = m_inlined.load(std::memory_order_relaxed);
+    return stats;
+}
+
+// ============================================================================
+// Queues and Workers
+// ============================================================================
+
+bool JobSystem::Push(std::uint32_t index) noexcept {
+    // Counted before it becomes visible, so m_queued never underflows
+    m_queued.fetch_add(1, std::memory_order_seq_cst);
+
+    bool pushed = false;
+    if (t_system == this && t_worker >= 0) {
+        pushed = m_deques[t_worker].Push(index);
+    }
+    if (!pushed) {
+        pushed = m_shared->Push(index);
+    }
+    if (!pushed) {
+        m_queued.fetch_sub(1, std::memory_order_relaxed);
+        return false;
+    }
+
+    if (m_sleepers.load(std::memory_order_seq_cst) > 0) {
+        // Taking the mutex orders this wake after a sleeper's predicate check
+        { std::lock_guard lock(m_sleepMutex); }
+        m_wake.notify_one();
+    }
+    return true;
+}
+
+bool JobSystem::TakeJob(int worker, std::uint32_t& index) noexcept {
+    if (worker >= 0 && m_deques[worker].Pop(index)) {
+        return true;
+    }
+    if (m_shared->Pop(index)) {
+        return true;
+    }
+
+    const std::uint32_t start = worker >= 0 ? static_cast<std::uint32_t>(worker) + 1 : t_stealSeed++;
+    for (std::uint32_t i = 0; i < m_workerCount; ++i) {
+        const std::uint32_t victim = (start + i) % m_workerCount;
+        if (static_cast<int>(victim) == worker) continue;
+        if (m_deques[victim].Steal(index)) {
+            m_stolen.fetch_add(1, std::memory_order_relaxed);
+            return true;
+        }
+    }
+    return false;
+}
+
+bool JobSystem::TryExecuteOne() noexcept {
+    if (!m_jobs) {
+        return false;
+    }
+    const int worker = t_system == this ? t_worker : -1;
+    std::uint32_t index;
+    if (!TakeJob(worker, index)) {
+        return false;
+    }
+    m_queued.fetch_sub(1, std::memory_order_relaxed);
+    Execute(index);
+    return true;
+}
+
+void JobSystem::WorkerLoop(int worker) noexcept {
+    t_system = this;
+    t_worker = worker;
+
+    int spins = 0;
+    while (!m_stopping.load(std::memory_order_acquire)) {
+        if (TryExecuteOne()) {
+            spins = 0;
+            continue;
+        }
+        if (++spins < IdleSpins) {
+            YU_PAUSE();
+            continue;
+        }
+
+        std::unique_lock lock(m_sleepMutex);
+        m_sleepers.fetch_add(1, std::memory_order_seq_cst);
+        m_wake.wait(lock, [this] {
+            return m_queued.load(std::memory_order_seq_cst) > 0 || m_stopping.load(std::memory_order_relaxed);
+        });
+        m_sleepers.fetch_sub(1, std::memory_order_relaxed);
+        spins = 0;
+    }
+
+    t_system = nullptr;
+    t_worker = -1;
+}
+
+} // namespace jobs
+} // namespace yu
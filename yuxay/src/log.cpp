@@ -7,6 +7,10 @@
 #include <iostream>
 #include <filesystem>
 #include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <thread>
+#include <unordered_set>
 
 #ifdef _WIN32
 #define WIN32_LEAN_AND_MEAN
@@ -18,22 +22,414 @@
 
 namespace yu {
 
+// ============================================================================
+// Asynchronous state
+// ============================================================================
+
+/// Bounded MPSC ring (Vyukov-style per-slot sequence numbers) plus the writer thread
+///
+/// A slot at ring position pos is free for the producer that claims pos when
+/// sequence == pos, and ready for the consumer when sequence == pos + 1.
+/// Consuming it sets sequence = pos + capacity, freeing it for the next lap.
+struct Logger::AsyncState {
+    std::unique_ptr<detail::LogSlot[]> slots;
+    std::size_t                        capacity{0};
+    std::size_t                        mask{0};
+    AsyncLogConfig                     config;
+
+    alignas(64) std::atomic<std::size_t> tail{0};  // Next position to claim (producers)
+    alignas(64) std::size_t              head{0};  // Next position to consume (writer only)
+    std::atomic<std::size_t>             consumed{0};
+
+    std::thread       writer;
+    std::atomic<bool> running{false};
+    std::atomic<bool> flushRequested{false};
+
+    // Writer-side batch buffers, reused across batches
+    std::string consoleBatch;
+    std::string fileBatch;
+    std::string binaryBatch;
+    std::size_t reportedDrops{0};
+
+    // Binary mode: sites already defined in the current .bin file
+    std::unordered_set<std::uint32_t> emittedSites;
+    std::uint32_t                     emittedGeneration{0};
+    std::chrono::steady_clock::time_point lastSync{};
+};
+
+namespace {
+
+template <typename T>
+void AppendRaw(std::string& out, const T& value) {
+    out.append(reinterpret_cast<const char*>(&value), sizeof(T));
+}
+
+void AppendString16(std::string& out, std::string_view text) {
+    const auto length = static_cast<std::uint16_t>(text.size() < 0xFFFF ? text.size() : 0xFFFF);
+    AppendRaw(out, length);
+    out.append(text.data(), length);
+}
+
+std::int64_t UnixNanoseconds() {
+    using namespace std::chrono;
+    return duration_cast<nanoseconds>(system_clock::now().time_since_epoch()).count();
+}
+
+void AppendSync(std::string& out) {
+    AppendRaw(out, binlog::BinaryRecord::Sync);
+    AppendRaw(out, binlog::ReadTsc());
+    AppendRaw(out, UnixNanoseconds());
+}
+
+} // namespace
+
 Logger& Logger::Instance() noexcept {
     static Logger instance;
     return instance;
 }
 
 Logger::~Logger() {
+    // Waits for producers still inside the ring before it is freed below
+    DisableAsync();
     CloseLogFile();
+    if (m_binaryStream.is_open()) {
+        m_binaryStream.close();
+    }
+    delete m_async;
+}
+
+bool Logger::EnableAsync(const AsyncLogConfig& config) {
+    if (m_asyncEnabled.load(std::memory_order_acquire)) return true;
+
+    if (!m_async) {
+        auto* state = new AsyncState();
+        std::size_t capacity = 2;
+        while (capacity < config.capacity) capacity <<= 1;
+        state->slots = std::make_unique<detail::LogSlot[]>(capacity);
+        for (std::size_t i = 0; i < capacity; ++i) {
+            state->slots[i].sequence.store(i, std::memory_order_relaxed);
+        }
+        state->capacity = capacity;
+        state->mask = capacity - 1;
+        state->consoleBatch.reserve(capacity * 64);
+        state->fileBatch.reserve(capacity * 64);
+        m_async = state;
+    }
+    m_async->config = config;
+
+    m_async->running.store(true, std::memory_order_release);
+    try {
+        m_async->writer = std::thread(&Logger::WriterLoop, this);
+    } catch (...) {
+        m_async->running.store(false, std::memory_order_release);
+        return false;
+    }
+    m_asyncEnabled.store(true, std::memory_order_release);
+    return true;
+}
+
+void Logger::DisableAsync() {
+    if (!m_async || !m_asyncEnabled.exchange(false, std::memory_order_seq_cst)) return;
+
+    // Producers that saw the flag before the exchange are still filling slots:
+    // wait until they published, so the final drain sees every entry
+    while (m_asyncProducers.load(std::memory_order_acquire) != 0) {
+        std::this_thread::yield();
+    }
+    m_async->running.store(false, std::memory_order_release);
+    if (m_async->writer.joinable()) {
+        m_async->writer.join();
+    }
+}
+
+void Logger::Flush() {
+    if (m_asyncEnabled.load(std::memory_order_acquire)) {
+        // Wait until the writer has written everything claimed so far, then
+        // have it flush the streams
+        const std::size_t target = m_async->tail.load(std::memory_order_acquire);
+        while (m_async->consumed.load(std::memory_order_acquire) < target &&
+               m_async->running.load(std::memory_order_acquire)) {
+            std::this_thread::yield();
+        }
+        m_async->flushRequested.store(true, std::memory_order_release);
+        while (m_async->flushRequested.load(std::memory_order_acquire) &&
+               m_async->running.load(std::memory_order_acquire)) {
+            std::this_thread::yield();
+        }
+        return;
+    }
+
+    std::lock_guard lock(m_mutex);
+    std::cout.flush();
+    if (m_fileWriter.IsOpen()) {
+        (void)m_fileWriter.Flush();
+        CheckLogFile();
+    }
+}
+
+detail::LogSlot* Logger::ClaimSlot() noexcept {
+    AsyncState* state = m_async;
+    std::size_t pos = state->tail.load(std::memory_order_relaxed);
+    for (;;) {
+        detail::LogSlot& slot = state->slots[pos & state->mask];
+        const std::size_t sequence = slot.sequence.load(std::memory_order_acquire);
+        const auto diff = static_cast<std::ptrdiff_t>(sequence - pos);
+        if (diff == 0) {
+            if (state->tail.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                return &slot;
+            }
+        } else if (diff < 0) {
+            // The writer has not consumed this slot's previous lap: full
+            m_dropped.fetch_add(1, std::memory_order_relaxed);
+            return nullptr;
+        } else {
+            pos = state->tail.load(std::memory_order_relaxed);
+        }
+    }
+}
+
+void Logger::PublishSlot(detail::LogSlot* slot, LogLevel level, const std::source_location& loc) noexcept {
+    slot->site = nullptr;
+    slot->level = level;
+    slot->line = loc.line();
+    slot->file = loc.file_name();
+    slot->timestamp = std::chrono::system_clock::now().time_since_epoch().count();
+    // The claim left sequence == pos; pos + 1 marks it ready
+    slot->sequence.store(slot->sequence.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+}
+
+void Logger::PublishBinarySlot(detail::LogSlot* slot, const LogSite& site) noexcept {
+    slot->site = &site;
+    slot->level = site.level;
+    slot->timestamp = static_cast<std::int64_t>(binlog::ReadTsc());
+    slot->sequence.store(slot->sequence.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+}
+
+bool Logger::SetBinaryLogFile(std::string_view filepath) {
+    // Stop producing binary records before the stream changes
+    m_binaryEnabled.store(false, std::memory_order_release);
+    if (m_asyncEnabled.load(std::memory_order_acquire)) {
+        Flush();
+    }
+
+    std::lock_guard lock(m_mutex);
+    if (m_binaryStream.is_open()) {
+        m_binaryStream.close();
+    }
+    if (filepath.empty()) {
+        return true;
+    }
+
+    std::filesystem::path path(filepath);
+    m_binaryStream.open(path, std::ios::out | std::ios::binary | std::ios::trunc);
+    if (!m_binaryStream.is_open()) {
+        std::cerr << "[YU::LOG] Failed to open binary log file: " << filepath << '\n';
+        return false;
+    }
+
+    // Calibrate the TSC once; Sync records let the decoder correct drift later
+    if (m_tscPerSecond == 0.0) {
+        const auto wallStart = std::chrono::steady_clock::now();
+        const std::uint64_t tscStart = binlog::ReadTsc();
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+        const std::uint64_t tscEnd = binlog::ReadTsc();
+        const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - wallStart).count();
+        m_tscPerSecond = seconds > 0.0 ? static_cast<double>(tscEnd - tscStart) / seconds : 0.0;
+    }
+
+    binlog::BinaryLogHeader header{};
+    std::memcpy(header.magic, binlog::Magic, sizeof(header.magic));
+    header.version = binlog::Version;
+    header.tscPerSecond = m_tscPerSecond;
+    header.tscBase = binlog::ReadTsc();
+    header.unixNsBase = UnixNanoseconds();
+    m_binaryStream.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    m_binaryStream.flush();
+
+    m_binaryGeneration.fetch_add(1, std::memory_order_acq_rel);
+    m_binaryEnabled.store(true, std::memory_order_release);
+    return true;
+}
+
+std::size_t Logger::DrainRing(bool& flushNow) {
+    // Held for the whole batch: SetBinaryLogFile swaps m_binaryStream (and its
+    // generation) under the same mutex, so a batch never straddles two files
+    std::lock_guard lock(m_mutex);
+    AsyncState& state = *m_async;
+    state.consoleBatch.clear();
+    state.fileBatch.clear();
+    state.binaryBatch.clear();
+
+    // A new .bin file needs every site defined again
+    const std::uint32_t generation = m_binaryGeneration.load(std::memory_order_acquire);
+    if (generation != state.emittedGeneration) {
+        state.emittedSites.clear();
+        state.emittedGeneration = generation;
+    }
+
+    // At most one lap per batch, so the mutex is released (and consumed advances) under constant load
+    std::size_t count = 0;
+    for (std::size_t taken = 0; taken < state.capacity; ++taken) {
+        detail::LogSlot& slot = state.slots[state.head & state.mask];
+        if (slot.sequence.load(std::memory_order_acquire) != state.head + 1) break;  // Not published yet
+
+        if (const LogSite* site = slot.site) {
+            if (state.emittedSites.insert(site->id).second) {
+                AppendRaw(state.binaryBatch, binlog::BinaryRecord::Site);
+                AppendRaw(state.binaryBatch, site->id);
+                AppendRaw(state.binaryBatch, site->level);
+                AppendRaw(state.binaryBatch, static_cast<std::uint32_t>(site->location.line()));
+                AppendString16(state.binaryBatch, site->location.file_name());
+                AppendString16(state.binaryBatch, site->format);
+            }
+            AppendRaw(state.binaryBatch, binlog::BinaryRecord::Entry);
+            AppendRaw(state.binaryBatch, site->id);
+            AppendRaw(state.binaryBatch, static_cast<std::uint64_t>(slot.timestamp));
+            AppendRaw(state.binaryBatch, static_cast<std::uint8_t>(slot.truncated ? binlog::EntryTruncated : 0));
+            AppendRaw(state.binaryBatch, slot.length);
+            state.binaryBatch.append(slot.text, slot.length);
+
+            if (state.config.flushPolicy == LogFlushPolicy::Interval && slot.level >= state.config.flushLevel) {
+                flushNow = true;
+            }
+            slot.sequence.store(state.head + state.capacity, std::memory_order_release);
+            ++state.head;
+            ++count;
+            continue;
+        }
+
+        std::string_view message(slot.text, slot.length);
+        const auto time = std::chrono::system_clock::time_point(
+            std::chrono::system_clock::duration(slot.timestamp));
+        std::string entry = FormatLogEntry(slot.level, message, time,
+                                           slot.file ? slot.file : "", slot.line);
+        if (slot.truncated) entry += " [...]";
+
+        if (m_consoleOutput) {
+            if (m_colorOutput) {
+                switch (slot.level) {
+                    case LogLevel::Debug:   state.consoleBatch += "\033[36m"; break;
+                    case LogLevel::Info:    state.consoleBatch += "\033[32m"; break;
+                    case LogLevel::Warning: state.consoleBatch += "\033[33m"; break;
+                    case LogLevel::Error:   state.consoleBatch += "\033[31m"; break;
+                    default:                state.consoleBatch += "\033[0m";  break;
+                }
+                state.consoleBatch += entry;
+                state.consoleBatch += "\033[0m\n";
+            } else {
+                state.consoleBatch += entry;
+                state.consoleBatch += '\n';
+            }
+        }
+        state.fileBatch += entry;
+        state.fileBatch += '\n';
+
+        if (state.config.flushPolicy == LogFlushPolicy::Interval && slot.level >= state.config.flushLevel) {
+            flushNow = true;
+        }
+
+        // Hand the slot back for the next lap
+        slot.sequence.store(state.head + state.capacity, std::memory_order_release);
+        ++state.head;
+        ++count;
+    }
+
+    // Report drops once per batch, from the writer side
+    const std::size_t dropped = m_dropped.load(std::memory_order_relaxed);
+    if (dropped != state.reportedDrops) {
+        std::string entry = FormatLogEntry(LogLevel::Warning,
+            std::format("[YU::LOG] {} entries dropped (ring full)", dropped - state.reportedDrops),
+            std::chrono::system_clock::now(), "log.cpp", 0);
+        state.consoleBatch += entry;
+        state.consoleBatch += '\n';
+        state.fileBatch += entry;
+        state.fileBatch += '\n';
+        state.reportedDrops = dropped;
+        ++count;
+    }
+
+    // Periodic TSC/wall-clock pairs for the decoder
+    if (m_binaryStream.is_open() && std::chrono::steady_clock::now() - state.lastSync >= std::chrono::seconds(1)) {
+        AppendSync(state.binaryBatch);
+        state.lastSync = std::chrono::steady_clock::now();
+    }
+
+    if (count > 0 || !state.binaryBatch.empty()) {
+        if (m_consoleOutput && !state.consoleBatch.empty()) {
+            std::cout.write(state.consoleBatch.data(), static_cast<std::streamsize>(state.consoleBatch.size()));
+        }
+        if (m_fileWriter.IsOpen() && !state.fileBatch.empty()) {
+            m_fileWriter.Write(state.fileBatch);
+            CheckLogFile();
+        }
+        if (m_binaryStream.is_open() && !state.binaryBatch.empty()) {
+            m_binaryStream.write(state.binaryBatch.data(), static_cast<std::streamsize>(state.binaryBatch.size()));
+        }
+    }
+    state.consumed.store(state.head, std::memory_order_release);
+    return count;
+}
+
+void Logger::WriterLoop() {
+    AsyncState& state = *m_async;
+    auto lastFlush = std::chrono::steady_clock::now();
+    bool dirty = false;
+
+    auto flush = [&] {
+        std::lock_guard lock(m_mutex);
+        std::cout.flush();
+        if (m_fileWriter.IsOpen()) {
+            (void)m_fileWriter.Flush();
+            CheckLogFile();
+        }
+        if (m_binaryStream.is_open()) {
+            m_binaryStream.flush();
+        }
+        lastFlush = std::chrono::steady_clock::now();
+        dirty = false;
+    };
+
+    for (;;) {
+        const bool running = state.running.load(std::memory_order_acquire);
+
+        bool flushNow = false;
+        const std::size_t written = DrainRing(flushNow);
+        dirty = dirty || written > 0;
+
+        const bool flushRequested = state.flushRequested.load(std::memory_order_acquire);
+        if (dirty) {
+            switch (state.config.flushPolicy) {
+                case LogFlushPolicy::EveryBatch:
+                    flushNow = true;
+                    break;
+                case LogFlushPolicy::Interval:
+                    if (std::chrono::steady_clock::now() - lastFlush >=
+                            std::chrono::milliseconds(state.config.flushIntervalMs)) {
+                        flushNow = true;
+                    }
+                    break;
+                case LogFlushPolicy::Manual:
+                    break;
+            }
+        }
+        if (flushNow || flushRequested || !running) {
+            if (dirty) flush();
+            if (flushRequested) state.flushRequested.store(false, std::memory_order_release);
+        }
+
+        // Stop only after a final drain that saw the stop request
+        if (!running) break;
+        if (written == 0) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(state.config.idleSleepMs));
+        }
+    }
 }
 
 bool Logger::SetLogFile(std::string_view filepath) {
     std::lock_guard lock(m_mutex);
     
     // Close existing file if open
-    if (m_fileStream.is_open()) {
-        m_fileStream.close();
-    }
+    (void)m_fileWriter.Close();
     
     if (filepath.empty()) {
         return true; // Empty path means disable file logging
@@ -50,27 +446,53 @@ bool Logger::SetLogFile(std::string_view filepath) {
         }
     }
     
-    m_fileStream.open(path, std::ios::out | std::ios::app);
-    if (!m_fileStream.is_open()) {
+    m_logPath = path;
+    m_logReopened = false;
+    if (!OpenLogFile()) {
         std::cerr << "[YU::LOG] Failed to open log file: " << filepath << '\n';
+        m_logPath.clear();
         return false;
     }
     
     return true;
 }
 
+bool Logger::OpenLogFile() {
+    io::StreamWriterConfig config;
+    config.bufferSize = 64 * 1024;
+    // path::c_str() is wide on Windows: the name never goes through the ANSI code page
+    return m_fileWriter.Open(m_logPath.c_str(), io::StreamMode::Append, config).has_value();
+}
+
+void Logger::CheckLogFile() {
+    const io::IOError error = m_fileWriter.GetError();
+    if (error == io::IOError::None) return;
+
+    // The writer's error is sticky: report it instead of dropping every later entry silently,
+    // and reopen the file once (a second failure ends file logging)
+    (void)m_fileWriter.Close();
+    std::cerr << "[YU::LOG] Log file write failed: " << io::IOErrorToString(error) << '\n';
+    if (!m_logReopened && OpenLogFile()) {
+        m_logReopened = true;
+        return;
+    }
+    std::cerr << "[YU::LOG] File logging stopped\n";
+    m_logPath.clear();
+}
+
 void Logger::CloseLogFile() {
     std::lock_guard lock(m_mutex);
-    if (m_fileStream.is_open()) {
-        m_fileStream.flush();
-        m_fileStream.close();
-    }
+    (void)m_fileWriter.Close();
+    m_logPath.clear();
 }
 
 std::string Logger::FormatTimestamp() const {
+    return FormatTimestamp(std::chrono::system_clock::now());
+}
+
+std::string Logger::FormatTimestamp(std::chrono::system_clock::time_point now) {
     using namespace std::chrono;
     
-    auto now = system_clock::now();
     auto time = system_clock::to_time_t(now);
     auto ms = duration_cast<milliseconds>(now.time_since_epoch()) % 1000;
     
@@ -89,27 +511,48 @@ std::string Logger::FormatTimestamp() const {
 
 std::string Logger::FormatLogEntry(LogLevel level, std::string_view message,
                                     const std::source_location& loc) const {
+    return FormatLogEntry(level, message, std::chrono::system_clock::now(), loc.file_name(), loc.line());
+}
+
+std::string Logger::FormatLogEntry(LogLevel level, std::string_view message,
+                                   std::chrono::system_clock::time_point time,
+                                   std::string_view file, std::uint32_t line) {
     // Extract just the filename from the full path
-    std::string_view filename = loc.file_name();
+    std::string_view filename = file;
     if (auto pos = filename.find_last_of("/\\"); pos != std::string_view::npos) {
         filename = filename.substr(pos + 1);
     }
     
     return std::format("[{}] [{}] [{}:{}] {}",
-                       FormatTimestamp(),
+                       FormatTimestamp(time),
                        LogLevelToString(level),
                        filename,
-                       loc.line(),
+                       line,
                        message);
 }
 
 void Logger::Log(LogLevel level, std::string_view message, const std::source_location& loc) {
     if (level < m_minLevel) return;
     
+    if (AsyncProducer producer(*this); producer) {
+        detail::LogSlot* slot = ClaimSlot();
+        if (!slot) return;  // Ring full: dropped
+        const std::size_t length = message.size() < detail::LogSlot::TextCapacity
+                                       ? message.size() : detail::LogSlot::TextCapacity;
+        std::memcpy(slot->text, message.data(), length);
+        slot->length = static_cast<std::uint16_t>(length);
+        slot->truncated = length < message.size();
+        PublishSlot(slot, level, loc);
+        return;
+    }
+    
     std::string entry = FormatLogEntry(level, message, loc);
     
     std::lock_guard lock(m_mutex);
-    
+    WriteEntry(level, entry);
+}
+
+void Logger::WriteEntry(LogLevel level, std::string_view entry) {
     // Console output with optional colors (ANSI escape codes)
     if (m_consoleOutput) {
         if (m_colorOutput) {
@@ -128,9 +571,10 @@ void Logger::Log(LogLevel level, std::string_view message, const std::source_loc
     }
     
     // File output
-    if (m_fileStream.is_open()) {
-        m_fileStream << entry << '\n';
-        m_fileStream.flush(); // Ensure immediate write for debugging
+    if (m_fileWriter.IsOpen()) {
+        m_fileWriter.WriteLine(entry);
+        (void)m_fileWriter.Flush(); // Ensure immediate write for debugging (one syscall per entry)
+        CheckLogFile();
     }
 }
 
@@ -0,0 +1,252 @@
+/**
+ * @file log_decode.cpp
+ * @brief Implementation of the binary log decoder
+ */
+
+#include "yu/log_decode.h"
+#include "yu/log.h"
+
+#include <cstring>
+#include <ctime>
+#include <unordered_map>
+#include <variant>
+#include <vector>
+
+namespace yu {
+namespace binlog {
+
+namespace {
+
+struct Site {
+    LogLevel      level{LogLevel::Info};
+    std::uint32_t line{0};
+    std::string   file;
+    std::string   format;
+};
+
+using Arg = std::variant<std::int64_t, std::uint64_t, double, std::string, const void*, char, bool>;
+
+/// Sequential reader over a byte range
+class Reader {
+public:
+    explicit Reader(std::string_view data) noexcept : m_data(data) {}
+
+    template <typename T>
+    bool Read(T& value) {
+        if (m_pos + sizeof(T) > m_data.size()) return false;
+        std::memcpy(&value, m_data.data() + m_pos, sizeof(T));
+        m_pos += sizeof(T);
+        return true;
+    }
+
+    bool ReadBytes(std::string& out, std::size_t length) {
+        if (m_pos + length > m_data.size()) return false;
+        out.assign(m_data.data() + m_pos, length);
+        m_pos += length;
+        return true;
+    }
+
+    bool ReadString16(std::string& out) {
+        std::uint16_t length = 0;
+        return Read(length) && ReadBytes(out, length);
+    }
+
+private:
+    std::string_view m_data;
+    std::size_t      m_pos{0};
+};
+
+std::vector<Arg> DecodeArgs(std::string_view payload) {
+    std::vector<Arg> args;
+    Reader reader(payload);
+    std::uint8_t tag = 0;
+    while (reader.Read(tag)) {
+        switch (static_cast<LogArgType>(tag)) {
+            case LogArgType::Int:     { std::int64_t v;  if (!reader.Read(v)) return args; args.emplace_back(v); break; }
+            case LogArgType::UInt:    { std::uint64_t v; if (!reader.Read(v)) return args; args.emplace_back(v); break; }
+            case LogArgType::Float:   { double v;        if (!reader.Read(v)) return args; args.emplace_back(v); break; }
+            case LogArgType::Pointer: {
+                std::uint64_t v;
+                if (!reader.Read(v)) return args;
+                args.emplace_back(reinterpret_cast<const void*>(static_cast<std::uintptr_t>(v)));
+                break;
+            }
+            case LogArgType::Char:    { char v;          if (!reader.Read(v)) return args; args.emplace_back(v); break; }
+            case LogArgType::Bool:    { std::uint8_t v;  if (!reader.Read(v)) return args; args.emplace_back(v != 0); break; }
+            case LogArgType::String:  { std::string v;   if (!reader.ReadString16(v)) return args; args.emplace_back(std::move(v)); break; }
+            default: return args;  // Unknown tag: stop rather than misread the rest
+        }
+    }
+    return args;
+}
+
+/// Format one argument with the spec of its replacement field
+std::string FormatArg(const Arg& arg, std::string_view spec) {
+    std::string field = "{";
+    if (!spec.empty()) {
+        field += ':';
+        field += spec;
+    }
+    field += '}';
+    try {
+        return std::visit([&](const auto& value) {
+            return std::vformat(field, std::make_format_args(value));
+        }, arg);
+    } catch (const std::format_error&) {
+        // e.g. a spec that no longer fits the widened type
+        return std::visit([](const auto& value) { return std::vformat("{}", std::make_format_args(value)); }, arg);
+    }
+}
+
+/// Re-run the site's format string over the decoded arguments
+std::string FormatMessage(std::string_view format, const std::vector<Arg>& args) {
+    std::string out;
+    std::size_t nextIndex = 0;
+    for (std::size_t i = 0; i < format.size(); ++i) {
+        const char c = format[i];
+        if (c == '}' && i + 1 < format.size() && format[i + 1] == '}') {
+            out += '}';
+            ++i;
+            continue;
+        }
+        if (c != '{') {
+            out += c;
+            continue;
+        }
+        if (i + 1 < format.size() && format[i + 1] == '{') {
+            out += '{';
+            ++i;
+            continue;
+        }
+
+        const std::size_t close = format.find('}', i);
+        if (close == std::string_view::npos) {
+            out += format.substr(i);
+            break;
+        }
+        std::string_view field = format.substr(i + 1, close - i - 1);
+        std::string_view spec;
+        if (auto colon = field.find(':'); colon != std::string_view::npos) {
+            spec = field.substr(colon + 1);
+            field = field.substr(0, colon);
+        }
+
+        std::size_t index = nextIndex++;
+        if (!field.empty()) {
+            index = 0;
+            for (char d : field) index = index * 10 + static_cast<std::size_t>(d - '0');
+        }
+        out += index < args.size() ? FormatArg(args[index], spec) : std::string("{?}");
+        i = close;
+    }
+    return out;
+}
+
+std::string FormatTime(std::int64_t unixNs) {
+    const std::time_t seconds = static_cast<std::time_t>(unixNs / 1000000000);
+    const int ms = static_cast<int>((unixNs / 1000000) % 1000);
+    std::tm tm_buf{};
+#ifdef _WIN32
+    localtime_s(&tm_buf, &seconds);
+#else
+    localtime_r(&seconds, &tm_buf);
+#endif
+    return std::format("{:04d}-{:02d}-{:02d} {:02d}:{:02d}:{:02d}.{:03d}",
+                       tm_buf.tm_year + 1900, tm_buf.tm_mon + 1, tm_buf.tm_mday,
+                       tm_buf.tm_hour, tm_buf.tm_min, tm_buf.tm_sec, ms);
+}
+
+std::string_view FileName(std::string_view path) {
+    if (auto pos = path.find_last_of("/\\"); pos != std::string_view::npos) {
+        return path.substr(pos + 1);
+    }
+    return path;
+}
+
+} // namespace
+
+std::string FormatPayload(std::string_view format, std::string_view payload) {
+    return FormatMessage(format, DecodeArgs(payload));
+}
+
+DecodeResult DecodeLog(std::string_view data, std::ostream& out) {
+    DecodeResult result;
+    Reader reader(data);
+
+    BinaryLogHeader header{};
+    if (!reader.Read(header) || std::memcmp(header.magic, Magic, sizeof(Magic)) != 0) {
+        result.error = "not a yu binary log";
+        return result;
+    }
+    if (header.version != Version) {
+        result.error = std::format("unsupported binary log version {}", header.version);
+        return result;
+    }
+
+    // TSC -> wall clock from the most recent reference pair
+    std::uint64_t refTsc = header.tscBase;
+    std::int64_t refNs = header.unixNsBase;
+    const double nsPerTick = header.tscPerSecond > 0.0 ? 1e9 / header.tscPerSecond : 0.0;
+
+    std::unordered_map<std::uint32_t, Site> sites;
+    std::uint8_t type = 0;
+    while (reader.Read(type)) {
+        switch (static_cast<BinaryRecord>(type)) {
+            case BinaryRecord::Site: {
+                std::uint32_t id = 0;
+                Site site;
+                if (!reader.Read(id) || !reader.Read(site.level) || !reader.Read(site.line) ||
+                    !reader.ReadString16(site.file) || !reader.ReadString16(site.format)) {
+                    result.error = "truncated site record";
+                    return result;
+                }
+                sites[id] = std::move(site);
+                break;
+            }
+            case BinaryRecord::Sync: {
+                if (!reader.Read(refTsc) || !reader.Read(refNs)) {
+                    result.error = "truncated sync record";
+                    return result;
+                }
+                break;
+            }
+            case BinaryRecord::Entry: {
+                std::uint32_t id = 0;
+                std::uint64_t tsc = 0;
+                std::uint8_t flags = 0;
+                std::uint16_t length = 0;
+                std::string payload;
+                if (!reader.Read(id) || !reader.Read(tsc) || !reader.Read(flags) ||
+                    !reader.Read(length) || !reader.ReadBytes(payload, length)) {
+                    result.error = "truncated entry record";
+                    return result;
+                }
+
+                const auto it = sites.find(id);
+                if (it == sites.end()) {
+                    ++result.unknownSites;
+                    continue;
+                }
+                const Site& site = it->second;
+                const auto delta = static_cast<double>(static_cast<std::int64_t>(tsc - refTsc));
+                const std::int64_t unixNs = refNs + static_cast<std::int64_t>(delta * nsPerTick);
+
+                out << '[' << FormatTime(unixNs) << "] ["
+                    << LogLevelToString(site.level) << "] ["
+                    << FileName(site.file) << ':' << site.line << "] "
+                    << FormatPayload(site.format, payload);
+                if (flags & EntryTruncated) out << " [...]";
+                out << '\n';
+                ++result.entries;
+                break;
+            }
+            default:
+                result.error = std::format("unknown record type {}, stopping", static_cast<int>(type));
+                return result;
+        }
+    }
+    return result;
+}
+
+} // namespace binlog
+} // namespace yu
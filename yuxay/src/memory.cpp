@@ -4,7 +4,7 @@
  * 
  * The new memory system is largely header-only:
  * - LightweightTracker: Fully header-only for lock-free operation
- * - DetailedTracker: Mostly header-only with mutex-based synchronization
+ * - DetailedTracker: Header-only, address-sharded spinlocks over a private heap
  * - MemoryTracker: Wrapper that uses LightweightTracker, header-only
  * 
  * This file exists for compatibility and any non-template implementations
@@ -15,7 +15,9 @@
 
 // All implementations are now in the headers:
 // - memory.h: Main API, MemoryTracker wrapper, allocation functions
-// - memory_lightweight.h: LightweightTracker, Spinlock, CompactRecord
+// - memory_lightweight.h: LightweightTracker, Spinlock
+// - memory_records.h: CompactRecord, RecordTable
+// - memory_stats.h: ExactStats/ShardedStats counter policies
 // - memory_detailed.h: DetailedTracker with full records
 
 // This file can be used for:
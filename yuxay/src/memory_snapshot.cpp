@@ -0,0 +1,339 @@
+/**
+ * @file memory_snapshot.cpp
+ * @brief Background memory snapshots (see memory_snapshot.h)
+ */
+
+#define NOMINMAX
+#include "yu/memory_snapshot.h"
+#include "yu/memory_os.h"
+
+#include <chrono>
+#include <cstring>
+#include <ctime>
+#include <new>
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#include <Windows.h>
+#else
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+namespace yu {
+namespace mem {
+
+namespace {
+
+/// Sleep step of the worker between checks for a request or the next period
+constexpr std::uint32_t PollMs = 50;
+
+std::uint64_t NowMs() noexcept {
+    return static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count());
+}
+
+std::tm LocalTime(std::int64_t unixSeconds) noexcept {
+    const std::time_t t = static_cast<std::time_t>(unixSeconds);
+    std::tm local{};
+#ifdef _WIN32
+    localtime_s(&local, &t);
+#else
+    localtime_r(&t, &local);
+#endif
+    return local;
+}
+
+/// Appends to a fixed buffer, truncating at its end (no allocation)
+class TextWriter {
+public:
+    TextWriter(char* buffer, std::size_t capacity) noexcept : m_buffer(buffer), m_capacity(capacity) {}
+
+    void Append(const char* str) noexcept {
+        while (*str && m_length + 1 < m_capacity) {
+            m_buffer[m_length++] = *str++;
+        }
+    }
+
+    /// Left-aligned in a field of width characters
+    void Field(const char* str, std::size_t width) noexcept {
+        const std::size_t before = m_length;
+        Append(str);
+        Spaces(width > m_length - before ? width - (m_length - before) : 0);
+    }
+
+    /// Decimal, right-aligned in a field of width characters (zero-padded if zeroPad)
+    void Number(std::uint64_t value, std::size_t width = 0, bool zeroPad = false) noexcept {
+        char digits[24];
+        std::size_t count = 0;
+        do {
+            digits[count++] = static_cast<char>('0' + value % 10);
+            value /= 10;
+        } while (value > 0);
+        for (std::size_t i = count; i < width; ++i) {
+            Put(zeroPad ? '0' : ' ');
+        }
+        while (count > 0) {
+            Put(digits[--count]);
+        }
+    }
+
+    void Spaces(std::size_t count) noexcept {
+        while (count-- > 0) Put(' ');
+    }
+
+    void Put(char c) noexcept {
+        if (m_length + 1 < m_capacity) m_buffer[m_length++] = c;
+    }
+
+    std::size_t Finish() noexcept {
+        m_buffer[m_length] = '\0';
+        return m_length;
+    }
+
+private:
+    char*       m_buffer;
+    std::size_t m_capacity;
+    std::size_t m_length = 0;
+};
+
+/// Create or truncate path and write size bytes in one call
+bool WriteWholeFile(const char* path, const char* data, std::size_t size) noexcept {
+#ifdef _WIN32
+    HANDLE file = CreateFileA(path, GENERIC_WRITE, 0, nullptr, CREATE_ALWAYS, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file == INVALID_HANDLE_VALUE) return false;
+    DWORD written = 0;
+    const BOOL ok = WriteFile(file, data, static_cast<DWORD>(size), &written, nullptr);
+    CloseHandle(file);
+    return ok && written == size;
+#else
+    const int fd = open(path, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if (fd < 0) return false;
+    const ssize_t written = write(fd, data, size);
+    close(fd);
+    return written == static_cast<ssize_t>(size);
+#endif
+}
+
+} // namespace
+
+// ============================================================================
+// MemorySnapshotter
+// ============================================================================
+
+MemorySnapshotter& MemorySnapshotter::Instance() noexcept {
+    static MemorySnapshotter instance;
+    return instance;
+}
+
+MemorySnapshotter::~MemorySnapshotter() noexcept {
+    Stop();
+    os::FreePages(m_snapshot, sizeof(MemorySnapshot));
+    os::FreePages(m_text, TextCapacity);
+}
+
+bool MemorySnapshotter::Start(const char* prefix, std::uint32_t intervalMs) noexcept {
+    if (m_running.load(std::memory_order_acquire)) return true;
+    if (!EnsureBuffers()) return false;
+
+    TextWriter name(m_prefix, sizeof(m_prefix));
+    name.Append(prefix && *prefix ? prefix : "memory_snapshot");
+    name.Finish();
+    m_intervalMs = intervalMs;
+    m_startMs = NowMs();
+
+    m_running.store(true, std::memory_order_release);
+    try {
+        m_worker = std::thread(&MemorySnapshotter::WorkerLoop, this);
+    } catch (...) {
+        m_running.store(false, std::memory_order_release);
+        return false;
+    }
+    return true;
+}
+
+void MemorySnapshotter::Stop() noexcept {
+    m_running.store(false, std::memory_order_release);
+    if (m_worker.joinable()) {
+        m_worker.join();
+    }
+}
+
+bool MemorySnapshotter::WriteSnapshot(const char* path) noexcept {
+    if (!path || !EnsureBuffers()) return false;
+    if (m_startMs == 0) m_startMs = NowMs();
+    return TakeAndWrite(path);
+}
+
+bool MemorySnapshotter::EnsureBuffers() noexcept {
+    if (!m_snapshot) {
+        void* pages = os::AllocatePages(sizeof(MemorySnapshot));
+        if (!pages) return false;
+        m_snapshot = new (pages) MemorySnapshot();
+    }
+    if (!m_text) {
+        m_text = static_cast<char*>(os::AllocatePages(TextCapacity));
+        if (!m_text) return false;
+    }
+    return true;
+}
+
+bool MemorySnapshotter::TakeAndWrite(const char* path) noexcept {
+    MemorySnapshot& snapshot = *m_snapshot;
+    snapshot.sequence = m_sequence.load(std::memory_order_relaxed);
+    snapshot.uptimeMs = NowMs() - m_startMs;
+    Capture(snapshot);
+
+    const std::size_t length = Format(snapshot, m_text, TextCapacity);
+    if (!WriteWholeFile(path, m_text, length)) return false;
+
+    TextWriter last(m_lastPath, sizeof(m_lastPath));
+    last.Append(path);
+    last.Finish();
+    m_sequence.fetch_add(1, std::memory_order_relaxed);
+    return true;
+}
+
+void MemorySnapshotter::WorkerLoop() noexcept {
+    std::uint64_t nextPeriodic = m_intervalMs ? NowMs() + m_intervalMs : 0;
+
+    while (m_running.load(std::memory_order_acquire)) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(PollMs));
+
+        const std::uint64_t now = NowMs();
+        const bool periodic = nextPeriodic != 0 && now >= nextPeriodic;
+        if (!m_requested.exchange(false, std::memory_order_acq_rel) && !periodic) continue;
+        if (periodic) nextPeriodic = now + m_intervalMs;
+
+        // <prefix>_<YYYYMMDD-HHMMSS>_<sequence>.txt
+        const std::tm local = LocalTime(static_cast<std::int64_t>(std::time(nullptr)));
+        char path[sizeof(m_prefix) + 32];
+        TextWriter name(path, sizeof(path));
+        name.Append(m_prefix);
+        name.Put('_');
+        name.Number(static_cast<std::uint64_t>(local.tm_year + 1900), 4, true);
+        name.Number(static_cast<std::uint64_t>(local.tm_mon + 1), 2, true);
+        name.Number(static_cast<std::uint64_t>(local.tm_mday), 2, true);
+        name.Put('-');
+        name.Number(static_cast<std::uint64_t>(local.tm_hour), 2, true);
+        name.Number(static_cast<std::uint64_t>(local.tm_min), 2, true);
+        name.Number(static_cast<std::uint64_t>(local.tm_sec), 2, true);
+        name.Put('_');
+        name.Number(m_sequence.load(std::memory_order_relaxed), 4, true);
+        name.Append(".txt");
+        name.Finish();
+
+        TakeAndWrite(path);
+    }
+}
+
+void MemorySnapshotter::Capture(MemorySnapshot& out, std::size_t chunkSlots) noexcept {
+    const LightweightTracker& tracker = LightweightTracker::Instance();
+    const std::uint64_t start = NowMs();
+
+    for (auto& bucket : out.tags) bucket = MemorySnapshot::Bucket{};
+    for (auto& bucket : out.sizeClasses) bucket = MemorySnapshot::Bucket{};
+    out.records = 0;
+    out.chunks = 0;
+    out.unixSeconds = static_cast<std::int64_t>(std::time(nullptr));
+    out.sampleInterval = tracker.GetSampleInterval();
+
+    // One bounded step at a time, giving the CPU back in between
+    LightweightTracker::ScanCursor cursor;
+    bool more = true;
+    while (more) {
+        more = tracker.ScanAllocations(cursor, chunkSlots ? chunkSlots : DefaultChunkSlots,
+            [&](void*, const CompactRecord& record) {
+                const SampleWeight weight = GetSampleWeight(record.size, record.sampleShift);
+                const std::size_t tag = record.tag < MemorySnapshot::MaxTags ? record.tag : MemorySnapshot::MaxTags - 1;
+                out.tags[tag].bytes += weight.bytes;
+                out.tags[tag].count += weight.count;
+                auto& sizeClass = out.sizeClasses[SizeClassOf(record.size)];
+                sizeClass.bytes += weight.bytes;
+                sizeClass.count += weight.count;
+                ++out.records;
+            });
+        ++out.chunks;
+        if (more) std::this_thread::yield();
+    }
+
+    out.totalBytes = tracker.GetTotalBytes();
+    out.peakBytes = tracker.GetPeakBytes();
+    out.activeCount = tracker.GetActiveCount();
+    out.dropped = tracker.GetDroppedCount();
+    out.scanMs = NowMs() - start;
+}
+
+std::size_t MemorySnapshotter::Format(const MemorySnapshot& snapshot, char* buffer, std::size_t bufferSize) noexcept {
+    if (!buffer || bufferSize == 0) return 0;
+    const LightweightTracker& tracker = LightweightTracker::Instance();
+    TextWriter out(buffer, bufferSize);
+
+    const std::tm local = LocalTime(snapshot.unixSeconds);
+    out.Append("=== YU Memory Snapshot ===\n");
+    out.Append("Sequence: "); out.Number(snapshot.sequence); out.Put('\n');
+    out.Append("Time: ");
+    out.Number(static_cast<std::uint64_t>(local.tm_year + 1900), 4, true); out.Put('-');
+    out.Number(static_cast<std::uint64_t>(local.tm_mon + 1), 2, true); out.Put('-');
+    out.Number(static_cast<std::uint64_t>(local.tm_mday), 2, true); out.Put(' ');
+    out.Number(static_cast<std::uint64_t>(local.tm_hour), 2, true); out.Put(':');
+    out.Number(static_cast<std::uint64_t>(local.tm_min), 2, true); out.Put(':');
+    out.Number(static_cast<std::uint64_t>(local.tm_sec), 2, true); out.Put('\n');
+    out.Append("Uptime: "); out.Number(snapshot.uptimeMs); out.Append(" ms\n");
+    if (snapshot.sampleInterval) {
+        out.Append("Mode: Sampled, 1 per "); out.Number(snapshot.sampleInterval);
+        out.Append(" bytes (histograms are estimates)\n");
+    } else {
+        out.Append("Mode: Exact\n");
+    }
+    out.Append("Total: "); out.Number(snapshot.totalBytes); out.Append(" bytes\n");
+    out.Append("Peak: "); out.Number(snapshot.peakBytes); out.Append(" bytes\n");
+    out.Append("Active: "); out.Number(snapshot.activeCount); out.Append(" allocations\n");
+    out.Append("Dropped: "); out.Number(snapshot.dropped); out.Append(" (table full)\n");
+    out.Append("Walk: "); out.Number(snapshot.records); out.Append(" records, ");
+    out.Number(snapshot.chunks); out.Append(" chunks, ");
+    out.Number(snapshot.scanMs); out.Append(" ms\n");
+
+    // One row per line with a fixed layout, so snapshots diff cleanly
+    out.Append("\n--- Tags (live records) ---\n");
+    out.Append("  Tag  Name                                 Bytes        Count\n");
+    for (std::size_t tag = 0; tag < MemorySnapshot::MaxTags; ++tag) {
+        const MemorySnapshot::Bucket& bucket = snapshot.tags[tag];
+        if (bucket.count == 0) continue;
+        out.Number(tag, 5);
+        out.Spaces(2);
+        if (tag == MemorySnapshot::MaxTags - 1) {
+            out.Field("(this and higher tags)", 24);
+        } else {
+            out.Field(tracker.GetTagName(static_cast<LightweightTracker::TagId>(tag)), 24);
+        }
+        out.Number(bucket.bytes, 18);
+        out.Number(bucket.count, 13);
+        out.Put('\n');
+    }
+
+    out.Append("\n--- Size Classes (live records) ---\n");
+    out.Append("                 Size                Bytes        Count\n");
+    for (std::size_t cls = 0; cls < MemorySnapshot::SizeClasses; ++cls) {
+        const MemorySnapshot::Bucket& bucket = snapshot.sizeClasses[cls];
+        if (bucket.count == 0) continue;
+        const std::uint64_t low = cls == 0 ? 0 : std::uint64_t{1} << cls;
+        const std::uint64_t high = (std::uint64_t{1} << (cls + 1)) - 1;
+        char range[32];
+        TextWriter label(range, sizeof(range));
+        label.Number(low);
+        label.Put('-');
+        label.Number(high);
+        const std::size_t width = label.Finish();
+        out.Spaces(width < 21 ? 21 - width : 0);
+        out.Append(range);
+        out.Number(bucket.bytes, 21);
+        out.Number(bucket.count, 13);
+        out.Put('\n');
+    }
+
+    return out.Finish();
+}
+
+} // namespace mem
+} // namespace yu
@@ -0,0 +1,132 @@
+/**
+ * @file alloc_count.cpp
+ * @brief Counting operator new/delete and yu::mem allocator
+ */
+
+#include "yu/alloc_count.h"
+
+#include <yu/memory.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+namespace yu {
+namespace testing {
+
+namespace {
+
+std::atomic<std::uint64_t> g_count{0};
+std::atomic<std::uint64_t> g_bytes{0};
+
+// Constant-initialized, so operator new may use them before any dynamic initialization
+constinit thread_local std::uint64_t t_count = 0;
+constinit thread_local std::uint64_t t_bytes = 0;
+
+void Count(std::size_t size) noexcept {
+    g_count.fetch_add(1, std::memory_order_relaxed);
+    g_bytes.fetch_add(size, std::memory_order_relaxed);
+    ++t_count;
+    t_bytes += size;
+}
+
+void* CountingAlloc(std::size_t size) {
+    Count(size);
+    return std::malloc(size);
+}
+
+void* CountingRealloc(void* ptr, std::size_t size) {
+    Count(size);
+    return std::realloc(ptr, size);
+}
+
+void CountingFree(void* ptr) {
+    std::free(ptr);
+}
+
+} // anonymous namespace
+
+void InstallCountingAllocator() noexcept {
+    mem::SetAllocator(&CountingAlloc, &CountingRealloc, &CountingFree);
+}
+
+AllocationCount GlobalAllocations() noexcept {
+    return {g_count.load(std::memory_order_relaxed), g_bytes.load(std::memory_order_relaxed)};
+}
+
+AllocationCount ThreadAllocations() noexcept {
+    return {t_count, t_bytes};
+}
+
+} // namespace testing
+} // namespace yu
+
+// ============================================================================
+// Global operator new/delete
+// ============================================================================
+
+namespace {
+
+void* CountedNew(std::size_t size) {
+    yu::testing::Count(size);
+    if (void* ptr = std::malloc(size ? size : 1)) return ptr;
+    throw std::bad_alloc();
+}
+
+void* CountedAlignedNew(std::size_t size, std::size_t alignment) noexcept {
+    yu::testing::Count(size);
+#ifdef _MSC_VER
+    return _aligned_malloc(size ? size : 1, alignment);
+#else
+    return std::aligned_alloc(alignment, (std::max<std::size_t>(size, 1) + alignment - 1) / alignment * alignment);
+#endif
+}
+
+void AlignedDelete(void* ptr) noexcept {
+#ifdef _MSC_VER
+    _aligned_free(ptr);
+#else
+    std::free(ptr);
+#endif
+}
+
+} // anonymous namespace
+
+void* operator new(std::size_t size) { return CountedNew(size); }
+void* operator new[](std::size_t size) { return CountedNew(size); }
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept {
+    yu::testing::Count(size);
+    return std::malloc(size ? size : 1);
+}
+void* operator new[](std::size_t size, const std::nothrow_t&) noexcept {
+    yu::testing::Count(size);
+    return std::malloc(size ? size : 1);
+}
+void* operator new(std::size_t size, std::align_val_t alignment) {
+    if (void* ptr = CountedAlignedNew(size, static_cast<std::size_t>(alignment))) return ptr;
+    throw std::bad_alloc();
+}
+void* operator new[](std::size_t size, std::align_val_t alignment) {
+    if (void* ptr = CountedAlignedNew(size, static_cast<std::size_t>(alignment))) return ptr;
+    throw std::bad_alloc();
+}
+void* operator new(std::size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept {
+    return CountedAlignedNew(size, static_cast<std::size_t>(alignment));
+}
+void* operator new[](std::size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept {
+    return CountedAlignedNew(size, static_cast<std::size_t>(alignment));
+}
+
+void operator delete(void* ptr) noexcept { std::free(ptr); }
+void operator delete[](void* ptr) noexcept { std::free(ptr); }
+void operator delete(void* ptr, std::size_t) noexcept { std::free(ptr); }
+void operator delete[](void* ptr, std::size_t) noexcept { std::free(ptr); }
+void operator delete(void* ptr, const std::nothrow_t&) noexcept { std::free(ptr); }
+void operator delete[](void* ptr, const std::nothrow_t&) noexcept { std::free(ptr); }
+void operator delete(void* ptr, std::align_val_t) noexcept { AlignedDelete(ptr); }
+void operator delete[](void* ptr, std::align_val_t) noexcept { AlignedDelete(ptr); }
+void operator delete(void* ptr, std::size_t, std::align_val_t) noexcept { AlignedDelete(ptr); }
+void operator delete[](void* ptr, std::size_t, std::align_val_t) noexcept { AlignedDelete(ptr); }
+void operator delete(void* ptr, std::align_val_t, const std::nothrow_t&) noexcept { AlignedDelete(ptr); }
+void operator delete[](void* ptr, std::align_val_t, const std::nothrow_t&) noexcept { AlignedDelete(ptr); }
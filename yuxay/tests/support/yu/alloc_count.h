@@ -0,0 +1,50 @@
+/**
+ * @file alloc_count.h
+ * @brief Heap allocation counters for test and benchmark binaries
+ *
+ * Linking the yu.testing target replaces the global operator new/delete of
+ * the binary with counting versions, and InstallCountingAllocator() routes
+ * yu::mem allocations through a counting allocator (yu::mem::SetAllocator).
+ * Both feed the same counters, kept process-wide and per thread.
+ *
+ * Direct malloc calls are not seen: code that claims to stay off the heap
+ * does so through operator new or yu::mem.
+ */
+
+#pragma once
+
+#include <cstdint>
+
+namespace yu {
+namespace testing {
+
+/// Heap allocations (operator new, yu::mem::Allocate and Reallocate) counted so far
+struct AllocationCount {
+    std::uint64_t count{0};
+    std::uint64_t bytes{0};
+};
+
+/// Route yu::mem allocations through the counters
+/// Call first thing in main: yu::mem must not switch allocators while blocks are alive.
+void InstallCountingAllocator() noexcept;
+
+/// All threads since process start
+[[nodiscard]] AllocationCount GlobalAllocations() noexcept;
+
+/// The calling thread since it started
+[[nodiscard]] AllocationCount ThreadAllocations() noexcept;
+
+/// Allocations made by the calling thread during the scope's lifetime
+class AllocationScope {
+public:
+    AllocationScope() noexcept : m_start(ThreadAllocations()) {}
+
+    [[nodiscard]] std::uint64_t Count() const noexcept { return ThreadAllocations().count - m_start.count; }
+    [[nodiscard]] std::uint64_t Bytes() const noexcept { return ThreadAllocations().bytes - m_start.bytes; }
+
+private:
+    AllocationCount m_start;
+};
+
+} // namespace testing
+} // namespace yu
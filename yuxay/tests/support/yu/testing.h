@@ -0,0 +1,63 @@
+/**
+ * @file testing.h
+ * @brief boost-ut helpers for yu tests
+ *
+ * YU_EXPECT_NO_ALLOC runs the block that follows it and fails the current
+ * test if that block allocated on the calling thread:
+ *
+ * ```cpp
+ * yu::testing::InstallCountingAllocator();  // first in main
+ * ...
+ * it("should record without allocating") = [] {
+ *     YU_EXPECT_NO_ALLOC {
+ *         tracker.RecordAllocation(ptr, 64);
+ *     };
+ * };
+ * ```
+ *
+ * Only the calling thread is counted, so background threads (a log writer,
+ * workers) do not make the check flaky. Do not leave the block with break or
+ * return: the check runs when the block completes.
+ */
+
+#pragma once
+
+#include "yu/alloc_count.h"
+
+#include <boost/ut.hpp>
+
+namespace yu {
+namespace testing {
+namespace detail {
+
+/// Loop driver behind YU_EXPECT_NO_ALLOC: one pass, then the expectation
+class NoAllocationCheck {
+public:
+    explicit NoAllocationCheck(const boost::ut::reflection::source_location& location) noexcept
+        : m_location(location) {}
+
+    [[nodiscard]] bool Running() const noexcept { return !m_done; }
+
+    void Finish() {
+        m_done = true;
+        const std::uint64_t count = m_scope.Count();
+        const std::uint64_t bytes = m_scope.Bytes();
+        boost::ut::expect(count == 0, m_location)
+            << "expected no heap allocation, got " << count << " (" << bytes << " bytes)";
+    }
+
+private:
+    boost::ut::reflection::source_location m_location;
+    AllocationScope m_scope;
+    bool m_done = false;
+};
+
+} // namespace detail
+} // namespace testing
+} // namespace yu
+
+/// Fail the current test if the following block allocates on this thread
+#define YU_EXPECT_NO_ALLOC                                                                           \
+    for (::yu::testing::detail::NoAllocationCheck yuNoAllocationCheck_(                              \
+             ::boost::ut::reflection::source_location::current());                                   \
+         yuNoAllocationCheck_.Running(); yuNoAllocationCheck_.Finish())
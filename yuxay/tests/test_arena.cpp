@@ -0,0 +1,137 @@
+#include <boost/ut.hpp>
+#include <yu/memory_arena.h>
+#include <cstdint>
+
+namespace ut = boost::ut;
+
+namespace {
+
+// Block size of the arenas under test, header included
+constexpr std::size_t BlockSize = 4096;
+constexpr std::size_t Chunk = 1024;  // Three fit in a block, a fourth spills into the next
+
+bool AlignedTo(const void* ptr, std::size_t alignment) {
+    return reinterpret_cast<std::uintptr_t>(ptr) % alignment == 0;
+}
+
+} // anonymous namespace
+
+int main() {
+    using namespace ut;
+    using namespace ut::spec;
+
+    cfg<override> = {.tag = {"yu::mem arena"}};
+
+    describe("yu::mem::Arena marks") = [] {
+        it("should rewind across a block boundary and reuse the later block") = [] {
+            yu::mem::Arena arena(yu::mem::Tags::Temporary, BlockSize);
+            void* first = arena.Allocate(Chunk);
+            expect(first != nullptr);
+            const yu::mem::Arena::Mark mark = arena.GetMark();
+            const std::size_t usedAtMark = arena.Used();
+
+            void* inFirstBlock[2] = {arena.Allocate(Chunk), arena.Allocate(Chunk)};
+            void* spilled = arena.Allocate(Chunk);
+            expect(arena.Capacity() == 2 * BlockSize);
+            const std::size_t used = arena.Used();  // Alignment padding of each block included
+            expect(used >= usedAtMark + 3 * Chunk);
+            const std::size_t peak = arena.Peak();
+
+            arena.Rewind(mark);
+            expect(arena.Used() == usedAtMark);
+            expect(arena.Peak() == peak) << "a rewind keeps the peak";
+
+            // Same bump sequence, same addresses: nothing new from the OS
+            expect(arena.Allocate(Chunk) == inFirstBlock[0]);
+            expect(arena.Allocate(Chunk) == inFirstBlock[1]);
+            expect(arena.Allocate(Chunk) == spilled);
+            expect(arena.Capacity() == 2 * BlockSize);
+            expect(arena.Used() == used);
+        };
+
+        it("should rewind to a mark taken in a later block") = [] {
+            yu::mem::Arena arena(yu::mem::Tags::Temporary, BlockSize);
+            for (int i = 0; i < 4; ++i) (void)arena.Allocate(Chunk);  // Second block in use
+            const yu::mem::Arena::Mark mark = arena.GetMark();
+            const std::size_t usedAtMark = arena.Used();
+
+            for (int i = 0; i < 8; ++i) (void)arena.Allocate(Chunk);  // Into a third and fourth block
+            const std::size_t capacity = arena.Capacity();
+            const std::size_t used = arena.Used();
+            expect(capacity == 4 * BlockSize);
+
+            arena.Rewind(mark);
+            expect(arena.Used() == usedAtMark);
+            for (int i = 0; i < 8; ++i) (void)arena.Allocate(Chunk);
+            expect(arena.Capacity() == capacity);
+            expect(arena.Used() == used);
+        };
+
+        it("should rewind a mark of an empty arena to the start") = [] {
+            yu::mem::Arena arena(yu::mem::Tags::Temporary, BlockSize);
+            const yu::mem::Arena::Mark start = arena.GetMark();
+            void* first = arena.Allocate(Chunk);
+            for (int i = 0; i < 6; ++i) (void)arena.Allocate(Chunk);
+
+            arena.Rewind(start);
+            expect(arena.Used() == 0_u);
+            expect(arena.Allocate(Chunk) == first) << "the first block is reused";
+
+            arena.Reset();
+            expect(arena.Used() == 0_u);
+            expect(arena.Allocate(Chunk) == first);
+            expect(arena.Capacity() == 3 * BlockSize);
+        };
+
+        it("should give an oversized allocation a block that a rewind keeps") = [] {
+            yu::mem::Arena arena(yu::mem::Tags::Temporary, BlockSize);
+            (void)arena.Allocate(Chunk);
+            const yu::mem::Arena::Mark mark = arena.GetMark();
+            void* large = arena.Allocate(3 * BlockSize);
+            expect(large != nullptr);
+            const std::size_t capacity = arena.Capacity();
+            expect(capacity > 4 * BlockSize);
+
+            arena.Rewind(mark);
+            expect(arena.Allocate(3 * BlockSize) == large);
+            expect(arena.Capacity() == capacity);
+        };
+
+        it("should align after a rewind as before it") = [] {
+            yu::mem::Arena arena(yu::mem::Tags::Temporary, BlockSize);
+            (void)arena.Allocate(3);
+            const yu::mem::Arena::Mark mark = arena.GetMark();
+            void* aligned = arena.Allocate(8, 64);
+            expect(AlignedTo(aligned, 64));
+            arena.Rewind(mark);
+            (void)arena.Allocate(1);
+            void* again = arena.Allocate(8, 64);
+            expect(AlignedTo(again, 64));
+            expect(again == aligned);
+        };
+    };
+
+    describe("yu::mem::ArenaScope") = [] {
+        it("should restore the arena when nested scopes cross blocks") = [] {
+            yu::mem::Arena arena(yu::mem::Tags::Temporary, BlockSize);
+            (void)arena.Allocate(Chunk);
+            const std::size_t outer = arena.Used();
+            void* reused = nullptr;
+            {
+                yu::mem::ArenaScope scope(arena);
+                for (int i = 0; i < 3; ++i) (void)arena.Allocate(Chunk);
+                const std::size_t inner = arena.Used();
+                {
+                    yu::mem::ArenaScope nested(arena);
+                    reused = arena.Allocate(2 * Chunk);
+                    expect(arena.Used() == inner + 2 * Chunk);
+                }
+                expect(arena.Used() == inner);
+                expect(arena.Allocate(2 * Chunk) == reused);
+            }
+            expect(arena.Used() == outer);
+            expect(arena.Capacity() == 2 * BlockSize);
+            expect(arena.Peak() >= outer + 5 * Chunk);
+        };
+    };
+}
@@ -0,0 +1,232 @@
+#include <boost/ut.hpp>
+#include <yu/concurrent.h>
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <thread>
+#include <vector>
+
+namespace ut = boost::ut;
+
+namespace {
+
+/// Value whose fields must always agree: a torn read breaks the invariant
+struct Sample {
+    std::uint32_t version;
+    std::uint32_t payload[15];
+    std::uint32_t check;
+};
+
+Sample MakeSample(std::uint32_t version) {
+    Sample sample{};
+    sample.version = version;
+    for (std::uint32_t i = 0; i < 15; ++i) sample.payload[i] = version * 31 + i;
+    sample.check = ~version;
+    return sample;
+}
+
+bool Consistent(const Sample& sample) {
+    for (std::uint32_t i = 0; i < 15; ++i) {
+        if (sample.payload[i] != sample.version * 31 + i) return false;
+    }
+    return sample.check == ~sample.version;
+}
+
+} // anonymous namespace
+
+int main() {
+    using namespace ut;
+    using namespace ut::spec;
+
+    cfg<override> = {.tag = {"yu::concurrent"}};
+
+    describe("yu::concurrent::SpscRing") = [] {
+        it("should keep order and report full and empty") = [] {
+            yu::concurrent::SpscRing<int, 4> ring;
+            int value = 0;
+            expect(!ring.TryPop(value));
+            for (int i = 0; i < 4; ++i) expect(ring.TryPush(i));
+            expect(!ring.TryPush(99));
+            expect(ring.Size() == 4_u);
+            for (int i = 0; i < 4; ++i) {
+                expect(ring.TryPop(value));
+                expect(value == i);
+            }
+            expect(ring.Empty());
+        };
+
+        it("should move values through") = [] {
+            yu::concurrent::SpscRing<std::unique_ptr<int>, 8> ring;
+            expect(ring.TryPush(std::make_unique<int>(7)));
+            std::unique_ptr<int> out;
+            expect(ring.TryPop(out));
+            expect(out && *out == 7);
+        };
+
+        it("should deliver every value across two threads") = [] {
+            constexpr std::uint32_t count = 200000;
+            auto ring = std::make_unique<yu::concurrent::SpscRing<std::uint32_t, 256>>();
+            std::thread producer([&] {
+                for (std::uint32_t i = 0; i < count;) {
+                    if (ring->TryPush(i)) ++i;
+                    else yu::concurrent::CpuRelax();
+                }
+            });
+
+            bool ordered = true;
+            std::uint32_t expected = 0;
+            while (expected < count) {
+                std::uint32_t value;
+                if (!ring->TryPop(value)) continue;
+                ordered = ordered && value == expected;
+                ++expected;
+            }
+            producer.join();
+            expect(ordered);
+            expect(ring->Empty());
+        };
+    };
+
+    describe("yu::concurrent::MpscQueue") = [] {
+        it("should keep order and report full and empty") = [] {
+            yu::concurrent::MpscQueue<int, 4> queue;
+            int value = 0;
+            expect(!queue.TryPop(value));
+            for (int i = 0; i < 4; ++i) expect(queue.TryPush(i));
+            expect(!queue.TryPush(99));
+            for (int i = 0; i < 4; ++i) {
+                expect(queue.TryPop(value));
+                expect(value == i);
+            }
+            expect(queue.Empty());
+
+            // Wraps around
+            for (int lap = 0; lap < 10; ++lap) {
+                expect(queue.TryPush(lap));
+                expect(queue.TryPop(value) && value == lap);
+            }
+        };
+
+        it("should deliver every value from several producers in per-producer order") = [] {
+            constexpr std::uint32_t producers = 4;
+            constexpr std::uint32_t perProducer = 50000;
+            auto queue = std::make_unique<yu::concurrent::MpscQueue<std::uint32_t, 128>>();
+
+            std::vector<std::thread> threads;
+            for (std::uint32_t p = 0; p < producers; ++p) {
+                threads.emplace_back([&, p] {
+                    for (std::uint32_t i = 0; i < perProducer;) {
+                        if (queue->TryPush((p << 24) | i)) ++i;
+                        else yu::concurrent::CpuRelax();
+                    }
+                });
+            }
+
+            std::array<std::uint32_t, producers> next{};
+            bool ordered = true;
+            for (std::uint32_t received = 0; received < producers * perProducer;) {
+                std::uint32_t value;
+                if (!queue->TryPop(value)) continue;
+                const std::uint32_t producer = value >> 24;
+                ordered = ordered && producer < producers && (value & 0xFFFFFF) == next[producer];
+                if (producer < producers) ++next[producer];
+                ++received;
+            }
+            for (auto& thread : threads) thread.join();
+
+            expect(ordered);
+            for (std::uint32_t p = 0; p < producers; ++p) expect(next[p] == perProducer);
+            expect(queue->Empty());
+        };
+    };
+
+    describe("yu::concurrent::SeqLock") = [] {
+        it("should be empty until the first publish") = [] {
+            yu::concurrent::SeqLock<Sample> lock;
+            Sample out{};
+            expect(!lock.Read(out));
+            expect(lock.Version() == 0_u);
+
+            lock.Publish(MakeSample(5));
+            expect(lock.Read(out));
+            expect(out.version == 5_u);
+            expect(Consistent(out));
+            expect(lock.Version() == 1_u);
+        };
+
+        it("should never return a torn value") = [] {
+            yu::concurrent::SeqLock<Sample> lock;
+            lock.Publish(MakeSample(0));
+            std::atomic<bool> done{false};
+            std::thread writer([&] {
+                for (std::uint32_t v = 1; v <= 100000; ++v) lock.Publish(MakeSample(v));
+                done.store(true, std::memory_order_release);
+            });
+
+            bool consistent = true;
+            bool monotonic = true;
+            std::uint32_t last = 0;
+            while (!done.load(std::memory_order_acquire)) {
+                Sample out;
+                lock.Read(out);
+                consistent = consistent && Consistent(out);
+                monotonic = monotonic && out.version >= last;
+                last = out.version;
+            }
+            writer.join();
+
+            Sample out;
+            expect(lock.Read(out) && out.version == 100000_u);
+            expect(consistent);
+            expect(monotonic);
+        };
+    };
+
+    describe("yu::concurrent::TripleBuffer") = [] {
+        it("should hand over the latest published value") = [] {
+            yu::concurrent::TripleBuffer<int> buffer(-1);
+            expect(!buffer.Fetch());
+            expect(buffer.Front() == -1);
+
+            buffer.Publish(1);
+            buffer.Publish(2);
+            expect(buffer.Fetch());
+            expect(buffer.Front() == 2);
+            expect(!buffer.Fetch());
+            expect(buffer.Front() == 2);
+
+            buffer.Back() = 3;
+            buffer.Publish();
+            expect(buffer.Fetch());
+            expect(buffer.Front() == 3);
+        };
+
+        it("should never share a buffer between writer and reader") = [] {
+            yu::concurrent::TripleBuffer<Sample> buffer(MakeSample(0));
+            std::atomic<bool> done{false};
+            std::thread writer([&] {
+                for (std::uint32_t v = 1; v <= 100000; ++v) buffer.Publish(MakeSample(v));
+                done.store(true, std::memory_order_release);
+            });
+
+            bool consistent = true;
+            bool monotonic = true;
+            std::uint32_t last = 0;
+            while (!done.load(std::memory_order_acquire)) {
+                if (!buffer.Fetch()) continue;
+                consistent = consistent && Consistent(buffer.Front());
+                monotonic = monotonic && buffer.Front().version > last;
+                last = buffer.Front().version;
+            }
+            writer.join();
+
+            buffer.Fetch();
+            expect(buffer.Front().version == 100000_u);
+            expect(consistent);
+            expect(monotonic);
+        };
+    };
+
+    return 0;
+}
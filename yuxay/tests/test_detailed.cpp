@@ -0,0 +1,105 @@
+#include <boost/ut.hpp>
+#include <yu/memory_detailed.h>
+#include <barrier>
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+namespace ut = boost::ut;
+
+namespace {
+
+using yu::mem::DetailedAllocationType;
+using yu::mem::DetailedTracker;
+
+constexpr yu::mem::DetailedTagId TestTag = yu::mem::DetailedTags::UserStart;
+
+void* FakeAddress(std::uint32_t index) {
+    return reinterpret_cast<void*>(std::uintptr_t{0x10000} + std::uintptr_t{index} * 16);
+}
+
+} // anonymous namespace
+
+int main() {
+    using namespace ut;
+    using namespace ut::spec;
+
+    cfg<override> = {.tag = {"yu::mem detailed"}};
+
+    describe("yu::mem::DetailedTracker") = [] {
+        it("should keep the newer record of an address recorded twice") = [] {
+            DetailedTracker& tracker = DetailedTracker::Instance();
+            tracker.Reset();
+            tracker.RegisterTag(TestTag, "Test");
+            expect(tracker.GetTagName(TestTag) == std::string_view("Test"));
+
+            tracker.RecordAllocation(FakeAddress(1), 100, 16, TestTag, DetailedAllocationType::Heap);
+            tracker.RecordAllocation(FakeAddress(1), 40, 16, TestTag, DetailedAllocationType::Heap);
+            expect(tracker.CheckLeaks() == 1_u);
+            expect(tracker.GetTotalAllocatedBytes() == 40_u);
+            expect(tracker.GetTagStats(TestTag).currentBytes == 40_u);
+
+            tracker.RecordDeallocation(FakeAddress(2));  // Never recorded
+            tracker.RecordDeallocation(FakeAddress(1));
+            tracker.RecordDeallocation(FakeAddress(1));
+            expect(tracker.CheckLeaks() == 0_u);
+            expect(tracker.GetTotalAllocatedBytes() == 0_u);
+            expect(tracker.GetTagStats(TestTag).freeCount == 2_u) << "one for the replaced record";
+        };
+
+        it("should agree on totals after concurrent allocations and frees") = [] {
+            DetailedTracker& tracker = DetailedTracker::Instance();
+            tracker.Reset();
+
+            // Every thread records its own range, then frees half of its
+            // neighbour's: frees land on shards other threads are filling
+            constexpr std::uint32_t Threads = 8;
+            constexpr std::uint32_t PerThread = 4000;
+            std::barrier sync(Threads);
+            std::vector<std::thread> threads;
+            for (std::uint32_t t = 0; t < Threads; ++t) {
+                threads.emplace_back([&tracker, &sync, t] {
+                    for (std::uint32_t i = 0; i < PerThread; ++i) {
+                        tracker.RecordAllocation(FakeAddress(t * PerThread + i), 16 + i % 64, 16,
+                                                 TestTag + t % 2, DetailedAllocationType::Heap);
+                    }
+                    sync.arrive_and_wait();
+                    const std::uint32_t neighbour = (t + 1) % Threads;
+                    for (std::uint32_t i = 0; i < PerThread; i += 2) {
+                        tracker.RecordDeallocation(FakeAddress(neighbour * PerThread + i));
+                    }
+                });
+            }
+            for (std::thread& thread : threads) thread.join();
+
+            std::size_t liveBytes = 0;
+            std::size_t tagBytes[2] = {};
+            for (std::uint32_t t = 0; t < Threads; ++t) {
+                for (std::uint32_t i = 1; i < PerThread; i += 2) {
+                    liveBytes += 16 + i % 64;
+                    tagBytes[t % 2] += 16 + i % 64;
+                }
+            }
+            const std::size_t live = Threads * PerThread / 2;
+            expect(tracker.CheckLeaks() == live);
+            expect(tracker.GetActiveAllocations().size() == live);
+            expect(tracker.GetTotalAllocatedBytes() == liveBytes);
+            expect(tracker.GetPeakAllocatedBytes() >= liveBytes);
+            expect(tracker.GetDroppedCount() == 0_u);
+            expect(tracker.GetFootprint() > 0_u);
+
+            for (std::uint32_t tag = 0; tag < 2; ++tag) {
+                const yu::mem::DetailedTagStats stats = tracker.GetTagStats(TestTag + tag);
+                expect(stats.currentBytes == tagBytes[tag]);
+                expect(stats.allocationCount == Threads / 2 * PerThread);
+                expect(stats.freeCount == Threads / 2 * PerThread / 2);
+                expect(stats.totalAllocated - stats.totalFreed == stats.currentBytes);
+                expect(tracker.GetActiveAllocations(TestTag + tag).size() == stats.GetActiveAllocations());
+            }
+
+            tracker.Reset();
+            expect(tracker.CheckLeaks() == 0_u);
+            expect(tracker.GetTotalAllocatedBytes() == 0_u);
+        };
+    };
+}
@@ -0,0 +1,74 @@
+#include <boost/ut.hpp>
+#include <yu/memory_frame.h>
+#include <cstring>
+#include <string_view>
+#include <thread>
+
+namespace ut = boost::ut;
+
+int main() {
+    using namespace ut;
+    using namespace ut::spec;
+
+    cfg<override> = {.tag = {"yu::mem frame"}};
+
+    describe("yu::mem::FrameArena") = [] {
+        it("should keep the last frame valid for one more frame") = [] {
+            yu::mem::FrameArena& frame = yu::mem::FrameArena::ThisThread();
+            yu::mem::FrameArena::EndFrame();
+
+            auto* first = frame.AllocateArray<char>(256);
+            std::memset(first, 'a', 256);
+            expect(frame.CurrentBytes() >= 256_u);
+            yu::mem::FrameArena::EndFrame();
+            expect(frame.CurrentBytes() == 0_u);
+            expect(frame.LastFrameBytes() >= 256_u);
+
+            // Frame N + 1 writes to the other arena: frame N reads back intact
+            auto* second = frame.AllocateArray<char>(256);
+            std::memset(second, 'b', 256);
+            expect(second != first);
+            bool intact = true;
+            for (int i = 0; i < 256; ++i) intact = intact && first[i] == 'a';
+            expect(intact);
+
+            // End of frame N + 1: frame N's arena is reset and handed out again
+            yu::mem::FrameArena::EndFrame();
+            auto* third = frame.AllocateArray<char>(256);
+            expect(third == first);
+            std::memset(third, 'c', 256);
+            intact = true;
+            for (int i = 0; i < 256; ++i) intact = intact && second[i] == 'b';
+            expect(intact);
+        };
+
+        it("should catch up on frames ended by another thread") = [] {
+            yu::mem::FrameArena& frame = yu::mem::FrameArena::ThisThread();
+            yu::mem::FrameArena::EndFrame();
+            const std::uint64_t start = yu::mem::FrameArena::FrameIndex();
+
+            (void)frame.Allocate(512);
+            std::thread([] {
+                yu::mem::FrameArena::EndFrame();
+                yu::mem::FrameArena::EndFrame();
+            }).join();
+            expect(yu::mem::FrameArena::FrameIndex() == start + 2);
+            expect(frame.CurrentBytes() >= 512_u) << "nothing resets before the next allocation";
+
+            (void)frame.Allocate(16);
+            expect(frame.LastFrameBytes() >= 512_u);
+            expect(frame.CurrentBytes() < 512_u);
+            expect(frame.HighWater() >= 512_u);
+            expect(yu::mem::FrameArena::GlobalHighWater() >= frame.HighWater());
+        };
+
+        it("should format into frame memory") = [] {
+            yu::mem::FrameArena::EndFrame();
+            const std::string_view text = yu::mem::FrameFormat("wave {} of {}", 3, 10);
+            expect(text == std::string_view("wave 3 of 10"));
+            expect(text.data()[text.size()] == '\0');
+            yu::mem::FrameArena::EndFrame();
+            expect(text == std::string_view("wave 3 of 10")) << "still valid one frame later";
+        };
+    };
+}
@@ -0,0 +1,99 @@
+#include <boost/ut.hpp>
+#include <yu/hook.h>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+namespace ut = boost::ut;
+
+namespace {
+
+using Add = int (*)(int, int);
+
+int AddOriginal(int a, int b) { return a + b; }
+
+Add g_original = &AddOriginal;
+yu::hook::Site& AddSite();
+
+// Detour in the shape the dll's hooks use
+int AddDetour(int a, int b) {
+    if (!AddSite().Enabled()) return g_original(a, b);
+    yu::hook::Site::Scope scope(AddSite());
+    return g_original(a, b) * 10;
+}
+
+yu::hook::Site& AddSite() {
+    static yu::hook::Site site("math.add", reinterpret_cast<void**>(&g_original), reinterpret_cast<void*>(&AddDetour));
+    return site;
+}
+
+} // anonymous namespace
+
+int main() {
+    using namespace ut;
+    using namespace ut::spec;
+
+    cfg<override> = {.tag = {"yu::hook"}};
+
+    describe("yu::hook::Site") = [] {
+        it("should describe the detour") = [] {
+            yu::hook::Site& site = AddSite();
+            expect(std::string_view(site.Name()) == "math.add");
+            expect(site.Original() == reinterpret_cast<void**>(&g_original));
+            expect(site.Detour() == reinterpret_cast<void*>(&AddDetour));
+            expect(site.Enabled());
+            expect(!site.Attached());
+        };
+
+        it("should call through without counting while disabled") = [] {
+            yu::hook::Site& site = AddSite();
+            site.ResetStats();
+            expect(AddDetour(1, 2) == 30_i);
+            expect(site.SetEnabled(false));
+            expect(AddDetour(1, 2) == 3_i);
+            expect(site.SetEnabled(true));
+            expect(AddDetour(2, 2) == 40_i);
+            expect(site.GetStats().calls == 2_ull);
+            expect(site.GetStats().timedCalls == 0_ull);
+        };
+
+        it("should time calls only while timed") = [] {
+            yu::hook::Site& site = AddSite();
+            site.ResetStats();
+            site.SetTimed(true);
+            for (int i = 0; i < 5; ++i) AddDetour(i, i);
+            site.SetTimed(false);
+            AddDetour(1, 1);
+            const auto stats = site.GetStats();
+            expect(stats.calls == 6_ull);
+            expect(stats.timedCalls == 5_ull);
+        };
+
+        it("should refuse to disable a pinned site") = [] {
+            void* original = nullptr;
+            yu::hook::Site site("d3d9.Reset", &original, nullptr, true);
+            expect(site.Pinned());
+            expect(!site.SetEnabled(false));
+            expect(site.Enabled());
+            expect(site.SetEnabled(true));
+        };
+
+        it("should count calls from several threads") = [] {
+            void* original = nullptr;
+            yu::hook::Site site("memory.malloc", &original, nullptr);
+            std::vector<std::thread> threads;
+            for (int t = 0; t < 4; ++t) {
+                threads.emplace_back([&site] {
+                    for (int i = 0; i < 10000; ++i) yu::hook::Site::Scope scope(site);
+                });
+            }
+            for (auto& thread : threads) thread.join();
+            expect(site.GetStats().calls == 40000_ull);
+
+            site.ResetStats();
+            expect(site.GetStats().calls == 0_ull) << "every shard is cleared";
+        };
+    };
+
+    return 0;
+}
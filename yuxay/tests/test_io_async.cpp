@@ -0,0 +1,191 @@
+#include <boost/ut.hpp>
+#include <yu/io_async.h>
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <filesystem>
+#include <future>
+#include <mutex>
+#include <vector>
+
+namespace ut = boost::ut;
+
+namespace {
+
+constexpr std::size_t FileSize = 64 * 1024;
+
+std::vector<std::uint8_t> Pattern(std::size_t size) {
+    std::vector<std::uint8_t> bytes(size);
+    for (std::size_t i = 0; i < size; ++i) {
+        bytes[i] = static_cast<std::uint8_t>((i * 131) ^ (i >> 9));
+    }
+    return bytes;
+}
+
+bool Matches(std::span<const std::uint8_t> read, const std::vector<std::uint8_t>& bytes, std::size_t offset) {
+    return offset + read.size() <= bytes.size() &&
+           std::equal(read.begin(), read.end(), bytes.begin() + static_cast<std::ptrdiff_t>(offset));
+}
+
+yu::io::ReadRequest Request(std::uint64_t offset, std::size_t length) {
+    yu::io::ReadRequest request;
+    request.path = "data.bin";
+    request.offset = offset;
+    request.length = length;
+    return request;
+}
+
+} // anonymous namespace
+
+int main() {
+    using namespace ut;
+    using namespace ut::spec;
+
+    cfg<override> = {.tag = {"yu::io async"}};
+
+    const std::filesystem::path directory = std::filesystem::temp_directory_path() / "yu_test_async";
+    std::filesystem::create_directories(directory);
+    yu::io::SetBasePath(directory);
+    const std::vector<std::uint8_t> bytes = Pattern(FileSize);
+    expect(yu::io::WriteBytes("data.bin", bytes).has_value());
+
+    describe("yu::io::AsyncReader::ReadAll") = [&] {
+        it("should complete a mixed batch in request order") = [&] {
+            yu::io::AsyncReader reader;
+            expect(reader.IsRunning() >> fatal);
+
+            std::vector<std::uint8_t> destination(100, 0);
+            std::vector<yu::io::ReadRequest> requests;
+            requests.push_back(Request(10, yu::io::ReadRequest::ToEnd));  // 0: caller buffer, clamped to it
+            requests.back().buffer = destination;
+            requests.push_back(Request(1000, 500));                       // 1: pooled
+            requests.push_back(Request(FileSize - 10, 100));              // 2: clamped at the end of the file
+            requests.push_back(Request(FileSize, 100));                   // 3: at the end: nothing to read
+            requests.push_back(Request(FileSize + 1, 1));                 // 4: past the end
+            requests.push_back(Request(0, 16));                           // 5: missing file
+            requests.back().path = "missing.bin";
+            requests.push_back(Request(0, yu::io::ReadRequest::ToEnd));   // 6: whole file, pooled
+
+            const std::vector<yu::io::ReadResult> results = reader.ReadAll(std::move(requests));
+            expect((results.size() == 7_u) >> fatal);
+            for (std::size_t i : {0u, 1u, 2u, 3u, 6u}) {
+                expect(results[i].has_value() >> fatal) << "request" << i;
+                expect(results[i]->index == i);
+            }
+
+            expect(results[0]->bytes.size() == 100_u);
+            expect(results[0]->bytes.data() == destination.data()) << "read into the caller's buffer";
+            expect(results[0]->pooled.empty());
+            expect(Matches(destination, bytes, 10));
+
+            expect(results[1]->bytes.size() == 500_u);
+            expect(results[1]->bytes.data() == results[1]->pooled.data());
+            expect(Matches(results[1]->bytes, bytes, 1000));
+
+            expect(results[2]->bytes.size() == 10_u);
+            expect(Matches(results[2]->bytes, bytes, FileSize - 10));
+            expect(results[3]->bytes.empty());
+
+            expect(!results[4].has_value());
+            expect(!results[4].has_value() && results[4].error() == yu::io::IOError::ReadError);
+            expect(!results[5].has_value());
+            expect(!results[5].has_value() && results[5].error() == yu::io::IOError::FileNotFound);
+
+            expect(results[6]->bytes.size() == FileSize);
+            expect(Matches(results[6]->bytes, bytes, 0));
+            expect(reader.Pending() == 0_u);
+        };
+
+        it("should reuse recycled buffers") = [&] {
+            yu::io::AsyncReader reader;
+            std::vector<yu::io::ReadRequest> first;
+            first.push_back(Request(0, 4096));
+            std::vector<yu::io::ReadResult> results = reader.ReadAll(std::move(first));
+            expect(results[0].has_value() >> fatal);
+            const std::uint8_t* storage = results[0]->pooled.data();
+            reader.Recycle(std::move(results[0]->pooled));
+
+            // Smaller than the recycled buffer: served from it
+            std::vector<yu::io::ReadRequest> second;
+            second.push_back(Request(512, 1024));
+            results = reader.ReadAll(std::move(second));
+            expect(results[0].has_value() >> fatal);
+            expect(results[0]->pooled.data() == storage);
+            expect(results[0]->bytes.size() == 1024_u);
+            expect(Matches(results[0]->bytes, bytes, 512));
+        };
+    };
+
+    describe("yu::io::AsyncReader callbacks") = [&] {
+        it("should pass each request's index to the callback") = [&] {
+            yu::io::AsyncReader reader({.maxInFlight = 4, .workerThreads = 3});
+
+            constexpr std::size_t Count = 64;
+            std::vector<yu::io::ReadRequest> requests;
+            for (std::size_t i = 0; i < Count; ++i) {
+                requests.push_back(Request(i * 512, 256));
+            }
+            requests[7].path = "missing.bin";  // A failure still reports its index
+
+            std::mutex mutex;
+            std::condition_variable done;
+            std::vector<int> calls(Count, 0);
+            bool indicesMatch = true;
+            bool bytesMatch = true;
+            std::size_t received = 0;
+            reader.Submit(std::move(requests), [&](std::size_t index, yu::io::ReadResult&& result) {
+                std::lock_guard lock(mutex);
+                if (index < Count) ++calls[index];
+                if (result) {
+                    indicesMatch = indicesMatch && result->index == index;
+                    bytesMatch = bytesMatch && Matches(result->bytes, bytes, index * 512) && result->bytes.size() == 256;
+                    reader.Recycle(std::move(result->pooled));
+                } else {
+                    indicesMatch = indicesMatch && index == 7;
+                }
+                if (++received == Count) done.notify_one();
+            });
+
+            std::unique_lock lock(mutex);
+            expect(done.wait_for(lock, std::chrono::seconds(10), [&] { return received == Count; }));
+            expect(indicesMatch);
+            expect(bytesMatch);
+            expect(std::all_of(calls.begin(), calls.end(), [](int count) { return count == 1; })) << "once each";
+        };
+    };
+
+    describe("yu::io::AsyncReader shutdown") = [&] {
+        it("should complete every request when destroyed with requests queued") = [&] {
+            std::vector<std::future<yu::io::ReadResult>> futures;
+            {
+                yu::io::AsyncReader reader({.maxInFlight = 1, .workerThreads = 1});
+                std::vector<yu::io::ReadRequest> requests;
+                for (int i = 0; i < 256; ++i) {
+                    requests.push_back(Request(0, yu::io::ReadRequest::ToEnd));
+                }
+                futures = reader.Submit(std::move(requests));
+            }
+
+            // Whatever had not started when the reader went away failed instead of hanging
+            std::size_t cancelled = 0;
+            bool otherErrors = false;
+            bool ready = true;
+            for (auto& future : futures) {
+                ready = ready && future.wait_for(std::chrono::seconds(0)) == std::future_status::ready;
+                if (!ready) break;
+                const yu::io::ReadResult result = future.get();
+                if (!result) {
+                    ++cancelled;
+                    otherErrors = otherErrors || result.error() != yu::io::IOError::ReadError;
+                }
+            }
+            expect(ready);
+            expect(cancelled > 0_u);
+            expect(!otherErrors);
+        };
+    };
+
+    yu::io::SetBasePath({});
+    std::filesystem::remove_all(directory);
+}
@@ -0,0 +1,159 @@
+#include <boost/ut.hpp>
+#include <yu/io_mapped.h>
+#include <algorithm>
+#include <cstdint>
+#include <filesystem>
+#include <vector>
+
+namespace ut = boost::ut;
+
+namespace {
+
+/// Bytes that differ from their neighbours across page boundaries, so a shifted view shows
+std::vector<std::uint8_t> Pattern(std::size_t size) {
+    std::vector<std::uint8_t> bytes(size);
+    for (std::size_t i = 0; i < size; ++i) {
+        bytes[i] = static_cast<std::uint8_t>((i * 131) ^ (i >> 9));
+    }
+    return bytes;
+}
+
+bool Matches(std::span<const std::uint8_t> view, const std::vector<std::uint8_t>& bytes, std::size_t offset) {
+    return offset + view.size() <= bytes.size() &&
+           std::equal(view.begin(), view.end(), bytes.begin() + static_cast<std::ptrdiff_t>(offset));
+}
+
+} // anonymous namespace
+
+int main() {
+    using namespace ut;
+    using namespace ut::spec;
+
+    cfg<override> = {.tag = {"yu::io mapped"}};
+
+    const std::filesystem::path directory = std::filesystem::temp_directory_path() / "yu_test_mapped";
+    std::filesystem::create_directories(directory);
+    yu::io::SetBasePath(directory);
+
+    // Three and a half alignment units: windows start inside, across and at the end of them
+    const std::size_t alignment = yu::io::MappedFile::WindowAlignment();
+    const std::vector<std::uint8_t> bytes = Pattern(alignment * 3 + alignment / 2);
+    expect(yu::io::WriteBytes("data.bin", bytes).has_value());
+    expect(yu::io::WriteBytes("empty.bin", std::span<const std::uint8_t>{}).has_value());
+
+    describe("yu::io::MappedFile::MapWindow") = [&] {
+        it("should map a window at an unaligned offset") = [&] {
+            auto file = yu::io::MappedFile::Open("data.bin");
+            expect(file.has_value() >> fatal);
+            expect(file->Size() == bytes.size());
+
+            for (const std::size_t offset : {std::size_t{1}, alignment - 1, alignment + 123, 2 * alignment + 7}) {
+                auto window = file->MapWindow(offset, alignment);  // Crosses an alignment boundary
+                expect(window.has_value() >> fatal);
+                expect(window->Offset() == offset);
+                expect(window->Size() == alignment);
+                expect(Matches(window->Data(), bytes, offset)) << "offset" << offset;
+            }
+        };
+
+        it("should clamp a window at the end of the file") = [&] {
+            auto file = yu::io::MappedFile::Open("data.bin");
+            expect(file.has_value() >> fatal);
+
+            const std::size_t offset = 3 * alignment + 5;
+            auto window = file->MapWindow(offset, 4 * alignment);
+            expect(window.has_value() >> fatal);
+            expect(window->Size() == bytes.size() - offset);
+            expect(Matches(window->Data(), bytes, offset));
+
+            auto last = file->MapWindow(bytes.size() - 1, 16);
+            expect(last.has_value() >> fatal);
+            expect(last->Size() == 1_u);
+            expect(last->Data()[0] == bytes.back());
+        };
+
+        it("should give an empty view at the end of the file and fail past it") = [&] {
+            auto file = yu::io::MappedFile::Open("data.bin");
+            expect(file.has_value() >> fatal);
+
+            auto atEnd = file->MapWindow(bytes.size(), 64);
+            expect(atEnd.has_value() >> fatal);
+            expect(atEnd->Empty());
+            expect(atEnd->Offset() == bytes.size());
+
+            auto zero = file->MapWindow(100, 0);
+            expect(zero.has_value() && zero->Empty());
+
+            expect(!file->MapWindow(bytes.size() + 1, 1).has_value());
+        };
+
+        it("should keep a window valid after the file is closed") = [&] {
+            auto file = yu::io::MappedFile::Open("data.bin");
+            expect(file.has_value() >> fatal);
+            auto window = file->MapWindow(alignment + 3, 100);
+            expect(window.has_value() >> fatal);
+            file->Close();
+            expect(Matches(window->Data(), bytes, alignment + 3));
+            expect(!file->MapWindow(0, 1).has_value()) << "closed";
+        };
+    };
+
+    describe("yu::io::MappedFile::View") = [&] {
+        it("should match ReadBytes") = [&] {
+            auto file = yu::io::MappedFile::Open("data.bin", yu::io::AccessHint::Sequential);
+            expect(file.has_value() >> fatal);
+            auto view = file->View();
+            expect(view.has_value() >> fatal);
+
+            auto read = yu::io::ReadBytes("data.bin");
+            expect(read.has_value() >> fatal);
+            expect(view->size() == read->size());
+            expect(std::equal(view->begin(), view->end(), read->begin()));
+
+            auto again = file->View();
+            expect(again.has_value() && again->data() == view->data()) << "mapped once";
+        };
+
+        it("should walk the file in windows") = [&] {
+            auto file = yu::io::MappedFile::Open("data.bin");
+            expect(file.has_value() >> fatal);
+            std::size_t covered = 0;
+            bool ordered = true;
+            auto walked = file->ForEachWindow(0, [&](std::uint64_t offset, std::span<const std::uint8_t> data) {
+                ordered = ordered && offset == covered && Matches(data, bytes, covered);
+                covered += data.size();
+                return true;
+            });
+            expect(walked.has_value() && *walked);
+            expect(ordered);
+            expect(covered == bytes.size());
+        };
+
+        it("should map an empty file as an empty view") = [] {
+            auto file = yu::io::MappedFile::Open("empty.bin");
+            expect(file.has_value() >> fatal);
+            expect(file->Size() == 0_u);
+            auto view = file->View();
+            expect(view.has_value() >> fatal);
+            expect(view->empty());
+            auto window = file->MapWindow(0, 16);
+            expect(window.has_value() && window->Empty());
+
+            std::size_t calls = 0;
+            auto walked = file->ForEachWindow(0, [&](std::uint64_t, std::span<const std::uint8_t>) {
+                ++calls;
+                return true;
+            });
+            expect(walked.has_value() && *walked);
+            expect(calls == 0_u);
+        };
+
+        it("should fail to open a missing file") = [] {
+            auto file = yu::io::MappedFile::Open("missing.bin");
+            expect(!file.has_value());
+        };
+    };
+
+    yu::io::SetBasePath({});
+    std::filesystem::remove_all(directory);
+}
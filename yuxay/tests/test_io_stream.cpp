@@ -0,0 +1,180 @@
+#include <boost/ut.hpp>
+#include <yu/io_stream.h>
+#include <yu/memory_os.h>
+#include <cstdint>
+#include <filesystem>
+#include <string>
+#include <vector>
+
+#ifndef _WIN32
+    #include <csignal>
+    #include <sys/resource.h>
+#endif
+
+namespace ut = boost::ut;
+
+namespace {
+
+/// Bytes that differ from their neighbours across page boundaries, so a misplaced page shows
+std::vector<std::uint8_t> Pattern(std::size_t size) {
+    std::vector<std::uint8_t> bytes(size);
+    for (std::size_t i = 0; i < size; ++i) {
+        bytes[i] = static_cast<std::uint8_t>((i * 131) ^ (i >> 9));
+    }
+    return bytes;
+}
+
+std::string ReadText(const std::filesystem::path& path) {
+    auto text = yu::io::ReadString(path);
+    return text ? *text : std::string("<unreadable>");
+}
+
+bool ContentIs(const std::filesystem::path& path, const std::vector<std::uint8_t>& bytes) {
+    auto read = yu::io::ReadBytes(path);
+    return read && *read == bytes;
+}
+
+} // anonymous namespace
+
+int main() {
+    using namespace ut;
+    using namespace ut::spec;
+
+    cfg<override> = {.tag = {"yu::io stream"}};
+
+    const std::filesystem::path directory = std::filesystem::temp_directory_path() / "yu_test_stream";
+    std::filesystem::create_directories(directory);
+    yu::io::SetBasePath(directory);
+    const std::size_t page = yu::mem::os::PageSize();
+
+    describe("yu::io::StreamWriter buffering") = [&] {
+        it("should write a block larger than the buffer") = [&] {
+            const std::vector<std::uint8_t> bytes = Pattern(3 * page + page / 2);
+            yu::io::StreamWriter writer;
+            expect(writer.Open(std::filesystem::path("large.bin"), yu::io::StreamMode::Truncate,
+                               {.bufferSize = page}).has_value() >> fatal);
+            expect(writer.Write(bytes));
+            expect(writer.BytesWritten() == bytes.size());
+            expect(writer.Close().has_value());
+            expect(ContentIs("large.bin", bytes));
+        };
+
+        it("should keep the order of buffers written in the background") = [&] {
+            // Lines of varying length, so buffer boundaries fall inside them
+            std::string expected;
+            yu::io::StreamWriter writer;
+            expect(writer.Open(std::filesystem::path("background.txt"), yu::io::StreamMode::Truncate,
+                               {.bufferSize = page, .backgroundFlush = true}).has_value() >> fatal);
+            for (int line = 0; line < 2000; ++line) {
+                const std::string text = std::to_string(line) + std::string(static_cast<std::size_t>(line % 37), '.');
+                expect(writer.WriteLine(text) >> fatal);
+                expected += text + '\n';
+                if (line == 1000) {
+                    expect(writer.Flush().has_value());
+                    expect(std::filesystem::file_size(directory / "background.txt") == writer.BytesWritten());
+                }
+            }
+            expect(writer.BytesWritten() == expected.size());
+            expect((expected.size() > 8 * page) >> fatal) << "several buffer swaps";
+            expect(writer.Close().has_value());
+            expect(ReadText("background.txt") == expected);
+        };
+
+        it("should pad unbuffered pages and cut the file to length on Close") = [&] {
+            const std::vector<std::uint8_t> bytes = Pattern(2 * page + 123);
+            yu::io::StreamWriter writer;
+            expect(writer.Open(std::filesystem::path("unbuffered.bin"), yu::io::StreamMode::Truncate,
+                               {.bufferSize = page, .unbuffered = true}).has_value() >> fatal);
+            expect(writer.Write(std::span(bytes).first(page + 10)));
+            expect(writer.Write(std::span(bytes).subspan(page + 10)));
+            expect(writer.Flush().has_value());
+            // A partial page may stay buffered until Close
+            expect(std::filesystem::file_size(directory / "unbuffered.bin") <= writer.BytesWritten());
+            expect(writer.BytesWritten() == bytes.size());
+            expect(writer.Close().has_value());
+            expect(std::filesystem::file_size(directory / "unbuffered.bin") == bytes.size());
+            expect(ContentIs("unbuffered.bin", bytes));
+        };
+    };
+
+    describe("yu::io::StreamWriter modes") = [&] {
+        it("should append to an existing file") = [&] {
+            expect(yu::io::WriteString("append.log", "first\n").has_value());
+            for (const char* line : {"second", "third"}) {
+                yu::io::StreamWriter writer;
+                expect(writer.Open(std::filesystem::path("append.log"), yu::io::StreamMode::Append).has_value() >> fatal);
+                expect(writer.WriteLine(line));
+                expect(writer.Close().has_value());
+            }
+            expect(ReadText("append.log") == "first\nsecond\nthird\n");
+
+            yu::io::StreamWriter writer;
+            expect(writer.Open(std::filesystem::path("append.log")).has_value() >> fatal);
+            expect(writer.WriteLine("replaced"));
+            expect(writer.Close().has_value());
+            expect(ReadText("append.log") == "replaced\n") << "Truncate";
+        };
+
+        it("should rename the temporary file over the target on Close") = [&] {
+            expect(yu::io::WriteString("atomic.txt", "old").has_value());
+            yu::io::StreamWriter writer;
+            expect(writer.Open(std::filesystem::path("atomic.txt"), yu::io::StreamMode::Atomic).has_value() >> fatal);
+            expect(writer.Write(std::string_view("new contents")));
+            expect(writer.Flush().has_value());
+            expect(std::filesystem::exists(directory / "atomic.txt.tmp"));
+            expect(ReadText("atomic.txt") == "old") << "readers see the old file until Close";
+
+            expect(writer.Close().has_value());
+            expect(!writer.IsOpen());
+            expect(ReadText("atomic.txt") == "new contents");
+            expect(!std::filesystem::exists(directory / "atomic.txt.tmp"));
+        };
+
+        it("should keep the old file on Discard") = [&] {
+            expect(yu::io::WriteString("discard.txt", "old").has_value());
+            yu::io::StreamWriter writer;
+            expect(writer.Open(std::filesystem::path("discard.txt"), yu::io::StreamMode::Atomic,
+                               {.bufferSize = page, .backgroundFlush = true}).has_value() >> fatal);
+            expect(writer.Write(Pattern(3 * page)));
+            writer.Discard();
+            expect(!writer.IsOpen());
+            expect(ReadText("discard.txt") == "old");
+            expect(!std::filesystem::exists(directory / "discard.txt.tmp"));
+            expect(writer.Close().has_value()) << "nothing left to close";
+            expect(ReadText("discard.txt") == "old");
+        };
+
+#ifndef _WIN32
+        it("should keep the old file when a write fails") = [&] {
+            expect(yu::io::WriteString("failed.txt", "old").has_value());
+
+            // Cap the file size so the second page is refused with EFBIG
+            std::signal(SIGXFSZ, SIG_IGN);
+            rlimit previous{};
+            getrlimit(RLIMIT_FSIZE, &previous);
+            rlimit capped = previous;
+            capped.rlim_cur = page;
+            expect((setrlimit(RLIMIT_FSIZE, &capped) == 0) >> fatal);
+
+            yu::io::StreamWriter writer;
+            const bool opened = writer.Open(std::filesystem::path("failed.txt"), yu::io::StreamMode::Atomic,
+                                            {.bufferSize = page}).has_value();
+            const bool wrote = opened && writer.Write(Pattern(3 * page));
+            const yu::io::IOError error = writer.GetError();
+            const auto closed = writer.Close();
+            setrlimit(RLIMIT_FSIZE, &previous);
+            std::signal(SIGXFSZ, SIG_DFL);
+
+            expect(opened);
+            expect(!wrote);
+            expect(error != yu::io::IOError::None);
+            expect(!closed.has_value());
+            expect(ReadText("failed.txt") == "old");
+            expect(!std::filesystem::exists(directory / "failed.txt.tmp"));
+        };
+#endif
+    };
+
+    yu::io::SetBasePath({});
+    std::filesystem::remove_all(directory);
+}
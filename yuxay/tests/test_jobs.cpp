@@ -0,0 +1,163 @@
+#include <boost/ut.hpp>
+#include <yu/jobs.h>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <numeric>
+#include <span>
+#include <thread>
+#include <vector>
+
+namespace ut = boost::ut;
+
+int main() {
+    using namespace ut;
+    using namespace ut::spec;
+
+    cfg<override> = {.tag = {"yu::jobs"}};
+
+    describe("yu::jobs::JobSystem::ParallelFor") = [] {
+        it("should visit every item exactly once") = [] {
+            yu::jobs::JobSystem jobs;
+            expect(jobs.Start({.workerThreads = 4}));
+
+            std::vector<std::uint32_t> items(10000, 0);
+            jobs.ParallelFor(std::span(items), 64, [](std::span<std::uint32_t> part) {
+                for (std::uint32_t& item : part) ++item;
+            });
+            bool once = true;
+            for (std::uint32_t item : items) once = once && item == 1;
+            expect(once);
+
+            // Default grain, and a range smaller than one chunk
+            jobs.ParallelFor(std::span(items), 0, [](std::span<std::uint32_t> part) {
+                for (std::uint32_t& item : part) ++item;
+            });
+            jobs.ParallelFor(std::span(items).first(3), 64, [](std::span<std::uint32_t> part) {
+                for (std::uint32_t& item : part) ++item;
+            });
+            expect(std::accumulate(items.begin(), items.end(), 0u) == 20003_u);
+            jobs.Stop();
+        };
+    };
+
+    describe("yu::jobs::JobSystem parents") = [] {
+        it("should not finish a parent before its children") = [] {
+            yu::jobs::JobSystem jobs;
+            expect(jobs.Start({.workerThreads = 2}));
+
+            std::atomic<bool> release{false};
+            std::atomic<std::uint32_t> children{0};
+            const yu::jobs::JobHandle parent = jobs.Create([] {});
+            expect(parent.Valid());
+            for (int i = 0; i < 8; ++i) {
+                jobs.Run(jobs.Create([&] {
+                    while (!release.load(std::memory_order_acquire)) std::this_thread::yield();
+                    children.fetch_add(1, std::memory_order_relaxed);
+                }, parent));
+            }
+            jobs.Run(parent);
+
+            // The parent's own body ran, but its children are held back
+            std::this_thread::sleep_for(std::chrono::milliseconds(10));
+            expect(!jobs.IsDone(parent));
+
+            release.store(true, std::memory_order_release);
+            jobs.Wait(parent);
+            expect(jobs.IsDone(parent));
+            expect(children.load() == 8_u);
+            jobs.Stop();
+        };
+
+        it("should finish a running parent exactly once while children are added") = [] {
+            yu::jobs::JobSystem jobs;
+            expect(jobs.Start({.workerThreads = 4, .maxJobs = 256}));
+
+            // Children are added while the parent runs, racing its last decrement: a
+            // parent finished twice would run its continuation twice
+            std::atomic<std::uint32_t> finished{0};
+            std::atomic<std::uint32_t> children{0};
+            for (int round = 0; round < 500; ++round) {
+                const yu::jobs::JobHandle parent = jobs.Create([] {});
+                auto* counter = &finished;
+                expect(jobs.AddContinuation(parent, jobs.Create([counter] {
+                    counter->fetch_add(1, std::memory_order_relaxed);
+                })));
+                jobs.Run(parent);
+                for (int i = 0; i < 4; ++i) {
+                    jobs.Schedule([&children] { children.fetch_add(1, std::memory_order_relaxed); }, parent);
+                }
+                jobs.Wait(parent);
+            }
+            jobs.Stop();
+            expect(children.load() == 2000_u);
+            expect(finished.load() == 500_u);
+        };
+    };
+
+    describe("yu::jobs::JobSystem continuations") = [] {
+        it("should run continuations after the ancestor and its children") = [] {
+            yu::jobs::JobSystem jobs;
+            expect(jobs.Start({.workerThreads = 3}));
+
+            std::atomic<std::uint32_t> step{0};
+            std::atomic<std::uint32_t> childrenSeen{0};
+            std::atomic<bool> ordered{true};
+            std::atomic<std::uint32_t> children{0};
+
+            const yu::jobs::JobHandle ancestor = jobs.Create([&] { step.fetch_add(1); });
+            for (int i = 0; i < 16; ++i) {
+                jobs.Run(jobs.Create([&] { children.fetch_add(1); }, ancestor));
+            }
+            yu::jobs::JobHandle continuations[yu::jobs::MaxContinuations];
+            for (auto& continuation : continuations) {
+                continuation = jobs.Create([&] {
+                    childrenSeen.fetch_add(children.load() == 16 ? 1 : 0);
+                    if (step.load() != 1) ordered.store(false);
+                });
+                expect(jobs.AddContinuation(ancestor, continuation));
+            }
+            const yu::jobs::JobHandle extra = jobs.Create([] {});
+            expect(!jobs.AddContinuation(ancestor, extra)) << "at most MaxContinuations";
+
+            jobs.Run(ancestor);
+            for (auto& continuation : continuations) jobs.Wait(continuation);
+            expect(ordered.load());
+            expect(childrenSeen.load() == yu::jobs::MaxContinuations);
+
+            // Added after the ancestor finished: runs at once
+            std::atomic<bool> late{false};
+            const yu::jobs::JobHandle tail = jobs.Create([&] { late.store(true); });
+            expect(jobs.AddContinuation(ancestor, tail));
+            jobs.Wait(tail);
+            expect(late.load());
+
+            jobs.Run(extra);
+            jobs.Stop();
+        };
+    };
+
+    describe("yu::jobs::JobSystem capacity") = [] {
+        it("should help instead of running inline when slots or queues are full") = [] {
+            yu::jobs::JobSystem jobs;
+            expect(jobs.Start({.workerThreads = 2, .maxJobs = 8, .queueCapacity = 4}));
+
+            std::atomic<std::uint32_t> ran{0};
+            for (int i = 0; i < 2000; ++i) {
+                jobs.Schedule([&ran] { ran.fetch_add(1, std::memory_order_relaxed); });
+            }
+            jobs.Stop();
+            expect(ran.load() == 2000_u);
+            expect(jobs.GetStats().inlined == 0_u);
+        };
+
+        it("should run inline only when the system is not running") = [] {
+            yu::jobs::JobSystem jobs;
+            bool ran = false;
+            const yu::jobs::JobHandle job = jobs.Schedule([&ran] { ran = true; });
+            expect(ran);
+            expect(!job.Valid());
+            expect(jobs.IsDone(job));
+        };
+    };
+}
@@ -0,0 +1,126 @@
+#include <boost/ut.hpp>
+#include <yu/memory_lightweight.h>
+#include <cstdint>
+#include <string_view>
+
+namespace ut = boost::ut;
+
+namespace {
+
+using yu::mem::LightweightTracker;
+
+void* FakeAddress(std::uint32_t index) {
+    return reinterpret_cast<void*>(static_cast<std::uintptr_t>(0x20000000u + index * 16u));
+}
+
+std::size_t ClassFrees(const LightweightTracker& tracker, std::size_t sizeClass) {
+    std::size_t frees = 0;
+    for (std::size_t b = 0; b < yu::mem::LightweightConfig::LifetimeBuckets; ++b) {
+        frees += tracker.GetLifetimeCount(sizeClass, b);
+    }
+    return frees;
+}
+
+} // anonymous namespace
+
+int main() {
+    using namespace ut;
+    using namespace ut::spec;
+
+    cfg<override> = {.tag = {"yu::mem lifetimes"}};
+
+    describe("LifetimeTable") = [] {
+        it("should bucket ages by log2") = [] {
+            expect(LightweightTracker::LifetimeBucketOf(0) == 0_u);
+            expect(LightweightTracker::LifetimeBucketOf(1) == 1_u);
+            expect(LightweightTracker::LifetimeBucketOf(2) == 2_u);
+            expect(LightweightTracker::LifetimeBucketOf(3) == 2_u);
+            expect(LightweightTracker::LifetimeBucketOf(4) == 3_u);
+            expect(LightweightTracker::LifetimeBucketOf(1023) == 10_u);
+            expect(LightweightTracker::LifetimeBucketOf(1024) == 11_u);
+            expect(LightweightTracker::LifetimeBucketOf(60000) == 11_u);
+        };
+    };
+
+    describe("LightweightTracker lifetime profiling") = [] {
+        it("should count frames alive per size class") = [] {
+            LightweightTracker& tracker = LightweightTracker::Instance();
+            tracker.Reset();
+            tracker.SetLifetimeProfiling(true);
+            const std::size_t small = yu::mem::SizeClassOf(48);
+            const std::size_t large = yu::mem::SizeClassOf(4096);
+
+            // 10 freed in the same frame, 5 after one frame, 3 after six frames
+            for (std::uint32_t i = 0; i < 18; ++i) tracker.RecordAllocation(FakeAddress(i), i < 15 ? 48 : 4096);
+            for (std::uint32_t i = 0; i < 10; ++i) tracker.RecordDeallocation(FakeAddress(i));
+            tracker.AdvanceFrame();
+            for (std::uint32_t i = 10; i < 15; ++i) tracker.RecordDeallocation(FakeAddress(i));
+            for (int f = 0; f < 5; ++f) tracker.AdvanceFrame();
+            for (std::uint32_t i = 15; i < 18; ++i) tracker.RecordDeallocation(FakeAddress(i));
+
+            expect(tracker.GetLifetimeCount(small, 0) == 10_u);
+            expect(tracker.GetLifetimeCount(small, 1) == 5_u);
+            expect(ClassFrees(tracker, small) == 15_u);
+            expect(tracker.GetLifetimeCount(large, LightweightTracker::LifetimeBucketOf(6)) == 3_u);
+            expect(tracker.GetSameFrameFreeCount() == 10_u);
+
+            // Blocks allocated while profiling was off are stamped too
+            tracker.SetLifetimeProfiling(false);
+            tracker.RecordAllocation(FakeAddress(100), 48);
+            tracker.RecordDeallocation(FakeAddress(101));  // Unknown block: ignored
+            expect(ClassFrees(tracker, small) == 15_u);
+            tracker.AdvanceFrame();
+            tracker.SetLifetimeProfiling(true);
+            tracker.RecordDeallocation(FakeAddress(100));
+            expect(tracker.GetLifetimeCount(small, 1) == 6_u);
+
+            tracker.Reset();
+            expect(ClassFrees(tracker, small) == 0_u);
+            tracker.SetLifetimeProfiling(false);
+        };
+
+        it("should rank call sites by same-frame frees") = [] {
+            LightweightTracker& tracker = LightweightTracker::Instance();
+            tracker.Reset();
+            tracker.SetCallSiteMode(LightweightTracker::CallSiteMode::ReturnAddress);
+            tracker.SetLifetimeProfiling(true);
+
+            // Site A churns within the frame, site B keeps its blocks for two frames
+            void* siteA = FakeAddress(0xA000);
+            void* siteB = FakeAddress(0xB000);
+            for (std::uint32_t i = 0; i < 20; ++i) {
+                tracker.RecordAllocation(FakeAddress(i), 32, 0, LightweightTracker::AllocationType::Heap, siteA);
+                tracker.RecordDeallocation(FakeAddress(i));
+            }
+            for (std::uint32_t i = 20; i < 24; ++i) {
+                tracker.RecordAllocation(FakeAddress(i), 32, 0, LightweightTracker::AllocationType::Heap, siteB);
+            }
+            tracker.AdvanceFrame();
+            tracker.AdvanceFrame();
+            for (std::uint32_t i = 20; i < 24; ++i) tracker.RecordDeallocation(FakeAddress(i));
+
+            std::uint16_t idA = 0, idB = 0;
+            for (std::uint16_t id = 1; id <= yu::mem::LightweightConfig::MaxCallSites; ++id) {
+                if (tracker.GetSiteLifetimeCount(id, 0) == 20) idA = id;
+                if (tracker.GetSiteLifetimeCount(id, 2) == 4) idB = id;
+            }
+            expect(idA != 0_u && idB != 0_u && idA != idB);
+            expect(tracker.GetSiteLifetimeCount(idB, 0) == 0_u);
+
+            char report[4096];
+            const std::size_t length = tracker.GenerateLifetimeReport(report, sizeof(report));
+            const std::string_view text(report, length);
+            expect(text.find("Same frame: 20 (83%)") != std::string_view::npos) << text;
+            expect(text.find("[32-63 B] 24 frees, 83% same frame: 20 0 4") != std::string_view::npos) << text;
+            expect(text.find("Top by same-frame frees:\n  20 of 20 frees") != std::string_view::npos) << text;
+
+            tracker.SetLifetimeProfiling(false);
+            tracker.SetCallSiteMode(LightweightTracker::CallSiteMode::Off);
+            tracker.Reset();
+            const std::size_t off = tracker.GenerateLifetimeReport(report, sizeof(report));
+            expect(std::string_view(report, off).find("(profiling disabled)") != std::string_view::npos);
+        };
+    };
+
+    return 0;
+}
@@ -0,0 +1,130 @@
+#include <boost/ut.hpp>
+#include <yu/log.h>
+#include <yu/log_decode.h>
+#include <cstdint>
+#include <filesystem>
+#include <format>
+#include <fstream>
+#include <iterator>
+#include <limits>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace ut = boost::ut;
+
+namespace {
+
+/// Arguments as a binary entry payload
+template <typename... Args>
+std::string Encode(const Args&... args) {
+    char buffer[yu::detail::LogSlot::TextCapacity];
+    yu::binlog::ArgEncoder encoder(buffer, sizeof(buffer));
+    (encoder.Put(args), ...);
+    return std::string(buffer, encoder.Size());
+}
+
+std::vector<std::string> Lines(const std::string& text) {
+    std::vector<std::string> lines;
+    std::istringstream stream(text);
+    std::string line;
+    while (std::getline(stream, line)) lines.push_back(line);
+    return lines;
+}
+
+bool EndsWith(std::string_view text, std::string_view suffix) {
+    return text.size() >= suffix.size() && text.substr(text.size() - suffix.size()) == suffix;
+}
+
+} // anonymous namespace
+
+int main() {
+    using namespace ut;
+    using namespace ut::spec;
+
+    cfg<override> = {.tag = {"yu::log binary"}};
+
+    describe("yu::binlog::ArgEncoder") = [] {
+        it("should decode to the text std::format produces") = [] {
+            const std::string name = "station";
+            const std::uint64_t big = std::numeric_limits<std::uint64_t>::max();
+            expect(yu::binlog::FormatPayload("{} {} {} {:.3f} {} {} {}", Encode(-7, 42u, big, 3.14159, 'x', true, name)) ==
+                   std::format("{} {} {} {:.3f} {} {} {}", -7, 42u, big, 3.14159, 'x', true, name));
+            expect(yu::binlog::FormatPayload("{:>6}|{:#x}|{:+}", Encode(42, 255u, 5)) ==
+                   std::format("{:>6}|{:#x}|{:+}", 42, 255u, 5));
+            expect(yu::binlog::FormatPayload("{1} before {0}", Encode("b", "a")) == "a before b");
+            expect(yu::binlog::FormatPayload("{{{}}}", Encode(std::string_view("braces"))) == "{braces}");
+
+            const int value = 0;
+            const void* pointer = &value;
+            expect(yu::binlog::FormatPayload("{}", Encode(pointer)) == std::format("{}", pointer));
+        };
+
+        it("should store a null C string as (null)") = [] {
+            const char* missing = nullptr;
+            char* alsoMissing = nullptr;
+            expect(yu::binlog::FormatPayload("[{}] [{}]", Encode(missing, alsoMissing)) == "[(null)] [(null)]");
+        };
+
+        it("should flag truncation and decode what fits") = [] {
+            char buffer[16];
+            yu::binlog::ArgEncoder encoder(buffer, sizeof(buffer));
+            encoder.Put(1);                                  // 9 bytes
+            encoder.Put(std::string_view("a long string"));  // Cut to 4 bytes
+            encoder.Put(2);                                  // No room left
+            expect(encoder.Truncated());
+            expect(encoder.Size() <= sizeof(buffer));
+            expect(yu::binlog::FormatPayload("{} {} {}", std::string(buffer, encoder.Size())) == "1 a lo {?}");
+        };
+    };
+
+    describe("yu::Logger binary mode") = [] {
+        it("should round-trip YU_LOG_* calls through yu-logdecode") = [] {
+            const std::filesystem::path path = std::filesystem::temp_directory_path() / "yu_test_log.bin";
+            yu::Logger& logger = yu::Logger::Instance();
+            logger.SetConsoleOutput(false);
+            logger.SetMinLevel(yu::LogLevel::Debug);
+            expect(logger.EnableAsync());
+            expect(logger.SetBinaryLogFile(path.string()));
+            expect(logger.IsBinaryLogging());
+
+            const char* missing = nullptr;
+            for (int frame = 0; frame < 3; ++frame) {
+                YU_LOG_INFO("Draw {} meshes at {:.2f} ms", 100 + frame, 1.5 * frame);
+            }
+            YU_LOG_WARN("Texture {} missing, {}", std::string_view("grass"), missing);
+            YU_LOG_ERROR("No arguments");
+            logger.Flush();
+            expect(logger.SetBinaryLogFile(""));
+            logger.DisableAsync();
+
+            std::ifstream input(path, std::ios::binary);
+            const std::string data((std::istreambuf_iterator<char>(input)), std::istreambuf_iterator<char>());
+            std::ostringstream text;
+            const yu::binlog::DecodeResult result = yu::binlog::DecodeLog(data, text);
+            expect(result.error.empty()) << result.error;
+            expect(result.entries == 5_u);
+            expect(result.unknownSites == 0_u);
+
+            const std::vector<std::string> lines = Lines(text.str());
+            expect(lines.size() == 5_u);
+            if (lines.size() == 5) {
+                for (int frame = 0; frame < 3; ++frame) {
+                    expect(lines[frame].find("] [INFO] [test_logbinary.cpp:") != std::string::npos) << lines[frame];
+                    expect(EndsWith(lines[frame], std::format("] Draw {} meshes at {:.2f} ms", 100 + frame, 1.5 * frame)))
+                        << lines[frame];
+                }
+                expect(lines[3].find("] [WARN] [") != std::string::npos);
+                expect(EndsWith(lines[3], "] Texture grass missing, (null)")) << lines[3];
+                expect(EndsWith(lines[4], "] No arguments")) << lines[4];
+            }
+
+            // Whatever it writes, the decoder rejects a file that is not a binary log
+            std::ostringstream ignored;
+            expect(!yu::binlog::DecodeLog("not a log file at all, just text", ignored).error.empty());
+            expect(!yu::binlog::DecodeLog(std::string_view(data).substr(0, data.size() - 3), ignored).error.empty())
+                << "a truncated entry is reported";
+            std::filesystem::remove(path);
+        };
+    };
+}
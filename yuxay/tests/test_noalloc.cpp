@@ -0,0 +1,174 @@
+#include <boost/ut.hpp>
+#include <yu/testing.h>
+#include <yu/log.h>
+#include <yu/memory.h>
+#include <yu/memory_arena.h>
+#include <yu/memory_frame.h>
+#include <yu/memory_pool.h>
+#include <cstdint>
+#include <memory>
+#include <string_view>
+
+namespace ut = boost::ut;
+
+namespace {
+
+using yu::mem::LightweightTracker;
+
+void* FakeAddress(std::uint32_t index) {
+    return reinterpret_cast<void*>(static_cast<std::uintptr_t>(0x10000000u + index * 16u));
+}
+
+} // anonymous namespace
+
+int main() {
+    yu::testing::InstallCountingAllocator();
+
+    using namespace ut;
+    using namespace ut::spec;
+
+    cfg<override> = {.tag = {"yu::testing"}};
+
+    describe("yu::testing::AllocationScope") = [] {
+        it("should count operator new and yu::mem on this thread") = [] {
+            yu::testing::AllocationScope scope;
+            auto value = std::make_unique<int>(42);
+            void* volatile sink = value.get();  // Keeps the new from being elided
+            expect(sink != nullptr);
+            void* block = yu::mem::Allocate(128);
+            expect(scope.Count() == 2_u);
+            expect(scope.Bytes() >= 128 + sizeof(int));
+            yu::mem::Free(block);
+        };
+
+        it("should pass for a block that does not allocate") = [] {
+            int sum = 0;
+            YU_EXPECT_NO_ALLOC {
+                for (int i = 0; i < 100; ++i) sum += i;
+            };
+            expect(sum == 4950_i);
+        };
+    };
+
+    describe("LightweightTracker") = [] {
+        it("should record and free without allocating") = [] {
+            LightweightTracker& tracker = LightweightTracker::Instance();
+            const std::size_t active = tracker.GetActiveCount();
+            YU_EXPECT_NO_ALLOC {
+                for (std::uint32_t i = 0; i < 1000; ++i) {
+                    tracker.RecordAllocation(FakeAddress(i), 64, LightweightTracker::Tags::Gameplay);
+                }
+                for (std::uint32_t i = 0; i < 1000; ++i) {
+                    tracker.RecordDeallocation(FakeAddress(i));
+                }
+            };
+            expect(tracker.GetActiveCount() == active);
+        };
+
+        it("should stay off the heap in sampled and call-site modes") = [] {
+            LightweightTracker& tracker = LightweightTracker::Instance();
+            tracker.SetTrackingMode(LightweightTracker::TrackingMode::Sampled, 4096);
+            tracker.SetCallSiteMode(LightweightTracker::CallSiteMode::ReturnAddress);  // Maps its table now
+            YU_EXPECT_NO_ALLOC {
+                for (std::uint32_t i = 0; i < 1000; ++i) {
+                    tracker.RecordAllocation(FakeAddress(i), 256, LightweightTracker::Tags::General,
+                                             LightweightTracker::AllocationType::Heap, FakeAddress(i % 8));
+                }
+                for (std::uint32_t i = 0; i < 1000; ++i) {
+                    tracker.RecordDeallocation(FakeAddress(i));
+                }
+            };
+            tracker.SetCallSiteMode(LightweightTracker::CallSiteMode::Off);
+            tracker.SetTrackingMode(LightweightTracker::TrackingMode::Exact);
+        };
+
+        it("should record reallocations without allocating") = [] {
+            LightweightTracker& tracker = LightweightTracker::Instance();
+            const std::size_t active = tracker.GetActiveCount();
+            YU_EXPECT_NO_ALLOC {
+                for (std::uint32_t i = 0; i < 1000; ++i) {
+                    tracker.RecordAllocation(FakeAddress(i), 32);
+                    tracker.RecordReallocation(FakeAddress(i), FakeAddress(i), 96);           // In place
+                    tracker.RecordReallocation(FakeAddress(i), FakeAddress(i + 5000), 512);  // Moved
+                }
+                for (std::uint32_t i = 0; i < 1000; ++i) {
+                    tracker.RecordDeallocation(FakeAddress(i + 5000));
+                }
+            };
+            expect(tracker.GetActiveCount() == active);
+        };
+
+        it("should build lifetime histograms without allocating") = [] {
+            LightweightTracker& tracker = LightweightTracker::Instance();
+            tracker.SetCallSiteMode(LightweightTracker::CallSiteMode::ReturnAddress);
+            tracker.SetLifetimeProfiling(true);  // Maps the site histograms now
+            YU_EXPECT_NO_ALLOC {
+                for (std::uint32_t i = 0; i < 1000; ++i) {
+                    tracker.RecordAllocation(FakeAddress(i), 48, LightweightTracker::Tags::General,
+                                             LightweightTracker::AllocationType::Heap, FakeAddress(i % 8));
+                    if (i % 100 == 0) tracker.AdvanceFrame();
+                }
+                for (std::uint32_t i = 0; i < 1000; ++i) {
+                    tracker.RecordDeallocation(FakeAddress(i));
+                }
+            };
+            tracker.SetLifetimeProfiling(false);
+            tracker.SetCallSiteMode(LightweightTracker::CallSiteMode::Off);
+        };
+    };
+
+    describe("Logger async") = [] {
+        it("should enqueue without allocating") = [] {
+            yu::Logger& logger = yu::Logger::Instance();
+            logger.SetConsoleOutput(false);
+            logger.SetMinLevel(yu::LogLevel::Debug);
+            yu::AsyncLogConfig config;
+            config.capacity = 1024;
+            expect(logger.EnableAsync(config));
+
+            const std::size_t dropped = logger.GetDroppedCount();
+            YU_EXPECT_NO_ALLOC {
+                for (int i = 0; i < 100; ++i) {
+                    logger.Log(yu::LogLevel::Info, "plain message");
+                    YU_LOG_INFO("frame {} of {}", i, std::string_view("station"));
+                }
+            };
+            expect(logger.GetDroppedCount() == dropped);
+            logger.DisableAsync();
+        };
+    };
+
+    describe("Frame and arena memory") = [] {
+        it("should serve frame allocations from pages") = [] {
+            yu::mem::FrameArena& frame = yu::mem::FrameArena::ThisThread();
+            (void)frame.Allocate(16);  // First use maps the arenas
+            YU_EXPECT_NO_ALLOC {
+                for (int f = 0; f < 4; ++f) {
+                    float* values = frame.AllocateArray<float>(256);
+                    values[0] = 1.0f;
+                    const std::string_view text = yu::mem::FrameFormat("ship {} at {:.1f}", f, 3.5);
+                    yu::mem::FrameVector<int> ids;
+                    for (int i = 0; i < 100; ++i) ids.push_back(i);
+                    expect(!text.empty());
+                    yu::mem::FrameArena::EndFrame();
+                }
+            };
+        };
+
+        it("should serve arena and pool allocations from pages") = [] {
+            yu::mem::Arena arena(yu::mem::Tags::Temporary);
+            yu::mem::FixedBlockPool pool(64);
+            YU_EXPECT_NO_ALLOC {
+                for (int i = 0; i < 100; ++i) {
+                    yu::mem::ArenaScope scope(arena);
+                    (void)arena.AllocateArray<double>(32);
+                    void* block = pool.Allocate();
+                    pool.Deallocate(block);
+                }
+                arena.Reset();
+            };
+        };
+    };
+
+    return 0;
+}
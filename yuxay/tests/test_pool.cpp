@@ -0,0 +1,144 @@
+#include <boost/ut.hpp>
+#include <yu/memory_pool.h>
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+namespace ut = boost::ut;
+
+namespace {
+
+bool AlignedTo(const void* ptr, std::size_t alignment) {
+    return reinterpret_cast<std::uintptr_t>(ptr) % alignment == 0;
+}
+
+struct alignas(32) Particle {
+    static inline int alive = 0;
+    float position[3];
+    std::uint32_t id;
+
+    explicit Particle(std::uint32_t value) noexcept : position{}, id(value) { ++alive; }
+    ~Particle() { --alive; }
+};
+
+} // anonymous namespace
+
+int main() {
+    using namespace ut;
+    using namespace ut::spec;
+
+    cfg<override> = {.tag = {"yu::mem pool"}};
+
+    describe("yu::mem::FixedBlockPool free list") = [] {
+        it("should hand out a new slab in address order") = [] {
+            yu::mem::FixedBlockPool pool(48);
+            auto* a = static_cast<char*>(pool.Allocate());
+            auto* b = static_cast<char*>(pool.Allocate());
+            auto* c = static_cast<char*>(pool.Allocate());
+            expect(b - a == static_cast<std::ptrdiff_t>(pool.BlockSize()));
+            expect(c - b == static_cast<std::ptrdiff_t>(pool.BlockSize()));
+            expect(pool.LiveCount() == 3_u);
+        };
+
+        it("should reuse the last freed block first") = [] {
+            yu::mem::FixedBlockPool pool(32);
+            void* a = pool.Allocate();
+            void* b = pool.Allocate();
+            void* c = pool.Allocate();
+            pool.Deallocate(a);
+            pool.Deallocate(c);
+            expect(pool.LiveCount() == 1_u);
+
+            expect(pool.Allocate() == c);
+            expect(pool.Allocate() == a);
+            void* next = pool.Allocate();
+            expect(next != a && next != b && next != c) << "then the untouched blocks";
+            pool.Deallocate(nullptr);
+            expect(pool.LiveCount() == 4_u);
+        };
+
+        it("should keep at least a pointer per block") = [] {
+            yu::mem::FixedBlockPool pool(1, 1);
+            expect(pool.BlockSize() >= sizeof(void*));
+            expect(pool.Alignment() >= alignof(void*));
+        };
+    };
+
+    describe("yu::mem::FixedBlockPool growth") = [] {
+        it("should add a slab once the free list runs out") = [] {
+            // Too small for eight blocks: grown to a slab that holds them
+            yu::mem::FixedBlockPool pool(64, 16, yu::mem::Tags::General, 128);
+            void* first = pool.Allocate();
+            const std::size_t perSlab = pool.Capacity();
+            expect(perSlab >= 8_u);
+
+            std::vector<void*> blocks{first};
+            for (std::size_t i = 1; i < perSlab; ++i) blocks.push_back(pool.Allocate());
+            expect(pool.Capacity() == perSlab) << "the first slab is exactly used up";
+            blocks.push_back(pool.Allocate());
+            expect(pool.Capacity() == 2 * perSlab);
+            expect(pool.LiveCount() == perSlab + 1);
+
+            std::sort(blocks.begin(), blocks.end());
+            expect(std::adjacent_find(blocks.begin(), blocks.end()) == blocks.end()) << "every block distinct";
+
+            // Everything back: no new slab for the same demand
+            for (void* block : blocks) pool.Deallocate(block);
+            expect(pool.LiveCount() == 0_u);
+            for (std::size_t i = 0; i <= perSlab; ++i) (void)pool.Allocate();
+            expect(pool.Capacity() == 2 * perSlab);
+
+            pool.Release();
+            expect(pool.Capacity() == 0_u);
+            expect(pool.LiveCount() == 0_u);
+        };
+    };
+
+    describe("yu::mem::FixedBlockPool alignment") = [] {
+        it("should align fresh and recycled blocks alike") = [] {
+            yu::mem::FixedBlockPool pool(24, 64, yu::mem::Tags::General, 4096);
+            expect(pool.BlockSize() == 64_u);
+
+            std::vector<void*> blocks;
+            bool aligned = true;
+            for (int i = 0; i < 200; ++i) {
+                blocks.push_back(pool.Allocate());  // Spans several slabs
+                aligned = aligned && AlignedTo(blocks.back(), 64);
+            }
+            expect(aligned);
+            expect(pool.Capacity() > 64_u);
+
+            // Free every other block, in reverse, and take them back
+            for (std::size_t i = blocks.size(); i-- > 0;) {
+                if (i % 2 == 0) pool.Deallocate(blocks[i]);
+            }
+            aligned = true;
+            for (int i = 0; i < 100; ++i) aligned = aligned && AlignedTo(pool.Allocate(), 64);
+            expect(aligned);
+        };
+    };
+
+    describe("yu::mem::Pool") = [] {
+        it("should construct and destroy objects in aligned blocks") = [] {
+            yu::mem::Pool<Particle> pool;
+            Particle* a = pool.New(1u);
+            Particle* b = pool.New(2u);
+            expect(Particle::alive == 2_i);
+            expect(AlignedTo(a, alignof(Particle)) && AlignedTo(b, alignof(Particle)));
+            expect(a->id == 1_u && b->id == 2_u);
+
+            pool.Delete(a);
+            expect(Particle::alive == 1_i);
+            Particle* c = pool.New(3u);
+            expect(c == a) << "the freed block comes back";
+            expect(c->id == 3_u);
+            expect(pool.LiveCount() == 2_u);
+
+            pool.Delete(b);
+            pool.Delete(c);
+            pool.Delete(nullptr);
+            expect(Particle::alive == 0_i);
+            expect(pool.LiveCount() == 0_u);
+        };
+    };
+}
@@ -0,0 +1,113 @@
+#include <boost/ut.hpp>
+#include <yu/memory_lightweight.h>
+#include <cstdint>
+
+namespace ut = boost::ut;
+
+namespace {
+
+using yu::mem::LightweightTracker;
+
+void* FakeAddress(std::uint32_t index) {
+    return reinterpret_cast<void*>(static_cast<std::uintptr_t>(0x30000000u + index * 16u));
+}
+
+} // anonymous namespace
+
+int main() {
+    using namespace ut;
+    using namespace ut::spec;
+
+    cfg<override> = {.tag = {"yu::mem realloc"}};
+
+    describe("LightweightTracker::RecordReallocation") = [] {
+        it("should resize in place as one event") = [] {
+            LightweightTracker& tracker = LightweightTracker::Instance();
+            tracker.Reset();
+            tracker.RecordAllocation(FakeAddress(0), 100, LightweightTracker::Tags::Gameplay);
+            const std::uint64_t allocs = tracker.GetTotalAllocCount();
+
+            tracker.RecordReallocation(FakeAddress(0), FakeAddress(0), 300);
+            expect(tracker.GetTotalBytes() == 300_u);
+            expect(tracker.GetActiveCount() == 1_u);
+            expect(tracker.GetTagBytes(LightweightTracker::Tags::Gameplay) == 300_u);  // Keeps its tag
+            expect(tracker.GetTotalAllocCount() == allocs);
+            expect(tracker.GetReallocCount() == 1_u);
+            expect(tracker.GetSizeClassCount(yu::mem::SizeClassOf(100)) == 0_u);
+            expect(tracker.GetSizeClassBytes(yu::mem::SizeClassOf(300)) == 300_u);
+            expect(tracker.GetPeakBytes() >= 300_u);
+
+            tracker.RecordReallocation(FakeAddress(0), FakeAddress(0), 260);  // Same class
+            expect(tracker.GetSizeClassBytes(yu::mem::SizeClassOf(260)) == 260_u);
+            expect(tracker.GetTagFreeCount(LightweightTracker::Tags::Gameplay) == 0_u);
+
+            tracker.RecordDeallocation(FakeAddress(0));
+            expect(tracker.GetTotalBytes() == 0_u);
+            expect(tracker.GetActiveCount() == 0_u);
+        };
+
+        it("should move the record with the block") = [] {
+            LightweightTracker& tracker = LightweightTracker::Instance();
+            tracker.Reset();
+            tracker.RecordAllocation(FakeAddress(1), 64, LightweightTracker::Tags::Audio);
+            tracker.RecordReallocation(FakeAddress(1), FakeAddress(2), 4096);
+            expect(tracker.GetTotalBytes() == 4096_u);
+            expect(tracker.GetActiveCount() == 1_u);
+            expect(tracker.CountActiveAllocations() == 1_u);
+            expect(tracker.GetTagBytes(LightweightTracker::Tags::Audio) == 4096_u);
+
+            tracker.RecordDeallocation(FakeAddress(1));  // Gone from the table
+            expect(tracker.GetTotalBytes() == 4096_u);
+            tracker.RecordDeallocation(FakeAddress(2));
+            expect(tracker.GetTotalBytes() == 0_u);
+            expect(tracker.CountActiveAllocations() == 0_u);
+        };
+
+        it("should follow realloc's null and failure rules") = [] {
+            LightweightTracker& tracker = LightweightTracker::Instance();
+            tracker.Reset();
+            tracker.RecordReallocation(nullptr, FakeAddress(3), 32);  // realloc(nullptr, n) allocates
+            expect(tracker.GetActiveCount() == 1_u);
+            expect(tracker.GetTotalAllocCount() == 1_u);
+
+            tracker.RecordReallocation(FakeAddress(3), nullptr, 64);  // Failed: the old block stays
+            expect(tracker.GetTotalBytes() == 32_u);
+
+            tracker.RecordReallocation(FakeAddress(3), nullptr, 0);  // realloc(p, 0) freed it
+            expect(tracker.GetActiveCount() == 0_u);
+
+            tracker.RecordReallocation(FakeAddress(4), FakeAddress(5), 48);  // Untracked block: a new record
+            expect(tracker.GetTotalBytes() == 48_u);
+            tracker.RecordDeallocation(FakeAddress(5));
+            expect(tracker.GetActiveCount() == 0_u);
+        };
+
+        it("should keep call-site and lifetime data") = [] {
+            LightweightTracker& tracker = LightweightTracker::Instance();
+            tracker.Reset();
+            tracker.SetCallSiteMode(LightweightTracker::CallSiteMode::ReturnAddress);
+            tracker.SetLifetimeProfiling(true);
+            tracker.RecordAllocation(FakeAddress(6), 16, 0, LightweightTracker::AllocationType::Heap, FakeAddress(0xC000));
+            tracker.AdvanceFrame();
+            tracker.RecordReallocation(FakeAddress(6), FakeAddress(7), 1000);
+            tracker.AdvanceFrame();
+            tracker.RecordDeallocation(FakeAddress(7));
+
+            // Two frames alive, counted once, in the class of its final size, at its first site
+            const std::size_t bucket = LightweightTracker::LifetimeBucketOf(2);
+            expect(tracker.GetLifetimeCount(yu::mem::SizeClassOf(1000), bucket) == 1_u);
+            expect(tracker.GetLifetimeCount(yu::mem::SizeClassOf(16), 0) == 0_u);
+            std::size_t siteFrees = 0;
+            for (std::uint16_t id = 1; id <= yu::mem::LightweightConfig::MaxCallSites; ++id) {
+                siteFrees += tracker.GetSiteLifetimeCount(id, bucket);
+            }
+            expect(siteFrees == 1_u);
+
+            tracker.SetLifetimeProfiling(false);
+            tracker.SetCallSiteMode(LightweightTracker::CallSiteMode::Off);
+            tracker.Reset();
+        };
+    };
+
+    return 0;
+}
@@ -0,0 +1,177 @@
+#include <boost/ut.hpp>
+#include <yu/memory_records.h>
+#include <cstdint>
+#include <vector>
+
+namespace ut = boost::ut;
+
+namespace {
+
+struct SmallTable {
+    static constexpr std::size_t MaxAllocations = 64;
+    static constexpr std::size_t MaxSegments = 4;
+    static constexpr std::size_t MaxProbes = 16;
+};
+
+using Table = yu::mem::RecordTable<SmallTable>;
+constexpr std::size_t Mask = SmallTable::MaxAllocations - 1;
+
+void* FakeAddress(std::uint32_t index) {
+    return reinterpret_cast<void*>(std::uintptr_t{0x100000} + std::uintptr_t{index} * 16);
+}
+
+std::size_t HomeOf(void* ptr) {
+    return yu::mem::detail::HashPointer(ptr) & Mask;
+}
+
+/// The nth fake address (from 0) whose home slot in the first segment is home
+void* AddressWithHome(std::size_t home, std::uint32_t nth) {
+    for (std::uint32_t i = 0;; ++i) {
+        void* ptr = FakeAddress(i);
+        if (HomeOf(ptr) == home && nth-- == 0) return ptr;
+    }
+}
+
+yu::mem::RecordInfo Info(std::uint32_t size) {
+    yu::mem::RecordInfo info;
+    info.size = size;
+    info.tag = 3;
+    return info;
+}
+
+} // anonymous namespace
+
+int main() {
+    using namespace ut;
+    using namespace ut::spec;
+
+    cfg<override> = {.tag = {"yu::mem records"}};
+
+    describe("yu::mem::RecordTable tombstones") = [] {
+        it("should find a record probed past a freed cluster") = [] {
+            Table table;
+            expect(table.Initialize());
+
+            // Six records share one home slot, so they fill a run of six slots
+            void* cluster[6];
+            for (std::uint32_t i = 0; i < 6; ++i) {
+                cluster[i] = AddressWithHome(5, i);
+                expect(table.Insert(cluster[i], Info(100 + i)) != nullptr);
+            }
+            yu::mem::RecordInfo out;
+            for (std::uint32_t i = 0; i < 4; ++i) expect(table.Erase(cluster[i], out));
+            expect(out.size == 103_u);
+            expect(!table.Erase(cluster[0], out)) << "already erased";
+
+            // A cleared slot would end these probes early
+            for (std::uint32_t i = 4; i < 6; ++i) {
+                yu::mem::CompactRecord* record = table.Find(cluster[i]);
+                expect(record != nullptr);
+                expect(record && record->size == 100 + i);
+            }
+            expect(table.Find(cluster[2]) == nullptr);
+
+            const yu::mem::RecordTableStats stats = table.GetStats();
+            expect(stats.live == 2_u);
+            expect(stats.tombstones == 4_u);
+
+            // A new record of the cluster takes a tombstone back
+            void* late = AddressWithHome(5, 6);
+            yu::mem::CompactRecord* reused = table.Insert(late, Info(7));
+            expect(reused != nullptr);
+            expect(table.Find(late) == reused);
+            expect(table.GetStats().tombstones == 3_u);
+            expect(table.Find(cluster[5]) != nullptr);
+        };
+    };
+
+    describe("yu::mem::RecordTable segments") = [] {
+        it("should grow past one segment without dropping records") = [] {
+            Table table;
+            expect(table.Initialize());
+            expect(table.GetSegmentCount() == 1_u);
+
+            constexpr std::uint32_t Count = SmallTable::MaxAllocations * 4;
+            bool inserted = true;
+            for (std::uint32_t i = 0; i < Count; ++i) {
+                inserted = inserted && table.Insert(FakeAddress(i), Info(i)) != nullptr;
+            }
+            expect(inserted);
+            expect(table.GetSegmentCount() > 1_u);
+            expect(table.GetCapacity() > Count);
+
+            bool found = true;
+            for (std::uint32_t i = 0; i < Count; ++i) {
+                const yu::mem::CompactRecord* record = table.Find(FakeAddress(i));
+                found = found && record && record->size == i;
+            }
+            expect(found);
+
+            std::size_t walked = 0;
+            table.ForEach([&walked](void*, const yu::mem::CompactRecord&) { ++walked; });
+            expect(walked == Count);
+            expect(table.GetStats().live == Count);
+        };
+
+        it("should re-open a saturated segment once frees drain it") = [] {
+            Table table;
+            expect(table.Initialize());
+
+            // Fill the first segment until an insert overflows into a second one
+            std::vector<void*> first;
+            std::uint32_t next = 0;
+            while (table.GetSegmentCount() == 1) {
+                void* ptr = FakeAddress(next++);
+                expect(table.Insert(ptr, Info(16)) != nullptr);
+                first.push_back(ptr);
+            }
+            first.pop_back();  // The insert that grew the table landed in the new segment
+            expect(first.size() * 2 >= SmallTable::MaxAllocations) << "saturated above half load";
+            expect(table.ReopenDrained() == 0_u) << "still too full";
+
+            yu::mem::RecordInfo out;
+            for (void* ptr : first) expect(table.Erase(ptr, out));
+            expect(table.ReopenDrained() == 1_u);
+            expect(table.ReopenDrained() == 0_u) << "already open";
+            expect(table.GetSegmentCount() == 2_u);
+
+            table.Clear();
+            expect(table.GetStats().live == 0_u);
+            expect(table.GetStats().tombstones == 0_u);
+        };
+    };
+
+    describe("yu::mem::RecordTable statistics") = [] {
+        it("should report probe distances and load of a known fill") = [] {
+            Table table;
+            expect(table.Initialize());
+
+            // Eight records at their own home slots 20..27, four sharing slot 40
+            for (std::size_t home = 20; home < 28; ++home) {
+                expect(table.Insert(AddressWithHome(home, 0), Info(8)) != nullptr);
+            }
+            for (std::uint32_t i = 0; i < 4; ++i) {
+                expect(table.Insert(AddressWithHome(40, i), Info(8)) != nullptr);
+            }
+
+            const yu::mem::RecordTableStats stats = table.GetStats();
+            expect(stats.segments == 1_u);
+            expect(stats.capacity == SmallTable::MaxAllocations);
+            expect(stats.live == 12_u);
+            expect(stats.tombstones == 0_u);
+            expect(stats.maxProbe == 3_u);
+            expect(stats.probeHistogram[0] == 9_u);  // Distances 0
+            expect(stats.probeHistogram[1] == 1_u);  // 1
+            expect(stats.probeHistogram[2] == 2_u);  // 2 and 3
+            expect(stats.averageProbe == 6.0 / 12.0);
+            expect(stats.loadFactor == 12.0 / 64.0);
+
+            yu::mem::RecordInfo out;
+            expect(table.Erase(AddressWithHome(20, 0), out));
+            const yu::mem::RecordTableStats after = table.GetStats();
+            expect(after.live == 11_u);
+            expect(after.tombstones == 1_u);
+            expect(after.loadFactor == 11.0 / 64.0);
+        };
+    };
+}
@@ -0,0 +1,52 @@
+#include <boost/ut.hpp>
+#include <yu/memory_stats.h>
+#include <cstdint>
+#include <memory>
+
+namespace ut = boost::ut;
+
+namespace {
+
+struct StatsConfig {
+    static constexpr std::size_t MaxTags = 4;
+    static constexpr std::size_t SizeClasses = 32;
+    static constexpr std::size_t StatShards = 8;
+    static constexpr std::size_t PeakSampleInterval = 0;  // Sample on every allocation
+};
+
+using Sharded = yu::mem::ShardedStats<StatsConfig>;
+
+} // anonymous namespace
+
+int main() {
+    using namespace ut;
+    using namespace ut::spec;
+
+    cfg<override> = {.tag = {"yu::mem stats"}};
+
+    describe("yu::mem::ShardedStats") = [] {
+        it("should clamp a gauge that reads below zero instead of wrapping") = [] {
+            // A reader racing the updates can see a free before its allocation;
+            // recording them in that order produces the same sums
+            auto stats = std::make_unique<Sharded>();
+            const std::size_t sizeClass = yu::mem::SizeClassOf(64);
+            stats->OnDeallocation(64, 1, 1, sizeClass);
+
+            expect(stats->TotalBytes() == 0_u);
+            expect(stats->ActiveCount() == 0_u);
+            expect(stats->TagBytes(1) == 0_u);
+            expect(stats->SizeClassBytes(sizeClass) == 0_u);
+            expect(stats->SizeClassCount(sizeClass) == 0_u);
+            expect(stats->PeakBytes() == 0_u) << "a wrapped sum must not latch as the peak";
+            expect(stats->TagPeakBytes(1) == 0_u);
+            expect(stats->TagFreeCount(1) == 1_u);
+
+            stats->OnAllocation(64, 1, 1, sizeClass);
+            expect(stats->TotalBytes() == 0_u);
+            stats->OnAllocation(32, 1, 1, yu::mem::SizeClassOf(32));
+            expect(stats->TotalBytes() == 32_u);
+            expect(stats->PeakBytes() == 32_u);
+            expect(stats->TagPeakBytes(1) == 32_u);
+        };
+    };
+}
@@ -0,0 +1,53 @@
+/**
+ * @file logdecode.cpp
+ * @brief yu-logdecode: turn a binary yu log (see yu/log_binary.h) back into text
+ *
+ * Usage: yu-logdecode <input.log.bin> [output.log]
+ *
+ * Output lines use the same layout as the text logger:
+ *   [2026-01-11 14:30:45.123] [INFO] [main.cpp:42] Application started
+ *
+ * The decoding itself is yu::binlog::DecodeLog (yu/log_decode.h).
+ */
+
+#include "yu/log_decode.h"
+
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <string>
+
+int main(int argc, char** argv) {
+    if (argc < 2) {
+        std::cerr << "Usage: yu-logdecode <input.log.bin> [output.log]\n";
+        return 2;
+    }
+
+    std::ifstream input(argv[1], std::ios::binary);
+    if (!input) {
+        std::cerr << "Cannot open " << argv[1] << '\n';
+        return 1;
+    }
+    const std::string data((std::istreambuf_iterator<char>(input)), std::istreambuf_iterator<char>());
+
+    std::ofstream outputFile;
+    if (argc >= 3) {
+        outputFile.open(argv[2]);
+        if (!outputFile) {
+            std::cerr << "Cannot open " << argv[2] << '\n';
+            return 1;
+        }
+    }
+    std::ostream& out = argc >= 3 ? static_cast<std::ostream&>(outputFile) : std::cout;
+
+    const yu::binlog::DecodeResult result = yu::binlog::DecodeLog(data, out);
+    if (!result.error.empty()) {
+        std::cerr << argv[1] << ": " << result.error << '\n';
+        return 1;
+    }
+
+    std::cerr << result.entries << " entries decoded";
+    if (result.unknownSites > 0) std::cerr << ", " << result.unknownSites << " with unknown sites";
+    std::cerr << '\n';
+    return 0;
+}